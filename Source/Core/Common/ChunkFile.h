@@ -20,6 +20,7 @@
 #include <map>
 #include <optional>
 #include <set>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -50,6 +51,7 @@ private:
   u8** m_ptr_current;
   u8* m_ptr_end;
   Mode m_mode;
+  std::vector<std::span<u8>>* m_external_regions = nullptr;
 
 public:
   PointerWrap(u8** ptr, size_t size, Mode mode)
@@ -64,6 +66,10 @@ public:
   bool IsMeasureMode() const { return m_mode == Mode::Measure; }
   bool IsVerifyMode() const { return m_mode == Mode::Verify; }
 
+  // Scatter-gather mode: the large blocks of emulated memory are added to regions instead of being
+  // copied, so the caller can save them from and load them into emulated memory on its own
+  void SetExternalRegions(std::vector<std::span<u8>>* regions) { m_external_regions = regions; }
+
   template <typename K, class V>
   void Do(std::map<K, V>& x)
   {
@@ -214,6 +220,15 @@ public:
     DoArray(arr, static_cast<u32>(N));
   }
 
+  // For the large blocks of emulated memory, like MEM1 and ARAM
+  void DoMemoryRegion(u8* data, u32 size)
+  {
+    if (m_external_regions)
+      m_external_regions->emplace_back(data, size);
+    else
+      DoVoid(data, size);
+  }
+
   // The caller is required to inspect the mode of this PointerWrap
   // and deal with the pointer returned from this function themself.
   [[nodiscard]] u8* DoExternal(u32& count)
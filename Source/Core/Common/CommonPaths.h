@@ -60,6 +60,10 @@
 #define GAMESETTINGS_DIR "GameSettings"
 #define STATFILES_DIR "StatFiles"
 #define MSSBFILES_DIR "MarioSuperstarBaseball"
+#define STATOUTBOX_DIR "Outbox"
+#define STATJOURNAL_DIR "Journal"
+#define STATTRACES_DIR "Traces"
+#define STATARCHIVE_DIR "Archive"
 #define HUDFILES_DIR "HudFiles"
 #define STATELOGGERFILES_DIR "StateLoggerFiles"
 #define MAPS_DIR "Maps"
@@ -135,6 +139,7 @@
 // Files in the directory returned by GetUserPath(D_MEMORYWATCHER_IDX)
 #define MEMORYWATCHER_LOCATIONS "Locations.txt"
 #define MEMORYWATCHER_SOCKET "MemoryWatcher"
+#define MEMORYWATCHER_RING "MemoryWatcher.ring"
 
 // Sys files
 #define TOTALDB "totaldb.dsy"
@@ -840,6 +840,10 @@ static void RebuildUserDirectories(unsigned int dir_index)
     s_user_paths[D_GAMESETTINGS_IDX] = s_user_paths[D_USER_IDX] + GAMESETTINGS_DIR DIR_SEP;
     s_user_paths[D_STATFILES_IDX] = s_user_paths[D_USER_IDX] + STATFILES_DIR DIR_SEP;
     s_user_paths[D_MSSBFILES_IDX] = s_user_paths[D_STATFILES_IDX] + MSSBFILES_DIR DIR_SEP;
+    s_user_paths[D_STATOUTBOX_IDX] = s_user_paths[D_MSSBFILES_IDX] + STATOUTBOX_DIR DIR_SEP;
+    s_user_paths[D_STATJOURNAL_IDX] = s_user_paths[D_MSSBFILES_IDX] + STATJOURNAL_DIR DIR_SEP;
+    s_user_paths[D_STATTRACES_IDX] = s_user_paths[D_MSSBFILES_IDX] + STATTRACES_DIR DIR_SEP;
+    s_user_paths[D_STATARCHIVE_IDX] = s_user_paths[D_MSSBFILES_IDX] + STATARCHIVE_DIR DIR_SEP;
     s_user_paths[D_HUDFILES_IDX] = s_user_paths[D_USER_IDX] + HUDFILES_DIR DIR_SEP;
     s_user_paths[D_STATELOGGER_IDX] = s_user_paths[D_USER_IDX] + STATELOGGERFILES_DIR DIR_SEP;
     s_user_paths[D_MAPS_IDX] = s_user_paths[D_USER_IDX] + MAPS_DIR DIR_SEP;
@@ -897,6 +901,7 @@ static void RebuildUserDirectories(unsigned int dir_index)
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_LOCATIONS;
     s_user_paths[F_MEMORYWATCHERSOCKET_IDX] =
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SOCKET;
+    s_user_paths[F_MEMORYWATCHERRING_IDX] = s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_RING;
 
     s_user_paths[D_GBAUSER_IDX] = s_user_paths[D_USER_IDX] + GBA_USER_DIR DIR_SEP;
     s_user_paths[D_GBASAVES_IDX] = s_user_paths[D_GBAUSER_IDX] + GBASAVES_DIR DIR_SEP;
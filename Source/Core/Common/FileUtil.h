@@ -36,6 +36,10 @@ enum
   D_SKYLANDERS_IDX,
   D_STATFILES_IDX,
   D_MSSBFILES_IDX,
+  D_STATOUTBOX_IDX,
+  D_STATJOURNAL_IDX,
+  D_STATTRACES_IDX,
+  D_STATARCHIVE_IDX,
   D_HUDFILES_IDX,
   D_STATELOGGER_IDX,
   D_MAPS_IDX,
@@ -92,6 +96,7 @@ enum
   F_GCSRAM_IDX,
   F_MEMORYWATCHERLOCATIONS_IDX,
   F_MEMORYWATCHERSOCKET_IDX,
+  F_MEMORYWATCHERRING_IDX,
   F_WIISDCARDIMAGE_IDX,
   F_DUALSHOCKUDPCLIENTCONFIG_IDX,
   F_FREELOOKCONFIG_IDX,
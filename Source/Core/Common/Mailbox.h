@@ -0,0 +1,49 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a lockless single producer, single consumer mailbox that only keeps the latest value.
+// Values are copied into one of three slots, so neither side ever waits for the other.
+
+#include <array>
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+template <typename T>
+class Mailbox
+{
+public:
+  // Producer only
+  void Publish(const T& value)
+  {
+    m_slots[m_write_slot] = value;
+    const u8 old = m_ready_slot.exchange(m_write_slot | NEW_VALUE, std::memory_order_acq_rel);
+    m_write_slot = old & SLOT_MASK;
+  }
+
+  // Consumer only. Returns the latest value if one was published since the last call, or nullptr.
+  // The value stays valid until the next call.
+  const T* Receive()
+  {
+    if (!(m_ready_slot.load(std::memory_order_relaxed) & NEW_VALUE))
+      return nullptr;
+
+    const u8 old = m_ready_slot.exchange(m_read_slot, std::memory_order_acq_rel);
+    m_read_slot = old & SLOT_MASK;
+    return &m_slots[m_read_slot];
+  }
+
+private:
+  static constexpr u8 SLOT_MASK = 0x3;
+  static constexpr u8 NEW_VALUE = 0x4;
+
+  std::array<T, 3> m_slots{};
+  u8 m_write_slot = 0;
+  std::atomic<u8> m_ready_slot = 1;
+  u8 m_read_slot = 2;
+};
+}  // namespace Common
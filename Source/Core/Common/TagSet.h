@@ -1,6 +1,7 @@
 #pragma once
 
 #include <picojson.h>
+#include <iostream>
 #include <sstream>
 #include <map>
 #include <string>
@@ -11,8 +12,6 @@
 #include <picojson.h>
 #include "sstream"
 
-#include "Common/HttpRequest.h"
-
 enum ClientCode {
     DisableManualFielderSelect,
     DisableAntiQuickPitch,
@@ -193,11 +192,10 @@ namespace Tag
     };
 
 
-    static std::optional<picojson::value> ParseResponse(const std::vector<u8>& response)
+    static std::optional<picojson::value> ParseResponse(const std::string& response)
     {
-       const std::string response_string(reinterpret_cast<const char*>(response.data()),response.size());
        picojson::value json;
-       const auto error = picojson::parse(json, response_string);
+       const auto error = picojson::parse(json, response);
        if (!error.empty())
            return {};
        return json;
@@ -264,6 +262,9 @@ namespace Tag
         std::cout << "So far so good" << "\n";
 
         // Get a vector of picojson::values for creating Tags 
+        if (!tag_set_pico_json.get("tags").is<picojson::array>()){
+            return std::nullopt;
+        }
         const std::vector<picojson::value> tags = tag_set_pico_json.get("tags").get<picojson::array>();
         // Loop through the vector of picojson::values, 
         // validate that the json data meets specifications, 
@@ -348,26 +349,19 @@ namespace Tag
         return tag_set;
     }
 
-    static inline std::optional<TagSet> getTagSet(Common::HttpRequest &http, int tag_set_id){
-       // const Common::HttpRequest::Response response = m_http.Get("https://api.projectrio.app/tag_set/" + std::to_string(tag_set_id));
-       const Common::HttpRequest::Response response = http.Get("https://api.projectrio.app/tag_set/" + std::to_string(tag_set_id));
-
-       if (!response){
-           std::cout << "No Response" << "\n";
-           return std::nullopt;
-       }
-
-       auto json = ParseResponse(response.value());
+    //Body of a tag_set/<id> response
+    static inline std::optional<TagSet> parseTagSetResponse(const std::string& response){
+       auto json = ParseResponse(response);
        if (!json){
            std::cout << "No JSON" << "\n"; 
            return std::nullopt;
        }
-       
-       picojson::value tag_set_pico_json = json->get("Tag Set").get<picojson::array>()[0];
 
-       std::optional<TagSet> tag_set = convertPicoJsonTagSet(tag_set_pico_json);
-       
-       return tag_set;
+       const picojson::value& tag_set_list = json->get("Tag Set");
+       if (!tag_set_list.is<picojson::array>() || tag_set_list.get<picojson::array>().empty())
+           return std::nullopt;
+
+       return convertPicoJsonTagSet(tag_set_list.get<picojson::array>()[0]);
     }
 
     static inline std::optional<TagSet> getDummyTagSet() {
@@ -423,37 +417,30 @@ namespace Tag
        );
     }
 
-    static inline std::map<int, TagSet> getAvailableTagSets(Common::HttpRequest &http, std::string rio_key){
+    //Payload of the tag_set/list request for the tag sets rio_key can use
+    static inline std::string availableTagSetsRequest(const std::string& rio_key){
        std::stringstream sstm;
        sstm << "{\"Active\":\"true\", \"Rio Key\":\"" << rio_key << "\"}";
-       std::string payload = sstm.str(); 
-       const Common::HttpRequest::Response response = http.Post(
-           "https://api.projectrio.app/tag_set/list",
-           payload,
-           {{"Content-Type", "application/json"},}
-       );
+       return sstm.str();
+    }
 
-       if (!response){
-           std::cout << "No Response" << "\n";
-           std::map<int, TagSet> empty_map;
-           return empty_map;
-       }
+    //Body of a tag_set/list response
+    static inline std::map<int, TagSet> parseAvailableTagSetsResponse(const std::string& response){
+       // Initalize vector that will be populated with TagSets and returned at end of function
+       std::map<int, TagSet> tag_sets;
 
-       auto json = ParseResponse(response.value());
+       auto json = ParseResponse(response);
        if (!json){
            std::cout << "No JSON" << "\n"; 
-           std::map<int, TagSet> empty_map;
-           return empty_map;
+           return tag_sets;
        }
 
-       // Initalize vector that will be populated with TagSets and returned at end of function
-       std::map<int, TagSet> tag_sets;
-
-       // Create a vector of tag_sets as picojson objects
-       std::vector<picojson::value> tag_sets_pico_json = json->get("Tag Sets").get<picojson::array>();
+       const picojson::value& tag_sets_list = json->get("Tag Sets");
+       if (!tag_sets_list.is<picojson::array>())
+           return tag_sets;
 
        // Loop through each pico json tag set object
-       for (picojson::value tag_set_pico_json : tag_sets_pico_json){
+       for (const picojson::value& tag_set_pico_json : tag_sets_list.get<picojson::array>()){
            std::optional<TagSet> tag_set = convertPicoJsonTagSet(tag_set_pico_json);     
 
            // If tag_set is valid, add to tag_sets vector
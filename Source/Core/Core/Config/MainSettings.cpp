@@ -242,6 +242,9 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<bool> MAIN_SAVESTATE_ZSTD{{System::Main, "Core", "SaveStateZstd"}, false};
+const Info<u32> MAIN_REWIND_SECONDS{{System::Main, "Core", "RewindSeconds"}, 0};
+const Info<u32> MAIN_REWIND_INTERVAL{{System::Main, "Core", "RewindInterval"}, 4};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
 const Info<bool> MAIN_WII_WIILINK_ENABLE{{System::Main, "Core", "EnableWiiLink"}, false};
@@ -402,6 +405,20 @@ const Info<std::string> MAIN_THEME_NAME{{System::Main, "Interface", "ThemeName"}
 const Info<bool> MAIN_PAUSE_ON_FOCUS_LOST{{System::Main, "Interface", "PauseOnFocusLost"}, false};
 const Info<bool> MAIN_ENABLE_DEBUGGING{{System::Main, "Interface", "DebugModeEnabled"}, false};
 
+// Main.StatTracker
+
+const Info<bool> MAIN_STAT_TRACKER_RECORD_TRACE{{System::Main, "StatTracker", "RecordTrace"},
+                                                false};
+const Info<int> MAIN_STAT_TRACKER_HUD_STREAM_PORT{{System::Main, "StatTracker", "HudStreamPort"},
+                                                  0};
+
+// Main.MemoryWatcher
+
+const Info<bool> MAIN_MEMORY_WATCHER_BINARY{{System::Main, "MemoryWatcher", "Binary"}, false};
+const Info<bool> MAIN_MEMORY_WATCHER_RING{{System::Main, "MemoryWatcher", "Ring"}, false};
+const Info<int> MAIN_MEMORY_WATCHER_RING_SIZE{{System::Main, "MemoryWatcher", "RingSize"},
+                                              1024 * 1024};
+
 // Main.Analytics
 
 const Info<std::string> MAIN_ANALYTICS_ID{{System::Main, "Analytics", "ID"}, ""};
@@ -477,6 +494,7 @@ const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT{{System::Main, "Movie", "DumpFram
 const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY{{System::Main, "Movie", "ShowInputDisplay"}, false};
 const Info<bool> MAIN_MOVIE_SHOW_RTC{{System::Main, "Movie", "ShowRTC"}, false};
 const Info<bool> MAIN_MOVIE_SHOW_RERECORD{{System::Main, "Movie", "ShowRerecord"}, false};
+const Info<u32> MAIN_MOVIE_KEYFRAME_SECONDS{{System::Main, "Movie", "KeyframeSeconds"}, 0};
 
 // Main.Input
 
@@ -148,6 +148,12 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+// Compress savestates with zstd instead of LZ4, smaller files but slower saves
+extern const Info<bool> MAIN_SAVESTATE_ZSTD;
+// How far back the rewind hotkey can go, 0 turns rewinding off
+extern const Info<u32> MAIN_REWIND_SECONDS;
+// Frames between two rewind snapshots
+extern const Info<u32> MAIN_REWIND_INTERVAL;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -249,6 +255,21 @@ extern const Info<std::string> MAIN_THEME_NAME;
 extern const Info<bool> MAIN_PAUSE_ON_FOCUS_LOST;
 extern const Info<bool> MAIN_ENABLE_DEBUGGING;
 
+// Main.StatTracker
+
+// Record the memory the stat tracker reads to a trace file, for replaying with dolphin-tool
+extern const Info<bool> MAIN_STAT_TRACKER_RECORD_TRACE;
+// Serve the HUD to overlays on this local TCP port, 0 to only write the HUD file
+extern const Info<int> MAIN_STAT_TRACKER_HUD_STREAM_PORT;
+
+// Main.MemoryWatcher
+
+// Send changed values as one binary packet per frame instead of text
+extern const Info<bool> MAIN_MEMORY_WATCHER_BINARY;
+// Also write the binary packets to a ring in a memory mapped file
+extern const Info<bool> MAIN_MEMORY_WATCHER_RING;
+extern const Info<int> MAIN_MEMORY_WATCHER_RING_SIZE;
+
 // Main.Analytics
 
 extern const Info<std::string> MAIN_ANALYTICS_ID;
@@ -313,6 +334,8 @@ extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT;
 extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
+// Seconds between two keyframe savestates of a recording, for seeking in it. 0 turns them off
+extern const Info<u32> MAIN_MOVIE_KEYFRAME_SECONDS;
 
 // Main.Input
 
@@ -41,6 +41,7 @@ extern const Info<u32> NETPLAY_CHUNKED_UPLOAD_LIMIT;
 
 extern const Info<u32> NETPLAY_BUFFER_SIZE;
 extern const Info<u32> NETPLAY_CLIENT_BUFFER_SIZE;
+extern const Info<bool> NETPLAY_AUTO_BUFFER;
 
 extern const Info<bool> NETPLAY_SAVEDATA_LOAD;
 extern const Info<bool> NETPLAY_SAVEDATA_WRITE;
@@ -54,6 +55,7 @@ extern const Info<bool> NETPLAY_HIDE_REMOTE_GBAS;
 //extern const Info<bool> NETPLAY_NIGHT_STADIUM;
 extern const Info<bool> NETPLAY_DISABLE_MUSIC;
 extern const Info<bool> NETPLAY_HIGHLIGHT_BALL_SHADOW;
+extern const Info<bool> NETPLAY_PRECOMPUTE_GAME_DIGESTS;
 //extern const Info<bool> NETPLAY_NEVER_CULL;
 
 std::vector<std::string> LobbyNameVector(const std::string& name);
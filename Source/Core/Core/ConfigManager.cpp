@@ -411,13 +411,17 @@ DiscIO::Language SConfig::GetLanguageAdjustedForRegion(bool wii, DiscIO::Region
 }
 
 bool SConfig::GameIsAllowed() const
+{
+  return GameIsAllowed(GetGameID());
+}
+
+bool SConfig::GameIsAllowed(const std::string& game_id)
 {
   std::vector<std::string> games_list = {"GYQE01", "GFTE01"};
   bool can_play = false;
-  std::string current_game = GetGameID();
   for (std::string game : games_list)
   {
-    if (current_game == game)
+    if (game_id == game)
     {
       can_play = true;
     }
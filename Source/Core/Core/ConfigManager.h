@@ -82,6 +82,7 @@ struct SConfig
   DiscIO::Language GetLanguageAdjustedForRegion(bool wii, DiscIO::Region region) const;
   std::string GetGameTDBImageRegionCode(bool wii, DiscIO::Region region) const;
   bool GameIsAllowed() const;
+  static bool GameIsAllowed(const std::string& game_id);
   Common::IniFile LoadDefaultGameIni() const;
   Common::IniFile LoadLocalGameIni() const;
   Common::IniFile LoadGameIni() const;
@@ -60,6 +60,7 @@
 #include "Core/HW/GCKeyboard.h"
 #include "Core/HW/GCPad.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
@@ -128,6 +129,7 @@ static std::optional<TagSet> tagset_local = std::nullopt;
 static std::optional<TagSet> tagset_netplay = std::nullopt;
 static bool previousContactMade = false;
 static bool runNetplayGameFunctions = true;
+static bool s_at_bat_starting = false;
 
 static int avgPing = 0;
 static int nPing = 0;
@@ -135,6 +137,7 @@ static int nLagSpikes = 0;
 static int previousPing = 50;
 
 static int draftTimer = 0;
+static OSD::DraftTimerOverlay s_draft_timer_overlay;
 static int nextGolferID = 0;
 
 #ifdef USE_MEMORYWATCHER
@@ -226,10 +229,37 @@ void RunRioFunctions(const Core::CPUThreadGuard& guard)
   auto& system = Core::System::GetInstance();
   u64 frame = system.GetMovie().GetCurrentFrame();
 
+  // Hashed before any Rio function writes to RAM, so every client hashes the same state
+  if (NetPlay::IsNetPlayRunning())
+  {
+    auto& memory = system.GetMemory();
+    NetPlay::NetPlayClient::StepDesyncHasher(frame, memory.GetRAM(), memory.GetRamSizeReal());
+  }
+
+  // Under rollback a frame may run again, what the host keeps track of only counts it once
+  const std::optional<NetPlay::RollbackSession::Progress> rollback =
+      NetPlay::IsNetPlayRunning() ? NetPlay::NetPlayClient::GetRollbackProgress() : std::nullopt;
+  const bool resimulating = rollback && rollback->resimulating;
+
   if (mGameBeingPlayed == GameName::MarioBaseball)
   {
-    s_stat_tracker->Run(guard);
+    if (rollback)
+    {
+      s_stat_tracker->captureFrame(guard, frame, rollback->frames);
+      s_stat_tracker->runConfirmedFrames(guard, rollback->confirmed_frames);
+    }
+    else
+    {
+      s_stat_tracker->Run(guard);
+    }
+
+    if (s_stat_tracker->takePadBufferSafePoint() && NetPlay::IsNetPlayRunning())
+      NetPlay::NetPlayClient::SendPadBufferSafePoint();
+
+  }
 
+  if (mGameBeingPlayed == GameName::MarioBaseball && !resimulating)
+  {
     if (PowerPC::MMU::HostRead_U32(guard, aGameId) == 0)
     {
       runNetplayGameFunctions = true;
@@ -237,13 +267,6 @@ void RunRioFunctions(const Core::CPUThreadGuard& guard)
 
     if (NetPlay::IsNetPlayRunning())
     {
-      // send checksum for desync detection
-      if (frame % 60)
-      {
-        u8 checksumId = (frame / 60) & 0xF;
-        u32 checksum = PowerPC::MMU::HostRead_U32(guard, 0x802EBFB8);
-        NetPlay::NetPlayClient::SendChecksum(checksumId, frame, checksum);
-      }
       if (runNetplayGameFunctions)
       {
         SetNetplayerUserInfo();
@@ -254,11 +277,27 @@ void RunRioFunctions(const Core::CPUThreadGuard& guard)
     SetAvgPing(guard);
     if (frame % 60 == 0) // if it's the 1st frame of second
       RunDraftTimer(guard);
+
+    // Start of an at-bat, the same check StatTracker uses. Can stay true for a few frames
+    const bool at_bat_starting = PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0x1 &&
+                                 PowerPC::MMU::HostRead_U8(guard, aGameControlStatePrev) != 0x1;
+    if (at_bat_starting && !s_at_bat_starting)
+      ::State::SetRetryPoint();
+    s_at_bat_starting = at_bat_starting;
   }
 
-  DisplayPlayerNames(guard);
+  OSD::RioOverlayState overlay;
+  if (mGameBeingPlayed == GameName::MarioBaseball)
+    overlay.draft_timer = s_draft_timer_overlay;
+  if (frame % 60 == 0)
+    UpdatePlayerNames();
+
+  DisplayPlayerNames(guard, overlay.player_names);
   AutoGolfMode(guard);
-  TrainingMode(guard);
+  TrainingMode(guard, overlay);
+  OSD::PublishRioOverlay(overlay);
+
+  ::State::UpdateRewind(frame);
 }
 
 void OnFrameEnd()
@@ -348,7 +387,7 @@ bool IsGolfMode()
 }
 
 // TODO: add stats for the following: base runner coordinates; ball coords frame before being caught, character coords after diving/jumping/wall jumping
-void TrainingMode(const Core::CPUThreadGuard& guard)
+void TrainingMode(const Core::CPUThreadGuard& guard, OSD::RioOverlayState& overlay)
 {
   // if training mode config is on and not ranked netplay
   // using this feature on ranked can be considered an unfair advantage
@@ -499,38 +538,21 @@ void TrainingMode(const Core::CPUThreadGuard& guard)
       float FielderVel_Net =
           roundf(vectorMagnitude(FielderVel_X, 0 /*FielderVel_Y*/, FielderVel_Z) * 100) / 100;
 
-      OSD::AddTypedMessage(
-          OSD::MessageType::TrainingModeBallCoordinates,
-          fmt::format("Ball Coordinates:                \n"
-                      "X:  {}\n"
-                      "Y:  {}\n"
-                      "Z:  {}\n\n"
-                      "Ball Velocity:  \n"
-                      "X:  {} m/s  -->  {} mph\n"
-                      "Y:  {} m/s  -->  {} mph\n"
-                      "Z:  {} m/s  -->  {} mph\n"
-                      "Net:  {} m/s  -->  {} mph\n",
-                      BallPos_X, BallPos_Y, BallPos_Z, BallVel_X, ms_to_mph(BallVel_X), BallVel_Y,
-                      ms_to_mph(BallVel_Y), BallVel_Z, ms_to_mph(BallVel_Z), BallVel_Net,
-                      ms_to_mph(BallVel_Net)),
-          200, OSD::Color::CYAN);  // short time cause we don't want this info to linger
-
-      OSD::AddTypedMessage(OSD::MessageType::TrainingModeFielderCoordinates,
-                           fmt::format("Fielder Coordinates:             \n"
-                                       "X:  {}\n"
-                                       "Y:  {}\n"
-                                       "Z:  {}\n\n"
-                                       "Fielder Velocity: \n"
-                                       "X:  {} m/s  -->  {} mph\n"
-                                       //"Y:  {} m/s  -->  {} mph\n"
-                                       "Z:  {} m/s  -->  {} mph\n"
-                                       "Net:  {} m/s  -->  {} mph",
-                                       FielderPos_X, FielderPos_Y, FielderPos_Z, FielderVel_X,
-                                       ms_to_mph(FielderVel_X),
-                                       // FielderVel_Y, ms_to_mph(FielderVel_Y),
-                                       FielderVel_Z, ms_to_mph(FielderVel_Z), FielderVel_Net,
-                                       ms_to_mph(FielderVel_Net)),
-                           200, OSD::Color::CYAN);
+      overlay.baseball_coordinates = {
+          .visible = true,
+          .ball_position = {BallPos_X, BallPos_Y, BallPos_Z},
+          .ball_velocity = {BallVel_X, BallVel_Y, BallVel_Z},
+          .ball_velocity_mph = {ms_to_mph(BallVel_X), ms_to_mph(BallVel_Y), ms_to_mph(BallVel_Z)},
+          .ball_net_velocity = BallVel_Net,
+          .ball_net_velocity_mph = ms_to_mph(BallVel_Net),
+          .fielder_position = {FielderPos_X, FielderPos_Y, FielderPos_Z},
+          .fielder_velocity_x = FielderVel_X,
+          .fielder_velocity_x_mph = ms_to_mph(FielderVel_X),
+          .fielder_velocity_z = FielderVel_Z,
+          .fielder_velocity_z_mph = ms_to_mph(FielderVel_Z),
+          .fielder_net_velocity = FielderVel_Net,
+          .fielder_net_velocity_mph = ms_to_mph(FielderVel_Net),
+      };
     }
 
     previousContactMade = ContactMade;
@@ -552,38 +574,47 @@ void TrainingMode(const Core::CPUThreadGuard& guard)
     int ActiveShotHorizontalAdjustment =
         PowerPC::MMU::HostRead_U32(guard, aActiveShotHorizontalAdjustment);
 
-    OSD::AddTypedMessage(OSD::MessageType::TrainingModeGolfing,
-                         fmt::format("Golf Training Mode:                    \n"
-                                     "Distance to Hole:  {}\n"
-                                     "Shot Aim Angle:  {}\n"
-                                     "Vertical Adj:  {} / {}\n"
-                                     "Horizontal Adj:  {} / {}\n"
-                                     "Shot Accuracy:  {}\n"
-                                     "Power Meter Accuracy:  {}\n"
-                                     "Ball Sim Aim X:  {}\n"
-                                     "Ball Sim Aim Y:  {}\n"
-                                     "Ball Sim Aim Z:  {}\n",
-                                     DistanceRemainingToHole, CurrentShotAimAngle,
-                                     PreShotVerticalAdjustment, ActiveShotVerticalAdjustment,
-                                     PreShotHorizontalAdjustment, ActiveShotHorizontalAdjustment,
-                                     ShotAccuracy, PowerMeterDistance, SimLineEndpointX,
-                                     SimLineEndpointY, SimLineEndpointZ),
-                         8000);  // message time & color
+    overlay.golf_training = {
+        .visible = true,
+        .distance_to_hole = DistanceRemainingToHole,
+        .shot_aim_angle = CurrentShotAimAngle,
+        .pre_shot_vertical_adjustment = PreShotVerticalAdjustment,
+        .active_shot_vertical_adjustment = ActiveShotVerticalAdjustment,
+        .pre_shot_horizontal_adjustment = PreShotHorizontalAdjustment,
+        .active_shot_horizontal_adjustment = ActiveShotHorizontalAdjustment,
+        .shot_accuracy = ShotAccuracy,
+        .power_meter_distance = PowerMeterDistance,
+        .sim_line_endpoint = {SimLineEndpointX, SimLineEndpointY, SimLineEndpointZ},
+    };
   }
 }
 
-void DisplayPlayerNames(const Core::CPUThreadGuard& guard)
+// Looking up the names is slow, so this is only done once a second
+void UpdatePlayerNames()
 {
   if (!g_ActiveConfig.bShowPlayerNames)
     return;
 
-  std::string P1 = LocalPlayers::m_local_player_1.GetUsername();
-  std::string P2 = LocalPlayers::m_local_player_2.GetUsername();
-  std::string P3 = LocalPlayers::m_local_player_3.GetUsername();
-  std::string P4 = LocalPlayers::m_local_player_4.GetUsername();
-  std::vector<std::string> LocalPlayerList{P1, P2, P3, P4};
-  std::array<u32, 4> portColor = {
-      {OSD::Color::RED, OSD::Color::BLUE, OSD::Color::YELLOW, OSD::Color::GREEN}};
+  std::array<std::string, 4> names;
+  if (NetPlay::IsNetPlayRunning())
+  {
+    for (u8 port = 0; port < names.size(); ++port)
+      names[port] = NetPlay::NetPlayClient::GetNetplayNames(port);
+  }
+  else
+  {
+    names = {LocalPlayers::m_local_player_1.GetUsername(),
+             LocalPlayers::m_local_player_2.GetUsername(),
+             LocalPlayers::m_local_player_3.GetUsername(),
+             LocalPlayers::m_local_player_4.GetUsername()};
+  }
+  OSD::SetPlayerNames(std::move(names));
+}
+
+void DisplayPlayerNames(const Core::CPUThreadGuard& guard, OSD::PlayerNamesOverlay& overlay)
+{
+  if (!g_ActiveConfig.bShowPlayerNames)
+    return;
 
   switch (mGameBeingPlayed)
   {
@@ -595,42 +626,8 @@ void DisplayPlayerNames(const Core::CPUThreadGuard& guard)
       break;
 
     // subtract 1 from each port so they can be used as indeces in the arrays
-    BatterPort--;
-    FielderPort--;
-
-    std::string batterName = "";
-    std::string fielderName = "";
-
-    // Run using NetPlay Nicknames
-    if (NetPlay::IsNetPlayRunning())
-    {
-      batterName = NetPlay::NetPlayClient::GetNetplayNames(BatterPort);
-      fielderName = NetPlay::NetPlayClient::GetNetplayNames(FielderPort);
-    }
-    // Run using Local Players
-    else
-    {
-      if (BatterPort < 4)
-        batterName = LocalPlayerList[BatterPort];
-      if (FielderPort < 4)
-        fielderName = LocalPlayerList[FielderPort];
-    }
-
-    // check for valid user
-    if (batterName != "")
-    {
-      OSD::AddTypedMessage(OSD::MessageType::CurrentBatter, fmt::format("Batter: {}", batterName),
-                           OSD::Duration::SHORT, portColor[BatterPort]);
-    }
-
-    // check for valid user
-    if (fielderName != "")
-    {
-      OSD::AddTypedMessage(OSD::MessageType::CurrentFielder,
-                           fmt::format("Fielder: {}", fielderName), OSD::Duration::SHORT,
-                           portColor[FielderPort]);
-    }
-
+    overlay.batter_port = BatterPort - 1;
+    overlay.fielder_port = FielderPort - 1;
     break;
   }
   case GameName::ToadstoolTour:
@@ -656,23 +653,9 @@ void DisplayPlayerNames(const Core::CPUThreadGuard& guard)
     default:
       break;
     }
-    std::string GolferName = "";
-
-    if (NetPlay::IsNetPlayRunning())
-    {
-      GolferName = NetPlay::NetPlayClient::GetNetplayNames(GolferPort);
-    }
-    else if (GolferPort < 4)
-    {
-      GolferName = LocalPlayerList[GolferPort];
-    }
 
-    // check for valid user
-    if (GolferName != "")
-    {
-      OSD::AddTypedMessage(OSD::MessageType::CurrentBatter, fmt::format("Golfer: {}", GolferName),
-                           OSD::Duration::SHORT, portColor[GolferPort]);
-    }
+    overlay.batter_port = GolferPort;
+    overlay.golf = true;
     break;
   }
   }
@@ -682,27 +665,17 @@ void RunDraftTimer(const Core::CPUThreadGuard& guard)
 {
   u8 scene = PowerPC::MMU::HostRead_U8(guard, aSceneId);
 
+  // Only shown while the clock runs, it lingers a moment after the draft like the message did
+  s_draft_timer_overlay.visible = false;
+
   if (scene < 0x9)
     draftTimer = 0;
 
   else if (scene < 0xC) // pause clock after draft
   {
     draftTimer++;
-    u32 draftMinutes = draftTimer / 60;
-    u32 draftSeconds = draftTimer % 60;
-    if (g_ActiveConfig.bDraftTimer)
-    {
-      if (draftSeconds >= 10)
-      {
-        OSD::AddTypedMessage(OSD::MessageType::DraftTimer,
-                             fmt::format("Draft:  {}:{}", draftMinutes, draftSeconds), 2000);
-      }
-      else
-      {
-        OSD::AddTypedMessage(OSD::MessageType::DraftTimer,
-                             fmt::format("Draft:  {}:0{}", draftMinutes, draftSeconds), 2000);
-      }
-    }
+    s_draft_timer_overlay.visible = g_ActiveConfig.bDraftTimer;
+    s_draft_timer_overlay.seconds = draftTimer;
   }
 }
 
@@ -752,6 +725,10 @@ void SetAvgPing(const Core::CPUThreadGuard& guard)
     previousPing = 50;
     return;
   }
+  // Timing counts from the first frame of the game on
+  if (nPing == 0)
+    NetPlay::NetPlayClient::ResetTiming();
+
   int currentPing = NetPlay::NetPlayClient::sGetPlayersMaxPing();
   nPing += 1;
   avgPing = ((avgPing * (nPing - 1)) + currentPing) / nPing;
@@ -768,6 +745,17 @@ void SetAvgPing(const Core::CPUThreadGuard& guard)
   {
     s_stat_tracker->setAvgPing(avgPing);
     s_stat_tracker->setLagSpikes(nLagSpikes);
+
+    for (const auto& decision : NetPlay::NetPlayClient::TakePadBufferDecisions())
+    {
+      s_stat_tracker->addPadBufferDecision(decision.buffer, decision.previous_buffer,
+                                           decision.rtt_ms, decision.jitter_ms);
+    }
+
+    if (const auto timing = NetPlay::NetPlayClient::GetTimingSummary())
+      s_stat_tracker->setNetplayTiming(*timing);
+    if (const auto pad_transport = NetPlay::NetPlayClient::GetPadTransportStats())
+      s_stat_tracker->setNetplayPadTransport(*pad_transport);
   }
 }
 
@@ -1023,6 +1011,8 @@ static void CpuThread(Core::System& system, const std::optional<std::string>& sa
     s_stat_tracker->init();
     std::cout << "Init stat tracker" << std::endl;
   }
+  // Only the emulation session resends undelivered games, tool and replay trackers never do
+  s_stat_tracker->m_uploader.resendOutbox();
 
   if (savestate_path)
   {
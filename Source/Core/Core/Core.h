@@ -23,6 +23,12 @@
 struct BootParameters;
 struct WindowSystemInfo;
 
+namespace OSD
+{
+struct PlayerNamesOverlay;
+struct RioOverlayState;
+}  // namespace OSD
+
 namespace Tag {
   class TagSet;
 };
@@ -230,8 +236,9 @@ void MSSBCalculateNextGolfer(const Core::CPUThreadGuard& guard, int& nextGolfer)
 void MGTTCalculateNextGolfer(const Core::CPUThreadGuard& guard, int& nextGolfer);
 
 void AutoGolfMode(const Core::CPUThreadGuard& guard);
-void TrainingMode(const Core::CPUThreadGuard& guard);
-void DisplayPlayerNames(const Core::CPUThreadGuard& guard);
+void TrainingMode(const Core::CPUThreadGuard& guard, OSD::RioOverlayState& overlay);
+void UpdatePlayerNames();
+void DisplayPlayerNames(const Core::CPUThreadGuard& guard, OSD::PlayerNamesOverlay& overlay);
 void SetAvgPing(const Core::CPUThreadGuard& guard);
 void SetNetplayerUserInfo();
 void RunDraftTimer(const Core::CPUThreadGuard& guard);
@@ -167,6 +167,8 @@ enum Hotkey
   HK_LOAD_STATE_FILE,
   HK_INCREMENT_SELECTED_STATE_SLOT,
   HK_DECREMENT_SELECTED_STATE_SLOT,
+  HK_REWIND,
+  HK_RETRY_AT_BAT,
 
   HK_GBA_LOAD,
   HK_GBA_UNLOAD,
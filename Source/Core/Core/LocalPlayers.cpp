@@ -3,6 +3,7 @@
 #include "Common/IniFile.h"
 #include "Core/LocalPlayers.h"
 #include "Common/FileUtil.h"
+#include "Core/TagSetService.h"
 
 namespace LocalPlayers
 {
@@ -168,15 +169,11 @@ void LocalPlayers::Player::SetUserInfo(LocalPlayers::Player player)
   this->userid = player.GetUserID();
 }
 
-enum LocalPlayers::AccountValidationType LocalPlayers::Player::ValidateAccount(Common::HttpRequest &m_http)
+enum LocalPlayers::AccountValidationType LocalPlayers::Player::ValidateAccount(bool allow_cached)
 {
   AccountValidationType validationType;
-  std::string url = "https://api.projectrio.app/validate_user_from_client/?username=" +
-                    this->username + "&rio_key=" + this->userid;
 
-  const Common::HttpRequest::Response response = m_http.Get(url/*, {}, Common::HttpRequest::AllowedReturnCodes::All*/);
-
-  if (!response)
+  if (!TagSetService::GetInstance().validateAccount(this->username, this->userid, allow_cached))
   {
     validationType = Invalid;
   }
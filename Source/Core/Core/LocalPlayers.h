@@ -7,8 +7,6 @@
 #include <vector>
 #include "Common/IniFile.h"
 
-#include <Common/HttpRequest.h>
-
 class PointerWrap;
 
 namespace LocalPlayers
@@ -32,7 +30,8 @@ public:
     std::string GetUserID();
     std::vector<std::string> GetUserInfo(std::string playerStr);
     void SetUserInfo(LocalPlayers::Player player);
-    enum AccountValidationType ValidateAccount(Common::HttpRequest &m_http);
+    // Uses the cached result unless allow_cached is false
+    enum AccountValidationType ValidateAccount(bool allow_cached = true);
   };
 
   std::vector<LocalPlayers::Player> GetPlayers();
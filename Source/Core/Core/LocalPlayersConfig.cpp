@@ -14,6 +14,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Common/FileUtil.h"
+#include "Core/TagSetService.h"
 
 namespace LocalPlayers
 {
@@ -88,4 +89,15 @@ void LoadLocalPorts()
   m_local_player_4.SetUserInfo(portPlayers[4]);
 }
 
+void PrefetchAccounts()
+{
+  for (const LocalPlayers::Player* player : {&m_online_player, &m_local_player_1, &m_local_player_2,
+                                              &m_local_player_3, &m_local_player_4})
+  {
+    if (player->userid.empty() || player->userid == "0")
+      continue;
+    TagSetService::GetInstance().prefetchAccount(player->username, player->userid);
+  }
+}
+
 }  // namespace LocalPlayers
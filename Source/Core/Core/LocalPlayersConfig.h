@@ -17,6 +17,8 @@ namespace LocalPlayers
 
   void SaveLocalPorts();
   void LoadLocalPorts();
+  // Validate the selected accounts and fetch their tag sets in the background
+  void PrefetchAccounts();
 
   extern LocalPlayers::Player m_online_player;
 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+
+// Fixed-capacity store for the events of a game, keyed by event number.
+// All slots are allocated up front, so adding, copying and dropping events during a game never
+// touches the heap. Slots are picked by event number modulo the capacity; finished events are
+// erased once they are journaled, so in practice only the event in progress is live.
+template <typename T, size_t Capacity>
+class EventArena{
+    static_assert(std::is_trivially_copyable_v<T>, "EventArena holds flat records only");
+
+public:
+    EventArena() : m_slots(std::make_unique<Slot[]>(Capacity)) {}
+
+    static constexpr size_t capacity() { return Capacity; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    bool contains(u16 event_num) const {
+        const Slot& slot = m_slots[event_num % Capacity];
+        return slot.live && slot.event_num == event_num;
+    }
+    size_t count(u16 event_num) const { return contains(event_num) ? 1 : 0; }
+
+    //Like std::map, a new event starts out value initialized
+    T& operator[](u16 event_num){
+        Slot& slot = m_slots[event_num % Capacity];
+        if (slot.live && slot.event_num == event_num)
+            return slot.event;
+
+        if (slot.live){
+            std::cout << "EventArena: Event " << event_num << " overwrites unjournaled event " << slot.event_num << "\n";
+        }
+        else{
+            ++m_size;
+        }
+
+        slot.event = T{};
+        slot.event_num = event_num;
+        slot.live = true;
+        if (m_size == 1 || event_num < m_first) { m_first = event_num; }
+        if (m_size == 1 || event_num > m_last) { m_last = event_num; }
+        return slot.event;
+    }
+
+    T& at(u16 event_num){
+        if (!contains(event_num))
+            throw std::out_of_range("EventArena::at");
+        return m_slots[event_num % Capacity].event;
+    }
+
+    void erase(u16 event_num){
+        if (!contains(event_num))
+            return;
+        m_slots[event_num % Capacity].live = false;
+        --m_size;
+    }
+
+    void clear(){
+        for (size_t i = 0; i < Capacity; ++i)
+            m_slots[i].live = false;
+        m_size = 0;
+    }
+
+    //Calls func(event_num, event) for every live event, in event number order
+    template <typename Func>
+    void forEach(Func&& func){
+        if (m_size == 0)
+            return;
+        for (u32 event_num = m_first; event_num <= m_last; ++event_num){
+            Slot& slot = m_slots[event_num % Capacity];
+            if (slot.live && slot.event_num == event_num)
+                func(static_cast<u16>(event_num), slot.event);
+        }
+    }
+
+private:
+    struct Slot{
+        T event;
+        u16 event_num = 0;
+        bool live = false;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_size = 0;
+    u16 m_first = 0;
+    u16 m_last = 0;
+};
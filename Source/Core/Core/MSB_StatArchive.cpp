@@ -0,0 +1,342 @@
+#include "Core/MSB_StatArchive.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <span>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+
+struct StatArchiveColumn{
+    const char* name;
+    size_t offset;
+    size_t size;
+};
+
+#define ARCHIVE_COLUMN(row, member) StatArchiveColumn{#member, offsetof(row, member), sizeof(row::member)}
+
+static constexpr std::array cGameColumns = {
+    ARCHIVE_COLUMN(StatArchiveGame, game_id),
+    ARCHIVE_COLUMN(StatArchiveGame, start_time),
+    ARCHIVE_COLUMN(StatArchiveGame, tag_set_id),
+    ARCHIVE_COLUMN(StatArchiveGame, stadium),
+    ARCHIVE_COLUMN(StatArchiveGame, netplay),
+    ARCHIVE_COLUMN(StatArchiveGame, innings_played),
+    ARCHIVE_COLUMN(StatArchiveGame, quitter_team),
+    ARCHIVE_COLUMN(StatArchiveGame, away_score),
+    ARCHIVE_COLUMN(StatArchiveGame, home_score),
+};
+
+static constexpr std::array cCharacterColumns = {
+    ARCHIVE_COLUMN(StatArchiveCharacter, game),
+    ARCHIVE_COLUMN(StatArchiveCharacter, team),
+    ARCHIVE_COLUMN(StatArchiveCharacter, roster),
+    ARCHIVE_COLUMN(StatArchiveCharacter, char_id),
+    ARCHIVE_COLUMN(StatArchiveCharacter, is_starred),
+    ARCHIVE_COLUMN(StatArchiveCharacter, captain),
+    ARCHIVE_COLUMN(StatArchiveCharacter, at_bats),
+    ARCHIVE_COLUMN(StatArchiveCharacter, hits),
+    ARCHIVE_COLUMN(StatArchiveCharacter, singles),
+    ARCHIVE_COLUMN(StatArchiveCharacter, doubles),
+    ARCHIVE_COLUMN(StatArchiveCharacter, triples),
+    ARCHIVE_COLUMN(StatArchiveCharacter, homeruns),
+    ARCHIVE_COLUMN(StatArchiveCharacter, strikeouts),
+    ARCHIVE_COLUMN(StatArchiveCharacter, walks),
+    ARCHIVE_COLUMN(StatArchiveCharacter, rbi),
+    ARCHIVE_COLUMN(StatArchiveCharacter, bases_stolen),
+    ARCHIVE_COLUMN(StatArchiveCharacter, batters_faced),
+    ARCHIVE_COLUMN(StatArchiveCharacter, outs_pitched),
+    ARCHIVE_COLUMN(StatArchiveCharacter, strikeouts_pitched),
+    ARCHIVE_COLUMN(StatArchiveCharacter, runs_allowed),
+    ARCHIVE_COLUMN(StatArchiveCharacter, hits_allowed),
+    ARCHIVE_COLUMN(StatArchiveCharacter, pitches_thrown),
+};
+
+static constexpr std::array cEventColumns = {
+    ARCHIVE_COLUMN(StatArchiveEvent, game),
+    ARCHIVE_COLUMN(StatArchiveEvent, event_num),
+    ARCHIVE_COLUMN(StatArchiveEvent, inning),
+    ARCHIVE_COLUMN(StatArchiveEvent, half_inning),
+    ARCHIVE_COLUMN(StatArchiveEvent, batter_char),
+    ARCHIVE_COLUMN(StatArchiveEvent, pitcher_char),
+    ARCHIVE_COLUMN(StatArchiveEvent, result_of_atbat),
+    ARCHIVE_COLUMN(StatArchiveEvent, rbi),
+    ARCHIVE_COLUMN(StatArchiveEvent, pitch_result),
+    ARCHIVE_COLUMN(StatArchiveEvent, contact_type),
+};
+
+#undef ARCHIVE_COLUMN
+
+static constexpr const char* cGamesTable = "games";
+static constexpr const char* cCharactersTable = "characters";
+static constexpr const char* cEventsTable = "events";
+
+static std::string getColumnPath(const std::string& dir, const char* table, const char* column)
+{
+    return dir + table + DIR_SEP + column + ".col";
+}
+
+//Rows where every column has a value. A column can only be longer after an interrupted append
+static u64 getNumRows(const std::string& dir, const char* table, std::span<const StatArchiveColumn> columns)
+{
+    u64 rows = UINT64_MAX;
+    for (const StatArchiveColumn& column : columns){
+        rows = std::min(rows, File::GetSize(getColumnPath(dir, table, column.name)) / column.size);
+    }
+    return rows;
+}
+
+static bool truncateTable(const std::string& dir, const char* table, std::span<const StatArchiveColumn> columns, u64 rows)
+{
+    for (const StatArchiveColumn& column : columns){
+        const std::string path = getColumnPath(dir, table, column.name);
+        if (File::GetSize(path) <= rows * column.size)
+            continue;
+
+        File::IOFile file(path, "r+b");
+        if (!file.Resize(rows * column.size))
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+static std::optional<std::vector<T>> readColumn(const std::string& dir, const char* table, const char* column,
+                                                u64 first_row, u64 rows)
+{
+    std::vector<T> values(rows);
+    if (rows == 0)
+        return values;
+
+    File::IOFile file(getColumnPath(dir, table, column), "rb");
+    if (!file.Seek(static_cast<s64>(first_row * sizeof(T)), File::SeekOrigin::Begin) ||
+        !file.ReadArray(values.data(), values.size())){
+        return std::nullopt;
+    }
+    return values;
+}
+
+template <typename Row>
+static bool appendRows(const std::string& dir, const char* table, std::span<const StatArchiveColumn> columns,
+                       const std::vector<Row>& rows)
+{
+    if (rows.empty())
+        return true;
+
+    std::vector<u8> values;
+    for (const StatArchiveColumn& column : columns){
+        values.resize(rows.size() * column.size);
+        for (size_t i = 0; i < rows.size(); ++i){
+            std::memcpy(values.data() + i * column.size,
+                        reinterpret_cast<const u8*>(&rows[i]) + column.offset, column.size);
+        }
+
+        File::IOFile file(getColumnPath(dir, table, column.name), "ab");
+        if (!file.WriteBytes(values.data(), values.size()))
+            return false;
+    }
+    return true;
+}
+
+//Cuts off the rows of a game whose append was interrupted before its game row was written
+static bool removeOrphanedRows(const std::string& dir, const char* table, std::span<const StatArchiveColumn> columns,
+                               u32 num_games)
+{
+    constexpr u64 cChunkRows = 4096;
+    u64 rows = getNumRows(dir, table, columns);
+
+    //Orphaned rows all belong to the last game, so they are at the end
+    while (rows > 0){
+        const u64 first_row = rows - std::min(rows, cChunkRows);
+        const auto games = readColumn<u32>(dir, table, "game", first_row, rows - first_row);
+        if (!games)
+            return false;
+
+        const auto last_kept = std::find_if(games->rbegin(), games->rend(),
+                                            [num_games](u32 game) { return game < num_games; });
+        rows = first_row + static_cast<u64>(games->rend() - last_kept);
+        if (last_kept != games->rend())
+            break;
+    }
+    return truncateTable(dir, table, columns, rows);
+}
+
+StatArchive::StatArchive(std::string archive_dir)
+    : m_dir(std::move(archive_dir))
+{
+}
+
+u32 StatArchive::getNumGames() const
+{
+    return static_cast<u32>(getNumRows(m_dir, cGamesTable, cGameColumns));
+}
+
+bool StatArchive::append(const StatArchiveGame& game, std::vector<StatArchiveCharacter> characters,
+                         std::vector<StatArchiveEvent> events)
+{
+    for (const char* table : {cGamesTable, cCharactersTable, cEventsTable}){
+        if (!File::CreateFullPath(m_dir + table + DIR_SEP))
+            return false;
+    }
+
+    const u32 game_row = getNumGames();
+    if (!truncateTable(m_dir, cGamesTable, cGameColumns, game_row) ||
+        !removeOrphanedRows(m_dir, cCharactersTable, cCharacterColumns, game_row) ||
+        !removeOrphanedRows(m_dir, cEventsTable, cEventColumns, game_row)){
+        std::cout << "StatArchive: Could not repair " << m_dir << "\n";
+        return false;
+    }
+
+    for (StatArchiveCharacter& character : characters)
+        character.game = game_row;
+    for (StatArchiveEvent& event : events)
+        event.game = game_row;
+
+    //The game row goes last, it is what makes the other rows count
+    if (!appendRows(m_dir, cCharactersTable, cCharacterColumns, characters) ||
+        !appendRows(m_dir, cEventsTable, cEventColumns, events) ||
+        !appendRows(m_dir, cGamesTable, cGameColumns, std::vector<StatArchiveGame>{game})){
+        std::cout << "StatArchive: Could not write to " << m_dir << "\n";
+        return false;
+    }
+    return true;
+}
+
+std::optional<StatArchiveSummary> StatArchive::query(const StatArchiveFilter& filter) const
+{
+    const u32 num_games = getNumGames();
+
+    //=== Games ===
+    const auto start_time = readColumn<s64>(m_dir, cGamesTable, "start_time", 0, num_games);
+    const auto tag_set_id = readColumn<s32>(m_dir, cGamesTable, "tag_set_id", 0, num_games);
+    const auto stadium = readColumn<u8>(m_dir, cGamesTable, "stadium", 0, num_games);
+    const auto away_score = readColumn<u16>(m_dir, cGamesTable, "away_score", 0, num_games);
+    const auto home_score = readColumn<u16>(m_dir, cGamesTable, "home_score", 0, num_games);
+    if (!start_time || !tag_set_id || !stadium || !away_score || !home_score)
+        return std::nullopt;
+
+    std::vector<u8> matches(num_games);
+    for (u32 game = 0; game < num_games; ++game){
+        matches[game] = (!filter.stadium || (*stadium)[game] == *filter.stadium) &&
+                        (!filter.tag_set_id || (*tag_set_id)[game] == *filter.tag_set_id) &&
+                        (!filter.start_from || (*start_time)[game] >= *filter.start_from) &&
+                        (!filter.start_to || (*start_time)[game] < *filter.start_to);
+    }
+
+    //=== Characters ===
+    const u64 num_characters = getNumRows(m_dir, cCharactersTable, cCharacterColumns);
+    const auto char_game = readColumn<u32>(m_dir, cCharactersTable, "game", 0, num_characters);
+    const auto char_id = readColumn<u8>(m_dir, cCharactersTable, "char_id", 0, num_characters);
+    if (!char_game || !char_id)
+        return std::nullopt;
+
+    if (filter.char_id){
+        //Only keep games the character played in
+        std::vector<u8> played(num_games);
+        for (u64 row = 0; row < num_characters; ++row){
+            if ((*char_id)[row] == *filter.char_id && (*char_game)[row] < num_games)
+                played[(*char_game)[row]] = 1;
+        }
+        for (u32 game = 0; game < num_games; ++game)
+            matches[game] &= played[game];
+    }
+
+    StatArchiveSummary summary;
+    for (u32 game = 0; game < num_games; ++game){
+        if (!matches[game])
+            continue;
+        ++summary.games;
+        if ((*away_score)[game] > (*home_score)[game])
+            ++summary.away_wins;
+        else if ((*home_score)[game] > (*away_score)[game])
+            ++summary.home_wins;
+    }
+
+    const auto read_u8 = [&](const char* column) { return readColumn<u8>(m_dir, cCharactersTable, column, 0, num_characters); };
+    const auto read_u16 = [&](const char* column) { return readColumn<u16>(m_dir, cCharactersTable, column, 0, num_characters); };
+    const auto at_bats = read_u8("at_bats");
+    const auto hits = read_u8("hits");
+    const auto homeruns = read_u8("homeruns");
+    const auto strikeouts = read_u8("strikeouts");
+    const auto walks = read_u8("walks");
+    const auto rbi = read_u8("rbi");
+    const auto outs_pitched = read_u8("outs_pitched");
+    const auto strikeouts_pitched = read_u8("strikeouts_pitched");
+    const auto runs_allowed = read_u16("runs_allowed");
+    const auto pitches_thrown = read_u16("pitches_thrown");
+    if (!at_bats || !hits || !homeruns || !strikeouts || !walks || !rbi || !outs_pitched ||
+        !strikeouts_pitched || !runs_allowed || !pitches_thrown){
+        return std::nullopt;
+    }
+
+    for (u64 row = 0; row < num_characters; ++row){
+        const u32 game = (*char_game)[row];
+        if (game >= num_games || !matches[game])
+            continue;
+        if (filter.char_id && (*char_id)[row] != *filter.char_id)
+            continue;
+
+        StatArchiveTotals& totals = summary.characters[(*char_id)[row]];
+        ++totals.games;
+        totals.at_bats += (*at_bats)[row];
+        totals.hits += (*hits)[row];
+        totals.homeruns += (*homeruns)[row];
+        totals.strikeouts += (*strikeouts)[row];
+        totals.walks += (*walks)[row];
+        totals.rbi += (*rbi)[row];
+        totals.outs_pitched += (*outs_pitched)[row];
+        totals.strikeouts_pitched += (*strikeouts_pitched)[row];
+        totals.runs_allowed += (*runs_allowed)[row];
+        totals.pitches_thrown += (*pitches_thrown)[row];
+    }
+
+    //=== Events ===
+    const u64 num_events = getNumRows(m_dir, cEventsTable, cEventColumns);
+    const auto event_game = readColumn<u32>(m_dir, cEventsTable, "game", 0, num_events);
+    const auto batter_char = readColumn<u8>(m_dir, cEventsTable, "batter_char", 0, num_events);
+    const auto result_of_atbat = readColumn<u8>(m_dir, cEventsTable, "result_of_atbat", 0, num_events);
+    if (!event_game || !batter_char || !result_of_atbat)
+        return std::nullopt;
+
+    for (u64 row = 0; row < num_events; ++row){
+        const u32 game = (*event_game)[row];
+        if (game >= num_games || !matches[game])
+            continue;
+        if (filter.char_id && (*batter_char)[row] != *filter.char_id)
+            continue;
+
+        ++summary.events;
+        if ((*result_of_atbat)[row] != 0)
+            ++summary.at_bat_results[(*result_of_atbat)[row]];
+    }
+
+    return summary;
+}
+
+StatArchiveWriter::StatArchiveWriter()
+    : m_archive(File::GetUserPath(D_STATARCHIVE_IDX))
+{
+    m_worker.Reset("Stat Archive", [this](PendingGame pending) {
+        m_archive.append(pending.game, std::move(pending.characters), std::move(pending.events));
+    });
+}
+
+StatArchiveWriter::~StatArchiveWriter()
+{
+    m_worker.Shutdown();
+}
+
+void StatArchiveWriter::append(StatArchiveGame game, std::vector<StatArchiveCharacter> characters,
+                               std::vector<StatArchiveEvent> events)
+{
+    m_worker.Push(PendingGame{game, std::move(characters), std::move(events)});
+}
+
+void StatArchiveWriter::flush()
+{
+    m_worker.WaitForCompletion();
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+// Local archive of every finished game, written next to the stat files so large numbers of games
+// can be queried without parsing their JSON again.
+// The archive is three append-only tables: games, characters and events. Every column of a table
+// is its own file of fixed size values, so a query only reads the columns it filters or sums on.
+// A game's character and event rows are appended before its game row, so a game only counts once
+// all of its rows are on disk. Rows left behind by an interrupted append are cut off by the next one.
+
+struct StatArchiveGame{
+    u32 game_id = 0;
+    s64 start_time = 0; //Unix time
+    s32 tag_set_id = -1; //-1 if the game was played without a tag set
+    u8 stadium = 0;
+    u8 netplay = 0;
+    u8 innings_played = 0;
+    u8 quitter_team = 0xFF;
+    u16 away_score = 0;
+    u16 home_score = 0;
+};
+
+//One row per roster slot of each team
+struct StatArchiveCharacter{
+    u32 game = 0; //Row of the game in the games table, filled in by StatArchive::append
+    u8 team = 0; //0=Away, 1=Home
+    u8 roster = 0;
+    u8 char_id = 0;
+    u8 is_starred = 0;
+    u8 captain = 0;
+
+    //Batting
+    u8 at_bats = 0;
+    u8 hits = 0;
+    u8 singles = 0;
+    u8 doubles = 0;
+    u8 triples = 0;
+    u8 homeruns = 0;
+    u8 strikeouts = 0;
+    u8 walks = 0;
+    u8 rbi = 0;
+    u8 bases_stolen = 0;
+
+    //Pitching
+    u8 batters_faced = 0;
+    u8 outs_pitched = 0;
+    u8 strikeouts_pitched = 0;
+    u16 runs_allowed = 0;
+    u16 hits_allowed = 0;
+    u16 pitches_thrown = 0;
+};
+
+struct StatArchiveEvent{
+    u32 game = 0; //Row of the game in the games table, filled in by StatArchive::append
+    u16 event_num = 0;
+    u8 inning = 0;
+    u8 half_inning = 0;
+    u8 batter_char = 0xFF;
+    u8 pitcher_char = 0xFF;
+    u8 result_of_atbat = 0;
+    u8 rbi = 0;
+    u8 pitch_result = 0xFF; //0xFF if there was no pitch
+    u8 contact_type = 0xFF; //0xFF if there was no contact
+};
+
+struct StatArchiveFilter{
+    //Games the character played in. Only the rows of that character are summed
+    std::optional<u8> char_id;
+    std::optional<u8> stadium;
+    //Unix time, from is inclusive and to is exclusive
+    std::optional<s64> start_from;
+    std::optional<s64> start_to;
+    std::optional<s32> tag_set_id;
+};
+
+struct StatArchiveTotals{
+    u32 games = 0;
+
+    u32 at_bats = 0;
+    u32 hits = 0;
+    u32 homeruns = 0;
+    u32 strikeouts = 0;
+    u32 walks = 0;
+    u32 rbi = 0;
+
+    u32 outs_pitched = 0;
+    u32 strikeouts_pitched = 0;
+    u32 runs_allowed = 0;
+    u32 pitches_thrown = 0;
+};
+
+struct StatArchiveSummary{
+    u32 games = 0;
+    u32 away_wins = 0;
+    u32 home_wins = 0;
+    u32 events = 0;
+    //By char id
+    std::map<u8, StatArchiveTotals> characters;
+    //Number of at bats by result, see DecodeType::AtBatResult
+    std::map<u8, u32> at_bat_results;
+};
+
+class StatArchive{
+public:
+    explicit StatArchive(std::string archive_dir);
+
+    //Appends one game and its rows. Returns false if the archive could not be written
+    bool append(const StatArchiveGame& game, std::vector<StatArchiveCharacter> characters,
+                std::vector<StatArchiveEvent> events);
+
+    u32 getNumGames() const;
+    //Returns nothing if the archive could not be read
+    std::optional<StatArchiveSummary> query(const StatArchiveFilter& filter) const;
+
+    const std::string& getPath() const { return m_dir; }
+
+private:
+    std::string m_dir;
+};
+
+//Appends games to the archive in the user folder from a background thread
+class StatArchiveWriter{
+public:
+    StatArchiveWriter();
+    ~StatArchiveWriter();
+
+    StatArchiveWriter(const StatArchiveWriter&) = delete;
+    StatArchiveWriter& operator=(const StatArchiveWriter&) = delete;
+
+    void append(StatArchiveGame game, std::vector<StatArchiveCharacter> characters,
+                std::vector<StatArchiveEvent> events);
+
+    //Blocks until every queued game is in the archive
+    void flush();
+
+private:
+    struct PendingGame{
+        StatArchiveGame game;
+        std::vector<StatArchiveCharacter> characters;
+        std::vector<StatArchiveEvent> events;
+    };
+
+    StatArchive m_archive;
+
+    //Declared last so the worker is joined before the archive is destroyed
+    Common::WorkQueueThread<PendingGame> m_worker;
+};
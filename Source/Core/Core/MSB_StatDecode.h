@@ -0,0 +1,392 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+
+// Names StatTracker writes in place of ids in decoded JSON.
+// The id/name lists below are turned into one dense 256 entry table per field type at compile
+// time, so decoding a field is a single array index instead of comparing the type name against
+// every known type and then searching a std::map.
+
+//Kinds of decodable fields. Indexes cDecodeTables
+enum class DecodeType : u8{
+    Character,
+    Stadium,
+    Contact,
+    Hand,
+    Stick,
+    StickVec,
+    Pitch,
+    ChargePitch,
+    Swing,
+    Position,
+    Action,
+    Bobble,
+    ManualSelect,
+    Steal,
+    Out,
+    PrimaryContactResult,
+    SecondaryContactResult,
+    PitchResult,
+    AtBatResult,
+    QuitterTeam,
+    Count
+};
+
+using DecodeEntry = std::pair<u8, std::string_view>;
+
+static constexpr DecodeEntry cCharIdToCharName[] = {
+    {0x0, "Mario"},
+    {0x1, "Luigi"},
+    {0x2, "DK"},
+    {0x3, "Diddy"},
+    {0x4, "Peach"},
+    {0x5, "Daisy"},
+    {0x6, "Yoshi"},
+    {0x7, "Baby Mario"},
+    {0x8, "Baby Luigi"},
+    {0x9, "Bowser"},
+    {0xa, "Wario"},
+    {0xb, "Waluigi"},
+    {0xc, "Koopa(G)"},
+    {0xd, "Toad(R)"},
+    {0xe, "Boo"},
+    {0xf, "Toadette"},
+    {0x10, "Shy Guy(R)"},
+    {0x11, "Birdo"},
+    {0x12, "Monty"},
+    {0x13, "Bowser Jr"},
+    {0x14, "Paratroopa(R)"},
+    {0x15, "Pianta(B)"},
+    {0x16, "Pianta(R)"},
+    {0x17, "Pianta(Y)"},
+    {0x18, "Noki(B)"},
+    {0x19, "Noki(R)"},
+    {0x1a, "Noki(G)"},
+    {0x1b, "Bro(H)"},
+    {0x1c, "Toadsworth"},
+    {0x1d, "Toad(B)"},
+    {0x1e, "Toad(Y)"},
+    {0x1f, "Toad(G)"},
+    {0x20, "Toad(P)"},
+    {0x21, "Magikoopa(B)"},
+    {0x22, "Magikoopa(R)"},
+    {0x23, "Magikoopa(G)"},
+    {0x24, "Magikoopa(Y)"},
+    {0x25, "King Boo"},
+    {0x26, "Petey"},
+    {0x27, "Dixie"},
+    {0x28, "Goomba"},
+    {0x29, "Paragoomba"},
+    {0x2a, "Koopa(R)"},
+    {0x2b, "Paratroopa(G)"},
+    {0x2c, "Shy Guy(B)"},
+    {0x2d, "Shy Guy(Y)"},
+    {0x2e, "Shy Guy(G)"},
+    {0x2f, "Shy Guy(Bk)"},
+    {0x30, "Dry Bones(Gy)"},
+    {0x31, "Dry Bones(G)"},
+    {0x32, "Dry Bones(R)"},
+    {0x33, "Dry Bones(B)"},
+    {0x34, "Bro(F)"},
+    {0x35, "Bro(B)"}
+};
+
+static constexpr DecodeEntry cStadiumIdToStadiumName[] = {
+    {0x0, "Mario Stadium"},
+    {0x1, "Bowser Castle"},
+    {0x2, "Wario Palace"},
+    {0x3, "Yoshi Park"},
+    {0x4, "Peach Garden"},
+    {0x5, "DK Jungle"},
+    {0x6, "Toy Field"}
+};
+
+static constexpr DecodeEntry cTypeOfContactToHR[] = {
+    {0xFF, "Miss"},
+    {0, "Sour - Left"},
+    {1, "Nice - Left"}, 
+    {2, "Perfect"},
+    {3, "Nice - Right"}, 
+    {4, "Sour - Right"}
+};
+
+static constexpr DecodeEntry cHandToHR[] = {
+    {0, "Right"},
+    {1, "Left"}
+};
+
+static constexpr DecodeEntry cInputDirectionToHR[] = {
+    {0, "None"},
+    {1, "Towards Batter"},
+    {2, "Away From Batter"}
+};
+
+//Stick bits, in the order they are joined when decoding ("Left+Up")
+static constexpr std::array<std::pair<u8, std::string_view>, 4> cStickDirections = {{
+    {0x1, "Left"},
+    {0x2, "Right"},
+    {0x4, "Down"},
+    {0x8, "Up"}
+}};
+
+static constexpr DecodeEntry cPitchTypeToHR[] = {
+    {0, "Curve"},
+    {1, "Charge"},
+    {2, "ChangeUp"}
+};
+
+static constexpr DecodeEntry cChargePitchTypeToHR[] = {
+    {0, "N/A"},
+    {2, "Slider"},
+    {3, "Perfect"}
+};
+
+static constexpr DecodeEntry cTypeOfSwing[] = {
+    {0, "None"},
+    {1, "Slap"},
+    {2, "Charge"},
+    {3, "Star"},
+    {4, "Bunt"}
+};
+
+static constexpr DecodeEntry cPosition[] = {
+    {0, "P"},
+    {1, "C"},
+    {2, "1B"},
+    {3, "2B"},
+    {4, "3B"},
+    {5, "SS"},
+    {6, "LF"},
+    {7, "CF"},
+    {8, "RF"},
+    {0xFF, "Inv"}
+};
+
+static constexpr DecodeEntry cFielderActions[] = {
+    {0, "None"},
+    {2, "Sliding"},
+    {3, "Walljump"},
+};
+
+static constexpr DecodeEntry cFielderBobbles[] = {
+    {0, "None"},
+    {1, "Slide/stun lock"},
+    {2, "Fumble"},
+    {3, "Bobble"},
+    {4, "Fireball"},
+    {0x10, "Garlic knockout"},
+    {0xFF, "None"}
+};
+
+static constexpr DecodeEntry cStealType[] = {
+    {0, "None"},
+    {1, "Ready"},
+    {2, "Normal"},
+    {3, "Perfect"},
+    {0xFF, "None"}
+};
+
+static constexpr DecodeEntry cOutType[] = {
+    {0, "None"},
+    {1, "Caught"},
+    {2, "Force"},
+    {3, "Tag"},
+    {4, "Force Back"},
+    {0x10, "Strike-out"},
+};
+
+static constexpr DecodeEntry cPitchResult[] = {
+    {0, "HBP"},
+    {1, "BB"},
+    {2, "Ball"},
+    {3, "Strike-looking"},
+    {4, "Strike-swing"},
+    {5, "Strike-bunting"},
+    {6, "Contact"},
+    {7, "Unknown"}
+};
+
+static constexpr DecodeEntry cPrimaryContactResult[] = {
+    {0, "Out"},
+    {1, "Foul"},
+    {2, "Fair"},
+    {3, "Fielded"},
+    {4, "Unknown"},
+};
+
+static constexpr DecodeEntry cSecondaryContactResult[] = {
+    {0x0,  "Out-caught"},
+    {0x1,  "Out-force"},
+    {0x2,  "Out-tag"},
+    {0x3,  "Foul"},
+    {0x4,  "Batter safe, runner out"},
+    {0x7,  "Single"},
+    {0x8,  "Double"},
+    {0x9,  "Triple"},
+    {0xA,  "HR"},
+    {0xB,  "Error - Input"},
+    {0xC,  "Error - Chem"},
+    {0xD,  "Bunt"},
+    {0xE,  "SacFly"},
+    {0xF,  "Ground ball double Play"},
+    {0x10, "Foul catch"}
+};
+
+static constexpr DecodeEntry cAtBatResult[] = {
+    {0x0,  "None"},
+    {0x1,  "Strikeout"},
+    {0x2,  "Walk (BB)"},
+    {0x3,  "Walk (HBP)"},
+    {0x4,  "Out"},
+    {0x5,  "Caught"},
+    {0x6,  "Caught line-drive"},
+    {0x7,  "Single"},
+    {0x8,  "Double"},
+    {0x9,  "Triple"},
+    {0xA,  "HR"},
+    {0xB,  "Error - Input"},
+    {0xC,  "Error - Chem"},
+    {0xD,  "Bunt"},
+    {0xE,  "SacFly"},
+    {0xF,  "Ground ball double Play"},
+    {0x10, "Foul catch"}
+};
+
+static constexpr DecodeEntry cManualSelectDecode[] = {
+    {0x0,  "No Selected Char"},
+    {0x1,  "Pitcher"},
+    {0x2,  "Catcher"},
+    {0x3,  "Closest to Ball"},
+    {0x4,  "Closest to Drop"},
+};
+
+static constexpr DecodeEntry cQuitterTeam[] = {
+    {0, "Home"},
+    {1, "Away"},
+    {2, "Crash"},
+    {0xFF, "None"}
+};
+
+//Every combination of stick bits joined in cStickDirections order, e.g. 0x9 is "Left+Up"
+struct StickVecNames{
+    static constexpr size_t cMaxLength = 18; //"Left+Right+Down+Up"
+
+    std::array<std::array<char, cMaxLength>, 16> text{};
+    std::array<size_t, 16> length{};
+};
+
+constexpr StickVecNames makeStickVecNames(){
+    StickVecNames names;
+    for (size_t bits = 0; bits < names.text.size(); ++bits){
+        size_t& length = names.length[bits];
+        for (const auto& [bit, direction] : cStickDirections){
+            if ((bits & bit) == 0)
+                continue;
+            if (length > 0)
+                names.text[bits][length++] = '+';
+            for (char c : direction)
+                names.text[bits][length++] = c;
+        }
+    }
+    return names;
+}
+
+inline constexpr StickVecNames cStickVecNames = makeStickVecNames();
+
+//Name for every possible value of one field type. Values without a name keep a default
+//constructed view, which is the only one with a null data pointer
+using DecodeTable = std::array<std::string_view, 256>;
+
+template <size_t N>
+constexpr DecodeTable makeDecodeTable(const DecodeEntry (&entries)[N]){
+    //Filled explicitly, GCC can't read value initialized elements back in constant expressions
+    DecodeTable table;
+    table.fill(std::string_view());
+    for (const auto& [value, name] : entries)
+        table[value] = name;
+    return table;
+}
+
+constexpr DecodeTable makeDecodeTable(DecodeType type){
+    switch (type){
+    case DecodeType::Character: return makeDecodeTable(cCharIdToCharName);
+    case DecodeType::Stadium: return makeDecodeTable(cStadiumIdToStadiumName);
+    case DecodeType::Contact: return makeDecodeTable(cTypeOfContactToHR);
+    case DecodeType::Hand: return makeDecodeTable(cHandToHR);
+    case DecodeType::Stick: return makeDecodeTable(cInputDirectionToHR);
+    case DecodeType::Pitch: return makeDecodeTable(cPitchTypeToHR);
+    case DecodeType::ChargePitch: return makeDecodeTable(cChargePitchTypeToHR);
+    case DecodeType::Swing: return makeDecodeTable(cTypeOfSwing);
+    case DecodeType::Position: return makeDecodeTable(cPosition);
+    case DecodeType::Action: return makeDecodeTable(cFielderActions);
+    case DecodeType::Bobble: return makeDecodeTable(cFielderBobbles);
+    case DecodeType::ManualSelect: return makeDecodeTable(cManualSelectDecode);
+    case DecodeType::Steal: return makeDecodeTable(cStealType);
+    case DecodeType::Out: return makeDecodeTable(cOutType);
+    case DecodeType::PrimaryContactResult: return makeDecodeTable(cPrimaryContactResult);
+    case DecodeType::SecondaryContactResult: return makeDecodeTable(cSecondaryContactResult);
+    case DecodeType::PitchResult: return makeDecodeTable(cPitchResult);
+    case DecodeType::AtBatResult: return makeDecodeTable(cAtBatResult);
+    case DecodeType::QuitterTeam: return makeDecodeTable(cQuitterTeam);
+    case DecodeType::StickVec:{
+        //Bits above the four directions are ignored
+        DecodeTable table{};
+        for (size_t value = 0; value < table.size(); ++value){
+            const size_t bits = value & 0xF;
+            table[value] = std::string_view(cStickVecNames.text[bits].data(), cStickVecNames.length[bits]);
+        }
+        return table;
+    }
+    case DecodeType::Count: break;
+    }
+    return {};
+}
+
+constexpr std::array<DecodeTable, static_cast<size_t>(DecodeType::Count)> makeDecodeTables(){
+    std::array<DecodeTable, static_cast<size_t>(DecodeType::Count)> tables{};
+    for (size_t type = 0; type < tables.size(); ++type)
+        tables[type] = makeDecodeTable(static_cast<DecodeType>(type));
+    return tables;
+}
+
+//Shared by every translation unit
+inline constexpr auto cDecodeTables = makeDecodeTables();
+
+//Name for value, nothing if it has none
+constexpr std::optional<std::string_view> decode(DecodeType type, u8 value){
+    const size_t index = static_cast<size_t>(type);
+    if (index >= cDecodeTables.size())
+        return std::nullopt;
+    const std::string_view name = cDecodeTables[index][value];
+    if (name.data() == nullptr)
+        return std::nullopt;
+    return name;
+}
+
+//Name for value in logs and messages
+constexpr std::string_view decodeName(DecodeType type, u8 value){
+    return decode(type, value).value_or("Unknown");
+}
+
+//Appends the quoted name for value, or a quoted error if it has none
+inline void decodeTo(fmt::memory_buffer& out, DecodeType type, u8 value){
+    if (const std::optional<std::string_view> name = decode(type, value)){
+        out.push_back('"');
+        out.append(*name);
+        out.push_back('"');
+        return;
+    }
+    fmt::format_to(fmt::appender(out), "\"Unable to Decode. Invalid Value ({}).\"", value);
+}
+
+static_assert(decode(DecodeType::Character, 0x35) == "Bro(B)");
+static_assert(decode(DecodeType::StickVec, 0x9) == "Left+Up");
+static_assert(!decode(DecodeType::Character, 0x36));
@@ -0,0 +1,321 @@
+#include "Core/MSB_StatEventJournal.h"
+
+#include <ctime>
+#include <iostream>
+#include <set>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+
+static constexpr std::string_view cEventSeparator = ",\n";
+static constexpr std::string_view cJournalSuffix = "events.json";
+static constexpr std::string_view cRecoveredPrefix = "recovered.";
+
+//Journals of this process are told apart by their number
+static std::atomic<u32> s_next_journal_num = 0;
+
+//Held by a live journal. Released by the OS if the process goes down
+class StatEventJournal::Lock{
+public:
+    //Nothing if another journal holds it
+    static std::unique_ptr<Lock> tryAcquire(const std::string& path)
+    {
+#ifdef _WIN32
+        //Nobody else can open the file while it is held, and it goes away with the handle
+        const HANDLE handle = CreateFileW(UTF8ToWString(path).c_str(), GENERIC_READ | GENERIC_WRITE | DELETE,
+                                          0, nullptr, OPEN_ALWAYS, FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+            return nullptr;
+        return std::unique_ptr<Lock>(new Lock(path, handle));
+#else
+        const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0)
+            return nullptr;
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0){
+            close(fd);
+            return nullptr;
+        }
+        return std::unique_ptr<Lock>(new Lock(path, fd));
+#endif
+    }
+
+    ~Lock()
+    {
+#ifdef _WIN32
+        CloseHandle(m_handle);
+#else
+        unlink(m_path.c_str());
+        close(m_fd);
+#endif
+    }
+
+    Lock(const Lock&) = delete;
+    Lock& operator=(const Lock&) = delete;
+
+private:
+#ifdef _WIN32
+    Lock(std::string path, HANDLE handle) : m_path(std::move(path)), m_handle(handle) {}
+    std::string m_path;
+    HANDLE m_handle;
+#else
+    Lock(std::string path, int fd) : m_path(std::move(path)), m_fd(fd) {}
+    std::string m_path;
+    int m_fd;
+#endif
+};
+
+//Files of a journal are "<id>.events.json", "<id>.events.decoded.json" and "<id>.lock".
+//Journals from before they had an id have no prefix at all
+static std::string getJournalPrefix(const std::string& journal_dir, const std::string& journal_id)
+{
+    return journal_id.empty() ? journal_dir : fmt::format("{}{}.", journal_dir, journal_id);
+}
+
+static std::string getJournalFilePath(const std::string& journal_dir, const std::string& journal_id,
+                                      bool decoded)
+{
+    return getJournalPrefix(journal_dir, journal_id) + (decoded ? "events.decoded.json" : "events.json");
+}
+
+static u64 getProcessId()
+{
+#ifdef _WIN32
+    return GetCurrentProcessId();
+#else
+    return static_cast<u64>(getpid());
+#endif
+}
+
+//Make sure an appended event survives the process going down, not just that it left our buffers
+static bool syncFile(File::IOFile& file)
+{
+    if (!file.Flush())
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(file.GetHandle())) == 0;
+#else
+    return fsync(fileno(file.GetHandle())) == 0;
+#endif
+}
+
+StatEventJournal::StatEventJournal()
+    : StatEventJournal(File::GetUserPath(D_STATJOURNAL_IDX))
+{
+}
+
+StatEventJournal::StatEventJournal(std::string journal_dir)
+    : m_journal_dir(std::move(journal_dir))
+{
+    File::CreateFullPath(m_journal_dir);
+    //The start time keeps a reused process id from picking up the journal of a crashed process
+    m_journal_id = fmt::format("{}.{}.{}", getProcessId(), static_cast<u64>(std::time(nullptr)),
+                               s_next_journal_num++);
+    m_decoded_path = getJournalFilePath(m_journal_dir, m_journal_id, true);
+    m_raw_path = getJournalFilePath(m_journal_dir, m_journal_id, false);
+
+    //Before taking our lock, so leftovers under our id are recovered instead of truncated by begin()
+    recoverJournals();
+
+    m_lock = Lock::tryAcquire(getJournalPrefix(m_journal_dir, m_journal_id) + "lock");
+    if (!m_lock)
+        std::cout << "StatEventJournal: Could not lock journal " << m_journal_id << " in " << m_journal_dir << "\n";
+
+    m_worker.Reset("Stat Event Journal", [this](Command command) { processCommand(std::move(command)); });
+}
+
+StatEventJournal::~StatEventJournal()
+{
+    m_worker.Shutdown();
+}
+
+void StatEventJournal::begin()
+{
+    m_num_events = 0;
+    m_worker.Push(Command{CommandType::Begin, {}, {}});
+}
+
+void StatEventJournal::append(std::string decoded, std::string raw)
+{
+    ++m_num_events;
+    m_worker.Push(Command{CommandType::Append, std::move(decoded), std::move(raw)});
+}
+
+void StatEventJournal::discard()
+{
+    m_num_events = 0;
+    m_worker.Push(Command{CommandType::Discard, {}, {}});
+}
+
+void StatEventJournal::flush()
+{
+    m_worker.WaitForCompletion();
+}
+
+void StatEventJournal::readEvents(bool decoded, fmt::memory_buffer& out)
+{
+    flush();
+
+    //Worker is idle and everything it wrote has been flushed
+    File::IOFile file(getJournalPath(decoded), "rb");
+    if (file.IsOpen()){
+        const size_t size = static_cast<size_t>(file.GetSize());
+        const size_t start = out.size();
+        out.resize(start + size);
+        if (!file.ReadBytes(out.data() + start, size)){
+            std::cout << "StatEventJournal: Could not read " << getJournalPath(decoded) << "\n";
+            out.resize(start);
+        }
+    }
+
+    std::lock_guard lk(m_fallback_lock);
+    const std::string& fallback = decoded ? m_decoded_fallback : m_raw_fallback;
+    out.append(std::string_view(fallback));
+}
+
+void StatEventJournal::processCommand(Command command)
+{
+    switch (command.type){
+        case CommandType::Begin:
+            closeFiles();
+            openFiles();
+            break;
+        case CommandType::Append:{
+            bool write_failed;
+            {
+                std::lock_guard lk(m_fallback_lock);
+                write_failed = m_write_failed;
+            }
+
+            if (!write_failed){
+                const u64 decoded_start = m_decoded_file.Tell();
+                const u64 raw_start = m_raw_file.Tell();
+                if (writeRecord(m_decoded_file, command.decoded) && writeRecord(m_raw_file, command.raw)){
+                    ++m_num_written;
+                    break;
+                }
+
+                //Cut off whatever part of this event made it to disk, it goes to memory instead
+                truncateFile(m_decoded_file, decoded_start);
+                truncateFile(m_raw_file, raw_start);
+            }
+
+            std::lock_guard lk(m_fallback_lock);
+            if (!m_write_failed){
+                std::cout << "StatEventJournal: Could not write to " << m_journal_dir
+                          << ", keeping the rest of the game in memory\n";
+                m_write_failed = true;
+            }
+            if (m_num_written > 0){
+                m_decoded_fallback.append(cEventSeparator);
+                m_raw_fallback.append(cEventSeparator);
+            }
+            m_decoded_fallback.append(command.decoded);
+            m_raw_fallback.append(command.raw);
+            ++m_num_written;
+            break;
+        }
+        case CommandType::Discard:
+            closeFiles();
+            File::Delete(m_decoded_path);
+            File::Delete(m_raw_path);
+            resetFallback();
+            break;
+    }
+}
+
+void StatEventJournal::recoverJournals()
+{
+    std::set<std::string> journal_ids;
+    for (const std::string& path : Common::DoFileSearch({m_journal_dir}, {".json"})){
+        const std::string file_name = PathToFileName(path);
+        if (file_name.starts_with(cRecoveredPrefix) || !file_name.ends_with(cJournalSuffix))
+            continue;
+        std::string journal_id = file_name.substr(0, file_name.size() - cJournalSuffix.size());
+        if (!journal_id.empty())
+            journal_id.pop_back();
+        journal_ids.insert(std::move(journal_id));
+    }
+
+    for (const std::string& journal_id : journal_ids){
+        //A journal that can be locked is left over from a game that never got to write its stat file.
+        //Otherwise it still belongs to a running game
+        const std::unique_ptr<Lock> lock = Lock::tryAcquire(getJournalPrefix(m_journal_dir, journal_id) + "lock");
+        if (lock)
+            recoverJournal(journal_id);
+    }
+}
+
+void StatEventJournal::recoverJournal(const std::string& journal_id)
+{
+    const u64 unix_time = static_cast<u64>(std::time(nullptr));
+    for (const bool decoded : {true, false}){
+        const std::string path = getJournalFilePath(m_journal_dir, journal_id, decoded);
+        std::string events;
+        if (!File::ReadFileToString(path, events))
+            continue;
+
+        if (!events.empty()){
+            const std::string recovered_path = fmt::format(
+                "{}{}{}.{}{}", m_journal_dir, cRecoveredPrefix, unix_time,
+                journal_id.empty() ? "" : journal_id + ".", decoded ? "events.decoded.json" : "events.json");
+            File::WriteStringToFile(recovered_path,
+                                    fmt::format("{{\n  \"Events\": [\n{}\n  ]\n}}\n", events));
+            std::cout << "StatEventJournal: Recovered unfinished game to " << recovered_path << "\n";
+        }
+        File::Delete(path);
+    }
+}
+
+void StatEventJournal::openFiles()
+{
+    m_num_written = 0;
+    resetFallback();
+
+    m_decoded_file.Open(m_decoded_path, "wb");
+    m_raw_file.Open(m_raw_path, "wb");
+}
+
+void StatEventJournal::closeFiles()
+{
+    m_decoded_file.Close();
+    m_raw_file.Close();
+}
+
+void StatEventJournal::resetFallback()
+{
+    std::lock_guard lk(m_fallback_lock);
+    m_write_failed = false;
+    m_decoded_fallback.clear();
+    m_decoded_fallback.shrink_to_fit();
+    m_raw_fallback.clear();
+    m_raw_fallback.shrink_to_fit();
+}
+
+void StatEventJournal::truncateFile(File::IOFile& file, u64 size)
+{
+    if (!file.IsOpen())
+        return;
+    file.ClearError();
+    file.Flush();
+    file.Resize(size);
+    file.Seek(static_cast<s64>(size), File::SeekOrigin::Begin);
+}
+
+bool StatEventJournal::writeRecord(File::IOFile& file, const std::string& record)
+{
+    if (!file.IsOpen())
+        return false;
+    if (m_num_written > 0 && !file.WriteString(cEventSeparator))
+        return false;
+    return file.WriteString(record) && syncFile(file);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
+
+// Append-only log of the events of the game in progress.
+// Every finished event is rendered once, handed to a background thread and appended (and synced)
+// to the journal files, one for decoded output and one for raw output. The stat file at the end
+// of a game, or on a crash, is assembled by copying the journal instead of keeping every event in
+// memory and serializing them all again.
+// Every journal has its own files, locked for as long as it is alive, so several Rio processes
+// (or a stat tool next to a running game) can share the journal directory. Only the journals of
+// processes that are gone get recovered.
+class StatEventJournal{
+public:
+    StatEventJournal();
+    explicit StatEventJournal(std::string journal_dir);
+    ~StatEventJournal();
+
+    StatEventJournal(const StatEventJournal&) = delete;
+    StatEventJournal& operator=(const StatEventJournal&) = delete;
+
+    //Starts an empty journal for a new game
+    void begin();
+    //Queues one finished event. Both are complete event objects without a trailing separator
+    void append(std::string decoded, std::string raw);
+    //Drops the journal of the current game once its stat files are written
+    void discard();
+
+    //Blocks until every queued event is on disk
+    void flush();
+
+    //Appends every journaled event, comma separated, to out. Flushes first
+    void readEvents(bool decoded, fmt::memory_buffer& out);
+
+    u32 getNumEvents() const { return m_num_events; }
+    const std::string& getJournalPath(bool decoded) const { return decoded ? m_decoded_path : m_raw_path; }
+
+private:
+    enum class CommandType{
+        Begin,
+        Append,
+        Discard,
+    };
+
+    struct Command{
+        CommandType type;
+        std::string decoded;
+        std::string raw;
+    };
+
+    class Lock;
+
+    void processCommand(Command command);
+    void recoverJournals();
+    void recoverJournal(const std::string& journal_id);
+    void openFiles();
+    void closeFiles();
+    void resetFallback();
+    void truncateFile(File::IOFile& file, u64 size);
+    bool writeRecord(File::IOFile& file, const std::string& record);
+
+    std::string m_journal_dir;
+    //Process id, start time and journal number, every journal file starts with it
+    std::string m_journal_id;
+    std::unique_ptr<Lock> m_lock;
+    std::string m_decoded_path;
+    std::string m_raw_path;
+
+    //Counted on the CPU thread when the event is queued
+    u32 m_num_events = 0;
+
+    //Only touched from the worker thread
+    File::IOFile m_decoded_file;
+    File::IOFile m_raw_file;
+    u32 m_num_written = 0;
+
+    //Events that could not be written to disk. Once a write fails every later event lands here
+    //so the order is kept
+    std::mutex m_fallback_lock;
+    bool m_write_failed = false;
+    std::string m_decoded_fallback;
+    std::string m_raw_fallback;
+
+    //Declared last so the worker is joined before the members it uses are destroyed
+    Common::WorkQueueThread<Command> m_worker;
+};
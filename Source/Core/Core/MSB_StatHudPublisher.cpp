@@ -0,0 +1,200 @@
+#include "Core/MSB_StatHudPublisher.h"
+
+#include <chrono>
+#include <iterator>
+#include <iostream>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
+
+//How often the worker looks for new overlays while nothing is published
+static constexpr std::chrono::milliseconds cAcceptInterval{50};
+//A client with more than this waiting to be sent has stopped reading
+static constexpr size_t cMaxUnsentBytes = 16 * 1024 * 1024;
+
+static std::optional<u16> getConfiguredStreamPort()
+{
+    const int port = Config::Get(Config::MAIN_STAT_TRACKER_HUD_STREAM_PORT);
+    if (port <= 0 || port > 0xFFFF)
+        return std::nullopt;
+    return static_cast<u16>(port);
+}
+
+StatHudPublisher::StatHudPublisher()
+    : StatHudPublisher(File::GetUserPath(D_HUDFILES_IDX) + "decoded.hud.json", getConfiguredStreamPort())
+{
+}
+
+StatHudPublisher::StatHudPublisher(std::string hud_path, std::optional<u16> stream_port)
+    : m_hud_path(std::move(hud_path))
+{
+    m_temp_path = File::GetTempFilenameForAtomicWrite(m_hud_path);
+
+    if (stream_port){
+        if (m_listener.listen(*stream_port, sf::IpAddress::LocalHost) == sf::Socket::Done){
+            m_listener.setBlocking(false);
+            m_stream_port = m_listener.getLocalPort();
+            std::cout << "StatHudPublisher: Streaming HUD on 127.0.0.1:" << m_stream_port << "\n";
+        }
+        else{
+            std::cout << "StatHudPublisher: Could not listen on port " << *stream_port << "\n";
+        }
+    }
+
+    m_thread = std::thread([this] { workerLoop(); });
+}
+
+StatHudPublisher::~StatHudPublisher()
+{
+    shutdown();
+}
+
+void StatHudPublisher::publish(std::string_view json)
+{
+    {
+        std::lock_guard lk(m_lock);
+        if (m_stop)
+            return;
+        m_pending.assign(json);
+        m_has_pending = true;
+        ++m_published_count;
+    }
+    m_wake.notify_one();
+}
+
+void StatHudPublisher::flush()
+{
+    std::unique_lock lk(m_lock);
+    m_idle.wait(lk, [this] { return !m_has_pending && !m_busy; });
+}
+
+void StatHudPublisher::shutdown()
+{
+    {
+        std::lock_guard lk(m_lock);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+u32 StatHudPublisher::getPublishedCount() const
+{
+    std::lock_guard lk(m_lock);
+    return m_published_count;
+}
+
+u32 StatHudPublisher::getWrittenCount() const
+{
+    std::lock_guard lk(m_lock);
+    return m_written_count;
+}
+
+void StatHudPublisher::workerLoop()
+{
+    Common::SetCurrentThreadName("Stat HUD Publisher");
+
+    //Last document written. Swapped with m_pending so both buffers keep their size
+    std::string current;
+    bool has_current = false;
+
+    std::unique_lock lk(m_lock);
+    while (true){
+        const auto ready = [this] { return m_has_pending || m_stop; };
+        if (m_stream_port != 0)
+            m_wake.wait_for(lk, cAcceptInterval, ready);
+        else
+            m_wake.wait(lk, ready);
+
+        if (m_has_pending){
+            std::swap(current, m_pending);
+            m_has_pending = false;
+            m_busy = true;
+            lk.unlock();
+
+            writeFile(current);
+            sendToClients(current);
+            has_current = true;
+
+            lk.lock();
+            ++m_written_count;
+            m_busy = false;
+            if (!m_has_pending)
+                m_idle.notify_all();
+        }
+
+        if (m_stop && !m_has_pending)
+            break;
+
+        if (m_stream_port != 0){
+            lk.unlock();
+            sendUnsent();
+            acceptClients(has_current ? current : std::string());
+            lk.lock();
+        }
+    }
+    lk.unlock();
+
+    m_clients.clear();
+    m_listener.close();
+}
+
+void StatHudPublisher::writeFile(const std::string& json)
+{
+    //Overlays poll the file, never let them see it missing or half written
+    if (!File::WriteStringToFile(m_temp_path, json) || !File::Rename(m_temp_path, m_hud_path)){
+        std::cout << "StatHudPublisher: Could not write " << m_hud_path << "\n";
+        File::Delete(m_temp_path);
+    }
+}
+
+void StatHudPublisher::acceptClients(const std::string& current)
+{
+    StreamClient client{std::make_unique<sf::TcpSocket>()};
+    while (m_listener.accept(*client.socket) == sf::Socket::Done){
+        client.socket->setBlocking(false);
+        //Start a new overlay off with the HUD as it is now
+        if (current.empty() || sendDocument(client, current))
+            m_clients.push_back(std::move(client));
+        client = StreamClient{std::make_unique<sf::TcpSocket>()};
+    }
+}
+
+void StatHudPublisher::sendToClients(const std::string& json)
+{
+    std::erase_if(m_clients, [&json](StreamClient& client) { return !sendDocument(client, json); });
+}
+
+void StatHudPublisher::sendUnsent()
+{
+    std::erase_if(m_clients, [](StreamClient& client) { return !sendUnsent(client); });
+}
+
+bool StatHudPublisher::sendDocument(StreamClient& client, const std::string& json)
+{
+    if (client.unsent.size() + json.size() > cMaxUnsentBytes)
+        return false;
+    fmt::format_to(std::back_inserter(client.unsent), "{}\n", json.size());
+    client.unsent += json;
+    return sendUnsent(client);
+}
+
+bool StatHudPublisher::sendUnsent(StreamClient& client)
+{
+    //Non-blocking, a short write leaves the rest for the next try
+    while (!client.unsent.empty()){
+        size_t sent = 0;
+        const sf::Socket::Status status =
+            client.socket->send(client.unsent.data(), client.unsent.size(), sent);
+        client.unsent.erase(0, sent);
+        if (status == sf::Socket::Partial || status == sf::Socket::NotReady)
+            return true;
+        if (status != sf::Socket::Done)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+
+#include "Common/CommonTypes.h"
+
+// Publishes the HUD document that broadcast overlays read.
+// The CPU thread only copies the finished document into a pending buffer. A background thread
+// writes it to the HUD file through a temp file and a rename, so a reader sees either the old or
+// the new document and never a partial one. Documents published faster than they can be written
+// are coalesced, only the latest is written.
+//
+// If a stream port is given the same thread also serves the documents on 127.0.0.1:port. Every
+// connected overlay receives each new document as "<length in bytes>\n<document>", starting with
+// the current one, instead of polling the file. What a client's socket doesn't take right away is
+// kept and sent later. Clients that fall too far behind are disconnected.
+class StatHudPublisher{
+public:
+    StatHudPublisher();
+    //A stream port of 0 serves the stream on any free port
+    explicit StatHudPublisher(std::string hud_path, std::optional<u16> stream_port = std::nullopt);
+    ~StatHudPublisher();
+
+    StatHudPublisher(const StatHudPublisher&) = delete;
+    StatHudPublisher& operator=(const StatHudPublisher&) = delete;
+
+    //Replaces whatever is waiting to be written. Does not allocate once the buffer has grown
+    void publish(std::string_view json);
+
+    //Blocks until the last published document is written and handed to the clients
+    void flush();
+    //Writes whatever is pending and joins the worker
+    void shutdown();
+
+    //Port the stream is served on, 0 if there is no stream
+    u16 getStreamPort() const { return m_stream_port; }
+    u32 getPublishedCount() const;
+    u32 getWrittenCount() const;
+    const std::string& getHudPath() const { return m_hud_path; }
+
+private:
+    struct StreamClient{
+        std::unique_ptr<sf::TcpSocket> socket;
+        //Bytes the socket didn't take yet
+        std::string unsent;
+    };
+
+    void workerLoop();
+    void writeFile(const std::string& json);
+    void acceptClients(const std::string& current);
+    void sendToClients(const std::string& json);
+    void sendUnsent();
+    static bool sendDocument(StreamClient& client, const std::string& json);
+    static bool sendUnsent(StreamClient& client);
+
+    std::string m_hud_path;
+    std::string m_temp_path;
+    u16 m_stream_port = 0;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::string m_pending;
+    bool m_has_pending = false;
+    bool m_busy = false;
+    bool m_stop = false;
+    u32 m_published_count = 0;
+    u32 m_written_count = 0;
+
+    //Only touched from the worker thread
+    sf::TcpListener m_listener;
+    std::vector<StreamClient> m_clients;
+
+    //Declared last so it is started after, and joined before, everything it uses
+    std::thread m_thread;
+};
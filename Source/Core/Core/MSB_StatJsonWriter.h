@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+#include "Core/MSB_StatDecode.h"
+
+// Streams StatTracker JSON into reusable buffers.
+// A document is built once and written to every target at the same time, so the decoded file,
+// the raw file and the submission payload at the end of a game all come out of a single pass over
+// the game. Buffers keep their capacity between documents; after the first game nothing here
+// allocates.
+class StatJsonWriter{
+public:
+    static constexpr size_t cMaxTargets = 3;
+
+    struct Target{
+        bool decode = false;     //Write names instead of ids for decoded values
+        bool hide_riokey = true; //Write usernames instead of Rio user ids
+        fmt::memory_buffer buffer;
+    };
+
+    StatJsonWriter() = default;
+
+    StatJsonWriter(const StatJsonWriter&) = delete;
+    StatJsonWriter& operator=(const StatJsonWriter&) = delete;
+
+    //Drops all targets. Their buffers are cleared but keep their memory
+    void reset(){
+        m_num_targets = 0;
+    }
+
+    //Returns the index to read the finished document back with. Once all cMaxTargets are taken
+    //nothing is added and the last target's index is returned, its settings left as they were
+    size_t addTarget(bool decode, bool hide_riokey = true){
+        ASSERT_MSG(CORE, m_num_targets < cMaxTargets, "StatJsonWriter: More than {} targets",
+                   cMaxTargets);
+        if (m_num_targets == cMaxTargets)
+            return cMaxTargets - 1;
+
+        Target& target = m_targets[m_num_targets];
+        target.decode = decode;
+        target.hide_riokey = hide_riokey;
+        target.buffer.clear();
+        return m_num_targets++;
+    }
+
+    size_t getNumTargets() const { return m_num_targets; }
+
+    //Literal text, identical for every target
+    void raw(std::string_view text){
+        for (size_t i = 0; i < m_num_targets; ++i)
+            m_targets[i].buffer.append(text);
+    }
+
+    //Formatted text, identical for every target. Formatted once and copied to the rest
+    template <typename... Args>
+    void format(fmt::format_string<Args...> format_str, Args&&... args){
+        if (m_num_targets == 0)
+            return;
+
+        fmt::memory_buffer& first = m_targets[0].buffer;
+        const size_t start = first.size();
+        fmt::format_to(fmt::appender(first), format_str, std::forward<Args>(args)...);
+
+        const std::string_view text(first.data() + start, first.size() - start);
+        for (size_t i = 1; i < m_num_targets; ++i)
+            m_targets[i].buffer.append(text);
+    }
+
+    //prefix + name (decoded targets) or number (raw targets) + suffix
+    void decoded(std::string_view prefix, DecodeType type, u8 value, std::string_view suffix){
+        for (size_t i = 0; i < m_num_targets; ++i){
+            fmt::memory_buffer& buffer = m_targets[i].buffer;
+            buffer.append(prefix);
+            if (m_targets[i].decode)
+                decodeTo(buffer, type, value);
+            else
+                fmt::format_to(fmt::appender(buffer), "{}", value);
+            buffer.append(suffix);
+        }
+    }
+
+    //For output that differs between targets in other ways
+    template <typename Func>
+    void perTarget(Func&& func){
+        for (size_t i = 0; i < m_num_targets; ++i)
+            func(m_targets[i]);
+    }
+
+    std::string_view view(size_t target) const{
+        return std::string_view(m_targets[target].buffer.data(), m_targets[target].buffer.size());
+    }
+    std::string str(size_t target) const { return std::string(view(target)); }
+
+private:
+    std::array<Target, cMaxTargets> m_targets;
+    size_t m_num_targets = 0;
+};
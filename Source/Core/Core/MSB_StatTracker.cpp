@@ -3,15 +3,20 @@
 
 #include <iomanip>
 #include <fstream>
+#include <cstring>
 #include <ctime>
+#include <utility>
 
 //For LocalPLayers
 #include "Common/CommonPaths.h"
 #include "Common/IniFile.h"
 #include "Core/LocalPlayersConfig.h"
 #include "Common/Version.h"
+#include "Core/Movie.h"
+#include "Core/System.h"
 
 #include "Common/Swap.h"
+#include "Common/StringUtil.h"
 
 // Package for rendering info on screen
 #include "VideoCommon/OnScreenDisplay.h"
@@ -23,11 +28,142 @@
 
 #include "Common/TagSet.h"
 
+const TrackerField& getTrackerField(TrackerFieldId id)
+{
+    return cTrackerFields[static_cast<size_t>(id)];
+}
+
 void StatTracker::Run(const Core::CPUThreadGuard& guard)
 {
+    //Frames still waiting for input when a rollback session ended never get it
+    m_captured_frames.clear();
+
+    //Game memory has moved on since last frame
+    m_snapshot.invalidate();
+    recordTraceFrame(guard);
     lookForTriggerEvents(guard);
 }
 
+void StatTracker::captureFrame(const Core::CPUThreadGuard& guard, u64 frame, u64 input_frames)
+{
+    //A rollback went back to before these frames, they are running again
+    while (!m_captured_frames.empty() && m_captured_frames.back().frame >= frame){
+        m_spare_frames.push_back(std::move(m_captured_frames.back()));
+        m_captured_frames.pop_back();
+    }
+
+    m_snapshot.invalidate();
+    m_snapshot.captureAll(guard);
+
+    CapturedFrame captured;
+    if (!m_spare_frames.empty()){
+        captured = std::move(m_spare_frames.back());
+        m_spare_frames.pop_back();
+    }
+    captured.frame = frame;
+    captured.input_frames = input_frames;
+    captured.regions.resize(m_snapshot.getNumRegions());
+    for (size_t i = 0; i < captured.regions.size(); ++i)
+        captured.regions[i] = m_snapshot.getRegionData(i);
+    m_captured_frames.push_back(std::move(captured));
+}
+
+void StatTracker::runConfirmedFrames(const Core::CPUThreadGuard& guard, u64 confirmed_input_frames)
+{
+    while (!m_captured_frames.empty() && m_captured_frames.front().input_frames <= confirmed_input_frames){
+        CapturedFrame& captured = m_captured_frames.front();
+
+        //Served like a trace, the frame is long gone from guest memory
+        m_snapshot.setReplaying(true);
+        for (size_t i = 0; i < captured.regions.size(); ++i)
+            std::memcpy(m_snapshot.getReplayData(i), captured.regions[i].data(), captured.regions[i].size());
+        recordTraceFrame(guard);
+        lookForTriggerEvents(guard);
+        m_snapshot.setReplaying(false);
+        m_snapshot.invalidate();
+
+        m_spare_frames.push_back(std::move(captured));
+        m_captured_frames.pop_front();
+    }
+}
+
+void StatTracker::recordTraceFrame(const Core::CPUThreadGuard& guard)
+{
+    if (m_replaying_trace)
+        return;
+
+    if (!m_trace_writer.isOpen()){
+        if (!Config::Get(Config::MAIN_STAT_TRACKER_RECORD_TRACE))
+            return;
+
+        std::time_t unix_time = std::time(nullptr);
+        char datetime_c[256];
+        std::strftime(datetime_c, sizeof(datetime_c), "%Y%m%dT%H%M%S", std::localtime(&unix_time));
+        const std::string path = File::GetUserPath(D_STATTRACES_IDX) + datetime_c + ".stattrace";
+        if (!m_trace_writer.open(path, m_snapshot))
+            return;
+        std::cout << "Recording stat tracker trace to " << path << "\n";
+    }
+
+    //Captured frames already hold everything
+    if (!m_snapshot.isReplaying())
+        m_snapshot.captureAll(guard);
+    m_trace_writer.writeSettings({m_state.m_netplay_session, m_state.m_netplay_opponent_alias,
+                                  m_state.tag_set_id_local, m_state.tag_set_id_netplay});
+    m_trace_writer.writeFrame(m_snapshot);
+}
+
+std::optional<u64> StatTracker::replayTrace(const Core::CPUThreadGuard& guard, const std::string& path)
+{
+    StatTrackerTraceReader reader;
+    if (!reader.open(path))
+        return std::nullopt;
+    if (!reader.matches(m_snapshot)){
+        std::cout << "StatTrackerTrace: " << path << " was recorded with different memory regions\n";
+        return std::nullopt;
+    }
+
+    const u64 missed_reads_before = m_snapshot.getMissedReadCount();
+    m_replaying_trace = true;
+    m_snapshot.setReplaying(true);
+    bool replayed = true;
+    while (true){
+        const StatTrackerTraceReader::Record record = reader.next(m_snapshot);
+        if (record == StatTrackerTraceReader::Record::Frame){
+            Run(guard);
+        }
+        else if (record == StatTrackerTraceReader::Record::Settings){
+            const StatTrackerTraceSettings& settings = reader.getSettings();
+            m_state.m_netplay_session = settings.netplay;
+            m_state.m_netplay_opponent_alias = settings.opponent_alias;
+            m_state.tag_set_id_local = settings.tag_set_id_local;
+            m_state.tag_set_id_netplay = settings.tag_set_id_netplay;
+        }
+        else{
+            replayed = (record == StatTrackerTraceReader::Record::End);
+            break;
+        }
+    }
+    m_snapshot.setReplaying(false);
+    m_replaying_trace = false;
+
+    //Let the journal worker catch up before anyone looks at the output
+    m_event_journal.flush();
+    m_hud_publisher.flush();
+    m_archive_writer.flush();
+    std::cout << "Replayed " << reader.getNumFrames() << " frames from " << path << "\n";
+    if (!replayed)
+        return std::nullopt;
+
+    //Those reads returned 0 instead of what the game had, so the stats can't be trusted
+    const u64 missed_reads = m_snapshot.getMissedReadCount() - missed_reads_before;
+    if (missed_reads != 0){
+        std::cout << "StatTrackerTrace: " << missed_reads << " reads outside the recorded regions\n";
+        return std::nullopt;
+    }
+    return reader.getNumFrames();
+}
+
 void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
 {
     // if (m_game_state != m_game_state_prev) {
@@ -58,8 +194,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     m_game_info.getCurrentEvent().event_num,
                     m_game_info.getCurrentEvent().inning,
                     m_game_info.getCurrentEvent().half_inning,
-                    (m_game_info.getCurrentEvent().runner_batter) ? cCharIdToCharName.at(m_game_info.getCurrentEvent().runner_batter->char_id) : "None",
-                    (m_game_info.getCurrentEvent().pitch) ? cCharIdToCharName.at(m_game_info.getCurrentEvent().pitch->pitcher_char_id) : "Pitch Not Thrown Yet",
+                    (m_game_info.getCurrentEvent().runner_batter) ? decodeName(DecodeType::Character, m_game_info.getCurrentEvent().runner_batter->char_id) : "None",
+                    (m_game_info.getCurrentEvent().pitch) ? decodeName(DecodeType::Character, m_game_info.getCurrentEvent().pitch->pitcher_char_id) : "Pitch Not Thrown Yet",
                     m_game_info.getCurrentEvent().stringifyHistory()
                 ));
             
@@ -70,8 +206,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     u8 batter_char_id = m_game_info.character_summaries[half_inning][m_game_info.getCurrentEvent().batter_roster_loc].char_id;
                     u8 pitcher_char_id = m_game_info.character_summaries[!half_inning][m_game_info.getCurrentEvent().pitcher_roster_loc].char_id;
 
-                    std::string batter_name = cCharIdToCharName.at(batter_char_id);
-                    std::string pitcher_name = cCharIdToCharName.at(pitcher_char_id);
+                    std::string batter_name(decodeName(DecodeType::Character, batter_char_id));
+                    std::string pitcher_name(decodeName(DecodeType::Character, pitcher_char_id));
 
                     if (Config::Get(Config::MAIN_ENABLE_DEBUGGING))
                     {
@@ -103,11 +239,11 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                               m_game_info.getCurrentEvent().inning,
                               m_game_info.getCurrentEvent().half_inning,
                               (m_game_info.getCurrentEvent().runner_batter) ?
-                                  cCharIdToCharName.at(
+                                  decodeName(DecodeType::Character, 
                                       m_game_info.getCurrentEvent().runner_batter->char_id) :
                                   "None",
                               (m_game_info.getCurrentEvent().pitch) ?
-                                  cCharIdToCharName.at(
+                                  decodeName(DecodeType::Character, 
                                       m_game_info.getCurrentEvent().pitch->pitcher_char_id) :
                                   "Pitch Not Thrown Yet",
                               m_game_info.getCurrentEvent().stringifyHistory()),
@@ -140,10 +276,10 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     m_game_info.getCurrentEvent().event_num, m_game_info.getCurrentEvent().inning,
                     m_game_info.getCurrentEvent().half_inning,
                     (m_game_info.getCurrentEvent().runner_batter) ?
-                        cCharIdToCharName.at(m_game_info.getCurrentEvent().runner_batter->char_id) :
+                        decodeName(DecodeType::Character, m_game_info.getCurrentEvent().runner_batter->char_id) :
                         "None",
                     (m_game_info.getCurrentEvent().pitch) ?
-                        cCharIdToCharName.at(m_game_info.getCurrentEvent().pitch->pitcher_char_id) :
+                        decodeName(DecodeType::Character, m_game_info.getCurrentEvent().pitch->pitcher_char_id) :
                         "Pitch Not Thrown Yet",
                     m_game_info.getCurrentEvent().stringifyHistory()),
                 3000, OSD::Color::CYAN);
@@ -168,8 +304,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 //Create new event, collect runner data
 
                 //Capture the rising edge of the AtBat Scene
-        if (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0x1 &&
-            PowerPC::MMU::HostRead_U8(guard, aGameControlStatePrev) != 0x1)
+        if (m_snapshot.read<u8>(guard, aGameControlStateCurr) == 0x1 &&
+            m_snapshot.read<u8>(guard, aGameControlStatePrev) != 0x1)
         {
 
                     m_game_info.events[m_game_info.event_num] = Event();
@@ -192,19 +328,18 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
 
                     if (!m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].initialized){
                         std::cout << " Initializing fielders for team: " << std::to_string(!m_game_info.getCurrentEvent().half_inning) << "\n";
-                        m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].initTracker(guard, !m_game_info.getCurrentEvent().half_inning);
+                        m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].initTracker(guard, m_snapshot, !m_game_info.getCurrentEvent().half_inning);
                     }
 
                     m_event_state = EVENT_STATE::WAITING_FOR_EVENT;
 
                     std::cout << "Init event " << std::to_string(m_game_info.event_num) << "\n";
                 }
-                else if (PowerPC::MMU::HostRead_U32(guard, aGameId) == 0){
+                else if (m_snapshot.read<u32>(guard, aGameId) == 0){
                     onGameQuit(guard);
 
                     //Remove current event, wasn't finished
-                    auto it = m_game_info.events.find(m_game_info.event_num);
-                    m_game_info.events.erase(it);
+                    m_game_info.events.erase(m_game_info.event_num);
 
                     m_event_state = EVENT_STATE::GAME_OVER;
                 }
@@ -212,12 +347,11 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
             //Look for Pitch
             case (EVENT_STATE::WAITING_FOR_EVENT):
                 //Handle quit to main menu
-                if (PowerPC::MMU::HostRead_U32(guard, aGameId) == 0){
+                if (m_snapshot.read<u32>(guard, aGameId) == 0){
                     onGameQuit(guard);
 
                     //Remove current event, wasn't finished
-                    auto it = m_game_info.events.find(m_game_info.event_num);
-                    m_game_info.events.erase(it);
+                    m_game_info.events.erase(m_game_info.event_num);
 
                     m_event_state = EVENT_STATE::GAME_OVER;
                     break;
@@ -233,37 +367,37 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 //1. Are runners stealing and pitcher stepped off the mound
                 //2. Has pitch started?
                 //3. Has game been paused, reinit 
-                if (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0xb){
+                if (m_snapshot.read<u8>(guard, aGameControlStateCurr) == 0xb){
                     std::cout << "Game paused, need to re-init event " << std::to_string(m_game_info.event_num) << "\n";
                     logGameInfo(guard);
                     updateOngoingGame(m_game_info.getCurrentEvent());
                     m_event_state = EVENT_STATE::INIT_EVENT;
                 }
                 //Watch for Runners Stealing
-                if (PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown) || PowerPC::MMU::HostRead_U8(guard, aAB_PickoffAttempt)){
+                if (m_snapshot.read<u8>(guard, aAB_PitchThrown) || m_snapshot.read<u8>(guard, aAB_PickoffAttempt)){
                     //If HUD not produced for this event, produce HUD JSON
                     logGameInfo(guard);
 
-                    if (m_game_info.getCurrentEvent().write_hud_ab.first) {
-                        std::string hud_file_path = File::GetUserPath(D_HUDFILES_IDX) + "decoded.hud.json";
-                        std::string json = getHUDJSON(std::to_string(m_game_info.event_num) + "a", m_game_info.getCurrentEvent(), m_game_info.previous_state, true);
-                        File::Delete(hud_file_path);
-                        File::WriteStringToFile(hud_file_path, json);
+                    if (m_game_info.getCurrentEvent().write_hud_a) {
+                        m_json_writer.reset();
+                        const size_t hud_json = m_json_writer.addTarget(true);
+                        writeHUDJSON(m_json_writer, std::to_string(m_game_info.event_num) + "a", m_game_info.getCurrentEvent(), m_game_info.previous_state);
+                        m_hud_publisher.publish(m_json_writer.view(hud_json));
                         //No longer need to write HUD B
-                        m_game_info.getCurrentEvent().write_hud_ab.first = false;
+                        m_game_info.getCurrentEvent().write_hud_a = false;
                     }
 
-                    if(PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown)){
+                    if(m_snapshot.read<u8>(guard, aAB_PitchThrown)){
                         std::cout << "Pitch detected!\n";
 
                         //Check for fielder swaps
                         std::cout << " Evaluating fielders for team: " << std::to_string(!m_game_info.getCurrentEvent().half_inning) << "\n";
-                        m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].evaluateFielders(guard);
+                        m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].evaluateFielders(guard, m_snapshot);
 
                         m_game_info.getCurrentEvent().pitch = std::make_optional(Pitch());
 
                         //Check if pitcher was at center of mound, if so this is a potential DB
-                        if (PowerPC::MMU::HostRead_U8(guard, aFielder_Pos_X) == 0){
+                        if (m_snapshot.read<u8>(guard, aFielder_Pos_X) == 0){
                             m_game_info.getCurrentEvent().pitch->potential_db = true;
                             std::cout << "Potential DB!\n";
                         }
@@ -271,7 +405,7 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                         //Pitch has started
                         m_event_state = EVENT_STATE::PITCH_RESULT;
                     }
-                    else if(PowerPC::MMU::HostRead_U8(guard, aAB_PickoffAttempt)) {
+                    else if(m_snapshot.read<u8>(guard, aAB_PickoffAttempt)) {
                         std::cout << "Pick of attempt detected!\n";
                         m_event_state = EVENT_STATE::MONITOR_RUNNERS;
                         m_game_info.getCurrentEvent().pick_off_attempt = true;
@@ -284,8 +418,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 //DBs
                 //If the pitcher started in the center of the mound this is a potential DB
                 //If the ball curves at any point it is no longer a DB
-                if (m_game_info.getCurrentEvent().pitch->potential_db && (PowerPC::MMU::HostRead_U8(guard, aAB_PitcherHasCtrlofPitch) == 1)) {
-                    if (floatConverter(PowerPC::MMU::HostRead_U32(guard, aAB_PitchCurveInput)) != 0) {
+                if (m_game_info.getCurrentEvent().pitch->potential_db && (m_snapshot.read<u8>(guard, aAB_PitcherHasCtrlofPitch) == 1)) {
+                    if (floatConverter(m_snapshot.read<u32>(guard, aAB_PitchCurveInput)) != 0) {
                         std::cout << "No longer potential DB!\n";
                         m_game_info.getCurrentEvent().pitch->potential_db = false;
                     }
@@ -306,28 +440,28 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
 
                 //Conditions to leave the state: Contact, Ball beyond batter, HBP
                 //Contact
-                if (PowerPC::MMU::HostRead_U8(guard, aAB_ContactMade)){
+                if (m_snapshot.read<u8>(guard, aAB_ContactMade)){
                     logPitch(guard, m_game_info.getCurrentEvent());
                     logContact(guard, m_game_info.getCurrentEvent());
                     m_event_state = EVENT_STATE::CONTACT_RESULT;
                 }
                 //If the ball gets behind the batter while mid pitch OR play flag is false (safety incase we miss the first cond), record miss
-                else if (PowerPC::MMU::HostRead_U8(guard, aAB_MissedBall)){
+                else if (m_snapshot.read<u8>(guard, aAB_MissedBall)){
                     logPitch(guard, m_game_info.getCurrentEvent());
                     m_event_state = EVENT_STATE::MONITOR_RUNNERS;
                 }
-                else if (PowerPC::MMU::HostRead_U8(guard, aAB_HitByPitch) == 1){
+                else if (m_snapshot.read<u8>(guard, aAB_HitByPitch) == 1){
                     //Log HBP
                     logPitch(guard, m_game_info.getCurrentEvent());
-                    if (!PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown)) {
-                        m_game_info.getCurrentEvent().result_of_atbat = PowerPC::MMU::HostRead_U8(guard, aAB_FinalResult);
+                    if (!m_snapshot.read<u8>(guard, aAB_PitchThrown)) {
+                        m_game_info.getCurrentEvent().result_of_atbat = m_snapshot.read<u8>(guard, aAB_FinalResult);
                         m_event_state = EVENT_STATE::PLAY_OVER;
                     }
                 }
 
                 break;
             case (EVENT_STATE::CONTACT_RESULT):                
-                if (PowerPC::MMU::HostRead_U8(guard, aAB_ContactResult) != 0){
+                if (m_snapshot.read<u8>(guard, aAB_ContactResult) != 0){
                     //Indicate that pitch resulted in contact and log contact details
                     m_game_info.getCurrentEvent().pitch->pitch_result = 6;
                     logContactResult(guard, &m_game_info.getCurrentEvent().pitch->contact.value()); //Land vs Caught vs Foul, Landing POS.
@@ -343,9 +477,9 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 else{
                     Contact* contact = &m_game_info.getCurrentEvent().pitch->contact.value();
                     //Final Result Ball
-                    contact->ball_x_pos.read_value(guard);
-                    contact->ball_y_pos.read_value(guard);
-                    contact->ball_z_pos.read_value(guard);
+                    contact->ball_x_pos.read_value(guard, m_snapshot);
+                    contact->ball_y_pos.read_value(guard, m_snapshot);
+                    contact->ball_z_pos.read_value(guard, m_snapshot);
                 }
                 //Could bobble before the ball hits the ground.
                 //Search for bobble if we haven't recorded one yet and the ball hasn't been collected yet
@@ -376,14 +510,14 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 }
 
                 //Break out if play ends without fielding the ball (HR or other play ending hit)
-                if (!PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown)) {
-                    m_game_info.getCurrentEvent().result_of_atbat = PowerPC::MMU::HostRead_U8(guard, aAB_FinalResult);
+                if (!m_snapshot.read<u8>(guard, aAB_PitchThrown)) {
+                    m_game_info.getCurrentEvent().result_of_atbat = m_snapshot.read<u8>(guard, aAB_FinalResult);
                     m_event_state = EVENT_STATE::PLAY_OVER;
                 }
                 break;
             case (EVENT_STATE::MONITOR_RUNNERS):
-                if (!PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown) && !PowerPC::MMU::HostRead_U8(guard, aAB_PickoffAttempt)){
-                    m_game_info.getCurrentEvent().result_of_atbat = PowerPC::MMU::HostRead_U8(guard, aAB_FinalResult);
+                if (!m_snapshot.read<u8>(guard, aAB_PitchThrown) && !m_snapshot.read<u8>(guard, aAB_PickoffAttempt)){
+                    m_game_info.getCurrentEvent().result_of_atbat = m_snapshot.read<u8>(guard, aAB_FinalResult);
                     m_event_state = EVENT_STATE::PLAY_OVER;
                 }
                 else {
@@ -400,8 +534,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 }
                 break;
             case (EVENT_STATE::PLAY_OVER):
-                if (!PowerPC::MMU::HostRead_U8(guard, aAB_PitchThrown)){
-                    m_game_info.getCurrentEvent().rbi = PowerPC::MMU::HostRead_U8(guard, aAB_RBI);
+                if (!m_snapshot.read<u8>(guard, aAB_PitchThrown)){
+                    m_game_info.getCurrentEvent().rbi = m_snapshot.read<u8>(guard, aAB_RBI);
 
                     //runner_batter out, contact_secondary
                     logFinalResults(guard, m_game_info.getCurrentEvent());
@@ -423,7 +557,7 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 break;
             case (EVENT_STATE::FINAL_RESULT):
                 //Log post event HUD to file
-                if (m_game_info.getCurrentEvent().write_hud_ab.second){
+                if (m_game_info.getCurrentEvent().write_hud_b){
 
                     //Fill in current state for HUD
                     logGameInfo(guard);
@@ -436,18 +570,19 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     //Store current state as previous state
                     m_game_info.previous_state = m_game_info.getCurrentEvent();
 
-                    std::string hud_file_path = File::GetUserPath(D_HUDFILES_IDX) + "decoded.hud.json";
-                    std::string json = getHUDJSON(std::to_string(m_game_info.event_num) + "b", m_game_info.getCurrentEvent(), m_game_info.previous_state, true);
-                    File::Delete(hud_file_path);
-                    File::WriteStringToFile(hud_file_path, json);
+                    m_json_writer.reset();
+                    const size_t hud_json = m_json_writer.addTarget(true);
+                    writeHUDJSON(m_json_writer, std::to_string(m_game_info.event_num) + "b", m_game_info.getCurrentEvent(), m_game_info.previous_state);
+                    m_hud_publisher.publish(m_json_writer.view(hud_json));
 
                     //No longer need to write HUD B
-                    m_game_info.getCurrentEvent().write_hud_ab.second = false;
+                    m_game_info.getCurrentEvent().write_hud_b = false;
                 }
 
                 // === Transitions ===
 
-                if (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0x7){
+                if (m_snapshot.read<u8>(guard, aGameControlStateCurr) == 0x7){
+                    journalCurrentEvent();
                     //Increment event count
                     ++m_game_info.event_num;
                     //Save position as prev position
@@ -456,20 +591,23 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                     m_fielder_tracker[fielding_team_id].newBatter();
                     m_event_state = EVENT_STATE::INIT_EVENT;
                     m_game_info.update_ongoing_game = true;
+                    m_pad_buffer_safe_point = true;
                     std::cout << "Logging Final Result\n" << "Starting next AB\n\n";
                 }
-                else if (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0x1 && !m_game_info.previous_state.value().pitch.has_value()){
+                else if (m_snapshot.read<u8>(guard, aGameControlStateCurr) == 0x1 && !m_game_info.previous_state.value().pitch.has_value()){
+                    journalCurrentEvent();
                     //Increment event count
                     ++m_game_info.event_num;
                     m_event_state = EVENT_STATE::INIT_EVENT;
                     std::cout << "Logging Final Result\n" << "Pickoff over\n\n";
                 }
-                else if ((PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0xE) || (PowerPC::MMU::HostRead_U8(guard, aEndOfGameFlag) == 1)){ //MVP screen
-                    //Increment event count
+                else if ((m_snapshot.read<u8>(guard, aGameControlStateCurr) == 0xE) || (m_snapshot.read<u8>(guard, aEndOfGameFlag) == 1)){ //MVP screen
+                    journalCurrentEvent();
                     m_event_state = EVENT_STATE::GAME_OVER;
                     std::cout << "Logging Final Result\n" << "Game Over\n\n";
                 }
                 else if ((m_game_info.previous_state.value().balls < 4 || m_game_info.previous_state.value().strikes < 3) && m_game_info.getCurrentEvent().result_of_atbat == 0) {
+                    journalCurrentEvent();
                     ++m_game_info.event_num;
                     m_event_state = EVENT_STATE::INIT_EVENT;
                     std::cout << "Logging Final Result\n" << "Starting next pitch of AB\n\n";
@@ -493,9 +631,9 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
     switch (m_game_state){ // crashed here in debugging "Access violation reading location 0xFFFFFFFFFFFFFFFF"
         case (GAME_STATE::PREGAME):
             //Start recording when GameId is set AND record button is pressed AND game has started
-            //std::cout << std::hex << "GameId=" << PowerPC::MMU::HostRead_U32(guard, aGameId) << "GameState=" <<  PowerPC::MMU::HostRead_U8(aGameControlStateCurr) << '\n';
-            if ((PowerPC::MMU::HostRead_U32(guard, aGameId) != 0) && (PowerPC::MMU::HostRead_U8(guard, aGameControlStateCurr) == 0x5) ) {
-                m_game_info.game_id = PowerPC::MMU::HostRead_U32(guard, aGameId);
+            //std::cout << std::hex << "GameId=" << m_snapshot.read<u32>(guard, aGameId) << "GameState=" <<  PowerPC::MMU::HostRead_U8(aGameControlStateCurr) << '\n';
+            if ((m_snapshot.read<u32>(guard, aGameId) != 0) && (m_snapshot.read<u8>(guard, aGameControlStateCurr) == 0x5) ) {
+                m_game_info.game_id = m_snapshot.read<u32>(guard, aGameId);
                 //Sample settings
                 m_game_info.netplay = m_state.m_netplay_session;
                 m_game_info.netplay_opponent_alias = m_state.m_netplay_opponent_alias;
@@ -504,6 +642,8 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
 
 
                 m_game_state = GAME_STATE::INGAME;
+                m_event_journal.begin();
+                m_archive_events.clear();
 
                 std::string tag_set_id_str = "\"\"";
                 if (m_game_info.tag_set_id.has_value()){
@@ -518,40 +658,36 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
                 logGameInfo(guard);
                 std::cout << "Logging Character Stats\n";
 
+                //Decoded file, local file and server submission all come out of one pass over the game
+                const bool submit_game = shouldSubmitGame();
+                m_json_writer.reset();
+                const size_t decoded_json = m_json_writer.addTarget(true);
+                const size_t local_json = m_json_writer.addTarget(false, true);
+                const size_t submit_json = submit_game ? m_json_writer.addTarget(false, false) : 0;
+                writeStatJSON(m_json_writer);
+
                 std::string jsonPath = getStatJsonPath("decoded.");
-                std::string json = getStatJSON(true);
-                    
-                File::WriteStringToFile(jsonPath, json);
+                File::WriteStringToFile(jsonPath, m_json_writer.view(decoded_json));
 
                 jsonPath = getStatJsonPath("");
-                json = getStatJSON(false, true);
                 //TODO: See if user has signed up for beta test features in future
-                File::WriteStringToFile(jsonPath, json);
+                File::WriteStringToFile(jsonPath, m_json_writer.view(local_json));
 
-                //File::WriteStringToFile(jsonPath, json);
                 //https://api.projectrio.app/populate_db
 
-                //Print server warning message
-                OSD::AddTypedMessage(OSD::MessageType::GameStateInfo, fmt::format(
-                    "Submitting game to server \n",
-                    "DO NOT LEAVE THE GAME OR CLOSE RIO"           
-                ), 500, OSD::Color::RED);
-                
-                json = getStatJSON(false, false);
-                if (shouldSubmitGame()) {
-                    const Common::HttpRequest::Response response =
-                    m_http.Post("https://api.projectrio.app/populate_db/", json,
-                        {
-                            {"Content-Type", "application/json"},
-                        }
-                    );
+                if (submit_game) {
+                    //Hand off to the uploader thread, never wait on the server here
+                    m_uploader.submitGame(m_json_writer.str(submit_json));
 
-                    // Print server warning message
                     OSD::AddTypedMessage(OSD::MessageType::GameStateInfo,
-                                         fmt::format("Done submitting game \n", "SAFE TO QUIT"),
-                                         5000, OSD::Color::GREEN);
+                                         "Submitting game to server", 3000, OSD::Color::YELLOW);
                 }
 
+                archiveGame();
+
+                //Stat files are written, the journal is no longer needed
+                m_event_journal.discard();
+
                 std::cout << "Logging to " << jsonPath << "\n";
                 std::cout << "INGAME->ENDGAME\n";
 
@@ -577,16 +713,16 @@ void StatTracker::lookForTriggerEvents(const Core::CPUThreadGuard& guard)
 
 void StatTracker::logGameInfo(const Core::CPUThreadGuard& guard){
 
-    std::time_t unix_time = std::time(nullptr);
+    std::time_t unix_time = getFrameTime();
 
     m_game_info.end_unix_date_time = std::to_string(unix_time);
     m_game_info.end_local_date_time = std::asctime(std::localtime(&unix_time));
     m_game_info.end_local_date_time.pop_back();
 
-    m_game_info.stadium = PowerPC::MMU::HostRead_U8(guard, aStadiumId);
+    m_game_info.stadium = m_snapshot.read<u8>(guard, aStadiumId);
 
-    m_game_info.innings_selected = PowerPC::MMU::HostRead_U8(guard, aInningsSelected);
-    m_game_info.innings_played = PowerPC::MMU::HostRead_U8(guard, aAB_Inning);
+    m_game_info.innings_selected = m_snapshot.read<u8>(guard, aInningsSelected);
+    m_game_info.innings_played = m_snapshot.read<u8>(guard, aAB_Inning);
 
     ////Captains
     //if (m_game_info.away_port == m_game_info.team0_port){
@@ -598,8 +734,8 @@ void StatTracker::logGameInfo(const Core::CPUThreadGuard& guard){
     //    m_game_info.home_captain = PowerPC::MMU::HostRead_U8(aTeam0_Captain);
     //}
 
-    m_game_info.away_score = PowerPC::MMU::HostRead_U16(guard, aAwayTeam_Score);
-    m_game_info.home_score = PowerPC::MMU::HostRead_U16(guard, aHomeTeam_Score);
+    m_game_info.away_score = m_snapshot.read<u16>(guard, aAwayTeam_Score);
+    m_game_info.home_score = m_snapshot.read<u16>(guard, aHomeTeam_Score);
 
     for (int team=0; team < cNumOfTeams; ++team){
         for (int roster=0; roster < cRosterSize; ++roster){
@@ -621,27 +757,27 @@ void StatTracker::logDefensiveStats(const Core::CPUThreadGuard& guard, int in_te
     
     auto& stat = m_game_info.character_summaries[idx][roster_id].end_game_defensive_stats;
 
-    m_game_info.character_summaries[idx][roster_id].is_starred = PowerPC::MMU::HostRead_U8(guard, aPitcher_IsStarred + is_starred_offset);
-
-    stat.batters_faced       = PowerPC::MMU::HostRead_U8(guard, aPitcher_BattersFaced + offset);
-    stat.runs_allowed        = PowerPC::MMU::HostRead_U16(guard, aPitcher_RunsAllowed + offset);
-    stat.earned_runs         = PowerPC::MMU::HostRead_U16(guard, aPitcher_RunsAllowed + offset);
-    stat.batters_walked      = PowerPC::MMU::HostRead_U16(guard, aPitcher_BattersWalked + offset);
-    stat.batters_hit         = PowerPC::MMU::HostRead_U16(guard, aPitcher_BattersHit + offset);
-    stat.hits_allowed        = PowerPC::MMU::HostRead_U16(guard, aPitcher_HitsAllowed + offset);
-    stat.homeruns_allowed    = PowerPC::MMU::HostRead_U16(guard, aPitcher_HRsAllowed + offset);
-    stat.pitches_thrown      = PowerPC::MMU::HostRead_U16(guard, aPitcher_PitchesThrown + offset);
-    stat.stamina             = PowerPC::MMU::HostRead_U16(guard, aPitcher_Stamina + offset);
-    stat.was_pitcher         = PowerPC::MMU::HostRead_U8(guard, aPitcher_WasPitcher + offset);
-    stat.batter_outs         = PowerPC::MMU::HostRead_U8(guard, aPitcher_BatterOuts + offset);
-    stat.outs_pitched        = PowerPC::MMU::HostRead_U8(guard, aPitcher_OutsPitched + offset);
-    stat.strike_outs         = PowerPC::MMU::HostRead_U8(guard, aPitcher_StrikeOuts + offset);
-    stat.star_pitches_thrown = PowerPC::MMU::HostRead_U8(guard, aPitcher_StarPitchesThrown + offset);
+    m_game_info.character_summaries[idx][roster_id].is_starred = m_snapshot.read<u8>(guard, aPitcher_IsStarred + is_starred_offset);
+
+    stat.batters_faced       = m_snapshot.read<u8>(guard, aPitcher_BattersFaced + offset);
+    stat.runs_allowed        = m_snapshot.read<u16>(guard, aPitcher_RunsAllowed + offset);
+    stat.earned_runs         = m_snapshot.read<u16>(guard, aPitcher_RunsAllowed + offset);
+    stat.batters_walked      = m_snapshot.read<u16>(guard, aPitcher_BattersWalked + offset);
+    stat.batters_hit         = m_snapshot.read<u16>(guard, aPitcher_BattersHit + offset);
+    stat.hits_allowed        = m_snapshot.read<u16>(guard, aPitcher_HitsAllowed + offset);
+    stat.homeruns_allowed    = m_snapshot.read<u16>(guard, aPitcher_HRsAllowed + offset);
+    stat.pitches_thrown      = m_snapshot.read<u16>(guard, aPitcher_PitchesThrown + offset);
+    stat.stamina             = m_snapshot.read<u16>(guard, aPitcher_Stamina + offset);
+    stat.was_pitcher         = m_snapshot.read<u8>(guard, aPitcher_WasPitcher + offset);
+    stat.batter_outs         = m_snapshot.read<u8>(guard, aPitcher_BatterOuts + offset);
+    stat.outs_pitched        = m_snapshot.read<u8>(guard, aPitcher_OutsPitched + offset);
+    stat.strike_outs         = m_snapshot.read<u8>(guard, aPitcher_StrikeOuts + offset);
+    stat.star_pitches_thrown = m_snapshot.read<u8>(guard, aPitcher_StarPitchesThrown + offset);
 
     //Get inherent values. Doesn't strictly belong here but we need the adjusted_team_id
-    m_game_info.character_summaries[idx][roster_id].char_id = PowerPC::MMU::HostRead_U8(guard, aInGame_CharAttributes_CharId + ingame_attribute_table_offset);
-    m_game_info.character_summaries[idx][roster_id].fielding_hand = PowerPC::MMU::HostRead_U8(guard, aInGame_CharAttributes_FieldingHand + ingame_attribute_table_offset);
-    m_game_info.character_summaries[idx][roster_id].batting_hand = PowerPC::MMU::HostRead_U8(guard, aInGame_CharAttributes_BattingHand + ingame_attribute_table_offset);
+    m_game_info.character_summaries[idx][roster_id].char_id = m_snapshot.read<u8>(guard, aInGame_CharAttributes_CharId + ingame_attribute_table_offset);
+    m_game_info.character_summaries[idx][roster_id].fielding_hand = m_snapshot.read<u8>(guard, aInGame_CharAttributes_FieldingHand + ingame_attribute_table_offset);
+    m_game_info.character_summaries[idx][roster_id].batting_hand = m_snapshot.read<u8>(guard, aInGame_CharAttributes_BattingHand + ingame_attribute_table_offset);
 
 }
 
@@ -653,62 +789,62 @@ void StatTracker::logOffensiveStats(const Core::CPUThreadGuard& guard, int in_te
 
     auto& stat = m_game_info.character_summaries[idx][roster_id].end_game_offensive_stats;
 
-    stat.at_bats          = PowerPC::MMU::HostRead_U8(guard, aBatter_AtBats + offset);
-    stat.hits             = PowerPC::MMU::HostRead_U8(guard, aBatter_Hits + offset);
-    stat.singles          = PowerPC::MMU::HostRead_U8(guard, aBatter_Singles + offset);
-    stat.doubles          = PowerPC::MMU::HostRead_U8(guard, aBatter_Doubles + offset);
-    stat.triples          = PowerPC::MMU::HostRead_U8(guard, aBatter_Triples + offset);
-    stat.homeruns         = PowerPC::MMU::HostRead_U8(guard, aBatter_Homeruns + offset);
-    stat.successful_bunts = PowerPC::MMU::HostRead_U8(guard, aBatter_BuntSuccess + offset);
-    stat.sac_flys         = PowerPC::MMU::HostRead_U8(guard, aBatter_SacFlys + offset);
-    stat.strikouts        = PowerPC::MMU::HostRead_U8(guard, aBatter_Strikeouts + offset);
-    stat.walks_4balls     = PowerPC::MMU::HostRead_U8(guard, aBatter_Walks_4Balls + offset);
-    stat.walks_hit        = PowerPC::MMU::HostRead_U8(guard, aBatter_Walks_Hit + offset);
-    stat.rbi              = PowerPC::MMU::HostRead_U8(guard, aBatter_RBI + offset);
-    stat.bases_stolen     = PowerPC::MMU::HostRead_U8(guard, aBatter_BasesStolen + offset);
-    stat.star_hits        = PowerPC::MMU::HostRead_U8(guard, aBatter_StarHits + offset);
-
-    m_game_info.character_summaries[idx][roster_id].end_game_defensive_stats.big_plays = PowerPC::MMU::HostRead_U8(guard, aBatter_BigPlays + offset);
+    stat.at_bats          = m_snapshot.read<u8>(guard, aBatter_AtBats + offset);
+    stat.hits             = m_snapshot.read<u8>(guard, aBatter_Hits + offset);
+    stat.singles          = m_snapshot.read<u8>(guard, aBatter_Singles + offset);
+    stat.doubles          = m_snapshot.read<u8>(guard, aBatter_Doubles + offset);
+    stat.triples          = m_snapshot.read<u8>(guard, aBatter_Triples + offset);
+    stat.homeruns         = m_snapshot.read<u8>(guard, aBatter_Homeruns + offset);
+    stat.successful_bunts = m_snapshot.read<u8>(guard, aBatter_BuntSuccess + offset);
+    stat.sac_flys         = m_snapshot.read<u8>(guard, aBatter_SacFlys + offset);
+    stat.strikouts        = m_snapshot.read<u8>(guard, aBatter_Strikeouts + offset);
+    stat.walks_4balls     = m_snapshot.read<u8>(guard, aBatter_Walks_4Balls + offset);
+    stat.walks_hit        = m_snapshot.read<u8>(guard, aBatter_Walks_Hit + offset);
+    stat.rbi              = m_snapshot.read<u8>(guard, aBatter_RBI + offset);
+    stat.bases_stolen     = m_snapshot.read<u8>(guard, aBatter_BasesStolen + offset);
+    stat.star_hits        = m_snapshot.read<u8>(guard, aBatter_StarHits + offset);
+
+    m_game_info.character_summaries[idx][roster_id].end_game_defensive_stats.big_plays = m_snapshot.read<u8>(guard, aBatter_BigPlays + offset);
 }
 
 void StatTracker::logEventState(const Core::CPUThreadGuard& guard, Event& in_event){
-    in_event.inning          = PowerPC::MMU::HostRead_U8(guard, aAB_Inning);
-    in_event.half_inning     = PowerPC::MMU::HostRead_U8(guard, aAB_HalfInning);
+    in_event.inning          = m_snapshot.read<u8>(guard, aAB_Inning);
+    in_event.half_inning     = m_snapshot.read<u8>(guard, aAB_HalfInning);
 
     //Figure out scores
-    in_event.away_score = PowerPC::MMU::HostRead_U16(guard, aAwayTeam_Score);
-    in_event.home_score = PowerPC::MMU::HostRead_U16(guard, aHomeTeam_Score);
+    in_event.away_score = m_snapshot.read<u16>(guard, aAwayTeam_Score);
+    in_event.home_score = m_snapshot.read<u16>(guard, aHomeTeam_Score);
 
-    in_event.balls           = PowerPC::MMU::HostRead_U8(guard, aAB_Balls);
-    in_event.strikes         = PowerPC::MMU::HostRead_U8(guard, aAB_Strikes);
-    in_event.outs            = PowerPC::MMU::HostRead_U8(guard, aAB_Outs);
+    in_event.balls           = m_snapshot.read<u8>(guard, aAB_Balls);
+    in_event.strikes         = m_snapshot.read<u8>(guard, aAB_Strikes);
+    in_event.outs            = m_snapshot.read<u8>(guard, aAB_Outs);
     
     //Figure out star ownership
     if (m_game_info.team0_port == m_game_info.away_port){
-        in_event.away_stars = PowerPC::MMU::HostRead_U8(guard, aAB_P1_Stars);
-        in_event.home_stars = PowerPC::MMU::HostRead_U8(guard, aAB_P2_Stars);
+        in_event.away_stars = m_snapshot.read<u8>(guard, aAB_P1_Stars);
+        in_event.home_stars = m_snapshot.read<u8>(guard, aAB_P2_Stars);
     }
     else {
-        in_event.away_stars = PowerPC::MMU::HostRead_U8(guard, aAB_P2_Stars);
-        in_event.home_stars = PowerPC::MMU::HostRead_U8(guard, aAB_P1_Stars);
+        in_event.away_stars = m_snapshot.read<u8>(guard, aAB_P2_Stars);
+        in_event.home_stars = m_snapshot.read<u8>(guard, aAB_P1_Stars);
     }
     
-    in_event.is_star_chance  = PowerPC::MMU::HostRead_U8(guard, aAB_IsStarChance);
-    in_event.chem_links_ob   = PowerPC::MMU::HostRead_U8(guard, aAB_ChemLinksOnBase);
+    in_event.is_star_chance  = m_snapshot.read<u8>(guard, aAB_IsStarChance);
+    in_event.chem_links_ob   = m_snapshot.read<u8>(guard, aAB_ChemLinksOnBase);
 
     //The following stamina lookup requires team_id to be in teams of team0 or team1
 
     auto batter_fielder_ports = getBatterFielderPorts(guard);
     u8 pitching_team = (batter_fielder_ports.second == m_game_info.team1_port); //1 if the pitching team is team1
-    u8 pitcher_roster_loc = PowerPC::MMU::HostRead_U8(guard, aAB_PitcherRosterID);
+    u8 pitcher_roster_loc = m_snapshot.read<u8>(guard, aAB_PitcherRosterID);
     
     //Calc the pitcher stamina offset and add it to the base stamina addr - TODO move to EventSummary
     u32 pitcherStaminaOffset = ((pitching_team * cRosterSize * c_defensive_stat_offset) + (pitcher_roster_loc * c_defensive_stat_offset));
-    in_event.pitcher_stamina = PowerPC::MMU::HostRead_U16(guard, aPitcher_Stamina + pitcherStaminaOffset);
+    in_event.pitcher_stamina = m_snapshot.read<u16>(guard, aPitcher_Stamina + pitcherStaminaOffset);
 
-    in_event.pitcher_roster_loc = PowerPC::MMU::HostRead_U8(guard, aAB_PitcherRosterID);
-    in_event.batter_roster_loc  = PowerPC::MMU::HostRead_U8(guard, aAB_BatterRosterID);
-    in_event.catcher_roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielder_RosterLoc + (1 * cFielder_Offset));
+    in_event.pitcher_roster_loc = m_snapshot.read<u8>(guard, aAB_PitcherRosterID);
+    in_event.batter_roster_loc  = m_snapshot.read<u8>(guard, aAB_BatterRosterID);
+    in_event.catcher_roster_loc = m_snapshot.read<u8>(guard, aFielder_RosterLoc + (1 * cFielder_Offset));
 }
 
 void StatTracker::logContact(const Core::CPUThreadGuard& guard, Event& in_event){
@@ -720,34 +856,34 @@ void StatTracker::logContact(const Core::CPUThreadGuard& guard, Event& in_event)
     std::cout << "  Pitch Type: " << std::to_string(in_event.pitch->pitch_type) << "\n";
     Contact* contact = &in_event.pitch->contact.value();
 
-    contact->power.read_value(guard);
-    contact->vert_angle.read_value(guard);
-    contact->horiz_angle.read_value(guard);
-    contact->ball_x_velo.read_value(guard);
-    contact->ball_y_velo.read_value(guard);
-    contact->ball_z_velo.read_value(guard);
-    contact->ball_contact_x_pos.read_value(guard);
-    contact->ball_contact_z_pos.read_value(guard);
-    contact->contact_absolute.read_value(guard);
-    contact->contact_quality.read_value(guard);
-    contact->rng1.read_value(guard);
-    contact->rng2.read_value(guard);
-    contact->rng3.read_value(guard);
-    contact->type_of_contact.read_value(guard);
-    contact->moon_shot.read_value(guard);
-    contact->charge_power_up.read_value(guard);
-    contact->charge_power_down.read_value(guard);
-    contact->input_direction_push_pull.read_value(guard);
-    contact->frame_of_swing.read_value(guard);
+    contact->power.read_value(guard, m_snapshot);
+    contact->vert_angle.read_value(guard, m_snapshot);
+    contact->horiz_angle.read_value(guard, m_snapshot);
+    contact->ball_x_velo.read_value(guard, m_snapshot);
+    contact->ball_y_velo.read_value(guard, m_snapshot);
+    contact->ball_z_velo.read_value(guard, m_snapshot);
+    contact->ball_contact_x_pos.read_value(guard, m_snapshot);
+    contact->ball_contact_z_pos.read_value(guard, m_snapshot);
+    contact->contact_absolute.read_value(guard, m_snapshot);
+    contact->contact_quality.read_value(guard, m_snapshot);
+    contact->rng1.read_value(guard, m_snapshot);
+    contact->rng2.read_value(guard, m_snapshot);
+    contact->rng3.read_value(guard, m_snapshot);
+    contact->type_of_contact.read_value(guard, m_snapshot);
+    contact->moon_shot.read_value(guard, m_snapshot);
+    contact->charge_power_up.read_value(guard, m_snapshot);
+    contact->charge_power_down.read_value(guard, m_snapshot);
+    contact->input_direction_push_pull.read_value(guard, m_snapshot);
+    contact->frame_of_swing.read_value(guard, m_snapshot);
 
     //More ball flight info
-    contact->ball_max_height.read_value(guard);
-    contact->ball_hang_time.read_value(guard);
+    contact->ball_max_height.read_value(guard, m_snapshot);
+    contact->ball_hang_time.read_value(guard, m_snapshot);
 
     u32 aStickInput = aAB_ControlStickInput + (getBatterFielderPorts(guard).first * cControl_Offset);
-    //std::cout << "Batter Port=" << std::to_string(getBatterFielderPorts().first) << " Stick Addr=" << std::hex << aStickInput << " Stick Value=" << (PowerPC::MMU::HostRead_U16(guard, aStickInput) & 0xF) << "\n";
-    contact->input_direction_stick.set_value(PowerPC::MMU::HostRead_U16(guard, aStickInput) & 0xF); //Mask off the lower 4 bits which are the control stick directions
-    //std::cout << "  Stick Value Decoded=" << decode("StickVec", contact->input_direction_stick.get_value(), true) << "\n";
+    //std::cout << "Batter Port=" << std::to_string(getBatterFielderPorts().first) << " Stick Addr=" << std::hex << aStickInput << " Stick Value=" << (m_snapshot.read<u16>(guard, aStickInput) & 0xF) << "\n";
+    contact->input_direction_stick.set_value(m_snapshot.read<u16>(guard, aStickInput) & 0xF); //Mask off the lower 4 bits which are the control stick directions
+    //std::cout << "  Stick Value Decoded=" << decodeName(DecodeType::StickVec, contact->input_direction_stick.get_value()) << "\n";
     std::cout << "SWING: " << contact->frame_of_swing.get_key_value_string().first << "=" << contact->frame_of_swing.get_key_value_string().second << "\n";
     std::cout << "\n";
 }
@@ -757,26 +893,26 @@ void StatTracker::logPitch(const Core::CPUThreadGuard& guard, Event& in_event){
 
     in_event.pitch->logged = true;
     in_event.pitch->pitcher_team_id    = !in_event.half_inning;
-    in_event.pitch->pitcher_char_id    = PowerPC::MMU::HostRead_U8(guard, aAB_PitcherID);
-    in_event.pitch->pitch_type         = PowerPC::MMU::HostRead_U8(guard, aAB_PitchType);
-    in_event.pitch->charge_type        = PowerPC::MMU::HostRead_U8(guard, aAB_ChargePitchType);
-    in_event.pitch->star_pitch         = ((PowerPC::MMU::HostRead_U8(guard, aAB_StarPitch_NonCaptain) > 0) || (PowerPC::MMU::HostRead_U8(guard, aAB_StarPitch_Captain) > 0));
-    in_event.pitch->pitch_speed        = PowerPC::MMU::HostRead_U8(guard, aAB_PitchSpeed);
+    in_event.pitch->pitcher_char_id    = m_snapshot.read<u8>(guard, aAB_PitcherID);
+    in_event.pitch->pitch_type         = m_snapshot.read<u8>(guard, aAB_PitchType);
+    in_event.pitch->charge_type        = m_snapshot.read<u8>(guard, aAB_ChargePitchType);
+    in_event.pitch->star_pitch         = ((m_snapshot.read<u8>(guard, aAB_StarPitch_NonCaptain) > 0) || (m_snapshot.read<u8>(guard, aAB_StarPitch_Captain) > 0));
+    in_event.pitch->pitch_speed        = m_snapshot.read<u8>(guard, aAB_PitchSpeed);
 
-    in_event.pitch->ball_z_strike_vs_ball = PowerPC::MMU::HostRead_U32(guard, aAB_PitchBallPosZStrikezone);
-    in_event.pitch->bat_contact_x_pos.read_value(guard);
-    in_event.pitch->bat_contact_z_pos.read_value(guard);
+    in_event.pitch->ball_z_strike_vs_ball = m_snapshot.read<u32>(guard, aAB_PitchBallPosZStrikezone);
+    in_event.pitch->bat_contact_x_pos.read_value(guard, m_snapshot);
+    in_event.pitch->bat_contact_z_pos.read_value(guard, m_snapshot);
 
     float ballposz_strikezone = floatConverter(in_event.pitch->ball_z_strike_vs_ball);
-    float strikezone_left = floatConverter(PowerPC::MMU::HostRead_U32(guard, aAB_PitchStrikezoneEdgeLeft));
-    float strikezone_right = floatConverter(PowerPC::MMU::HostRead_U32(guard, aAB_PitchStrikezoneEdgeRight));
+    float strikezone_left = floatConverter(m_snapshot.read<u32>(guard, aAB_PitchStrikezoneEdgeLeft));
+    float strikezone_right = floatConverter(m_snapshot.read<u32>(guard, aAB_PitchStrikezoneEdgeRight));
     in_event.pitch->ball_in_strikezone = (strikezone_left < ballposz_strikezone && ballposz_strikezone < strikezone_right) ? 1 : 0;
     
     // === Batter info ===
 
     //First slap,charge,star,bunt
-    u8 swing_type = PowerPC::MMU::HostRead_U8(guard, aAB_TypeOfSwing);  // 0=Slap, 1=charge, 3=bunt
-    u8 star_swing = PowerPC::MMU::HostRead_U8(guard, aAB_StarSwing);
+    u8 swing_type = m_snapshot.read<u8>(guard, aAB_TypeOfSwing);  // 0=Slap, 1=charge, 3=bunt
+    u8 star_swing = m_snapshot.read<u8>(guard, aAB_StarSwing);
     u8 adjusted_swing = 0; //0=miss, 1=slap, 2=charge, 3=star, 4=bunt
     //Adjust swing to definition
     if (star_swing != 0){
@@ -787,7 +923,7 @@ void StatTracker::logPitch(const Core::CPUThreadGuard& guard, Event& in_event){
     }
 
     //Use adjusted swing if swing and miss, else 0 (or 4 for bunt)
-    u8 any_swing = PowerPC::MMU::HostRead_U8(guard, aAB_AnySwing);  // 0=No swing, 1=swing
+    u8 any_swing = m_snapshot.read<u8>(guard, aAB_AnySwing);  // 0=No swing, 1=swing
     if (any_swing == 0) {
         in_event.pitch->type_of_swing = 0;
     }
@@ -796,21 +932,21 @@ void StatTracker::logPitch(const Core::CPUThreadGuard& guard, Event& in_event){
     }
 
     std::cout << "SWING: Swing Type=" << std::to_string(swing_type) << " Star Swing=" << std::to_string(star_swing) 
-              << " AnySwing=" << std::to_string(PowerPC::MMU::HostRead_U8(guard, aAB_AnySwing)) << " Final=" << std::to_string(in_event.pitch->type_of_swing) << "\n";
+              << " AnySwing=" << std::to_string(m_snapshot.read<u8>(guard, aAB_AnySwing)) << " Final=" << std::to_string(in_event.pitch->type_of_swing) << "\n";
 }
 
 void StatTracker::logContactResult(const Core::CPUThreadGuard& guard, Contact* in_contact){
     std::cout << "Logging Contact Result\n";
 
-    u8 result = PowerPC::MMU::HostRead_U8(guard, aAB_ContactResult);
+    u8 result = m_snapshot.read<u8>(guard, aAB_ContactResult);
 
     //Log primary contact result (and secondary if possible)
     if (result == 1 || result == 2){
         in_contact->primary_contact_result = result+1; //Landed Fair
         m_event_state = EVENT_STATE::LOG_FIELDER;
-        in_contact->ball_x_pos.read_value(guard);
-        in_contact->ball_y_pos.read_value(guard);
-        in_contact->ball_z_pos.read_value(guard);
+        in_contact->ball_x_pos.read_value(guard, m_snapshot);
+        in_contact->ball_y_pos.read_value(guard, m_snapshot);
+        in_contact->ball_z_pos.read_value(guard, m_snapshot);
 
         //If 2, ball has been caught. Log this as final fielder. If ball has been bobbled they will be logged as bobble
         in_contact->collect_fielder = logFielderWithBall(guard);
@@ -841,16 +977,16 @@ void StatTracker::logContactResult(const Core::CPUThreadGuard& guard, Contact* i
     else if (result == 0xFF){ // Known bug: this will be true for foul or HR. Correct when adjusting secondary contact later
         in_contact->primary_contact_result = 1; //Foul
         in_contact->secondary_contact_result = 3; //Foul
-        in_contact->ball_x_pos.read_value(guard);
-        in_contact->ball_y_pos.read_value(guard);
-        in_contact->ball_z_pos.read_value(guard);
+        in_contact->ball_x_pos.read_value(guard, m_snapshot);
+        in_contact->ball_y_pos.read_value(guard, m_snapshot);
+        in_contact->ball_z_pos.read_value(guard, m_snapshot);
     }
     else{
         in_contact->primary_contact_result = result;
         in_contact->secondary_contact_result = 0xFF; //???
-        in_contact->ball_x_pos.read_value(guard);
-        in_contact->ball_y_pos.read_value(guard);
-        in_contact->ball_z_pos.read_value(guard);
+        in_contact->ball_x_pos.read_value(guard, m_snapshot);
+        in_contact->ball_y_pos.read_value(guard, m_snapshot);
+        in_contact->ball_z_pos.read_value(guard, m_snapshot);
     }
 }
 
@@ -879,7 +1015,7 @@ void StatTracker::logFinalResults(const Core::CPUThreadGuard& guard, Event& in_e
     }
 
     //num_outs_during_play
-    auto num_outs = in_event.num_outs_during_play.read_value(guard);
+    auto num_outs = in_event.num_outs_during_play.read_value(guard, m_snapshot);
     std::cout << "Num outs for play=" << std::to_string(num_outs) << "\n";
     m_fielder_tracker[!m_game_info.getCurrentEvent().half_inning].incrementBatterOutForPosition(num_outs);
 
@@ -896,6 +1032,15 @@ void StatTracker::logFinalResults(const Core::CPUThreadGuard& guard, Event& in_e
     }
 }
 
+std::time_t StatTracker::getFrameTime() const{
+    const Movie::MovieManager& movie = Core::System::GetInstance().GetMovie();
+    if (!movie.IsPlayingInput())
+        return std::time(nullptr);
+
+    //Counted from the start of the recording, the game runs at 60 frames a second
+    return static_cast<std::time_t>(movie.GetRecordingStartTime() + movie.GetCurrentFrame() / 60);
+}
+
 std::string StatTracker::getStatJsonPath(std::string prefix){
     std::string away_player_name;
     std::string home_player_name;
@@ -908,7 +1053,7 @@ std::string StatTracker::getStatJsonPath(std::string prefix){
         home_player_name = m_game_info.team0_player.GetUsername();
     }
 
-    std::time_t unix_time = std::time(nullptr);
+    std::time_t unix_time = getFrameTime();
     char datetime_c[256];
     std::strftime(datetime_c, sizeof(datetime_c), "%Y%m%dT%H%M%S", std::localtime(&unix_time));
     
@@ -922,42 +1067,90 @@ std::string StatTracker::getStatJsonPath(std::string prefix){
 }
 
 std::string StatTracker::getStatJSON(bool inDecode, bool hide_riokey){
-    //TODO switch to IDs when submitting game
-    std::string away_player_info = (inDecode || hide_riokey) ? m_game_info.getAwayTeamPlayer().GetUsername() : m_game_info.getAwayTeamPlayer().GetUserID();
-    std::string home_player_info = (inDecode || hide_riokey) ? m_game_info.getHomeTeamPlayer().GetUsername() : m_game_info.getHomeTeamPlayer().GetUserID();
+    m_json_writer.reset();
+    const size_t target = m_json_writer.addTarget(inDecode, hide_riokey);
+    writeStatJSON(m_json_writer);
+    return m_json_writer.str(target);
+}
 
-    std::stringstream json_stream;
+void StatTracker::writeStatJSON(StatJsonWriter& json){
+    LocalPlayers::LocalPlayers::Player away_player = m_game_info.getAwayTeamPlayer();
+    LocalPlayers::LocalPlayers::Player home_player = m_game_info.getHomeTeamPlayer();
+    //TODO switch to IDs when submitting game
+    const std::string away_player_name = away_player.GetUsername();
+    const std::string home_player_name = home_player.GetUsername();
+    const std::string away_player_id = away_player.GetUserID();
+    const std::string home_player_id = home_player.GetUserID();
+
+    json.raw("{\n");
+    json.format("  \"GameID\": \"{}\",\n", m_game_info.game_id);
+    json.perTarget([&](StatJsonWriter::Target& target){
+        const std::string& start_date_time = (target.decode) ? m_game_info.start_local_date_time : m_game_info.start_unix_date_time;
+        const std::string& end_date_time = (target.decode) ? m_game_info.end_local_date_time : m_game_info.end_unix_date_time;
+        fmt::format_to(fmt::appender(target.buffer), "  \"Date - Start\": \"{}\",\n", start_date_time);
+        fmt::format_to(fmt::appender(target.buffer), "  \"Date - End\": \"{}\",\n", end_date_time);
+    });
 
-    json_stream << "{\n";
-    std::string stadium = (inDecode) ? "\"" + cStadiumIdToStadiumName.at(m_game_info.stadium) + "\"" : std::to_string(m_game_info.stadium);
-    std::string start_date_time = (inDecode) ? m_game_info.start_local_date_time : m_game_info.start_unix_date_time;
-    std::string end_date_time = (inDecode) ? m_game_info.end_local_date_time : m_game_info.end_unix_date_time;
-    json_stream << "  \"GameID\": \"" << m_game_info.game_id << "\",\n";
-    json_stream << "  \"Date - Start\": \"" << start_date_time << "\",\n";
-    json_stream << "  \"Date - End\": \"" << end_date_time << "\",\n";
-    
-    std::string tag_set_id_str = "\"\"";
     if (m_game_info.tag_set_id.has_value()){
-        tag_set_id_str = std::to_string(m_game_info.tag_set_id.value());
+        json.format("  \"TagSetID\": {},\n", m_game_info.tag_set_id.value());
     }
-    json_stream << "  \"TagSetID\": " << tag_set_id_str << ",\n";
-    json_stream << "  \"Netplay\": " << std::to_string(m_game_info.netplay) << ",\n";
-    json_stream << "  \"StadiumID\": " << decode("Stadium", m_game_info.stadium, inDecode) << ",\n";
-    json_stream << "  \"Away Player\": \"" << away_player_info << "\",\n"; //TODO MAKE THIS AN ID
-    json_stream << "  \"Home Player\": \"" << home_player_info << "\",\n";
-
-    json_stream << "  \"Away Score\": " << std::dec << m_game_info.away_score << ",\n";
-    json_stream << "  \"Home Score\": " << std::dec << m_game_info.home_score << ",\n";
-
-    json_stream << "  \"Innings Selected\": " << std::to_string(m_game_info.innings_selected) << ",\n";
-    json_stream << "  \"Innings Played\": " << std::to_string(m_game_info.innings_played) << ",\n";
-    json_stream << "  \"Quitter Team\": " << decode("QuitterTeam", m_game_info.quitter_team, inDecode) << ",\n";
-
-    json_stream << "  \"Average Ping\": " << std::to_string(m_game_info.avg_ping) << ",\n";
-    json_stream << "  \"Lag Spikes\": " << std::to_string(m_game_info.lag_spikes) << ",\n";
-    json_stream << "  \"Version\": \"" << Common::GetRioRevStr() << "\",\n";
-
-    json_stream << "  \"Character Game Stats\": {\n";
+    else{
+        json.raw("  \"TagSetID\": \"\",\n");
+    }
+    json.format("  \"Netplay\": {},\n", static_cast<int>(m_game_info.netplay));
+    json.decoded("  \"StadiumID\": ", DecodeType::Stadium, m_game_info.stadium, ",\n");
+    json.perTarget([&](StatJsonWriter::Target& target){
+        const bool show_name = target.decode || target.hide_riokey;
+        fmt::format_to(fmt::appender(target.buffer), "  \"Away Player\": \"{}\",\n", show_name ? away_player_name : away_player_id); //TODO MAKE THIS AN ID
+        fmt::format_to(fmt::appender(target.buffer), "  \"Home Player\": \"{}\",\n", show_name ? home_player_name : home_player_id);
+    });
+
+    json.format("  \"Away Score\": {},\n", m_game_info.away_score);
+    json.format("  \"Home Score\": {},\n", m_game_info.home_score);
+
+    json.format("  \"Innings Selected\": {},\n", m_game_info.innings_selected);
+    json.format("  \"Innings Played\": {},\n", m_game_info.innings_played);
+    json.decoded("  \"Quitter Team\": ", DecodeType::QuitterTeam, m_game_info.quitter_team, ",\n");
+
+    json.format("  \"Average Ping\": {},\n", m_game_info.avg_ping);
+    json.format("  \"Lag Spikes\": {},\n", m_game_info.lag_spikes);
+    json.raw("  \"Pad Buffer Changes\": [");
+    for (size_t i = 0; i < m_game_info.pad_buffer_decisions.size(); ++i){
+        const auto& decision = m_game_info.pad_buffer_decisions[i];
+        json.format("{}\n    {{\"Event\": {}, \"Buffer\": {}, \"Previous Buffer\": {}, \"RTT ms\": {}, \"Jitter ms\": {}}}",
+                    (i == 0) ? "" : ",", decision.event_num, decision.buffer, decision.previous_buffer,
+                    decision.rtt_ms, decision.jitter_ms);
+    }
+    json.raw(m_game_info.pad_buffer_decisions.empty() ? "],\n" : "\n  ],\n");
+    const NetPlay::TimingSummary& timing = m_game_info.netplay_timing;
+    auto write_histogram = [&json](const char* name, const NetPlay::TimingHistogram& histogram, const char* end){
+        json.format("    \"{}\": {{", name);
+        for (size_t bucket = 0; bucket < NetPlay::TimingHistogram::BUCKETS; ++bucket){
+            json.format("{}\"{}\": {}", (bucket == 0) ? "" : ", ", NetPlay::TimingHistogram::GetLabel(bucket),
+                        histogram.counts[bucket]);
+        }
+        json.format("}}{}\n", end);
+    };
+    json.raw("  \"NetPlay Timing\": {\n");
+    json.format("    \"Frames\": {},\n", timing.frames);
+    json.format("    \"Stalls\": {},\n", timing.stalls);
+    json.format("    \"Stall ms\": {},\n", timing.stall_us / 1000);
+    json.format("    \"Longest Stall ms\": {},\n", timing.max_stall_us / 1000);
+    write_histogram("Stall ms Histogram", timing.stall_ms, ",");
+    json.format("    \"Pad Arrivals\": {},\n", timing.pad_arrivals);
+    write_histogram("Pad Arrival Interval ms Histogram", timing.arrival_interval_ms, ",");
+    write_histogram("Buffer Depth Histogram", timing.buffer_depth, ",");
+    json.format("    \"Host Polls\": {},\n", timing.host_polls);
+    json.format("    \"Golfer Switches\": {},\n", timing.golf_switches);
+    json.format("    \"Dropped Events\": {},\n", timing.dropped_events);
+    const NetPlay::RedundantPadReceiver::Stats& pad_transport = m_game_info.netplay_pad_transport;
+    json.format("    \"Pad Transport\": {{\"Reliable First\": {}, \"Unreliable First\": {}, \"Recovered\": {}, \"Gaps\": {}}}\n",
+                pad_transport.reliable_first, pad_transport.unreliable_first, pad_transport.recovered,
+                pad_transport.gaps);
+    json.raw("  },\n");
+    json.format("  \"Version\": \"{}\",\n", Common::GetRioRevStr());
+
+    json.raw("  \"Character Game Stats\": {\n");
 
     //Defensive Stats
     for (int team=0; team < cNumOfTeams; ++team){
@@ -969,333 +1162,424 @@ std::string StatTracker::getStatJSON(bool inDecode, bool hide_riokey){
             captain_roster_loc = (m_game_info.home_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
         }
 
-        std::string team_string = (team == 0) ? "Away" : "Home";
+        const char* team_string = (team == 0) ? "Away" : "Home";
 
         for (int roster=0; roster < cRosterSize; ++roster){
             CharacterSummary& char_summary = m_game_info.character_summaries[team][roster];
             
             // team integer home or away
-            std::string label = "\"" + team_string + " Roster " + std::to_string(roster) + "\": ";
-            json_stream << "    " << label << "{\n";
-            json_stream << "      \"Team\": \""        << std::to_string(team) << "\",\n";
-            json_stream << "      \"RosterID\": "      << std::to_string(roster) << ",\n";
-            json_stream << "      \"CharID\": "        << decode("Character", char_summary.char_id, inDecode) << ",\n";
-            json_stream << "      \"Superstar\": "     << std::to_string(char_summary.is_starred) << ",\n";
-            json_stream << "      \"Captain\": "       << std::to_string(roster == captain_roster_loc) << ",\n";
-            json_stream << "      \"Fielding Hand\": " << decode("Hand", char_summary.fielding_hand, inDecode) << ",\n";
-            json_stream << "      \"Batting Hand\": "  << decode("Hand", char_summary.batting_hand, inDecode) << ",\n";
+            json.format("    \"{} Roster {}\": {{\n", team_string, roster);
+            json.format("      \"Team\": \"{}\",\n", team);
+            json.format("      \"RosterID\": {},\n", roster);
+            json.decoded("      \"CharID\": ", DecodeType::Character, char_summary.char_id, ",\n");
+            json.format("      \"Superstar\": {},\n", char_summary.is_starred);
+            json.format("      \"Captain\": {},\n", static_cast<int>(roster == captain_roster_loc));
+            json.decoded("      \"Fielding Hand\": ", DecodeType::Hand, char_summary.fielding_hand, ",\n");
+            json.decoded("      \"Batting Hand\": ", DecodeType::Hand, char_summary.batting_hand, ",\n");
 
             //=== Defensive Stats ===
             EndGameRosterDefensiveStats& def_stat = char_summary.end_game_defensive_stats;
-            json_stream << "      \"Defensive Stats\": {\n";
-            json_stream << "        \"Batters Faced\": "       << std::to_string(def_stat.batters_faced) << ",\n";
-            json_stream << "        \"Runs Allowed\": "        << std::dec << def_stat.runs_allowed << ",\n";
-            json_stream << "        \"Earned Runs\": "        << std::dec << def_stat.earned_runs << ",\n";
-            json_stream << "        \"Batters Walked\": "      << def_stat.batters_walked << ",\n";
-            json_stream << "        \"Batters Hit\": "         << def_stat.batters_hit << ",\n";
-            json_stream << "        \"Hits Allowed\": "        << def_stat.hits_allowed << ",\n";
-            json_stream << "        \"HRs Allowed\": "         << def_stat.homeruns_allowed << ",\n";
-            json_stream << "        \"Pitches Thrown\": "      << def_stat.pitches_thrown << ",\n";
-            json_stream << "        \"Stamina\": "             << def_stat.stamina << ",\n";
-            json_stream << "        \"Was Pitcher\": "         << std::to_string(def_stat.was_pitcher) << ",\n";
-            json_stream << "        \"Strikeouts\": "          << std::to_string(def_stat.strike_outs) << ",\n";
-            json_stream << "        \"Star Pitches Thrown\": " << std::to_string(def_stat.star_pitches_thrown) << ",\n";
-            json_stream << "        \"Big Plays\": "           << std::to_string(def_stat.big_plays) << ",\n";
-            json_stream << "        \"Outs Pitched\": "        << std::to_string(def_stat.outs_pitched) << ",\n";
-            json_stream << "        \"Batters Per Position\": [\n";
-
+            json.raw("      \"Defensive Stats\": {\n");
+            json.format("        \"Batters Faced\": {},\n", def_stat.batters_faced);
+            json.format("        \"Runs Allowed\": {},\n", def_stat.runs_allowed);
+            json.format("        \"Earned Runs\": {},\n", def_stat.earned_runs);
+            json.format("        \"Batters Walked\": {},\n", def_stat.batters_walked);
+            json.format("        \"Batters Hit\": {},\n", def_stat.batters_hit);
+            json.format("        \"Hits Allowed\": {},\n", def_stat.hits_allowed);
+            json.format("        \"HRs Allowed\": {},\n", def_stat.homeruns_allowed);
+            json.format("        \"Pitches Thrown\": {},\n", def_stat.pitches_thrown);
+            json.format("        \"Stamina\": {},\n", def_stat.stamina);
+            json.format("        \"Was Pitcher\": {},\n", def_stat.was_pitcher);
+            json.format("        \"Strikeouts\": {},\n", def_stat.strike_outs);
+            json.format("        \"Star Pitches Thrown\": {},\n", def_stat.star_pitches_thrown);
+            json.format("        \"Big Plays\": {},\n", def_stat.big_plays);
+            json.format("        \"Outs Pitched\": {},\n", def_stat.outs_pitched);
+
+            FielderInfo& fielder_info = m_fielder_tracker[team].fielder_map[roster];
+            json.raw("        \"Batters Per Position\": [\n");
             if (m_fielder_tracker[team].battersAtAnyPosition(roster, 0)){
-                json_stream << "          {\n";
+                json.raw("          {\n");
                 for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].batter_count_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].battersAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].batter_count_by_position[pos]) << comma << "\n";
+                    if (fielder_info.batter_count_by_position[pos] > 0){
+                        const char* comma = (m_fielder_tracker[team].battersAtAnyPosition(roster, pos+1)) ? "," : "";
+                        json.format("            \"{}\": {}{}\n", decodeName(DecodeType::Position, pos), fielder_info.batter_count_by_position[pos], comma);
                     }
                 }
-                json_stream << "          }\n";
+                json.raw("          }\n");
             }
-            json_stream << "        ],\n";
+            json.raw("        ],\n");
 
-            json_stream << "        \"Batter Outs Per Position\": [\n";
+            json.raw("        \"Batter Outs Per Position\": [\n");
             if (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, 0)){
-                json_stream << "          {\n";
+                json.raw("          {\n");
                 for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].batter_outs_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].batter_outs_by_position[pos]) << comma << "\n";
+                    if (fielder_info.batter_outs_by_position[pos] > 0){
+                        const char* comma = (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, pos+1)) ? "," : "";
+                        json.format("            \"{}\": {}{}\n", decodeName(DecodeType::Position, pos), fielder_info.batter_outs_by_position[pos], comma);
                     }
                 }
-                json_stream << "          }\n";
+                json.raw("          }\n");
             }
-            json_stream << "        ],\n";
+            json.raw("        ],\n");
 
-            json_stream << "        \"Outs Per Position\": [\n";
+            json.raw("        \"Outs Per Position\": [\n");
             if (m_fielder_tracker[team].outsAtAnyPosition(roster, 0)){
-                json_stream << "          {\n";
+                json.raw("          {\n");
                 for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].out_count_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].outsAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].out_count_by_position[pos]) << comma << "\n";
+                    if (fielder_info.out_count_by_position[pos] > 0){
+                        const char* comma = (m_fielder_tracker[team].outsAtAnyPosition(roster, pos+1)) ? "," : "";
+                        json.format("            \"{}\": {}{}\n", decodeName(DecodeType::Position, pos), fielder_info.out_count_by_position[pos], comma);
                     }
                 }
-                json_stream << "          }\n";
+                json.raw("          }\n");
             }
-            json_stream << "        ]\n";
-            json_stream << "      },\n";
+            json.raw("        ]\n");
+            json.raw("      },\n");
 
             //=== Offensive Stats ===
             EndGameRosterOffensiveStats& of_stat = char_summary.end_game_offensive_stats;
-            json_stream << "      \"Offensive Stats\": {\n";
-            json_stream << "        \"At Bats\": "          << std::to_string(of_stat.at_bats) << ",\n";
-            json_stream << "        \"Hits\": "             << std::to_string(of_stat.hits) << ",\n";
-            json_stream << "        \"Singles\": "          << std::to_string(of_stat.singles) << ",\n";
-            json_stream << "        \"Doubles\": "          << std::to_string(of_stat.doubles) << ",\n";
-            json_stream << "        \"Triples\": "          << std::to_string(of_stat.triples) << ",\n";
-            json_stream << "        \"Homeruns\": "         << std::to_string(of_stat.homeruns) << ",\n";
-            json_stream << "        \"Successful Bunts\": " << std::to_string(of_stat.successful_bunts) << ",\n";
-            json_stream << "        \"Sac Flys\": "         << std::to_string(of_stat.sac_flys) << ",\n";
-            json_stream << "        \"Strikeouts\": "       << std::to_string(of_stat.strikouts) << ",\n";
-            json_stream << "        \"Walks (4 Balls)\": "  << std::to_string(of_stat.walks_4balls) << ",\n";
-            json_stream << "        \"Walks (Hit)\": "      << std::to_string(of_stat.walks_hit) << ",\n";
-            json_stream << "        \"RBI\": "              << std::to_string(of_stat.rbi) << ",\n";
-            json_stream << "        \"Bases Stolen\": "     << std::to_string(of_stat.bases_stolen) << ",\n";
-            json_stream << "        \"Star Hits\": "        << std::to_string(of_stat.star_hits) << "\n";
-            json_stream << "      }\n";
-            std::string commas = ((roster == 8) && (team ==1)) ? "" : ",";
-            json_stream << "    }" << commas << "\n";
+            json.raw("      \"Offensive Stats\": {\n");
+            json.format("        \"At Bats\": {},\n", of_stat.at_bats);
+            json.format("        \"Hits\": {},\n", of_stat.hits);
+            json.format("        \"Singles\": {},\n", of_stat.singles);
+            json.format("        \"Doubles\": {},\n", of_stat.doubles);
+            json.format("        \"Triples\": {},\n", of_stat.triples);
+            json.format("        \"Homeruns\": {},\n", of_stat.homeruns);
+            json.format("        \"Successful Bunts\": {},\n", of_stat.successful_bunts);
+            json.format("        \"Sac Flys\": {},\n", of_stat.sac_flys);
+            json.format("        \"Strikeouts\": {},\n", of_stat.strikouts);
+            json.format("        \"Walks (4 Balls)\": {},\n", of_stat.walks_4balls);
+            json.format("        \"Walks (Hit)\": {},\n", of_stat.walks_hit);
+            json.format("        \"RBI\": {},\n", of_stat.rbi);
+            json.format("        \"Bases Stolen\": {},\n", of_stat.bases_stolen);
+            json.format("        \"Star Hits\": {}\n", of_stat.star_hits);
+            json.raw("      }\n");
+            json.raw(((roster == 8) && (team ==1)) ? "    }\n" : "    },\n");
         }
     }
-    json_stream << "  },\n";
+    json.raw("  },\n");
     //=== Events === 
-    json_stream << "  \"Events\": [\n";
-    for (auto event_map_iter = m_game_info.events.begin(); event_map_iter != m_game_info.events.end(); event_map_iter++) {
-        u8 event_num = event_map_iter->first;
-        Event& event = event_map_iter->second;
-
+    json.raw("  \"Events\": [\n");
+    //Finished events come straight from the journal, already rendered
+    bool first_event = (m_event_journal.getNumEvents() == 0);
+    if (!first_event){
+        json.perTarget([&](StatJsonWriter::Target& target){
+            m_event_journal.readEvents(target.decode, target.buffer);
+        });
+    }
+    m_game_info.events.forEach([&](u16 event_num, Event& event){
         //Don't log events with inning == 0. Means game has crashed/quit and this is an empty event
         if (event.inning == 0) {
-            continue;
+            return;
         }
 
-        json_stream << "    {\n";
-        json_stream << "      \"Event Num\": "               << std::to_string(event_num) << ",\n";
-        json_stream << "      \"Inning\": "                  << std::to_string(event.inning) << ",\n";
-        json_stream << "      \"Half Inning\": "             << std::to_string(event.half_inning) << ",\n";
-        json_stream << "      \"Away Score\": "              << std::dec << event.away_score << ",\n";
-        json_stream << "      \"Home Score\": "              << std::dec << event.home_score << ",\n";
-        json_stream << "      \"Balls\": "                   << std::to_string(event.balls) << ",\n";
-        json_stream << "      \"Strikes\": "                 << std::to_string(event.strikes) << ",\n";
-        json_stream << "      \"Outs\": "                    << std::to_string(event.outs) << ",\n";
-        json_stream << "      \"Star Chance\": "             << std::to_string(event.is_star_chance) << ",\n";
-        json_stream << "      \"Away Stars\": "              << std::to_string(event.away_stars) << ",\n";
-        json_stream << "      \"Home Stars\": "              << std::to_string(event.home_stars) << ",\n";
-        json_stream << "      \"Pitcher Stamina\": "         << std::to_string(event.pitcher_stamina) << ",\n";
-        json_stream << "      \"Chemistry Links on Base\": " << std::to_string(event.chem_links_ob) << ",\n";
-        json_stream << "      \"Pitcher Roster Loc\": "      << std::to_string(event.pitcher_roster_loc) << ",\n";
-        json_stream << "      \"Batter Roster Loc\": "       << std::to_string(event.batter_roster_loc) << ",\n";
-        json_stream << "      \"Catcher Roster Loc\": "       << std::to_string(event.catcher_roster_loc) << ",\n";
-        json_stream << "      \"RBI\": "                     << std::to_string(event.rbi) << ",\n";
-        json_stream << "      \"" << event.num_outs_during_play.name << "\": " << event.num_outs_during_play.get_key_value_string().second << ",\n";
-        json_stream << "      \"Result of AB\": "            << decode("AtBatResult", event.result_of_atbat, inDecode) << ",\n";
-
-        //=== Runners ===
-        //Build vector of <Runner*, Label/Name>
-        std::vector<std::pair<Runner*, std::string>> runners;
-        if (event.runner_batter) {
-            runners.push_back({&event.runner_batter.value(), "Batter"});
-        }
-        if (event.runner_1) {
-            runners.push_back({&event.runner_1.value(), "1B"});
-        }
-        if (event.runner_2) {
-            runners.push_back({&event.runner_2.value(), "2B"});
-        }
-        if (event.runner_3) {
-            runners.push_back({&event.runner_3.value(), "3B"});
+        if (!first_event) {
+            json.raw(",\n");
         }
+        writeEventJSON(json, event_num, event);
+        first_event = false;
+    });
+    if (!first_event) {
+        json.raw("\n");
+    }
 
-        for (auto runner = runners.begin(); runner != runners.end(); runner++){
-            Runner* runner_info = runner->first;
-            std::string& label = runner->second;
-
-            json_stream << "      \"Runner " << label << "\": {\n";
-            json_stream << "        \"Runner Roster Loc\": "   << std::to_string(runner_info->roster_loc) << ",\n";
-            json_stream << "        \"Runner Char Id\": "      << decode("Character", runner_info->char_id, inDecode) << ",\n";
-            json_stream << "        \"Runner Initial Base\": " << std::to_string(runner_info->initial_base) << ",\n";
-            json_stream << "        \"Out Type\": "            << decode("Out", runner_info->out_type, inDecode) << ",\n";
-            json_stream << "        \"Out Location\": "        << std::to_string(runner_info->out_location) << ",\n";
-            //json_stream << "        \"Runner Basepath Location\": "  << std::to_string(runner_info->basepath_location) << ",\n";
-            json_stream << "        \"Steal\": "               << decode("Steal", runner_info->steal, inDecode) << ",\n";
-            json_stream << "        \"Runner Result Base\": "  << std::to_string(runner_info->result_base) << "\n";
-            std::string comma = (std::next(runner) == runners.end() && !event.pitch.has_value()) ? "" : ",";
-            json_stream << "      }" << comma << "\n";
-        }
+    json.raw("  ]\n");
+    json.raw("}\n");
+}
+
+std::string StatTracker::getEventJSON(u16 in_event_num, Event& in_event, bool inDecode){
+    m_json_writer.reset();
+    const size_t target = m_json_writer.addTarget(inDecode);
+    writeEventJSON(m_json_writer, in_event_num, in_event);
+    return m_json_writer.str(target);
+}
 
+void StatTracker::writeEventJSON(StatJsonWriter& json, u16 in_event_num, Event& in_event){
+    json.raw("    {\n");
+    json.format("      \"Event Num\": {},\n", in_event_num);
+    json.format("      \"Inning\": {},\n", in_event.inning);
+    json.format("      \"Half Inning\": {},\n", in_event.half_inning);
+    json.format("      \"Away Score\": {},\n", in_event.away_score);
+    json.format("      \"Home Score\": {},\n", in_event.home_score);
+    json.format("      \"Balls\": {},\n", in_event.balls);
+    json.format("      \"Strikes\": {},\n", in_event.strikes);
+    json.format("      \"Outs\": {},\n", in_event.outs);
+    json.format("      \"Star Chance\": {},\n", in_event.is_star_chance);
+    json.format("      \"Away Stars\": {},\n", in_event.away_stars);
+    json.format("      \"Home Stars\": {},\n", in_event.home_stars);
+    json.format("      \"Pitcher Stamina\": {},\n", in_event.pitcher_stamina);
+    json.format("      \"Chemistry Links on Base\": {},\n", in_event.chem_links_ob);
+    json.format("      \"Pitcher Roster Loc\": {},\n", in_event.pitcher_roster_loc);
+    json.format("      \"Batter Roster Loc\": {},\n", in_event.batter_roster_loc);
+    json.format("      \"Catcher Roster Loc\": {},\n", in_event.catcher_roster_loc);
+    json.format("      \"RBI\": {},\n", in_event.rbi);
+    json.format("      \"{}\": {},\n", in_event.num_outs_during_play.name(), in_event.num_outs_during_play.get_value());
+    json.decoded("      \"Result of AB\": ", DecodeType::AtBatResult, in_event.result_of_atbat, ",\n");
 
-        //=== Pitch ===
-        if (event.pitch.has_value()){
-            Pitch* pitch = &event.pitch.value();
-            json_stream << "      \"Pitch\": {\n";
-            json_stream << "        \"Pitcher Team Id\": "    << std::to_string(pitch->pitcher_team_id) << ",\n";
-            json_stream << "        \"Pitcher Char Id\": "    << decode("Character", pitch->pitcher_char_id, inDecode) << ",\n";
-            json_stream << "        \"Pitch Type\": "         << decode("Pitch", pitch->pitch_type, inDecode) << ",\n";
-            json_stream << "        \"Charge Type\": "        << decode("ChargePitch", pitch->charge_type, inDecode) << ",\n";
-            json_stream << "        \"Star Pitch\": "         << std::to_string(pitch->star_pitch) << ",\n";
-            json_stream << "        \"Pitch Speed\": "        << std::to_string(pitch->pitch_speed) << ",\n";
-            json_stream << "        \"Ball Position - Strikezone\": "   << floatConverter(pitch->ball_z_strike_vs_ball) << ",\n";
-            json_stream << "        \"In Strikezone\": "      << std::to_string(pitch->ball_in_strikezone) << ",\n";
-            json_stream << "        \"" << pitch->bat_contact_x_pos.name << "\": " << floatConverter(pitch->bat_contact_x_pos.get_value()) << ",\n";
-            json_stream << "        \"" << pitch->bat_contact_z_pos.name << "\": " << floatConverter(pitch->bat_contact_z_pos.get_value()) << ",\n";
-            json_stream << "        \"DB\": "                 << std::to_string(pitch->db) << ",\n";
-            json_stream << "        \"Type of Swing\": "      << decode("Swing", pitch->type_of_swing, inDecode);
+    //=== Runners ===
+    //<Runner*, Label/Name>
+    std::array<std::pair<Runner*, const char*>, 4> runners;
+    size_t num_runners = 0;
+    if (in_event.runner_batter) {
+        runners[num_runners++] = {&in_event.runner_batter.value(), "Batter"};
+    }
+    if (in_event.runner_1) {
+        runners[num_runners++] = {&in_event.runner_1.value(), "1B"};
+    }
+    if (in_event.runner_2) {
+        runners[num_runners++] = {&in_event.runner_2.value(), "2B"};
+    }
+    if (in_event.runner_3) {
+        runners[num_runners++] = {&in_event.runner_3.value(), "3B"};
+    }
+
+    for (size_t runner = 0; runner < num_runners; ++runner){
+        Runner* runner_info = runners[runner].first;
+
+        json.format("      \"Runner {}\": {{\n", runners[runner].second);
+        json.format("        \"Runner Roster Loc\": {},\n", runner_info->roster_loc);
+        json.decoded("        \"Runner Char Id\": ", DecodeType::Character, runner_info->char_id, ",\n");
+        json.format("        \"Runner Initial Base\": {},\n", runner_info->initial_base);
+        json.decoded("        \"Out Type\": ", DecodeType::Out, runner_info->out_type, ",\n");
+        json.format("        \"Out Location\": {},\n", runner_info->out_location);
+        //json.format("        \"Runner Basepath Location\": {},\n", runner_info->basepath_location);
+        json.decoded("        \"Steal\": ", DecodeType::Steal, runner_info->steal, ",\n");
+        json.format("        \"Runner Result Base\": {}\n", runner_info->result_base);
+        json.raw((runner + 1 == num_runners && !in_event.pitch.has_value()) ? "      }\n" : "      },\n");
+    }
+
+
+    //=== Pitch ===
+    if (in_event.pitch.has_value()){
+        Pitch* pitch = &in_event.pitch.value();
+        json.raw("      \"Pitch\": {\n");
+        json.format("        \"Pitcher Team Id\": {},\n", pitch->pitcher_team_id);
+        json.decoded("        \"Pitcher Char Id\": ", DecodeType::Character, pitch->pitcher_char_id, ",\n");
+        json.decoded("        \"Pitch Type\": ", DecodeType::Pitch, pitch->pitch_type, ",\n");
+        json.decoded("        \"Charge Type\": ", DecodeType::ChargePitch, pitch->charge_type, ",\n");
+        json.format("        \"Star Pitch\": {},\n", pitch->star_pitch);
+        json.format("        \"Pitch Speed\": {},\n", pitch->pitch_speed);
+        json.format("        \"Ball Position - Strikezone\": {:g},\n", floatConverter(pitch->ball_z_strike_vs_ball));
+        json.format("        \"In Strikezone\": {},\n", pitch->ball_in_strikezone);
+        json.format("        \"{}\": {:g},\n", pitch->bat_contact_x_pos.name(), floatConverter(pitch->bat_contact_x_pos.get_value()));
+        json.format("        \"{}\": {:g},\n", pitch->bat_contact_z_pos.name(), floatConverter(pitch->bat_contact_z_pos.get_value()));
+        json.format("        \"DB\": {},\n", pitch->db);
+        json.decoded("        \"Type of Swing\": ", DecodeType::Swing, pitch->type_of_swing, "");
+        
+        //=== Contact ===
+        if (pitch->contact.has_value() && pitch->contact->type_of_contact.get_value() != 0xFF){
+            json.raw(",\n");
+
+            Contact* contact = &pitch->contact.value();
+            json.raw("        \"Contact\": {\n");
+            json.format("          \"{}\":", contact->type_of_contact.name());
+            json.decoded("", DecodeType::Contact, contact->type_of_contact.get_value(), ",\n");
+            json.format("          \"{}\": {:g},\n", contact->charge_power_up.name(), floatConverter(contact->charge_power_up.get_value()));
+            json.format("          \"{}\": {:g},\n", contact->charge_power_down.name(), floatConverter(contact->charge_power_down.get_value()));
+            json.format("          \"{}\": {},\n", contact->moon_shot.name(), contact->moon_shot.get_value());
+            json.format("          \"{}\": ", contact->input_direction_push_pull.name());
+            json.decoded("", DecodeType::Stick, contact->input_direction_push_pull.get_value(), ",\n");
+            json.format("          \"{}\": ", contact->input_direction_stick.name());
+            json.decoded("", DecodeType::StickVec, contact->input_direction_stick.get_value(), ",\n");
+            json.format("          \"{}\": \"{}\",\n", contact->frame_of_swing.name(), contact->frame_of_swing.get_value());
+
+            json.format("          \"{}\": \"{}\",\n", contact->power.name(), contact->power.get_value());
+            json.format("          \"{}\": \"{}\",\n", contact->vert_angle.name(), contact->vert_angle.get_value());
+            json.format("          \"{}\": \"{}\",\n", contact->horiz_angle.name(), contact->horiz_angle.get_value());
+
+            json.format("          \"{}\": {:g},\n", contact->contact_absolute.name(), floatConverter(contact->contact_absolute.get_value()));
+            json.format("          \"{}\": {:g},\n", contact->contact_quality.name(), floatConverter(contact->contact_quality.get_value()));
             
-            //=== Contact ===
-            if (pitch->contact.has_value() && pitch->contact->type_of_contact.get_value() != 0xFF){
-                json_stream << ",\n";
-
-                Contact* contact = &pitch->contact.value();
-                json_stream << "        \"Contact\": {\n";
-                json_stream << "          \"" << contact->type_of_contact.name << "\":" << decode("Contact", contact->type_of_contact.get_value(), inDecode) << ",\n";
-                json_stream << "          \"" << contact->charge_power_up.name << "\": " << floatConverter(contact->charge_power_up.get_value()) << ",\n";
-                json_stream << "          \"" << contact->charge_power_down.name << "\": " << floatConverter(contact->charge_power_down.get_value()) << ",\n";
-                json_stream << "          \"" << contact->moon_shot.name << "\": " << contact->moon_shot.get_key_value_string().second << ",\n"; 
-                json_stream << "          \"" << contact->input_direction_push_pull.name << "\": " << decode("Stick", contact->input_direction_push_pull.get_value(), inDecode) << ",\n";
-                json_stream << "          \"" << contact->input_direction_stick.name << "\": " << decode("StickVec", contact->input_direction_stick.get_value(), inDecode) << ",\n";
-                json_stream << "          \"" << contact->frame_of_swing.name << "\": \"" << std::dec << contact->frame_of_swing.get_value() << "\",\n";
-
-                json_stream << "          \"" << contact->power.name << "\": \"" << std::dec << contact->power.get_value() <<"\",\n";
-                json_stream << "          \"" << contact->vert_angle.name << "\": \"" << std::dec << contact->vert_angle.get_value() << "\",\n";
-                json_stream << "          \"" << contact->horiz_angle.name << "\": \"" << std::dec << contact->horiz_angle.get_value() << "\",\n";
-
-                json_stream << "          \"" << contact->contact_absolute.name << "\": " << floatConverter(contact->contact_absolute.get_value()) << ",\n";
-                json_stream << "          \"" << contact->contact_quality.name << "\": " << floatConverter(contact->contact_quality.get_value()) << ",\n";
+            json.format("          \"{}\": \"{}\",\n", contact->rng1.name(), contact->rng1.get_value());
+            json.format("          \"{}\": \"{}\",\n", contact->rng2.name(), contact->rng2.get_value());
+            json.format("          \"{}\": \"{}\",\n", contact->rng3.name(), contact->rng3.get_value());
+
+            json.format("          \"{}\": {:g},\n", contact->ball_x_velo.name(), floatConverter(contact->ball_x_velo.get_value()));
+            json.format("          \"{}\": {:g},\n", contact->ball_y_velo.name(), floatConverter(contact->ball_y_velo.get_value()));
+            json.format("          \"{}\": {:g},\n", contact->ball_z_velo.name(), floatConverter(contact->ball_z_velo.get_value()));
+
+            json.format("          \"{}\": {:g},\n", contact->ball_contact_x_pos.name(), floatConverter(contact->ball_contact_x_pos.get_value()));
+            json.format("          \"{}\": {:g},\n", contact->ball_contact_z_pos.name(), floatConverter(contact->ball_contact_z_pos.get_value()));
+                            
+            json.format("          \"{}\": {:g},\n", contact->ball_x_pos.name(), floatConverter(contact->ball_x_pos.get_value()));
+            json.format("          \"{}\": {:g},\n", contact->ball_y_pos.name(), floatConverter(contact->ball_y_pos.get_value()));
+            json.format("          \"{}\": {:g},\n", contact->ball_z_pos.name(), floatConverter(contact->ball_z_pos.get_value()));
+
+            json.format("          \"{}\": {:g},\n", contact->ball_max_height.name(), floatConverter(contact->ball_max_height.get_value()));
+            json.format("          \"{}\": \"{}\",\n", contact->ball_hang_time.name(), contact->ball_hang_time.get_value());
+            json.decoded("          \"Contact Result - Primary\": ", DecodeType::PrimaryContactResult, contact->primary_contact_result, ",\n");
+            json.decoded("          \"Contact Result - Secondary\": ", DecodeType::SecondaryContactResult, contact->secondary_contact_result, "");
+
+            //=== Fielder ===
+            //TODO could be reworked
+            if (contact->first_fielder.has_value() || contact->collect_fielder.has_value()){
+                json.raw(",\n");
+
+                //First fielder to touch the ball
+                Fielder* fielder;
+
+                //If the fielder bobbled but the same fielder collected the ball OR there was no bobble, log single fielder
                 
-                json_stream << "          \"" << contact->rng1.name << "\": \"" << std::dec << contact->rng1.get_value() << "\",\n";
-                json_stream << "          \"" << contact->rng2.name << "\": \"" << std::dec << contact->rng2.get_value() << "\",\n";
-                json_stream << "          \"" << contact->rng3.name << "\": \"" << std::dec << contact->rng3.get_value() << "\",\n";
-
-                json_stream << "          \"" << contact->ball_x_velo.name << "\": " << floatConverter(contact->ball_x_velo.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_y_velo.name << "\": " << floatConverter(contact->ball_y_velo.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_z_velo.name << "\": " << floatConverter(contact->ball_z_velo.get_value()) << ",\n";
-
-                json_stream << "          \"" << contact->ball_contact_x_pos.name << "\": " << floatConverter(contact->ball_contact_x_pos.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_contact_z_pos.name << "\": " << floatConverter(contact->ball_contact_z_pos.get_value()) << ",\n";
-                                
-                json_stream << "          \"" << contact->ball_x_pos.name << "\": " << floatConverter(contact->ball_x_pos.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_y_pos.name << "\": " << floatConverter(contact->ball_y_pos.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_z_pos.name << "\": " << floatConverter(contact->ball_z_pos.get_value()) << ",\n";
-
-                json_stream << "          \"" << contact->ball_max_height.name << "\": " << floatConverter(contact->ball_max_height.get_value()) << ",\n";
-                json_stream << "          \"" << contact->ball_hang_time.name << "\": \"" << std::dec << contact->ball_hang_time.get_value() << "\",\n";
-                json_stream << "          \"Contact Result - Primary\": "         << decode("PrimaryContactResult", contact->primary_contact_result, inDecode) << ",\n";
-                json_stream << "          \"Contact Result - Secondary\": "       << decode("SecondaryContactResult", contact->secondary_contact_result, inDecode);
-
-                //=== Fielder ===
-                //TODO could be reworked
-                if (contact->first_fielder.has_value() || contact->collect_fielder.has_value()){
-                    json_stream << ",\n";
-
-                    //First fielder to touch the ball
-                    Fielder* fielder;
-
-                    //If the fielder bobbled but the same fielder collected the ball OR there was no bobble, log single fielder
-                    
-                    if (contact->first_fielder.has_value()) { fielder = &contact->first_fielder.value(); }
-                    else {fielder = &contact->collect_fielder.value();}
-
-                    json_stream << "          \"First Fielder\": {\n";
-                    json_stream << "            \"Fielder Roster Location\": " << std::to_string(fielder->fielder_roster_loc) << ",\n";
-                    json_stream << "            \"Fielder Position\": "        << decode("Position", fielder->fielder_pos, inDecode) << ",\n";
-                    json_stream << "            \"Fielder Character\": "       << decode("Character", fielder->fielder_char_id, inDecode) << ",\n";
-                    json_stream << "            \"Fielder Action\": "          << decode("Action", fielder->fielder_action, inDecode) << ",\n";
-                    json_stream << "            \"Fielder Jump\": "            << std::to_string(fielder->fielder_jump) << ",\n";
-                    json_stream << "            \"Fielder Swap\": "            << std::to_string(fielder->fielder_swapped_for_batter) << ",\n";
-                    json_stream << "            \"Fielder Manual Selected\": " << decode("ManualSelect", fielder->fielder_manual_select_arg, inDecode) << ",\n";
-                    json_stream << "            \"Fielder Position - X\": "    << floatConverter(fielder->fielder_x_pos) << ",\n";
-                    json_stream << "            \"Fielder Position - Y\": "    << floatConverter(fielder->fielder_y_pos) << ",\n";
-                    json_stream << "            \"Fielder Position - Z\": "    << floatConverter(fielder->fielder_z_pos) << ",\n";
-                    json_stream << "            \"Fielder Bobble\": "          << decode("Bobble", fielder->bobble, inDecode) << "\n";
-                    json_stream << "          }\n";
-                    /*
-                    else if (contact->first_fielder.has_value() 
-                            && (contact->first_fielder->fielder_roster_loc != contact->collect_fielder->fielder_roster_loc)) {
-                        
-                        Fielder* first_fielder  = &contact->first_fielder.value();
-                        Fielder* second_fielder = &contact->collect_fielder.value();
-
-                        json_stream << "          \"First Fielder\": {\n";
-                        json_stream << "            \"Fielder Roster Location\": " << std::to_string(first_fielder->fielder_roster_loc) << ",\n";
-                        json_stream << "            \"Fielder Position\": "        << std::to_string(first_fielder->fielder_pos) << ",\n";
-                        json_stream << "            \"Fielder Character\": "       << std::to_string(first_fielder->fielder_char_id) << ",\n";
-                        json_stream << "            \"Fielder Action\": "          << std::to_string(first_fielder->fielder_action) << ",\n";
-                        json_stream << "            \"Fielder Swap\": "            << std::to_string(first_fielder->fielder_swapped_for_batter) << ",\n";
-                        json_stream << "            \"Fielder Position - X\": "    << floatConverter(first_fielder->fielder_x_pos) << ",\n";
-                        json_stream << "            \"Fielder Position - Y\": "    << floatConverter(first_fielder->fielder_y_pos) << ",\n";
-                        json_stream << "            \"Fielder Position - Z\": "    << floatConverter(first_fielder->fielder_z_pos) << ",\n";
-                        json_stream << "            \"Fielder Bobble\": "          << std::to_string(first_fielder->bobble) << "\n";
-                        json_stream << "          },\n";
-                        json_stream << "          \"Second Fielder\": {\n";
-                        json_stream << "            \"Fielder Roster Location\": " << std::to_string(second_fielder->fielder_roster_loc) << ",\n";
-                        json_stream << "            \"Fielder Position\": "        << std::to_string(second_fielder->fielder_pos) << ",\n";
-                        json_stream << "            \"Fielder Character\": "       << std::to_string(second_fielder->fielder_char_id) << ",\n";
-                        json_stream << "            \"Fielder Action\": "          << std::to_string(second_fielder->fielder_action) << ",\n";
-                        json_stream << "            \"Fielder Swap\": "            << std::to_string(second_fielder->fielder_swapped_for_batter) << ",\n";
-                        json_stream << "            \"Fielder Position - X\": "    << floatConverter(second_fielder->fielder_x_pos) << ",\n";
-                        json_stream << "            \"Fielder Position - Y\": "    << floatConverter(second_fielder->fielder_y_pos) << ",\n";
-                        json_stream << "            \"Fielder Position - Z\": "    << floatConverter(second_fielder->fielder_z_pos) << ",\n";
-                        json_stream << "            \"Fielder Bobble\": "          << std::to_string(second_fielder->bobble) << "\n";
-                        json_stream << "          }\n";
-                    }
-                    */
-                }
-                else{ //Finish contact section
-                    json_stream << "\n";
-                }
-                json_stream << "        }\n";
+                if (contact->first_fielder.has_value()) { fielder = &contact->first_fielder.value(); }
+                else {fielder = &contact->collect_fielder.value();}
+
+                json.raw("          \"First Fielder\": {\n");
+                json.format("            \"Fielder Roster Location\": {},\n", fielder->fielder_roster_loc);
+                json.decoded("            \"Fielder Position\": ", DecodeType::Position, fielder->fielder_pos, ",\n");
+                json.decoded("            \"Fielder Character\": ", DecodeType::Character, fielder->fielder_char_id, ",\n");
+                json.decoded("            \"Fielder Action\": ", DecodeType::Action, fielder->fielder_action, ",\n");
+                json.format("            \"Fielder Jump\": {},\n", fielder->fielder_jump);
+                json.format("            \"Fielder Swap\": {},\n", fielder->fielder_swapped_for_batter);
+                json.decoded("            \"Fielder Manual Selected\": ", DecodeType::ManualSelect, fielder->fielder_manual_select_arg, ",\n");
+                json.format("            \"Fielder Position - X\": {:g},\n", floatConverter(fielder->fielder_x_pos));
+                json.format("            \"Fielder Position - Y\": {:g},\n", floatConverter(fielder->fielder_y_pos));
+                json.format("            \"Fielder Position - Z\": {:g},\n", floatConverter(fielder->fielder_z_pos));
+                json.decoded("            \"Fielder Bobble\": ", DecodeType::Bobble, fielder->bobble, "\n");
+                json.raw("          }\n");
             }
-            else { //Finish pitch section
-                json_stream << "\n";
+            else{ //Finish contact section
+                json.raw("\n");
             }
-            json_stream << "      }\n";
+            json.raw("        }\n");
         }
-
-        std::string end_comma = (std::next(event_map_iter) !=  m_game_info.events.end()) ? "," : "";
-        json_stream << "    }" << end_comma << "\n";
+        else { //Finish pitch section
+            json.raw("\n");
+        }
+        json.raw("      }\n");
     }
 
-    json_stream << "  ]\n";
-    json_stream << "}\n";
+    json.raw("    }");
+}
 
-    return json_stream.str();
+void StatTracker::journalCurrentEvent(){
+    if (!m_game_info.currentEventVld()){
+        return;
+    }
+
+    Event& event = m_game_info.getCurrentEvent();
+    //Same rule as the stat file, an event that never got going is not logged
+    if (event.inning != 0){
+        m_json_writer.reset();
+        const size_t decoded_json = m_json_writer.addTarget(true);
+        const size_t raw_json = m_json_writer.addTarget(false);
+        writeEventJSON(m_json_writer, m_game_info.event_num, event);
+        m_event_journal.append(m_json_writer.str(decoded_json), m_json_writer.str(raw_json));
+
+        StatArchiveEvent row;
+        row.event_num = static_cast<u16>(m_game_info.event_num);
+        row.inning = event.inning;
+        row.half_inning = event.half_inning;
+        if (event.half_inning < cNumOfTeams){
+            if (event.batter_roster_loc < cRosterSize)
+                row.batter_char = m_game_info.character_summaries[event.half_inning][event.batter_roster_loc].char_id;
+            if (event.pitcher_roster_loc < cRosterSize)
+                row.pitcher_char = m_game_info.character_summaries[!event.half_inning][event.pitcher_roster_loc].char_id;
+        }
+        row.result_of_atbat = event.result_of_atbat;
+        row.rbi = event.rbi;
+        if (event.pitch.has_value()){
+            row.pitch_result = event.pitch->pitch_result;
+            if (event.pitch->contact.has_value())
+                row.contact_type = event.pitch->contact->type_of_contact.get_value();
+        }
+        m_archive_events.push_back(row);
+    }
+    m_game_info.events.erase(m_game_info.event_num);
 }
 
-std::string StatTracker::getHUDJSON(std::string in_event_num, Event& in_curr_event, std::optional<Event> in_prev_event, bool inDecode){
-    std::stringstream json_stream;
+void StatTracker::archiveGame(){
+    //Replayed games (traces and movies) were archived when they were played
+    if (m_replaying_trace || Core::System::GetInstance().GetMovie().IsPlayingInput()){
+        m_archive_events = {};
+        return;
+    }
+
+    StatArchiveGame game;
+    game.game_id = m_game_info.game_id;
+    TryParse(m_game_info.start_unix_date_time, &game.start_time);
+    game.tag_set_id = m_game_info.tag_set_id.value_or(-1);
+    game.stadium = m_game_info.stadium;
+    game.netplay = m_game_info.netplay;
+    game.innings_played = m_game_info.innings_played;
+    game.quitter_team = m_game_info.quitter_team;
+    game.away_score = m_game_info.away_score;
+    game.home_score = m_game_info.home_score;
+
+    std::vector<StatArchiveCharacter> characters;
+    characters.reserve(cNumOfTeams * cRosterSize);
+    for (int team=0; team < cNumOfTeams; ++team){
+        //Same as the stat file, team 0 is away
+        const u8 team_port = (team == 0) ? m_game_info.away_port : m_game_info.home_port;
+        const u8 captain_roster_loc = (team_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
 
-    if (in_curr_event.inning == 0) {
-        return "{}";
+        for (int roster=0; roster < cRosterSize; ++roster){
+            const CharacterSummary& char_summary = m_game_info.character_summaries[team][roster];
+            const EndGameRosterOffensiveStats& offense = char_summary.end_game_offensive_stats;
+            const EndGameRosterDefensiveStats& defense = char_summary.end_game_defensive_stats;
+
+            StatArchiveCharacter row;
+            row.team = static_cast<u8>(team);
+            row.roster = static_cast<u8>(roster);
+            row.char_id = char_summary.char_id;
+            row.is_starred = char_summary.is_starred;
+            row.captain = (roster == captain_roster_loc);
+            row.at_bats = offense.at_bats;
+            row.hits = offense.hits;
+            row.singles = offense.singles;
+            row.doubles = offense.doubles;
+            row.triples = offense.triples;
+            row.homeruns = offense.homeruns;
+            row.strikeouts = offense.strikouts;
+            row.walks = offense.walks_4balls + offense.walks_hit;
+            row.rbi = offense.rbi;
+            row.bases_stolen = offense.bases_stolen;
+            row.batters_faced = defense.batters_faced;
+            row.outs_pitched = defense.outs_pitched;
+            row.strikeouts_pitched = defense.strike_outs;
+            row.runs_allowed = defense.runs_allowed;
+            row.hits_allowed = defense.hits_allowed;
+            row.pitches_thrown = defense.pitches_thrown;
+            characters.push_back(row);
+        }
     }
 
-    json_stream << "{\n";
+    m_archive_writer.append(game, std::move(characters), std::move(m_archive_events));
+    m_archive_events = {};
+}
 
-    json_stream << "  \"Event Num\": \""             << in_event_num << "\",\n";
-    json_stream << "  \"Away Player\": \""           << m_game_info.getAwayTeamPlayer().GetUsername() << "\",\n";
-    json_stream << "  \"Home Player\": \""           << m_game_info.getHomeTeamPlayer().GetUsername() << "\",\n";
-    json_stream << "  \"Inning\": "                  << std::to_string(in_curr_event.inning) << ",\n";
-    json_stream << "  \"Half Inning\": "             << std::to_string(in_curr_event.half_inning) << ",\n";
-    json_stream << "  \"Away Score\": "              << std::dec << in_curr_event.away_score << ",\n";
-    json_stream << "  \"Home Score\": "              << std::dec << in_curr_event.home_score << ",\n";
-    json_stream << "  \"Balls\": "                   << std::to_string(in_curr_event.balls) << ",\n";
-    json_stream << "  \"Strikes\": "                 << std::to_string(in_curr_event.strikes) << ",\n";
-    json_stream << "  \"Outs\": "                    << std::to_string(in_curr_event.outs) << ",\n";
-    json_stream << "  \"Star Chance\": "             << std::to_string(in_curr_event.is_star_chance) << ",\n";
-    json_stream << "  \"Away Stars\": "              << std::to_string(in_curr_event.away_stars) << ",\n";
-    json_stream << "  \"Home Stars\": "              << std::to_string(in_curr_event.home_stars) << ",\n";
-    json_stream << "  \"Pitcher Stamina\": "         << std::to_string(in_curr_event.pitcher_stamina) << ",\n";
-    json_stream << "  \"Chemistry Links on Base\": " << std::to_string(in_curr_event.chem_links_ob) << ",\n";
-    json_stream << "  \"" << in_curr_event.num_outs_during_play.name << "\": " << in_curr_event.num_outs_during_play.get_key_value_string().second << ",\n";
-    json_stream << "  \"Pitcher Roster Loc\": "      << std::to_string(in_curr_event.pitcher_roster_loc) << ",\n";
-    json_stream << "  \"Batter Roster Loc\": "       << std::to_string(in_curr_event.batter_roster_loc) << ",\n";
+std::string StatTracker::getHUDJSON(std::string in_event_num, Event& in_curr_event, std::optional<Event>& in_prev_event, bool inDecode){
+    m_json_writer.reset();
+    const size_t target = m_json_writer.addTarget(inDecode);
+    writeHUDJSON(m_json_writer, in_event_num, in_curr_event, in_prev_event);
+    return m_json_writer.str(target);
+}
+
+void StatTracker::writeHUDJSON(StatJsonWriter& json, std::string_view in_event_num, Event& in_curr_event, std::optional<Event>& in_prev_event){
+    if (in_curr_event.inning == 0) {
+        json.raw("{}");
+        return;
+    }
+
+    json.raw("{\n");
+
+    json.format("  \"Event Num\": \"{}\",\n", in_event_num);
+    json.format("  \"Away Player\": \"{}\",\n", m_game_info.getAwayTeamPlayer().GetUsername());
+    json.format("  \"Home Player\": \"{}\",\n", m_game_info.getHomeTeamPlayer().GetUsername());
+    json.format("  \"Inning\": {},\n", in_curr_event.inning);
+    json.format("  \"Half Inning\": {},\n", in_curr_event.half_inning);
+    json.format("  \"Away Score\": {},\n", in_curr_event.away_score);
+    json.format("  \"Home Score\": {},\n", in_curr_event.home_score);
+    json.format("  \"Balls\": {},\n", in_curr_event.balls);
+    json.format("  \"Strikes\": {},\n", in_curr_event.strikes);
+    json.format("  \"Outs\": {},\n", in_curr_event.outs);
+    json.format("  \"Star Chance\": {},\n", in_curr_event.is_star_chance);
+    json.format("  \"Away Stars\": {},\n", in_curr_event.away_stars);
+    json.format("  \"Home Stars\": {},\n", in_curr_event.home_stars);
+    json.format("  \"Pitcher Stamina\": {},\n", in_curr_event.pitcher_stamina);
+    json.format("  \"Chemistry Links on Base\": {},\n", in_curr_event.chem_links_ob);
+    json.format("  \"{}\": {},\n", in_curr_event.num_outs_during_play.name(), in_curr_event.num_outs_during_play.get_value());
+    json.format("  \"Pitcher Roster Loc\": {},\n", in_curr_event.pitcher_roster_loc);
+    json.format("  \"Batter Roster Loc\": {},\n", in_curr_event.batter_roster_loc);
 
     for (int team=0; team < 2; ++team){
         for (int roster=0; roster < cRosterSize; ++roster){
@@ -1308,198 +1592,199 @@ std::string StatTracker::getHUDJSON(std::string in_event_num, Event& in_curr_eve
                 captain_roster_loc = (m_game_info.away_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
             }
 
-            std::string team_string = (team == 0) ? "Away" : "Home";
+            const char* team_string = (team == 0) ? "Away" : "Home";
 
             CharacterSummary& char_summary = m_game_info.character_summaries[team][roster];
-            std::string label = "\"" + team_string + " Roster " + std::to_string(roster) + "\": ";
-            json_stream << "  " << label << "{\n";
-            json_stream << "    \"Team\": \""        << std::to_string(team) << "\",\n";
-            json_stream << "    \"RosterID\": "      << std::to_string(roster) << ",\n";
-            json_stream << "    \"CharID\": "        << decode("Character", char_summary.char_id, inDecode) << ",\n";
-            json_stream << "    \"Superstar\": "     << std::to_string(char_summary.is_starred) << ",\n";
-            json_stream << "    \"Captain\": "       << std::to_string(roster == captain_roster_loc) << ",\n";
-            json_stream << "    \"Fielding Hand\": " << decode("Hand", char_summary.fielding_hand, inDecode) << ",\n";
-            json_stream << "    \"Batting Hand\": "  << decode("Hand", char_summary.batting_hand, inDecode) << ",\n";
+            json.format("  \"{} Roster {}\": {{\n", team_string, roster);
+            json.format("    \"Team\": \"{}\",\n", team);
+            json.format("    \"RosterID\": {},\n", roster);
+            json.decoded("    \"CharID\": ", DecodeType::Character, char_summary.char_id, ",\n");
+            json.format("    \"Superstar\": {},\n", char_summary.is_starred);
+            json.format("    \"Captain\": {},\n", static_cast<int>(roster == captain_roster_loc));
+            json.decoded("    \"Fielding Hand\": ", DecodeType::Hand, char_summary.fielding_hand, ",\n");
+            json.decoded("    \"Batting Hand\": ", DecodeType::Hand, char_summary.batting_hand, ",\n");
 
             //=== Defensive Stats ===
             EndGameRosterDefensiveStats& def_stat = char_summary.end_game_defensive_stats;
-            json_stream << "    \"Defensive Stats\": {\n";
-            json_stream << "      \"Batters Faced\": "       << std::to_string(def_stat.batters_faced) << ",\n";
-            json_stream << "      \"Runs Allowed\": "        << std::dec << def_stat.runs_allowed << ",\n";
-            json_stream << "      \"Earned Runs\": "        << std::dec << def_stat.earned_runs << ",\n";
-            json_stream << "      \"Batters Walked\": "      << def_stat.batters_walked << ",\n";
-            json_stream << "      \"Batters Hit\": "         << def_stat.batters_hit << ",\n";
-            json_stream << "      \"Hits Allowed\": "        << def_stat.hits_allowed << ",\n";
-            json_stream << "      \"HRs Allowed\": "         << def_stat.homeruns_allowed << ",\n";
-            json_stream << "      \"Pitches Thrown\": "      << def_stat.pitches_thrown << ",\n";
-            json_stream << "      \"Stamina\": "             << def_stat.stamina << ",\n";
-            json_stream << "      \"Was Pitcher\": "         << std::to_string(def_stat.was_pitcher) << ",\n";
-            json_stream << "      \"Strikeouts\": "          << std::to_string(def_stat.strike_outs) << ",\n";
-            json_stream << "      \"Star Pitches Thrown\": " << std::to_string(def_stat.star_pitches_thrown) << ",\n";
-            json_stream << "      \"Big Plays\": "           << std::to_string(def_stat.big_plays) << ",\n";
-            json_stream << "      \"Outs Pitched\": "        << std::to_string(def_stat.outs_pitched) << ",\n";
-            json_stream << "      \"Batters Per Position\": [\n";
-
+            json.raw("    \"Defensive Stats\": {\n");
+            json.format("      \"Batters Faced\": {},\n", def_stat.batters_faced);
+            json.format("      \"Runs Allowed\": {},\n", def_stat.runs_allowed);
+            json.format("      \"Earned Runs\": {},\n", def_stat.earned_runs);
+            json.format("      \"Batters Walked\": {},\n", def_stat.batters_walked);
+            json.format("      \"Batters Hit\": {},\n", def_stat.batters_hit);
+            json.format("      \"Hits Allowed\": {},\n", def_stat.hits_allowed);
+            json.format("      \"HRs Allowed\": {},\n", def_stat.homeruns_allowed);
+            json.format("      \"Pitches Thrown\": {},\n", def_stat.pitches_thrown);
+            json.format("      \"Stamina\": {},\n", def_stat.stamina);
+            json.format("      \"Was Pitcher\": {},\n", def_stat.was_pitcher);
+            json.format("      \"Strikeouts\": {},\n", def_stat.strike_outs);
+            json.format("      \"Star Pitches Thrown\": {},\n", def_stat.star_pitches_thrown);
+            json.format("      \"Big Plays\": {},\n", def_stat.big_plays);
+            json.format("      \"Outs Pitched\": {},\n", def_stat.outs_pitched);
+
+            FielderInfo& fielder_info = m_fielder_tracker[team].fielder_map[roster];
+            json.raw("      \"Batters Per Position\": [\n");
             if (m_fielder_tracker[team].battersAtAnyPosition(roster, 0)){
-                json_stream << "        {\n";
+                json.raw("        {\n");
                 for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].batter_count_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].battersAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].batter_count_by_position[pos]) << comma << "\n";
+                    if (fielder_info.batter_count_by_position[pos] > 0){
+                        const char* comma = (m_fielder_tracker[team].battersAtAnyPosition(roster, pos+1)) ? "," : "";
+                        json.format("            \"{}\": {}{}\n", decodeName(DecodeType::Position, pos), fielder_info.batter_count_by_position[pos], comma);
                     }
                 }
-                json_stream << "        }\n";
+                json.raw("        }\n");
             }
-            json_stream << "      ],\n";
+            json.raw("      ],\n");
 
-            json_stream << "      \"Batter Outs Per Position\": [\n";
+            json.raw("      \"Batter Outs Per Position\": [\n");
             if (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, 0)){
-                json_stream << "        {\n";
+                json.raw("        {\n");
                 for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].batter_outs_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].batter_outs_by_position[pos]) << comma << "\n";
+                    if (fielder_info.batter_outs_by_position[pos] > 0){
+                        const char* comma = (m_fielder_tracker[team].batterOutsAtAnyPosition(roster, pos+1)) ? "," : "";
+                        json.format("            \"{}\": {}{}\n", decodeName(DecodeType::Position, pos), fielder_info.batter_outs_by_position[pos], comma);
                     }
                 }
-                json_stream << "        }\n";
+                json.raw("        }\n");
             }
-            json_stream << "      ],\n";
+            json.raw("      ],\n");
 
-            json_stream << "      \"Outs Per Position\": [\n";
+            json.raw("      \"Outs Per Position\": [\n");
             if (m_fielder_tracker[team].outsAtAnyPosition(roster, 0)){
-                json_stream << "        {\n";
+                json.raw("        {\n");
                 for (int pos = 0; pos < cNumOfPositions; ++pos) {
-                    if (m_fielder_tracker[team].fielder_map[roster].out_count_by_position[pos] > 0){
-                        std::string comma = (m_fielder_tracker[team].outsAtAnyPosition(roster, pos+1)) ? "," : "";
-                        json_stream << "            \"" << cPosition.at(pos) << "\": " << std::to_string(m_fielder_tracker[team].fielder_map[roster].out_count_by_position[pos]) << comma << "\n";
+                    if (fielder_info.out_count_by_position[pos] > 0){
+                        const char* comma = (m_fielder_tracker[team].outsAtAnyPosition(roster, pos+1)) ? "," : "";
+                        json.format("            \"{}\": {}{}\n", decodeName(DecodeType::Position, pos), fielder_info.out_count_by_position[pos], comma);
                     }
                 }
-                json_stream << "        }\n";
+                json.raw("        }\n");
             }
-            json_stream << "      ]\n";
-            json_stream << "    },\n";
+            json.raw("      ]\n");
+            json.raw("    },\n");
 
             //=== Offensive Stats ===
             EndGameRosterOffensiveStats& of_stat = char_summary.end_game_offensive_stats;
-            json_stream << "    \"Offensive Stats\": {\n";
-            json_stream << "      \"At Bats\": "          << std::to_string(of_stat.at_bats) << ",\n";
-            json_stream << "      \"Hits\": "             << std::to_string(of_stat.hits) << ",\n";
-            json_stream << "      \"Singles\": "          << std::to_string(of_stat.singles) << ",\n";
-            json_stream << "      \"Doubles\": "          << std::to_string(of_stat.doubles) << ",\n";
-            json_stream << "      \"Triples\": "          << std::to_string(of_stat.triples) << ",\n";
-            json_stream << "      \"Homeruns\": "         << std::to_string(of_stat.homeruns) << ",\n";
-            json_stream << "      \"Successful Bunts\": " << std::to_string(of_stat.successful_bunts) << ",\n";
-            json_stream << "      \"Sac Flys\": "         << std::to_string(of_stat.sac_flys) << ",\n";
-            json_stream << "      \"Strikeouts\": "       << std::to_string(of_stat.strikouts) << ",\n";
-            json_stream << "      \"Walks (4 Balls)\": "  << std::to_string(of_stat.walks_4balls) << ",\n";
-            json_stream << "      \"Walks (Hit)\": "      << std::to_string(of_stat.walks_hit) << ",\n";
-            json_stream << "      \"RBI\": "              << std::to_string(of_stat.rbi) << ",\n";
-            json_stream << "      \"Bases Stolen\": "     << std::to_string(of_stat.bases_stolen) << ",\n";
-            json_stream << "      \"Star Hits\": "        << std::to_string(of_stat.star_hits) << "\n";
-            json_stream << "    }\n";
-            json_stream << "  },\n";
+            json.raw("    \"Offensive Stats\": {\n");
+            json.format("      \"At Bats\": {},\n", of_stat.at_bats);
+            json.format("      \"Hits\": {},\n", of_stat.hits);
+            json.format("      \"Singles\": {},\n", of_stat.singles);
+            json.format("      \"Doubles\": {},\n", of_stat.doubles);
+            json.format("      \"Triples\": {},\n", of_stat.triples);
+            json.format("      \"Homeruns\": {},\n", of_stat.homeruns);
+            json.format("      \"Successful Bunts\": {},\n", of_stat.successful_bunts);
+            json.format("      \"Sac Flys\": {},\n", of_stat.sac_flys);
+            json.format("      \"Strikeouts\": {},\n", of_stat.strikouts);
+            json.format("      \"Walks (4 Balls)\": {},\n", of_stat.walks_4balls);
+            json.format("      \"Walks (Hit)\": {},\n", of_stat.walks_hit);
+            json.format("      \"RBI\": {},\n", of_stat.rbi);
+            json.format("      \"Bases Stolen\": {},\n", of_stat.bases_stolen);
+            json.format("      \"Star Hits\": {}\n", of_stat.star_hits);
+            json.raw("    }\n");
+            json.raw("  },\n");
         }
     }
 
     //=== Runners ===
-    //Build vector of <Runner*, Label/Name>
-    std::vector<std::pair<Runner*, std::string>> runners;
+    //<Runner*, Label/Name>
+    std::array<std::pair<Runner*, const char*>, 4> runners;
+    size_t num_runners = 0;
     if (in_curr_event.runner_batter) {
-        runners.push_back({&in_curr_event.runner_batter.value(), "Batter"});
+        runners[num_runners++] = {&in_curr_event.runner_batter.value(), "Batter"};
     }
     if (in_curr_event.runner_1) {
-        runners.push_back({&in_curr_event.runner_1.value(), "1B"});
+        runners[num_runners++] = {&in_curr_event.runner_1.value(), "1B"};
     }
     if (in_curr_event.runner_2) {
-        runners.push_back({&in_curr_event.runner_2.value(), "2B"});
+        runners[num_runners++] = {&in_curr_event.runner_2.value(), "2B"};
     }
     if (in_curr_event.runner_3) {
-        runners.push_back({&in_curr_event.runner_3.value(), "3B"});
+        runners[num_runners++] = {&in_curr_event.runner_3.value(), "3B"};
     }
 
-    for (auto runner = runners.begin(); runner != runners.end(); runner++){
-        Runner* runner_info = runner->first;
-        std::string& label = runner->second;
+    for (size_t runner = 0; runner < num_runners; ++runner){
+        Runner* runner_info = runners[runner].first;
 
-        json_stream << "  \"Runner " << label << "\": {\n";
-        json_stream << "    \"Runner Roster Loc\": "   << std::to_string(runner_info->roster_loc) << ",\n";
-        json_stream << "    \"Runner Char Id\": "      << decode("Character", runner_info->char_id, inDecode) << ",\n";
-        json_stream << "    \"Runner Initial Base\": " << std::to_string(runner_info->initial_base) << ",\n";
-        json_stream << "    \"Out Type\": "            << decode("Out", runner_info->out_type, inDecode) << ",\n";
-        json_stream << "    \"Out Location\": "        << std::to_string(runner_info->out_location) << ",\n";
-        //json_stream << "    \"Runner Basepath Location\": "  << std::to_string(runner_info->basepath_location) << ",\n";
-        json_stream << "    \"Steal\": "               << decode("Steal", runner_info->steal, inDecode) << ",\n";
-        json_stream << "    \"Runner Result Base\": "  << std::to_string(runner_info->result_base) << "\n";
-        std::string comma = (std::next(runner) == runners.end() && !in_prev_event.has_value() ) ? "" : ",";
-        json_stream << "  }" << comma << "\n";
+        json.format("  \"Runner {}\": {{\n", runners[runner].second);
+        json.format("    \"Runner Roster Loc\": {},\n", runner_info->roster_loc);
+        json.decoded("    \"Runner Char Id\": ", DecodeType::Character, runner_info->char_id, ",\n");
+        json.format("    \"Runner Initial Base\": {},\n", runner_info->initial_base);
+        json.decoded("    \"Out Type\": ", DecodeType::Out, runner_info->out_type, ",\n");
+        json.format("    \"Out Location\": {},\n", runner_info->out_location);
+        //json.format("    \"Runner Basepath Location\": {},\n", runner_info->basepath_location);
+        json.decoded("    \"Steal\": ", DecodeType::Steal, runner_info->steal, ",\n");
+        json.format("    \"Runner Result Base\": {}\n", runner_info->result_base);
+        json.raw((runner + 1 == num_runners && !in_prev_event.has_value()) ? "  }\n" : "  },\n");
     }
 
     //Previous Event - return if first event of game. Else write the event
     if (!in_prev_event.has_value()){
-        json_stream << "}";
-        return json_stream.str();
+        json.raw("}");
+        return;
     }
 
     //=== Pitch ===
 
-    json_stream << "  \"Previous Event\": {\n";
-    json_stream << "    \"RBI\": "                     << std::to_string(in_prev_event->rbi) << ",\n";
-    std::string comma = (in_prev_event->pitch.has_value()) ? "," : "";
-    json_stream << "    \"Result of AB\": "            << decode("AtBatResult", in_prev_event->result_of_atbat, inDecode) << comma << "\n";
+    json.raw("  \"Previous Event\": {\n");
+    json.format("    \"RBI\": {},\n", in_prev_event->rbi);
+    json.decoded("    \"Result of AB\": ", DecodeType::AtBatResult, in_prev_event->result_of_atbat, (in_prev_event->pitch.has_value()) ? ",\n" : "\n");
     if (in_prev_event->pitch.has_value()){
         Pitch* pitch = &in_prev_event->pitch.value();
-        json_stream << "    \"Pitch\": {\n";
-        json_stream << "      \"Pitcher Team Id\": "    << std::to_string(pitch->pitcher_team_id) << ",\n";
-        json_stream << "      \"Pitcher Char Id\": "    << decode("Character", pitch->pitcher_char_id, inDecode) << ",\n";
-        json_stream << "      \"Pitch Type\": "         << decode("Pitch", pitch->pitch_type, inDecode) << ",\n";
-        json_stream << "      \"Charge Type\": "        << decode("ChargePitch", pitch->charge_type, inDecode) << ",\n";
-        json_stream << "      \"Star Pitch\": "         << std::to_string(pitch->star_pitch) << ",\n";
-        json_stream << "      \"Pitch Speed\": "        << std::to_string(pitch->pitch_speed) << ",\n";
-        json_stream << "      \"Ball Position - Strikezone\": "   << floatConverter(pitch->ball_z_strike_vs_ball) << ",\n";
-        json_stream << "      \"In Strikezone\": "      << std::to_string(pitch->ball_in_strikezone) << ",\n";
-        json_stream << "        \"" << pitch->bat_contact_x_pos.name << "\": " << floatConverter(pitch->bat_contact_x_pos.get_value()) << ",\n";
-        json_stream << "        \"" << pitch->bat_contact_z_pos.name << "\": " << floatConverter(pitch->bat_contact_z_pos.get_value()) << ",\n";
-        json_stream << "      \"DB\": "                 << std::to_string(pitch->db) << ",\n";
-        json_stream << "      \"Type of Swing\": "      << decode("Swing", pitch->type_of_swing, inDecode);
+        json.raw("    \"Pitch\": {\n");
+        json.format("      \"Pitcher Team Id\": {},\n", pitch->pitcher_team_id);
+        json.decoded("      \"Pitcher Char Id\": ", DecodeType::Character, pitch->pitcher_char_id, ",\n");
+        json.decoded("      \"Pitch Type\": ", DecodeType::Pitch, pitch->pitch_type, ",\n");
+        json.decoded("      \"Charge Type\": ", DecodeType::ChargePitch, pitch->charge_type, ",\n");
+        json.format("      \"Star Pitch\": {},\n", pitch->star_pitch);
+        json.format("      \"Pitch Speed\": {},\n", pitch->pitch_speed);
+        json.format("      \"Ball Position - Strikezone\": {:g},\n", floatConverter(pitch->ball_z_strike_vs_ball));
+        json.format("      \"In Strikezone\": {},\n", pitch->ball_in_strikezone);
+        json.format("        \"{}\": {:g},\n", pitch->bat_contact_x_pos.name(), floatConverter(pitch->bat_contact_x_pos.get_value()));
+        json.format("        \"{}\": {:g},\n", pitch->bat_contact_z_pos.name(), floatConverter(pitch->bat_contact_z_pos.get_value()));
+        json.format("      \"DB\": {},\n", pitch->db);
+        json.decoded("      \"Type of Swing\": ", DecodeType::Swing, pitch->type_of_swing, "");
         
         //=== Contact ===
         if (pitch->contact.has_value() && pitch->contact->type_of_contact.get_value() != 0xFF){
-            json_stream << ",\n";
+            json.raw(",\n");
 
             Contact* contact = &pitch->contact.value();
-            json_stream << "      \"Contact\": {\n";
-            json_stream << "        \"" << contact->type_of_contact.name << "\":" << decode("Contact", contact->type_of_contact.get_value(), inDecode) << ",\n";
-            json_stream << "        \"" << contact->charge_power_up.name << "\": " << floatConverter(contact->charge_power_up.get_value()) << ",\n";
-            json_stream << "        \"" << contact->charge_power_down.name << "\": " << floatConverter(contact->charge_power_down.get_value()) << ",\n";
-            json_stream << "        \"" << contact->moon_shot.name << "\": " << contact->moon_shot.get_key_value_string().second << ",\n"; 
-            json_stream << "        \"" << contact->input_direction_push_pull.name << "\": " << decode("Stick", contact->input_direction_push_pull.get_value(), inDecode) << ",\n";
-            json_stream << "        \"" << contact->input_direction_stick.name << "\": " << decode("StickVec", contact->input_direction_stick.get_value(), inDecode) << ",\n";
-            json_stream << "        \"" << contact->frame_of_swing.name << "\": \"" << std::dec << contact->frame_of_swing.get_value() << "\",\n";
-            json_stream << "        \"" << contact->power.name << "\": \"" << std::dec << contact->power.get_value() <<"\",\n";
-            json_stream << "        \"" << contact->vert_angle.name << "\": \"" << std::dec << contact->vert_angle.get_value() << "\",\n";
-            json_stream << "        \"" << contact->horiz_angle.name << "\": \"" << std::dec << contact->horiz_angle.get_value() << "\",\n";
-            json_stream << "        \"" << contact->contact_absolute.name << "\": " << floatConverter(contact->contact_absolute.get_value()) << ",\n";
-            json_stream << "        \"" << contact->contact_quality.name << "\": " << floatConverter(contact->contact_quality.get_value()) << ",\n";
-            json_stream << "        \"" << contact->rng1.name << "\": \"" << std::dec << contact->rng1.get_value() << "\",\n";
-            json_stream << "        \"" << contact->rng2.name << "\": \"" << std::dec << contact->rng2.get_value() << "\",\n";
-            json_stream << "        \"" << contact->rng3.name << "\": \"" << std::dec << contact->rng3.get_value() << "\",\n";
-            json_stream << "        \"" << contact->ball_x_velo.name << "\": " << floatConverter(contact->ball_x_velo.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_y_velo.name << "\": " << floatConverter(contact->ball_y_velo.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_z_velo.name << "\": " << floatConverter(contact->ball_z_velo.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_contact_x_pos.name << "\": " << floatConverter(contact->ball_contact_x_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_contact_z_pos.name << "\": " << floatConverter(contact->ball_contact_z_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_x_pos.name << "\": " << floatConverter(contact->ball_x_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_y_pos.name << "\": " << floatConverter(contact->ball_y_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_z_pos.name << "\": " << floatConverter(contact->ball_z_pos.get_value()) << ",\n";
-            json_stream << "        \"" << contact->ball_hang_time.name << "\": " << std::dec << contact->ball_hang_time.get_value() << ",\n";
-            json_stream << "        \"" << contact->ball_max_height.name << "\": " << floatConverter(contact->ball_max_height.get_value()) << ",\n";
-            json_stream << "        \"Contact Result - Primary\": "         << decode("PrimaryContactResult", contact->primary_contact_result, inDecode) << ",\n";
-            json_stream << "        \"Contact Result - Secondary\": "       << decode("SecondaryContactResult", contact->secondary_contact_result, inDecode);
+            json.raw("      \"Contact\": {\n");
+            json.format("        \"{}\":", contact->type_of_contact.name());
+            json.decoded("", DecodeType::Contact, contact->type_of_contact.get_value(), ",\n");
+            json.format("        \"{}\": {:g},\n", contact->charge_power_up.name(), floatConverter(contact->charge_power_up.get_value()));
+            json.format("        \"{}\": {:g},\n", contact->charge_power_down.name(), floatConverter(contact->charge_power_down.get_value()));
+            json.format("        \"{}\": {},\n", contact->moon_shot.name(), contact->moon_shot.get_value());
+            json.format("        \"{}\": ", contact->input_direction_push_pull.name());
+            json.decoded("", DecodeType::Stick, contact->input_direction_push_pull.get_value(), ",\n");
+            json.format("        \"{}\": ", contact->input_direction_stick.name());
+            json.decoded("", DecodeType::StickVec, contact->input_direction_stick.get_value(), ",\n");
+            json.format("        \"{}\": \"{}\",\n", contact->frame_of_swing.name(), contact->frame_of_swing.get_value());
+            json.format("        \"{}\": \"{}\",\n", contact->power.name(), contact->power.get_value());
+            json.format("        \"{}\": \"{}\",\n", contact->vert_angle.name(), contact->vert_angle.get_value());
+            json.format("        \"{}\": \"{}\",\n", contact->horiz_angle.name(), contact->horiz_angle.get_value());
+            json.format("        \"{}\": {:g},\n", contact->contact_absolute.name(), floatConverter(contact->contact_absolute.get_value()));
+            json.format("        \"{}\": {:g},\n", contact->contact_quality.name(), floatConverter(contact->contact_quality.get_value()));
+            json.format("        \"{}\": \"{}\",\n", contact->rng1.name(), contact->rng1.get_value());
+            json.format("        \"{}\": \"{}\",\n", contact->rng2.name(), contact->rng2.get_value());
+            json.format("        \"{}\": \"{}\",\n", contact->rng3.name(), contact->rng3.get_value());
+            json.format("        \"{}\": {:g},\n", contact->ball_x_velo.name(), floatConverter(contact->ball_x_velo.get_value()));
+            json.format("        \"{}\": {:g},\n", contact->ball_y_velo.name(), floatConverter(contact->ball_y_velo.get_value()));
+            json.format("        \"{}\": {:g},\n", contact->ball_z_velo.name(), floatConverter(contact->ball_z_velo.get_value()));
+            json.format("        \"{}\": {:g},\n", contact->ball_contact_x_pos.name(), floatConverter(contact->ball_contact_x_pos.get_value()));
+            json.format("        \"{}\": {:g},\n", contact->ball_contact_z_pos.name(), floatConverter(contact->ball_contact_z_pos.get_value()));
+            json.format("        \"{}\": {:g},\n", contact->ball_x_pos.name(), floatConverter(contact->ball_x_pos.get_value()));
+            json.format("        \"{}\": {:g},\n", contact->ball_y_pos.name(), floatConverter(contact->ball_y_pos.get_value()));
+            json.format("        \"{}\": {:g},\n", contact->ball_z_pos.name(), floatConverter(contact->ball_z_pos.get_value()));
+            json.format("        \"{}\": {},\n", contact->ball_hang_time.name(), contact->ball_hang_time.get_value());
+            json.format("        \"{}\": {:g},\n", contact->ball_max_height.name(), floatConverter(contact->ball_max_height.get_value()));
+            json.decoded("        \"Contact Result - Primary\": ", DecodeType::PrimaryContactResult, contact->primary_contact_result, ",\n");
+            json.decoded("        \"Contact Result - Secondary\": ", DecodeType::SecondaryContactResult, contact->secondary_contact_result, "");
 
             //=== Fielder ===
             //TODO could be reworked
             if (contact->first_fielder.has_value() || contact->collect_fielder.has_value()){
-                json_stream << ",\n";
+                json.raw(",\n");
 
                 //First fielder to touch the ball
                 Fielder* fielder;
@@ -1509,33 +1794,32 @@ std::string StatTracker::getHUDJSON(std::string in_event_num, Event& in_curr_eve
                 if (contact->first_fielder.has_value()) { fielder = &contact->first_fielder.value(); }
                 else {fielder = &contact->collect_fielder.value();}
 
-                json_stream << "        \"First Fielder\": {\n";
-                json_stream << "          \"Fielder Roster Location\": " << std::to_string(fielder->fielder_roster_loc) << ",\n";
-                json_stream << "          \"Fielder Position\": "        << decode("Position", fielder->fielder_pos, inDecode) << ",\n";
-                json_stream << "          \"Fielder Character\": "       << decode("Character", fielder->fielder_char_id, inDecode) << ",\n";
-                json_stream << "          \"Fielder Action\": "          << decode("Action", fielder->fielder_action, inDecode) << ",\n";
-                json_stream << "          \"Fielder Jump\": "            << std::to_string(fielder->fielder_jump) << ",\n";
-                json_stream << "          \"Fielder Swap\": "            << std::to_string(fielder->fielder_swapped_for_batter) << ",\n";
-                json_stream << "          \"Fielder Manual Selected\": " << decode("ManualSelect", fielder->fielder_manual_select_arg, inDecode) << ",\n";
-                json_stream << "          \"Fielder Position - X\": "    << floatConverter(fielder->fielder_x_pos) << ",\n";
-                json_stream << "          \"Fielder Position - Y\": "    << floatConverter(fielder->fielder_y_pos) << ",\n";
-                json_stream << "          \"Fielder Position - Z\": "    << floatConverter(fielder->fielder_z_pos) << ",\n";
-                json_stream << "          \"Fielder Bobble\": "          << decode("Bobble", fielder->bobble, inDecode) << "\n";
-                json_stream << "        }\n";
+                json.raw("        \"First Fielder\": {\n");
+                json.format("          \"Fielder Roster Location\": {},\n", fielder->fielder_roster_loc);
+                json.decoded("          \"Fielder Position\": ", DecodeType::Position, fielder->fielder_pos, ",\n");
+                json.decoded("          \"Fielder Character\": ", DecodeType::Character, fielder->fielder_char_id, ",\n");
+                json.decoded("          \"Fielder Action\": ", DecodeType::Action, fielder->fielder_action, ",\n");
+                json.format("          \"Fielder Jump\": {},\n", fielder->fielder_jump);
+                json.format("          \"Fielder Swap\": {},\n", fielder->fielder_swapped_for_batter);
+                json.decoded("          \"Fielder Manual Selected\": ", DecodeType::ManualSelect, fielder->fielder_manual_select_arg, ",\n");
+                json.format("          \"Fielder Position - X\": {:g},\n", floatConverter(fielder->fielder_x_pos));
+                json.format("          \"Fielder Position - Y\": {:g},\n", floatConverter(fielder->fielder_y_pos));
+                json.format("          \"Fielder Position - Z\": {:g},\n", floatConverter(fielder->fielder_z_pos));
+                json.decoded("          \"Fielder Bobble\": ", DecodeType::Bobble, fielder->bobble, "\n");
+                json.raw("        }\n");
             }
             else{ //Finish contact section
-                json_stream << "\n";
+                json.raw("\n");
             }
-            json_stream << "      }\n"; //close contact
+            json.raw("      }\n"); //close contact
         }
         else { //Finish pitch section
-            json_stream << "\n";
+            json.raw("\n");
         }
-        json_stream << "    }\n"; //Close pitch
+        json.raw("    }\n"); //Close pitch
     }
-    json_stream << "  }\n"; //Close Previous Event
-    json_stream << "}";
-    return json_stream.str();
+    json.raw("  }\n"); //Close Previous Event
+    json.raw("}");
 }
 
 //Scans player for possession
@@ -1553,27 +1837,27 @@ std::optional<StatTracker::Fielder> StatTracker::logFielderWithBall(const Core::
         u32 aFielderRosterLoc = aFielder_RosterLoc + (pos * cFielder_Offset);
         u32 aFielderCharId = aFielder_CharId + (pos * cFielder_Offset);
 
-        bool fielder_has_ball = (PowerPC::MMU::HostRead_U8(guard, aFielderControlStatus) == 0xA);
+        bool fielder_has_ball = (m_snapshot.read<u8>(guard, aFielderControlStatus) == 0xA);
 
         if (fielder_has_ball) {
             Fielder fielder_with_ball;
             //get char id
-            fielder_with_ball.fielder_roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielderRosterLoc);
-            fielder_with_ball.fielder_char_id = PowerPC::MMU::HostRead_U8(guard, aFielderCharId);
+            fielder_with_ball.fielder_roster_loc = m_snapshot.read<u8>(guard, aFielderRosterLoc);
+            fielder_with_ball.fielder_char_id = m_snapshot.read<u8>(guard, aFielderCharId);
             fielder_with_ball.fielder_pos = pos;
 
-            fielder_with_ball.fielder_x_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosX);
-            fielder_with_ball.fielder_y_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosY);
-            fielder_with_ball.fielder_z_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosZ);
+            fielder_with_ball.fielder_x_pos = m_snapshot.read<u32>(guard, aFielderPosX);
+            fielder_with_ball.fielder_y_pos = m_snapshot.read<u32>(guard, aFielderPosY);
+            fielder_with_ball.fielder_z_pos = m_snapshot.read<u32>(guard, aFielderPosZ);
 
-            if (PowerPC::MMU::HostRead_U8(guard, aFielderAction)) {
-                fielder_with_ball.fielder_action = PowerPC::MMU::HostRead_U8(guard, aFielderAction); //2 = Slide, 3 = Walljump
+            if (m_snapshot.read<u8>(guard, aFielderAction)) {
+                fielder_with_ball.fielder_action = m_snapshot.read<u8>(guard, aFielderAction); //2 = Slide, 3 = Walljump
             }
-            if (PowerPC::MMU::HostRead_U8(guard, aFielderJump)) {
-                fielder_with_ball.fielder_jump = PowerPC::MMU::HostRead_U8(guard, aFielderJump); //1 = jump
+            if (m_snapshot.read<u8>(guard, aFielderJump)) {
+                fielder_with_ball.fielder_jump = m_snapshot.read<u8>(guard, aFielderJump); //1 = jump
             }
 
-            fielder_with_ball.fielder_manual_select_arg = PowerPC::MMU::HostRead_U8(guard, aFielder_ManualSelectArg);
+            fielder_with_ball.fielder_manual_select_arg = m_snapshot.read<u8>(guard, aFielder_ManualSelectArg);
 
             std::cout << "Fielder Pos=" << std::to_string(pos) << " Fielder RosterLoc=" << std::to_string(fielder_with_ball.fielder_roster_loc)
                       << " Fielder Action: " << std::to_string(fielder_with_ball.fielder_action)
@@ -1605,8 +1889,8 @@ std::optional<StatTracker::Fielder> StatTracker::logFielderBobble(const Core::CP
         u32 aFielderCharId = aFielder_CharId + (pos * cFielder_Offset);
         
         u8 typeOfFielderDisruption = 0x0;
-        u8 bobble_addr = PowerPC::MMU::HostRead_U8(guard, aFielderBobbleStatus);
-        u8 knockout_addr = PowerPC::MMU::HostRead_U8(guard, aFielderKnockoutStatus);
+        u8 bobble_addr = m_snapshot.read<u8>(guard, aFielderBobbleStatus);
+        u8 knockout_addr = m_snapshot.read<u8>(guard, aFielderKnockoutStatus);
 
         if (knockout_addr) {
             typeOfFielderDisruption = 0x10; //Knockout - no bobble
@@ -1618,24 +1902,24 @@ std::optional<StatTracker::Fielder> StatTracker::logFielderBobble(const Core::CP
         if (typeOfFielderDisruption > 0x1) {
             Fielder fielder_that_bobbled;
             //get char id
-            fielder_that_bobbled.fielder_roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielderRosterLoc);
-            fielder_that_bobbled.fielder_char_id = PowerPC::MMU::HostRead_U8(guard, aFielderCharId);
+            fielder_that_bobbled.fielder_roster_loc = m_snapshot.read<u8>(guard, aFielderRosterLoc);
+            fielder_that_bobbled.fielder_char_id = m_snapshot.read<u8>(guard, aFielderCharId);
 
-            fielder_that_bobbled.fielder_x_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosX);
-            fielder_that_bobbled.fielder_y_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosY);
-            fielder_that_bobbled.fielder_z_pos = PowerPC::MMU::HostRead_U32(guard, aFielderPosZ);
+            fielder_that_bobbled.fielder_x_pos = m_snapshot.read<u32>(guard, aFielderPosX);
+            fielder_that_bobbled.fielder_y_pos = m_snapshot.read<u32>(guard, aFielderPosY);
+            fielder_that_bobbled.fielder_z_pos = m_snapshot.read<u32>(guard, aFielderPosZ);
             fielder_that_bobbled.fielder_pos = pos;
             fielder_that_bobbled.bobble = typeOfFielderDisruption;
 
-            if (PowerPC::MMU::HostRead_U8(guard, aFielderAction)) {
-                fielder_that_bobbled.fielder_action = PowerPC::MMU::HostRead_U8(guard, aFielderAction); //2 = Slide, 3 = Walljump
+            if (m_snapshot.read<u8>(guard, aFielderAction)) {
+                fielder_that_bobbled.fielder_action = m_snapshot.read<u8>(guard, aFielderAction); //2 = Slide, 3 = Walljump
             }
-            if (PowerPC::MMU::HostRead_U8(guard, aFielderJump)) {
-                fielder_that_bobbled.fielder_jump = PowerPC::MMU::HostRead_U8(guard, aFielderJump); //1 = jump
+            if (m_snapshot.read<u8>(guard, aFielderJump)) {
+                fielder_that_bobbled.fielder_jump = m_snapshot.read<u8>(guard, aFielderJump); //1 = jump
             }
 
             //We can read manual select now because we don't have the ball
-            fielder_that_bobbled.fielder_manual_select_arg = PowerPC::MMU::HostRead_U8(guard, aFielder_ManualSelectArg);
+            fielder_that_bobbled.fielder_manual_select_arg = m_snapshot.read<u8>(guard, aFielder_ManualSelectArg);
 
             std::cout << "Fielder Pos=" << std::to_string(pos) << " Fielder RosterLoc=" << std::to_string(fielder_that_bobbled.fielder_roster_loc)
                       << " Fielder Action: " << std::to_string(fielder_that_bobbled.fielder_action) 
@@ -1655,7 +1939,24 @@ void StatTracker::readPlayerNames(bool local_game) {
   int team0_port = m_game_info.team0_port;
   int team1_port = m_game_info.team1_port;
 
-  if (local_game)
+  // The local players are whoever plays the movie back, not who recorded it. Their ports are left
+  // without a player
+  if (Core::System::GetInstance().GetMovie().IsPlayingInput())
+  {
+    m_game_info.team0_player = LocalPlayers::LocalPlayers::Player();
+    m_game_info.team1_player = LocalPlayers::LocalPlayers::Player();
+    if (team0_port != 0)
+    {
+      m_game_info.team0_player.username = "CPU";
+      m_game_info.team0_player.userid = "CPU";
+    }
+    if (team1_port > 3)
+    {
+      m_game_info.team1_player.username = "CPU";
+      m_game_info.team1_player.userid = "CPU";
+    }
+  }
+  else if (local_game)
   {
     // Player 1
     if (team0_port == 0)
@@ -1700,6 +2001,9 @@ void StatTracker::clearTagSetId(bool netplay) {
 
 
 bool StatTracker::shouldSubmitGame() {
+    //A replayed game was submitted when it was played, the same goes for movie playback
+    if (m_replaying_trace || Core::System::GetInstance().GetMovie().IsPlayingInput()){ return false; }
+
     bool cpuInGame = (m_game_info.getAwayTeamPlayer().GetUserID() == "CPU") || (m_game_info.getHomeTeamPlayer().GetUserID() == "CPU");
     bool tag_set_game = m_game_info.tag_set_id.has_value();
     std::cout << "Checking game submission. TagSetSelected=" << tag_set_game << " cpuInGame=" << cpuInGame << "\n";
@@ -1723,6 +2027,26 @@ void StatTracker::setLagSpikes(int nLagSpikes)
   //std::cout << "Number of Lag Spikes=" << nLagSpikes << "\n";
   m_game_info.lag_spikes = nLagSpikes;
 }
+void StatTracker::addPadBufferDecision(u32 buffer, u32 previous_buffer, u32 rtt_ms, u32 jitter_ms)
+{
+  m_game_info.pad_buffer_decisions.push_back({m_game_info.event_num, buffer, previous_buffer, rtt_ms, jitter_ms});
+}
+
+void StatTracker::setNetplayTiming(const NetPlay::TimingSummary& timing)
+{
+  m_game_info.netplay_timing = timing;
+}
+
+void StatTracker::setNetplayPadTransport(const NetPlay::RedundantPadReceiver::Stats& pad_transport)
+{
+  m_game_info.netplay_pad_transport = pad_transport;
+}
+
+bool StatTracker::takePadBufferSafePoint()
+{
+  return std::exchange(m_pad_buffer_safe_point, false);
+}
+
 void StatTracker::setNetplayerUserInfo(std::map<int, LocalPlayers::LocalPlayers::Player> userInfo)
 {
   for (auto player : userInfo)
@@ -1736,17 +2060,16 @@ void StatTracker::setGameID(u32 gameID)
 
 void StatTracker::initPlayerInfo(const Core::CPUThreadGuard& guard){
     //Read start time
-    std::time_t unix_time = std::time(nullptr);
+    std::time_t unix_time = getFrameTime();
     m_game_info.start_unix_date_time = std::to_string(unix_time);
     m_game_info.start_local_date_time = std::asctime(std::localtime(&unix_time));
     m_game_info.start_local_date_time.pop_back();
     //Collect port info for players
     if (m_game_info.team0_port == 0xFF && m_game_info.team1_port == 0xFF){
-        //From Roeming
-        std::array<u8, 2> ports = {PowerPC::MMU::HostRead_U8(guard, 0x800e874c), PowerPC::MMU::HostRead_U8(guard, 0x800e874d)};
+        std::array<u8, 2> ports = {m_snapshot.read<u8>(guard, aTeamPorts), m_snapshot.read<u8>(guard, aTeamPorts + 1)};
         
-        u8 BattingPort = ports[PowerPC::MMU::HostRead_U32(guard, 0x80892990)];
-        u8 FieldingPort = ports[PowerPC::MMU::HostRead_U32(guard, 0x80892994)];
+        u8 BattingPort = ports[m_snapshot.read<u32>(guard, 0x80892990)];
+        u8 FieldingPort = ports[m_snapshot.read<u32>(guard, 0x80892994)];
         
         m_game_info.team0_port = ports[0];
         m_game_info.team1_port = ports[1];
@@ -1768,8 +2091,8 @@ void StatTracker::initPlayerInfo(const Core::CPUThreadGuard& guard){
             home_player_name = m_game_info.team0_player.GetUsername();
         }
 
-        std::cout << "ports[0]=" << std::to_string(PowerPC::MMU::HostRead_U8(guard, 0x800e874c)) << " ports[1]=" << std::to_string(PowerPC::MMU::HostRead_U8(guard, 0x800e874d)) << "\n";
-        std::cout << "BattingPort=" << std::to_string(PowerPC::MMU::HostRead_U32(guard, 0x80892990)) << " FieldingPort=" << std::to_string(PowerPC::MMU::HostRead_U32(guard, 0x80892994)) << "\n";
+        std::cout << "ports[0]=" << std::to_string(ports[0]) << " ports[1]=" << std::to_string(ports[1]) << "\n";
+        std::cout << "BattingPort=" << std::to_string(m_snapshot.read<u32>(guard, 0x80892990)) << " FieldingPort=" << std::to_string(m_snapshot.read<u32>(guard, 0x80892994)) << "\n";
 
         std::cout << "Info:  Fielder Port=" << std::to_string(FieldingPort) << ", Batter Port=" << std::to_string(BattingPort) << "\n";
         std::cout << "Info:  Team0 Port=" << std::to_string(m_game_info.team0_port) << ", Team1 Port=" << std::to_string(m_game_info.team1_port) << "\n";
@@ -1782,8 +2105,8 @@ void StatTracker::initPlayerInfo(const Core::CPUThreadGuard& guard){
 
 void StatTracker::initCaptains(const Core::CPUThreadGuard& guard)
 {
-    m_game_info.team0_captain_roster_loc = PowerPC::MMU::HostRead_U8(guard, aTeam0_Captain_Roster_Loc);
-    m_game_info.team1_captain_roster_loc = PowerPC::MMU::HostRead_U8(guard, aTeam1_Captain_Roster_Loc);
+    m_game_info.team0_captain_roster_loc = m_snapshot.read<u8>(guard, aTeam0_Captain_Roster_Loc);
+    m_game_info.team1_captain_roster_loc = m_snapshot.read<u8>(guard, aTeam1_Captain_Roster_Loc);
 
     u8 away_captain_roster_loc = (m_game_info.away_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
     u8 home_captain_roster_loc = (m_game_info.home_port == m_game_info.team0_port) ? m_game_info.team0_captain_roster_loc : m_game_info.team1_captain_roster_loc;
@@ -1793,7 +2116,7 @@ void StatTracker::initCaptains(const Core::CPUThreadGuard& guard)
 }
 
 void StatTracker::onGameQuit(const Core::CPUThreadGuard& guard){
-    u8 quitter_port = PowerPC::MMU::HostRead_U8(guard, aWhoQuit);
+    u8 quitter_port = m_snapshot.read<u8>(guard, aWhoQuit);
     m_game_info.quitter_team = (quitter_port == m_game_info.away_port);
     logGameInfo(guard);
 
@@ -1810,6 +2133,8 @@ void StatTracker::onGameQuit(const Core::CPUThreadGuard& guard){
     
     File::WriteStringToFile(jsonPath, json);
 
+    archiveGame();
+
     // json = getStatJSON(false, false);
     // if (shouldSubmitGame()) {
     //     const Common::HttpRequest::Response response =
@@ -1824,12 +2149,12 @@ void StatTracker::onGameQuit(const Core::CPUThreadGuard& guard){
 std::optional<StatTracker::Runner> StatTracker::logRunnerInfo(const Core::CPUThreadGuard& guard, u8 base){
     std::optional<Runner> runner;
     //See if there is a runner in this pos
-    if (PowerPC::MMU::HostRead_U8(guard, aRunner_RosterLoc + (base * cRunner_Offset)) != 0xFF){
+    if (m_snapshot.read<u8>(guard, aRunner_RosterLoc + (base * cRunner_Offset)) != 0xFF){
         Runner init_runner;
-        init_runner.roster_loc = PowerPC::MMU::HostRead_U8(guard, aRunner_RosterLoc + (base * cRunner_Offset));
-        init_runner.char_id = PowerPC::MMU::HostRead_U8(guard, aRunner_CharId + (base * cRunner_Offset));
+        init_runner.roster_loc = m_snapshot.read<u8>(guard, aRunner_RosterLoc + (base * cRunner_Offset));
+        init_runner.char_id = m_snapshot.read<u8>(guard, aRunner_CharId + (base * cRunner_Offset));
         init_runner.initial_base = base;
-        init_runner.basepath_location = PowerPC::MMU::HostRead_U32(guard, aRunner_BasepathPercentage + (base * cRunner_Offset));
+        init_runner.basepath_location = m_snapshot.read<u32>(guard, aRunner_BasepathPercentage + (base * cRunner_Offset));
         runner = std::make_optional(init_runner);
         return runner;        
     }
@@ -1838,9 +2163,9 @@ std::optional<StatTracker::Runner> StatTracker::logRunnerInfo(const Core::CPUThr
 
 bool StatTracker::anyRunnerStealing(const Core::CPUThreadGuard& guard, Event& in_event)
 {
-    u8 runner_1_stealing = PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (1 * cRunner_Offset));
-    u8 runner_2_stealing = PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (2 * cRunner_Offset));
-    u8 runner_3_stealing = PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (3 * cRunner_Offset));
+    u8 runner_1_stealing = m_snapshot.read<u8>(guard, aRunner_Stealing + (1 * cRunner_Offset));
+    u8 runner_2_stealing = m_snapshot.read<u8>(guard, aRunner_Stealing + (2 * cRunner_Offset));
+    u8 runner_3_stealing = m_snapshot.read<u8>(guard, aRunner_Stealing + (3 * cRunner_Offset));
 
     return (runner_1_stealing || runner_2_stealing || runner_3_stealing);
 }
@@ -1850,171 +2175,25 @@ void StatTracker::logRunnerEvents(const Core::CPUThreadGuard& guard, Runner* in_
     if (in_runner->out_type != 0 ) { return; }
 
     //Return if runner has already gotten out
-    in_runner->out_type = PowerPC::MMU::HostRead_U8(guard, aRunner_OutType + (in_runner->initial_base * cRunner_Offset));
+    in_runner->out_type = m_snapshot.read<u8>(guard, aRunner_OutType + (in_runner->initial_base * cRunner_Offset));
     if (in_runner->out_type != 0) {
-        in_runner->out_location = PowerPC::MMU::HostRead_U8(guard, aRunner_CurrentBase + (in_runner->initial_base * cRunner_Offset));
+        in_runner->out_location = m_snapshot.read<u8>(guard, aRunner_CurrentBase + (in_runner->initial_base * cRunner_Offset));
         in_runner->result_base = 0xFF;
-        in_runner->basepath_location = PowerPC::MMU::HostRead_U32(guard, aRunner_BasepathPercentage + (in_runner->initial_base * cRunner_Offset));
+        in_runner->basepath_location = m_snapshot.read<u32>(guard, aRunner_BasepathPercentage + (in_runner->initial_base * cRunner_Offset));
 
         std::cout << "Logging Runner " << std::to_string(in_runner->initial_base) << ": Out. Type=" << std::to_string(in_runner->out_type)
         << " Location=" << std::to_string(in_runner->out_location) << "\n";
     }
     else{
-        in_runner->result_base = PowerPC::MMU::HostRead_U8(guard, aRunner_CurrentBase + (in_runner->initial_base * cRunner_Offset));
+        in_runner->result_base = m_snapshot.read<u8>(guard, aRunner_CurrentBase + (in_runner->initial_base * cRunner_Offset));
     }
 
-    if (PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (in_runner->initial_base * cRunner_Offset)) > in_runner->steal){
-        in_runner->steal = PowerPC::MMU::HostRead_U8(guard, aRunner_Stealing + (in_runner->initial_base * cRunner_Offset));
+    if (m_snapshot.read<u8>(guard, aRunner_Stealing + (in_runner->initial_base * cRunner_Offset)) > in_runner->steal){
+        in_runner->steal = m_snapshot.read<u8>(guard, aRunner_Stealing + (in_runner->initial_base * cRunner_Offset));
         std::cout << "Logging Runner " << std::to_string(in_runner->initial_base) << ": Steal. Type=" << std::to_string(in_runner->steal)<< "\n";
     }
 }
 
-std::string StatTracker::decode(std::string type, u8 value, bool decode){
-    if (!decode) { return std::to_string(value);}
-
-    std::string retVal = "Unable to Decode";
-    
-    if (type == "Character"){
-        if (cCharIdToCharName.count(value)){
-            retVal = cCharIdToCharName.at(value);
-        }
-    }
-    else if (type == "Stadium"){
-        if (cStadiumIdToStadiumName.count(value)){
-            retVal = cStadiumIdToStadiumName.at(value);
-        }
-    }
-    else if (type == "Contact"){
-        if (cTypeOfContactToHR.count(value)){
-            retVal = cTypeOfContactToHR.at(value);
-        }
-    }
-    else if (type == "Hand"){
-        if (cHandToHR.count(value)){
-            retVal = cHandToHR.at(value);
-        }
-    }
-    else if (type == "Stick"){
-        if (cInputDirectionToHR.count(value)){
-            retVal = cInputDirectionToHR.at(value);
-        }
-    }
-    else if (type == "StickVec"){
-        retVal = "";
-        if ( (value & 0x1) > 0 ){
-            if (retVal != ""){
-                retVal += "+";
-            }
-            retVal += "Left";
-        }
-        if ( (value & 0x2) > 0 ){
-            if (retVal != ""){
-                retVal += "+";
-            }
-            retVal += "Right";
-        } 
-        if ( (value & 0x4) > 0 ){
-            if (retVal != ""){
-                retVal += "+";
-            }
-            retVal += "Down";
-        } 
-        if ( (value & 0x8) > 0 ){
-            if (retVal != ""){
-                retVal += "+";
-            }
-            retVal += "Up";
-        } 
-    }
-    else if (type == "Pitch"){
-        if (cPitchTypeToHR.count(value)){
-            retVal = cPitchTypeToHR.at(value);
-        }
-    }
-    else if (type == "ChargePitch"){
-        if (cChargePitchTypeToHR.count(value)){
-            retVal = cChargePitchTypeToHR.at(value);
-        }
-    }
-    else if (type == "Swing"){
-        if (cTypeOfSwing.count(value)){
-            retVal = cTypeOfSwing.at(value);
-        }
-    }
-    else if (type == "Position"){
-        if (cPosition.count(value)){
-            retVal = cPosition.at(value);
-        }
-    }
-    else if (type == "Action"){
-        if (cFielderActions.count(value)){
-            retVal = cFielderActions.at(value);
-        }
-    }
-    else if (type == "Bobble"){
-        if (cFielderBobbles.count(value)){
-            retVal = cFielderBobbles.at(value);
-        }
-    }
-    else if (type == "ManualSelect"){
-        if (cManualSelectDecode.count(value)){
-            retVal = cManualSelectDecode.at(value);
-        }
-    }
-    else if (type == "Steal"){
-        if (cStealType.count(value)){
-            retVal = cStealType.at(value);
-        }
-    }
-    else if (type == "Out"){
-        if (cOutType.count(value)){
-            retVal = cOutType.at(value);
-        }
-    }
-    else if (type == "PrimaryContactResult"){
-        if (cPrimaryContactResult.count(value)){
-            retVal = cPrimaryContactResult.at(value);
-        }
-    }
-    else if (type == "SecondaryContactResult"){
-        if (cSecondaryContactResult.count(value)){
-            retVal = cSecondaryContactResult.at(value);
-        }
-    }
-    else if (type == "PitchResult"){
-        if (cPitchResult.count(value)){
-            retVal = cPitchResult.at(value);
-        }
-    }
-    else if (type == "AtBatResult"){
-        if (cAtBatResult.count(value)){
-            retVal = cAtBatResult.at(value);
-        }
-    }
-    else if (type == "QuitterTeam"){
-        if (value == 0){
-            retVal = "Home";
-        }
-        else if (value == 1){
-            retVal = "Away";
-        }
-        else if (value == 2){
-            retVal = "Crash";
-        }
-        else if (value == 0xFF){
-            retVal = "None";
-        }
-    }
-    else{
-        retVal += ". Invalid Type (" + type + ")";
-    }
-    
-    if (retVal == "Unable to Decode"){
-        retVal += ". Invalid Value (" + std::to_string(value) + ").";
-    }
-    return ("\"" + retVal + "\"");
-}
-
 void StatTracker::postOngoingGame(Event& in_curr_event){
     if (!shouldSubmitGame()){ return; }
 
@@ -2032,7 +2211,7 @@ void StatTracker::postOngoingGame(Event& in_curr_event){
         tag_set_id_str = std::to_string(m_game_info.tag_set_id.value());
     }
     json_stream << "  \"TagSetID\": " << tag_set_id_str << ",\n";
-    json_stream << "  \"StadiumID\": " << decode("Stadium", m_game_info.stadium, false) << ",\n";
+    json_stream << "  \"StadiumID\": " << std::to_string(m_game_info.stadium) << ",\n";
     json_stream << "  \"Away Player\": \""           << m_game_info.getAwayTeamPlayer().GetUserID() << "\",\n";
     json_stream << "  \"Home Player\": \""           << m_game_info.getHomeTeamPlayer().GetUserID() << "\",\n";
 
@@ -2066,12 +2245,7 @@ void StatTracker::postOngoingGame(Event& in_curr_event){
     json_stream << "  \"Pitcher\": "                 << std::to_string(in_curr_event.pitcher_roster_loc) << "\n";
     json_stream << "}\n";
 
-    const Common::HttpRequest::Response response =
-        m_http.Post("https://api.projectrio.app/populate_db/ongoing_game/", json_stream.str(),
-            {
-                {"Content-Type", "application/json"},
-            }
-        );
+    m_uploader.submitOngoingGame(json_stream.str());
 }
 void StatTracker::updateOngoingGame(Event& in_curr_event){
     if (!shouldSubmitGame()){ return; }
@@ -2101,10 +2275,5 @@ void StatTracker::updateOngoingGame(Event& in_curr_event){
     json_stream << "  \"Runner 3B\": "       << std::to_string(runner_3) << "\n";
     json_stream << "}\n";
 
-    const Common::HttpRequest::Response response =
-        m_http.Post("https://api.projectrio.app/populate_db/ongoing_game/", json_stream.str(),
-            {
-                {"Content-Type", "application/json"},
-            }
-        );
+    m_uploader.submitOngoingGame(json_stream.str());
 }
@@ -1,11 +1,16 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <array>
+#include <ctime>
+#include <deque>
 #include <vector>
+#include <optional>
 #include <map>
 #include <set>
 #include <tuple>
+#include <type_traits>
 #include <iostream>
 #include "Core/HW/Memmap.h"
 #include <picojson.h>
@@ -17,7 +22,18 @@
 
 #include "Core/LocalPlayers.h"
 #include "Core/Logger.h"
+#include "Core/MSB_EventArena.h"
+#include "Core/MSB_StatArchive.h"
+#include "Core/MSB_StatDecode.h"
+#include "Core/MSB_StatEventJournal.h"
+#include "Core/MSB_StatHudPublisher.h"
+#include "Core/MSB_StatJsonWriter.h"
+#include "Core/MSB_StatTrackerTrace.h"
+#include "Core/MSB_StatUploader.h"
+#include "Core/NetPlayRedundantPads.h"
+#include "Core/NetPlayTiming.h"
 #include "Core/TrackerAdr.h"
+#include "Core/TrackerSnapshot.h"
 
 namespace Tag {
 class TagSet;
@@ -67,226 +83,6 @@ static std::map<EVENT_STATE, std::string> c_event_state = {
 
 
 
-//Conversion Maps
-
-static const std::map<u8, std::string> cCharIdToCharName = {
-    {0x0, "Mario"},
-    {0x1, "Luigi"},
-    {0x2, "DK"},
-    {0x3, "Diddy"},
-    {0x4, "Peach"},
-    {0x5, "Daisy"},
-    {0x6, "Yoshi"},
-    {0x7, "Baby Mario"},
-    {0x8, "Baby Luigi"},
-    {0x9, "Bowser"},
-    {0xa, "Wario"},
-    {0xb, "Waluigi"},
-    {0xc, "Koopa(G)"},
-    {0xd, "Toad(R)"},
-    {0xe, "Boo"},
-    {0xf, "Toadette"},
-    {0x10, "Shy Guy(R)"},
-    {0x11, "Birdo"},
-    {0x12, "Monty"},
-    {0x13, "Bowser Jr"},
-    {0x14, "Paratroopa(R)"},
-    {0x15, "Pianta(B)"},
-    {0x16, "Pianta(R)"},
-    {0x17, "Pianta(Y)"},
-    {0x18, "Noki(B)"},
-    {0x19, "Noki(R)"},
-    {0x1a, "Noki(G)"},
-    {0x1b, "Bro(H)"},
-    {0x1c, "Toadsworth"},
-    {0x1d, "Toad(B)"},
-    {0x1e, "Toad(Y)"},
-    {0x1f, "Toad(G)"},
-    {0x20, "Toad(P)"},
-    {0x21, "Magikoopa(B)"},
-    {0x22, "Magikoopa(R)"},
-    {0x23, "Magikoopa(G)"},
-    {0x24, "Magikoopa(Y)"},
-    {0x25, "King Boo"},
-    {0x26, "Petey"},
-    {0x27, "Dixie"},
-    {0x28, "Goomba"},
-    {0x29, "Paragoomba"},
-    {0x2a, "Koopa(R)"},
-    {0x2b, "Paratroopa(G)"},
-    {0x2c, "Shy Guy(B)"},
-    {0x2d, "Shy Guy(Y)"},
-    {0x2e, "Shy Guy(G)"},
-    {0x2f, "Shy Guy(Bk)"},
-    {0x30, "Dry Bones(Gy)"},
-    {0x31, "Dry Bones(G)"},
-    {0x32, "Dry Bones(R)"},
-    {0x33, "Dry Bones(B)"},
-    {0x34, "Bro(F)"},
-    {0x35, "Bro(B)"}
-};
-
-static const std::map<u8, std::string> cStadiumIdToStadiumName = {
-    {0x0, "Mario Stadium"},
-    {0x1, "Bowser Castle"},
-    {0x2, "Wario Palace"},
-    {0x3, "Yoshi Park"},
-    {0x4, "Peach Garden"},
-    {0x5, "DK Jungle"},
-    {0x6, "Toy Field"}
-};
-
-static const std::map<u8, std::string> cTypeOfContactToHR = {
-    {0xFF, "Miss"},
-    {0, "Sour - Left"},
-    {1, "Nice - Left"}, 
-    {2, "Perfect"},
-    {3, "Nice - Right"}, 
-    {4, "Sour - Right"}
-};
-
-static const std::map<u8, std::string> cHandToHR = {
-    {0, "Right"},
-    {1, "Left"}
-};
-
-static const std::map<u8, std::string> cInputDirectionToHR = {
-    {0, "None"},
-    {1, "Towards Batter"},
-    {2, "Away From Batter"}
-};
-
-static const std::map<u8, std::string> cPitchTypeToHR = {
-    {0, "Curve"},
-    {1, "Charge"},
-    {2, "ChangeUp"}
-};
-
-static const std::map<u8, std::string> cChargePitchTypeToHR = {
-    {0, "N/A"},
-    {2, "Slider"},
-    {3, "Perfect"}
-};
-
-static const std::map<u8, std::string> cTypeOfSwing = {
-    {0, "None"},
-    {1, "Slap"},
-    {2, "Charge"},
-    {3, "Star"},
-    {4, "Bunt"}
-};
-
-static const std::map<u8, std::string> cPosition = {
-    {0, "P"},
-    {1, "C"},
-    {2, "1B"},
-    {3, "2B"},
-    {4, "3B"},
-    {5, "SS"},
-    {6, "LF"},
-    {7, "CF"},
-    {8, "RF"},
-    {0xFF, "Inv"}
-};
-
-static const std::map<u8, std::string> cFielderActions = {
-    {0, "None"},
-    {2, "Sliding"},
-    {3, "Walljump"},
-};
-
-static const std::map<u8, std::string> cFielderBobbles = {
-    {0, "None"},
-    {1, "Slide/stun lock"},
-    {2, "Fumble"},
-    {3, "Bobble"},
-    {4, "Fireball"},
-    {0x10, "Garlic knockout"},
-    {0xFF, "None"}
-};
-
-static const std::map<u8, std::string> cStealType = {
-    {0, "None"},
-    {1, "Ready"},
-    {2, "Normal"},
-    {3, "Perfect"},
-    {0xFF, "None"}
-};
-
-static const std::map<u8, std::string> cOutType = {
-    {0, "None"},
-    {1, "Caught"},
-    {2, "Force"},
-    {3, "Tag"},
-    {4, "Force Back"},
-    {0x10, "Strike-out"},
-};
-
-static const std::map<u8, std::string> cPitchResult = {
-    {0, "HBP"},
-    {1, "BB"},
-    {2, "Ball"},
-    {3, "Strike-looking"},
-    {4, "Strike-swing"},
-    {5, "Strike-bunting"},
-    {6, "Contact"},
-    {7, "Unknown"}
-};
-
-static const std::map<u8, std::string> cPrimaryContactResult = {
-    {0, "Out"},
-    {1, "Foul"},
-    {2, "Fair"},
-    {3, "Fielded"},
-    {4, "Unknown"},
-};
-
-static const std::map<u8, std::string> cSecondaryContactResult = {
-    {0x0,  "Out-caught"},
-    {0x1,  "Out-force"},
-    {0x2,  "Out-tag"},
-    {0x3,  "Foul"},
-    {0x4,  "Batter safe, runner out"},
-    {0x7,  "Single"},
-    {0x8,  "Double"},
-    {0x9,  "Triple"},
-    {0xA,  "HR"},
-    {0xB,  "Error - Input"},
-    {0xC,  "Error - Chem"},
-    {0xD,  "Bunt"},
-    {0xE,  "SacFly"},
-    {0xF,  "Ground ball double Play"},
-    {0x10, "Foul catch"}
-};
-
-static const std::map<u8, std::string> cAtBatResult = {
-    {0x0,  "None"},
-    {0x1,  "Strikeout"},
-    {0x2,  "Walk (BB)"},
-    {0x3,  "Walk (HBP)"},
-    {0x4,  "Out"},
-    {0x5,  "Caught"},
-    {0x6,  "Caught line-drive"},
-    {0x7,  "Single"},
-    {0x8,  "Double"},
-    {0x9,  "Triple"},
-    {0xA,  "HR"},
-    {0xB,  "Error - Input"},
-    {0xC,  "Error - Chem"},
-    {0xD,  "Bunt"},
-    {0xE,  "SacFly"},
-    {0xF,  "Ground ball double Play"},
-    {0x10, "Foul catch"}
-};
-
-static const std::map<u8, std::string> cManualSelectDecode = {
-    {0x0,  "No Selected Char"},
-    {0x1,  "Pitcher"},
-    {0x2,  "Catcher"},
-    {0x3,  "Closest to Ball"},
-    {0x4,  "Closest to Drop"},
-};
-
 //Const for structs
 static const int cRosterSize = 9;
 static const int cNumOfTeams = 2;
@@ -310,6 +106,7 @@ static const u32 aAB_IsReplay  = 0x80872540;
 
 //Addrs for GameInfo
 static const u32 aStadiumId = 0x800E8705;
+static const u32 aTeamPorts = 0x800E874C; //u8 port of team 0, then team 1. From Roeming
 
 static const u32 aTeam0_Captain = 0x80353083;
 static const u32 aTeam1_Captain = 0x80353087;
@@ -494,10 +291,134 @@ static const u32 aRunner_CurrentBase = 0x8088EF3D;
 static const u32 aRunner_Stealing = 0x8088EF66;
 static const u32 cRunner_Offset = 0x154;
 
+//Contiguous ranges holding every address above. Copied at most once per frame by m_snapshot and
+//all a trace records, so a read outside of them can't be replayed
+struct SnapshotRegion{
+    u32 start;
+    u32 end;
+};
+static constexpr std::array<SnapshotRegion, 7> cSnapshotRegions = {{
+    {0x800E8700, 0x800E8760}, //Stadium and team ports
+    {0x802EBF80, 0x802EC020}, //Game control
+    {0x80353000, 0x80354800}, //Roster
+    {0x8036F3A0, 0x8036F3C0}, //Game is live
+    {0x80872540, 0x80872560}, //Replay flag
+    {0x8088A800, 0x8088A820}, //Pitch thrown
+    {0x8088EE00, 0x80893C00}, //Runners, fielders, at-bat and game state
+}};
+
+static constexpr bool inSnapshotRegion(u32 adr, u32 size){
+    for (const SnapshotRegion& region : cSnapshotRegions){
+        if (region.start <= adr && adr + size <= region.end)
+            return true;
+    }
+    return false;
+}
+
+//Tracked values that are read straight from an address. Order matches cTrackerFields
+enum class TrackerFieldId : u8 {
+    BallPower,
+    VertAngle,
+    HorizAngle,
+    BallVeloX,
+    BallVeloY,
+    BallVeloZ,
+    BallContactPosX,
+    BallContactPosZ,
+    ContactAbsolute,
+    ContactQuality,
+    ContactRng1,
+    ContactRng2,
+    ContactRng3,
+    TypeOfContact,
+    MoonShot,
+    ChargePowerUp,
+    ChargePowerDown,
+    InputDirectionStick,
+    InputDirectionPushPull,
+    FrameOfSwing,
+    BallPosX,
+    BallPosY,
+    BallPosZ,
+    BallMaxHeight,
+    BallHangTime,
+    BatContactPosX,
+    BatContactPosZ,
+    NumOutsDuringPlay,
+    Count
+};
+
+//Name is the key written to the stat file
+static constexpr std::array<TrackerField, static_cast<size_t>(TrackerFieldId::Count)> cTrackerFields = {{
+    {TrackerFieldId::BallPower,              "Ball Power",                  aAB_BallPower,        0xFFFF},
+    {TrackerFieldId::VertAngle,              "Vert Angle",                  aAB_VertAngle,        0xFFFF},
+    {TrackerFieldId::HorizAngle,             "Horiz Angle",                 aAB_HorizAngle,       0xFFFF},
+    {TrackerFieldId::BallVeloX,              "Ball Velocity - X",           aAB_BallVel_X,        0xFFFFFFFF},
+    {TrackerFieldId::BallVeloY,              "Ball Velocity - Y",           aAB_BallVel_Y,        0xFFFFFFFF},
+    {TrackerFieldId::BallVeloZ,              "Ball Velocity - Z",           aAB_BallVel_Z,        0xFFFFFFFF},
+    {TrackerFieldId::BallContactPosX,        "Ball Contact Pos - X",        aAB_BallContactPos_X, 0xFFFFFFFF},
+    {TrackerFieldId::BallContactPosZ,        "Ball Contact Pos - Z",        aAB_BallContactPos_Z, 0xFFFFFFFF},
+    {TrackerFieldId::ContactAbsolute,        "Contact Absolute",            aAB_ContactAbsolute,  0xFFFFFFFF},
+    {TrackerFieldId::ContactQuality,         "Contact Quality",             aAB_ContactQuality,   0xFFFFFFFF},
+    {TrackerFieldId::ContactRng1,            "RNG1",                        aAB_ContactRandInt1,  0xFFFF},
+    {TrackerFieldId::ContactRng2,            "RNG2",                        aAB_ContactRandInt2,  0xFFFF},
+    {TrackerFieldId::ContactRng3,            "RNG3",                        aAB_ContactRandInt3,  0xFFFF},
+    {TrackerFieldId::TypeOfContact,          "Type of Contact",             aAB_TypeOfContact,    0xFF},
+    {TrackerFieldId::MoonShot,               "Star Swing Five-Star",        aAB_MoonShot,         0xFF},
+    {TrackerFieldId::ChargePowerUp,          "Charge Power Up",             aAB_ChargeUp,         0xFFFFFFFF},
+    {TrackerFieldId::ChargePowerDown,        "Charge Power Down",           aAB_ChargeDown,       0xFFFFFFFF},
+    {TrackerFieldId::InputDirectionStick,    "Input Direction - Stick",     0,                    0}, //Derived, no address
+    {TrackerFieldId::InputDirectionPushPull, "Input Direction - Push/Pull", aAB_InputDirection,   0xFF},
+    {TrackerFieldId::FrameOfSwing,           "Frame of Swing Upon Contact", aAB_FrameOfSwing,     0xFFFF},
+    {TrackerFieldId::BallPosX,               "Ball Landing Position - X",   aAB_BallPos_X,        0xFFFFFFFF},
+    {TrackerFieldId::BallPosY,               "Ball Landing Position - Y",   aAB_BallPos_Y,        0xFFFFFFFF},
+    {TrackerFieldId::BallPosZ,               "Ball Landing Position - Z",   aAB_BallPos_Z,        0xFFFFFFFF},
+    {TrackerFieldId::BallMaxHeight,          "Ball Max Height",             0x8089250c,           0xFFFFFFFF},
+    {TrackerFieldId::BallHangTime,           "Ball Hang Time",              0x80892696,           0xFFFF},
+    {TrackerFieldId::BatContactPosX,         "Bat Contact Pos - X",         aAB_BatContactPos_X,  0xFFFFFFFF},
+    {TrackerFieldId::BatContactPosZ,         "Bat Contact Pos - Z",         aAB_BatContactPos_Z,  0xFFFFFFFF},
+    {TrackerFieldId::NumOutsDuringPlay,      "Num Outs During Play",        aAB_NumOutsDuringPlay, 0xFF},
+}};
+
+static constexpr bool trackerFieldsInOrder(){
+    for (size_t i = 0; i < cTrackerFields.size(); ++i){
+        if (static_cast<size_t>(cTrackerFields[i].id) != i)
+            return false;
+    }
+    return true;
+}
+static_assert(trackerFieldsInOrder(), "cTrackerFields must be in TrackerFieldId order");
+
+static constexpr bool trackerFieldsInSnapshot(){
+    for (const TrackerField& field : cTrackerFields){
+        if (field.adr == 0)
+            continue;
+        const u32 size = field.default_value <= 0xFF ? 1 : field.default_value <= 0xFFFF ? 2 : 4;
+        if (!inSnapshotRegion(field.adr, size))
+            return false;
+    }
+    return true;
+}
+static_assert(trackerFieldsInSnapshot(), "Every tracked value must be inside cSnapshotRegions");
+//Read outside of the tables above
+static_assert(inSnapshotRegion(aStadiumId, 1) && inSnapshotRegion(aTeamPorts, 2) &&
+              inSnapshotRegion(aAB_PitchThrown, 1) && inSnapshotRegion(aAB_GameIsLive, 1) &&
+              inSnapshotRegion(aAB_IsReplay, 1), "Tracker reads must be inside cSnapshotRegions");
+//Last element of every table the tracker indexes
+static_assert(inSnapshotRegion(aFielder_RosterLoc + (cRosterSize - 1) * cFielder_Offset, 1) &&
+              inSnapshotRegion(aAB_ControlStickInput + 3 * cControl_Offset, 2),
+              "Tracker tables must be inside cSnapshotRegions");
+
+//Most events a single game can hold before the oldest unjournaled ones are overwritten.
+//A 9 inning game is a few hundred events, this leaves room for long extra innings
+static const size_t cMaxEventsPerGame = 1024;
 
 class StatTracker{
 public:
-    //StatTracker() { };
+    StatTracker(){
+        for (const SnapshotRegion& region : cSnapshotRegions)
+            m_snapshot.addRegion(region.start, region.end);
+    };
     Logger state_logger = Logger("state_log");;
 
     struct EndGameRosterDefensiveStats{
@@ -579,45 +500,45 @@ public:
 
     struct Contact {
         //Vars with 1:1 Adrs
-        TrackerAdr<u16> power       = TrackerAdr<u16>("Ball Power", aAB_BallPower, 0xFFFF);
-        TrackerAdr<u16> vert_angle  = TrackerAdr<u16>("Vert Angle", aAB_VertAngle, 0xFFFF);
-        TrackerAdr<u16> horiz_angle = TrackerAdr<u16>("Horiz Angle", aAB_HorizAngle, 0xFFFF);
+        TrackerAdr<u16> power{TrackerFieldId::BallPower};
+        TrackerAdr<u16> vert_angle{TrackerFieldId::VertAngle};
+        TrackerAdr<u16> horiz_angle{TrackerFieldId::HorizAngle};
 
-        TrackerAdr<u32> ball_x_velo = TrackerAdr<u32>("Ball Velocity - X", aAB_BallVel_X, 0xFFFFFFFF);
-        TrackerAdr<u32> ball_y_velo = TrackerAdr<u32>("Ball Velocity - Y", aAB_BallVel_Y, 0xFFFFFFFF);
-        TrackerAdr<u32> ball_z_velo = TrackerAdr<u32>("Ball Velocity - Z", aAB_BallVel_Z, 0xFFFFFFFF);
+        TrackerAdr<u32> ball_x_velo{TrackerFieldId::BallVeloX};
+        TrackerAdr<u32> ball_y_velo{TrackerFieldId::BallVeloY};
+        TrackerAdr<u32> ball_z_velo{TrackerFieldId::BallVeloZ};
 
-        TrackerAdr<u32> ball_contact_x_pos = TrackerAdr<u32>("Ball Contact Pos - X", aAB_BallContactPos_X, 0xFFFFFFFF);
-        TrackerAdr<u32> ball_contact_z_pos = TrackerAdr<u32>("Ball Contact Pos - Z", aAB_BallContactPos_Z, 0xFFFFFFFF);
+        TrackerAdr<u32> ball_contact_x_pos{TrackerFieldId::BallContactPosX};
+        TrackerAdr<u32> ball_contact_z_pos{TrackerFieldId::BallContactPosZ};
 
-        TrackerAdr<u32> contact_absolute = TrackerAdr<u32>("Contact Absolute", aAB_ContactAbsolute, 0xFFFFFFFF);
-        TrackerAdr<u32> contact_quality = TrackerAdr<u32>("Contact Quality", aAB_ContactQuality, 0xFFFFFFFF);
+        TrackerAdr<u32> contact_absolute{TrackerFieldId::ContactAbsolute};
+        TrackerAdr<u32> contact_quality{TrackerFieldId::ContactQuality};
 
-        TrackerAdr<u16> rng1 = TrackerAdr<u16>("RNG1", aAB_ContactRandInt1, 0xFFFF);
-        TrackerAdr<u16> rng2 = TrackerAdr<u16>("RNG2", aAB_ContactRandInt2, 0xFFFF);
-        TrackerAdr<u16> rng3 = TrackerAdr<u16>("RNG3", aAB_ContactRandInt3, 0xFFFF);
+        TrackerAdr<u16> rng1{TrackerFieldId::ContactRng1};
+        TrackerAdr<u16> rng2{TrackerFieldId::ContactRng2};
+        TrackerAdr<u16> rng3{TrackerFieldId::ContactRng3};
 
         //Hit Status
-        TrackerAdr<u8> type_of_contact = TrackerAdr<u8>("Type of Contact", aAB_TypeOfContact, 0xFF);
-        TrackerAdr<u8> moon_shot = TrackerAdr<u8>("Star Swing Five-Star", aAB_MoonShot, 0xFF);
+        TrackerAdr<u8> type_of_contact{TrackerFieldId::TypeOfContact};
+        TrackerAdr<u8> moon_shot{TrackerFieldId::MoonShot};
 
         //Charge Power
-        TrackerAdr<u32> charge_power_up = TrackerAdr<u32>("Charge Power Up", aAB_ChargeUp, 0xFFFFFFFF);
-        TrackerAdr<u32> charge_power_down = TrackerAdr<u32>("Charge Power Down", aAB_ChargeDown, 0xFFFFFFFF);
+        TrackerAdr<u32> charge_power_up{TrackerFieldId::ChargePowerUp};
+        TrackerAdr<u32> charge_power_down{TrackerFieldId::ChargePowerDown};
         
-        TrackerValue<u8> input_direction_stick = TrackerValue<u8>("Input Direction - Stick", 0);
-        TrackerAdr<u8> input_direction_push_pull = TrackerAdr<u8>("Input Direction - Push/Pull", aAB_InputDirection, 0xFF);
+        TrackerValue<u8> input_direction_stick{TrackerFieldId::InputDirectionStick};
+        TrackerAdr<u8> input_direction_push_pull{TrackerFieldId::InputDirectionPushPull};
 
-        TrackerAdr<u16> frame_of_swing = TrackerAdr<u16>("Frame of Swing Upon Contact", aAB_FrameOfSwing, 0xFFFF);
+        TrackerAdr<u16> frame_of_swing{TrackerFieldId::FrameOfSwing};
         
         //Final Result Ball
-        TrackerAdr<u32> ball_x_pos = TrackerAdr<u32>("Ball Landing Position - X", aAB_BallPos_X, 0xFFFFFFFF);
-        TrackerAdr<u32> ball_y_pos = TrackerAdr<u32>("Ball Landing Position - Y", aAB_BallPos_Y, 0xFFFFFFFF);
-        TrackerAdr<u32> ball_z_pos = TrackerAdr<u32>("Ball Landing Position - Z", aAB_BallPos_Z, 0xFFFFFFFF);
+        TrackerAdr<u32> ball_x_pos{TrackerFieldId::BallPosX};
+        TrackerAdr<u32> ball_y_pos{TrackerFieldId::BallPosY};
+        TrackerAdr<u32> ball_z_pos{TrackerFieldId::BallPosZ};
 
         //More ball flight info
-        TrackerAdr<u32> ball_max_height = TrackerAdr<u32>("Ball Max Height", 0x8089250c, 0xFFFFFFFF);
-        TrackerAdr<u16> ball_hang_time = TrackerAdr<u16>("Ball Hang Time", 0x80892696, 0xFFFF);
+        TrackerAdr<u32> ball_max_height{TrackerFieldId::BallMaxHeight};
+        TrackerAdr<u16> ball_hang_time{TrackerFieldId::BallHangTime};
 
         //0=Out
         //1=Foul
@@ -657,8 +578,8 @@ public:
         u32 ball_z_strike_vs_ball;
         u8 ball_in_strikezone;
 
-        TrackerAdr<u32> bat_contact_x_pos = TrackerAdr<u32>("Bat Contact Pos - X", aAB_BatContactPos_X, 0xFFFFFFFF);
-        TrackerAdr<u32> bat_contact_z_pos = TrackerAdr<u32>("Bat Contact Pos - Z", aAB_BatContactPos_Z, 0xFFFFFFFF);
+        TrackerAdr<u32> bat_contact_x_pos{TrackerFieldId::BatContactPosX};
+        TrackerAdr<u32> bat_contact_z_pos{TrackerFieldId::BatContactPosZ};
 
         //For integrosity - TODO
         u8 db = 0;
@@ -710,15 +631,27 @@ public:
         std::array<u8, cRosterSize> manual_select_locks;
 
         //Double play or more
-        TrackerAdr<u8> num_outs_during_play = TrackerAdr<u8>("Num Outs During Play", aAB_NumOutsDuringPlay, 0xFF);
+        TrackerAdr<u8> num_outs_during_play{TrackerFieldId::NumOutsDuringPlay};
 
         u8 rbi;
         u8 result_of_atbat;
 
         //Partial game. indicates this game has not been finished
-        std::pair<bool, bool> write_hud_ab = {true, true};
+        bool write_hud_a = true;
+        bool write_hud_b = true;
+
+        //Fixed size so the event stays plain data. Only used for logging, states past the end are dropped
+        struct History{
+            std::array<EVENT_STATE, 32> states;
+            u8 size = 0;
 
-        std::vector<EVENT_STATE> history;
+            void push_back(EVENT_STATE state){
+                if (size < states.size()) { states[size++] = state; }
+            }
+            const EVENT_STATE* begin() const { return states.data(); }
+            const EVENT_STATE* end() const { return states.data() + size; }
+        };
+        History history;
         std::string stringifyHistory() {
             std::string stringifiedHistory;
             for(EVENT_STATE i : history) {  
@@ -727,6 +660,8 @@ public:
             return stringifiedHistory;
         }
     };
+    //Events are copied and stored by value, keep them a flat record
+    static_assert(std::is_trivially_copyable_v<Event>, "Event must stay trivially copyable");
     
     struct GameInfo{
         u32 game_id;
@@ -750,6 +685,20 @@ public:
         int avg_ping = 0;
         int lag_spikes = 0;
 
+        //Pad buffer changes the netplay host made automatically, with what they had to cover
+        struct PadBufferDecision{
+            int event_num;
+            u32 buffer;
+            u32 previous_buffer;
+            u32 rtt_ms;
+            u32 jitter_ms;
+        };
+        std::vector<PadBufferDecision> pad_buffer_decisions;
+        //Netplay stalls and input timing over the whole game
+        NetPlay::TimingSummary netplay_timing;
+        //How pads got through when packets were lost, over the whole game
+        NetPlay::RedundantPadReceiver::Stats netplay_pad_transport;
+
         //Auto capture
         u16 away_score;
         u16 home_score;
@@ -780,8 +729,8 @@ public:
         //Array of both teams' character summaries
         std::array<std::array<CharacterSummary, cRosterSize>, cNumOfTeams> character_summaries;
 
-        //All of the events for this game
-        std::map<u16, Event> events;
+        //Events of this game that are not journaled yet. Preallocated, keyed by event number
+        EventArena<Event, cMaxEventsPerGame> events;
         std::optional<Event> previous_state;
         bool write_hud = true;
 
@@ -845,16 +794,16 @@ public:
         u8 prev_batter_roster_loc = 0xFF; //Used to check each pitch if the batter has changed.
                                           //Mark current positions when changed
 
-        void initTracker(const Core::CPUThreadGuard& guard, u8 inTeamId){
+        void initTracker(const Core::CPUThreadGuard& guard, TrackerSnapshot& snapshot, u8 inTeamId){
             team_id = inTeamId;
             initialized = true;
             for (u8 pos=0; pos < cRosterSize; ++pos){
                 u32 aFielderRosterLoc_calc = aFielder_RosterLoc + (pos * cFielder_Offset);
 
-                u8 roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielderRosterLoc_calc);
+                u8 roster_loc = snapshot.read<u8>(guard, aFielderRosterLoc_calc);
 
                 std::cout << "RosterLoc:" << std::to_string(roster_loc) 
-                          << " Init Pos=" << cPosition.at(pos) << std::endl;
+                          << " Init Pos=" << decodeName(DecodeType::Position, pos) << std::endl;
 
                 fielder_map[roster_loc].current_pos = pos;
                 fielder_map[roster_loc].previous_pos = pos;
@@ -868,18 +817,18 @@ public:
         }
         
         //Scans field to see who is playing which position and increments counts for positions
-        void evaluateFielders(const Core::CPUThreadGuard& guard) {
+        void evaluateFielders(const Core::CPUThreadGuard& guard, TrackerSnapshot& snapshot) {
             for (u8 pos=0; pos < cRosterSize; ++pos){
                 u32 aFielderRosterLoc_calc = aFielder_RosterLoc + (pos * cFielder_Offset);
 
-                u8 roster_loc = PowerPC::MMU::HostRead_U8(guard, aFielderRosterLoc_calc);
+                u8 roster_loc = snapshot.read<u8>(guard, aFielderRosterLoc_calc);
 
                 //If new position, mark changed (unless this is the first pitch of the AB (pos==0xFF))
                 //Then set new position
                 if (fielder_map[roster_loc].current_pos != pos){
                     std::cout << " Team=" << std::to_string(team_id) << " RosterLoc:" << std::to_string(roster_loc) 
-                                << " swapped from " << cPosition.at(fielder_map[roster_loc].current_pos)
-                                << " to " << cPosition.at(pos) << std::endl; 
+                                << " swapped from " << decodeName(DecodeType::Position, fielder_map[roster_loc].current_pos)
+                                << " to " << decodeName(DecodeType::Position, pos) << std::endl; 
                     fielder_map[roster_loc].current_pos = pos; 
                 }
 
@@ -968,12 +917,16 @@ public:
         //Reset state machines
         m_game_state  = GAME_STATE::PREGAME;
         m_event_state = EVENT_STATE::INIT_EVENT;
+
+        //A trace covers one game, the next frame starts a new one
+        m_trace_writer.close();
     }
 
     GAME_STATE  m_game_state  = GAME_STATE::PREGAME;
     GAME_STATE  m_game_state_prev = GAME_STATE::UNDEFINED;
     EVENT_STATE m_event_state = EVENT_STATE::INIT_EVENT;
     EVENT_STATE m_event_state_prev = EVENT_STATE::UNDEFINED;
+    bool m_pad_buffer_safe_point = false;
 
     struct state_members{
         bool m_netplay_session = false;
@@ -994,12 +947,28 @@ public:
     void setNetplaySession(bool netplay_session, std::string opponent_name = "");
     void setAvgPing(int avgPing);
     void setLagSpikes(int nLagSpikes);
+    void addPadBufferDecision(u32 buffer, u32 previous_buffer, u32 rtt_ms, u32 jitter_ms);
+    void setNetplayTiming(const NetPlay::TimingSummary& timing);
+    void setNetplayPadTransport(const NetPlay::RedundantPadReceiver::Stats& pad_transport);
+    //True once after each at-bat ends, the pad buffer can change then without anyone noticing
+    bool takePadBufferSafePoint();
     void setNetplayerUserInfo(std::map<int, LocalPlayers::LocalPlayers::Player> userInfo);
     void setGameID(u32 gameID);
     // void setTags(std::vector tags);
     // void setTagSet(int tagset);
 
     void Run(const Core::CPUThreadGuard& guard);
+    //Rollback NetPlay runs frames with predicted input and runs them again when the prediction
+    //was wrong. In place of Run, frames are captured as they run and only go through the tracker
+    //once the input they depend on is confirmed, so nothing is counted from a wrong prediction or
+    //counted twice. frame is the movie frame, input_frames the rollback frames begun
+    void captureFrame(const Core::CPUThreadGuard& guard, u64 frame, u64 input_frames);
+    //Runs the captured frames that only depend on the first confirmed_input_frames frames
+    void runConfirmedFrames(const Core::CPUThreadGuard& guard, u64 confirmed_input_frames);
+    //Runs a recorded trace through the tracker in place of guest memory. Stat files are written
+    //as usual but nothing is submitted. Returns the number of frames replayed, nothing if the
+    //trace can't be replayed or the tracker read memory the trace doesn't hold
+    std::optional<u64> replayTrace(const Core::CPUThreadGuard& guard, const std::string& path);
     void lookForTriggerEvents(const Core::CPUThreadGuard& guard);
 
     void logGameInfo(const Core::CPUThreadGuard& guard);
@@ -1037,17 +1006,58 @@ public:
         return out_float;
     }
 
-    Common::HttpRequest m_http{std::chrono::minutes{3}};
+    //Game submissions and ongoing game updates are posted from the uploader thread
+    StatUploader m_uploader;
+
+    //HUD files and the overlay stream are written from the publisher thread
+    StatHudPublisher m_hud_publisher;
 
-    //The type of value to decode, the value to be decoded, bool for decode if true or original value if false
-    std::string decode(std::string type, u8 value, bool decode);
+    //All tracker reads for the current frame are served from here
+    TrackerSnapshot m_snapshot;
+
+    //Memory trace of the current game, recorded when MAIN_STAT_TRACKER_RECORD_TRACE is set
+    StatTrackerTraceWriter m_trace_writer;
+    void recordTraceFrame(const Core::CPUThreadGuard& guard);
+    //Set while replayTrace runs. Nothing found in a trace is submitted or recorded again
+    bool m_replaying_trace = false;
+
+    //Frames captured under rollback that wait for their input to be confirmed, oldest first
+    struct CapturedFrame{
+        u64 frame;
+        u64 input_frames;
+        std::vector<std::vector<u8>> regions;
+    };
+    std::deque<CapturedFrame> m_captured_frames;
+    //Frames already run, their buffers are reused
+    std::vector<CapturedFrame> m_spare_frames;
+
+    //Finished events of the current game. GameInfo::events only holds the event in progress
+    StatEventJournal m_event_journal;
+    //Render the current event to the journal and drop it from GameInfo::events
+    void journalCurrentEvent();
+
+    //Reused for every document so buffers keep their size between games
+    StatJsonWriter m_json_writer;
+
+    //Every finished game also goes to the local archive, written from the archive thread
+    StatArchiveWriter m_archive_writer;
+    //Archive rows of the journaled events of the current game
+    std::vector<StatArchiveEvent> m_archive_events;
+    void archiveGame();
 
     //Returns JSON, PathToWriteTo
     std::string getStatJSON(bool inDecode, bool hide_riokey = true);
     std::string getEventJSON(u16 in_event_num, Event& in_event, bool inDecode);
-    std::string getHUDJSON(std::string in_event_num, Event& in_curr_event, std::optional<Event> in_prev_event, bool inDecode);
+    std::string getHUDJSON(std::string in_event_num, Event& in_curr_event, std::optional<Event>& in_prev_event, bool inDecode);
+    //Write the document to every target of json in a single pass
+    void writeStatJSON(StatJsonWriter& json);
+    //A single entry of "Events", without a trailing separator
+    void writeEventJSON(StatJsonWriter& json, u16 in_event_num, Event& in_event);
+    void writeHUDJSON(StatJsonWriter& json, std::string_view in_event_num, Event& in_curr_event, std::optional<Event>& in_prev_event);
     //Returns path to save json
     std::string getStatJsonPath(std::string prefix);
+    //Time of the current frame. A movie being played back counts from when it was recorded
+    std::time_t getFrameTime() const;
 
     void postOngoingGame(Event& in_event);
     void updateOngoingGame(Event& in_event);
@@ -1055,12 +1065,12 @@ public:
     std::pair<u8,u8> getBatterFielderPorts(const Core::CPUThreadGuard& guard){
         // These values are the actual port numbers
         // and are indexed into using the below u8s
-        std::array<u8, 2> ports = {PowerPC::MMU::HostRead_U8(guard, 0x800e874c), PowerPC::MMU::HostRead_U8(guard, 0x800e874d)};
+        std::array<u8, 2> ports = {m_snapshot.read<u8>(guard, aTeamPorts), m_snapshot.read<u8>(guard, aTeamPorts + 1)};
 
         // These registers will always be 0 or 1
         // and swap values each half inning
-        u32 BattingTeam = PowerPC::MMU::HostRead_U32(guard, 0x80892990);
-        u32 PitchingTeam = PowerPC::MMU::HostRead_U32(guard, 0x80892994);
+        u32 BattingTeam = m_snapshot.read<u32>(guard, 0x80892990);
+        u32 PitchingTeam = m_snapshot.read<u32>(guard, 0x80892994);
         
         u8 BattingPort = ports[BattingTeam];
         u8 FieldingPort = ports[PitchingTeam];
@@ -1087,26 +1097,23 @@ public:
     //If mid-game, dump game
     void dumpGame(const Core::CPUThreadGuard& guard){
         if (m_game_state == GAME_STATE::INGAME){
+            m_snapshot.invalidate();
             m_game_info.quitter_team = 2;
             logGameInfo(guard);
 
             //Remove current event, wasn't finished
-            auto it = m_game_info.events.find(m_game_info.event_num);
-            if ((&it != NULL) && (it != m_game_info.events.end()))
-            {
-              m_game_info.events.erase(it);
-            }
+            m_game_info.events.erase(m_game_info.event_num);
 
             //Game has ended. Write file but do not submit
-            std::string jsonPath = getStatJsonPath("crash.decode.");
-            std::string json = getStatJSON(true);
-            
-            File::WriteStringToFile(jsonPath, json);
-
-            jsonPath = getStatJsonPath("crash.");
-            json = getStatJSON(false, true);
-            
-            File::WriteStringToFile(jsonPath, json);
+            m_json_writer.reset();
+            const size_t decoded_json = m_json_writer.addTarget(true);
+            const size_t local_json = m_json_writer.addTarget(false, true);
+            writeStatJSON(m_json_writer);
+
+            File::WriteStringToFile(getStatJsonPath("crash.decode."), m_json_writer.view(decoded_json));
+            File::WriteStringToFile(getStatJsonPath("crash."), m_json_writer.view(local_json));
+            m_event_journal.discard();
+            m_archive_events.clear();
             init();
         }
     }
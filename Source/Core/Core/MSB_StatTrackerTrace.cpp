@@ -0,0 +1,297 @@
+#include "Core/MSB_StatTrackerTrace.h"
+
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+#include "Common/FileUtil.h"
+#include "Core/TrackerSnapshot.h"
+
+static constexpr std::string_view cTraceMagic = "RTRC";
+static constexpr u32 cTraceVersion = 1;
+
+//Unchanged gaps shorter than this are stored inside the surrounding run, which is smaller than
+//starting a new one
+static constexpr size_t cMinRunGap = 4;
+
+enum class TraceRecordType : u8{
+    Frame = 1,
+    Settings = 2,
+};
+
+static void appendU32(std::vector<u8>& out, u32 value)
+{
+    for (int i = 0; i < 4; ++i)
+        out.push_back(static_cast<u8>(value >> (i * 8)));
+}
+
+static void appendVarint(std::vector<u8>& out, u32 value)
+{
+    while (value >= 0x80){
+        out.push_back(static_cast<u8>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<u8>(value));
+}
+
+static void appendTagSetId(std::vector<u8>& out, const std::optional<int>& id)
+{
+    out.push_back(id.has_value());
+    appendU32(out, static_cast<u32>(id.value_or(0)));
+}
+
+bool StatTrackerTraceWriter::open(const std::string& path, const TrackerSnapshot& snapshot)
+{
+    close();
+    File::CreateFullPath(path);
+    if (!m_file.Open(path, "wb")){
+        std::cout << "StatTrackerTrace: Could not create " << path << "\n";
+        return false;
+    }
+
+    m_previous.clear();
+    m_settings.reset();
+    m_num_frames = 0;
+
+    m_record.clear();
+    m_record.insert(m_record.end(), cTraceMagic.begin(), cTraceMagic.end());
+    appendU32(m_record, cTraceVersion);
+    appendU32(m_record, static_cast<u32>(snapshot.getNumRegions()));
+    for (size_t i = 0; i < snapshot.getNumRegions(); ++i){
+        appendU32(m_record, snapshot.getRegionStart(i));
+        appendU32(m_record, snapshot.getRegionEnd(i));
+        m_previous.emplace_back(snapshot.getRegionEnd(i) - snapshot.getRegionStart(i), 0);
+    }
+    return writeRecord();
+}
+
+void StatTrackerTraceWriter::close()
+{
+    m_file.Close();
+}
+
+void StatTrackerTraceWriter::writeSettings(const StatTrackerTraceSettings& settings)
+{
+    if (!isOpen() || m_settings == settings)
+        return;
+    m_settings = settings;
+
+    m_record.clear();
+    m_record.push_back(static_cast<u8>(TraceRecordType::Settings));
+    m_record.push_back(settings.netplay);
+    appendVarint(m_record, static_cast<u32>(settings.opponent_alias.size()));
+    m_record.insert(m_record.end(), settings.opponent_alias.begin(), settings.opponent_alias.end());
+    appendTagSetId(m_record, settings.tag_set_id_local);
+    appendTagSetId(m_record, settings.tag_set_id_netplay);
+    writeRecord();
+}
+
+void StatTrackerTraceWriter::writeFrame(const TrackerSnapshot& snapshot)
+{
+    if (!isOpen())
+        return;
+
+    m_record.clear();
+    m_record.push_back(static_cast<u8>(TraceRecordType::Frame));
+    for (size_t i = 0; i < m_previous.size(); ++i){
+        const u8* current = snapshot.getRegionData(i).data();
+        u8* previous = m_previous[i].data();
+        const size_t size = m_previous[i].size();
+
+        size_t pos = 0;
+        size_t last_end = 0;
+        while (pos < size){
+            //Skip unchanged memory a word at a time
+            if (pos + 8 <= size && std::memcmp(current + pos, previous + pos, 8) == 0){
+                pos += 8;
+                continue;
+            }
+            if (current[pos] == previous[pos]){
+                ++pos;
+                continue;
+            }
+
+            size_t end = pos + 1;
+            for (size_t scan = end; scan < size && scan - end < cMinRunGap; ++scan){
+                if (current[scan] != previous[scan])
+                    end = scan + 1;
+            }
+
+            appendVarint(m_record, static_cast<u32>(pos - last_end));
+            appendVarint(m_record, static_cast<u32>(end - pos));
+            m_record.insert(m_record.end(), current + pos, current + end);
+            std::memcpy(previous + pos, current + pos, end - pos);
+            last_end = end;
+            pos = end;
+        }
+        appendVarint(m_record, 0);
+        appendVarint(m_record, 0);
+    }
+
+    if (writeRecord())
+        ++m_num_frames;
+}
+
+bool StatTrackerTraceWriter::writeRecord()
+{
+    if (m_file.WriteBytes(m_record.data(), m_record.size()))
+        return true;
+
+    std::cout << "StatTrackerTrace: Could not write trace, recording stopped\n";
+    close();
+    return false;
+}
+
+bool StatTrackerTraceReader::open(const std::string& path)
+{
+    m_data.clear();
+    m_pos = 0;
+    m_regions.clear();
+    m_settings = StatTrackerTraceSettings();
+    m_num_frames = 0;
+
+    File::IOFile file(path, "rb");
+    if (!file.IsOpen()){
+        std::cout << "StatTrackerTrace: Could not open " << path << "\n";
+        return false;
+    }
+    m_data.resize(static_cast<size_t>(file.GetSize()));
+    if (!file.ReadBytes(m_data.data(), m_data.size())){
+        std::cout << "StatTrackerTrace: Could not read " << path << "\n";
+        return false;
+    }
+
+    u32 version;
+    u32 num_regions;
+    if (m_data.size() < cTraceMagic.size() ||
+        std::memcmp(m_data.data(), cTraceMagic.data(), cTraceMagic.size()) != 0){
+        std::cout << "StatTrackerTrace: " << path << " is not a stat tracker trace\n";
+        return false;
+    }
+    m_pos = cTraceMagic.size();
+    if (!readU32(version) || version != cTraceVersion || !readU32(num_regions)){
+        std::cout << "StatTrackerTrace: Unsupported trace version in " << path << "\n";
+        return false;
+    }
+
+    for (u32 i = 0; i < num_regions; ++i){
+        Region region;
+        if (!readU32(region.start) || !readU32(region.end) || region.end <= region.start){
+            std::cout << "StatTrackerTrace: Bad header in " << path << "\n";
+            return false;
+        }
+        m_regions.push_back(region);
+    }
+    return true;
+}
+
+bool StatTrackerTraceReader::matches(const TrackerSnapshot& snapshot) const
+{
+    if (snapshot.getNumRegions() != m_regions.size())
+        return false;
+    for (size_t i = 0; i < m_regions.size(); ++i){
+        if (snapshot.getRegionStart(i) != m_regions[i].start || snapshot.getRegionEnd(i) != m_regions[i].end)
+            return false;
+    }
+    return true;
+}
+
+StatTrackerTraceReader::Record StatTrackerTraceReader::next(TrackerSnapshot& snapshot)
+{
+    u8 type;
+    if (!readU8(type))
+        return Record::End;
+
+    //Only complete records change anything, a record cut short by a crash ends the trace
+    const size_t record_start = m_pos - 1;
+    switch (static_cast<TraceRecordType>(type)){
+        case TraceRecordType::Frame:{
+            //Validate first so a torn frame is not half applied
+            for (int pass = 0; pass < 2; ++pass){
+                m_pos = record_start + 1;
+                for (size_t i = 0; i < m_regions.size(); ++i){
+                    const u32 size = m_regions[i].end - m_regions[i].start;
+                    u8* data = snapshot.getReplayData(i);
+                    u32 pos = 0;
+                    while (true){
+                        u32 skip, length;
+                        if (!readVarint(skip) || !readVarint(length))
+                            return Record::End;
+                        if (length == 0)
+                            break;
+                        if (skip > size - pos || length > size - pos - skip)
+                            return Record::Error;
+                        if (length > m_data.size() - m_pos)
+                            return Record::End;
+                        pos += skip;
+                        if (pass == 1)
+                            std::memcpy(data + pos, &m_data[m_pos], length);
+                        pos += length;
+                        m_pos += length;
+                    }
+                }
+            }
+            ++m_num_frames;
+            return Record::Frame;
+        }
+        case TraceRecordType::Settings:{
+            StatTrackerTraceSettings settings;
+            u8 netplay;
+            u32 alias_length;
+            if (!readU8(netplay) || !readVarint(alias_length) || alias_length > m_data.size() - m_pos)
+                return Record::End;
+            settings.netplay = netplay != 0;
+            settings.opponent_alias.assign(reinterpret_cast<const char*>(&m_data[m_pos]), alias_length);
+            m_pos += alias_length;
+            if (!readTagSetId(settings.tag_set_id_local) || !readTagSetId(settings.tag_set_id_netplay))
+                return Record::End;
+            m_settings = std::move(settings);
+            return Record::Settings;
+        }
+        default:
+            std::cout << "StatTrackerTrace: Unknown record type " << static_cast<int>(type) << "\n";
+            return Record::Error;
+    }
+}
+
+bool StatTrackerTraceReader::readU8(u8& value)
+{
+    if (m_pos >= m_data.size())
+        return false;
+    value = m_data[m_pos++];
+    return true;
+}
+
+bool StatTrackerTraceReader::readU32(u32& value)
+{
+    if (m_data.size() - m_pos < 4)
+        return false;
+    value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= static_cast<u32>(m_data[m_pos++]) << (i * 8);
+    return true;
+}
+
+bool StatTrackerTraceReader::readVarint(u32& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7){
+        u8 byte;
+        if (!readU8(byte))
+            return false;
+        value |= static_cast<u32>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool StatTrackerTraceReader::readTagSetId(std::optional<int>& id)
+{
+    u8 present;
+    u32 value;
+    if (!readU8(present) || !readU32(value))
+        return false;
+    id = present ? std::make_optional(static_cast<int>(value)) : std::nullopt;
+    return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+class TrackerSnapshot;
+
+// Recording of the guest memory the StatTracker reads, one record per frame, so a game can be run
+// through the tracker again without the emulator.
+//
+// Layout (little endian):
+//   Header:   "RTRC", u32 version, u32 region count, then u32 start and u32 end for each region
+//   Frame:    u8 type, then for every region the bytes that changed since the previous frame as
+//             (varint offset from the end of the last run, varint length, bytes) runs, closed by a
+//             run of length 0. The first frame is stored against all zeroes
+//   Settings: u8 type, u8 netplay, varint length and opponent alias, then the local and netplay
+//             tag set ids (u8 present, s32 id). Written whenever they change
+// A frame is a few bytes when nothing moved and a few hundred during play, so a full game is a
+// few MB. A trace cut short by a crash is readable up to its last complete record.
+
+//Tracker state that does not come from guest memory
+struct StatTrackerTraceSettings{
+    bool netplay = false;
+    std::string opponent_alias;
+    std::optional<int> tag_set_id_local;
+    std::optional<int> tag_set_id_netplay;
+
+    bool operator==(const StatTrackerTraceSettings& other) const{
+        return netplay == other.netplay && opponent_alias == other.opponent_alias &&
+               tag_set_id_local == other.tag_set_id_local && tag_set_id_netplay == other.tag_set_id_netplay;
+    }
+};
+
+class StatTrackerTraceWriter{
+public:
+    //Creates path and writes the header for the regions of snapshot
+    bool open(const std::string& path, const TrackerSnapshot& snapshot);
+    void close();
+    bool isOpen() const { return m_file.IsOpen(); }
+
+    //Writes a settings record if they differ from the last ones written
+    void writeSettings(const StatTrackerTraceSettings& settings);
+    //Writes the regions of snapshot as changed since the last frame. Call after captureAll
+    void writeFrame(const TrackerSnapshot& snapshot);
+
+    u64 getNumFrames() const { return m_num_frames; }
+
+private:
+    bool writeRecord();
+
+    File::IOFile m_file;
+    std::vector<std::vector<u8>> m_previous;
+    std::optional<StatTrackerTraceSettings> m_settings;
+    u64 m_num_frames = 0;
+
+    //Reused for every record
+    std::vector<u8> m_record;
+};
+
+class StatTrackerTraceReader{
+public:
+    enum class Record{
+        Frame,
+        Settings,
+        End,
+        Error
+    };
+
+    //Loads the whole trace into memory
+    bool open(const std::string& path);
+
+    //True if the trace was recorded with the same regions snapshot has
+    bool matches(const TrackerSnapshot& snapshot) const;
+
+    //Reads the next record. Frames are applied to the replay data of snapshot, settings are
+    //available from getSettings
+    Record next(TrackerSnapshot& snapshot);
+
+    const StatTrackerTraceSettings& getSettings() const { return m_settings; }
+    u64 getNumFrames() const { return m_num_frames; }
+
+private:
+    struct Region{
+        u32 start;
+        u32 end;
+    };
+
+    bool readU8(u8& value);
+    bool readU32(u32& value);
+    bool readVarint(u32& value);
+    bool readTagSetId(std::optional<int>& id);
+
+    std::vector<u8> m_data;
+    size_t m_pos = 0;
+    std::vector<Region> m_regions;
+    StatTrackerTraceSettings m_settings;
+    u64 m_num_frames = 0;
+};
@@ -0,0 +1,195 @@
+#include "Core/MSB_StatUploader.h"
+
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+
+#include <fmt/format.h>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+
+#include "VideoCommon/OnScreenDisplay.h"
+
+StatUploader::StatUploader()
+    : StatUploader(File::GetUserPath(D_STATOUTBOX_IDX), cRioApiUrl)
+{
+}
+
+StatUploader::StatUploader(std::string outbox_dir, std::string base_url, PostFunction post,
+                           RetryPolicy retry_policy)
+    : m_outbox_dir(std::move(outbox_dir)), m_base_url(std::move(base_url)), m_post(std::move(post)),
+      m_retry_policy(retry_policy)
+{
+    File::CreateFullPath(m_outbox_dir);
+    m_worker.Reset("Stat Uploader", [this](Upload upload) { processUpload(std::move(upload)); });
+}
+
+StatUploader::~StatUploader()
+{
+    shutdown();
+}
+
+void StatUploader::submitGame(std::string json)
+{
+    Upload upload;
+    upload.endpoint = cRioApiEndpoint_Game;
+    upload.payload = std::move(json);
+    upload.persist = true;
+    m_worker.Push(std::move(upload));
+}
+
+void StatUploader::submitOngoingGame(std::string json)
+{
+    Upload upload;
+    upload.endpoint = cRioApiEndpoint_OngoingGame;
+    upload.payload = std::move(json);
+    m_worker.Push(std::move(upload));
+}
+
+void StatUploader::waitForIdle()
+{
+    m_worker.WaitForCompletion();
+}
+
+void StatUploader::shutdown()
+{
+    m_shutting_down = true;
+    m_shutdown_event.Set();
+    m_worker.Shutdown();
+}
+
+void StatUploader::resendOutbox()
+{
+    if (m_outbox_resent.exchange(true))
+        return;
+
+    std::vector<std::string> paths = Common::DoFileSearch({m_outbox_dir}, {".json"});
+    //File names start with the submission time, keep the original order
+    std::sort(paths.begin(), paths.end());
+
+    for (std::string& path : paths){
+        Upload upload;
+        if (!File::ReadFileToString(path, upload.payload))
+            continue;
+        upload.endpoint = cRioApiEndpoint_Game;
+        upload.persist = true;
+        upload.outbox_path = std::move(path);
+        std::cout << "StatUploader: Resending " << upload.outbox_path << "\n";
+        m_worker.Push(std::move(upload));
+    }
+}
+
+bool StatUploader::writeToOutbox(Upload& upload)
+{
+    const std::string path = fmt::format("{}{:020}_{:04}.json", m_outbox_dir,
+                                         static_cast<u64>(std::time(nullptr)), m_outbox_counter++);
+
+    //Write then rename so a crash mid-write never leaves a truncated game in the outbox
+    const std::string temp_path = File::GetTempFilenameForAtomicWrite(path);
+    if (!File::WriteStringToFile(temp_path, upload.payload) || !File::RenameSync(temp_path, path)){
+        std::cout << "StatUploader: Could not write " << path << " to outbox\n";
+        File::Delete(temp_path);
+        return false;
+    }
+
+    upload.outbox_path = path;
+    return true;
+}
+
+void StatUploader::processUpload(Upload upload)
+{
+    if (upload.persist && upload.outbox_path.empty())
+        writeToOutbox(upload);
+
+    //Games are safe in the outbox, leave them for the next session instead of holding up exit
+    if (m_shutting_down)
+        return;
+
+    const std::string url = m_base_url + upload.endpoint;
+    const int max_attempts = upload.persist ? m_retry_policy.max_attempts : 1;
+    std::chrono::milliseconds backoff = m_retry_policy.initial_backoff;
+
+    for (int attempt = 1; attempt <= max_attempts; ++attempt){
+        const PostResult result = post(url, upload.payload);
+        if (result == PostResult::Accepted){
+            ++m_uploaded_count;
+            if (!upload.outbox_path.empty())
+                File::Delete(upload.outbox_path);
+
+            if (upload.persist){
+                OSD::AddTypedMessage(OSD::MessageType::GameStateInfo, "Done submitting game", 5000,
+                                     OSD::Color::GREEN);
+            }
+            return;
+        }
+
+        if (result == PostResult::Rejected){
+            ++m_failed_count;
+            quarantine(upload);
+            return;
+        }
+
+        std::cout << "StatUploader: " << url << " failed (attempt " << attempt << "/"
+                  << max_attempts << ")\n";
+
+        if (attempt == max_attempts)
+            break;
+
+        //Returns early if we are asked to shut down
+        if (m_shutdown_event.WaitFor(backoff))
+            return;
+        backoff = std::min(backoff * 2, m_retry_policy.max_backoff);
+    }
+
+    ++m_failed_count;
+    if (upload.persist){
+        OSD::AddTypedMessage(OSD::MessageType::GameStateInfo,
+                             "Could not submit game. It will be resent next time Rio starts",
+                             5000, OSD::Color::RED);
+    }
+}
+
+void StatUploader::quarantine(const Upload& upload)
+{
+    if (!upload.persist)
+        return;
+
+    //Keep the game around for a bug report but out of the outbox so it is never resent
+    if (!upload.outbox_path.empty()){
+        const std::string rejected_dir = m_outbox_dir + cStatOutboxRejectedDir;
+        const std::string file_name =
+            upload.outbox_path.substr(upload.outbox_path.find_last_of('/') + 1);
+        File::CreateFullPath(rejected_dir);
+        if (!File::Rename(upload.outbox_path, rejected_dir + file_name))
+            File::Delete(upload.outbox_path);
+    }
+
+    OSD::AddTypedMessage(OSD::MessageType::GameStateInfo,
+                         "Game was rejected by the server and will not be resent", 5000,
+                         OSD::Color::RED);
+}
+
+StatUploader::PostResult StatUploader::post(const std::string& url, const std::string& payload)
+{
+    s32 status = 0;
+    if (m_post){
+        status = m_post(url, payload);
+    }
+    else{
+        //Ask for every status so a 4xx can be told apart from the server being unreachable
+        const Common::HttpRequest::Response response =
+            m_http.Post(url, payload, {{"Content-Type", "application/json"}},
+                        Common::HttpRequest::AllowedReturnCodes::All);
+        if (response)
+            status = m_http.GetLastResponseCode();
+    }
+
+    if (status >= 200 && status < 300)
+        return PostResult::Accepted;
+
+    std::cout << "StatUploader: " << url << " returned " << status << "\n";
+    if (status >= 400 && status < 500)
+        return PostResult::Rejected;
+    return PostResult::Failed;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "Common/Event.h"
+#include "Common/HttpRequest.h"
+#include "Common/WorkQueueThread.h"
+
+static const std::string cRioApiUrl = "https://api.projectrio.app/";
+static const std::string cRioApiEndpoint_Game = "populate_db/";
+static const std::string cRioApiEndpoint_OngoingGame = "populate_db/ongoing_game/";
+//Games the server refused are moved here instead of being resent forever
+static const std::string cStatOutboxRejectedDir = "Rejected/";
+
+struct StatUploadRetryPolicy{
+    int max_attempts = 5;
+    std::chrono::milliseconds initial_backoff = std::chrono::seconds(2);
+    std::chrono::milliseconds max_backoff = std::chrono::minutes(1);
+};
+
+// Sends StatTracker JSON to the Rio API on a background thread so the CPU thread only ever
+// queues a finished buffer. Finished games go through an on-disk outbox and are only removed
+// once the server accepts them; whatever is left over is resent the next time Rio starts.
+// Games the server refuses with a 4xx are moved out of the outbox instead of being retried.
+class StatUploader{
+public:
+    //Returns the HTTP status code, or 0 if the server could not be reached.
+    //Tests swap this for a local stand-in
+    using PostFunction = std::function<s32(const std::string& url, const std::string& payload)>;
+
+    using RetryPolicy = StatUploadRetryPolicy;
+
+    StatUploader();
+    StatUploader(std::string outbox_dir, std::string base_url, PostFunction post = nullptr,
+                 RetryPolicy retry_policy = RetryPolicy());
+    ~StatUploader();
+
+    StatUploader(const StatUploader&) = delete;
+    StatUploader& operator=(const StatUploader&) = delete;
+
+    //Finished game. Persisted to the outbox before the first attempt
+    void submitGame(std::string json);
+    //Ongoing game updates are best effort. Dropped if the first attempt fails
+    void submitOngoingGame(std::string json);
+    //Queues the games a previous session could not deliver. Only the first call does anything,
+    //and only the emulation session calls it so tool and replay trackers leave the outbox alone
+    void resendOutbox();
+
+    //Blocks until every queued upload has been sent or parked in the outbox
+    void waitForIdle();
+    //Stops retrying, parks unsent games in the outbox and joins the worker
+    void shutdown();
+
+    u32 getUploadedCount() const { return m_uploaded_count.load(); }
+    u32 getFailedCount() const { return m_failed_count.load(); }
+
+private:
+    struct Upload{
+        std::string endpoint;
+        std::string payload;
+        bool persist = false;
+        std::string outbox_path; //Empty until written to the outbox
+    };
+
+    enum class PostResult{
+        Accepted,
+        Rejected, //4xx, sending it again will not help
+        Failed,   //Transport error or 5xx, worth retrying
+    };
+
+    void processUpload(Upload upload);
+    bool writeToOutbox(Upload& upload);
+    void quarantine(const Upload& upload);
+    PostResult post(const std::string& url, const std::string& payload);
+
+    std::string m_outbox_dir;
+    std::string m_base_url;
+    PostFunction m_post;
+    RetryPolicy m_retry_policy;
+
+    //Only touched from the worker thread
+    Common::HttpRequest m_http{std::chrono::minutes{3}};
+    u64 m_outbox_counter = 0;
+
+    Common::Event m_shutdown_event;
+    std::atomic<bool> m_shutting_down{false};
+    std::atomic<bool> m_outbox_resent{false};
+    std::atomic<u32> m_uploaded_count{0};
+    std::atomic<u32> m_failed_count{0};
+
+    //Declared last so the worker is joined before the members it uses are destroyed
+    Common::WorkQueueThread<Upload> m_worker;
+};
@@ -3,33 +3,75 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <fcntl.h>
 #include <fstream>
-#include <iostream>
+#include <iterator>
+#include <new>
+#include <numeric>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
+#include <utility>
+
+#include <fmt/format.h>
 
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
 
+namespace
+{
+constexpr char RING_MAGIC[4] = {'M', 'W', 'R', 'G'};
+constexpr u32 RING_VERSION = 1;
+constexpr size_t RING_HEADER_SIZE = 64;
+
+struct RingHeader
+{
+  char magic[4];
+  u32 version;
+  u32 capacity;
+  u32 reserved;
+  std::atomic<u64> write_pos;
+};
+static_assert(sizeof(RingHeader) <= RING_HEADER_SIZE);
+static_assert(std::atomic<u64>::is_always_lock_free);
+}  // namespace
+
 MemoryWatcher::MemoryWatcher()
+    : MemoryWatcher(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX),
+                    File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX),
+                    Options{Config::Get(Config::MAIN_MEMORY_WATCHER_BINARY),
+                            Config::Get(Config::MAIN_MEMORY_WATCHER_RING) ?
+                                File::GetUserPath(F_MEMORYWATCHERRING_IDX) :
+                                std::string(),
+                            static_cast<u32>(Config::Get(Config::MAIN_MEMORY_WATCHER_RING_SIZE))})
 {
-  m_running = false;
-  if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
+}
+
+MemoryWatcher::MemoryWatcher(const std::string& locations_path, const std::string& socket_path,
+                             const Options& options)
+    : m_binary(options.binary)
+{
+  if (!LoadAddresses(locations_path))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  if (!OpenSocket(socket_path))
     return;
+  if (!options.ring_path.empty() && !OpenRing(options.ring_path, options.ring_capacity))
+    WARN_LOG_FMT(CORE, "MemoryWatcher: Could not create ring {}", options.ring_path);
   m_running = true;
 }
 
 MemoryWatcher::~MemoryWatcher()
 {
-  if (!m_running)
-    return;
-
+  CloseRing();
+  if (m_fd >= 0)
+    close(m_fd);
   m_running = false;
-  close(m_fd);
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -43,19 +85,52 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return !m_values.empty();
+  std::vector<u32> sorted(m_labels.size());
+  std::iota(sorted.begin(), sorted.end(), 0);
+  std::sort(sorted.begin(), sorted.end(),
+            [this](u32 a, u32 b) { return m_labels[a] < m_labels[b]; });
+  m_text_rank.resize(sorted.size());
+  for (u32 rank = 0; rank < sorted.size(); ++rank)
+    m_text_rank[sorted[rank]] = rank;
+
+  return !m_watch_nodes.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
-
-  std::istringstream offsets(line);
-  offsets >> std::hex;
+  std::vector<u32> offsets;
+  std::istringstream stream(line);
+  stream >> std::hex;
   u32 offset;
-  while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+  while (stream >> offset)
+    offsets.push_back(offset);
+
+  if (offsets.empty() ||
+      std::find(m_labels.begin(), m_labels.end(), line) != m_labels.end())
+  {
+    return;
+  }
+
+  // Reuse the nodes of any chain that starts the same way
+  s32 parent = -1;
+  for (u32 chain_offset : offsets)
+  {
+    auto node = std::find_if(m_nodes.begin(), m_nodes.end(), [&](const ChainNode& n) {
+      return n.parent == parent && n.offset == chain_offset;
+    });
+    if (node == m_nodes.end())
+    {
+      if (parent >= 0)
+        m_nodes[parent].has_children = true;
+      m_nodes.push_back(ChainNode{parent, chain_offset, false, 0, false});
+      node = std::prev(m_nodes.end());
+    }
+    parent = static_cast<s32>(std::distance(m_nodes.begin(), node));
+  }
+
+  m_labels.push_back(line);
+  m_watch_nodes.push_back(static_cast<u32>(parent));
+  m_values.push_back(0);
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,38 +142,126 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
+bool MemoryWatcher::OpenRing(const std::string& path, u32 capacity)
 {
-  u32 value = 0;
-  for (u32 offset : m_addresses[line])
-  {
-    value = PowerPC::MMU::HostRead_U32(guard, value + offset);
-    if (!PowerPC::MMU::HostIsRAMAddress(guard, value))
-      break;
-  }
-  return value;
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return false;
+
+  const size_t size = RING_HEADER_SIZE + capacity;
+  void* const mapping = ftruncate(fd, static_cast<off_t>(size)) == 0 ?
+                            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) :
+                            MAP_FAILED;
+  close(fd);
+  if (mapping == MAP_FAILED)
+    return false;
+
+  m_ring = static_cast<u8*>(mapping);
+  m_ring_size = size;
+
+  RingHeader* header = new (m_ring) RingHeader;
+  std::memcpy(header->magic, RING_MAGIC, sizeof(RING_MAGIC));
+  header->version = RING_VERSION;
+  header->capacity = capacity;
+  header->reserved = 0;
+  header->write_pos.store(0, std::memory_order_release);
+  return true;
 }
 
-std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
+void MemoryWatcher::CloseRing()
 {
-  std::ostringstream message_stream;
-  message_stream << std::hex;
+  if (!m_ring)
+    return;
 
-  for (auto& entry : m_values)
+  munmap(m_ring, m_ring_size);
+  m_ring = nullptr;
+  m_ring_size = 0;
+}
+
+void MemoryWatcher::ReadChains(const Core::CPUThreadGuard& guard)
+{
+  // Parents always come before their children
+  for (ChainNode& node : m_nodes)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    if (node.parent < 0)
+    {
+      node.value = PowerPC::MMU::HostRead_U32(guard, node.offset);
+    }
+    else
+    {
+      const ChainNode& parent = m_nodes[node.parent];
+      // The chain stopped at a value that isn't a pointer, which is what gets reported
+      if (!parent.is_pointer)
+      {
+        node.value = parent.value;
+        node.is_pointer = false;
+        continue;
+      }
+      node.value = PowerPC::MMU::HostRead_U32(guard, parent.value + node.offset);
+    }
+
+    if (node.has_children)
+      node.is_pointer = PowerPC::MMU::HostIsRAMAddress(guard, node.value);
+  }
 
-    u32 new_value = ChasePointer(guard, address);
-    if (new_value != current_value)
+  m_changed.clear();
+  for (u32 i = 0; i < m_watch_nodes.size(); ++i)
+  {
+    const u32 new_value = m_nodes[m_watch_nodes[i]].value;
+    if (new_value != m_values[i])
     {
-      // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      m_values[i] = new_value;
+      m_changed.push_back(i);
     }
   }
+}
+
+void MemoryWatcher::ComposeText()
+{
+  // Sorted like the std::map the text format used to be written from, readers may rely on it
+  m_text_changed.assign(m_changed.begin(), m_changed.end());
+  std::sort(m_text_changed.begin(), m_text_changed.end(),
+            [this](u32 a, u32 b) { return m_text_rank[a] < m_text_rank[b]; });
+
+  m_text.clear();
+  for (u32 index : m_text_changed)
+    fmt::format_to(std::back_inserter(m_text), "{}\n{:x}\n", m_labels[index], m_values[index]);
+}
+
+void MemoryWatcher::ComposePacket()
+{
+  m_packet.clear();
+  m_packet.push_back(m_frame);
+  m_packet.push_back(static_cast<u32>(m_changed.size()));
+  for (u32 index : m_changed)
+  {
+    m_packet.push_back(index);
+    m_packet.push_back(m_values[index]);
+  }
+}
+
+void MemoryWatcher::WriteRing()
+{
+  RingHeader* header = reinterpret_cast<RingHeader*>(m_ring);
+  u8* const data = m_ring + RING_HEADER_SIZE;
+  const u32 capacity = header->capacity;
+
+  const u32 length = static_cast<u32>(m_packet.size() * sizeof(u32));
+  if (length + sizeof(length) > capacity)
+    return;
+
+  u64 pos = header->write_pos.load(std::memory_order_relaxed);
+  const auto write = [&](const void* source, size_t size) {
+    const size_t offset = pos % capacity;
+    const size_t first = std::min<size_t>(size, capacity - offset);
+    std::memcpy(data + offset, source, first);
+    std::memcpy(data, static_cast<const u8*>(source) + first, size - first);
+    pos += size;
+  };
+  write(&length, sizeof(length));
+  write(m_packet.data(), length);
 
-  return message_stream.str();
+  header->write_pos.store(pos, std::memory_order_release);
 }
 
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
@@ -106,7 +269,25 @@ void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
   if (!m_running)
     return;
 
-  std::string message = ComposeMessages(guard);
-  sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
-         sizeof(m_addr));
+  ++m_frame;
+  ReadChains(guard);
+
+  if (!m_binary)
+  {
+    ComposeText();
+    sendto(m_fd, m_text.c_str(), m_text.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
+           sizeof(m_addr));
+  }
+
+  if (m_changed.empty() || (!m_binary && !m_ring))
+    return;
+
+  ComposePacket();
+  if (m_binary)
+  {
+    sendto(m_fd, m_packet.data(), m_packet.size() * sizeof(u32), 0,
+           reinterpret_cast<sockaddr*>(&m_addr), sizeof(m_addr));
+  }
+  if (m_ring)
+    WriteRing();
 }
@@ -5,7 +5,6 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -22,30 +21,95 @@ class CPUThreadGuard;
 // The input file is a newline-separated list of hex memory addresses, without
 // the "0x". To follow pointers, separate addresses with a space. For example,
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
-// The output to the socket is two lines. The first is the address from the
-// input file, and the second is the new value in hex.
+//
+// In the text format, each frame sends one datagram. For every changed address it
+// holds two lines: the address from the input file, and the new value in hex. The
+// addresses are sorted as strings, not in file order.
+//
+// In the binary format, a datagram is only sent on frames where something changed.
+// It is a sequence of little endian u32s: the frame number, the number of changed
+// addresses, then an (index, value) pair for each of them. The index is the line
+// of the address in the input file, counting unique addresses from 0.
+//
+// Optionally every binary packet is also appended to a ring in a memory mapped
+// file, so readers don't need a socket. The ring starts with a 64 byte header:
+// "MWRG", u32 version, u32 capacity in bytes, u32 reserved, then a u64 count of
+// bytes ever written, stored after the data it covers. Each record is a u32 length
+// followed by a binary packet, wrapping around at the end of the data area which
+// follows the header. Readers keep their own position and have fallen behind if
+// the write count is more than the capacity ahead of it.
 class MemoryWatcher final
 {
 public:
+  struct Options
+  {
+    bool binary;
+    // Path of the ring file, empty for none
+    std::string ring_path;
+    u32 ring_capacity;
+  };
+
   MemoryWatcher();
+  MemoryWatcher(const std::string& locations_path, const std::string& socket_path,
+                const Options& options);
   ~MemoryWatcher();
+
+  MemoryWatcher(const MemoryWatcher&) = delete;
+  MemoryWatcher& operator=(const MemoryWatcher&) = delete;
+
   void Step(const Core::CPUThreadGuard& guard);
 
+  bool IsRunning() const { return m_running; }
+  size_t GetNumWatches() const { return m_watch_nodes.size(); }
+  // Number of distinct pointer chain steps read every frame
+  size_t GetNumReads() const { return m_nodes.size(); }
+
 private:
+  // One step of a pointer chain. Chains with the same prefix share their nodes,
+  // so every distinct prefix is read once per frame.
+  struct ChainNode
+  {
+    s32 parent;
+    u32 offset;
+    bool has_children;
+
+    // Updated every frame
+    u32 value;
+    bool is_pointer;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenRing(const std::string& path, u32 capacity);
+  void CloseRing();
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
-  std::string ComposeMessages(const Core::CPUThreadGuard& guard);
+  void ReadChains(const Core::CPUThreadGuard& guard);
+  void ComposeText();
+  void ComposePacket();
+  void WriteRing();
 
   bool m_running = false;
+  bool m_binary = false;
+  u32 m_frame = 0;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  std::vector<ChainNode> m_nodes;
+  // Per watch, in file order
+  std::vector<std::string> m_labels;
+  std::vector<u32> m_watch_nodes;
+  std::vector<u32> m_values;
+  std::vector<u32> m_changed;
+  // Position of each watch when sorted by label, the order of the text format
+  std::vector<u32> m_text_rank;
+
+  // Reused every frame
+  std::string m_text;
+  std::vector<u32> m_text_changed;
+  std::vector<u32> m_packet;
+
+  u8* m_ring = nullptr;
+  size_t m_ring_size = 0;
 };
@@ -9,6 +9,7 @@
 #include <cstring>
 #include <iterator>
 #include <locale>
+#include <memory>
 #include <mbedtls/config.h>
 #include <mbedtls/md.h>
 #include <mutex>
@@ -52,6 +53,7 @@
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_Device.h"
+#include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/HW/WiimoteCommon/DataReport.h"
 #include "Core/HW/WiimoteCommon/WiimoteReport.h"
@@ -63,6 +65,7 @@
 
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
+#include "Core/MovieStream.h"
 #include "Core/NetPlayProto.h"
 #include "Core/State.h"
 #include "Core/System.h"
@@ -78,6 +81,9 @@
 // The chunk to allocate movie data in multiples of.
 #define DTM_BASE_LENGTH (1024)
 
+// Frames between two writes of the recording to disk
+constexpr u64 STREAM_APPEND_INTERVAL = 60;
+
 namespace Movie
 {
 using namespace WiimoteCommon;
@@ -117,6 +123,18 @@ static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
   return revision_bytes;
 }
 
+// Where the recording is written while it is recorded, the one before it is kept so it survives
+// restarting after a crash
+static std::string GetStreamPath()
+{
+  return File::GetUserPath(D_STATESAVES_IDX) + "recording.dtm";
+}
+
+static std::string GetLastStreamPath()
+{
+  return File::GetUserPath(D_STATESAVES_IDX) + "lastRecording.dtm";
+}
+
 MovieManager::MovieManager(Core::System& system) : m_system(system)
 {
 }
@@ -192,11 +210,107 @@ void MovieManager::FrameUpdate()
   {
     m_total_frames = m_current_frame;
     m_total_lag_count = m_current_lag_count;
+    UpdateStream();
+  }
+  else
+  {
+    StopStream();
+  }
+
+  if (m_seek_target && m_current_frame >= *m_seek_target)
+  {
+    m_seek_target.reset();
+    Core::SetIsThrottlerTempDisabled(false);
+    m_system.GetCPU().Break();
+    Core::DisplayMessage(fmt::format("Reached frame {}", m_current_frame), 2000);
   }
 
   m_polled = false;
 }
 
+// NOTE: CPU Thread
+void MovieManager::UpdateStream()
+{
+  if (!m_stream_writer)
+    m_stream_writer = std::make_unique<DTMStreamWriter>();
+
+  // Input after the current byte is from before a savestate was loaded and gets recorded over
+  const u64 recorded_bytes = std::min<u64>(m_current_byte, m_temp_input.size());
+  const std::span<const u8> recorded_input(m_temp_input.data(), recorded_bytes);
+  const std::string path = GetStreamPath();
+  if (!m_stream_writer->IsActive())
+  {
+    m_stream_writer->Flush();
+    const std::string last_path = GetLastStreamPath();
+    File::Delete(GetKeyframePath(last_path), File::IfAbsentBehavior::NoConsoleWarning);
+    if (File::Exists(path))
+      File::Rename(path, last_path);
+    if (File::Exists(GetKeyframePath(path)))
+      File::Rename(GetKeyframePath(path), GetKeyframePath(last_path));
+
+    m_stream_writer->Start(path, CreateHeader(), recorded_input);
+    m_streamed_bytes = recorded_bytes;
+  }
+  else if (recorded_bytes < m_streamed_bytes)
+  {
+    // A savestate took the recording back, so is the file
+    m_stream_writer->Start(path, CreateHeader(), recorded_input, m_current_frame);
+    m_streamed_bytes = recorded_bytes;
+  }
+  else if (m_current_frame % STREAM_APPEND_INTERVAL == 0)
+  {
+    m_stream_writer->Append(CreateHeader(), recorded_input.subspan(m_streamed_bytes));
+    m_streamed_bytes = recorded_bytes;
+  }
+
+  const u32 keyframe_seconds = Config::Get(Config::MAIN_MOVIE_KEYFRAME_SECONDS);
+  const u64 keyframe_interval = static_cast<u64>(
+      keyframe_seconds * m_system.GetVideoInterface().GetTargetRefreshRate());
+  if (keyframe_interval == 0 || m_current_frame % keyframe_interval != 0 ||
+      m_keyframe_capture_pending.exchange(true))
+  {
+    return;
+  }
+
+  // Taken from the host thread like other savestates. The CPU is paused between blocks, which may
+  // be partway into the frame, but the state holds the movie position so playback resumes from it
+  Core::QueueHostJob([this] {
+    if (Core::IsRunningAndStarted())
+    {
+      Core::RunOnCPUThread(
+          [this] {
+            if (!IsRecordingInput() || !m_stream_writer)
+              return;
+            std::vector<u8> state;
+            State::SaveToBuffer(state);
+            m_stream_writer->AddKeyframe(m_current_frame, std::move(state));
+          },
+          true);
+    }
+    m_keyframe_capture_pending = false;
+  });
+}
+
+// NOTE: CPU Thread / EmuThread
+void MovieManager::StopStream()
+{
+  if (!m_stream_writer || !m_stream_writer->IsActive())
+    return;
+
+  // Stopping the recording resets the current byte, but not the input
+  if (m_temp_input.size() < m_streamed_bytes)
+  {
+    m_stream_writer->Start(GetStreamPath(), CreateHeader(), m_temp_input, m_current_frame);
+  }
+  else if (m_temp_input.size() > m_streamed_bytes)
+  {
+    m_stream_writer->Append(CreateHeader(),
+                            std::span<const u8>(m_temp_input).subspan(m_streamed_bytes));
+  }
+  m_stream_writer->Stop();
+  m_streamed_bytes = 0;
+}
+
 // called when game is booting up, even if no movie is active,
 // but potentially after BeginRecordingInput or PlayInput has been called.
 // NOTE: EmuThread
@@ -965,6 +1079,11 @@ bool MovieManager::PlayInput(const std::string& movie_path,
   m_current_byte = 0;
   recording_file.Close();
 
+  if (std::optional<DTMKeyframes> keyframes = DTMKeyframes::Open(GetKeyframePath(movie_path)))
+    m_keyframes = std::make_unique<DTMKeyframes>(std::move(*keyframes));
+  else
+    m_keyframes.reset();
+
   // Load savestate (and skip to frame data)
   if (m_temp_header.bFromSaveState && savestate_path)
   {
@@ -1360,11 +1479,8 @@ void MovieManager::EndPlayInput(bool cont)
   }
 }
 
-// NOTE: Save State + Host Thread
-void MovieManager::SaveRecording(const std::string& filename)
+DTMHeader MovieManager::CreateHeader() const
 {
-  File::IOFile save_record(filename, "wb");
-  // Create the real header now and write it
   DTMHeader header;
   memset(&header, 0, sizeof(DTMHeader));
 
@@ -1411,6 +1527,15 @@ void MovieManager::SaveRecording(const std::string& filename)
   header.uniqueID = 0;
   // header.audioEmulator;
 
+  return header;
+}
+
+// NOTE: Save State + Host Thread
+void MovieManager::SaveRecording(const std::string& filename)
+{
+  File::IOFile save_record(filename, "wb");
+  // Create the real header now and write it
+  const DTMHeader header = CreateHeader();
   save_record.WriteArray(&header, 1);
 
   bool success = save_record.WriteBytes(m_temp_input.data(), m_temp_input.size());
@@ -1427,6 +1552,50 @@ void MovieManager::SaveRecording(const std::string& filename)
     Core::DisplayMessage(fmt::format("Failed to save {}", filename), 2000);
 }
 
+// NOTE: Host Thread
+void MovieManager::SaveKeyframes(const std::string& filename)
+{
+  if (!m_stream_writer)
+    return;
+
+  m_stream_writer->Flush();
+  const std::string keyframe_path = GetKeyframePath(GetStreamPath());
+  if (File::Exists(keyframe_path))
+    File::CopyRegularFile(keyframe_path, GetKeyframePath(filename));
+}
+
+// NOTE: Host Thread
+bool MovieManager::SeekToFrame(u64 frame)
+{
+  if (!IsPlayingInput() || frame > m_total_frames)
+    return false;
+
+  bool success = false;
+  Core::RunOnCPUThread(
+      [&] {
+        // Going back needs a keyframe, going forward only uses one if it skips part of the way
+        const DTMKeyframes::Keyframe* keyframe = m_keyframes ? m_keyframes->Find(frame) : nullptr;
+        if (keyframe && (frame < m_current_frame || keyframe->frame > m_current_frame))
+        {
+          std::optional<std::vector<u8>> state = m_keyframes->Load(*keyframe);
+          if (state)
+            State::LoadFromBuffer(*state);
+        }
+        if (frame < m_current_frame)
+          return;
+
+        // The rest of the way is emulated as fast as possible, FrameUpdate stops at the frame
+        m_seek_target = frame;
+        Core::SetIsThrottlerTempDisabled(true);
+        success = true;
+      },
+      true);
+
+  if (success)
+    Core::SetState(Core::State::Running);
+  return success;
+}
+
 // NOTE: GPU Thread
 void MovieManager::SetGraphicsConfig()
 {
@@ -1555,6 +1724,16 @@ void MovieManager::GetMD5()
 // NOTE: EmuThread
 void MovieManager::Shutdown()
 {
+  StopStream();
+  if (m_stream_writer)
+    m_stream_writer->Flush();
+  m_keyframes.reset();
+  if (m_seek_target)
+  {
+    m_seek_target.reset();
+    Core::SetIsThrottlerTempDisabled(false);
+  }
+
   m_current_input_count = m_total_input_count = m_total_frames = m_tick_count_at_last_input = 0;
   m_temp_input.clear();
 }
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -144,6 +146,9 @@ static_assert(sizeof(DTMHeader) == 256, "DTMHeader should be 256 bytes");
 
 #pragma pack(pop)
 
+class DTMKeyframes;
+class DTMStreamWriter;
+
 enum class PlayMode
 {
   None = 0,
@@ -215,6 +220,10 @@ public:
                    WiimoteEmu::ExtensionNumber ext, const WiimoteEmu::EncryptionKey& key);
   void EndPlayInput(bool cont);
   void SaveRecording(const std::string& filename);
+  // Copies the keyframes of the recording next to a DTM saved with SaveRecording
+  void SaveKeyframes(const std::string& filename);
+  // Jumps to a frame of the movie being played, from the closest keyframe before it
+  bool SeekToFrame(u64 frame);
   void DoState(PointerWrap& p);
   void Shutdown();
   void CheckPadStatus(const GCPadStatus* PadStatus, int controllerID);
@@ -232,6 +241,10 @@ private:
   void CheckMD5();
   void GetMD5();
 
+  DTMHeader CreateHeader() const;
+  void UpdateStream();
+  void StopStream();
+
   bool m_read_only = true;
   u32 m_rerecords = 0;
   PlayMode m_play_mode = PlayMode::None;
@@ -270,6 +283,15 @@ private:
 
   std::string m_current_file_name;
 
+  // The recording is written to disk as it goes, m_temp_input up to m_streamed_bytes is in the file
+  std::unique_ptr<DTMStreamWriter> m_stream_writer;
+  u64 m_streamed_bytes = 0;
+  std::atomic<bool> m_keyframe_capture_pending = false;
+
+  // Keyframes of the movie being played, if it has any
+  std::unique_ptr<DTMKeyframes> m_keyframes;
+  std::optional<u64> m_seek_target;
+
   // m_input_display is used by both CPU and GPU (is mutable).
   std::mutex m_input_display_lock;
   std::array<std::string, 8> m_input_display;
@@ -0,0 +1,289 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieStream.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "Common/Logging/Log.h"
+#include "Common/Version.h"
+#include "Core/StateCompression.h"
+
+namespace Movie
+{
+constexpr std::array<u8, 4> KEYFRAME_FILE_MAGIC{'D', 'T', 'M', 'K'};
+constexpr u32 KEYFRAME_FILE_VERSION = 1;
+
+// Keyframes are compressed next to the emulation, so they only get one thread
+constexpr State::CompressionType KEYFRAME_COMPRESSION = State::CompressionType::ChunkedZstd;
+constexpr size_t KEYFRAME_COMPRESSION_THREADS = 1;
+
+#pragma pack(push, 1)
+struct KeyframeFileHeader
+{
+  std::array<u8, 4> magic;
+  u32 version;
+  // Git revision of the build that wrote the keyframes, as savestates only load in the same build
+  std::array<char, 40> revision;
+};
+
+struct KeyframeRecordHeader
+{
+  u64 frame;
+  u64 uncompressed_size;
+  u16 compression_type;
+  u32 chunk_size;
+  u32 chunk_count;
+  // Followed by chunk_count u32 chunk sizes and the compressed chunks
+};
+#pragma pack(pop)
+
+static KeyframeFileHeader CreateKeyframeFileHeader()
+{
+  KeyframeFileHeader header{};
+  header.magic = KEYFRAME_FILE_MAGIC;
+  header.version = KEYFRAME_FILE_VERSION;
+  const std::string& revision = Common::GetScmRevGitStr();
+  std::copy_n(revision.begin(), std::min(revision.size(), header.revision.size()),
+              header.revision.begin());
+  return header;
+}
+
+std::string GetKeyframePath(const std::string& dtm_path)
+{
+  return dtm_path + ".keyframes";
+}
+
+DTMStreamWriter::DTMStreamWriter()
+{
+  m_worker.Reset("DTM Writer", [](std::function<void()> job) { job(); });
+}
+
+DTMStreamWriter::~DTMStreamWriter()
+{
+  m_worker.Shutdown();
+}
+
+void DTMStreamWriter::Start(const std::string& path, const DTMHeader& header,
+                            std::span<const u8> input, std::optional<u64> keep_keyframes_until)
+{
+  if (!m_active)
+    keep_keyframes_until.reset();
+  m_active = true;
+
+  m_worker.EmplaceItem([this, path, header, input = std::vector<u8>(input.begin(), input.end()),
+                        keep_keyframes_until] {
+    if (!m_file.Open(path, "wb") || !m_file.WriteArray(&header, 1) ||
+        !m_file.WriteBytes(input.data(), input.size()) || !m_file.Flush())
+    {
+      ERROR_LOG_FMT(CORE, "Failed to write the recording to {}", path);
+      m_file.Close();
+    }
+    OpenKeyframeFile(GetKeyframePath(path), keep_keyframes_until);
+  });
+}
+
+void DTMStreamWriter::OpenKeyframeFile(const std::string& path,
+                                       std::optional<u64> keep_keyframes_until)
+{
+  if (keep_keyframes_until && m_keyframe_file.IsOpen())
+  {
+    // Keyframes after the frame the recording went back to are from a future that won't happen
+    const u64 frame = *keep_keyframes_until;
+    const auto first_dropped =
+        std::find_if(m_keyframe_records.begin(), m_keyframe_records.end(),
+                     [frame](const KeyframeRecord& record) { return record.frame > frame; });
+    if (first_dropped != m_keyframe_records.end())
+    {
+      m_keyframe_file.Resize(first_dropped->offset);
+      m_keyframe_records.erase(first_dropped, m_keyframe_records.end());
+    }
+    m_keyframe_file.Seek(0, File::SeekOrigin::End);
+    return;
+  }
+
+  m_keyframe_records.clear();
+  const KeyframeFileHeader header = CreateKeyframeFileHeader();
+  if (!m_keyframe_file.Open(path, "wb") || !m_keyframe_file.WriteArray(&header, 1) ||
+      !m_keyframe_file.Flush())
+  {
+    ERROR_LOG_FMT(CORE, "Failed to write the recording keyframes to {}", path);
+    m_keyframe_file.Close();
+  }
+}
+
+void DTMStreamWriter::Append(const DTMHeader& header, std::span<const u8> input)
+{
+  if (!m_active)
+    return;
+
+  m_worker.EmplaceItem([this, header, input = std::vector<u8>(input.begin(), input.end())] {
+    if (!m_file.IsOpen())
+      return;
+
+    // The header goes last, so its counts never cover input that isn't in the file yet
+    m_file.Seek(0, File::SeekOrigin::End);
+    m_file.WriteBytes(input.data(), input.size());
+    m_file.Flush();
+    m_file.Seek(0, File::SeekOrigin::Begin);
+    m_file.WriteArray(&header, 1);
+    m_file.Flush();
+  });
+}
+
+void DTMStreamWriter::AddKeyframe(u64 frame, std::vector<u8> state)
+{
+  if (!m_active)
+    return;
+
+  m_worker.EmplaceItem([this, frame, state = std::move(state)] {
+    // The index needs them in order
+    if (!m_keyframe_file.IsOpen() ||
+        (!m_keyframe_records.empty() && frame <= m_keyframe_records.back().frame))
+    {
+      return;
+    }
+
+    const auto chunks = State::CompressChunks(state, KEYFRAME_COMPRESSION, State::STATE_CHUNK_SIZE,
+                                              KEYFRAME_COMPRESSION_THREADS);
+    if (!chunks)
+    {
+      ERROR_LOG_FMT(CORE, "Failed to compress the keyframe at frame {}", frame);
+      return;
+    }
+
+    KeyframeRecordHeader header{};
+    header.frame = frame;
+    header.uncompressed_size = state.size();
+    header.compression_type = KEYFRAME_COMPRESSION;
+    header.chunk_size = State::STATE_CHUNK_SIZE;
+    header.chunk_count = static_cast<u32>(chunks->sizes.size());
+
+    const u64 offset = m_keyframe_file.Tell();
+    if (!m_keyframe_file.WriteArray(&header, 1) ||
+        !m_keyframe_file.WriteArray(chunks->sizes.data(), chunks->sizes.size()) ||
+        !m_keyframe_file.WriteBytes(chunks->data.data(), chunks->data.size()) ||
+        !m_keyframe_file.Flush())
+    {
+      ERROR_LOG_FMT(CORE, "Failed to write the keyframe at frame {}", frame);
+      m_keyframe_file.Close();
+      return;
+    }
+    m_keyframe_records.push_back({frame, offset});
+  });
+}
+
+void DTMStreamWriter::Stop()
+{
+  if (!m_active)
+    return;
+  m_active = false;
+
+  m_worker.EmplaceItem([this] {
+    m_file.Close();
+    m_keyframe_file.Close();
+    m_keyframe_records.clear();
+  });
+}
+
+void DTMStreamWriter::Flush()
+{
+  m_worker.WaitForCompletion();
+}
+
+bool DTMStreamWriter::IsActive() const
+{
+  return m_active;
+}
+
+std::optional<DTMKeyframes> DTMKeyframes::Open(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  KeyframeFileHeader file_header;
+  if (!file.ReadArray(&file_header, 1) || file_header.magic != KEYFRAME_FILE_MAGIC ||
+      file_header.version != KEYFRAME_FILE_VERSION)
+  {
+    return std::nullopt;
+  }
+  if (file_header.revision != CreateKeyframeFileHeader().revision)
+  {
+    WARN_LOG_FMT(CORE, "Ignoring the keyframes in {}, they are from another build", path);
+    return std::nullopt;
+  }
+
+  DTMKeyframes keyframes;
+  keyframes.m_path = path;
+  keyframes.m_end_offset = file.Tell();
+  const u64 file_size = file.GetSize();
+
+  KeyframeRecordHeader header;
+  while (file.ReadArray(&header, 1))
+  {
+    const u64 sizes_end = file.Tell() + u64{header.chunk_count} * sizeof(u32);
+    if (sizes_end > file_size || !State::IsChunkedCompression(header.compression_type) ||
+        header.chunk_size == 0 ||
+        header.chunk_count != State::GetChunkCount(header.uncompressed_size, header.chunk_size))
+    {
+      break;
+    }
+
+    Keyframe keyframe{};
+    keyframe.frame = header.frame;
+    keyframe.uncompressed_size = header.uncompressed_size;
+    keyframe.compression_type = header.compression_type;
+    keyframe.chunk_size = header.chunk_size;
+    keyframe.chunk_sizes.resize(header.chunk_count);
+    if (!file.ReadArray(keyframe.chunk_sizes.data(), keyframe.chunk_sizes.size()))
+      break;
+
+    keyframe.offset = file.Tell();
+    for (const u32 size : keyframe.chunk_sizes)
+      keyframe.compressed_size += size;
+    if (keyframe.offset + keyframe.compressed_size > file_size)
+      break;
+    // Written in order, anything else means the file is damaged
+    if (!keyframes.m_keyframes.empty() && keyframe.frame <= keyframes.m_keyframes.back().frame)
+      break;
+
+    keyframes.m_end_offset = keyframe.offset + keyframe.compressed_size;
+    if (!file.Seek(keyframes.m_end_offset, File::SeekOrigin::Begin))
+      break;
+    keyframes.m_keyframes.push_back(std::move(keyframe));
+  }
+
+  return keyframes;
+}
+
+const DTMKeyframes::Keyframe* DTMKeyframes::Find(u64 frame) const
+{
+  const auto it = std::upper_bound(
+      m_keyframes.begin(), m_keyframes.end(), frame,
+      [](u64 value, const Keyframe& keyframe) { return value < keyframe.frame; });
+  if (it == m_keyframes.begin())
+    return nullptr;
+  return &*std::prev(it);
+}
+
+std::optional<std::vector<u8>> DTMKeyframes::Load(const Keyframe& keyframe) const
+{
+  File::IOFile file(m_path, "rb");
+  std::vector<u8> compressed(keyframe.compressed_size);
+  if (!file.Seek(keyframe.offset, File::SeekOrigin::Begin) ||
+      !file.ReadBytes(compressed.data(), compressed.size()))
+  {
+    return std::nullopt;
+  }
+
+  std::vector<u8> state(keyframe.uncompressed_size);
+  if (!State::DecompressChunks(compressed, keyframe.chunk_sizes,
+                               static_cast<State::CompressionType>(keyframe.compression_type),
+                               keyframe.chunk_size, state))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to decompress the keyframe at frame {}", keyframe.frame);
+    return std::nullopt;
+  }
+  return state;
+}
+}  // namespace Movie
@@ -0,0 +1,101 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
+#include "Core/Movie.h"
+
+namespace Movie
+{
+// Keyframes of a DTM are kept next to it, so the DTM itself stays readable by anything that
+// reads DTMs
+std::string GetKeyframePath(const std::string& dtm_path);
+
+// Writes a DTM while it is being recorded instead of only when the recording is saved, so a crash
+// doesn't lose it. Input is appended and the header rewritten after it, on a worker thread, so the
+// file is a valid DTM after every write. Keyframes are savestates taken every so often, written
+// compressed to the keyframe file for seeking during playback.
+//
+// The calls only queue work and copy what they are given, so they are cheap enough for the CPU
+// thread.
+class DTMStreamWriter
+{
+public:
+  DTMStreamWriter();
+  ~DTMStreamWriter();
+
+  // Writes the file from scratch. If the writer was already active, the keyframes up to and
+  // including keep_keyframes_until are kept, otherwise the keyframe file is started over too.
+  void Start(const std::string& path, const DTMHeader& header, std::span<const u8> input,
+             std::optional<u64> keep_keyframes_until = std::nullopt);
+  // Input recorded since the last call
+  void Append(const DTMHeader& header, std::span<const u8> input);
+  void AddKeyframe(u64 frame, std::vector<u8> state);
+  void Stop();
+
+  // Waits until everything queued is on disk
+  void Flush();
+  bool IsActive() const;
+
+private:
+  struct KeyframeRecord
+  {
+    u64 frame;
+    u64 offset;
+  };
+
+  void OpenKeyframeFile(const std::string& path, std::optional<u64> keep_keyframes_until);
+
+  bool m_active = false;
+
+  // Only used on the worker thread
+  File::IOFile m_file;
+  File::IOFile m_keyframe_file;
+  std::vector<KeyframeRecord> m_keyframe_records;
+
+  Common::WorkQueueThread<std::function<void()>> m_worker;
+};
+
+// Index of the keyframes of a DTM, read once when playback starts
+class DTMKeyframes
+{
+public:
+  struct Keyframe
+  {
+    u64 frame;
+    u64 uncompressed_size;
+    u16 compression_type;
+    u32 chunk_size;
+    std::vector<u32> chunk_sizes;
+    // Where the compressed data starts in the file
+    u64 offset;
+    u64 compressed_size;
+  };
+
+  // Nothing if the file doesn't exist or was written by another build, whose savestates wouldn't
+  // load. A record cut off by a crash and everything after it is ignored.
+  static std::optional<DTMKeyframes> Open(const std::string& path);
+
+  // The last keyframe at or before frame
+  const Keyframe* Find(u64 frame) const;
+  std::optional<std::vector<u8>> Load(const Keyframe& keyframe) const;
+
+  const std::vector<Keyframe>& GetKeyframes() const { return m_keyframes; }
+  // Where the records after the last complete one start
+  u64 GetEndOffset() const { return m_end_offset; }
+
+private:
+  std::string m_path;
+  std::vector<Keyframe> m_keyframes;
+  u64 m_end_offset = 0;
+};
+}  // namespace Movie
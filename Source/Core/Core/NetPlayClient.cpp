@@ -21,9 +21,9 @@
 #include "Common/Assert.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
-#include "Common/Crypto/SHA1.h"
 #include "Common/ENet.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
@@ -67,13 +67,14 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayCommon.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
 #include "Core/SyncIdentifier.h"
 #include "Core/System.h"
-#include "DiscIO/Blob.h"
 
 #include "InputCommon/ControllerEmu/ControlGroup/Attachments.h"
 #include "InputCommon/GCAdapter.h"
 #include "InputCommon/InputConfig.h"
+#include "UICommon/GameDigestCache.h"
 #include "UICommon/GameFile.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
@@ -137,13 +138,15 @@ NetPlayClient::~NetPlayClient()
 NetPlayClient::NetPlayClient(const std::string& address, const u16 port, NetPlayUI* dialog,
                              const NetTraversalConfig& traversal_config,
                              LocalPlayers::LocalPlayers::Player* player,
-                             std::map<int, Tag::TagSet>* tagset_map)
-    : m_dialog(dialog)
+                             std::map<int, Tag::TagSet>* tagset_map,
+                             std::optional<Headless> headless)
+    : m_dialog(dialog), m_headless(std::move(headless))
 {
   ClearBuffers();
 
     // Validate Rio User
-  LocalPlayers::LocalPlayers::AccountValidationType type = player->ValidateAccount(m_http);
+  LocalPlayers::LocalPlayers::AccountValidationType type =
+      m_headless ? LocalPlayers::LocalPlayers::Valid : player->ValidateAccount();
 
 if (type == LocalPlayers::LocalPlayers::Invalid)
   {
@@ -426,6 +429,10 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnPadHostData(packet);
     break;
 
+  case MessageID::PadDataRedundant:
+    OnPadDataRedundant(packet);
+    break;
+
   case MessageID::WiimoteData:
     OnWiimoteData(packet);
     break;
@@ -434,6 +441,10 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnPadBuffer(packet);
     break;
 
+  case MessageID::PadBufferDecision:
+    OnPadBufferDecision(packet);
+    break;
+
   case MessageID::HostInputAuthority:
     OnHostInputAuthority(packet);
     break;
@@ -523,8 +534,20 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnNightMsg(packet);
     break;  
 
-  case MessageID::Checksum:
-    OnChecksumMsg(packet);
+  case MessageID::DesyncHashRoot:
+    OnDesyncHashRoot(packet);
+    break;
+
+  case MessageID::DesyncHashRequest:
+    OnDesyncHashRequest(packet);
+    break;
+
+  case MessageID::DesyncHashNodes:
+    OnDesyncHashNodes(packet);
+    break;
+
+  case MessageID::DesyncDump:
+    OnDesyncDump(packet);
     break;
 
   case MessageID::GameID:
@@ -764,10 +787,55 @@ void NetPlayClient::OnPadData(sf::Packet& packet)
     }
 
     // Trusting server for good map value (>=0 && <4)
+    // The unreliable channel may have delivered it already
+    if (m_redundant_receiver.OnReliable(map))
+      PushRemotePad(map, pad);
+  }
+}
+
+void NetPlayClient::OnPadDataRedundant(sf::Packet& packet)
+{
+  while (!packet.endOfPacket())
+  {
+    PadIndex map;
+    u32 first_sequence;
+    u8 count;
+    u8 repeated;
+    packet >> map >> first_sequence >> count >> repeated;
+
+    // Trusting server for good map value (>=0 && <4)
+    const size_t first_new = m_redundant_receiver.OnUnreliable(map, first_sequence, count, repeated);
+    for (u8 i = 0; i < count; ++i)
+    {
+      GCPadStatus pad;
+      packet >> pad.button;
+      if (!m_gba_config.at(map).enabled)
+      {
+        packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
+            pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+      }
+
+      if (i >= first_new)
+        PushRemotePad(map, pad);
+    }
+  }
+}
+
+void NetPlayClient::PushRemotePad(PadIndex map, const GCPadStatus& pad)
+{
+  if (m_rollback)
+  {
+    // The CPU thread rolls back when it polls the next frame
+    m_rollback->AddRemoteInput(map, pad);
+  }
+  else
+  {
     // add to pad buffer
     m_pad_buffer.at(map).Push(pad);
-    m_gc_pad_event.Set();
   }
+  m_timing.Record(TimingRecorder::EventType::PadArrival, map,
+                  static_cast<u32>(m_pad_buffer[map].Size()));
+  m_gc_pad_event.Set();
 }
 
 void NetPlayClient::OnPadHostData(sf::Packet& packet)
@@ -788,6 +856,7 @@ void NetPlayClient::OnPadHostData(sf::Packet& packet)
     // Trusting server for good map value (>=0 && <4)
     // write to last status
     m_last_pad_status[map] = pad;
+    m_timing.Record(TimingRecorder::EventType::PadArrival, map);
 
     if (!m_first_pad_status_received[map])
     {
@@ -833,6 +902,17 @@ void NetPlayClient::OnPadBuffer(sf::Packet& packet)
   m_dialog->OnPadBufferChanged(size);
 }
 
+void NetPlayClient::OnPadBufferDecision(sf::Packet& packet)
+{
+  // The buffer itself changes with the PadBuffer message before this
+  PadBufferController::Decision decision;
+  packet >> decision.buffer >> decision.previous_buffer >> decision.required_ms >>
+      decision.rtt_ms >> decision.jitter_ms;
+
+  std::lock_guard lk(m_pad_buffer_decisions_lock);
+  m_pad_buffer_decisions.push_back(decision);
+}
+
 void NetPlayClient::OnHostInputAuthority(sf::Packet& packet)
 {
   packet >> m_host_input_authority;
@@ -846,6 +926,7 @@ void NetPlayClient::OnGolfSwitch(sf::Packet& packet)
 
   const PlayerId previous_golfer = m_current_golfer;
   m_current_golfer = pid;
+  m_timing.Record(TimingRecorder::EventType::GolfSwitch);
   m_dialog->OnGolferChanged(m_local_player->pid == pid, pid != 0 ? m_players[pid].name : "");
 
   if (m_local_player->pid == previous_golfer)
@@ -1000,6 +1081,7 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.sync_codes;
 
     packet >> m_net_settings.golf_mode;
+    packet >> m_net_settings.rollback;
     packet >> m_net_settings.use_fma;
     packet >> m_net_settings.hide_remote_gbas;
 
@@ -1089,6 +1171,36 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
     OnSyncSaveDataNotify(packet);
     break;
 
+  case SyncSaveDataID::RawData:
+  case SyncSaveDataID::GCIData:
+  case SyncSaveDataID::WiiData:
+  case SyncSaveDataID::GBAData:
+    OnSyncSaveDataFiles(sub_id, packet);
+    break;
+
+  case SyncSaveDataID::Blocks:
+    OnSyncSaveDataBlocks(packet);
+    break;
+
+  default:
+    PanicAlertFmtT("Unknown SYNC_SAVE_DATA message received with id: {0}", static_cast<u8>(sub_id));
+    break;
+  }
+}
+
+void NetPlayClient::OnSyncSaveDataFiles(SyncSaveDataID sub_id, sf::Packet& packet)
+{
+  // Keep the order the saves were sent in
+  if (!m_sync_save_data_waiting.empty())
+  {
+    m_sync_save_data_waiting.emplace_back(sub_id, packet);
+    return;
+  }
+
+  const sf::Packet original_packet = packet;
+
+  switch (sub_id)
+  {
   case SyncSaveDataID::RawData:
     OnSyncSaveDataRaw(packet);
     break;
@@ -1106,9 +1218,38 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
     break;
 
   default:
-    PanicAlertFmtT("Unknown SYNC_SAVE_DATA message received with id: {0}", static_cast<u8>(sub_id));
     break;
   }
+
+  // Blocks we reported went missing or got corrupted, ask for them instead of failing
+  if (m_sync_save_data_decoder && !m_sync_save_data_decoder->GetMissingBlocks().empty())
+  {
+    const std::set<SyncBlockDigest>& missing = m_sync_save_data_decoder->GetMissingBlocks();
+    INFO_LOG_FMT(NETPLAY, "Requesting {} missing save data blocks.", missing.size());
+    m_sync_save_data_waiting.emplace_back(sub_id, original_packet);
+
+    sf::Packet response_packet;
+    response_packet << MessageID::SyncSaveData;
+    response_packet << SyncSaveDataID::BlockRequest;
+    WriteSyncBlockDigests(response_packet, {missing.begin(), missing.end()});
+    Send(response_packet);
+  }
+}
+
+void NetPlayClient::OnSyncSaveDataBlocks(sf::Packet& packet)
+{
+  if (!m_sync_save_data_decoder || !m_sync_save_data_decoder->AddBlocks(packet))
+  {
+    ERROR_LOG_FMT(NETPLAY, "Didn't get the missing save data blocks.");
+    m_sync_save_data_waiting.clear();
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  auto waiting = std::move(m_sync_save_data_waiting);
+  m_sync_save_data_waiting.clear();
+  for (auto& [sub_id, waiting_packet] : waiting)
+    OnSyncSaveDataFiles(sub_id, waiting_packet);
 }
 
 void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
@@ -1119,9 +1260,25 @@ void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
   INFO_LOG_FMT(NETPLAY, "Initializing wait for {} savegame chunks.", m_sync_save_data_count);
 
   if (m_sync_save_data_count == 0)
+  {
     SyncSaveDataResponse(true);
-  else
-    m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
+    return;
+  }
+
+  m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
+
+  // Tell the server which blocks we have, it only sends the rest
+  SyncBlockStore store(File::GetUserPath(D_CACHE_IDX) + "NetPlaySync" DIR_SEP);
+  store.Prune();
+
+  sf::Packet response_packet;
+  response_packet << MessageID::SyncSaveData;
+  response_packet << SyncSaveDataID::BlockInventory;
+  WriteSyncBlockDigests(response_packet, store.GetDigests());
+  Send(response_packet);
+
+  m_sync_save_data_decoder = std::make_unique<SyncBlockDecoder>(std::move(store));
+  m_sync_save_data_waiting.clear();
 }
 
 void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
@@ -1158,7 +1315,7 @@ void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
     return;
   }
 
-  const bool success = DecompressPacketIntoFile(packet, path);
+  const bool success = DecompressPacketIntoFile(packet, *m_sync_save_data_decoder, path);
   SyncSaveDataResponse(success);
 }
 
@@ -1190,7 +1347,7 @@ void NetPlayClient::OnSyncSaveDataGCI(sf::Packet& packet)
     INFO_LOG_FMT(NETPLAY, "Received GCI: {}", file_name);
 
     if (!Common::IsFileNameSafe(file_name) ||
-        !DecompressPacketIntoFile(packet, path + DIR_SEP + file_name))
+        !DecompressPacketIntoFile(packet, *m_sync_save_data_decoder, path + DIR_SEP + file_name))
     {
       WARN_LOG_FMT(NETPLAY, "Received invalid GCI.");
       SyncSaveDataResponse(false);
@@ -1235,7 +1392,7 @@ void NetPlayClient::OnSyncSaveDataWii(sf::Packet& packet)
   {
     INFO_LOG_FMT(NETPLAY, "Received Mii data.");
 
-    auto buffer = DecompressPacketIntoBuffer(packet);
+    auto buffer = DecompressPacketIntoBuffer(packet, *m_sync_save_data_decoder);
 
     temp_fs->CreateFullPath(IOS::PID_KERNEL, IOS::PID_KERNEL, "/shared2/menu/FaceLib/", 0,
                             fs_modes);
@@ -1314,7 +1471,7 @@ void NetPlayClient::OnSyncSaveDataWii(sf::Packet& packet)
 
       if (file.type == WiiSave::Storage::SaveFile::Type::File)
       {
-        auto buffer = DecompressPacketIntoBuffer(packet);
+        auto buffer = DecompressPacketIntoBuffer(packet, *m_sync_save_data_decoder);
         if (!buffer)
         {
           SyncSaveDataResponse(false);
@@ -1340,7 +1497,7 @@ void NetPlayClient::OnSyncSaveDataWii(sf::Packet& packet)
   if (has_redirected_save)
   {
     INFO_LOG_FMT(NETPLAY, "Received redirected save.");
-    if (!DecompressPacketIntoFolder(packet, redirect_path))
+    if (!DecompressPacketIntoFolder(packet, *m_sync_save_data_decoder, redirect_path))
     {
       PanicAlertFmtT("Failed to write redirected save.");
       SyncSaveDataResponse(false);
@@ -1369,7 +1526,7 @@ void NetPlayClient::OnSyncSaveDataGBA(sf::Packet& packet)
     return;
   }
 
-  const bool success = DecompressPacketIntoFile(packet, path);
+  const bool success = DecompressPacketIntoFile(packet, *m_sync_save_data_decoder, path);
   SyncSaveDataResponse(success);
 }
 
@@ -1654,17 +1811,92 @@ void NetPlayClient::OnDisableReplaysMsg(sf::Packet& packet)
   Gecko::setDisableReplays(disable);
 }
 
-void NetPlayClient::OnChecksumMsg(sf::Packet& packet)
+void NetPlayClient::OnDesyncHashRoot(sf::Packet& packet)
 {
-  u32 inChecksum;
-  u8 checksumId;
-  packet >> inChecksum;
-  packet >> checksumId;
+  PlayerId pid;
+  u32 round;
+  packet >> pid >> round;
+  const u64 root = Common::PacketReadU64(packet);
+
+  std::lock_guard lk(m_desync_lock);
+  if (!m_desync_hasher)
+    return;
+
+  DesyncBisector& bisector = m_desync_bisectors.try_emplace(pid, *m_desync_hasher).first->second;
+  if (!bisector.OnRemoteRoot(round, root))
+    return;
+
+  OnDesyncFound(pid, bisector);
+  SendDesyncRequests();
+}
+
+void NetPlayClient::OnDesyncHashRequest(sf::Packet& packet)
+{
+  PlayerId pid;
+  u32 round;
+  u8 level;
+  u32 index;
+  packet >> pid >> round >> level >> index;
 
-  if (ourChecksum[checksumId] != inChecksum)
+  std::optional<std::vector<u64>> children;
   {
-    m_dialog->OnDesync(0, "");
+    std::lock_guard lk(m_desync_lock);
+    if (m_desync_hasher)
+      children = m_desync_hasher->GetChildren(round, level, index);
   }
+
+  // An empty answer tells the peer we can't help, so it stops waiting
+  sf::Packet response;
+  response << MessageID::DesyncHashNodes;
+  response << pid << round << level << index;
+  response << static_cast<u32>(children ? children->size() : 0);
+  if (children)
+  {
+    for (u64 hash : *children)
+      response << static_cast<sf::Uint64>(hash);
+  }
+  SendAsync(std::move(response));
+}
+
+void NetPlayClient::OnDesyncHashNodes(sf::Packet& packet)
+{
+  PlayerId pid;
+  u32 round;
+  u8 level;
+  u32 index;
+  u32 count;
+  packet >> pid >> round >> level >> index >> count;
+
+  std::vector<u64> hashes(std::min(count, DesyncHasher::FANOUT));
+  for (u64& hash : hashes)
+    hash = Common::PacketReadU64(packet);
+
+  std::lock_guard lk(m_desync_lock);
+  const auto it = m_desync_bisectors.find(pid);
+  if (it == m_desync_bisectors.end())
+    return;
+
+  it->second.OnRemoteChildren(round, level, index, hashes);
+  if (const auto result = it->second.TakeResult())
+    OnDesyncBisected(pid, *result);
+  SendDesyncRequests();
+}
+
+void NetPlayClient::OnDesyncDump(sf::Packet& packet)
+{
+  DesyncDump dump;
+  sf::Uint64 frame;
+  u32 count;
+  packet >> frame >> dump.round >> count;
+  dump.frame = frame;
+  dump.pages.resize(std::min(count, DesyncHasher::FANOUT));
+  for (u32& page : dump.pages)
+    packet >> page;
+
+  std::lock_guard lk(m_desync_lock);
+  // Both sides of a desync may ask for a dump, the first one wins
+  if (!m_desync_dump)
+    m_desync_dump = std::move(dump);
 }
 
 void NetPlayClient::OnGameIDMsg(sf::Packet& packet)
@@ -1691,7 +1923,7 @@ void NetPlayClient::OnCourseMsg(sf::Packet& packet)
 
 void NetPlayClient::Send(const sf::Packet& packet, const u8 channel_id)
 {
-  Common::ENet::SendPacket(m_server, packet, channel_id);
+  Common::ENet::SendPacket(m_server, packet, channel_id, channel_id != PAD_DATA_CHANNEL);
 }
 
 void NetPlayClient::DisplayPlayersPing()
@@ -1702,6 +1934,22 @@ void NetPlayClient::DisplayPlayersPing()
 
   OSD::AddTypedMessage(OSD::MessageType::NetPlayPing, fmt::format("Ping: {}", maxPing),
                        OSD::Duration::SHORT, OSD::Color::CYAN);
+
+  if (!m_is_running.IsSet())
+    return;
+
+  const TimingSummary timing = m_timing.GetSummary();
+  if (timing.frames == 0)
+    return;
+
+  OSD::AddTypedMessage(OSD::MessageType::NetPlayTiming,
+                       fmt::format("Stalls: {} ({} ms, p95 < {} ms) | Buffer p50 < {} | "
+                                   "Input gap p95 < {} ms",
+                                   timing.stalls, timing.stall_us / 1000,
+                                   timing.stall_ms.GetQuantileBound(0.95),
+                                   timing.buffer_depth.GetQuantileBound(0.5),
+                                   timing.arrival_interval_ms.GetQuantileBound(0.95)),
+                       OSD::Duration::SHORT, OSD::Color::CYAN);
 }
 
 bool NetPlayClient::isGolfMode()
@@ -2019,10 +2267,36 @@ bool NetPlayClient::StartGame(const std::string& path)
 
   m_timebase_frame = 0;
   m_current_golfer = 1;
+
+  for (RedundantPadHistory& history : m_redundant_pads)
+    history.Reset();
+  m_redundant_receiver.Reset();
+  m_pad_transport_start = {};
+  m_timing.Reset();
+
+  SetRollbackFastForward(false);
+  m_rollback.reset();
+  if (m_net_settings.rollback && !m_host_input_authority &&
+      std::none_of(m_wiimote_map.begin(), m_wiimote_map.end(), [](PlayerId p) { return p > 0; }))
+  {
+    RollbackSession::PadSet remote_pads{};
+    for (size_t i = 0; i < m_pad_map.size(); ++i)
+      remote_pads[i] = m_pad_map[i] > 0 && m_pad_map[i] != m_local_player->pid;
+    m_rollback = std::make_unique<RollbackSession>(remote_pads);
+  }
+
+  {
+    std::lock_guard lk(m_desync_lock);
+    m_desync_hasher.reset();
+    m_desync_bisectors.clear();
+    m_desync_dump.reset();
+    m_desync_frame = 0;
+  }
   m_wait_on_input = false;
 
   m_is_running.Set();
-  NetPlay_Enable(this);
+  if (!m_headless)
+    NetPlay_Enable(this);
 
   ClearBuffers();
 
@@ -2082,13 +2356,21 @@ bool NetPlayClient::StartGame(const std::string& path)
 
   m_dialog->StartingMsg(Core::isTagSetActive(true));
 
-  UpdateDevices();
+  if (!m_headless)
+    UpdateDevices();
 
   return true;
 }
 
 void NetPlayClient::SyncSaveDataResponse(const bool success)
 {
+  // OnSyncSaveDataFiles asks for the missing blocks and tries again
+  if (!success && m_sync_save_data_decoder &&
+      !m_sync_save_data_decoder->GetMissingBlocks().empty())
+  {
+    return;
+  }
+
   m_dialog->AppendChat(success ? Common::GetStringT("Data received!") :
                                  Common::GetStringT("Error processing data."));
 
@@ -2309,8 +2591,13 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_wait_on_input_event.Wait();
   }
 
+  if (m_rollback)
+    return GetRollbackPads(pad_nb, batching, pad_status);
+
   if (IsFirstInGamePad(pad_nb) && batching)
   {
+    m_timing.Record(TimingRecorder::EventType::Frame);
+
     sf::Packet packet;
     packet << MessageID::PadData;
 
@@ -2322,7 +2609,7 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     }
 
     if (send_packet)
-      SendAsync(std::move(packet));
+      SendPadData(std::move(packet));
 
     if (m_host_input_authority)
       SendPadHostPoll(-1);
@@ -2336,7 +2623,7 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
       sf::Packet packet;
       packet << MessageID::PadData;
       if (PollLocalPad(local_pad, packet))
-        SendAsync(std::move(packet));
+        SendPadData(std::move(packet));
     }
 
     if (m_host_input_authority)
@@ -2360,13 +2647,14 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
 
       std::chrono::duration<double> time_diff =
           std::chrono::steady_clock::now() - m_buffer_under_target_last;
-      bool bDrainHotkeyPressed = HotkeyManagerEmu::IsPressed(HK_DRAIN_GOLF_BUFFER, true);
+      bool bDrainHotkeyPressed =
+          !m_headless && HotkeyManagerEmu::IsPressed(HK_DRAIN_GOLF_BUFFER, true);
 
       if ((time_diff.count() >= 1.0 || (!buffer_over_target && !bDrainHotkeyPressed))
         /*&& !isPitchInProgress*/) // don't speed up game during a pitch
       {
         // run fast if the buffer is overfilled, otherwise run normal speed
-        Config::SetCurrent(Config::MAIN_EMULATION_SPEED, buffer_over_target ? 0.0f : 1.0f);
+        SetEmulationSpeed(buffer_over_target ? 0.0f : 1.0f);
       }
       // after a pitch, we speed up game to keep buffer low
       //if (pitchComplete)
@@ -2374,29 +2662,137 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
       //    m_pad_buffer[pad_nb].Size() > 1 ? 0.0f : 1.0f);
       // Hotkey drains netplay buffer for non golfer
       if (bDrainHotkeyPressed)
-        Config::SetCurrent(Config::MAIN_EMULATION_SPEED,
-                           m_pad_buffer[pad_nb].Size() > 1 ? 0.0f : 1.0f);
+        SetEmulationSpeed(m_pad_buffer[pad_nb].Size() > 1 ? 0.0f : 1.0f);
     }
     else
     {
       // Set normal speed when we're the host, otherwise it can get stuck at unlimited
-      Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 1.0f);
+      SetEmulationSpeed(1.0f);
     }
   }
 
   // Now, we either use the data pushed earlier, or wait for the
   // other clients to send it to us
-  while (m_pad_buffer[pad_nb].Size() == 0)
+  if (m_pad_buffer[pad_nb].Size() == 0)
   {
-    if (!m_is_running.IsSet())
+    const u64 stall_start = Common::Timer::NowUs();
+    while (m_pad_buffer[pad_nb].Size() == 0)
     {
-      return false;
-    }
+      if (!m_is_running.IsSet())
+      {
+        return false;
+      }
 
-    m_gc_pad_event.Wait();
+      m_gc_pad_event.Wait();
+    }
+    m_timing.Record(TimingRecorder::EventType::Stall, pad_nb,
+                    static_cast<u32>(Common::Timer::NowUs() - stall_start));
   }
 
+  m_timing.Record(TimingRecorder::EventType::BufferDepth, pad_nb,
+                  static_cast<u32>(m_pad_buffer[pad_nb].Size()));
   m_pad_buffer[pad_nb].Pop(*pad_status);
+  RecordPadStatus(pad_nb, pad_status);
+  return true;
+}
+
+// called from ---CPU--- thread
+bool NetPlayClient::GetRollbackPads(const int pad_nb, const bool batching, GCPadStatus* pad_status)
+{
+  // Frames are only counted on batched polls. Local pads are sent once per frame, so a poll from
+  // MMIO gets the input of the current frame
+  if (IsFirstInGamePad(pad_nb) && batching)
+  {
+    m_timing.Record(TimingRecorder::EventType::Frame);
+
+    // Batched polls happen in the VI event, at the same emulated point on every client. Saving and
+    // loading here means a frame always starts from the snapshot tagged with it
+    m_rollback->Rollback(State::RestoreRollbackSnapshot);
+    m_rollback->TakeSnapshot(State::CaptureRollbackSnapshot);
+
+    if (m_rollback->BeginFrame())
+    {
+      sf::Packet packet;
+      packet << MessageID::PadData;
+
+      bool send_packet = false;
+      const int num_local_pads = NumLocalPads();
+      for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
+        send_packet = PollLocalPad(local_pad, packet) || send_packet;
+
+      if (send_packet)
+        SendPadData(std::move(packet));
+    }
+
+    // Frames that run again catch up as fast as possible
+    SetRollbackFastForward(m_rollback->IsResimulating());
+  }
+
+  // Predicted input is used while the remote one is on its way, only wait when too far ahead
+  std::optional<GCPadStatus> status = m_rollback->GetInput(pad_nb);
+  if (!status)
+  {
+    const u64 stall_start = Common::Timer::NowUs();
+    while (!(status = m_rollback->GetInput(pad_nb)))
+    {
+      if (!m_is_running.IsSet())
+      {
+        return false;
+      }
+
+      m_gc_pad_event.Wait();
+    }
+    m_timing.Record(TimingRecorder::EventType::Stall, pad_nb,
+                    static_cast<u32>(Common::Timer::NowUs() - stall_start));
+  }
+
+  *pad_status = *status;
+  RecordPadStatus(pad_nb, pad_status);
+  return true;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendPadData(sf::Packet&& packet)
+{
+  SendAsync(std::move(packet));
+
+  // With host input authority, pads go through the golfer instead
+  if (m_host_input_authority)
+    return;
+
+  // Repeat the last inputs of every local pad on the unreliable channel, so a lost packet doesn't
+  // stall the other clients until ENet resends the reliable one
+  sf::Packet redundant_packet;
+  redundant_packet << MessageID::PadDataRedundant;
+  for (size_t ingame_pad = 0; ingame_pad < m_redundant_pads.size(); ++ingame_pad)
+  {
+    RedundantPadHistory& history = m_redundant_pads[ingame_pad];
+    if (history.IsEmpty())
+      continue;
+
+    const std::deque<GCPadStatus>& inputs = history.GetInputs();
+    redundant_packet << static_cast<PadIndex>(ingame_pad) << history.GetFirstSequence()
+                     << static_cast<u8>(inputs.size()) << history.TakeRepeatedCount();
+    for (const GCPadStatus& pad : inputs)
+    {
+      redundant_packet << pad.button;
+      if (!m_gba_config[ingame_pad].enabled)
+      {
+        redundant_packet << pad.analogA << pad.analogB << pad.stickX << pad.stickY
+                         << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight
+                         << pad.isConnected;
+      }
+    }
+  }
+
+  SendAsync(std::move(redundant_packet), PAD_DATA_CHANNEL);
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::RecordPadStatus(const int pad_nb, GCPadStatus* pad_status)
+{
+  if (m_headless)
+    return;
 
   auto& movie = Core::System::GetInstance().GetMovie();
   if (movie.IsRecordingInput())
@@ -2408,8 +2804,37 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
   {
     movie.CheckPadStatus(pad_status, pad_nb);
   }
+}
 
-  return true;
+void NetPlayClient::SetEmulationSpeed(float speed)
+{
+  if (m_headless)
+    m_headless->set_emulation_speed(speed);
+  else
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, speed);
+}
+
+// The speed limit is lifted in the current run layer, whatever the user had there is put back
+void NetPlayClient::SetRollbackFastForward(bool fast_forward)
+{
+  if (fast_forward == m_rollback_fast_forward)
+    return;
+  m_rollback_fast_forward = fast_forward;
+
+  if (fast_forward)
+  {
+    m_speed_before_fast_forward = Config::GetLayer(Config::LayerType::CurrentRun)
+                                      ->Get<float>(Config::MAIN_EMULATION_SPEED.GetLocation());
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  }
+  else if (m_speed_before_fast_forward)
+  {
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, *m_speed_before_fast_forward);
+  }
+  else
+  {
+    Config::DeleteKey(Config::LayerType::CurrentRun, Config::MAIN_EMULATION_SPEED);
+  }
 }
 
 u64 NetPlayClient::GetInitialRTCValue() const
@@ -2462,7 +2887,11 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
   bool data_added = false;
   GCPadStatus pad_status;
 
-  if (m_gba_config[ingame_pad].enabled)
+  if (m_headless)
+  {
+    pad_status = m_headless->get_pad(local_pad);
+  }
+  else if (m_gba_config[ingame_pad].enabled)
   {
     pad_status = Pad::GetGBAStatus(local_pad);
   }
@@ -2491,6 +2920,14 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
       m_first_pad_status_received[ingame_pad] = true;
     }
   }
+  else if (m_rollback)
+  {
+    // Used on this frame already, without a buffer
+    m_rollback->SetLocalInput(ingame_pad, pad_status);
+    m_redundant_pads[ingame_pad].Push(pad_status);
+    AddPadStateToPacket(ingame_pad, pad_status, packet);
+    data_added = true;
+  }
   else
   {
     // adjust the buffer either up or down
@@ -2499,6 +2936,7 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
     {
       // add to buffer
       m_pad_buffer[ingame_pad].Push(pad_status);
+      m_redundant_pads[ingame_pad].Push(pad_status);
 
       // add to packet
       AddPadStateToPacket(ingame_pad, pad_status, packet);
@@ -2548,6 +2986,8 @@ void NetPlayClient::SendPadHostPoll(const PadIndex pad_num)
   if (m_local_player->pid != m_current_golfer)
     return;
 
+  m_timing.Record(TimingRecorder::EventType::HostPoll, pad_num < 0 ? 0 : pad_num);
+
   sf::Packet packet;
   packet << MessageID::PadHostData;
 
@@ -2614,7 +3054,33 @@ bool NetPlayClient::StopGame()
 {
   InvokeStop();
 
-  NetPlay_Disable();
+  const RedundantPadReceiver::Stats pad_stats = m_redundant_receiver.GetStats();
+  INFO_LOG_FMT(NETPLAY,
+               "Pad transport: {} inputs first on the unreliable channel, {} of them recovered "
+               "from repeated copies, {} first on the reliable channel, {} gaps",
+               pad_stats.unreliable_first, pad_stats.recovered, pad_stats.reliable_first,
+               pad_stats.gaps);
+
+  const TimingSummary timing = m_timing.GetSummary();
+  INFO_LOG_FMT(NETPLAY,
+               "Timing: {} frames, {} stalls for {} ms (longest {} ms), {} pad arrivals, {} host "
+               "polls, {} golfer switches, {} events dropped",
+               timing.frames, timing.stalls, timing.stall_us / 1000, timing.max_stall_us / 1000,
+               timing.pad_arrivals, timing.host_polls, timing.golf_switches,
+               timing.dropped_events);
+
+  if (m_rollback)
+  {
+    const RollbackSession::Stats stats = m_rollback->GetStats();
+    INFO_LOG_FMT(NETPLAY,
+                 "Rollback: {} frames, {} resimulated in {} rollbacks (longest {}), {} of {} "
+                 "predicted inputs wrong",
+                 stats.frames, stats.resimulated_frames, stats.rollbacks,
+                 stats.max_rollback_frames, stats.mispredicted_inputs, stats.predicted_inputs);
+  }
+
+  if (!m_headless)
+    NetPlay_Disable();
 
   // stop game
   m_dialog->StopGame();
@@ -2868,21 +3334,227 @@ void NetPlayClient::SendGameStatus()
   Send(packet);
 }
 
-void NetPlayClient::SendChecksum(u8 checksumId, u64 frame, u32 checksum)
+void NetPlayClient::SendPadBufferSafePoint()
+{
+  std::lock_guard lk(crit_netplay_client);
+  if (!netplay_client || !netplay_client->m_local_player->IsHost())
+    return;
+
+  sf::Packet packet;
+  packet << MessageID::PadBufferSafePoint;
+  netplay_client->SendAsync(std::move(packet));
+}
+
+std::vector<PadBufferController::Decision> NetPlayClient::TakePadBufferDecisions()
+{
+  std::lock_guard lk(crit_netplay_client);
+  if (!netplay_client)
+    return {};
+
+  std::lock_guard lk_decisions(netplay_client->m_pad_buffer_decisions_lock);
+  return std::exchange(netplay_client->m_pad_buffer_decisions, {});
+}
+
+std::optional<TimingSummary> NetPlayClient::GetTimingSummary()
+{
+  std::lock_guard lk(crit_netplay_client);
+  if (!netplay_client)
+    return std::nullopt;
+
+  return netplay_client->m_timing.GetSummary();
+}
+
+std::optional<RedundantPadReceiver::Stats> NetPlayClient::GetPadTransportStats()
+{
+  std::lock_guard lk(crit_netplay_client);
+  if (!netplay_client)
+    return std::nullopt;
+
+  RedundantPadReceiver::Stats stats = netplay_client->m_redundant_receiver.GetStats();
+  const RedundantPadReceiver::Stats& start = netplay_client->m_pad_transport_start;
+  stats.reliable_first -= start.reliable_first;
+  stats.unreliable_first -= start.unreliable_first;
+  stats.recovered -= start.recovered;
+  stats.gaps -= start.gaps;
+  return stats;
+}
+
+void NetPlayClient::ResetTiming()
+{
+  std::lock_guard lk(crit_netplay_client);
+  if (netplay_client)
+  {
+    netplay_client->m_timing.Reset();
+    netplay_client->m_pad_transport_start = netplay_client->m_redundant_receiver.GetStats();
+  }
+}
+
+std::optional<RollbackSession::Progress> NetPlayClient::GetRollbackProgress()
 {
-  netplay_client->ourChecksum[checksumId] = checksum;
+  std::lock_guard lk(crit_netplay_client);
+  if (!netplay_client || !netplay_client->m_rollback)
+    return std::nullopt;
 
-  if (frame < 1000) // dont send the initial ones since they're whack
+  return netplay_client->m_rollback->GetProgress();
+}
+
+void NetPlayClient::StepDesyncHasher(u64 frame, const u8* ram, u32 ram_size)
+{
+  std::lock_guard lk(crit_netplay_client);
+  if (netplay_client)
+    netplay_client->UpdateDesyncHasher(frame, ram, ram_size);
+}
+
+void NetPlayClient::UpdateDesyncHasher(u64 frame, const u8* ram, u32 ram_size)
+{
+  // Frames that ran with predicted input would hash differently than on the other clients
+  if (m_rollback)
     return;
 
-  u8 newId = checksumId + 11 & 0xf;  // send checksum from 5 seconds ago
+  std::lock_guard lk(m_desync_lock);
+  m_desync_frame = frame;
+
+  if (!m_desync_hasher || m_desync_hasher->GetRamSize() != ram_size)
+  {
+    // The bisectors refer to the old hasher
+    m_desync_bisectors.clear();
+    m_desync_hasher = std::make_unique<DesyncHasher>(ram_size);
+  }
+
+  if (m_desync_dump && frame >= m_desync_dump->frame)
+  {
+    WriteDesyncDump(*m_desync_dump, frame, ram);
+    m_desync_dump.reset();
+  }
+
+  const DesyncHasher::Round* const round = m_desync_hasher->Step(frame, ram);
+  if (!round)
+    return;
 
   sf::Packet packet;
-  packet << MessageID::Checksum;
-  packet << netplay_client->ourChecksum[newId]; 
-  packet << newId;
+  packet << MessageID::DesyncHashRoot;
+  packet << round->id;
+  packet << static_cast<sf::Uint64>(round->GetRoot());
+  SendAsync(std::move(packet));
 
-  netplay_client->SendAsync(std::move(packet));
+  for (auto& [pid, bisector] : m_desync_bisectors)
+  {
+    if (bisector.CheckPendingRoots())
+      OnDesyncFound(pid, bisector);
+  }
+  SendDesyncRequests();
+}
+
+void NetPlayClient::SendDesyncRequests()
+{
+  for (auto& [pid, bisector] : m_desync_bisectors)
+  {
+    if (const auto result = bisector.TakeResult())
+      OnDesyncBisected(pid, *result);
+
+    const auto request = bisector.TakeRequest();
+    if (!request)
+      continue;
+
+    sf::Packet packet;
+    packet << MessageID::DesyncHashRequest;
+    packet << pid << request->round << request->level << request->index;
+    SendAsync(std::move(packet));
+  }
+}
+
+void NetPlayClient::OnDesyncFound(PlayerId pid, const DesyncBisector& bisector)
+{
+  const DesyncHasher::Round* const round = m_desync_hasher->GetRound(bisector.GetDivergedRound());
+  const u64 frame = round ? round->first_frame : m_desync_frame;
+  const std::string player = GetPlayerName(pid);
+
+  INFO_LOG_FMT(NETPLAY, "RAM of player {} ({}) differs in round {} (frame {})", player, pid,
+               bisector.GetDivergedRound(), frame);
+  m_dialog->OnDesync(static_cast<u32>(frame), player);
+}
+
+void NetPlayClient::OnDesyncBisected(PlayerId pid, const DesyncBisector::Result& result)
+{
+  // Far enough ahead that every client is still before it when the request arrives
+  constexpr u64 DUMP_DELAY_FRAMES = 180;
+  const u64 dump_frame = m_desync_frame + DUMP_DELAY_FRAMES;
+  const std::string player = GetPlayerName(pid);
+
+  std::string report = fmt::format("Desync with {} in round {} (frames {}-{})\n", player,
+                                   result.round, result.first_frame,
+                                   result.first_frame + m_desync_hasher->GetFramesPerRound() - 1);
+  report += fmt::format("Diverged page groups: {}\n", result.mismatched_groups);
+  if (!result.pages.empty())
+  {
+    const DesyncBisector::PageMismatch& first = result.pages.front();
+    report += fmt::format("First mismatch: page {} (0x{:08x}) on frame {}\n", first.page,
+                          0x80000000 + first.page * DesyncHasher::PAGE_SIZE, first.frame);
+  }
+  for (const DesyncBisector::PageMismatch& page : result.pages)
+  {
+    report += fmt::format("0x{:08x}-0x{:08x} hashed on frame {}: {:016x} here, {:016x} remote\n",
+                          0x80000000 + page.page * DesyncHasher::PAGE_SIZE,
+                          0x80000000 + (page.page + 1) * DesyncHasher::PAGE_SIZE - 1, page.frame,
+                          page.local_hash, page.remote_hash);
+  }
+
+  const std::string path =
+      fmt::format("{}Desync/{}/report_{}.txt", File::GetUserPath(D_DUMP_IDX), dump_frame, pid);
+  File::CreateFullPath(path);
+  if (!File::WriteStringToFile(path, report))
+    ERROR_LOG_FMT(NETPLAY, "Could not write desync report {}", path);
+  INFO_LOG_FMT(NETPLAY, "{}", report);
+
+  if (result.pages.empty())
+  {
+    m_dialog->AppendChat(fmt::format("Could not narrow down the desync with {}.", player));
+    return;
+  }
+
+  m_dialog->AppendChat(fmt::format("Desync with {} first shows at 0x{:08x} on frame {}, dumping "
+                                   "RAM on frame {}.",
+                                   player,
+                                   0x80000000 + result.pages.front().page * DesyncHasher::PAGE_SIZE,
+                                   result.pages.front().frame, dump_frame));
+
+  sf::Packet packet;
+  packet << MessageID::DesyncDump;
+  packet << static_cast<sf::Uint64>(dump_frame) << result.round;
+  packet << static_cast<u32>(result.pages.size());
+  for (const DesyncBisector::PageMismatch& page : result.pages)
+    packet << page.page;
+  SendAsync(std::move(packet));
+}
+
+void NetPlayClient::WriteDesyncDump(const DesyncDump& dump, u64 frame, const u8* ram) const
+{
+  // One file per page, named after its address, so the dumps of two clients can be compared
+  const std::string dir =
+      fmt::format("{}Desync/{}/player{}/", File::GetUserPath(D_DUMP_IDX), dump.frame, m_pid);
+  File::CreateFullPath(dir);
+  for (u32 page : dump.pages)
+  {
+    const u32 offset = page * DesyncHasher::PAGE_SIZE;
+    if (offset >= m_desync_hasher->GetRamSize())
+      continue;
+
+    const u32 size = std::min(DesyncHasher::PAGE_SIZE, m_desync_hasher->GetRamSize() - offset);
+    File::IOFile file(fmt::format("{}{:08x}.bin", dir, 0x80000000 + offset), "wb");
+    if (!file.WriteBytes(ram + offset, size))
+      ERROR_LOG_FMT(NETPLAY, "Could not write desync dump to {}", dir);
+  }
+
+  if (frame != dump.frame)
+    WARN_LOG_FMT(NETPLAY, "Desync dump requested for frame {} was written on frame {}", dump.frame,
+                 frame);
+}
+
+std::string NetPlayClient::GetPlayerName(PlayerId pid)
+{
+  std::lock_guard lkp(m_crit.players);
+  const auto it = m_players.find(pid);
+  return it != m_players.end() ? it->second.name : "??";
 }
 
 void NetPlayClient::SendTimeBase()
@@ -2913,35 +3585,6 @@ bool NetPlayClient::DoAllPlayersHaveGame()
   });
 }
 
-static std::string SHA1Sum(const std::string& file_path, std::function<bool(int)> report_progress)
-{
-  std::vector<u8> data(8 * 1024 * 1024);
-  u64 read_offset = 0;
-
-  std::unique_ptr<DiscIO::BlobReader> file(DiscIO::CreateBlobReader(file_path));
-  u64 game_size = file->GetDataSize();
-
-  auto ctx = Common::SHA1::CreateContext();
-
-  while (read_offset < game_size)
-  {
-    size_t read_size = std::min(static_cast<u64>(data.size()), game_size - read_offset);
-    if (!file->Read(read_offset, read_size, data.data()))
-      return "";
-
-    ctx->Update(data.data(), read_size);
-    read_offset += read_size;
-
-    int progress =
-        static_cast<int>(static_cast<float>(read_offset) / static_cast<float>(game_size) * 100);
-    if (!report_progress(progress))
-      return "";
-  }
-
-  // Convert to hex
-  return fmt::format("{:02x}", fmt::join(ctx->Finish(), ""));
-}
-
 void NetPlayClient::ComputeGameDigest(const SyncIdentifier& sync_identifier)
 {
   if (m_should_compute_game_digest)
@@ -2968,7 +3611,9 @@ void NetPlayClient::ComputeGameDigest(const SyncIdentifier& sync_identifier)
   if (m_game_digest_thread.joinable())
     m_game_digest_thread.join();
   m_game_digest_thread = std::thread([this, file]() {
-    std::string sum = SHA1Sum(file, [&](int progress) {
+    // Unchanged games are only hashed once, the game list hashes them in the background too
+    UICommon::GameDigestCache& cache = UICommon::GameDigestCache::GetInstance();
+    std::string sum = cache.GetOrCompute(file, [&](int progress) {
       sf::Packet packet;
       packet << MessageID::GameDigestProgress;
       packet << progress;
@@ -2976,6 +3621,7 @@ void NetPlayClient::ComputeGameDigest(const SyncIdentifier& sync_identifier)
 
       return m_should_compute_game_digest;
     });
+    cache.Save();
 
     sf::Packet packet;
     packet << MessageID::GameDigestResult;
@@ -3049,6 +3695,11 @@ bool IsNetPlayRunning()
   return netplay_client != nullptr;
 }
 
+bool IsRollbackRunning()
+{
+  return netplay_client != nullptr && netplay_client->IsRollbackRunning();
+}
+
 void SetSIPollBatching(bool state)
 {
   s_si_poll_batching = state;
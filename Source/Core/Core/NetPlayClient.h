@@ -6,9 +6,11 @@
 #include <SFML/Network/Packet.hpp>
 #include <array>
 #include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <thread>
@@ -20,11 +22,16 @@
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayDesyncHasher.h"
+#include "Core/NetPlayPadBufferController.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayRedundantPads.h"
+#include "Core/NetPlayRollback.h"
+#include "Core/NetPlaySyncBlocks.h"
+#include "Core/NetPlayTiming.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 #include "Core/LocalPlayers.h"
-#include <Common/HttpRequest.h>
 
 class BootSessionData;
 
@@ -132,9 +139,20 @@ public:
   void ThreadFunc();
   void SendAsync(sf::Packet&& packet, u8 channel_id = DEFAULT_CHANNEL);
 
+  // Stands in for the emulated machine, so a client can run without emulation like in the
+  // loopback benchmark. Pads come from get_pad instead of the controllers and the emulation speed
+  // the client asks for goes to set_emulation_speed. The Rio account isn't validated and the
+  // client isn't made the one the emulated machine uses.
+  struct Headless
+  {
+    std::function<GCPadStatus(int local_pad)> get_pad;
+    std::function<void(float speed)> set_emulation_speed;
+  };
+
   NetPlayClient(const std::string& address, const u16 port, NetPlayUI* dialog,
                 const NetTraversalConfig& traversal_config,
-                LocalPlayers::LocalPlayers::Player* player, std::map<int, Tag::TagSet>* tagset_map);
+                LocalPlayers::LocalPlayers::Player* player, std::map<int, Tag::TagSet>* tagset_map,
+                std::optional<Headless> headless = std::nullopt);
   ~NetPlayClient();
 
   std::vector<const Player*> GetPlayers();
@@ -144,6 +162,7 @@ public:
 
   // Called from the GUI thread.
   bool IsConnected() const { return m_is_connected; }
+  bool IsRollbackRunning() const { return m_rollback != nullptr; }
   bool StartGame(const std::string& path);
   void InvokeStop();
   bool StopGame();
@@ -162,7 +181,6 @@ public:
   void RequestGolfControl();
   std::string GetCurrentGolfer();
   std::vector<std::string> v_ActiveGeckoCodes;
-  std::map<u8, u32> ourChecksum;
 
   // Send and receive pads values
   struct WiimoteDataBatchEntry
@@ -196,9 +214,23 @@ public:
   bool PortHasPlayerAssigned(int port);
 
   static void SendTimeBase();
-  static void SendChecksum(u8 checksumId, u64 frame, u32 checksum);
+  // Called from the CPU thread once per frame, hashes part of RAM for desync detection
+  static void StepDesyncHasher(u64 frame, const u8* ram, u32 ram_size);
   bool DoAllPlayersHaveGame();
 
+  // Called from the CPU thread between at-bats, when the pad buffer can change without notice
+  static void SendPadBufferSafePoint();
+  // Buffer changes the host made automatically since the last call
+  static std::vector<PadBufferController::Decision> TakePadBufferDecisions();
+  // Pad timing of the current game, nothing without a client
+  static std::optional<TimingSummary> GetTimingSummary();
+  // How often the unreliable pad channel beat the reliable one in the current game, nothing
+  // without a client
+  static std::optional<RedundantPadReceiver::Stats> GetPadTransportStats();
+  static void ResetTiming();
+  // Progress of the rollback session, nothing without one
+  static std::optional<RollbackSession::Progress> GetRollbackProgress();
+
   static std::string GetNetplayNames(u8 PortInt);
   static u32 sGetPlayersMaxPing();
   static std::map<int, LocalPlayers::LocalPlayers::Player> getNetplayerUserInfo();
@@ -237,6 +269,12 @@ protected:
   Common::SPSCQueue<AsyncQueueEntry, false> m_async_queue;
 
   std::array<Common::SPSCQueue<GCPadStatus>, 4> m_pad_buffer;
+  // Indexed by in-game pad, only local pads are pushed to
+  std::array<RedundantPadHistory, 4> m_redundant_pads;
+  RedundantPadReceiver m_redundant_receiver;
+  // The receiver counts from the start of the session, the game starts later
+  RedundantPadReceiver::Stats m_pad_transport_start;
+  TimingRecorder m_timing;
   std::array<Common::SPSCQueue<WiimoteEmu::SerializedWiimoteState>, 4> m_wiimote_buffer;
 
   std::array<GCPadStatus, 4> m_last_pad_status{};
@@ -245,6 +283,7 @@ protected:
   std::chrono::time_point<std::chrono::steady_clock> m_buffer_under_target_last;
 
   NetPlayUI* m_dialog = nullptr;
+  std::optional<Headless> m_headless;
 
   ENetHost* m_client = nullptr;
   ENetPeer* m_server = nullptr;
@@ -295,6 +334,10 @@ private:
   void SyncCodeResponse(bool success);
 
   bool PollLocalPad(int local_pad, sf::Packet& packet);
+  void SendPadData(sf::Packet&& packet);
+  bool GetRollbackPads(int pad_nb, bool batching, GCPadStatus* pad_status);
+  void RecordPadStatus(int pad_nb, GCPadStatus* pad_status);
+  void SetEmulationSpeed(float speed);
   void SendPadHostPoll(PadIndex pad_num);
 
   bool AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state,
@@ -327,9 +370,12 @@ private:
   void OnWiimoteMapping(sf::Packet& packet);
   void OnGBAConfig(sf::Packet& packet);
   void OnPadData(sf::Packet& packet);
+  void OnPadDataRedundant(sf::Packet& packet);
+  void PushRemotePad(PadIndex map, const GCPadStatus& pad);
   void OnPadHostData(sf::Packet& packet);
   void OnWiimoteData(sf::Packet& packet);
   void OnPadBuffer(sf::Packet& packet);
+  void OnPadBufferDecision(sf::Packet& packet);
   void OnHostInputAuthority(sf::Packet& packet);
   void OnGolfSwitch(sf::Packet& packet);
   void OnGolfPrepare(sf::Packet& packet);
@@ -343,6 +389,8 @@ private:
   void OnDesyncDetected(sf::Packet& packet);
   void OnSyncSaveData(sf::Packet& packet);
   void OnSyncSaveDataNotify(sf::Packet& packet);
+  void OnSyncSaveDataFiles(SyncSaveDataID sub_id, sf::Packet& packet);
+  void OnSyncSaveDataBlocks(sf::Packet& packet);
   void OnSyncSaveDataRaw(sf::Packet& packet);
   void OnSyncSaveDataGCI(sf::Packet& packet);
   void OnSyncSaveDataWii(sf::Packet& packet);
@@ -362,7 +410,10 @@ private:
   void OnSendCodesMsg(sf::Packet& packet);
   void OnCoinFlipMsg(sf::Packet& packet);
   void OnNightMsg(sf::Packet& packet);
-  void OnChecksumMsg(sf::Packet& packet);
+  void OnDesyncHashRoot(sf::Packet& packet);
+  void OnDesyncHashRequest(sf::Packet& packet);
+  void OnDesyncHashNodes(sf::Packet& packet);
+  void OnDesyncDump(sf::Packet& packet);
   void OnGameIDMsg(sf::Packet& packet);
   void OnStadiumMsg(sf::Packet& packet);
   void OnCourseMsg(sf::Packet& packet);
@@ -370,6 +421,25 @@ private:
 
   int framesAsGolfer = 0;
 
+  // Resimulated frames run without the speed limit
+  void SetRollbackFastForward(bool fast_forward);
+
+  // Pages every client writes out on the same frame once a desync was narrowed down
+  struct DesyncDump
+  {
+    u64 frame;
+    u32 round;
+    std::vector<u32> pages;
+  };
+
+  void UpdateDesyncHasher(u64 frame, const u8* ram, u32 ram_size);
+  // These expect m_desync_lock to be held
+  void SendDesyncRequests();
+  void OnDesyncFound(PlayerId pid, const DesyncBisector& bisector);
+  void OnDesyncBisected(PlayerId pid, const DesyncBisector::Result& result);
+  void WriteDesyncDump(const DesyncDump& dump, u64 frame, const u8* ram) const;
+  std::string GetPlayerName(PlayerId pid);
+
   bool m_is_connected = false;
   ConnectionState m_connection_state = ConnectionState::Failure;
 
@@ -389,6 +459,10 @@ private:
   Common::Event m_wait_on_input_event;
   u8 m_sync_save_data_count = 0;
   u8 m_sync_save_data_success_count = 0;
+  // Resolves the save data blocks the server left out because we kept them from an earlier sync
+  std::unique_ptr<SyncBlockDecoder> m_sync_save_data_decoder;
+  // Save data that needs kept blocks we couldn't read, handled again once the server sent them
+  std::vector<std::pair<SyncSaveDataID, sf::Packet>> m_sync_save_data_waiting;
   u16 m_sync_gecko_codes_count = 0;
   u16 m_sync_gecko_codes_success_count = 0;
   bool m_sync_gecko_codes_complete = false;
@@ -400,10 +474,25 @@ private:
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
 
+  // Desync detection, shared by the CPU thread and the NetPlay thread
+  std::mutex m_desync_lock;
+  std::unique_ptr<DesyncHasher> m_desync_hasher;
+  std::map<PlayerId, DesyncBisector> m_desync_bisectors;
+  std::optional<DesyncDump> m_desync_dump;
+  u64 m_desync_frame = 0;
+
+  std::mutex m_pad_buffer_decisions_lock;
+  std::vector<PadBufferController::Decision> m_pad_buffer_decisions;
+
+  // Only set in rollback mode
+  std::unique_ptr<RollbackSession> m_rollback;
+  bool m_rollback_fast_forward = false;
+  // Speed the current run layer had before fast forwarding, nothing if it had none
+  std::optional<float> m_speed_before_fast_forward;
+
   std::unique_ptr<IOS::HLE::FS::FileSystem> m_wii_sync_fs;
   std::vector<u64> m_wii_sync_titles;
   std::string m_wii_sync_redirect_folder;
-  Common::HttpRequest m_http{std::chrono::minutes{3}};
 };
 
 void NetPlay_Enable(NetPlayClient* const np);
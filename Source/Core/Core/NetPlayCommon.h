@@ -20,10 +20,19 @@ using namespace std::chrono_literals;
 // connection is disconnected
 constexpr std::chrono::milliseconds PEER_TIMEOUT = 30s;
 
-bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet);
-bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet);
-bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet);
-bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path);
-bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path);
-std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet);
+class SyncBlockDecoder;
+class SyncBlockEncoder;
+
+bool CompressFileIntoPacket(const std::string& file_path, SyncBlockEncoder& encoder,
+                            sf::Packet& packet);
+bool CompressFolderIntoPacket(const std::string& folder_path, SyncBlockEncoder& encoder,
+                              sf::Packet& packet);
+bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, SyncBlockEncoder& encoder,
+                              sf::Packet& packet);
+bool DecompressPacketIntoFile(sf::Packet& packet, SyncBlockDecoder& decoder,
+                              const std::string& file_path);
+bool DecompressPacketIntoFolder(sf::Packet& packet, SyncBlockDecoder& decoder,
+                                const std::string& folder_path);
+std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet,
+                                                          SyncBlockDecoder& decoder);
 }  // namespace NetPlay
@@ -0,0 +1,231 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayDesyncHasher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <xxhash.h>
+
+namespace NetPlay
+{
+DesyncHasher::DesyncHasher(u32 ram_size)
+    : m_ram_size(ram_size), m_num_pages((ram_size + PAGE_SIZE - 1) / PAGE_SIZE),
+      m_frames_per_round((m_num_pages + PAGES_PER_FRAME - 1) / PAGES_PER_FRAME),
+      m_pages(m_num_pages)
+{
+}
+
+const DesyncHasher::Round* DesyncHasher::Step(u64 frame, const u8* ram)
+{
+  const u32 round_id = static_cast<u32>(frame / m_frames_per_round);
+  const u32 first_page = static_cast<u32>(frame % m_frames_per_round) * PAGES_PER_FRAME;
+  if (round_id != m_round_id)
+  {
+    m_round_id = round_id;
+    m_pages_hashed = 0;
+  }
+
+  // A frame that runs again keeps the hashes from its first run, which is what the other
+  // clients hashed, and the round goes on from where it was
+  if (first_page < m_pages_hashed)
+    return nullptr;
+
+  // A skipped frame leaves pages that were never hashed, so the round can't be closed
+  if (first_page > m_pages_hashed)
+  {
+    m_pages_hashed = 0;
+    return nullptr;
+  }
+
+  const u32 last_page = std::min(first_page + PAGES_PER_FRAME, m_num_pages);
+  for (u32 page = first_page; page < last_page; ++page)
+  {
+    const u32 offset = page * PAGE_SIZE;
+    m_pages[page] = HashPage(ram + offset, std::min(PAGE_SIZE, m_ram_size - offset));
+  }
+  m_pages_hashed = last_page;
+
+  if (m_pages_hashed != m_num_pages)
+    return nullptr;
+
+  Round round{round_id, u64(round_id) * m_frames_per_round, {m_pages}};
+  while (round.levels.back().size() > 1)
+    round.levels.push_back(HashLevel(round.levels.back()));
+
+  m_history.push_back(std::move(round));
+  if (m_history.size() > HISTORY_ROUNDS)
+    m_history.pop_front();
+  return &m_history.back();
+}
+
+const DesyncHasher::Round* DesyncHasher::GetRound(u32 id) const
+{
+  const auto it = std::find_if(m_history.begin(), m_history.end(),
+                               [id](const Round& round) { return round.id == id; });
+  return it != m_history.end() ? &*it : nullptr;
+}
+
+std::optional<std::vector<u64>> DesyncHasher::GetChildren(u32 round, u8 level, u32 index) const
+{
+  const Round* const found = GetRound(round);
+  if (!found || level == 0 || level >= found->levels.size())
+    return std::nullopt;
+
+  const std::vector<u64>& children = found->levels[level - 1];
+  const size_t first = size_t(index) * FANOUT;
+  if (first >= children.size())
+    return std::nullopt;
+  const size_t last = std::min(first + FANOUT, children.size());
+  return std::vector<u64>(children.begin() + first, children.begin() + last);
+}
+
+u64 DesyncHasher::GetPageFrame(const Round& round, u32 page) const
+{
+  return round.first_frame + page / PAGES_PER_FRAME;
+}
+
+u64 DesyncHasher::HashPage(const u8* data, u32 size)
+{
+  // XXH3 picks the widest vector unit available (SSE2/AVX2/NEON)
+  return XXH3_64bits(data, size);
+}
+
+std::vector<u64> DesyncHasher::HashLevel(const std::vector<u64>& children)
+{
+  std::vector<u64> parents;
+  parents.reserve((children.size() + FANOUT - 1) / FANOUT);
+  for (size_t first = 0; first < children.size(); first += FANOUT)
+  {
+    const size_t count = std::min<size_t>(FANOUT, children.size() - first);
+    parents.push_back(XXH3_64bits(children.data() + first, count * sizeof(u64)));
+  }
+  return parents;
+}
+
+bool DesyncBisector::OnRemoteRoot(u32 round, u64 root)
+{
+  if (m_state != State::Comparing)
+    return false;
+
+  if (!m_hasher.GetRound(round))
+  {
+    // Ours isn't done yet. Rounds we never close are dropped once enough newer ones arrived
+    m_pending_roots[round] = root;
+    if (m_pending_roots.size() > DesyncHasher::HISTORY_ROUNDS)
+      m_pending_roots.erase(m_pending_roots.begin());
+    return false;
+  }
+  return Compare(round, root);
+}
+
+bool DesyncBisector::CheckPendingRoots()
+{
+  for (auto it = m_pending_roots.begin(); it != m_pending_roots.end() && m_state == State::Comparing;)
+  {
+    if (!m_hasher.GetRound(it->first))
+    {
+      ++it;
+      continue;
+    }
+
+    const auto [round, root] = *it;
+    it = m_pending_roots.erase(it);
+    if (Compare(round, root))
+      return true;
+  }
+  return false;
+}
+
+bool DesyncBisector::Compare(u32 round, u64 root)
+{
+  const DesyncHasher::Round* const ours = m_hasher.GetRound(round);
+  if (ours->GetRoot() == root)
+    return false;
+
+  m_pending_roots.clear();
+  m_state = State::Bisecting;
+  m_diverged_round = round;
+  if (ours->GetTopLevel() == 0)
+  {
+    Finish(round, {{0, ours->first_frame, ours->GetRoot(), root}});
+    return true;
+  }
+
+  m_request = Request{round, ours->GetTopLevel(), 0};
+  return true;
+}
+
+std::optional<DesyncBisector::Request> DesyncBisector::TakeRequest()
+{
+  if (m_state != State::Bisecting || !m_request || m_request_sent)
+    return std::nullopt;
+  m_request_sent = true;
+  return m_request;
+}
+
+void DesyncBisector::OnRemoteChildren(u32 round, u8 level, u32 index,
+                                      const std::vector<u64>& hashes)
+{
+  if (m_state != State::Bisecting || !m_request || m_request->round != round ||
+      m_request->level != level || m_request->index != index)
+  {
+    return;
+  }
+
+  // The peer no longer has the round, or the trees don't have the same shape
+  const std::optional<std::vector<u64>> ours = m_hasher.GetChildren(round, level, index);
+  if (!ours || ours->size() != hashes.size())
+  {
+    Finish(round, {});
+    return;
+  }
+
+  std::vector<u32> mismatched;
+  for (u32 i = 0; i < hashes.size(); ++i)
+  {
+    if ((*ours)[i] != hashes[i])
+      mismatched.push_back(i);
+  }
+  if (mismatched.empty())
+  {
+    Finish(round, {});
+    return;
+  }
+
+  const u32 first_child = index * DesyncHasher::FANOUT;
+  if (level == 1)
+  {
+    const DesyncHasher::Round& ours_round = *m_hasher.GetRound(round);
+    std::vector<PageMismatch> pages;
+    for (u32 i : mismatched)
+    {
+      const u32 page = first_child + i;
+      pages.push_back({page, m_hasher.GetPageFrame(ours_round, page), (*ours)[i], hashes[i]});
+    }
+    Finish(round, std::move(pages));
+    return;
+  }
+
+  if (level == 2)
+    m_mismatched_groups = static_cast<u32>(mismatched.size());
+
+  m_request = Request{round, static_cast<u8>(level - 1), first_child + mismatched.front()};
+  m_request_sent = false;
+}
+
+std::optional<DesyncBisector::Result> DesyncBisector::TakeResult()
+{
+  return std::exchange(m_result, std::nullopt);
+}
+
+void DesyncBisector::Finish(u32 round, std::vector<PageMismatch> pages)
+{
+  const DesyncHasher::Round* const ours = m_hasher.GetRound(round);
+  m_result = Result{round, ours ? ours->first_frame : 0, std::move(pages),
+                    std::max<u32>(m_mismatched_groups, 1)};
+  m_request.reset();
+  m_state = State::Done;
+}
+}  // namespace NetPlay
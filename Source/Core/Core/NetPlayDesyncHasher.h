@@ -0,0 +1,148 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace NetPlay
+{
+// Hashes emulated RAM for desync detection.
+//
+// RAM is split into fixed size pages, and a few pages are hashed every frame so the cost per frame
+// stays small. Which pages are hashed on a frame only depends on the frame number, so every client
+// hashes the same page on the same frame. Once all pages have been hashed, the round is closed
+// and its page hashes are folded into a tree with FANOUT children per node. Peers exchange only
+// the root of each round; when the roots differ, DesyncBisector walks the tree down to the pages
+// that differ, asking the peer for one node's children per round trip.
+class DesyncHasher
+{
+public:
+  static constexpr u32 PAGE_SIZE = 0x10000;
+  static constexpr u32 PAGES_PER_FRAME = 8;
+  static constexpr u32 FANOUT = 16;
+  // Closed rounds kept around for peers that are behind or bisecting
+  static constexpr size_t HISTORY_ROUNDS = 32;
+
+  struct Round
+  {
+    u32 id;
+    u64 first_frame;
+    // levels[0] holds the page hashes, levels.back() only the root
+    std::vector<std::vector<u64>> levels;
+
+    u64 GetRoot() const { return levels.back()[0]; }
+    u8 GetTopLevel() const { return static_cast<u8>(levels.size() - 1); }
+  };
+
+  explicit DesyncHasher(u32 ram_size);
+
+  // Hashes this frame's pages. Returns the round closed by them, if any. A frame that was already
+  // hashed this round is skipped
+  const Round* Step(u64 frame, const u8* ram);
+
+  const Round* GetRound(u32 id) const;
+  // Hashes of the children of node index on level, nothing if there is no such node
+  std::optional<std::vector<u64>> GetChildren(u32 round, u8 level, u32 index) const;
+
+  u32 GetRamSize() const { return m_ram_size; }
+  u32 GetNumPages() const { return m_num_pages; }
+  u32 GetFramesPerRound() const { return m_frames_per_round; }
+  // Frame on which page was hashed in round
+  u64 GetPageFrame(const Round& round, u32 page) const;
+
+  static u64 HashPage(const u8* data, u32 size);
+  // One level up the tree
+  static std::vector<u64> HashLevel(const std::vector<u64>& children);
+
+private:
+  u32 m_ram_size;
+  u32 m_num_pages;
+  u32 m_frames_per_round;
+
+  // Round being hashed
+  u32 m_round_id = 0;
+  u32 m_pages_hashed = 0;
+  std::vector<u64> m_pages;
+
+  std::deque<Round> m_history;
+};
+
+// Narrows a mismatch with one peer down to the first diverging pages
+class DesyncBisector
+{
+public:
+  // Ask the peer for the children of a node
+  struct Request
+  {
+    u32 round;
+    u8 level;
+    u32 index;
+  };
+
+  struct PageMismatch
+  {
+    u32 page;
+    u64 frame;
+    u64 local_hash;
+    u64 remote_hash;
+  };
+
+  struct Result
+  {
+    u32 round;
+    u64 first_frame;
+    // Within the first diverging group of FANOUT pages, in page order. The first one is the first
+    // page that differs, hashed on the first frame that does
+    std::vector<PageMismatch> pages;
+    // Mismatching nodes one level above the pages, a rough count of how far the desync spread
+    u32 mismatched_groups;
+  };
+
+  explicit DesyncBisector(const DesyncHasher& hasher) : m_hasher(hasher) {}
+
+  // A root the peer sent. Returns true if it differs from ours
+  bool OnRemoteRoot(u32 round, u64 root);
+  // Checks roots that arrived before ours were ready. Returns true on the first mismatch
+  bool CheckPendingRoots();
+
+  // The next node to ask the peer about, once a mismatch was found
+  std::optional<Request> TakeRequest();
+  // The peer's answer to the last request
+  void OnRemoteChildren(u32 round, u8 level, u32 index, const std::vector<u64>& hashes);
+
+  std::optional<Result> TakeResult();
+
+  // Only the first diverging round is bisected
+  bool IsBisecting() const { return m_state == State::Bisecting; }
+  bool HasDiverged() const { return m_state != State::Comparing; }
+  // Valid once HasDiverged
+  u32 GetDivergedRound() const { return m_diverged_round; }
+
+private:
+  enum class State
+  {
+    Comparing,
+    Bisecting,
+    Done,
+  };
+
+  bool Compare(u32 round, u64 root);
+  void Finish(u32 round, std::vector<PageMismatch> pages);
+
+  const DesyncHasher& m_hasher;
+  State m_state = State::Comparing;
+  u32 m_diverged_round = 0;
+  std::map<u32, u64> m_pending_roots;
+  // Node being asked about, and whether it was handed out yet
+  std::optional<Request> m_request;
+  bool m_request_sent = false;
+  u32 m_mismatched_groups = 0;
+  std::optional<Result> m_result;
+};
+}  // namespace NetPlay
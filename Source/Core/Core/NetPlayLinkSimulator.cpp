@@ -0,0 +1,286 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayLinkSimulator.h"
+
+#include <algorithm>
+#include <array>
+
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Common/Timer.h"
+
+namespace NetPlay
+{
+namespace
+{
+constexpr size_t MAX_DATAGRAM_SIZE = ENET_PROTOCOL_MAXIMUM_MTU;
+}
+
+LinkShaper::LinkShaper(const LinkConditions& conditions, u32 seed)
+    : m_conditions(conditions), m_random(seed)
+{
+}
+
+void LinkShaper::Submit(std::vector<u8> datagram, u64 now_us)
+{
+  ++m_stats.submitted;
+  if (m_conditions.loss > 0 && m_chance(m_random) < m_conditions.loss)
+  {
+    ++m_stats.dropped;
+    return;
+  }
+
+  double delay_ms = m_conditions.latency_ms;
+  if (m_conditions.jitter_ms > 0)
+  {
+    delay_ms += std::uniform_real_distribution<double>(-m_conditions.jitter_ms,
+                                                       m_conditions.jitter_ms)(m_random);
+  }
+  u64 release_us = now_us + static_cast<u64>(std::max(delay_ms, 0.0) * 1000);
+
+  if (m_conditions.reorder > 0 && m_chance(m_random) < m_conditions.reorder)
+  {
+    ++m_stats.reordered;
+    release_us += static_cast<u64>((2 * m_conditions.jitter_ms + REORDER_HOLD_MS) * 1000);
+    m_pending.emplace(release_us, std::move(datagram));
+    return;
+  }
+
+  release_us = std::max(release_us, m_last_release_us);
+  m_last_release_us = release_us;
+  m_pending.emplace(release_us, std::move(datagram));
+}
+
+std::optional<std::vector<u8>> LinkShaper::PopReady(u64 now_us)
+{
+  if (m_pending.empty() || m_pending.begin()->first > now_us)
+    return std::nullopt;
+
+  std::vector<u8> datagram = std::move(m_pending.begin()->second);
+  m_pending.erase(m_pending.begin());
+  return datagram;
+}
+
+std::optional<u64> LinkShaper::GetNextReleaseUs() const
+{
+  if (m_pending.empty())
+    return std::nullopt;
+  return m_pending.begin()->first;
+}
+
+LinkSimulator::LinkSimulator(const ENetAddress& server, const LinkConditions& upstream,
+                             const LinkConditions& downstream, u32 seed)
+    : m_server(server), m_upstream_conditions(upstream), m_downstream_conditions(downstream),
+      m_seed(seed)
+{
+}
+
+LinkSimulator::~LinkSimulator()
+{
+  Stop();
+}
+
+bool LinkSimulator::Start(u16 listen_port)
+{
+  m_listen_socket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+  if (m_listen_socket == ENET_SOCKET_NULL)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Link simulator: failed to create a socket");
+    return false;
+  }
+
+  ENetAddress address{};
+  address.host = ENET_HOST_ANY;
+  address.port = listen_port;
+  if (enet_socket_bind(m_listen_socket, &address) != 0 ||
+      enet_socket_get_address(m_listen_socket, &address) != 0)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Link simulator: failed to listen on port {}", listen_port);
+    enet_socket_destroy(m_listen_socket);
+    m_listen_socket = ENET_SOCKET_NULL;
+    return false;
+  }
+  enet_socket_set_option(m_listen_socket, ENET_SOCKOPT_NONBLOCK, 1);
+  m_listen_port = address.port;
+
+  m_running.Set();
+  m_thread = std::thread(&LinkSimulator::ThreadFunc, this);
+  return true;
+}
+
+void LinkSimulator::Stop()
+{
+  if (!m_running.TestAndClear())
+    return;
+
+  m_thread.join();
+
+  for (const std::unique_ptr<Flow>& flow : m_flows)
+    enet_socket_destroy(flow->server_socket);
+  m_flows.clear();
+  enet_socket_destroy(m_listen_socket);
+  m_listen_socket = ENET_SOCKET_NULL;
+}
+
+LinkSimulator::Stats LinkSimulator::GetStats() const
+{
+  std::lock_guard lk(m_stats_lock);
+  return m_stats;
+}
+
+void LinkSimulator::ThreadFunc()
+{
+  Common::SetCurrentThreadName("NetPlay Link Simulator");
+
+  while (m_running.IsSet())
+  {
+    // Wait for datagrams until the next one is due, at most a millisecond so Stop gets noticed
+    u64 now_us = Common::Timer::NowUs();
+    u64 timeout_us = 1000;
+    for (const std::unique_ptr<Flow>& flow : m_flows)
+    {
+      for (const LinkShaper* shaper : {&flow->upstream, &flow->downstream})
+      {
+        if (const std::optional<u64> release_us = shaper->GetNextReleaseUs())
+          timeout_us = std::min(timeout_us, *release_us > now_us ? *release_us - now_us : 0);
+      }
+    }
+
+    ENetSocketSet read_set;
+    ENET_SOCKETSET_EMPTY(read_set);
+    ENET_SOCKETSET_ADD(read_set, m_listen_socket);
+    ENetSocket max_socket = m_listen_socket;
+    for (const std::unique_ptr<Flow>& flow : m_flows)
+    {
+      ENET_SOCKETSET_ADD(read_set, flow->server_socket);
+      max_socket = std::max(max_socket, flow->server_socket);
+    }
+    if (enet_socketset_select(max_socket, &read_set, nullptr,
+                              static_cast<enet_uint32>(timeout_us / 1000)) < 0)
+    {
+      ERROR_LOG_FMT(NETPLAY, "Link simulator: select failed");
+      break;
+    }
+
+    now_us = Common::Timer::NowUs();
+    if (ENET_SOCKETSET_CHECK(read_set, m_listen_socket))
+      ReceiveFromClients(now_us);
+    for (const std::unique_ptr<Flow>& flow : m_flows)
+    {
+      if (ENET_SOCKETSET_CHECK(read_set, flow->server_socket))
+        ReceiveFromServer(*flow, now_us);
+    }
+
+    Release(Common::Timer::NowUs());
+    UpdateStats();
+  }
+}
+
+LinkSimulator::Flow* LinkSimulator::GetFlow(const ENetAddress& client)
+{
+  const auto it = std::find_if(m_flows.begin(), m_flows.end(), [&](const auto& flow) {
+    return flow->client.host == client.host && flow->client.port == client.port;
+  });
+  if (it != m_flows.end())
+    return it->get();
+
+  const ENetSocket socket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+  if (socket == ENET_SOCKET_NULL)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Link simulator: failed to create a socket for a new client");
+    return nullptr;
+  }
+
+  ENetAddress address{};
+  address.host = ENET_HOST_ANY;
+  address.port = 0;
+  if (enet_socket_bind(socket, &address) != 0)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Link simulator: failed to bind a socket for a new client");
+    enet_socket_destroy(socket);
+    return nullptr;
+  }
+  enet_socket_set_option(socket, ENET_SOCKOPT_NONBLOCK, 1);
+
+  // Every flow and direction gets its own random sequence
+  const u32 seed = m_seed + static_cast<u32>(m_flows.size()) * 2;
+  m_flows.push_back(std::make_unique<Flow>(Flow{client, socket,
+                                                LinkShaper(m_upstream_conditions, seed),
+                                                LinkShaper(m_downstream_conditions, seed + 1)}));
+  INFO_LOG_FMT(NETPLAY, "Link simulator: new client on port {}", client.port);
+  return m_flows.back().get();
+}
+
+void LinkSimulator::ReceiveFromClients(u64 now_us)
+{
+  std::array<u8, MAX_DATAGRAM_SIZE> data;
+  while (true)
+  {
+    ENetBuffer buffer;
+    buffer.data = data.data();
+    buffer.dataLength = data.size();
+    ENetAddress source;
+    const int received = enet_socket_receive(m_listen_socket, &source, &buffer, 1);
+    if (received <= 0)
+      return;
+
+    if (Flow* flow = GetFlow(source))
+      flow->upstream.Submit(std::vector<u8>(data.begin(), data.begin() + received), now_us);
+  }
+}
+
+void LinkSimulator::ReceiveFromServer(Flow& flow, u64 now_us)
+{
+  std::array<u8, MAX_DATAGRAM_SIZE> data;
+  while (true)
+  {
+    ENetBuffer buffer;
+    buffer.data = data.data();
+    buffer.dataLength = data.size();
+    ENetAddress source;
+    const int received = enet_socket_receive(flow.server_socket, &source, &buffer, 1);
+    if (received <= 0)
+      return;
+
+    flow.downstream.Submit(std::vector<u8>(data.begin(), data.begin() + received), now_us);
+  }
+}
+
+void LinkSimulator::Release(u64 now_us)
+{
+  const auto send = [](ENetSocket socket, const ENetAddress& address, std::vector<u8>& datagram) {
+    ENetBuffer buffer;
+    buffer.data = datagram.data();
+    buffer.dataLength = datagram.size();
+    enet_socket_send(socket, &address, &buffer, 1);
+  };
+
+  for (const std::unique_ptr<Flow>& flow : m_flows)
+  {
+    while (std::optional<std::vector<u8>> datagram = flow->upstream.PopReady(now_us))
+      send(flow->server_socket, m_server, *datagram);
+    while (std::optional<std::vector<u8>> datagram = flow->downstream.PopReady(now_us))
+      send(m_listen_socket, flow->client, *datagram);
+  }
+}
+
+void LinkSimulator::UpdateStats()
+{
+  Stats stats;
+  stats.clients = m_flows.size();
+  for (const std::unique_ptr<Flow>& flow : m_flows)
+  {
+    for (auto [total, shaper] : {std::pair{&stats.upstream, &flow->upstream},
+                                 std::pair{&stats.downstream, &flow->downstream}})
+    {
+      total->submitted += shaper->GetStats().submitted;
+      total->dropped += shaper->GetStats().dropped;
+      total->reordered += shaper->GetStats().reordered;
+    }
+  }
+
+  std::lock_guard lk(m_stats_lock);
+  m_stats = stats;
+}
+}  // namespace NetPlay
@@ -0,0 +1,130 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <enet/enet.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+
+namespace NetPlay
+{
+// What a simulated network does to the datagrams going one way
+struct LinkConditions
+{
+  double latency_ms = 0;
+  // Each datagram is delayed by up to this much more or less than the latency
+  double jitter_ms = 0;
+  // Probabilities from 0 to 1
+  double loss = 0;
+  double reorder = 0;
+};
+
+// Delays, drops and reorders datagrams going one way.
+//
+// Without reordering, jitter never lets a datagram overtake the one sent before it, like on most
+// real links. A reordered datagram is instead held back long enough for the next ones to pass it.
+class LinkShaper
+{
+public:
+  struct Stats
+  {
+    u64 submitted = 0;
+    u64 dropped = 0;
+    u64 reordered = 0;
+  };
+
+  // Extra hold for reordered datagrams, on top of twice the jitter
+  static constexpr double REORDER_HOLD_MS = 4.0;
+
+  LinkShaper(const LinkConditions& conditions, u32 seed);
+
+  void Submit(std::vector<u8> datagram, u64 now_us);
+  // The next datagram due at now_us, in the order they are due
+  std::optional<std::vector<u8>> PopReady(u64 now_us);
+  std::optional<u64> GetNextReleaseUs() const;
+
+  const Stats& GetStats() const { return m_stats; }
+
+private:
+  LinkConditions m_conditions;
+  std::mt19937 m_random;
+  std::uniform_real_distribution<double> m_chance{0.0, 1.0};
+
+  // Datagrams due at the same time keep the order they were submitted in
+  std::multimap<u64, std::vector<u8>> m_pending;
+  u64 m_last_release_us = 0;
+  Stats m_stats;
+};
+
+// UDP relay in front of a NetPlay server that shapes the traffic of every client going through
+// it, so latency, jitter, loss and reordering can be reproduced on a single machine.
+//
+// Clients connect to the listen port instead of the server. Each client gets its own socket
+// towards the server, so the server sees them as separate peers.
+class LinkSimulator
+{
+public:
+  struct Stats
+  {
+    u64 clients = 0;
+    LinkShaper::Stats upstream;
+    LinkShaper::Stats downstream;
+  };
+
+  LinkSimulator(const ENetAddress& server, const LinkConditions& upstream,
+                const LinkConditions& downstream, u32 seed = 0);
+  ~LinkSimulator();
+
+  LinkSimulator(const LinkSimulator&) = delete;
+  LinkSimulator& operator=(const LinkSimulator&) = delete;
+
+  // Port 0 picks a free one, see GetListenPort
+  bool Start(u16 listen_port);
+  void Stop();
+
+  u16 GetListenPort() const { return m_listen_port; }
+  Stats GetStats() const;
+
+private:
+  struct Flow
+  {
+    ENetAddress client;
+    ENetSocket server_socket;
+    LinkShaper upstream;
+    LinkShaper downstream;
+  };
+
+  void ThreadFunc();
+  Flow* GetFlow(const ENetAddress& client);
+  void ReceiveFromClients(u64 now_us);
+  void ReceiveFromServer(Flow& flow, u64 now_us);
+  void Release(u64 now_us);
+  void UpdateStats();
+
+  ENetAddress m_server;
+  LinkConditions m_upstream_conditions;
+  LinkConditions m_downstream_conditions;
+  u32 m_seed;
+
+  ENetSocket m_listen_socket = ENET_SOCKET_NULL;
+  u16 m_listen_port = 0;
+  std::vector<std::unique_ptr<Flow>> m_flows;
+
+  std::thread m_thread;
+  Common::Flag m_running;
+
+  mutable std::mutex m_stats_lock;
+  Stats m_stats;
+};
+}  // namespace NetPlay
@@ -0,0 +1,418 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayLoopbackBenchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+#include <enet/enet.h>
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/Event.h"
+#include "Common/Logging/Log.h"
+#include "Common/TagSet.h"
+#include "Common/Thread.h"
+#include "Common/Timer.h"
+#include "Core/Config/NetplaySettings.h"
+#include "Core/LocalPlayers.h"
+#include "Core/NetPlayClient.h"
+#include "Core/NetPlayProto.h"
+#include "Core/NetPlayServer.h"
+
+namespace NetPlay
+{
+namespace
+{
+constexpr u64 FRAME_US = 1000000 / 60;
+// Getting the pads of a frame taking this long is counted as a stall
+constexpr u64 STALL_THRESHOLD_US = 1000;
+// A player getting no pads this long gives up
+constexpr u64 STALL_TIMEOUT_US = 10000000;
+constexpr u64 START_TIMEOUT_US = 10000000;
+constexpr u32 MAX_PLAYERS = 4;
+
+double Mean(const std::vector<u64>& values_us)
+{
+  if (values_us.empty())
+    return 0;
+  return std::accumulate(values_us.begin(), values_us.end(), 0.0) / values_us.size() / 1000;
+}
+
+double Percentile95(std::vector<u64> values_us)
+{
+  if (values_us.empty())
+    return 0;
+  const size_t rank = values_us.size() * 95 / 100;
+  std::nth_element(values_us.begin(), values_us.begin() + rank, values_us.end());
+  return values_us[rank] / 1000.0;
+}
+
+// Inputs carry the number of the poll they come from in the sticks, so whoever uses them can look
+// up when they were polled
+GCPadStatus EncodeInput(u32 poll)
+{
+  GCPadStatus pad;
+  pad.stickX = static_cast<u8>(poll);
+  pad.stickY = static_cast<u8>(poll >> 8);
+  pad.substickX = static_cast<u8>(poll >> 16);
+  pad.substickY = static_cast<u8>(poll >> 24);
+  return pad;
+}
+
+u32 DecodeInput(const GCPadStatus& pad)
+{
+  return pad.stickX | pad.stickY << 8 | pad.substickX << 16 | static_cast<u32>(pad.substickY) << 24;
+}
+
+// By pad, the time of every poll of its player
+using PollTimes = std::array<std::vector<std::atomic<u64>>, MAX_PLAYERS>;
+
+// Takes the place of the NetPlay dialog, there is nothing to show or boot
+class HeadlessUI : public NetPlayUI
+{
+public:
+  void BootGame(const std::string& filename,
+                std::unique_ptr<BootSessionData> boot_session_data) override
+  {
+  }
+  void StopGame() override {}
+  bool IsHosting() const override { return false; }
+
+  void Update() override {}
+  void AppendChat(const std::string& msg) override {}
+
+  void OnMsgChangeGame(const SyncIdentifier& sync_identifier,
+                       const std::string& netplay_name) override
+  {
+  }
+  void OnMsgChangeGBARom(int pad, const GBAConfig& config) override {}
+  void OnMsgStartGame() override {}
+  void OnMsgStopGame() override {}
+  void OnMsgPowerButton() override {}
+  void OnPlayerConnect(const std::string& player) override {}
+  void OnPlayerDisconnect(const std::string& player) override {}
+  void OnPadBufferChanged(u32 buffer) override {}
+  void OnHostInputAuthorityChanged(bool enabled) override {}
+  void OnDesync(u32 frame, const std::string& player) override {}
+  void OnConnectionLost() override { ERROR_LOG_FMT(NETPLAY, "Benchmark: connection lost"); }
+  void OnConnectionError(const std::string& message) override
+  {
+    ERROR_LOG_FMT(NETPLAY, "Benchmark: {}", message);
+  }
+  void OnTraversalError(Common::TraversalClient::FailureReason error) override {}
+  void OnTraversalStateChanged(Common::TraversalClient::State state) override {}
+  void OnGameStartAborted() override {}
+  void OnGolferChanged(bool is_golfer, const std::string& golfer_name) override {}
+  void OnGameMode(std::string mode, std::string description,
+                  std::vector<std::string> tags) override
+  {
+  }
+  void StartingMsg(bool is_tagset) override {}
+  void OnCoinFlipResult(int coinFlip) override {}
+  void OnNightResult(bool is_night) override {}
+  void OnDisableReplaysResult(bool disable) override {}
+  void OnActiveGeckoCodes(std::string codeStr) override {}
+  void OnRandomStadiumResult(int stadium) override {}
+  void OnCourseResult(std::string message) override {}
+  bool IsSpectating() override { return false; }
+  void SetSpectating(bool spectating) override {}
+  void OnTtlDetermined(u8 ttl) override {}
+
+  bool IsRecording() override { return false; }
+  std::shared_ptr<const UICommon::GameFile>
+  FindGameFile(const SyncIdentifier& sync_identifier,
+               SyncIdentifierComparison* found = nullptr) override
+  {
+    return nullptr;
+  }
+  std::string FindGBARomPath(const std::array<u8, 20>& hash, std::string_view title,
+                             int device_number) override
+  {
+    return {};
+  }
+  void ShowGameDigestDialog(const std::string& title) override {}
+  void SetGameDigestProgress(int pid, int progress) override {}
+  void SetGameDigestResult(int pid, const std::string& result) override {}
+  void AbortGameDigest() override {}
+
+  void OnIndexAdded(bool success, std::string error) override {}
+  void OnIndexRefreshFailed(std::string error) override {}
+
+  void ShowChunkedProgressDialog(const std::string& title, u64 data_size,
+                                 const std::vector<int>& players) override
+  {
+  }
+  void HideChunkedProgressDialog() override {}
+  void SetChunkedProgress(int pid, u64 progress) override {}
+
+  void SetHostWiiSyncData(std::vector<u64> titles, std::string redirect_folder) override {}
+};
+
+// A NetPlayClient with a player on pad pid - 1, run without emulation
+class BenchmarkPlayer final : public HeadlessUI
+{
+public:
+  BenchmarkPlayer(const BenchmarkSettings& settings, PlayerId pid, PollTimes& poll_times)
+      : m_settings(settings), m_pid(pid), m_poll_times(poll_times)
+  {
+    m_account.username = fmt::format("Player {}", pid);
+  }
+
+  bool Connect(u16 port)
+  {
+    NetPlayClient::Headless headless;
+    headless.get_pad = [this](int local_pad) { return PollInput(); };
+    headless.set_emulation_speed = [this](float speed) { m_unthrottled = speed == 0; };
+
+    m_client = std::make_unique<NetPlayClient>("127.0.0.1", port, this, NetTraversalConfig{},
+                                               &m_account, &m_tag_sets, std::move(headless));
+    return m_client->IsConnected();
+  }
+
+  void OnMsgStartGame() override { m_start_event.Set(); }
+
+  // Like booting the game, once the server said to
+  bool StartGame()
+  {
+    return m_start_event.WaitFor(std::chrono::microseconds(START_TIMEOUT_US)) &&
+           m_client->StartGame("");
+  }
+
+  void Run()
+  {
+    Common::SetCurrentThreadName("NetPlay Benchmark Player");
+
+    const u64 start_us = Common::Timer::NowUs();
+    u64 next_frame_us = start_us;
+    m_last_frame_us = start_us;
+
+    while (m_result.frames < m_settings.frames && RunFrame())
+    {
+      ++m_result.frames;
+      m_last_frame_us = Common::Timer::NowUs();
+
+      // The buffer running over the target lifts the speed limit, like for the emulation
+      next_frame_us += FRAME_US;
+      const u64 now_us = Common::Timer::NowUs();
+      if (m_unthrottled || next_frame_us <= now_us)
+      {
+        // Running late doesn't get made up for, like the emulation throttle
+        next_frame_us = now_us;
+        continue;
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(next_frame_us - now_us));
+    }
+
+    m_result.seconds = (Common::Timer::NowUs() - start_us) / 1000000.0;
+
+    // Whoever is done first ends the game for everyone, like quitting it does
+    if (m_result.frames == m_settings.frames)
+      m_client->RequestStopGame();
+    m_done = true;
+  }
+
+  // Called from another thread, stops a player that got no pads for too long
+  void CheckStalled(u64 now_us)
+  {
+    if (m_done || m_timed_out || now_us - m_last_frame_us < STALL_TIMEOUT_US)
+      return;
+
+    m_timed_out = true;
+    m_client->Stop();
+  }
+
+  bool IsDone() const { return m_done; }
+
+  BenchmarkPlayerResult GetResult() const
+  {
+    BenchmarkPlayerResult result = m_result;
+    result.timed_out = m_timed_out;
+    result.local_delay_ms = Mean(m_local_delays_us);
+    result.local_delay_p95_ms = Percentile95(m_local_delays_us);
+    result.remote_delay_ms = Mean(m_remote_delays_us);
+    result.remote_delay_p95_ms = Percentile95(m_remote_delays_us);
+    return result;
+  }
+
+private:
+  bool RunFrame()
+  {
+    // Golf mode passes the golfer on to every player in turn
+    if (m_settings.mode == BenchmarkMode::Golf && m_settings.golf_switch_frames != 0 &&
+        m_result.frames != 0 && m_result.frames % m_settings.golf_switch_frames == 0 &&
+        m_result.frames / m_settings.golf_switch_frames % m_settings.players == m_pid - 1u)
+    {
+      m_client->RequestGolfControl();
+    }
+
+    // The pads every frame gets from the emulated machine, the first one polls ours
+    for (int pad = 0; pad < static_cast<int>(m_settings.players); ++pad)
+    {
+      GCPadStatus status;
+      const u64 call_us = Common::Timer::NowUs();
+      if (!m_client->GetNetPads(pad, true, &status))
+        return false;
+
+      const u64 now_us = Common::Timer::NowUs();
+      if (now_us - call_us >= STALL_THRESHOLD_US)
+      {
+        const double stall_ms = (now_us - call_us) / 1000.0;
+        ++m_result.stalls;
+        m_result.stall_ms += stall_ms;
+        m_result.max_stall_ms = std::max(m_result.max_stall_ms, stall_ms);
+      }
+
+      const u32 poll = DecodeInput(status);
+      const std::vector<std::atomic<u64>>& poll_times = m_poll_times[pad];
+      const u64 poll_us = poll < poll_times.size() ? poll_times[poll].load() : 0;
+      if (poll_us != 0 && poll_us <= now_us)
+        (pad == m_pid - 1 ? m_local_delays_us : m_remote_delays_us).push_back(now_us - poll_us);
+    }
+    return true;
+  }
+
+  // Polls start at 1, pads nothing was polled for yet have 0
+  GCPadStatus PollInput()
+  {
+    const u32 poll = ++m_polls;
+    std::vector<std::atomic<u64>>& poll_times = m_poll_times[m_pid - 1];
+    if (poll < poll_times.size())
+      poll_times[poll] = Common::Timer::NowUs();
+    return EncodeInput(poll);
+  }
+
+  const BenchmarkSettings& m_settings;
+  const PlayerId m_pid;
+  PollTimes& m_poll_times;
+
+  LocalPlayers::LocalPlayers::Player m_account;
+  std::map<int, Tag::TagSet> m_tag_sets;
+  std::unique_ptr<NetPlayClient> m_client;
+
+  Common::Event m_start_event;
+  std::atomic<bool> m_unthrottled = false;
+  std::atomic<u64> m_last_frame_us = 0;
+  std::atomic<bool> m_done = false;
+  std::atomic<bool> m_timed_out = false;
+  u32 m_polls = 0;
+
+  BenchmarkPlayerResult m_result;
+  std::vector<u64> m_local_delays_us;
+  std::vector<u64> m_remote_delays_us;
+};
+}  // namespace
+
+std::optional<BenchmarkMode> ParseBenchmarkMode(std::string_view name)
+{
+  if (name == "normal")
+    return BenchmarkMode::Normal;
+  if (name == "hia")
+    return BenchmarkMode::HostInputAuthority;
+  if (name == "golf")
+    return BenchmarkMode::Golf;
+  return std::nullopt;
+}
+
+BenchmarkResult RunLoopbackBenchmark(const BenchmarkSettings& settings)
+{
+  BenchmarkResult result;
+  if (settings.players < 2 || settings.players > MAX_PLAYERS)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Benchmark: {} players are not supported", settings.players);
+    return result;
+  }
+
+  HeadlessUI server_ui;
+  NetPlayServer server(0, false, &server_ui, NetTraversalConfig{});
+  if (!server.is_connected)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Benchmark: failed to create the server");
+    return result;
+  }
+
+  ENetAddress server_address{};
+  enet_address_set_host(&server_address, "127.0.0.1");
+  server_address.port = server.GetPort();
+  LinkSimulator link(server_address, settings.conditions, settings.conditions, settings.seed);
+  if (!link.Start(0))
+    return result;
+
+  PollTimes poll_times;
+  for (u32 pad = 0; pad < settings.players; ++pad)
+    poll_times[pad] = std::vector<std::atomic<u64>>(settings.frames + 2);
+
+  // One at a time, so the host gets pid 1 and the others follow
+  std::vector<std::unique_ptr<BenchmarkPlayer>> players;
+  PadMappingArray pad_map{};
+  for (PlayerId pid = 1; pid <= settings.players; ++pid)
+  {
+    players.push_back(std::make_unique<BenchmarkPlayer>(settings, pid, poll_times));
+    if (!players.back()->Connect(pid == 1 ? server.GetPort() : link.GetListenPort()))
+    {
+      ERROR_LOG_FMT(NETPLAY, "Benchmark: player {} failed to connect", pid);
+      return result;
+    }
+    pad_map[pid - 1] = pid;
+  }
+
+  // The buffer stays where it is set
+  Config::SetCurrent(Config::NETPLAY_AUTO_BUFFER, false);
+  server.SetPadMapping(pad_map);
+  server.AdjustPadBufferSize(settings.buffer);
+  if (settings.mode != BenchmarkMode::Normal)
+    server.SetHostInputAuthority(true);
+
+  NetSettings net_settings{};
+  net_settings.golf_mode = settings.mode == BenchmarkMode::Golf;
+  if (!server.StartGame(net_settings))
+    return result;
+
+  // Every player is in the game before anyone polls, the pads sent before would be cleared
+  for (const std::unique_ptr<BenchmarkPlayer>& player : players)
+  {
+    if (!player->StartGame())
+    {
+      ERROR_LOG_FMT(NETPLAY, "Benchmark: the game failed to start");
+      return result;
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for (const std::unique_ptr<BenchmarkPlayer>& player : players)
+    threads.emplace_back(&BenchmarkPlayer::Run, player.get());
+
+  while (!std::all_of(players.begin(), players.end(),
+                      [](const std::unique_ptr<BenchmarkPlayer>& player) {
+                        return player->IsDone();
+                      }))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const u64 now_us = Common::Timer::NowUs();
+    for (const std::unique_ptr<BenchmarkPlayer>& player : players)
+      player->CheckStalled(now_us);
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  result.success = true;
+  for (const std::unique_ptr<BenchmarkPlayer>& player : players)
+  {
+    result.players.push_back(player->GetResult());
+    result.success = result.success && !result.players.back().timed_out;
+  }
+
+  // The clients say goodbye through the link
+  players.clear();
+  link.Stop();
+  result.link = link.GetStats();
+  return result;
+}
+}  // namespace NetPlay
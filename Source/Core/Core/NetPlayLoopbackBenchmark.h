@@ -0,0 +1,71 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayLinkSimulator.h"
+
+namespace NetPlay
+{
+enum class BenchmarkMode
+{
+  Normal,
+  HostInputAuthority,
+  Golf,
+};
+
+std::optional<BenchmarkMode> ParseBenchmarkMode(std::string_view name);
+
+struct BenchmarkSettings
+{
+  BenchmarkMode mode = BenchmarkMode::Normal;
+  u32 players = 2;
+  u32 frames = 3600;
+  // In pads, like the NetPlay buffer. With host input authority only the players other than the
+  // golfer buffer. The server raises it to 8 at least, like in any session.
+  u32 buffer = 8;
+  // Golf mode passes the golfer on to the next player this often
+  u32 golf_switch_frames = 600;
+  // Between the server and every player but the host, each way. The host is on the same machine
+  // as the server, like in a real session.
+  LinkConditions conditions;
+  u32 seed = 0;
+};
+
+struct BenchmarkPlayerResult
+{
+  u32 frames = 0;
+  double seconds = 0;
+  u64 stalls = 0;
+  double stall_ms = 0;
+  double max_stall_ms = 0;
+  // From an input being polled on its player's machine to a frame on this one using it
+  double local_delay_ms = 0;
+  double local_delay_p95_ms = 0;
+  double remote_delay_ms = 0;
+  double remote_delay_p95_ms = 0;
+  // Gave up waiting for input
+  bool timed_out = false;
+};
+
+struct BenchmarkResult
+{
+  bool success = false;
+  std::vector<BenchmarkPlayerResult> players;
+  LinkSimulator::Stats link;
+};
+
+// Runs a NetPlay session in this process, with a NetPlayServer and a NetPlayClient for every
+// player over loopback ENet connections through a LinkSimulator, and measures how the players get
+// along.
+//
+// There is no emulation: the clients are headless and every player gets the pads of a frame from
+// its client at 60 FPS, so only the network part of a session is measured. Rollback isn't
+// covered, it needs savestates.
+BenchmarkResult RunLoopbackBenchmark(const BenchmarkSettings& settings);
+}  // namespace NetPlay
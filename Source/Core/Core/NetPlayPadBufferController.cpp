@@ -0,0 +1,131 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayPadBufferController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace NetPlay
+{
+namespace
+{
+template <typename T>
+T Quantile(const std::deque<T>& samples, double quantile)
+{
+  std::vector<T> sorted(samples.begin(), samples.end());
+  const size_t rank = std::min(sorted.size() - 1,
+                               static_cast<size_t>(std::ceil(quantile * sorted.size())) - 1);
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+  return sorted[rank];
+}
+
+struct PlayerDelay
+{
+  double rtt_ms;
+  double jitter_ms;
+};
+}  // namespace
+
+PadBufferController::PadBufferController(double stall_probability)
+    : m_stall_probability(stall_probability)
+{
+}
+
+void PadBufferController::AddRttSample(PlayerId pid, u32 rtt_ms)
+{
+  std::lock_guard lk(m_lock);
+  std::deque<u32>& samples = m_players[pid].rtt_ms;
+  samples.push_back(rtt_ms);
+  if (samples.size() > RTT_SAMPLES)
+    samples.pop_front();
+}
+
+void PadBufferController::AddPadArrival(PlayerId pid, double time_ms)
+{
+  std::lock_guard lk(m_lock);
+  PlayerSamples& player = m_players[pid];
+  if (player.last_arrival_ms)
+  {
+    player.arrival_intervals_ms.push_back(time_ms - *player.last_arrival_ms);
+    if (player.arrival_intervals_ms.size() > ARRIVAL_SAMPLES)
+      player.arrival_intervals_ms.pop_front();
+  }
+  player.last_arrival_ms = time_ms;
+}
+
+void PadBufferController::RemovePlayer(PlayerId pid)
+{
+  std::lock_guard lk(m_lock);
+  m_players.erase(pid);
+}
+
+void PadBufferController::ResetArrivals()
+{
+  std::lock_guard lk(m_lock);
+  for (auto& [pid, player] : m_players)
+  {
+    player.last_arrival_ms.reset();
+    player.arrival_intervals_ms.clear();
+  }
+}
+
+std::optional<PadBufferController::Decision>
+PadBufferController::Recommend(u32 current_buffer) const
+{
+  std::lock_guard lk(m_lock);
+  const double quantile = 1.0 - m_stall_probability;
+
+  std::vector<PlayerDelay> delays;
+  for (const auto& [pid, player] : m_players)
+  {
+    if (player.rtt_ms.size() < MIN_RTT_SAMPLES)
+      return std::nullopt;
+
+    PlayerDelay delay{static_cast<double>(Quantile(player.rtt_ms, quantile)), 0.0};
+    // Arrivals late compared to the usual interval eat into the buffer like extra latency
+    if (player.arrival_intervals_ms.size() >= MIN_ARRIVAL_SAMPLES)
+    {
+      delay.jitter_ms = std::max(0.0, Quantile(player.arrival_intervals_ms, quantile) -
+                                          Quantile(player.arrival_intervals_ms, 0.5));
+    }
+    delays.push_back(delay);
+  }
+  if (delays.empty())
+    return std::nullopt;
+
+  std::sort(delays.begin(), delays.end(), [](const PlayerDelay& a, const PlayerDelay& b) {
+    return a.rtt_ms + a.jitter_ms > b.rtt_ms + b.jitter_ms;
+  });
+  double rtt_ms = 0;
+  double jitter_ms = 0;
+  for (size_t i = 0; i < std::min<size_t>(delays.size(), 2); ++i)
+  {
+    rtt_ms += delays[i].rtt_ms;
+    jitter_ms += delays[i].jitter_ms;
+  }
+
+  const double required_ms = rtt_ms + jitter_ms;
+  const u32 buffer = std::clamp(static_cast<u32>(std::ceil(required_ms / MS_PER_BUFFER)),
+                                MIN_BUFFER, MAX_BUFFER);
+  return Decision{buffer, current_buffer, static_cast<u32>(std::lround(required_ms)),
+                  static_cast<u32>(std::lround(rtt_ms)), static_cast<u32>(std::lround(jitter_ms))};
+}
+
+std::optional<PadBufferController::Decision> PadBufferController::Decide(u32 current_buffer) const
+{
+  std::optional<Decision> decision = Recommend(current_buffer);
+  if (!decision || decision->buffer == current_buffer)
+    return std::nullopt;
+
+  // Lowering is only worth it once the buffer is clearly too large, and only a little at a time
+  if (decision->buffer < current_buffer)
+  {
+    if (decision->buffer + 1 >= current_buffer)
+      return std::nullopt;
+    decision->buffer = std::max(decision->buffer, current_buffer - MAX_DECREASE);
+  }
+  return decision;
+}
+}  // namespace NetPlay
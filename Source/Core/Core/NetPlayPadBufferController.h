@@ -0,0 +1,80 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayProto.h"
+
+namespace NetPlay
+{
+// Picks the pad buffer on the host from what it measures of the players.
+//
+// A pad state has to reach every other player before the buffer ahead of it runs out. Following
+// the rule the buffer box suggests (ping / 8), each player needs its RTT covered in units of
+// MS_PER_BUFFER, plus the jitter of its pad data arrivals at the server. Pads of two remote
+// players pass through the server on their way to each other, so the two slowest players add up.
+// RTT and jitter are taken at the quantile that leaves the target stall probability.
+//
+// Changes are only made at safe points the game reports, between at-bats. The buffer is raised
+// right away, but lowered a little at a time so one quiet stretch doesn't undo it.
+class PadBufferController
+{
+public:
+  static constexpr double MS_PER_BUFFER = 8.0;
+  // Same floor as NetPlayServer::AdjustPadBufferSize
+  static constexpr u32 MIN_BUFFER = 8;
+  static constexpr u32 MAX_BUFFER = 64;
+  static constexpr u32 MAX_DECREASE = 2;
+  // Pings are sent every second
+  static constexpr size_t RTT_SAMPLES = 30;
+  static constexpr size_t MIN_RTT_SAMPLES = 5;
+  static constexpr size_t ARRIVAL_SAMPLES = 600;
+  static constexpr size_t MIN_ARRIVAL_SAMPLES = 60;
+
+  struct Decision
+  {
+    u32 buffer;
+    u32 previous_buffer;
+    // What the buffer has to cover, the sum of rtt_ms and jitter_ms
+    u32 required_ms;
+    u32 rtt_ms;
+    u32 jitter_ms;
+  };
+
+  explicit PadBufferController(double stall_probability = 0.02);
+
+  void AddRttSample(PlayerId pid, u32 rtt_ms);
+  // A pad data packet from pid arrived at time_ms
+  void AddPadArrival(PlayerId pid, double time_ms);
+  void RemovePlayer(PlayerId pid);
+  // Arrivals only count while a game runs
+  void ResetArrivals();
+
+  // The smallest buffer for the target stall probability, nothing until every player has enough
+  // RTT samples
+  std::optional<Decision> Recommend(u32 current_buffer) const;
+  // The buffer to switch to at a safe point, nothing if it stays the same
+  std::optional<Decision> Decide(u32 current_buffer) const;
+
+  double GetStallProbability() const { return m_stall_probability; }
+
+private:
+  struct PlayerSamples
+  {
+    std::deque<u32> rtt_ms;
+    std::optional<double> last_arrival_ms;
+    std::deque<double> arrival_intervals_ms;
+  };
+
+  double m_stall_probability;
+
+  mutable std::mutex m_lock;
+  std::map<PlayerId, PlayerSamples> m_players;
+};
+}  // namespace NetPlay
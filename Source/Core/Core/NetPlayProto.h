@@ -103,6 +103,7 @@ struct NetSettings
   bool sync_codes = false;
   std::string save_data_region;
   bool golf_mode = false;
+  bool rollback = false;
   bool use_fma = false;
   bool hide_remote_gbas = false;
 
@@ -154,6 +155,9 @@ enum class MessageID : u8
   PadHostData = 0x63,
   GBAConfig = 0x64,
   PadSpectator = 0x66,
+  PadDataRedundant = 0x67,
+  PadBufferSafePoint = 0x68,
+  PadBufferDecision = 0x69,
 
   WiimoteData = 0x70,
   WiimoteMapping = 0x71,
@@ -175,7 +179,10 @@ enum class MessageID : u8
 
   TimeBase = 0xB0,
   DesyncDetected = 0xB1,
-  Checksum = 0xB2,
+  DesyncHashRoot = 0xB2,
+  DesyncHashRequest = 0xB3,
+  DesyncHashNodes = 0xB4,
+  DesyncDump = 0xB5,
 
   ComputeGameDigest = 0xC0,
   GameDigestProgress = 0xC1,
@@ -219,7 +226,12 @@ enum class SyncSaveDataID : u8
   RawData = 3,
   GCIData = 4,
   WiiData = 5,
-  GBAData = 6
+  GBAData = 6,
+  // Digests of the save data blocks a client kept, see NetPlaySyncBlocks.h
+  BlockInventory = 7,
+  // Digests of kept blocks a client couldn't read after all, and the server's answer
+  BlockRequest = 8,
+  Blocks = 9,
 };
 
 enum class SyncCodeID : u8
@@ -241,6 +253,8 @@ enum : u8
 {
   DEFAULT_CHANNEL,
   CHUNKED_DATA_CHANNEL,
+  // Unreliable, for PadDataRedundant
+  PAD_DATA_CHANNEL,
   CHANNEL_COUNT
 };
 
@@ -269,6 +283,7 @@ std::string GetPlayerMappingString(PlayerId pid, const PadMappingArray& pad_map,
                                    const GBAConfigArray& gba_config,
                                    const PadMappingArray& wiimote_map);
 bool IsNetPlayRunning();
+bool IsRollbackRunning();
 void SetSIPollBatching(bool state);
 void SendPowerButtonEvent();
 std::string GetGBASavePath(int pad_num);
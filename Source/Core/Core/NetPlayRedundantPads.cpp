@@ -0,0 +1,79 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRedundantPads.h"
+
+#include <algorithm>
+
+namespace NetPlay
+{
+void RedundantPadHistory::Push(const GCPadStatus& status)
+{
+  m_inputs.push_back(status);
+  if (m_inputs.size() > SIZE)
+    m_inputs.pop_front();
+  ++m_next_sequence;
+}
+
+void RedundantPadHistory::Reset()
+{
+  m_inputs.clear();
+  m_next_sequence = 0;
+  m_sent = 0;
+}
+
+u8 RedundantPadHistory::TakeRepeatedCount()
+{
+  const u32 fresh = m_next_sequence - m_sent;
+  m_sent = m_next_sequence;
+  return static_cast<u8>(m_inputs.size() - std::min<size_t>(fresh, m_inputs.size()));
+}
+
+bool RedundantPadReceiver::OnReliable(int pad)
+{
+  std::lock_guard lk(m_lock);
+  const u32 sequence = m_reliable[pad]++;
+  if (sequence < m_received[pad])
+    return false;
+
+  ++m_received[pad];
+  ++m_stats.reliable_first;
+  return true;
+}
+
+size_t RedundantPadReceiver::OnUnreliable(int pad, u32 first_sequence, size_t count,
+                                          size_t repeated)
+{
+  std::lock_guard lk(m_lock);
+  u32& received = m_received[pad];
+  if (first_sequence > received)
+  {
+    ++m_stats.gaps;
+    return count;
+  }
+
+  const size_t first_new = received - first_sequence;
+  if (first_new >= count)
+    return count;
+
+  m_stats.unreliable_first += count - first_new;
+  if (first_new < repeated)
+    m_stats.recovered += repeated - first_new;
+  received = first_sequence + static_cast<u32>(count);
+  return first_new;
+}
+
+void RedundantPadReceiver::Reset()
+{
+  std::lock_guard lk(m_lock);
+  m_received = {};
+  m_reliable = {};
+  m_stats = {};
+}
+
+RedundantPadReceiver::Stats RedundantPadReceiver::GetStats() const
+{
+  std::lock_guard lk(m_lock);
+  return m_stats;
+}
+}  // namespace NetPlay
@@ -0,0 +1,78 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <mutex>
+
+#include "Common/CommonTypes.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// Pad input is sent twice. Once on the reliable channel as before, and once on an unreliable
+// sequenced channel where every packet repeats the last inputs of the pad. When a packet is lost,
+// the next one that arrives still carries its inputs, so the receiver doesn't wait for the reliable
+// resend. Inputs are numbered per pad so that whichever copy arrives second is dropped.
+
+// Last inputs sent for one local pad, called from the CPU thread
+class RedundantPadHistory
+{
+public:
+  // Inputs repeated in every unreliable packet
+  static constexpr u32 SIZE = 8;
+
+  void Push(const GCPadStatus& status);
+  void Reset();
+
+  bool IsEmpty() const { return m_inputs.empty(); }
+  u32 GetFirstSequence() const { return m_next_sequence - static_cast<u32>(m_inputs.size()); }
+  const std::deque<GCPadStatus>& GetInputs() const { return m_inputs; }
+  // How many of the oldest inputs were in an earlier packet. Marks all of them as sent
+  u8 TakeRepeatedCount();
+
+private:
+  std::deque<GCPadStatus> m_inputs;
+  u32 m_next_sequence = 0;
+  u32 m_sent = 0;
+};
+
+// Drops the inputs of remote pads that arrived on the other channel already
+class RedundantPadReceiver
+{
+public:
+  struct Stats
+  {
+    // Inputs the reliable channel delivered first
+    u64 reliable_first = 0;
+    // Inputs the unreliable channel delivered first
+    u64 unreliable_first = 0;
+    // Of those, inputs taken from a repeated copy because the packet that first carried them was
+    // lost or late. Each would have waited for the reliable resend
+    u64 recovered = 0;
+    // Unreliable packets that arrived after more inputs were lost than they repeat
+    u64 gaps = 0;
+  };
+
+  // An input from the reliable channel, which delivers every input in order. Returns true if it
+  // wasn't received yet
+  bool OnReliable(int pad);
+  // Inputs first_sequence and up from the unreliable channel, oldest first, the first repeated
+  // ones were sent before. Returns the index of the first new one, count if there is none. Inputs
+  // after a gap are left to the reliable channel
+  size_t OnUnreliable(int pad, u32 first_sequence, size_t count, size_t repeated);
+
+  void Reset();
+  Stats GetStats() const;
+
+private:
+  mutable std::mutex m_lock;
+  // Inputs received per pad, from either channel
+  std::array<u32, 4> m_received{};
+  // Inputs received per pad on the reliable channel
+  std::array<u32, 4> m_reliable{};
+  Stats m_stats;
+};
+}  // namespace NetPlay
@@ -0,0 +1,207 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+namespace NetPlay
+{
+RollbackSession::RollbackSession(PadSet remote_pads) : m_remote_pads(remote_pads)
+{
+}
+
+bool RollbackSession::BeginFrame()
+{
+  std::lock_guard lk(m_lock);
+  const u64 frame = m_next_frame++;
+  if (frame < m_resim_until)
+  {
+    ++m_stats.resimulated_frames;
+    return false;
+  }
+
+  ++m_stats.frames;
+  return true;
+}
+
+void RollbackSession::SetLocalInput(int pad, const GCPadStatus& status)
+{
+  std::lock_guard lk(m_lock);
+  InputSlot& slot = GetSlot(pad, m_next_frame - 1);
+  slot.status = status;
+  slot.confirmed = true;
+}
+
+std::optional<GCPadStatus> RollbackSession::GetInput(int pad)
+{
+  std::lock_guard lk(m_lock);
+  // Polled outside of a batch before the first frame
+  if (m_next_frame == 0)
+    return NeutralInput();
+
+  const u64 frame = m_next_frame - 1;
+  InputSlot& slot = GetSlot(pad, frame);
+  if (m_remote_pads[pad] && !slot.confirmed)
+  {
+    if (!CanPredict(frame))
+      return std::nullopt;
+
+    // Players mostly hold their input for several frames, so the last one is the best guess
+    slot.status = m_received[pad] ? GetSlot(pad, m_received[pad] - 1).status : NeutralInput();
+    ++m_stats.predicted_inputs;
+  }
+  else if (!slot.confirmed)
+  {
+    // A port nobody plays on
+    slot.status = NeutralInput();
+  }
+
+  slot.used = slot.status;
+  return slot.status;
+}
+
+bool RollbackSession::IsResimulating() const
+{
+  std::lock_guard lk(m_lock);
+  return m_next_frame <= m_resim_until;
+}
+
+u64 RollbackSession::GetFrame() const
+{
+  std::lock_guard lk(m_lock);
+  return m_next_frame - 1;
+}
+
+void RollbackSession::TakeSnapshot(const SaveFunction& save)
+{
+  std::lock_guard lk(m_lock);
+  const std::optional<u64> newest_frame = m_snapshots.GetNewestFrame();
+  if (newest_frame && *newest_frame >= m_next_frame)
+    return;
+
+  save(m_snapshots, m_next_frame);
+}
+
+bool RollbackSession::Rollback(const LoadFunction& load)
+{
+  std::lock_guard lk(m_lock);
+  if (!m_mispredicted_frame)
+    return false;
+
+  // Snapshots taken after the mispredicted frame ran carry the wrong input, the ring drops them
+  const u64 mispredicted_frame = *std::exchange(m_mispredicted_frame, std::nullopt);
+  // Can't fail, frames are only predicted while a snapshot from before them exists
+  if (!HasSnapshot(mispredicted_frame))
+    return false;
+
+  const std::optional<u64> snapshot_frame = load(m_snapshots, mispredicted_frame);
+  if (!snapshot_frame)
+    return false;
+
+  // Their old predictions don't count anymore, they will run again
+  for (u64 frame = *snapshot_frame; frame < m_next_frame; ++frame)
+  {
+    for (int pad = 0; pad < 4; ++pad)
+      GetSlot(pad, frame).used.reset();
+  }
+
+  const u64 distance = m_next_frame - *snapshot_frame;
+  m_resim_until = std::max(m_resim_until, m_next_frame);
+  m_next_frame = *snapshot_frame;
+
+  ++m_stats.rollbacks;
+  m_stats.max_rollback_frames = std::max(m_stats.max_rollback_frames, static_cast<u32>(distance));
+  return true;
+}
+
+bool RollbackSession::AddRemoteInput(int pad, const GCPadStatus& status)
+{
+  std::lock_guard lk(m_lock);
+  const u64 frame = m_received[pad]++;
+  InputSlot& slot = GetSlot(pad, frame);
+  slot.status = status;
+  slot.confirmed = true;
+
+  if (!slot.used || IsSameInput(*slot.used, status))
+    return false;
+  ++m_stats.mispredicted_inputs;
+
+  const bool already_pending = m_mispredicted_frame.has_value();
+  m_mispredicted_frame = std::min(m_mispredicted_frame.value_or(frame), frame);
+  return !already_pending;
+}
+
+RollbackSession::Stats RollbackSession::GetStats() const
+{
+  std::lock_guard lk(m_lock);
+  return m_stats;
+}
+
+RollbackSession::Progress RollbackSession::GetProgress() const
+{
+  std::lock_guard lk(m_lock);
+  // A mispredicted frame runs again once the rollback is done
+  const u64 first_unconfirmed = GetFirstUnconfirmedFrame();
+  return {m_next_frame,
+          std::min(first_unconfirmed, m_mispredicted_frame.value_or(first_unconfirmed)),
+          m_next_frame <= m_resim_until};
+}
+
+GCPadStatus RollbackSession::NeutralInput()
+{
+  GCPadStatus status;
+  status.stickX = GCPadStatus::MAIN_STICK_CENTER_X;
+  status.stickY = GCPadStatus::MAIN_STICK_CENTER_Y;
+  status.substickX = GCPadStatus::C_STICK_CENTER_X;
+  status.substickY = GCPadStatus::C_STICK_CENTER_Y;
+  return status;
+}
+
+bool RollbackSession::IsSameInput(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return std::tie(a.button, a.stickX, a.stickY, a.substickX, a.substickY, a.triggerLeft,
+                  a.triggerRight, a.analogA, a.analogB, a.isConnected) ==
+         std::tie(b.button, b.stickX, b.stickY, b.substickX, b.substickY, b.triggerLeft,
+                  b.triggerRight, b.analogA, b.analogB, b.isConnected);
+}
+
+RollbackSession::InputSlot& RollbackSession::GetSlot(int pad, u64 frame)
+{
+  InputSlot& slot = m_inputs[pad][frame % HISTORY];
+  if (slot.frame != frame)
+    slot = InputSlot{frame, GCPadStatus{}, false, std::nullopt};
+  return slot;
+}
+
+u64 RollbackSession::GetFirstUnconfirmedFrame() const
+{
+  u64 first = m_next_frame;
+  for (int pad = 0; pad < 4; ++pad)
+  {
+    if (m_remote_pads[pad])
+      first = std::min(first, m_received[pad]);
+  }
+  return first;
+}
+
+bool RollbackSession::CanPredict(u64 frame) const
+{
+  for (int pad = 0; pad < 4; ++pad)
+  {
+    if (m_remote_pads[pad] && frame >= m_received[pad] + MAX_PREDICTION)
+      return false;
+  }
+
+  // A misprediction has to be undone from a snapshot taken before the frame it happened on
+  return HasSnapshot(std::min(frame, GetFirstUnconfirmedFrame()));
+}
+
+bool RollbackSession::HasSnapshot(u64 frame) const
+{
+  const std::optional<u64> oldest_frame = m_snapshots.GetOldestFrame();
+  return oldest_frame && *oldest_frame <= frame;
+}
+}  // namespace NetPlay
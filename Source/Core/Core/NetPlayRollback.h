@@ -0,0 +1,129 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "Core/StateRing.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// Input bookkeeping for rollback NetPlay.
+//
+// Instead of holding every frame back until the remote pads arrived, frames run right away with
+// the last remote input repeated as a prediction. Snapshots of the emulated state are kept for
+// the frames that still have predicted input. When a remote input arrives that differs from the
+// prediction a frame ran with, the newest snapshot from before that frame is loaded and the frames
+// since are run again with the real input.
+//
+// Frames are counted by batched pad polls, which every client makes on the same emulated frames.
+// A snapshot is tagged with the frame that begins after it, so it holds the input of all earlier
+// frames. Snapshots are saved and loaded on the CPU thread right before the first pad of a frame is
+// polled, so a frame always starts from the snapshot tagged with it. They are kept in a StateRing,
+// which only copies the pages that changed since the snapshot before.
+class RollbackSession
+{
+public:
+  // Frames that may run ahead of the last remote input before the CPU thread waits for it
+  static constexpr u32 MAX_PREDICTION = 8;
+  // Frames of input kept, enough for MAX_PREDICTION on either side of a rollback
+  static constexpr u32 HISTORY = 64;
+  // A snapshot for every predicted frame and one from before the first of them
+  static constexpr u32 MAX_SNAPSHOTS = MAX_PREDICTION + 2;
+
+  using PadSet = std::array<bool, 4>;
+  // Capture or restore a snapshot of the given frame in the ring, see StateRing
+  using SaveFunction = std::function<void(State::StateRing& ring, u64 frame)>;
+  using LoadFunction = std::function<std::optional<u64>(State::StateRing& ring, u64 frame)>;
+
+  struct Stats
+  {
+    // Frames run for the first time
+    u64 frames = 0;
+    u64 resimulated_frames = 0;
+    u64 rollbacks = 0;
+    u32 max_rollback_frames = 0;
+    u64 predicted_inputs = 0;
+    u64 mispredicted_inputs = 0;
+  };
+
+  struct Progress
+  {
+    // Frames begun, the emulated state holds the input of all of them
+    u64 frames = 0;
+    // Frames before this ran with the input every client sent and won't run again
+    u64 confirmed_frames = 0;
+    bool resimulating = false;
+  };
+
+  // Pads played from other clients, local ones are set every frame
+  explicit RollbackSession(PadSet remote_pads);
+
+  // Starts the next frame. Returns false while frames that already ran are resimulated, their
+  // local input is taken from the history instead of being polled and sent again
+  bool BeginFrame();
+  // Local input of the current frame
+  void SetLocalInput(int pad, const GCPadStatus& status);
+  // Input of the current frame, predicted if the remote one is missing. Nothing if the frame is too
+  // far ahead to predict, the caller has to wait for more remote input
+  std::optional<GCPadStatus> GetInput(int pad);
+  bool IsResimulating() const;
+  u64 GetFrame() const;
+
+  // Saves a snapshot for the frame that begins next, unless there is one already. Call before
+  // BeginFrame
+  void TakeSnapshot(const SaveFunction& save);
+  // Loads the newest snapshot from before the first mispredicted frame. Returns false if no frame
+  // was mispredicted or the snapshot couldn't be loaded. Call before TakeSnapshot
+  bool Rollback(const LoadFunction& load);
+
+  // Input sent by the remote client for its next frame. Returns true if a frame already ran with a
+  // different prediction, and a rollback wasn't pending yet
+  bool AddRemoteInput(int pad, const GCPadStatus& status);
+
+  Stats GetStats() const;
+  Progress GetProgress() const;
+
+  static GCPadStatus NeutralInput();
+  static bool IsSameInput(const GCPadStatus& a, const GCPadStatus& b);
+
+private:
+  struct InputSlot
+  {
+    u64 frame = ~u64(0);
+    GCPadStatus status;
+    bool confirmed = false;
+    // What the frame ran with the last time it ran
+    std::optional<GCPadStatus> used;
+  };
+
+  InputSlot& GetSlot(int pad, u64 frame);
+  // First frame that some remote pad has no input for yet
+  u64 GetFirstUnconfirmedFrame() const;
+  bool CanPredict(u64 frame) const;
+  bool HasSnapshot(u64 frame) const;
+
+  const PadSet m_remote_pads;
+
+  mutable std::mutex m_lock;
+  std::array<std::array<InputSlot, HISTORY>, 4> m_inputs;
+  // Remote inputs received per pad, also the frame the next one is for
+  std::array<u64, 4> m_received{};
+  u64 m_next_frame = 0;
+  // Frames before this already ran once
+  u64 m_resim_until = 0;
+  std::optional<u64> m_mispredicted_frame;
+
+  // Older snapshots are folded into the oldest one, which never goes back past the first
+  // unconfirmed frame as frames aren't predicted further than MAX_PREDICTION ahead of it
+  State::StateRing m_snapshots{MAX_SNAPSHOTS};
+
+  Stats m_stats;
+};
+}  // namespace NetPlay
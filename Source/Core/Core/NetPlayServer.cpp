@@ -10,6 +10,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -61,6 +62,9 @@
 #include "Core/IOS/Uids.h"
 #include "Core/NetPlayClient.h"  //for NetPlayUI
 #include "Core/NetPlayCommon.h"
+#include "Core/NetPlayDesyncHasher.h"
+#include "Core/NetPlayRedundantPads.h"
+#include "Core/NetPlaySyncBlocks.h"
 #include "Core/SyncIdentifier.h"
 #include "Core/LocalPlayersConfig.h"
 
@@ -93,6 +97,7 @@ NetPlayServer::~NetPlayServer()
   if (is_connected)
   {
     m_do_loop = false;
+    m_save_sync_thread.Shutdown(true);
     m_chunked_data_event.Set();
     m_chunked_data_complete_event.Set();
     if (m_chunked_data_thread.joinable())
@@ -170,6 +175,8 @@ NetPlayServer::NetPlayServer(const u16 port, const bool forward_port, NetPlayUI*
     m_thread = std::thread(&NetPlayServer::ThreadFunc, this);
     m_target_buffer_size = 8;
     m_chunked_data_thread = std::thread(&NetPlayServer::ChunkedDataThreadFunc, this);
+    m_save_sync_thread.Reset("NetPlaySaveSync",
+                             [](const std::function<void()>& func) { func(); });
 
 #ifdef USE_UPNP
     if (forward_port && !traversal_config.use_traversal)
@@ -567,6 +574,7 @@ unsigned int NetPlayServer::OnDisconnect(const Client& player)
   auto it = m_players.find(player.pid);
   if (it != m_players.end())
     m_players.erase(it);
+  m_pad_buffer_controller.RemovePlayer(pid);
 
   // alert other players of disconnect
   SendToClients(spac);
@@ -1020,10 +1028,87 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     else
     {
       SendToClients(spac, player.pid);
+      m_pad_buffer_controller.AddPadArrival(
+          player.pid, std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count());
     }
   }
   break;
 
+  case MessageID::PadBufferSafePoint:
+  {
+    // Every client's game reaches the safe point, the host's one decides
+    if (!player.IsHost() || player.current_game != m_current_game)
+      break;
+
+    u32 current_buffer;
+    {
+      std::lock_guard lkg(m_crit.game);
+      if (!m_is_running || m_host_input_authority || !Config::Get(Config::NETPLAY_AUTO_BUFFER))
+        break;
+      current_buffer = m_target_buffer_size;
+    }
+
+    const std::optional<PadBufferController::Decision> decision =
+        m_pad_buffer_controller.Decide(current_buffer);
+    if (!decision)
+      break;
+
+    INFO_LOG_FMT(NETPLAY, "Pad buffer {} -> {}: {} ms RTT and {} ms jitter to cover",
+                 decision->previous_buffer, decision->buffer, decision->rtt_ms,
+                 decision->jitter_ms);
+    AdjustPadBufferSize(decision->buffer);
+
+    sf::Packet spac;
+    spac << MessageID::PadBufferDecision;
+    spac << decision->buffer << decision->previous_buffer << decision->required_ms
+         << decision->rtt_ms << decision->jitter_ms;
+    SendAsyncToClients(std::move(spac));
+  }
+  break;
+
+  case MessageID::PadDataRedundant:
+  {
+    // Only sent without host input authority, as a second copy of PadData
+    if (player.current_game != m_current_game || m_host_input_authority)
+      break;
+
+    sf::Packet spac;
+    spac << MessageID::PadDataRedundant;
+
+    while (!packet.endOfPacket())
+    {
+      PadIndex map;
+      u32 first_sequence;
+      u8 count;
+      u8 repeated;
+      packet >> map >> first_sequence >> count >> repeated;
+
+      if (m_pad_map.at(map) != player.pid || count > RedundantPadHistory::SIZE)
+        return 1;
+
+      spac << map << first_sequence << count << repeated;
+      for (u8 i = 0; i < count; ++i)
+      {
+        GCPadStatus pad;
+        packet >> pad.button;
+        spac << pad.button;
+        if (!m_gba_config.at(map).enabled)
+        {
+          packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
+              pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+
+          spac << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
+               << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
+        }
+      }
+    }
+
+    SendToClients(spac, player.pid, PAD_DATA_CHANNEL);
+  }
+  break;
+
   case MessageID::PadHostData:
   {
     // Kick player if they're not the golfer.
@@ -1160,6 +1245,12 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (m_ping_key == ping_key)
     {
       player.ping = ping;
+
+      // Spectators don't hold anyone up
+      if (PlayerHasControllerMapped(player.pid))
+        m_pad_buffer_controller.AddRttSample(player.pid, ping);
+      else
+        m_pad_buffer_controller.RemovePlayer(player.pid);
     }
 
     sf::Packet spac;
@@ -1270,17 +1361,80 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
-  case MessageID::Checksum:
+  case MessageID::DesyncHashRoot:
+  {
+    u32 round;
+    packet >> round;
+    const u64 root = Common::PacketReadU64(packet);
+
+    sf::Packet spac;
+    spac << MessageID::DesyncHashRoot;
+    spac << player.pid;
+    spac << round;
+    spac << static_cast<sf::Uint64>(root);
+    SendToClients(spac, player.pid);
+  }
+  break;
+
+  case MessageID::DesyncHashRequest:
   {
-    u32 inChecksum;
-    u8 checksumId;
-    packet >> inChecksum;
-    packet >> checksumId;
+    PlayerId target;
+    u32 round;
+    u8 level;
+    u32 index;
+    packet >> target >> round >> level >> index;
+
+    const auto it = m_players.find(target);
+    if (it == m_players.end())
+      break;
 
     sf::Packet spac;
-    spac << MessageID::Checksum;
-    spac << inChecksum;
-    spac << checksumId;
+    spac << MessageID::DesyncHashRequest;
+    spac << player.pid;
+    spac << round << level << index;
+    Send(it->second.socket, spac);
+  }
+  break;
+
+  case MessageID::DesyncHashNodes:
+  {
+    PlayerId target;
+    u32 round;
+    u8 level;
+    u32 index;
+    u32 count;
+    packet >> target >> round >> level >> index >> count;
+
+    const auto it = m_players.find(target);
+    if (it == m_players.end() || count > DesyncHasher::FANOUT)
+      break;
+
+    sf::Packet spac;
+    spac << MessageID::DesyncHashNodes;
+    spac << player.pid;
+    spac << round << level << index << count;
+    for (u32 i = 0; i < count; ++i)
+      spac << static_cast<sf::Uint64>(Common::PacketReadU64(packet));
+    Send(it->second.socket, spac);
+  }
+  break;
+
+  case MessageID::DesyncDump:
+  {
+    sf::Uint64 frame;
+    u32 round;
+    u32 count;
+    packet >> frame >> round >> count;
+
+    sf::Packet spac;
+    spac << MessageID::DesyncDump;
+    spac << frame << round << count;
+    for (u32 i = 0; i < count && i < DesyncHasher::FANOUT; ++i)
+    {
+      u32 page;
+      packet >> page;
+      spac << page;
+    }
     SendToClients(spac);
   }
   break;
@@ -1365,6 +1519,38 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
     break;
 
+    case SyncSaveDataID::BlockInventory:
+    {
+      std::optional<std::set<SyncBlockDigest>> known = ReadSyncBlockDigests(packet);
+      if (!known)
+        return 1;
+
+      if (m_start_pending)
+      {
+        QueueSaveDataWork([this, pid = player.pid, known = std::move(*known)](
+                              const SaveSyncInfo& sync_info) mutable {
+          return SendSaveData(pid, sync_info, std::move(known));
+        });
+      }
+    }
+    break;
+
+    case SyncSaveDataID::BlockRequest:
+    {
+      std::optional<std::set<SyncBlockDigest>> digests = ReadSyncBlockDigests(packet);
+      if (!digests)
+        return 1;
+
+      if (m_start_pending)
+      {
+        QueueSaveDataWork([this, pid = player.pid,
+                           digests = std::move(*digests)](const SaveSyncInfo& sync_info) {
+          return SendSaveDataBlocks(pid, sync_info, digests);
+        });
+      }
+    }
+    break;
+
     case SyncSaveDataID::Failure:
     {
       m_dialog->AppendChat(Common::FmtFormatT("{0} failed to synchronize.", player.name));
@@ -1647,6 +1833,7 @@ bool NetPlayServer::SetupNetSettings()
   settings.strict_settings_sync = Config::Get(Config::NETPLAY_STRICT_SETTINGS_SYNC);
   settings.sync_codes = true;
   settings.golf_mode = Config::Get(Config::NETPLAY_NETWORK_MODE) == "golf";
+  settings.rollback = Config::Get(Config::NETPLAY_NETWORK_MODE) == "rollback";
   settings.use_fma = DoAllPlayersHaveHardwareFMA();
   settings.hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
 
@@ -1680,6 +1867,11 @@ struct SaveSyncInfo
   std::optional<std::vector<u8>> mii_data;
   std::vector<std::pair<u64, WiiSave::StoragePointer>> wii_saves;
   std::optional<DiscIO::Riivolution::SavegameRedirect> redirected_save;
+  // Copies for the save sync thread, the server's can change while the saves are sent
+  NetSettings settings;
+  GBAConfigArray gba_config;
+  // Compressed as clients ask for them, each block once for all of them
+  std::unique_ptr<SyncBlockCache> blocks = std::make_unique<SyncBlockCache>();
 };
 
 // called from ---GUI--- thread
@@ -1717,7 +1909,7 @@ bool NetPlayServer::RequestStartGame()
     {
       start_now = false;
       m_start_pending = true;
-      if (!SyncSaveData(*save_sync_info))
+      if (!SyncSaveData(std::move(*save_sync_info)))
       {
         PanicAlertFmtT("Error synchronizing save data!");
         m_start_pending = false;
@@ -1755,6 +1947,7 @@ bool NetPlayServer::StartGame()
 
   m_timebase_by_frame.clear();
   m_desync_detected = false;
+  m_pad_buffer_controller.ResetArrivals();
   std::lock_guard lkg(m_crit.game);
   // only used as an identifier, not time value, so truncation is fine
   m_current_game = static_cast<u32>(Common::Timer::NowMs());
@@ -1768,8 +1961,10 @@ bool NetPlayServer::StartGame()
 
   const sf::Uint64 initial_rtc = GetInitialNetPlayRTC();
 
+  // Without a game the fallback region is used
+  const auto game = m_dialog->FindGameFile(m_selected_game_identifier);
   const std::string region = Config::GetDirectoryForRegion(
-      Config::ToGameCubeRegion(m_dialog->FindGameFile(m_selected_game_identifier)->GetRegion()));
+      Config::ToGameCubeRegion(game ? game->GetRegion() : DiscIO::Region::Unknown));
 
   // load host's GC SRAM
   SConfig::GetInstance().m_strSRAM = File::GetUserPath(F_GCSRAM_IDX);
@@ -1854,6 +2049,7 @@ bool NetPlayServer::StartGame()
   spac << m_settings.sync_codes;
 
   spac << m_settings.golf_mode;
+  spac << m_settings.rollback;
   spac << m_settings.use_fma;
   spac << m_settings.hide_remote_gbas;
 
@@ -1868,6 +2064,12 @@ bool NetPlayServer::StartGame()
   return true;
 }
 
+bool NetPlayServer::StartGame(const NetSettings& settings)
+{
+  m_settings = settings;
+  return StartGame();
+}
+
 void NetPlayServer::AbortGameStart()
 {
   if (m_start_pending)
@@ -1889,6 +2091,8 @@ std::optional<SaveSyncInfo> NetPlayServer::CollectSaveSyncInfo()
   INFO_LOG_FMT(NETPLAY, "Collecting saves.");
 
   SaveSyncInfo sync_info;
+  sync_info.settings = m_settings;
+  sync_info.gba_config = m_gba_config;
 
   sync_info.save_count = 0;
   for (ExpansionInterface::Slot slot : ExpansionInterface::MEMCARD_SLOTS)
@@ -1986,7 +2190,7 @@ std::optional<SaveSyncInfo> NetPlayServer::CollectSaveSyncInfo()
 }
 
 // called from ---GUI--- thread
-bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
+bool NetPlayServer::SyncSaveData(SaveSyncInfo sync_info)
 {
   INFO_LOG_FMT(NETPLAY, "Sending {} savegame chunks to clients.", sync_info.save_count);
 
@@ -1995,18 +2199,64 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
 
   m_save_data_synced_players = 0;
 
+  const u8 save_count = sync_info.save_count;
+  {
+    // The saves are sent once each client has told us which blocks it has
+    std::lock_guard lks(m_crit.save_sync);
+    m_save_sync_info =
+        save_count == 0 ? nullptr : std::make_shared<SaveSyncInfo>(std::move(sync_info));
+  }
+
   {
     sf::Packet pac;
     pac << MessageID::SyncSaveData;
     pac << SyncSaveDataID::Notify;
-    pac << sync_info.save_count;
+    pac << save_count;
 
     // send this on the chunked data channel to ensure it's sequenced properly
     SendAsyncToClients(std::move(pac), 0, CHUNKED_DATA_CHANNEL);
   }
 
-  if (sync_info.save_count == 0)
-    return true;
+  return true;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::QueueSaveDataWork(std::function<bool(const SaveSyncInfo&)> work)
+{
+  std::shared_ptr<const SaveSyncInfo> sync_info;
+  {
+    std::lock_guard lks(m_crit.save_sync);
+    sync_info = m_save_sync_info;
+  }
+  if (!sync_info)
+    return;
+
+  m_save_sync_thread.EmplaceItem([this, sync_info = std::move(sync_info), work = std::move(work)] {
+    const auto is_current = [&] {
+      std::lock_guard lks(m_crit.save_sync);
+      return m_save_sync_info == sync_info;
+    };
+
+    // Don't send the saves of a sync that was replaced in the meantime
+    if (!is_current() || work(*sync_info))
+      return;
+
+    std::lock_guard lkg(m_crit.game);
+    if (m_start_pending && is_current())
+    {
+      PanicAlertFmtT("Error synchronizing save data!");
+      m_dialog->OnGameStartAborted();
+      ChunkedDataAbort();
+      m_start_pending = false;
+    }
+  });
+}
+
+// called from ---Save Sync--- thread
+bool NetPlayServer::SendSaveData(const PlayerId pid, const SaveSyncInfo& sync_info,
+                                 std::set<SyncBlockDigest> known)
+{
+  SyncBlockEncoder encoder(*sync_info.blocks, std::move(known));
 
   const auto game_region = sync_info.game->GetRegion();
   const auto gamecube_region = Config::ToGameCubeRegion(game_region);
@@ -2016,9 +2266,9 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
   {
     const bool is_slot_a = slot == ExpansionInterface::Slot::A;
 
-    if (m_settings.exi_device[slot] == ExpansionInterface::EXIDeviceType::MemoryCard)
+    if (sync_info.settings.exi_device[slot] == ExpansionInterface::EXIDeviceType::MemoryCard)
     {
-      const int size_override = m_settings.memcard_size_override;
+      const int size_override = sync_info.settings.memcard_size_override;
       const u16 card_size_mbits =
           size_override >= 0 && size_override <= 4 ?
               static_cast<u16>(Memcard::MBIT_SIZE_MEMORY_CARD_59 << size_override) :
@@ -2034,7 +2284,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
       {
         INFO_LOG_FMT(NETPLAY, "Sending data of raw memcard {} in slot {}.", path,
                      is_slot_a ? 'A' : 'B');
-        if (!CompressFileIntoPacket(path, pac))
+        if (!CompressFileIntoPacket(path, encoder, pac))
           return false;
       }
       else
@@ -2045,8 +2295,8 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
         pac << sf::Uint64{0};
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      SendChunked(std::move(pac), pid,
+                  fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
     }
     else if (Config::Get(Config::GetInfoForEXIDevice(slot)) ==
              ExpansionInterface::EXIDeviceType::MemoryCardFolder)
@@ -2073,7 +2323,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
           const std::string filename = file.substr(file.find_last_of('/') + 1);
           INFO_LOG_FMT(NETPLAY, "Sending GCI {}.", filename);
           pac << filename;
-          if (!CompressFileIntoPacket(file, pac))
+          if (!CompressFileIntoPacket(file, encoder, pac))
             return false;
         }
       }
@@ -2085,8 +2335,8 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
         pac << static_cast<u8>(0);
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'));
+      SendChunked(std::move(pac), pid,
+                  fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'));
     }
   }
 
@@ -2101,7 +2351,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
     {
       INFO_LOG_FMT(NETPLAY, "Sending Mii data.");
       pac << true;
-      if (!CompressBufferIntoPacket(*sync_info.mii_data, pac))
+      if (!CompressBufferIntoPacket(*sync_info.mii_data, encoder, pac))
         return false;
     }
     else
@@ -2162,7 +2412,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
           if (file.type == WiiSave::Storage::SaveFile::Type::File)
           {
             const std::optional<std::vector<u8>>& data = *file.data;
-            if (!data || !CompressBufferIntoPacket(*data, pac))
+            if (!data || !CompressBufferIntoPacket(*data, encoder, pac))
               return false;
           }
         }
@@ -2179,7 +2429,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
       INFO_LOG_FMT(NETPLAY, "Sending redirected save at {}.",
                    sync_info.redirected_save->m_target_path);
       pac << true;
-      if (!CompressFolderIntoPacket(sync_info.redirected_save->m_target_path, pac))
+      if (!CompressFolderIntoPacket(sync_info.redirected_save->m_target_path, encoder, pac))
         return false;
     }
     else
@@ -2188,12 +2438,12 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
       pac << false;  // no redirected save
     }
 
-    SendChunkedToClients(std::move(pac), 1, "Wii Save Synchronization");
+    SendChunked(std::move(pac), pid, "Wii Save Synchronization");
   }
 
-  for (size_t i = 0; i < m_gba_config.size(); ++i)
+  for (size_t i = 0; i < sync_info.gba_config.size(); ++i)
   {
-    if (m_gba_config[i].enabled && m_gba_config[i].has_rom)
+    if (sync_info.gba_config[i].enabled && sync_info.gba_config[i].has_rom)
     {
       sf::Packet pac;
       pac << MessageID::SyncSaveData;
@@ -2208,7 +2458,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
       if (File::Exists(path))
       {
         INFO_LOG_FMT(NETPLAY, "Sending data of GBA save at {} for slot {}.", path, i);
-        if (!CompressFileIntoPacket(path, pac))
+        if (!CompressFileIntoPacket(path, encoder, pac))
           return false;
       }
       else
@@ -2218,11 +2468,30 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
         pac << sf::Uint64{0};
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GBA{} Save File Synchronization", i + 1));
+      SendChunked(std::move(pac), pid, fmt::format("GBA{} Save File Synchronization", i + 1));
     }
   }
 
+  INFO_LOG_FMT(NETPLAY, "Sent {} bytes for {} bytes of save data to player {}.",
+               encoder.GetSentBytes(), encoder.GetRawBytes(), pid);
+  return true;
+}
+
+// called from ---Save Sync--- thread
+bool NetPlayServer::SendSaveDataBlocks(const PlayerId pid, const SaveSyncInfo& sync_info,
+                                       const std::set<SyncBlockDigest>& digests)
+{
+  INFO_LOG_FMT(NETPLAY, "Player {} lost {} save data blocks, sending them again.", pid,
+               digests.size());
+
+  SyncBlockEncoder encoder(*sync_info.blocks, {});
+  sf::Packet pac;
+  pac << MessageID::SyncSaveData;
+  pac << SyncSaveDataID::Blocks;
+  if (!encoder.EncodeBlocks(digests, pac))
+    return false;
+
+  SendChunked(std::move(pac), pid, "Save Data Block Synchronization");
   return true;
 }
 
@@ -2422,7 +2691,7 @@ void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_
 
 void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 channel_id)
 {
-  Common::ENet::SendPacket(socket, packet, channel_id);
+  Common::ENet::SendPacket(socket, packet, channel_id, channel_id != PAD_DATA_CHANNEL);
 }
 
 void NetPlayServer::KickPlayer(PlayerId player)
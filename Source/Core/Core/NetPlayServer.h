@@ -5,11 +5,13 @@
 
 #include <SFML/Network/Packet.hpp>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <set>
 #include <sstream>
 #include <thread>
 #include <unordered_map>
@@ -22,7 +24,10 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
+#include "Common/WorkQueueThread.h"
+#include "Core/NetPlayPadBufferController.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlaySyncBlocks.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 #include "UICommon/NetPlayIndex.h"
@@ -55,6 +60,9 @@ public:
   bool DoAllPlayersHaveIPLDump() const;
   bool DoAllPlayersHaveHardwareFMA() const;
   bool StartGame();
+  // Starts with these settings right away, without a game to take them from or to sync saves and
+  // codes for. For sessions that only exchange pads, like the loopback benchmark
+  bool StartGame(const NetSettings& settings);
   bool RequestStartGame();
   void AbortGameStart();
 
@@ -129,7 +137,12 @@ private:
 
   bool SetupNetSettings();
   std::optional<SaveSyncInfo> CollectSaveSyncInfo();
-  bool SyncSaveData(const SaveSyncInfo& sync_info);
+  bool SyncSaveData(SaveSyncInfo sync_info);
+  void QueueSaveDataWork(std::function<bool(const SaveSyncInfo&)> work);
+  bool SendSaveData(PlayerId pid, const SaveSyncInfo& sync_info,
+                    std::set<SyncBlockDigest> known);
+  bool SendSaveDataBlocks(PlayerId pid, const SaveSyncInfo& sync_info,
+                          const std::set<SyncBlockDigest>& digests);
   bool SyncCodes();
   void CheckSyncAndStartGame();
 
@@ -183,6 +196,8 @@ private:
   unsigned int m_save_data_synced_players = 0;
   unsigned int m_codes_synced_players = 0;
   bool m_saves_synced = true;
+  // What SendSaveData sends to each client, until the next sync
+  std::shared_ptr<const SaveSyncInfo> m_save_sync_info;
   bool m_codes_synced = true;
   bool m_start_pending = false;
   bool m_host_input_authority = false;
@@ -198,6 +213,9 @@ private:
   std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
   bool m_desync_detected = false;
 
+  // Picks the buffer at safe points when NETPLAY_AUTO_BUFFER is set
+  PadBufferController m_pad_buffer_controller;
+
   struct
   {
     std::recursive_mutex game;
@@ -205,6 +223,7 @@ private:
     std::recursive_mutex players;
     std::recursive_mutex async_queue_write;
     std::recursive_mutex chunked_data_queue_write;
+    std::recursive_mutex save_sync;
   } m_crit;
 
   Common::SPSCQueue<AsyncQueueEntry, false> m_async_queue;
@@ -216,6 +235,8 @@ private:
   Common::Event m_chunked_data_event;
   Common::Event m_chunked_data_complete_event;
   std::thread m_chunked_data_thread;
+  // Hashes and compresses the save data, away from the ---NETPLAY--- thread
+  Common::WorkQueueThread<std::function<void()>> m_save_sync_thread;
   u32 m_next_chunked_data_id = 0;
   std::unordered_map<u32, unsigned int> m_chunked_data_complete_count;
   bool m_abort_chunked_data = false;
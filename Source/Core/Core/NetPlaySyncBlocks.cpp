@@ -0,0 +1,471 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlaySyncBlocks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <zstd.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/SFMLHelper.h"
+#include "Common/StringUtil.h"
+
+namespace NetPlay
+{
+constexpr int SYNC_BLOCK_COMPRESSION_LEVEL = 5;
+
+// Far more than a store of DEFAULT_MAX_SIZE can hold
+constexpr u32 MAX_SYNC_BLOCK_DIGESTS = 0x10000;
+
+static void WriteDigest(sf::Packet& packet, const SyncBlockDigest& digest)
+{
+  packet.append(digest.data(), digest.size());
+}
+
+static SyncBlockDigest ReadDigest(sf::Packet& packet)
+{
+  SyncBlockDigest digest{};
+  for (u8& byte : digest)
+    packet >> byte;
+  return digest;
+}
+
+static std::optional<SyncBlockDigest> ParseDigest(std::string_view name)
+{
+  SyncBlockDigest digest;
+  if (name.size() != digest.size() * 2 ||
+      !std::all_of(name.begin(), name.end(), [](char c) { return std::isxdigit(c) != 0; }))
+  {
+    return std::nullopt;
+  }
+
+  for (size_t i = 0; i < digest.size(); ++i)
+  {
+    if (!TryParse(std::string(name.substr(i * 2, 2)), &digest[i], 16))
+      return std::nullopt;
+  }
+  return digest;
+}
+
+void WriteSyncBlockDigests(sf::Packet& packet, const std::vector<SyncBlockDigest>& digests)
+{
+  const u32 count = static_cast<u32>(std::min<size_t>(digests.size(), MAX_SYNC_BLOCK_DIGESTS));
+  packet << count;
+  for (u32 i = 0; i < count; ++i)
+    WriteDigest(packet, digests[i]);
+}
+
+std::optional<std::set<SyncBlockDigest>> ReadSyncBlockDigests(sf::Packet& packet)
+{
+  u32 count;
+  packet >> count;
+  if (!packet || count > MAX_SYNC_BLOCK_DIGESTS)
+    return std::nullopt;
+
+  std::set<SyncBlockDigest> digests;
+  for (u32 i = 0; i < count; ++i)
+    digests.insert(ReadDigest(packet));
+
+  if (!packet)
+    return std::nullopt;
+  return digests;
+}
+
+std::optional<std::vector<const std::vector<u8>*>>
+SyncBlockCache::Compress(const std::vector<SyncBlock>& blocks)
+{
+  std::lock_guard lk(m_mutex);
+
+  std::vector<const SyncBlock*> missing;
+  std::set<SyncBlockDigest> missing_digests;
+  for (const SyncBlock& block : blocks)
+  {
+    if (!m_blocks.contains(block.digest) && missing_digests.insert(block.digest).second)
+      missing.push_back(&block);
+  }
+
+  std::vector<std::vector<u8>> compressed(missing.size());
+  std::atomic<size_t> next_block = 0;
+  std::atomic<bool> failed = false;
+  const auto compress_blocks = [&] {
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    if (!context)
+    {
+      failed = true;
+      return;
+    }
+
+    for (size_t i = next_block++; i < missing.size(); i = next_block++)
+    {
+      const SyncBlock& block = *missing[i];
+      std::vector<u8>& out = compressed[i];
+      out.resize(ZSTD_compressBound(block.size));
+      const size_t out_size = ZSTD_compressCCtx(context, out.data(), out.size(), block.data,
+                                                block.size, SYNC_BLOCK_COMPRESSION_LEVEL);
+      if (ZSTD_isError(out_size))
+        failed = true;
+      else
+        out.resize(out_size);
+    }
+
+    ZSTD_freeCCtx(context);
+  };
+
+  // A memory card is a few hundred blocks, so this is worth a thread per core
+  const size_t thread_count =
+      std::min<size_t>(missing.size(), std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(compress_blocks);
+  compress_blocks();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  if (failed)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Failed to compress save data block");
+    return std::nullopt;
+  }
+
+  for (size_t i = 0; i < missing.size(); ++i)
+    m_blocks.emplace(missing[i]->digest, std::move(compressed[i]));
+
+  std::vector<const std::vector<u8>*> result;
+  result.reserve(blocks.size());
+  for (const SyncBlock& block : blocks)
+    result.push_back(&m_blocks.find(block.digest)->second);
+  return result;
+}
+
+void SyncBlockCache::Keep(const std::vector<SyncBlock>& blocks)
+{
+  std::lock_guard lk(m_mutex);
+  for (const SyncBlock& block : blocks)
+  {
+    if (!m_kept_blocks.contains(block.digest))
+      m_kept_blocks.emplace(block.digest, std::vector<u8>(block.data, block.data + block.size));
+  }
+}
+
+std::vector<SyncBlock> SyncBlockCache::Find(const std::set<SyncBlockDigest>& digests)
+{
+  std::lock_guard lk(m_mutex);
+  std::vector<SyncBlock> blocks;
+  for (const SyncBlockDigest& digest : digests)
+  {
+    const auto it = m_kept_blocks.find(digest);
+    if (it != m_kept_blocks.end())
+      blocks.push_back(SyncBlock{digest, it->second.data(), it->second.size()});
+  }
+  return blocks;
+}
+
+void SyncBlockCache::Clear()
+{
+  std::lock_guard lk(m_mutex);
+  m_blocks.clear();
+  m_kept_blocks.clear();
+}
+
+SyncBlockEncoder::SyncBlockEncoder(SyncBlockCache& cache, std::set<SyncBlockDigest> known)
+    : m_cache(cache), m_known(std::move(known))
+{
+}
+
+bool SyncBlockEncoder::Encode(const u8* data, size_t size, sf::Packet& packet)
+{
+  packet << static_cast<sf::Uint64>(size);
+
+  std::vector<SyncBlock> blocks;
+  std::vector<SyncBlock> unknown_blocks;
+  for (size_t offset = 0; offset < size; offset += SYNC_BLOCK_SIZE)
+  {
+    const size_t block_size = std::min<size_t>(SYNC_BLOCK_SIZE, size - offset);
+    SyncBlock block{Common::SHA1::CalculateDigest(data + offset, block_size), data + offset,
+                    block_size};
+    if (!m_known.contains(block.digest))
+      unknown_blocks.push_back(block);
+    blocks.push_back(block);
+  }
+
+  m_cache.Keep(blocks);
+  const auto compressed = m_cache.Compress(unknown_blocks);
+  if (!compressed)
+    return false;
+
+  std::map<SyncBlockDigest, const std::vector<u8>*> compressed_blocks;
+  for (size_t i = 0; i < unknown_blocks.size(); ++i)
+    compressed_blocks.emplace(unknown_blocks[i].digest, (*compressed)[i]);
+
+  for (const SyncBlock& block : blocks)
+  {
+    WriteDigest(packet, block.digest);
+    m_sent_bytes += block.digest.size() + 1;
+
+    // Only the first copy of a block repeated in this stream is sent compressed
+    if (m_known.contains(block.digest))
+    {
+      packet << SyncBlockKind::Known;
+      continue;
+    }
+
+    const std::vector<u8>& out = *compressed_blocks[block.digest];
+    packet << SyncBlockKind::Compressed;
+    packet << static_cast<u32>(out.size());
+    packet.append(out.data(), out.size());
+    m_sent_bytes += sizeof(u32) + out.size();
+    m_known.insert(block.digest);
+  }
+
+  m_raw_bytes += size;
+  return true;
+}
+
+bool SyncBlockEncoder::EncodeBlocks(const std::set<SyncBlockDigest>& digests, sf::Packet& packet)
+{
+  const std::vector<SyncBlock> blocks = m_cache.Find(digests);
+  const auto compressed = m_cache.Compress(blocks);
+  if (!compressed)
+    return false;
+
+  packet << static_cast<u32>(blocks.size());
+  for (size_t i = 0; i < blocks.size(); ++i)
+  {
+    const std::vector<u8>& out = *(*compressed)[i];
+    WriteDigest(packet, blocks[i].digest);
+    packet << static_cast<u32>(blocks[i].size) << static_cast<u32>(out.size());
+    packet.append(out.data(), out.size());
+    m_raw_bytes += blocks[i].size;
+    m_sent_bytes += blocks[i].digest.size() + sizeof(u32) * 2 + out.size();
+  }
+  return true;
+}
+
+SyncBlockStore::SyncBlockStore(std::string path, u64 max_size)
+    : m_path(std::move(path)), m_max_size(max_size)
+{
+}
+
+std::string SyncBlockStore::GetBlockPath(const SyncBlockDigest& digest) const
+{
+  return fmt::format("{}{:02x}", m_path, fmt::join(digest, ""));
+}
+
+std::vector<SyncBlockDigest> SyncBlockStore::GetDigests() const
+{
+  std::vector<SyncBlockDigest> digests;
+  if (!File::IsDirectory(m_path))
+    return digests;
+
+  for (const File::FSTEntry& entry : File::ScanDirectoryTree(m_path, false).children)
+  {
+    if (entry.isDirectory)
+      continue;
+    if (const std::optional<SyncBlockDigest> digest = ParseDigest(entry.virtualName))
+      digests.push_back(*digest);
+  }
+  return digests;
+}
+
+std::optional<std::vector<u8>> SyncBlockStore::Get(const SyncBlockDigest& digest) const
+{
+  const std::string path = GetBlockPath(digest);
+  File::IOFile file(path, "rb");
+  if (!file || file.GetSize() > SYNC_BLOCK_SIZE)
+    return std::nullopt;
+
+  std::vector<u8> block(file.GetSize());
+  if (!file.ReadBytes(block.data(), block.size()))
+    return std::nullopt;
+  file.Close();
+
+  if (Common::SHA1::CalculateDigest(block) != digest)
+  {
+    WARN_LOG_FMT(NETPLAY, "Removing corrupted save data block {}", path);
+    File::Delete(path);
+    return std::nullopt;
+  }
+
+  // Keep blocks that are still in use when pruning
+  std::error_code error;
+  std::filesystem::last_write_time(StringToPath(path),
+                                   std::filesystem::file_time_type::clock::now(), error);
+
+  return block;
+}
+
+void SyncBlockStore::Put(const SyncBlockDigest& digest, const std::vector<u8>& block)
+{
+  if (!File::CreateFullPath(m_path))
+    return;
+
+  File::IOFile file(GetBlockPath(digest), "wb");
+  if (!file || !file.WriteBytes(block.data(), block.size()))
+    WARN_LOG_FMT(NETPLAY, "Failed to store save data block {}", GetBlockPath(digest));
+}
+
+void SyncBlockStore::Prune()
+{
+  if (!File::IsDirectory(m_path))
+    return;
+
+  std::vector<std::tuple<std::filesystem::file_time_type, u64, std::string>> blocks;
+  for (const File::FSTEntry& entry : File::ScanDirectoryTree(m_path, false).children)
+  {
+    if (entry.isDirectory || !ParseDigest(entry.virtualName))
+      continue;
+
+    std::error_code error;
+    const auto time = std::filesystem::last_write_time(StringToPath(entry.physicalName), error);
+    blocks.emplace_back(error ? std::filesystem::file_time_type{} : time, entry.size,
+                        entry.physicalName);
+  }
+
+  // Newest first
+  std::sort(blocks.begin(), blocks.end(), std::greater<>());
+
+  u64 total_size = 0;
+  for (const auto& [time, size, path] : blocks)
+  {
+    total_size += size;
+    if (total_size > m_max_size)
+      File::Delete(path);
+  }
+}
+
+SyncBlockDecoder::SyncBlockDecoder(SyncBlockStore store) : m_store(std::move(store))
+{
+}
+
+// Reads a u32 length and zstd frame, and checks the block against its digest
+static std::optional<std::vector<u8>> ReadCompressedBlock(sf::Packet& packet,
+                                                          const SyncBlockDigest& digest,
+                                                          size_t block_size,
+                                                          std::vector<u8>& in_buffer)
+{
+  u32 compressed_size;
+  packet >> compressed_size;
+  if (!packet || compressed_size > ZSTD_compressBound(SYNC_BLOCK_SIZE))
+    return std::nullopt;
+
+  in_buffer.resize(compressed_size);
+  for (u8& byte : in_buffer)
+    packet >> byte;
+  if (!packet)
+    return std::nullopt;
+
+  std::vector<u8> block(block_size);
+  const size_t out_size =
+      ZSTD_decompress(block.data(), block.size(), in_buffer.data(), in_buffer.size());
+  if (ZSTD_isError(out_size) || out_size != block_size ||
+      Common::SHA1::CalculateDigest(block) != digest)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Failed to decompress save data block {:02x}", fmt::join(digest, ""));
+    return std::nullopt;
+  }
+  return block;
+}
+
+std::optional<std::vector<u8>> SyncBlockDecoder::GetKnownBlock(const SyncBlockDigest& digest)
+{
+  const auto it = m_received.find(digest);
+  if (it != m_received.end())
+    return it->second;
+  return m_store.Get(digest);
+}
+
+std::optional<std::vector<u8>> SyncBlockDecoder::Decode(sf::Packet& packet)
+{
+  const u64 size = Common::PacketReadU64(packet);
+
+  std::vector<u8> data;
+  std::vector<u8> in_buffer;
+  while (data.size() < size)
+  {
+    const size_t block_size =
+        static_cast<size_t>(std::min<u64>(SYNC_BLOCK_SIZE, size - data.size()));
+    const SyncBlockDigest digest = ReadDigest(packet);
+    SyncBlockKind kind;
+    packet >> kind;
+    if (!packet)
+      return std::nullopt;
+
+    std::optional<std::vector<u8>> block;
+    if (kind == SyncBlockKind::Known)
+    {
+      block = GetKnownBlock(digest);
+      if (!block)
+      {
+        // Keep reading, so the server can send every block this stream lacks at once
+        WARN_LOG_FMT(NETPLAY, "Save data block {:02x} is missing", fmt::join(digest, ""));
+        m_missing.insert(digest);
+        data.resize(data.size() + block_size);
+        continue;
+      }
+    }
+    else if (kind == SyncBlockKind::Compressed)
+    {
+      block = ReadCompressedBlock(packet, digest, block_size, in_buffer);
+      if (!block)
+        return std::nullopt;
+
+      m_store.Put(digest, *block);
+      m_received.emplace(digest, *block);
+    }
+    else
+    {
+      return std::nullopt;
+    }
+
+    if (block->size() != block_size)
+      return std::nullopt;
+    data.insert(data.end(), block->begin(), block->end());
+  }
+
+  if (!m_missing.empty())
+    return std::nullopt;
+  return data;
+}
+bool SyncBlockDecoder::AddBlocks(sf::Packet& packet)
+{
+  u32 count;
+  packet >> count;
+  if (!packet || count > MAX_SYNC_BLOCK_DIGESTS)
+    return false;
+
+  std::vector<u8> in_buffer;
+  for (u32 i = 0; i < count; ++i)
+  {
+    const SyncBlockDigest digest = ReadDigest(packet);
+    u32 block_size;
+    packet >> block_size;
+    if (!packet || block_size > SYNC_BLOCK_SIZE)
+      return false;
+
+    const std::optional<std::vector<u8>> block =
+        ReadCompressedBlock(packet, digest, block_size, in_buffer);
+    if (!block)
+      return false;
+
+    m_store.Put(digest, *block);
+    m_received.emplace(digest, *block);
+    m_missing.erase(digest);
+  }
+
+  const bool complete = m_missing.empty();
+  m_missing.clear();
+  return complete;
+}
+}  // namespace NetPlay
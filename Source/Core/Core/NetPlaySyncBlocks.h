@@ -0,0 +1,137 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+
+// Save data is sent to NetPlay clients as a stream of content addressed blocks. Before the server
+// sends anything, every client reports the digests of the blocks it kept from earlier sessions,
+// and blocks a client already has are sent as just their digest. The others are compressed with
+// zstd, in parallel, once per session no matter how many clients need them.
+//
+// Stream format: u64 size, then for every block of up to SYNC_BLOCK_SIZE bytes its SHA-1 digest
+// and a SyncBlockKind. Compressed blocks are followed by a u32 length and the zstd frame.
+//
+// A client that lost or corrupted a block it reported asks for the missing blocks, which come back
+// as a u32 count and for every block its digest, u32 size, u32 length and zstd frame.
+
+namespace NetPlay
+{
+constexpr u32 SYNC_BLOCK_SIZE = 64 * 1024;
+
+using SyncBlockDigest = Common::SHA1::Digest;
+
+enum class SyncBlockKind : u8
+{
+  // The client has the block already, from its store or earlier in this session
+  Known = 0,
+  Compressed = 1,
+};
+
+void WriteSyncBlockDigests(sf::Packet& packet, const std::vector<SyncBlockDigest>& digests);
+std::optional<std::set<SyncBlockDigest>> ReadSyncBlockDigests(sf::Packet& packet);
+
+struct SyncBlock
+{
+  SyncBlockDigest digest;
+  const u8* data;
+  size_t size;
+};
+
+// Server side. Holds the compressed blocks of one save data sync, shared by every client.
+class SyncBlockCache
+{
+public:
+  // Returns the compressed form of each block, compressing the ones not seen yet on several
+  // threads. Returns nothing if compression failed.
+  std::optional<std::vector<const std::vector<u8>*>> Compress(const std::vector<SyncBlock>& blocks);
+
+  // Keeps a copy of the blocks, so they can still be sent to a client that lost them
+  void Keep(const std::vector<SyncBlock>& blocks);
+  std::vector<SyncBlock> Find(const std::set<SyncBlockDigest>& digests);
+
+  void Clear();
+
+private:
+  std::mutex m_mutex;
+  std::map<SyncBlockDigest, std::vector<u8>> m_blocks;
+  std::map<SyncBlockDigest, std::vector<u8>> m_kept_blocks;
+};
+
+// Writes the streams for one client
+class SyncBlockEncoder
+{
+public:
+  SyncBlockEncoder(SyncBlockCache& cache, std::set<SyncBlockDigest> known);
+
+  bool Encode(const u8* data, size_t size, sf::Packet& packet);
+  // Writes the blocks a client asked for, leaving out the ones never encoded
+  bool EncodeBlocks(const std::set<SyncBlockDigest>& digests, sf::Packet& packet);
+
+  u64 GetRawBytes() const { return m_raw_bytes; }
+  u64 GetSentBytes() const { return m_sent_bytes; }
+
+private:
+  SyncBlockCache& m_cache;
+  std::set<SyncBlockDigest> m_known;
+  u64 m_raw_bytes = 0;
+  u64 m_sent_bytes = 0;
+};
+
+// Client side. Keeps received blocks on disk, one file per block named after its digest, so the
+// next session only has to send what changed.
+class SyncBlockStore
+{
+public:
+  // Blocks beyond max_size are pruned least recently used first
+  explicit SyncBlockStore(std::string path, u64 max_size = DEFAULT_MAX_SIZE);
+
+  static constexpr u64 DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+  std::vector<SyncBlockDigest> GetDigests() const;
+  std::optional<std::vector<u8>> Get(const SyncBlockDigest& digest) const;
+  void Put(const SyncBlockDigest& digest, const std::vector<u8>& block);
+
+  // Call before reporting the digests, so nothing reported goes away during the sync
+  void Prune();
+
+private:
+  std::string GetBlockPath(const SyncBlockDigest& digest) const;
+
+  std::string m_path;
+  u64 m_max_size;
+};
+
+// Reads the streams written by a SyncBlockEncoder
+class SyncBlockDecoder
+{
+public:
+  explicit SyncBlockDecoder(SyncBlockStore store);
+
+  // Fails if a known block is missing or corrupted, these are then returned by GetMissingBlocks
+  std::optional<std::vector<u8>> Decode(sf::Packet& packet);
+
+  const std::set<SyncBlockDigest>& GetMissingBlocks() const { return m_missing; }
+  // Reads the blocks written by SyncBlockEncoder::EncodeBlocks. Fails if any is still missing.
+  bool AddBlocks(sf::Packet& packet);
+
+private:
+  std::optional<std::vector<u8>> GetKnownBlock(const SyncBlockDigest& digest);
+
+  SyncBlockStore m_store;
+  // Blocks received this session, which the server also treats as known
+  std::map<SyncBlockDigest, std::vector<u8>> m_received;
+  std::set<SyncBlockDigest> m_missing;
+};
+}  // namespace NetPlay
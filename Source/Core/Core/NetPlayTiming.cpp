@@ -0,0 +1,161 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayTiming.h"
+
+#include <algorithm>
+#include <bit>
+
+#include <fmt/format.h>
+
+#include "Common/Timer.h"
+
+namespace NetPlay
+{
+void TimingHistogram::Add(u32 value)
+{
+  const size_t bucket = std::min<size_t>(std::bit_width(value), BUCKETS - 1);
+  ++counts[bucket];
+}
+
+u64 TimingHistogram::GetTotal() const
+{
+  u64 total = 0;
+  for (u64 count : counts)
+    total += count;
+  return total;
+}
+
+u32 TimingHistogram::GetQuantileBound(double quantile) const
+{
+  const u64 total = GetTotal();
+  u64 seen = 0;
+  for (size_t bucket = 0; bucket < BUCKETS - 1; ++bucket)
+  {
+    seen += counts[bucket];
+    if (seen > 0 && seen >= quantile * total)
+      return GetLowerBound(bucket + 1);
+  }
+  return GetLowerBound(BUCKETS - 1);
+}
+
+u32 TimingHistogram::GetLowerBound(size_t bucket)
+{
+  return bucket == 0 ? 0 : 1u << (bucket - 1);
+}
+
+std::string TimingHistogram::GetLabel(size_t bucket)
+{
+  if (bucket == BUCKETS - 1)
+    return fmt::format("{}+", GetLowerBound(bucket));
+  return fmt::format("{}-{}", GetLowerBound(bucket), GetLowerBound(bucket + 1));
+}
+
+void TimingRecorder::Record(EventType type, u8 pad, u32 value)
+{
+  RecordAt(type, pad, value, Common::Timer::NowUs());
+}
+
+void TimingRecorder::RecordAt(EventType type, u8 pad, u32 value, u64 time_us)
+{
+  const u64 index = m_head.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = m_ring[index % RING_SIZE];
+
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.time_us.store(time_us, std::memory_order_relaxed);
+  slot.value.store(value, std::memory_order_relaxed);
+  slot.type.store(static_cast<u8>(type), std::memory_order_relaxed);
+  slot.pad.store(pad, std::memory_order_relaxed);
+  slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+TimingSummary TimingRecorder::GetSummary()
+{
+  std::lock_guard lk(m_summary_lock);
+  Drain();
+  return m_summary;
+}
+
+void TimingRecorder::Reset()
+{
+  std::lock_guard lk(m_summary_lock);
+  m_tail = m_head.load(std::memory_order_acquire);
+  m_last_arrival_us = {};
+  m_summary = {};
+}
+
+void TimingRecorder::Drain()
+{
+  const u64 head = m_head.load(std::memory_order_acquire);
+  if (head - m_tail > RING_SIZE)
+  {
+    m_summary.dropped_events += head - RING_SIZE - m_tail;
+    m_tail = head - RING_SIZE;
+  }
+
+  for (; m_tail < head; ++m_tail)
+  {
+    const Slot& slot = m_ring[m_tail % RING_SIZE];
+    const u64 sequence = slot.sequence.load(std::memory_order_acquire);
+    const u64 time_us = slot.time_us.load(std::memory_order_relaxed);
+    const u32 value = slot.value.load(std::memory_order_relaxed);
+    const u8 type = slot.type.load(std::memory_order_relaxed);
+    const u8 pad = slot.pad.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (sequence != m_tail + 1 || slot.sequence.load(std::memory_order_relaxed) != sequence)
+    {
+      // Still being written, pick it up next time
+      if (sequence <= m_tail + 1)
+        break;
+
+      // Overwritten by a writer that lapped the ring
+      ++m_summary.dropped_events;
+      continue;
+    }
+
+    Apply(static_cast<EventType>(type), pad, value, time_us);
+  }
+}
+
+void TimingRecorder::Apply(EventType type, u8 pad, u32 value, u64 time_us)
+{
+  switch (type)
+  {
+  case EventType::Frame:
+    ++m_summary.frames;
+    break;
+
+  case EventType::Stall:
+    ++m_summary.stalls;
+    m_summary.stall_us += value;
+    m_summary.max_stall_us = std::max(m_summary.max_stall_us, value);
+    m_summary.stall_ms.Add(value / 1000);
+    break;
+
+  case EventType::PadArrival:
+  {
+    ++m_summary.pad_arrivals;
+    std::optional<u64>& last = m_last_arrival_us[pad % m_last_arrival_us.size()];
+    // Events of different threads can be recorded slightly out of order
+    if (last && time_us >= *last)
+      m_summary.arrival_interval_ms.Add(static_cast<u32>((time_us - *last) / 1000));
+    last = time_us;
+    break;
+  }
+
+  case EventType::BufferDepth:
+    m_summary.buffer_depth.Add(value);
+    break;
+
+  case EventType::HostPoll:
+    ++m_summary.host_polls;
+    break;
+
+  case EventType::GolfSwitch:
+    ++m_summary.golf_switches;
+    break;
+  }
+}
+}  // namespace NetPlay
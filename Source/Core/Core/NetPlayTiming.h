@@ -0,0 +1,107 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace NetPlay
+{
+// Counts over power of two buckets: [0, 1), [1, 2), [2, 4) ... and everything from
+// 2^(BUCKETS - 2) up in the last one
+struct TimingHistogram
+{
+  static constexpr size_t BUCKETS = 10;
+
+  std::array<u64, BUCKETS> counts{};
+
+  void Add(u32 value);
+  u64 GetTotal() const;
+  // Upper bound of the bucket the quantile falls into, the last bucket has none and returns its
+  // lower bound
+  u32 GetQuantileBound(double quantile) const;
+
+  static u32 GetLowerBound(size_t bucket);
+  // "0-1", "1-2" ... "256+"
+  static std::string GetLabel(size_t bucket);
+};
+
+struct TimingSummary
+{
+  // Batched pad polls, one per frame
+  u64 frames = 0;
+  // Polls that had to wait for remote input, and how long
+  u64 stalls = 0;
+  u64 stall_us = 0;
+  u32 max_stall_us = 0;
+  TimingHistogram stall_ms;
+  // Time between two inputs of the same remote pad arriving
+  u64 pad_arrivals = 0;
+  TimingHistogram arrival_interval_ms;
+  // Inputs waiting in the pad buffer when one was taken out
+  TimingHistogram buffer_depth;
+  u64 host_polls = 0;
+  u64 golf_switches = 0;
+  // Events overwritten before they were summarized
+  u64 dropped_events = 0;
+};
+
+// Records NetPlay timing events from the CPU and NetPlay threads without taking a lock, and folds
+// them into a TimingSummary when asked.
+//
+// Events go into a fixed ring. Each slot is guarded by a sequence number that a writer clears
+// before and sets after filling it, so the reader can tell a slot that is being written or was
+// overwritten since.
+class TimingRecorder
+{
+public:
+  enum class EventType : u8
+  {
+    Frame,
+    // value is the time waited in microseconds
+    Stall,
+    // value is the number of inputs buffered for the pad afterwards
+    PadArrival,
+    // value is the number of inputs buffered for the pad before one is taken
+    BufferDepth,
+    HostPoll,
+    GolfSwitch,
+  };
+
+  static constexpr size_t RING_SIZE = 4096;
+
+  void Record(EventType type, u8 pad = 0, u32 value = 0);
+  void RecordAt(EventType type, u8 pad, u32 value, u64 time_us);
+
+  // Summarizes what was recorded since the last call and returns the totals since Reset
+  TimingSummary GetSummary();
+  void Reset();
+
+private:
+  struct Slot
+  {
+    std::atomic<u64> sequence{0};
+    std::atomic<u64> time_us{0};
+    std::atomic<u32> value{0};
+    std::atomic<u8> type{0};
+    std::atomic<u8> pad{0};
+  };
+
+  void Drain();
+  void Apply(EventType type, u8 pad, u32 value, u64 time_us);
+
+  std::array<Slot, RING_SIZE> m_ring;
+  std::atomic<u64> m_head{0};
+
+  std::mutex m_summary_lock;
+  u64 m_tail = 0;
+  std::array<std::optional<u64>, 4> m_last_arrival_us;
+  TimingSummary m_summary;
+};
+}  // namespace NetPlay
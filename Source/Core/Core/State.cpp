@@ -6,11 +6,15 @@
 #include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstring>
 #include <filesystem>
 #include <locale>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
+#include <optional>
+#include <span>
 #include <string>
 #include <thread>
 #include <utility>
@@ -35,17 +39,22 @@
 
 #include "Core/AchievementManager.h"
 #include "Core/Config/AchievementSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
+#include "Core/HW/DSP.h"
 #include "Core/HW/HW.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateCompression.h"
+#include "Core/StateRing.h"
 #include "Core/System.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
@@ -77,7 +86,14 @@ static std::mutex s_load_or_save_in_progress_mutex;
 struct CompressAndDumpState_args
 {
   std::vector<u8> buffer_vector;
+  // For the chunked compression types, the DoState data at the start of buffer_vector. The memory
+  // regions follow it from the next chunk, either copied into buffer_vector or in
+  // compressed_regions.
+  size_t state_size = 0;
+  std::optional<CompressedChunks> compressed_regions;
+  u64 compressed_regions_size = 0;
   std::string filename;
+  CompressionType compression_type = CompressionType::Uncompressed;
   std::shared_ptr<Common::Event> state_write_done_event;
 };
 
@@ -88,6 +104,12 @@ static std::mutex s_save_thread_mutex;
 // Queue for compressing and writing savestates to disk.
 static Common::WorkQueueThread<CompressAndDumpState_args> s_save_thread;
 
+// Snapshots for rewinding and the at-bat retry point
+static std::mutex s_rewind_mutex;
+static std::unique_ptr<StateRing> s_rewind_ring;
+static u32 s_rewind_seconds = 0;
+static std::atomic<bool> s_rewind_capture_pending = false;
+
 // Keeps track of savestate writes that are currently happening, so we don't load a state while
 // another one is still saving. This is particularly important so if you save to a slot and then
 // immediately load from the same one, you don't accidentally load the state that's still at that
@@ -100,7 +122,9 @@ static std::condition_variable s_state_write_queue_is_empty;
 constexpr u32 STATE_VERSION = 167;  // Last changed in PR 12494
 
 // Increase this if the StateExtendedHeader definition changes
-constexpr u32 EXTENDED_HEADER_VERSION = 1;  // Last changed in PR 12217
+// Older headers are still read. Version 1 never has a chunk index, version 2 has the memory regions
+// inline in the DoState data.
+constexpr u32 EXTENDED_HEADER_VERSION = 3;  // Last changed for the memory regions header
 
 // Change this if we ever need to store more data in the extended header
 constexpr u32 COMPRESSED_DATA_OFFSET = 0;
@@ -137,6 +161,14 @@ void EnableCompression(bool compression)
   s_use_compression = compression;
 }
 
+static CompressionType GetCompressionType()
+{
+  if (!s_use_compression)
+    return CompressionType::Uncompressed;
+  return Config::Get(Config::MAIN_SAVESTATE_ZSTD) ? CompressionType::ChunkedZstd :
+                                                    CompressionType::ChunkedLZ4;
+}
+
 static void DoState(PointerWrap& p)
 {
   auto& system = Core::System::GetInstance();
@@ -201,29 +233,44 @@ static void DoState(PointerWrap& p)
   p.DoMarker("Gecko");
 }
 
-void LoadFromBuffer(std::vector<u8>& buffer)
+static void LoadBuffer(std::vector<u8>& buffer)
 {
-  if (NetPlay::IsNetPlayRunning())
+  Core::RunOnCPUThread(
+      [&] {
+        u8* ptr = buffer.data();
+        PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+        DoState(p);
+      },
+      true);
+}
+
+// Rollback NetPlay loads its own snapshots, at the same emulated point on every client
+static bool IsLoadingAllowed(bool for_rollback = false)
+{
+  const bool rollback_allowed = for_rollback && NetPlay::IsRollbackRunning() && Core::IsCPUThread();
+  if (NetPlay::IsNetPlayRunning() && !rollback_allowed)
   {
     OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
-    return;
+    return false;
   }
 
 #ifdef USE_RETRO_ACHIEVEMENTS
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
   {
     OSD::AddMessage("Loading savestates is disabled in RetroAchievements hardcore mode");
-    return;
+    return false;
   }
 #endif  // USE_RETRO_ACHIEVEMENTS
 
-  Core::RunOnCPUThread(
-      [&] {
-        u8* ptr = buffer.data();
-        PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-        DoState(p);
-      },
-      true);
+  return true;
+}
+
+void LoadFromBuffer(std::vector<u8>& buffer)
+{
+  if (!IsLoadingAllowed())
+    return;
+
+  LoadBuffer(buffer);
 }
 
 void SaveToBuffer(std::vector<u8>& buffer)
@@ -244,6 +291,168 @@ void SaveToBuffer(std::vector<u8>& buffer)
       true);
 }
 
+// The memory regions PointerWrap::DoMemoryRegion handles, in the same order
+static StateRing::Regions GetMemoryRegions(Core::System& system)
+{
+  auto& memory = system.GetMemory();
+  StateRing::Regions regions;
+  regions.emplace_back(memory.GetRAM(), memory.GetRamSize());
+  if (memory.GetFakeVMEM())
+    regions.emplace_back(memory.GetFakeVMEM(), memory.GetFakeVMemSize());
+  if (memory.GetEXRAM())
+    regions.emplace_back(memory.GetEXRAM(), memory.GetExRamSize());
+  if (!system.IsWii())
+    regions.emplace_back(system.GetDSP().GetARAMPtr(), DSP::ARAM_SIZE);
+  return regions;
+}
+
+// The ring takes the memory regions from GetMemoryRegions
+static void SaveWithoutMemoryRegions(std::vector<u8>& buffer)
+{
+  std::vector<std::span<u8>> regions;
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  p_measure.SetExternalRegions(&regions);
+  DoState(p_measure);
+  const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+  buffer.resize(buffer_size);
+
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+  p.SetExternalRegions(&regions);
+  DoState(p);
+}
+
+static void LoadWithoutMemoryRegions(std::vector<u8>& buffer)
+{
+  std::vector<std::span<u8>> regions;
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  p.SetExternalRegions(&regions);
+  DoState(p);
+}
+
+void CaptureRollbackSnapshot(StateRing& ring, u64 frame)
+{
+  ring.Capture(frame, GetMemoryRegions(Core::System::GetInstance()), SaveWithoutMemoryRegions);
+}
+
+std::optional<u64> RestoreRollbackSnapshot(StateRing& ring, u64 frame)
+{
+  if (!IsLoadingAllowed(true))
+    return std::nullopt;
+
+  return ring.Restore(frame, GetMemoryRegions(Core::System::GetInstance()),
+                      LoadWithoutMemoryRegions);
+}
+
+// Runs job on the CPU thread from the host thread, the same way savestates are taken. The CPU is
+// paused between blocks, which may be a little into the next frame, and like any savestate the
+// state taken there loads back fine. Rewinding is local, so landing a few blocks off is harmless.
+static void QueueRewindJob(std::function<void(StateRing& ring, Core::System& system)> job,
+                           std::atomic<bool>* pending = nullptr)
+{
+  Core::QueueHostJob([job = std::move(job), pending] {
+    if (Core::IsRunningAndStarted())
+    {
+      Core::RunOnCPUThread(
+          [&] {
+            std::lock_guard lk(s_rewind_mutex);
+            if (s_rewind_ring)
+              job(*s_rewind_ring, Core::System::GetInstance());
+          },
+          true);
+    }
+    if (pending)
+      *pending = false;
+  });
+}
+
+static bool HasRewindRing()
+{
+  std::lock_guard lk(s_rewind_mutex);
+  return s_rewind_ring != nullptr;
+}
+
+void UpdateRewind(u64 frame)
+{
+  // Rewinding would desync NetPlay
+  const u32 seconds = NetPlay::IsNetPlayRunning() ? 0 : Config::Get(Config::MAIN_REWIND_SECONDS);
+  const u32 interval = std::max(Config::Get(Config::MAIN_REWIND_INTERVAL), 1u);
+  if (seconds != s_rewind_seconds)
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    s_rewind_seconds = seconds;
+    if (seconds == 0)
+    {
+      s_rewind_ring.reset();
+      return;
+    }
+
+    const double frames =
+        seconds * Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
+    s_rewind_ring = std::make_unique<StateRing>(static_cast<size_t>(frames / interval) + 1);
+  }
+
+  if (seconds == 0 || frame % interval != 0 || s_rewind_capture_pending.exchange(true))
+    return;
+
+  QueueRewindJob(
+      [](StateRing& ring, Core::System& system) {
+        ring.Capture(system.GetMovie().GetCurrentFrame(), GetMemoryRegions(system),
+                     SaveWithoutMemoryRegions);
+      },
+      &s_rewind_capture_pending);
+}
+
+void Rewind(double seconds)
+{
+  if (!IsLoadingAllowed())
+    return;
+
+  QueueRewindJob([seconds](StateRing& ring, Core::System& system) {
+    const u64 current_frame = system.GetMovie().GetCurrentFrame();
+    const u64 frames =
+        static_cast<u64>(seconds * system.GetVideoInterface().GetTargetRefreshRate());
+    const std::optional<u64> frame =
+        ring.Restore(current_frame - std::min(frames, current_frame), GetMemoryRegions(system),
+                     LoadWithoutMemoryRegions);
+    if (frame)
+      OSD::AddMessage(fmt::format("Rewound {} frames", current_frame - *frame));
+  });
+}
+
+void SetRetryPoint()
+{
+  // Called at every at-bat, don't bother the host and CPU threads when there is nothing to keep
+  if (NetPlay::IsNetPlayRunning() || !HasRewindRing())
+    return;
+
+  QueueRewindJob([](StateRing& ring, Core::System& system) {
+    ring.SetRetryPoint(system.GetMovie().GetCurrentFrame(), GetMemoryRegions(system),
+                       SaveWithoutMemoryRegions);
+  });
+}
+
+void Retry()
+{
+  if (!IsLoadingAllowed())
+    return;
+
+  if (!HasRewindRing())
+  {
+    OSD::AddMessage("No at-bat to retry");
+    return;
+  }
+
+  QueueRewindJob([](StateRing& ring, Core::System& system) {
+    if (ring.Retry(GetMemoryRegions(system), LoadWithoutMemoryRegions))
+      OSD::AddMessage("Retrying the at-bat");
+    else
+      OSD::AddMessage("No at-bat to retry");
+  });
+}
+
 namespace
 {
 struct SlotWithTimestamp
@@ -313,51 +522,33 @@ static bool CompareTimestamp(const SlotWithTimestamp& lhs, const SlotWithTimesta
   return lhs.timestamp < rhs.timestamp;
 }
 
-static void CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f)
-{
-  u64 total_bytes_compressed = 0;
-
-  while (true)
-  {
-    u64 bytes_left_to_compress = size - total_bytes_compressed;
-
-    int bytes_to_compress =
-        static_cast<int>(std::min(static_cast<u64>(LZ4_MAX_INPUT_SIZE), bytes_left_to_compress));
-    int compressed_buffer_size = LZ4_compressBound(bytes_to_compress);
-    auto compressed_buffer = std::make_unique<char[]>(compressed_buffer_size);
-    s32 compressed_len =
-        LZ4_compress_default(reinterpret_cast<const char*>(raw_buffer) + total_bytes_compressed,
-                             compressed_buffer.get(), bytes_to_compress, compressed_buffer_size);
-
-    if (compressed_len == 0)
-    {
-      PanicAlertFmtT("Internal LZ4 Error - compression failed");
-      break;
-    }
-
-    // The size of the data to write is 'compressed_len'
-    f.WriteArray(&compressed_len, 1);
-    f.WriteBytes(compressed_buffer.get(), compressed_len);
-
-    total_bytes_compressed += bytes_to_compress;
-    if (total_bytes_compressed == size)
-      break;
-  }
-}
-
-static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
+static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size,
+                                 CompressionType compression_type,
+                                 std::span<const u32> chunk_sizes, size_t state_size)
 {
   StateExtendedBaseHeader& base_header = extended_header.base_header;
   base_header.header_version = EXTENDED_HEADER_VERSION;
-  base_header.compression_type =
-      s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
+  base_header.compression_type = compression_type;
   base_header.payload_offset = COMPRESSED_DATA_OFFSET;
   base_header.uncompressed_size = uncompressed_size;
 
+  if (IsChunkedCompression(compression_type))
+  {
+    extended_header.chunk_index_header.chunk_size = STATE_CHUNK_SIZE;
+    extended_header.chunk_index_header.chunk_count = static_cast<u32>(chunk_sizes.size());
+    extended_header.chunk_sizes.assign(chunk_sizes.begin(), chunk_sizes.end());
+    extended_header.memory_regions_header.state_size = state_size;
+    base_header.payload_offset +=
+        static_cast<u32>(sizeof(StateChunkIndexHeader) + chunk_sizes.size() * sizeof(u32) +
+                         sizeof(StateMemoryRegionsHeader));
+  }
+
   // If more fields are added to StateExtendedHeader, set them here.
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+static void WriteHeadersToFile(size_t uncompressed_size, CompressionType compression_type,
+                               std::span<const u32> chunk_sizes, size_t state_size,
+                               File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -369,13 +560,20 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
   StateExtendedHeader extended_header{};
-  CreateExtendedHeader(extended_header, uncompressed_size);
+  CreateExtendedHeader(extended_header, uncompressed_size, compression_type, chunk_sizes,
+                       state_size);
 
   f.WriteArray(&header.legacy_header, 1);
   f.WriteArray(&header.version_header, 1);
   f.WriteString(header.version_string);
 
   f.WriteArray(&extended_header.base_header, 1);
+  if (IsChunkedCompression(compression_type))
+  {
+    f.WriteArray(&extended_header.chunk_index_header, 1);
+    f.WriteArray(extended_header.chunk_sizes.data(), extended_header.chunk_sizes.size());
+    f.WriteArray(&extended_header.memory_regions_header, 1);
+  }
   // If StateExtendedHeader is amended to include more than the base, add WriteBytes() calls here.
 }
 
@@ -384,6 +582,27 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
   const u8* const buffer_data = save_args.buffer_vector.data();
   const size_t buffer_size = save_args.buffer_vector.size();
   const std::string& filename = save_args.filename;
+  const CompressionType compression_type = save_args.compression_type;
+  const std::optional<CompressedChunks>& compressed_regions = save_args.compressed_regions;
+
+  std::optional<CompressedChunks> chunks;
+  std::vector<u32> chunk_sizes;
+  if (IsChunkedCompression(compression_type))
+  {
+    chunks = CompressChunks(save_args.buffer_vector, compression_type);
+    if (!chunks)
+    {
+      PanicAlertFmtT("Internal Error - savestate compression failed");
+      return;
+    }
+
+    chunk_sizes = chunks->sizes;
+    if (compressed_regions)
+    {
+      chunk_sizes.insert(chunk_sizes.end(), compressed_regions->sizes.begin(),
+                         compressed_regions->sizes.end());
+    }
+  }
 
   // Find free temporary filename.
   // TODO: The file exists check and the actual opening of the file should be atomic, we don't have
@@ -403,12 +622,15 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
+  WriteHeadersToFile(buffer_size + save_args.compressed_regions_size, compression_type, chunk_sizes,
+                     save_args.state_size, f);
 
-  if (s_use_compression)
-    CompressBufferToFile(buffer_data, buffer_size, f);
+  if (chunks)
+    f.WriteBytes(chunks->data.data(), chunks->data.size());
   else
     f.WriteBytes(buffer_data, buffer_size);
+  if (compressed_regions)
+    f.WriteBytes(compressed_regions->data.data(), compressed_regions->data.size());
 
   const std::string last_state_filename = File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav";
   const std::string last_state_dtmname = last_state_filename + ".dtm";
@@ -467,20 +689,63 @@ void SaveAs(const std::string& filename, bool wait)
           ++s_state_writes_in_queue;
         }
 
+        // The chunked compression types keep the memory regions out of the DoState data
+        const CompressionType compression_type = GetCompressionType();
+        const bool external_regions = IsChunkedCompression(compression_type);
+        std::vector<std::span<u8>> regions;
+
         // Measure the size of the buffer.
         u8* ptr = nullptr;
         PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+        if (external_regions)
+          p_measure.SetExternalRegions(&regions);
         DoState(p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+        const size_t state_size = reinterpret_cast<size_t>(ptr);
+        regions.clear();
 
         // Then actually do the write.
         std::vector<u8> current_buffer;
-        current_buffer.resize(buffer_size);
+        current_buffer.resize(state_size);
         ptr = current_buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+        PointerWrap p(&ptr, state_size, PointerWrap::Mode::Write);
+        if (external_regions)
+          p.SetExternalRegions(&regions);
         DoState(p);
 
-        if (p.IsWriteMode())
+        // When the caller waits anyway, the memory regions are compressed straight from emulated
+        // memory. Otherwise they are copied once so the worker can compress them while the
+        // emulation goes on.
+        std::optional<CompressedChunks> compressed_regions;
+        u64 compressed_regions_size = 0;
+        bool success = p.IsWriteMode();
+        if (success && external_regions)
+        {
+          size_t regions_size = 0;
+          for (const std::span<u8> region : regions)
+            regions_size += region.size();
+
+          const size_t padded_state_size =
+              GetChunkCount(state_size, STATE_CHUNK_SIZE) * STATE_CHUNK_SIZE;
+          if (wait)
+          {
+            current_buffer.resize(padded_state_size);
+            compressed_regions = CompressRegions(regions, compression_type);
+            compressed_regions_size = regions_size;
+            success = compressed_regions.has_value();
+          }
+          else
+          {
+            current_buffer.resize(padded_state_size + regions_size);
+            u8* out = current_buffer.data() + padded_state_size;
+            for (const std::span<u8> region : regions)
+            {
+              std::memcpy(out, region.data(), region.size());
+              out += region.size();
+            }
+          }
+        }
+
+        if (success)
         {
           Core::DisplayMessage("Saving State...", 1000);
 
@@ -488,7 +753,11 @@ void SaveAs(const std::string& filename, bool wait)
 
           CompressAndDumpState_args save_args;
           save_args.buffer_vector = std::move(current_buffer);
+          save_args.state_size = state_size;
+          save_args.compressed_regions = std::move(compressed_regions);
+          save_args.compressed_regions_size = compressed_regions_size;
           save_args.filename = filename;
+          save_args.compression_type = compression_type;
           if (wait)
           {
             sync_event = std::make_shared<Common::Event>();
@@ -753,7 +1022,39 @@ static bool ValidateHeaders(const StateHeader& header)
   return success;
 }
 
-static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+namespace
+{
+// What LoadFileStateData read. The memory regions stay compressed until DoState has found where
+// they go.
+struct StateFileData
+{
+  std::vector<u8> state;
+
+  bool has_external_regions = false;
+  CompressionType compression_type = CompressionType::Uncompressed;
+  u32 chunk_size = 0;
+  u64 regions_size = 0;
+  std::vector<u32> region_chunk_sizes;
+  std::vector<u8> compressed_data;
+  size_t regions_offset = 0;
+};
+}  // namespace
+
+static bool LoadMemoryRegions(const StateFileData& data,
+                              const std::vector<std::span<u8>>& regions)
+{
+  u64 regions_size = 0;
+  for (const std::span<u8> region : regions)
+    regions_size += region.size();
+  if (regions_size != data.regions_size)
+    return false;
+
+  return DecompressRegions(std::span(data.compressed_data).subspan(data.regions_offset),
+                           data.region_chunk_sizes, data.compression_type, data.chunk_size,
+                           regions);
+}
+
+static void LoadFileStateData(const std::string& filename, StateFileData& ret_data)
 {
   File::IOFile f;
 
@@ -783,15 +1084,44 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
     PanicAlertFmt("Unable to read state header");
     return;
   }
-  // If StateExtendedHeader is amended to include more than the base, add ReadBytes() calls here.
-
-  if (extended_header.base_header.header_version != EXTENDED_HEADER_VERSION)
+  if (extended_header.base_header.header_version == 0 ||
+      extended_header.base_header.header_version > EXTENDED_HEADER_VERSION)
   {
     PanicAlertFmt("State header corrupted");
     return;
   }
 
-  std::vector<u8> buffer;
+  if (IsChunkedCompression(extended_header.base_header.compression_type))
+  {
+    StateChunkIndexHeader& chunk_index_header = extended_header.chunk_index_header;
+    if (!f.ReadArray(&chunk_index_header, 1) || chunk_index_header.chunk_size == 0 ||
+        chunk_index_header.chunk_count > (f.GetSize() - f.Tell()) / sizeof(u32))
+    {
+      PanicAlertFmt("State chunk index corrupted");
+      return;
+    }
+
+    extended_header.chunk_sizes.resize(chunk_index_header.chunk_count);
+    if (!f.ReadArray(extended_header.chunk_sizes.data(), extended_header.chunk_sizes.size()))
+    {
+      PanicAlertFmt("State chunk index corrupted");
+      return;
+    }
+
+    // Older states have the memory regions in the DoState data
+    StateMemoryRegionsHeader& memory_regions_header = extended_header.memory_regions_header;
+    memory_regions_header.state_size = extended_header.base_header.uncompressed_size;
+    if (extended_header.base_header.header_version >= 3 &&
+        !f.ReadArray(&memory_regions_header, 1))
+    {
+      PanicAlertFmt("State header corrupted");
+      return;
+    }
+  }
+  // If StateExtendedHeader is amended to include more than the base, add ReadBytes() calls here.
+
+  StateFileData data;
+  std::vector<u8>& buffer = data.state;
 
   switch (extended_header.base_header.compression_type)
   {
@@ -803,6 +1133,58 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     break;
   }
+  case CompressionType::ChunkedLZ4:
+  case CompressionType::ChunkedZstd:
+  {
+    const std::vector<u32>& chunk_sizes = extended_header.chunk_sizes;
+    const u64 compressed_size = std::accumulate(chunk_sizes.begin(), chunk_sizes.end(), u64{0});
+    if (compressed_size > f.GetSize() - f.Tell())
+    {
+      PanicAlertFmt("State chunk index corrupted");
+      return;
+    }
+
+    std::vector<u8>& compressed_data = data.compressed_data;
+    compressed_data.resize(compressed_size);
+    if (!f.ReadBytes(compressed_data.data(), compressed_data.size()))
+    {
+      PanicAlertFmt("Could not read state data");
+      return;
+    }
+
+    // The DoState data is decompressed now, the memory regions after it by LoadMemoryRegions
+    const u32 chunk_size = extended_header.chunk_index_header.chunk_size;
+    const u64 uncompressed_size = extended_header.base_header.uncompressed_size;
+    const u64 state_size = extended_header.memory_regions_header.state_size;
+    const size_t state_chunk_count = GetChunkCount(state_size, chunk_size);
+    const u64 padded_state_size =
+        state_size == uncompressed_size ? state_size : u64{state_chunk_count} * chunk_size;
+    if (padded_state_size > uncompressed_size || state_chunk_count > chunk_sizes.size())
+    {
+      PanicAlertFmt("State header corrupted");
+      return;
+    }
+
+    data.compression_type =
+        static_cast<CompressionType>(extended_header.base_header.compression_type);
+    data.chunk_size = chunk_size;
+    data.has_external_regions = state_size != uncompressed_size;
+    data.regions_size = uncompressed_size - padded_state_size;
+    data.region_chunk_sizes.assign(chunk_sizes.begin() + state_chunk_count, chunk_sizes.end());
+    data.regions_offset = std::accumulate(chunk_sizes.begin(),
+                                          chunk_sizes.begin() + state_chunk_count, size_t{0});
+
+    buffer.resize(padded_state_size);
+    if (!DecompressChunks(std::span(compressed_data).first(data.regions_offset),
+                          std::span(chunk_sizes).first(state_chunk_count), data.compression_type,
+                          chunk_size, buffer))
+    {
+      PanicAlertFmtT("Internal Error - savestate decompression failed");
+      return;
+    }
+    buffer.resize(state_size);
+    break;
+  }
   case CompressionType::Uncompressed:
   {
     u64 header_len = sizeof(StateHeaderLegacy) + sizeof(StateHeaderVersion) +
@@ -832,7 +1214,7 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
   }
 
   // all good
-  ret_data.swap(buffer);
+  ret_data = std::move(data);
 }
 
 void LoadAs(const std::string& filename)
@@ -878,16 +1260,21 @@ void LoadAs(const std::string& filename)
 
         // brackets here are so buffer gets freed ASAP
         {
-          std::vector<u8> buffer;
-          LoadFileStateData(filename, buffer);
+          StateFileData data;
+          LoadFileStateData(filename, data);
+          std::vector<u8>& buffer = data.state;
 
           if (!buffer.empty())
           {
+            std::vector<std::span<u8>> regions;
             u8* ptr = buffer.data();
             PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+            if (data.has_external_regions)
+              p.SetExternalRegions(&regions);
             DoState(p);
             loaded = true;
-            loadedSuccessfully = p.IsReadMode();
+            loadedSuccessfully =
+                p.IsReadMode() && (!data.has_external_regions || LoadMemoryRegions(data, regions));
           }
         }
 
@@ -944,6 +1331,12 @@ void Shutdown()
 {
   s_save_thread.Shutdown();
 
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    s_rewind_ring.reset();
+    s_rewind_seconds = 0;
+  }
+
   // swapping with an empty vector, rather than clear()ing
   // this gives a better guarantee to free the allocated memory right NOW (as opposed to, actually,
   // never)
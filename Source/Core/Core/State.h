@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -15,6 +16,8 @@
 
 namespace State
 {
+class StateRing;
+
 // number of states
 static const u32 NUM_STATES = 10;
 
@@ -50,6 +53,9 @@ enum CompressionType : u16
 {
   Uncompressed = 0,
   LZ4 = 1,
+  // Fixed-size chunks compressed independently, listed in the chunk index
+  ChunkedLZ4 = 2,
+  ChunkedZstd = 3,
   // Add new compression types after this, as the compression type
   // is numerically stored in the state file.
 };
@@ -67,9 +73,33 @@ static_assert(offsetof(StateExtendedBaseHeader, payload_offset) == 4);
 static_assert(offsetof(StateExtendedBaseHeader, uncompressed_size) == 8);
 static_assert(std::is_trivially_copyable_v<StateExtendedBaseHeader>);
 
+// Follows the base header for the chunked compression types, then the compressed size of every
+// chunk as a u32. payload_offset covers both.
+struct StateChunkIndexHeader
+{
+  u32 chunk_size;
+  u32 chunk_count;
+};
+static_assert(sizeof(StateChunkIndexHeader) == 8);
+static_assert(std::is_trivially_copyable_v<StateChunkIndexHeader>);
+
+// Follows the chunk index since extended header version 3. The memory regions that
+// PointerWrap::DoMemoryRegion handles aren't in the DoState data, they follow it in order starting
+// at the next chunk, so they can be compressed from and decompressed into emulated memory directly.
+struct StateMemoryRegionsHeader
+{
+  u64 state_size;
+};
+static_assert(sizeof(StateMemoryRegionsHeader) == 8);
+static_assert(std::is_trivially_copyable_v<StateMemoryRegionsHeader>);
+
 struct StateExtendedHeader
 {
   StateExtendedBaseHeader base_header;
+  // Only for the chunked compression types
+  StateChunkIndexHeader chunk_index_header;
+  std::vector<u32> chunk_sizes;
+  StateMemoryRegionsHeader memory_regions_header;
   // Feel free to add new fields here, adjusting COMPRESSED_DATA_OFFSET accordingly, as well as
   // CreateExtendedHeader(). Add the appropriate IOFile read/write calls within LoadFileStateData()
   // and WriteHeadersToFile()
@@ -104,11 +134,23 @@ void LoadAs(const std::string& filename);
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 
+// For rollback NetPlay, which saves and loads its own snapshots on the CPU thread, at the same
+// emulated point on every client. Returns the frame of the snapshot that was loaded
+void CaptureRollbackSnapshot(StateRing& ring, u64 frame);
+std::optional<u64> RestoreRollbackSnapshot(StateRing& ring, u64 frame);
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
 void UndoLoadState();
 
+// Rewinding and at-bat retry, from savestates kept in memory while Config::MAIN_REWIND_SECONDS
+// isn't 0. UpdateRewind is called on the CPU thread every frame, the rest from any thread.
+void UpdateRewind(u64 frame);
+void Rewind(double seconds);
+void SetRetryPoint();
+void Retry();
+
 // for calling back into UI code without introducing a dependency on it in core
 using AfterLoadCallbackFunc = std::function<void()>;
 void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback);
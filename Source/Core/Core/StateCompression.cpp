@@ -0,0 +1,286 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateCompression.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include <lz4.h>
+#include <zstd.h>
+
+namespace State
+{
+// zstd's default, still several times faster than the disk on most systems
+static constexpr int ZSTD_COMPRESSION_LEVEL = 3;
+
+bool IsChunkedCompression(u16 compression_type)
+{
+  return compression_type == CompressionType::ChunkedLZ4 ||
+         compression_type == CompressionType::ChunkedZstd;
+}
+
+size_t GetChunkCount(size_t size, u32 chunk_size)
+{
+  return (size + chunk_size - 1) / chunk_size;
+}
+
+// Runs work(chunk) for every chunk across threads, each with its own worker from make_worker so
+// compression contexts aren't shared. Stops early and returns false if any chunk fails.
+template <typename MakeWorker>
+static bool ForEachChunk(size_t chunk_count, size_t thread_count, const MakeWorker& make_worker)
+{
+  if (thread_count == 0)
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  thread_count = std::min(thread_count, chunk_count);
+
+  std::atomic<size_t> next_chunk = 0;
+  std::atomic<bool> failed = false;
+  const auto run = [&] {
+    auto work = make_worker();
+    for (size_t i = next_chunk++; i < chunk_count && !failed; i = next_chunk++)
+    {
+      if (!work(i))
+        failed = true;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(run);
+  run();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  return !failed;
+}
+
+static size_t GetCompressBound(CompressionType type, u32 chunk_size)
+{
+  if (type == CompressionType::ChunkedZstd)
+    return ZSTD_compressBound(chunk_size);
+  return static_cast<size_t>(LZ4_compressBound(static_cast<int>(chunk_size)));
+}
+
+// Where every region starts when they are seen as one buffer, followed by the total size
+template <typename T>
+static std::vector<size_t> GetRegionOffsets(std::span<const std::span<T>> regions)
+{
+  std::vector<size_t> offsets(regions.size() + 1);
+  for (size_t i = 0; i < regions.size(); ++i)
+    offsets[i + 1] = offsets[i] + regions[i].size();
+  return offsets;
+}
+
+static size_t FindRegion(const std::vector<size_t>& offsets, size_t offset)
+{
+  return std::upper_bound(offsets.begin(), offsets.end(), offset) - offsets.begin() - 1;
+}
+
+// The chunk from offset to offset + size if it is within one region, otherwise nullptr
+template <typename T>
+static T* GetContiguousChunk(std::span<const std::span<T>> regions,
+                             const std::vector<size_t>& offsets, size_t offset, size_t size)
+{
+  const size_t region = FindRegion(offsets, offset);
+  if (offset + size > offsets[region + 1])
+    return nullptr;
+  return regions[region].data() + (offset - offsets[region]);
+}
+
+// Calls copy(region_data, chunk_offset, length) for the part of the chunk in every region it
+// crosses, in order
+template <typename T, typename Copy>
+static void ForEachRegionPiece(std::span<const std::span<T>> regions,
+                               const std::vector<size_t>& offsets, size_t offset, size_t size,
+                               const Copy& copy)
+{
+  for (size_t region = FindRegion(offsets, offset), done = 0; done < size; ++region)
+  {
+    const size_t region_offset = offset + done - offsets[region];
+    const size_t length = std::min(size - done, regions[region].size() - region_offset);
+    copy(regions[region].data() + region_offset, done, length);
+    done += length;
+  }
+}
+
+static std::optional<CompressedChunks> Compress(std::span<const std::span<const u8>> regions,
+                                                CompressionType type, u32 chunk_size,
+                                                size_t thread_count)
+{
+  if (!IsChunkedCompression(type) || chunk_size == 0 || chunk_size > LZ4_MAX_INPUT_SIZE)
+    return std::nullopt;
+
+  const std::vector<size_t> offsets = GetRegionOffsets(regions);
+  const size_t chunk_count = GetChunkCount(offsets.back(), chunk_size);
+  const size_t bound = GetCompressBound(type, chunk_size);
+
+  // Every chunk gets room for its worst case, the gaps are closed afterwards
+  CompressedChunks result;
+  result.sizes.resize(chunk_count);
+  result.data.resize(chunk_count * bound);
+
+  const auto make_worker = [&] {
+    std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(nullptr, ZSTD_freeCCtx);
+    if (type == CompressionType::ChunkedZstd)
+      context.reset(ZSTD_createCCtx());
+
+    // gathered holds the chunks that cross from one region to the next
+    return [&, context = std::move(context), gathered = std::vector<u8>()](size_t chunk) mutable {
+      const size_t offset = chunk * chunk_size;
+      const size_t size = std::min<size_t>(chunk_size, offsets.back() - offset);
+      u8* const out = result.data.data() + chunk * bound;
+
+      const u8* in = GetContiguousChunk(regions, offsets, offset, size);
+      if (!in)
+      {
+        gathered.resize(chunk_size);
+        ForEachRegionPiece(regions, offsets, offset, size,
+                           [&](const u8* piece, size_t chunk_offset, size_t length) {
+                             std::memcpy(gathered.data() + chunk_offset, piece, length);
+                           });
+        in = gathered.data();
+      }
+
+      size_t compressed_size;
+      if (type == CompressionType::ChunkedZstd)
+      {
+        if (!context)
+          return false;
+        compressed_size =
+            ZSTD_compressCCtx(context.get(), out, bound, in, size, ZSTD_COMPRESSION_LEVEL);
+        if (ZSTD_isError(compressed_size))
+          return false;
+      }
+      else
+      {
+        const int lz4_size =
+            LZ4_compress_default(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out),
+                                 static_cast<int>(size), static_cast<int>(bound));
+        if (lz4_size <= 0)
+          return false;
+        compressed_size = static_cast<size_t>(lz4_size);
+      }
+
+      result.sizes[chunk] = static_cast<u32>(compressed_size);
+      return true;
+    };
+  };
+
+  if (!ForEachChunk(chunk_count, thread_count, make_worker))
+    return std::nullopt;
+
+  size_t total_size = 0;
+  for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+  {
+    std::memmove(result.data.data() + total_size, result.data.data() + chunk * bound,
+                 result.sizes[chunk]);
+    total_size += result.sizes[chunk];
+  }
+  result.data.resize(total_size);
+  result.data.shrink_to_fit();
+
+  return result;
+}
+
+static bool Decompress(std::span<const u8> data, std::span<const u32> sizes, CompressionType type,
+                       u32 chunk_size, std::span<const std::span<u8>> regions,
+                       size_t thread_count)
+{
+  const std::vector<size_t> region_offsets = GetRegionOffsets(regions);
+  if (!IsChunkedCompression(type) || chunk_size == 0 ||
+      sizes.size() != GetChunkCount(region_offsets.back(), chunk_size))
+  {
+    return false;
+  }
+
+  std::vector<size_t> offsets(sizes.size());
+  size_t total_size = 0;
+  for (size_t chunk = 0; chunk < sizes.size(); ++chunk)
+  {
+    offsets[chunk] = total_size;
+    total_size += sizes[chunk];
+  }
+  if (total_size > data.size())
+    return false;
+
+  const auto make_worker = [&] {
+    std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(nullptr, ZSTD_freeDCtx);
+    if (type == CompressionType::ChunkedZstd)
+      context.reset(ZSTD_createDCtx());
+
+    // scattered holds the chunks that cross from one region to the next
+    return [&, context = std::move(context), scattered = std::vector<u8>()](size_t chunk) mutable {
+      const u8* const in = data.data() + offsets[chunk];
+      const size_t offset = chunk * chunk_size;
+      const size_t size = std::min<size_t>(chunk_size, region_offsets.back() - offset);
+
+      u8* out = GetContiguousChunk(regions, region_offsets, offset, size);
+      if (!out)
+      {
+        scattered.resize(chunk_size);
+        out = scattered.data();
+      }
+
+      // Every chunk but the last one has to fill a whole chunk
+      bool success;
+      if (type == CompressionType::ChunkedZstd)
+      {
+        if (!context)
+          return false;
+        const size_t decompressed_size =
+            ZSTD_decompressDCtx(context.get(), out, size, in, sizes[chunk]);
+        success = !ZSTD_isError(decompressed_size) && decompressed_size == size;
+      }
+      else
+      {
+        const int decompressed_size = LZ4_decompress_safe(
+            reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out),
+            static_cast<int>(sizes[chunk]), static_cast<int>(size));
+        success = decompressed_size >= 0 && static_cast<size_t>(decompressed_size) == size;
+      }
+
+      if (success && out == scattered.data())
+      {
+        ForEachRegionPiece(regions, region_offsets, offset, size,
+                           [&](u8* piece, size_t chunk_offset, size_t length) {
+                             std::memcpy(piece, scattered.data() + chunk_offset, length);
+                           });
+      }
+      return success;
+    };
+  };
+
+  return ForEachChunk(sizes.size(), thread_count, make_worker);
+}
+
+std::optional<CompressedChunks> CompressChunks(std::span<const u8> data, CompressionType type,
+                                               u32 chunk_size, size_t thread_count)
+{
+  return Compress({&data, 1}, type, chunk_size, thread_count);
+}
+
+bool DecompressChunks(std::span<const u8> data, std::span<const u32> sizes, CompressionType type,
+                      u32 chunk_size, std::span<u8> out, size_t thread_count)
+{
+  return Decompress(data, sizes, type, chunk_size, {&out, 1}, thread_count);
+}
+
+std::optional<CompressedChunks> CompressRegions(const std::vector<std::span<u8>>& regions,
+                                                CompressionType type, u32 chunk_size,
+                                                size_t thread_count)
+{
+  const std::vector<std::span<const u8>> const_regions(regions.begin(), regions.end());
+  return Compress(const_regions, type, chunk_size, thread_count);
+}
+
+bool DecompressRegions(std::span<const u8> data, std::span<const u32> sizes, CompressionType type,
+                       u32 chunk_size, const std::vector<std::span<u8>>& regions,
+                       size_t thread_count)
+{
+  return Decompress(data, sizes, type, chunk_size, regions, thread_count);
+}
+}  // namespace State
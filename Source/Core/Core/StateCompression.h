@@ -0,0 +1,49 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/State.h"
+
+namespace State
+{
+// The chunked compression types split the payload into chunks of this many uncompressed bytes
+// and compress every chunk on its own, so saving and loading can use every core.
+constexpr u32 STATE_CHUNK_SIZE = 1024 * 1024;
+
+bool IsChunkedCompression(u16 compression_type);
+size_t GetChunkCount(size_t size, u32 chunk_size);
+
+struct CompressedChunks
+{
+  // Compressed size of every chunk, in order. This is the chunk index written to the header.
+  std::vector<u32> sizes;
+  // The compressed chunks back to back
+  std::vector<u8> data;
+};
+
+// A thread_count of 0 uses one thread per core. Returns nothing if compression failed.
+std::optional<CompressedChunks> CompressChunks(std::span<const u8> data, CompressionType type,
+                                               u32 chunk_size = STATE_CHUNK_SIZE,
+                                               size_t thread_count = 0);
+
+// Decompresses into out, which must already have the uncompressed size
+bool DecompressChunks(std::span<const u8> data, std::span<const u32> sizes, CompressionType type,
+                      u32 chunk_size, std::span<u8> out, size_t thread_count = 0);
+
+// The same for memory regions that are compressed as if they were one buffer, straight from and
+// back into emulated memory. Only chunks that cross from one region to the next are copied.
+std::optional<CompressedChunks> CompressRegions(const std::vector<std::span<u8>>& regions,
+                                                CompressionType type,
+                                                u32 chunk_size = STATE_CHUNK_SIZE,
+                                                size_t thread_count = 0);
+bool DecompressRegions(std::span<const u8> data, std::span<const u32> sizes, CompressionType type,
+                       u32 chunk_size, const std::vector<std::span<u8>>& regions,
+                       size_t thread_count = 0);
+}  // namespace State
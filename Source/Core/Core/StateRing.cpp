@@ -0,0 +1,282 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateRing.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include <xxhash.h>
+
+namespace State
+{
+static size_t GetPageCount(size_t size)
+{
+  return (size + StateRing::PAGE_SIZE - 1) / StateRing::PAGE_SIZE;
+}
+
+static size_t GetPageLength(size_t size, size_t page)
+{
+  return std::min(StateRing::PAGE_SIZE, size - page * StateRing::PAGE_SIZE);
+}
+
+StateRing::StateRing(size_t max_snapshots) : m_max_snapshots(std::max<size_t>(max_snapshots, 1))
+{
+}
+
+std::vector<u64> StateRing::HashPages(std::span<const u8> buffer)
+{
+  std::vector<u64> hashes(GetPageCount(buffer.size()));
+  for (size_t page = 0; page < hashes.size(); ++page)
+  {
+    hashes[page] =
+        XXH3_64bits(buffer.data() + page * PAGE_SIZE, GetPageLength(buffer.size(), page));
+  }
+  return hashes;
+}
+
+void StateRing::CopyFull(FullCopy& copy, u64 frame, const std::vector<std::span<u8>>& buffers)
+{
+  copy.frame = frame;
+  copy.buffers.resize(buffers.size());
+  copy.hashes.resize(buffers.size());
+  for (size_t i = 0; i < buffers.size(); ++i)
+  {
+    copy.buffers[i].assign(buffers[i].begin(), buffers[i].end());
+    copy.hashes[i] = HashPages(buffers[i]);
+  }
+}
+
+bool StateRing::RestoreFullCopy(const FullCopy& copy, const Regions& regions,
+                                std::vector<u8>& state)
+{
+  if (copy.buffers.size() != regions.size() + 1)
+    return false;
+  for (size_t i = 0; i < regions.size(); ++i)
+  {
+    if (copy.buffers[i].size() != regions[i].size())
+      return false;
+  }
+
+  for (size_t i = 0; i < regions.size(); ++i)
+    std::memcpy(regions[i].data(), copy.buffers[i].data(), regions[i].size());
+  state = copy.buffers.back();
+  return true;
+}
+
+void StateRing::Capture(u64 frame, const Regions& regions, const StateFunction& save)
+{
+  save(m_state);
+  std::vector<std::span<u8>> buffers = regions;
+  buffers.emplace_back(m_state);
+
+  // Also starts over after a savestate was loaded that went back in time
+  const std::optional<u64> newest_frame = GetNewestFrame();
+  if (!m_base || m_hashes.size() != buffers.size() || frame <= *newest_frame)
+  {
+    m_deltas.clear();
+    m_base.emplace();
+    CopyFull(*m_base, frame, buffers);
+    m_hashes = m_base->hashes;
+    return;
+  }
+
+  Snapshot snapshot;
+  snapshot.frame = frame;
+  snapshot.buffers.resize(buffers.size());
+  for (size_t i = 0; i < buffers.size(); ++i)
+  {
+    const std::span<const u8> buffer = buffers[i];
+    std::vector<u64>& hashes = m_hashes[i];
+    BufferDelta& delta = snapshot.buffers[i];
+
+    // Pages past the end of the last snapshot's buffer are always changed
+    const size_t old_page_count = hashes.size();
+    hashes.resize(GetPageCount(buffer.size()));
+    delta.size = buffer.size();
+    for (size_t page = 0; page < hashes.size(); ++page)
+    {
+      const size_t length = GetPageLength(buffer.size(), page);
+      const u64 hash = XXH3_64bits(buffer.data() + page * PAGE_SIZE, length);
+      if (page < old_page_count && hash == hashes[page])
+        continue;
+
+      hashes[page] = hash;
+      delta.pages.push_back(static_cast<u32>(page));
+      delta.hashes.push_back(hash);
+      // Every page takes a whole page in data, so a page's data is found by its index in pages
+      delta.data.resize(delta.pages.size() * PAGE_SIZE);
+      std::memcpy(delta.data.data() + (delta.pages.size() - 1) * PAGE_SIZE,
+                  buffer.data() + page * PAGE_SIZE, length);
+    }
+  }
+
+  m_deltas.push_back(std::move(snapshot));
+  while (m_deltas.size() + 1 > m_max_snapshots)
+    FoldOldestDelta();
+}
+
+void StateRing::FoldOldestDelta()
+{
+  const Snapshot& oldest = m_deltas.front();
+  for (size_t i = 0; i < oldest.buffers.size(); ++i)
+  {
+    const BufferDelta& delta = oldest.buffers[i];
+    std::vector<u8>& buffer = m_base->buffers[i];
+    std::vector<u64>& hashes = m_base->hashes[i];
+
+    buffer.resize(delta.size);
+    hashes.resize(GetPageCount(delta.size));
+    for (size_t j = 0; j < delta.pages.size(); ++j)
+    {
+      const u32 page = delta.pages[j];
+      std::memcpy(buffer.data() + page * PAGE_SIZE, delta.data.data() + j * PAGE_SIZE,
+                  GetPageLength(delta.size, page));
+      hashes[page] = delta.hashes[j];
+    }
+  }
+
+  m_base->frame = oldest.frame;
+  m_deltas.pop_front();
+}
+
+std::optional<u64> StateRing::Restore(u64 frame, const Regions& regions,
+                                      const StateFunction& load)
+{
+  if (!m_base || m_base->buffers.size() != regions.size() + 1)
+    return std::nullopt;
+
+  const auto first_newer = std::find_if(m_deltas.begin(), m_deltas.end(),
+                                        [frame](const Snapshot& s) { return s.frame > frame; });
+  const auto get_size = [&](size_t buffer) {
+    if (first_newer == m_deltas.begin())
+      return m_base->buffers[buffer].size();
+    return std::prev(first_newer)->buffers[buffer].size;
+  };
+
+  for (size_t i = 0; i < regions.size(); ++i)
+  {
+    if (regions[i].size() != get_size(i))
+      return std::nullopt;
+  }
+
+  // Later snapshots are from a future that won't happen anymore
+  m_deltas.erase(first_newer, m_deltas.end());
+
+  std::vector<u8> restored;
+  for (size_t i = 0; i < m_base->buffers.size(); ++i)
+  {
+    const size_t size = get_size(i);
+    if (i == regions.size())
+      m_state.resize(size);
+    u8* const out = i < regions.size() ? regions[i].data() : m_state.data();
+
+    std::vector<u64>& hashes = m_hashes[i];
+    hashes.resize(GetPageCount(size));
+    restored.assign(hashes.size(), 0);
+
+    // The newest version of every page, the base has the ones no delta changed
+    for (auto it = m_deltas.rbegin(); it != m_deltas.rend(); ++it)
+    {
+      const BufferDelta& delta = it->buffers[i];
+      for (size_t j = 0; j < delta.pages.size(); ++j)
+      {
+        const u32 page = delta.pages[j];
+        if (page >= restored.size() || restored[page])
+          continue;
+
+        std::memcpy(out + page * PAGE_SIZE, delta.data.data() + j * PAGE_SIZE,
+                    GetPageLength(size, page));
+        hashes[page] = delta.hashes[j];
+        restored[page] = 1;
+      }
+    }
+
+    const std::vector<u8>& base = m_base->buffers[i];
+    for (size_t page = 0; page < restored.size(); ++page)
+    {
+      if (restored[page])
+        continue;
+
+      std::memcpy(out + page * PAGE_SIZE, base.data() + page * PAGE_SIZE,
+                  GetPageLength(size, page));
+      hashes[page] = m_base->hashes[i][page];
+    }
+  }
+
+  load(m_state);
+  return m_deltas.empty() ? m_base->frame : m_deltas.back().frame;
+}
+
+void StateRing::SetRetryPoint(u64 frame, const Regions& regions, const StateFunction& save)
+{
+  save(m_state);
+  std::vector<std::span<u8>> buffers = regions;
+  buffers.emplace_back(m_state);
+
+  if (!m_retry_point)
+    m_retry_point.emplace();
+  CopyFull(*m_retry_point, frame, buffers);
+}
+
+std::optional<u64> StateRing::Retry(const Regions& regions, const StateFunction& load)
+{
+  if (!m_retry_point || !RestoreFullCopy(*m_retry_point, regions, m_state))
+    return std::nullopt;
+
+  load(m_state);
+
+  // The next capture starts the ring again from here
+  m_base.reset();
+  m_deltas.clear();
+  m_hashes.clear();
+  return m_retry_point->frame;
+}
+
+size_t StateRing::GetSnapshotCount() const
+{
+  return m_base ? m_deltas.size() + 1 : 0;
+}
+
+std::optional<u64> StateRing::GetOldestFrame() const
+{
+  if (!m_base)
+    return std::nullopt;
+  return m_base->frame;
+}
+
+std::optional<u64> StateRing::GetNewestFrame() const
+{
+  if (!m_base)
+    return std::nullopt;
+  return m_deltas.empty() ? m_base->frame : m_deltas.back().frame;
+}
+
+size_t StateRing::GetMemoryUsage() const
+{
+  size_t usage = 0;
+  for (const std::optional<FullCopy>* copy : {&m_base, &m_retry_point})
+  {
+    if (!*copy)
+      continue;
+    for (const std::vector<u8>& buffer : (*copy)->buffers)
+      usage += buffer.size();
+  }
+  for (const Snapshot& snapshot : m_deltas)
+  {
+    for (const BufferDelta& delta : snapshot.buffers)
+      usage += delta.data.size();
+  }
+  return usage;
+}
+
+void StateRing::Clear()
+{
+  m_base.reset();
+  m_deltas.clear();
+  m_hashes.clear();
+  m_retry_point.reset();
+}
+}  // namespace State
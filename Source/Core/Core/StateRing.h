@@ -0,0 +1,102 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+// Savestates kept in memory for rewinding and retrying.
+//
+// The emulated memory regions (MEM1, ARAM, ...) are captured page by page instead of through
+// DoState. Only the oldest snapshot holds a full copy, every newer one holds the pages that changed
+// since the snapshot before it, found by comparing page hashes. The rest of the state, which is
+// small, is stored the same way. When the ring is full, the oldest delta is folded into the full
+// copy.
+//
+// A retry point is a separate full copy that stays until the next one is set, so it can be older
+// than everything in the ring.
+class StateRing
+{
+public:
+  static constexpr size_t PAGE_SIZE = 4096;
+
+  using Regions = std::vector<std::span<u8>>;
+  // Saves or loads everything but the regions
+  using StateFunction = std::function<void(std::vector<u8>& state)>;
+
+  explicit StateRing(size_t max_snapshots);
+
+  // Saves first, as saving can write cached data back to the regions
+  void Capture(u64 frame, const Regions& regions, const StateFunction& save);
+  // Restores the newest snapshot from at or before frame, or the oldest one if they are all newer,
+  // and drops the snapshots after it. Returns the frame of the snapshot
+  std::optional<u64> Restore(u64 frame, const Regions& regions, const StateFunction& load);
+
+  // Captures a snapshot that stays until the next call
+  void SetRetryPoint(u64 frame, const Regions& regions, const StateFunction& save);
+  // Restores the retry point and empties the ring. Returns the frame of the retry point
+  std::optional<u64> Retry(const Regions& regions, const StateFunction& load);
+
+  size_t GetSnapshotCount() const;
+  std::optional<u64> GetOldestFrame() const;
+  std::optional<u64> GetNewestFrame() const;
+  // Bytes held by the ring and the retry point
+  size_t GetMemoryUsage() const;
+
+  void Clear();
+
+private:
+  // Changed pages of one buffer, which is a region or the rest of the state
+  struct BufferDelta
+  {
+    size_t size = 0;
+    std::vector<u32> pages;
+    std::vector<u64> hashes;
+    std::vector<u8> data;
+  };
+
+  struct Snapshot
+  {
+    u64 frame = 0;
+    std::vector<BufferDelta> buffers;
+  };
+
+  struct FullCopy
+  {
+    u64 frame = 0;
+    std::vector<std::vector<u8>> buffers;
+    std::vector<std::vector<u64>> hashes;
+  };
+
+  static std::vector<u64> HashPages(std::span<const u8> buffer);
+  // Reuses the buffers copy already has
+  static void CopyFull(FullCopy& copy, u64 frame, const std::vector<std::span<u8>>& buffers);
+  static bool RestoreFullCopy(const FullCopy& copy, const Regions& regions,
+                              std::vector<u8>& state);
+
+  void FoldOldestDelta();
+
+  size_t m_max_snapshots;
+
+  // The oldest snapshot
+  std::optional<FullCopy> m_base;
+  // Every newer snapshot, oldest first
+  std::deque<Snapshot> m_deltas;
+  // Page hashes of the newest snapshot
+  std::vector<std::vector<u64>> m_hashes;
+
+  std::optional<FullCopy> m_retry_point;
+
+  // Reused so saving and loading don't allocate
+  std::vector<u8> m_state;
+};
+}  // namespace State
@@ -0,0 +1,249 @@
+#include "Core/TagSetService.h"
+
+#include <iostream>
+
+#include <picojson.h>
+
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Core/MSB_StatUploader.h"
+
+//Version 1 kept Rio keys in the cache keys
+static constexpr double cCacheVersion = 2;
+
+static s64 getUnixTime()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+TagSetService::TagSetService()
+    : TagSetService(File::GetUserPath(D_CACHE_IDX) + "RioApiCache.json", cRioApiUrl)
+{
+}
+
+TagSetService::TagSetService(std::string cache_path, std::string base_url, FetchFunction fetch,
+                             std::chrono::seconds max_age)
+    : m_cache_path(std::move(cache_path)), m_base_url(std::move(base_url)), m_fetch(std::move(fetch)),
+      m_max_age(max_age)
+{
+    loadCache();
+    m_worker.Reset("Tag Set Service", [this](Request request) { processFetch(std::move(request)); });
+}
+
+TagSetService::~TagSetService()
+{
+    m_worker.Shutdown();
+}
+
+TagSetService& TagSetService::GetInstance()
+{
+    static TagSetService instance;
+    return instance;
+}
+
+std::map<int, Tag::TagSet> TagSetService::getAvailableTagSets(const std::string& rio_key)
+{
+    const Request request = makeTagSetListRequest(rio_key);
+    const std::optional<std::string> body = lookup(request);
+    if (!body)
+        return {};
+
+    std::lock_guard lk(m_lock);
+    auto it = m_responses.find(request.key);
+    if (it == m_responses.end())
+        return Tag::parseAvailableTagSetsResponse(*body);
+    if (!it->second.tag_sets)
+        it->second.tag_sets = Tag::parseAvailableTagSetsResponse(it->second.body);
+    return *it->second.tag_sets;
+}
+
+std::optional<Tag::TagSet> TagSetService::getTagSet(int tag_set_id)
+{
+    const std::optional<std::string> body = lookup(makeRequest("tag_set/" + std::to_string(tag_set_id)));
+    if (!body)
+        return std::nullopt;
+    return Tag::parseTagSetResponse(*body);
+}
+
+bool TagSetService::validateAccount(const std::string& username, const std::string& rio_key, bool allow_cached)
+{
+    //The server answers with an error for unknown accounts, which drops them from the cache.
+    //Only accepted accounts are cached, and used while the server can't be reached
+    return lookup(makeValidationRequest(username, rio_key), allow_cached).has_value();
+}
+
+void TagSetService::prefetchAccount(const std::string& username, const std::string& rio_key)
+{
+    std::lock_guard lk(m_lock);
+    for (const Request& request : {makeValidationRequest(username, rio_key), makeTagSetListRequest(rio_key)}){
+        auto it = m_responses.find(request.key);
+        if (it == m_responses.end() || isStale(it->second))
+            queueFetch(request);
+    }
+}
+
+void TagSetService::waitForIdle()
+{
+    m_worker.WaitForCompletion();
+}
+
+u32 TagSetService::getFetchCount() const
+{
+    std::lock_guard lk(m_lock);
+    return m_fetch_count;
+}
+
+TagSetService::Request TagSetService::makeRequest(const std::string& endpoint, const std::string& payload) const
+{
+    return Request{endpoint + "\n" + payload, m_base_url + endpoint, payload};
+}
+
+std::string TagSetService::makeAccountKey(const std::string& endpoint, const std::string& rio_key)
+{
+    return endpoint + "\n" + Common::BytesToHexString(Common::SHA1::CalculateDigest(rio_key));
+}
+
+TagSetService::Request TagSetService::makeTagSetListRequest(const std::string& rio_key) const
+{
+    Request request = makeRequest("tag_set/list", Tag::availableTagSetsRequest(rio_key));
+    request.key = makeAccountKey("tag_set/list", rio_key);
+    return request;
+}
+
+TagSetService::Request TagSetService::makeValidationRequest(const std::string& username, const std::string& rio_key) const
+{
+    Request request = makeRequest("validate_user_from_client/?username=" + username + "&rio_key=" + rio_key);
+    request.key = makeAccountKey("validate_user_from_client/?username=" + username, rio_key);
+    return request;
+}
+
+std::optional<std::string> TagSetService::lookup(const Request& request, bool allow_cached)
+{
+    std::unique_lock lk(m_lock);
+    auto it = m_responses.find(request.key);
+    if (allow_cached && it != m_responses.end()){
+        if (isStale(it->second))
+            queueFetch(request);
+        return it->second.body;
+    }
+
+    //Nothing usable yet. Wait for the fetch, joining the one in flight if there is one
+    const u32 attempts = m_attempts[request.key];
+    queueFetch(request);
+    m_fetch_done.wait(lk, [&] { return m_attempts[request.key] != attempts; });
+
+    //Still there after a failed fetch if the server couldn't be reached, gone if it refused
+    it = m_responses.find(request.key);
+    if (it == m_responses.end())
+        return std::nullopt;
+    return it->second.body;
+}
+
+void TagSetService::queueFetch(const Request& request)
+{
+    if (m_in_flight.insert(request.key).second)
+        m_worker.Push(request);
+}
+
+bool TagSetService::isStale(const CachedResponse& response) const
+{
+    return getUnixTime() - response.fetched_time >= m_max_age.count();
+}
+
+void TagSetService::processFetch(Request request)
+{
+    FetchResult result = fetch(request.url, request.payload);
+    const bool succeeded = result.body.has_value();
+    if (!succeeded)
+        std::cout << "TagSetService: " << request.key.substr(0, request.key.find('\n'))
+                  << (result.rejected ? " was refused\n" : " failed\n");
+
+    bool dropped = false;
+    {
+        std::lock_guard lk(m_lock);
+        m_in_flight.erase(request.key);
+        ++m_fetch_count;
+        ++m_attempts[request.key];
+
+        //A refresh that didn't reach the server keeps whatever we had, a refused one drops it
+        if (succeeded)
+            m_responses[request.key] = CachedResponse{std::move(*result.body), getUnixTime(), std::nullopt};
+        else if (result.rejected)
+            dropped = m_responses.erase(request.key) != 0;
+    }
+    m_fetch_done.notify_all();
+
+    if (succeeded || dropped)
+        saveCache();
+}
+
+TagSetService::FetchResult TagSetService::fetch(const std::string& url, const std::string& payload)
+{
+    if (m_fetch)
+        return m_fetch(url, payload);
+
+    constexpr auto codes = Common::HttpRequest::AllowedReturnCodes::All;
+    const Common::HttpRequest::Response response =
+        payload.empty() ? m_http.Get(url, {}, codes) :
+                          m_http.Post(url, payload, {{"Content-Type", "application/json"}}, codes);
+    if (!response)
+        return {};
+
+    //Server errors say nothing about the request, only client errors are refusals
+    const s32 code = m_http.GetLastResponseCode();
+    if (code >= 200 && code < 300)
+        return FetchResult{std::string(response->begin(), response->end()), false};
+    return FetchResult{std::nullopt, code >= 400 && code < 500};
+}
+
+void TagSetService::loadCache()
+{
+    std::string contents;
+    if (!File::ReadFileToString(m_cache_path, contents))
+        return;
+
+    picojson::value json;
+    if (!picojson::parse(json, contents).empty() || !json.is<picojson::object>() || !json.get("Version").is<double>() ||
+        json.get("Version").get<double>() != cCacheVersion || !json.get("Responses").is<picojson::object>()){
+        //Older caches can hold Rio keys, don't leave them around
+        std::cout << "TagSetService: Removing outdated cache " << m_cache_path << "\n";
+        File::Delete(m_cache_path);
+        return;
+    }
+
+    for (const auto& [key, entry] : json.get("Responses").get<picojson::object>()){
+        if (!entry.is<picojson::object>() || !entry.get("Body").is<std::string>() || !entry.get("Fetched").is<double>())
+            continue;
+        m_responses[key] = CachedResponse{entry.get("Body").get<std::string>(),
+                                          static_cast<s64>(entry.get("Fetched").get<double>()), std::nullopt};
+    }
+}
+
+void TagSetService::saveCache()
+{
+    picojson::object responses;
+    {
+        std::lock_guard lk(m_lock);
+        for (const auto& [key, response] : m_responses){
+            picojson::object entry;
+            entry["Body"] = picojson::value(response.body);
+            entry["Fetched"] = picojson::value(static_cast<double>(response.fetched_time));
+            responses[key] = picojson::value(std::move(entry));
+        }
+    }
+
+    picojson::object root;
+    root["Version"] = picojson::value(cCacheVersion);
+    root["Responses"] = picojson::value(std::move(responses));
+    const std::string contents = picojson::value(std::move(root)).serialize();
+
+    //Write then rename so a crash mid-write never leaves a truncated cache behind
+    File::CreateFullPath(m_cache_path);
+    const std::string temp_path = File::GetTempFilenameForAtomicWrite(m_cache_path);
+    if (!File::WriteStringToFile(temp_path, contents) || !File::Rename(temp_path, m_cache_path)){
+        std::cout << "TagSetService: Could not write " << m_cache_path << "\n";
+        File::Delete(temp_path);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/HttpRequest.h"
+#include "Common/TagSet.h"
+#include "Common/WorkQueueThread.h"
+
+// Cached access to the tag set and account endpoints of the Rio API.
+// Every successful response is kept in memory and in a versioned cache file. Lookups return the
+// cached response right away and, once it is older than the max age, refresh it in the background
+// (stale while revalidate). Only a request that has never succeeded waits for the network, and
+// then only for the one fetch that is already in flight for it. Refreshes that can't reach the
+// server keep the stale response, so lobbies and local games can still be set up offline. A
+// request the server refuses drops it. Rio keys are only kept as hashes in the cache.
+class TagSetService{
+public:
+    struct FetchResult{
+        //Response body of an accepted request
+        std::optional<std::string> body;
+        //The server answered and refused the request. Neither this nor a body means the server
+        //could not be reached
+        bool rejected = false;
+    };
+
+    //payload is empty for a GET. Tests swap this for a local stand-in
+    using FetchFunction = std::function<FetchResult(const std::string& url, const std::string& payload)>;
+
+    TagSetService();
+    TagSetService(std::string cache_path, std::string base_url, FetchFunction fetch = nullptr,
+                  std::chrono::seconds max_age = std::chrono::minutes(10));
+    ~TagSetService();
+
+    TagSetService(const TagSetService&) = delete;
+    TagSetService& operator=(const TagSetService&) = delete;
+
+    //Shared by the UI, NetPlay and the stat tracker
+    static TagSetService& GetInstance();
+
+    //Tag sets rio_key can use
+    std::map<int, Tag::TagSet> getAvailableTagSets(const std::string& rio_key);
+    std::optional<Tag::TagSet> getTagSet(int tag_set_id);
+    //Without allow_cached the account is checked with the server, for newly entered accounts. The
+    //cached answer is only used if the server can't be reached
+    bool validateAccount(const std::string& username, const std::string& rio_key, bool allow_cached = true);
+
+    //Starts validating the account and fetching its tag sets in the background, so later
+    //lookups find them cached
+    void prefetchAccount(const std::string& username, const std::string& rio_key);
+
+    //Blocks until every queued fetch is done
+    void waitForIdle();
+
+    u32 getFetchCount() const;
+
+private:
+    struct Request{
+        std::string key;
+        std::string url;
+        std::string payload;
+    };
+
+    //Cache key of a request made for the account of rio_key, which never holds the key itself
+    static std::string makeAccountKey(const std::string& endpoint, const std::string& rio_key);
+
+    struct CachedResponse{
+        std::string body;
+        s64 fetched_time = 0;
+        //Parsed on first use, so a tag set list is only parsed again after a refresh
+        std::optional<std::map<int, Tag::TagSet>> tag_sets;
+    };
+
+    Request makeRequest(const std::string& endpoint, const std::string& payload = {}) const;
+    Request makeTagSetListRequest(const std::string& rio_key) const;
+    Request makeValidationRequest(const std::string& username, const std::string& rio_key) const;
+    //Cached body, waiting for the fetch if there is none yet
+    std::optional<std::string> lookup(const Request& request, bool allow_cached = true);
+    //Queues a fetch unless one is in flight. Call with m_lock held
+    void queueFetch(const Request& request);
+    bool isStale(const CachedResponse& response) const;
+    void processFetch(Request request);
+    FetchResult fetch(const std::string& url, const std::string& payload);
+
+    void loadCache();
+    void saveCache();
+
+    std::string m_cache_path;
+    std::string m_base_url;
+    FetchFunction m_fetch;
+    std::chrono::seconds m_max_age;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_fetch_done;
+    std::map<std::string, CachedResponse> m_responses;
+    std::set<std::string> m_in_flight;
+    //Bumped every time a fetch for the key finishes
+    std::map<std::string, u32> m_attempts;
+    u32 m_fetch_count = 0;
+
+    //Only touched from the worker thread
+    Common::HttpRequest m_http{std::chrono::seconds{30}};
+
+    //Declared last so the worker is joined before the members it uses are destroyed
+    Common::WorkQueueThread<Request> m_worker;
+};
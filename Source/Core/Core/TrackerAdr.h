@@ -3,31 +3,49 @@
 #include <type_traits>
 #include <optional>
 #include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Common/CommonTypes.h"
 
 //For Mem Access
 // #include "Core/HW/Memmap.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/TrackerSnapshot.h"
+
+//Identifies a tracked value in the descriptor table. The values are listed with the table
+enum class TrackerFieldId : u8;
+
+//Everything about a tracked value that never changes. Kept out of the value itself so events
+//stay plain data and copy with a memcpy
+struct TrackerField {
+    TrackerFieldId id;
+    std::string_view name;
+    u32 adr;
+    u32 default_value;
+};
+
+//Looks up the descriptor of a field. Defined next to the table
+const TrackerField& getTrackerField(TrackerFieldId id);
 
 template <typename T>
 class TrackerValue {
 public:
-    TrackerValue() {};
-    TrackerValue(std::string in_name, T in_default_value)
-    {
-        name = in_name;
-        default_value = in_default_value;
-    };
-    
-    std::string name;
+    constexpr TrackerValue() = default;
+    constexpr explicit TrackerValue(TrackerFieldId in_field) : field(in_field) {}
+
     std::optional<T> value;
     std::optional<T> prev_value;
+    TrackerFieldId field{};
 
-    T default_value;
+    std::string_view name() const { return getTrackerField(field).name; }
+    T default_value() const { return static_cast<T>(getTrackerField(field).default_value); }
 
-    T get_value(){
+    T get_value() const {
         if (value.has_value()) { return value.value(); }
-        return default_value;
+        return default_value();
     }
 
     void set_value(T new_value){
@@ -39,42 +57,45 @@ public:
         value=prev_value;
     }
 
-    std::pair<std::string, std::string> get_key_value_string(){
-        return std::make_pair(name, std::to_string(get_value()));
+    std::pair<std::string, std::string> get_key_value_string() const {
+        return std::make_pair(std::string(name()), std::to_string(get_value()));
     }
 
-    void write(std::ostream stream, std::string sep=" "){
-        stream << name << sep << std::to_string(get_value());
+    void write(std::ostream& stream, std::string_view sep=" ") const {
+        stream << name() << sep << std::to_string(get_value());
     }
 };
 
 template <typename T>
 class TrackerAdr : public TrackerValue<T>{
 public:
-    TrackerAdr() {};
-    TrackerAdr(std::string in_name, u32 in_adr, T in_default_value) :
-        TrackerValue<T>(in_name, in_default_value),
-        adr(in_adr)
-    {
-        static_assert((std::is_same<T, u8>::value || std::is_same<T, u16>::value || std::is_same<T, u32>::value), "TrackerAdr type is not valid. Must be u8, u16, or u32");
-    }
+    static_assert((std::is_same<T, u8>::value || std::is_same<T, u16>::value || std::is_same<T, u32>::value), "TrackerAdr type is not valid. Must be u8, u16, or u32");
 
-    u32 adr;
+    constexpr TrackerAdr() = default;
+    constexpr explicit TrackerAdr(TrackerFieldId in_field) : TrackerValue<T>(in_field) {}
+
+    u32 adr() const { return getTrackerField(this->field).adr; }
 
     T read_value(const Core::CPUThreadGuard& guard) {
         T mem_val;
         if constexpr(std::is_same<T, u8>::value){
-            mem_val = PowerPC::MMU::HostRead_U8(guard, adr);
+            mem_val = PowerPC::MMU::HostRead_U8(guard, adr());
         }
         else if constexpr(std::is_same<T, u16>::value){
-            mem_val = PowerPC::MMU::HostRead_U16(guard, adr);
+            mem_val = PowerPC::MMU::HostRead_U16(guard, adr());
         }
         else if constexpr(std::is_same<T, u32>::value){
-            mem_val = PowerPC::MMU::HostRead_U32(guard, adr);
+            mem_val = PowerPC::MMU::HostRead_U32(guard, adr());
         }
         TrackerValue<T>::set_value(mem_val);
         return mem_val;
     }
+
+    T read_value(const Core::CPUThreadGuard& guard, TrackerSnapshot& snapshot) {
+        T mem_val = snapshot.read<T>(guard, adr());
+        TrackerValue<T>::set_value(mem_val);
+        return mem_val;
+    }
 };
 
 //ostream& operator<<(ostream& os, const TrackerValue<T>& dt)
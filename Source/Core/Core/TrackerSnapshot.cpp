@@ -0,0 +1,71 @@
+#include "Core/TrackerSnapshot.h"
+
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+void TrackerSnapshot::addRegion(u32 start, u32 end)
+{
+    Region region;
+    region.start = start;
+    region.end = end;
+    region.data.resize(end - start);
+    m_regions.push_back(std::move(region));
+}
+
+void TrackerSnapshot::invalidate()
+{
+    for (Region& region : m_regions)
+        region.state = RegionState::Stale;
+}
+
+void TrackerSnapshot::captureAll(const Core::CPUThreadGuard& guard)
+{
+    for (Region& region : m_regions){
+        if (region.state == RegionState::Stale)
+            capture(guard, region);
+
+        if (region.state == RegionState::Unavailable){
+            //Region sizes are word aligned
+            for (u32 adr = region.start; adr < region.end; adr += sizeof(u32)){
+                const u32 value = Common::swap32(PowerPC::MMU::HostRead_U32(guard, adr));
+                std::memcpy(&region.data[adr - region.start], &value, sizeof(u32));
+            }
+        }
+    }
+}
+
+void TrackerSnapshot::capture(const Core::CPUThreadGuard& guard, Region& region)
+{
+    region.state = RegionState::Unavailable;
+
+    auto& system = guard.GetSystem();
+    auto& ppc_state = system.GetPPCState();
+
+    //With the data cache emulated the cache may hold newer values than RAM
+    if (ppc_state.m_enable_dcache)
+        return;
+
+    const u32 size = region.end - region.start;
+    u32 physical_start = region.start;
+    if (ppc_state.msr.DR){
+        //Translate once per region. Only take the fast path if the range is mapped contiguously
+        auto& mmu = system.GetMMU();
+        const std::optional<u32> first = mmu.GetTranslatedAddress(region.start);
+        const std::optional<u32> last = mmu.GetTranslatedAddress(region.end - 1);
+        if (!first || !last || *last - *first != size - 1)
+            return;
+        physical_start = *first;
+    }
+
+    auto& memory = system.GetMemory();
+    if (!memory.GetRAM() || physical_start >= memory.GetRamSizeReal() ||
+        size > memory.GetRamSizeReal() - physical_start){
+        return;
+    }
+
+    std::memcpy(region.data.data(), memory.GetRAM() + physical_start, size);
+    region.state = RegionState::Captured;
+    ++m_capture_count;
+}
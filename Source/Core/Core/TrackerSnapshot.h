@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+
+//For Mem Access
+#include "Core/PowerPC/MMU.h"
+
+// Per-frame copy of the guest memory the StatTracker reads.
+// The tracker registers the contiguous ranges it cares about once. The first read that lands in
+// a range during a frame copies the whole range with a single translated memcpy, every later read
+// that frame is served from the copy and byte-swapped on the way out. Reads outside of every
+// registered range (or from a range that can't be copied directly) fall back to HostRead.
+class TrackerSnapshot {
+public:
+    //Register [start, end) as a region to snapshot
+    void addRegion(u32 start, u32 end);
+
+    //Mark every region stale. Call once per frame before reading
+    void invalidate();
+
+    //When disabled every read goes through HostRead (used to compare against the old path)
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    //Number of region copies made since creation
+    u64 getCaptureCount() const { return m_capture_count; }
+
+    size_t getNumRegions() const { return m_regions.size(); }
+    u32 getRegionStart(size_t index) const { return m_regions[index].start; }
+    u32 getRegionEnd(size_t index) const { return m_regions[index].end; }
+
+    //Fill every region for this frame, whether the tracker reads it or not. Regions that can't be
+    //copied directly are read through HostRead. Used to record a trace
+    void captureAll(const Core::CPUThreadGuard& guard);
+    const std::vector<u8>& getRegionData(size_t index) const { return m_regions[index].data; }
+
+    //When replaying a trace there is no guest memory. Every read is served from the region data,
+    //which the replay writes through getReplayData, and reads outside every region return 0
+    void setReplaying(bool replaying) { m_replaying = replaying; }
+    bool isReplaying() const { return m_replaying; }
+    u8* getReplayData(size_t index) { return m_regions[index].data.data(); }
+
+    //Reads that fell outside every region while replaying
+    u64 getMissedReadCount() const { return m_missed_read_count; }
+
+    template <typename T>
+    T read(const Core::CPUThreadGuard& guard, u32 adr){
+        static_assert((std::is_same<T, u8>::value || std::is_same<T, u16>::value || std::is_same<T, u32>::value), "TrackerSnapshot type is not valid. Must be u8, u16, or u32");
+
+        if (m_enabled || m_replaying){
+            for (Region& region : m_regions){
+                if (adr < region.start || adr + sizeof(T) > region.end)
+                    continue;
+
+                if (region.state == RegionState::Stale && !m_replaying)
+                    capture(guard, region);
+
+                if (region.state == RegionState::Captured || m_replaying){
+                    T mem_val;
+                    std::memcpy(&mem_val, &region.data[adr - region.start], sizeof(T));
+                    return Common::FromBigEndian(mem_val);
+                }
+                break;
+            }
+        }
+
+        if (m_replaying){
+            ++m_missed_read_count;
+            return 0;
+        }
+
+        if constexpr(std::is_same<T, u8>::value){
+            return PowerPC::MMU::HostRead_U8(guard, adr);
+        }
+        else if constexpr(std::is_same<T, u16>::value){
+            return PowerPC::MMU::HostRead_U16(guard, adr);
+        }
+        else{
+            return PowerPC::MMU::HostRead_U32(guard, adr);
+        }
+    }
+
+private:
+    enum class RegionState{
+        Stale,
+        Captured,
+        Unavailable //Not plain MEM1 under the current translation, read through HostRead instead
+    };
+
+    struct Region{
+        u32 start;
+        u32 end;
+        RegionState state = RegionState::Stale;
+        std::vector<u8> data;
+    };
+
+    void capture(const Core::CPUThreadGuard& guard, Region& region);
+
+    std::vector<Region> m_regions;
+    bool m_enabled = true;
+    bool m_replaying = false;
+    u64 m_capture_count = 0;
+    u64 m_missed_read_count = 0;
+};
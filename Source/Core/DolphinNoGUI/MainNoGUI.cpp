@@ -2,11 +2,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "DolphinNoGUI/Platform.h"
+#include "DolphinNoGUI/ReplayBatch.h"
 
 #include <OptionParser.h>
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <optional>
 #include <signal.h>
 #include <string>
 #include <vector>
@@ -17,6 +20,8 @@
 #include <Windows.h>
 #endif
 
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
@@ -24,6 +29,8 @@
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
+#include "Core/System.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -179,6 +186,84 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+// Keeps the stat and HUD files of this process apart from the ones of the user directory and of
+// other processes replaying at the same time. Nothing goes to the outbox, so nothing is uploaded
+// again. The HUD stream port is turned off in the replay arguments for the same reason.
+static void SetStatOutputDirectory(const std::string& directory)
+{
+  File::SetUserPath(D_MSSBFILES_IDX, directory);
+  const std::string& stat_dir = File::GetUserPath(D_MSSBFILES_IDX);
+  File::SetUserPath(D_STATOUTBOX_IDX, stat_dir + STATOUTBOX_DIR DIR_SEP);
+  File::SetUserPath(D_STATJOURNAL_IDX, stat_dir + STATJOURNAL_DIR DIR_SEP);
+  File::SetUserPath(D_STATTRACES_IDX, stat_dir + STATTRACES_DIR DIR_SEP);
+  File::SetUserPath(D_STATARCHIVE_IDX, stat_dir + STATARCHIVE_DIR DIR_SEP);
+  File::SetUserPath(D_HUDFILES_IDX, stat_dir + HUDFILES_DIR DIR_SEP);
+}
+
+static int RunReplayBatch(const optparse::Values& options, const std::vector<std::string>& args)
+{
+  ReplayBatch::Options batch;
+  if (options.is_set("replay"))
+  {
+    for (const std::string& movie : options.all("replay"))
+      batch.movies.push_back(movie);
+  }
+  if (options.is_set("replay_list"))
+  {
+    const std::string list_path = static_cast<const char*>(options.get("replay_list"));
+    const std::vector<std::string> movies = ReplayBatch::ReadMovieList(list_path);
+    if (movies.empty())
+    {
+      fprintf(stderr, "No movies found in %s\n", list_path.c_str());
+      return 1;
+    }
+    batch.movies.insert(batch.movies.end(), movies.begin(), movies.end());
+  }
+  batch.jobs = static_cast<size_t>(std::max(0, static_cast<int>(options.get("jobs"))));
+
+  if (options.is_set("exec"))
+  {
+    for (const std::string& path : options.all("exec"))
+      batch.replay_args.insert(batch.replay_args.end(), {"--exec", path});
+  }
+  else if (!args.empty())
+  {
+    batch.replay_args.insert(batch.replay_args.end(), {"--exec", args.front()});
+  }
+  else
+  {
+    fprintf(stderr, "Replaying movies needs the game they were recorded with.\n");
+    return 1;
+  }
+
+  std::string user_directory;
+  if (options.is_set("user"))
+  {
+    user_directory = static_cast<const char*>(options.get("user"));
+    batch.replay_args.insert(batch.replay_args.end(), {"--user", user_directory});
+  }
+  if (options.is_set_by_user("config"))
+  {
+    for (const std::string& config : options.all("config"))
+      batch.replay_args.insert(batch.replay_args.end(), {"--config", config});
+  }
+  // Later settings win, so these can't be turned off by the ones above
+  batch.replay_args.insert(batch.replay_args.end(),
+                           {"--platform", "headless", "--video_backend", "Null", "--config",
+                            "Dolphin.DSP.Backend=No Audio Output", "--config",
+                            "Dolphin.Core.EmulationSpeed=0", "--config",
+                            "Dolphin.Movie.PauseMovie=True", "--config",
+                            "Dolphin.StatTracker.HudStreamPort=0"});
+
+  UICommon::SetUserDirectory(user_directory);
+  if (options.is_set("stat_output"))
+    batch.output_dir = static_cast<const char*>(options.get("stat_output"));
+  else
+    batch.output_dir = File::GetUserPath(D_MSSBFILES_IDX);
+
+  return ReplayBatch::Run(batch);
+}
+
 #ifdef _WIN32
 #define main app_main
 #endif
@@ -210,10 +295,33 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("--replay")
+      .action("append")
+      .metavar("<file>")
+      .type("string")
+      .help("Replay a movie headless to write its stat files again, can be given more than once");
+  parser->add_option("--replay-list")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Replay the movies listed in a file, one per line");
+  parser->add_option("-j", "--jobs")
+      .action("store")
+      .type("int")
+      .set_default(0)
+      .help("Movies to replay at once, one per core if not given");
+  parser->add_option("--stat-output")
+      .action("store")
+      .metavar("<directory>")
+      .type("string")
+      .help("Directory to write stat files to");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
 
+  if (options.is_set("replay") || options.is_set("replay_list"))
+    return RunReplayBatch(options, args);
+
   std::optional<std::string> save_state_path;
   if (options.is_set("save_state"))
   {
@@ -284,6 +392,30 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  if (options.is_set("stat_output"))
+    SetStatOutputDirectory(static_cast<const char*>(options.get("stat_output")));
+
+  if (options.is_set("movie"))
+  {
+    if (!game_specified)
+    {
+      fprintf(stderr, "A movie cannot be played without specifying a game to launch.\n");
+      return 1;
+    }
+
+    auto& movie = Core::System::GetInstance().GetMovie();
+    movie.SetReadOnly(true);
+    std::optional<std::string> movie_save_state_path;
+    if (!movie.PlayInput(static_cast<const char*>(options.get("movie")), &movie_save_state_path))
+    {
+      fprintf(stderr, "Could not play the specified movie\n");
+      return 1;
+    }
+    boot->boot_session_data.SetSavestateData(std::move(movie_save_state_path),
+                                             DeleteSavestateAfterBoot::No);
+    s_platform->StopAtMovieEnd();
+  }
+
   Core::AddOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
@@ -318,9 +450,12 @@ int main(int argc, char* argv[])
   Core::Stop();
 
   Core::Shutdown();
+
+  // A movie that didn't play to the end, like when the game failed to boot, didn't replay
+  const bool failed = options.is_set("movie") && !s_platform->ReachedMovieEnd();
   s_platform.reset();
 
-  return 0;
+  return failed ? 1 : 0;
 }
 
 #ifdef _WIN32
@@ -5,6 +5,7 @@
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/STM/STM.h"
+#include "Core/Movie.h"
 #include "Core/State.h"
 #include "Core/System.h"
 
@@ -21,6 +22,12 @@ void Platform::SetTitle(const std::string& title)
 
 void Platform::UpdateRunningFlag()
 {
+  if (m_stop_at_movie_end && !Core::System::GetInstance().GetMovie().IsMovieActive())
+  {
+    m_reached_movie_end.Set();
+    m_running.Clear();
+  }
+
   if (m_shutdown_requested.TestAndClear())
   {
     const auto ios = IOS::HLE::GetIOS();
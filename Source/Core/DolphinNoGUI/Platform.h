@@ -30,6 +30,10 @@ public:
   // Request an immediate shutdown.
   void Stop();
 
+  // Shuts down once the movie being played ends, for replaying movies without anyone watching.
+  void StopAtMovieEnd() { m_stop_at_movie_end = true; }
+  bool ReachedMovieEnd() const { return m_reached_movie_end.IsSet(); }
+
   static std::unique_ptr<Platform> CreateHeadlessPlatform();
 #ifdef HAVE_X11
   static std::unique_ptr<Platform> CreateX11Platform();
@@ -53,6 +57,8 @@ protected:
   Common::Flag m_running{true};
   Common::Flag m_shutdown_requested{false};
   Common::Flag m_tried_graceful_shutdown{false};
+  Common::Flag m_reached_movie_end{false};
+  bool m_stop_at_movie_end = false;
 
   bool m_window_focus = true;  // Should be made atomic if actually implemented
   bool m_window_fullscreen = false;
@@ -0,0 +1,252 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/ReplayBatch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char** environ;
+#endif
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+
+namespace ReplayBatch
+{
+// Where a replay writes its stat files and its output, kept if the replay fails
+static std::string GetReplayDir(const std::string& output_dir, size_t index)
+{
+  return fmt::format("{}replay{}/", output_dir, index);
+}
+
+std::vector<std::string> ReadMovieList(const std::string& path)
+{
+  std::string contents;
+  if (!File::ReadFileToString(path, contents))
+    return {};
+
+  std::vector<std::string> movies;
+  std::istringstream stream(contents);
+  for (std::string line; std::getline(stream, line);)
+  {
+    const std::string_view movie = StripWhitespace(line);
+    if (!movie.empty() && movie.front() != '#')
+      movies.emplace_back(movie);
+  }
+  return movies;
+}
+
+#ifdef _WIN32
+// The quoting CommandLineToArgvW undoes
+static std::string QuoteArgument(const std::string& arg)
+{
+  std::string quoted = "\"";
+  size_t backslashes = 0;
+  for (const char c : arg)
+  {
+    if (c == '\\')
+    {
+      ++backslashes;
+      continue;
+    }
+    quoted.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+    quoted.push_back(c);
+    backslashes = 0;
+  }
+  quoted.append(backslashes * 2, '\\');
+  quoted.push_back('"');
+  return quoted;
+}
+#endif
+
+// Runs args[0] with stdout and stderr going to log_path and waits for it. Returns the exit code,
+// or nothing if it couldn't be started or didn't exit by itself.
+static std::optional<int> RunProcess(const std::vector<std::string>& args,
+                                     const std::string& log_path)
+{
+#ifdef _WIN32
+  std::string command_line;
+  for (const std::string& arg : args)
+  {
+    if (!command_line.empty())
+      command_line.push_back(' ');
+    command_line += QuoteArgument(arg);
+  }
+
+  SECURITY_ATTRIBUTES attributes{.nLength = sizeof(attributes), .bInheritHandle = TRUE};
+  const HANDLE log = CreateFileW(UTF8ToWString(log_path).c_str(), GENERIC_WRITE, FILE_SHARE_READ,
+                                 &attributes, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (log == INVALID_HANDLE_VALUE)
+    return std::nullopt;
+
+  STARTUPINFOW startup_info{.cb = sizeof(startup_info)};
+  startup_info.dwFlags = STARTF_USESTDHANDLES;
+  startup_info.hStdOutput = log;
+  startup_info.hStdError = log;
+  PROCESS_INFORMATION process_info;
+  const bool started =
+      CreateProcessW(UTF8ToWString(args[0]).c_str(), UTF8ToWString(command_line).data(), nullptr,
+                     nullptr, TRUE, CREATE_NO_WINDOW, nullptr, nullptr, &startup_info,
+                     &process_info);
+  CloseHandle(log);
+  if (!started)
+    return std::nullopt;
+
+  CloseHandle(process_info.hThread);
+  WaitForSingleObject(process_info.hProcess, INFINITE);
+  DWORD exit_code;
+  const bool exited = GetExitCodeProcess(process_info.hProcess, &exit_code);
+  CloseHandle(process_info.hProcess);
+  if (!exited)
+    return std::nullopt;
+  return static_cast<int>(exit_code);
+#else
+  std::vector<char*> argv;
+  for (const std::string& arg : args)
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  argv.push_back(nullptr);
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log_path.c_str(),
+                                   O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+  pid_t pid;
+  const int error = posix_spawn(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+  posix_spawn_file_actions_destroy(&actions);
+  if (error != 0)
+    return std::nullopt;
+
+  int status;
+  while (waitpid(pid, &status, 0) < 0)
+  {
+    if (errno != EINTR)
+      return std::nullopt;
+  }
+  if (!WIFEXITED(status))
+    return std::nullopt;
+  return WEXITSTATUS(status);
+#endif
+}
+
+// Moves the stat files of a replay to the output directory, returns how many games they are for.
+// Names only hold the players, the game id and the time, which other movies can share, so they
+// get the index of the movie in front
+static size_t CollectStatFiles(const std::string& replay_dir, const std::string& output_dir,
+                               size_t index)
+{
+  size_t games = 0;
+  for (const std::string& path : Common::DoFileSearch({replay_dir}, {".json"}))
+  {
+    const std::string file_name = PathToFileName(path);
+    // Every finished game has a decoded file, quit games have "quit." ones instead
+    if (file_name.starts_with("decoded."))
+      ++games;
+    File::Rename(path, fmt::format("{}replay{}.{}", output_dir, index, file_name));
+  }
+  return games;
+}
+
+int Run(const Options& options)
+{
+  if (options.movies.empty())
+  {
+    fprintf(stderr, "No movies to replay.\n");
+    return 1;
+  }
+
+  std::string output_dir = options.output_dir;
+  if (!output_dir.ends_with('/'))
+    output_dir.push_back('/');
+  if (!File::CreateFullPath(output_dir))
+  {
+    fprintf(stderr, "Could not create %s\n", output_dir.c_str());
+    return 1;
+  }
+
+  size_t jobs = options.jobs;
+  if (jobs == 0)
+    jobs = std::max(1u, std::thread::hardware_concurrency());
+  jobs = std::min(jobs, options.movies.size());
+
+  const std::string exe_path = File::GetExePath();
+  const auto start = std::chrono::steady_clock::now();
+
+  std::mutex output_lock;
+  std::atomic<size_t> next_movie = 0;
+  size_t finished = 0;
+  size_t total_games = 0;
+
+  const auto run = [&] {
+    for (size_t i = next_movie++; i < options.movies.size(); i = next_movie++)
+    {
+      const std::string& movie = options.movies[i];
+      const std::string replay_dir = GetReplayDir(output_dir, i);
+      File::DeleteDirRecursively(replay_dir);
+      File::CreateFullPath(replay_dir);
+
+      std::vector<std::string> args{exe_path, "--movie", movie, "--stat-output", replay_dir};
+      args.insert(args.end(), options.replay_args.begin(), options.replay_args.end());
+
+      const auto replay_start = std::chrono::steady_clock::now();
+      const std::optional<int> exit_code = RunProcess(args, replay_dir + "replay.log");
+      const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - replay_start;
+      const size_t games = CollectStatFiles(replay_dir, output_dir, i);
+      const bool success = exit_code == 0;
+      if (success)
+        File::DeleteDirRecursively(replay_dir);
+
+      std::lock_guard lk(output_lock);
+      total_games += games;
+      if (success)
+      {
+        ++finished;
+        fmt::print("[{}/{}] {}: {} games in {:.0f} s\n", i + 1, options.movies.size(), movie,
+                   games, seconds.count());
+      }
+      else
+      {
+        fmt::print("[{}/{}] {}: failed ({}), see {}replay.log\n", i + 1, options.movies.size(),
+                   movie, exit_code ? fmt::format("exit code {}", *exit_code) : "did not exit",
+                   replay_dir);
+      }
+      fflush(stdout);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < jobs; ++i)
+    threads.emplace_back(run);
+  run();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  const std::chrono::duration<double, std::ratio<3600>> hours =
+      std::chrono::steady_clock::now() - start;
+  fmt::print("{} of {} replays finished with {} jobs, {} games in {:.1f} minutes ({:.1f} games "
+             "per hour)\n",
+             finished, options.movies.size(), jobs, total_games, hours.count() * 60,
+             hours.count() > 0 ? total_games / hours.count() : 0.0);
+
+  return finished == options.movies.size() ? 0 : 1;
+}
+}  // namespace ReplayBatch
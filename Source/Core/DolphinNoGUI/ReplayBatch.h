@@ -0,0 +1,33 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Replays a batch of movies to get their stats again, for when the stat files change.
+//
+// Dolphin emulates one game per process, so every movie is replayed by its own DolphinNoGUI
+// process with --movie, headless, without audio and as fast as it goes. Each of them writes to a
+// directory of its own, the stat files are moved to the output directory once it is done. Their
+// names start with "replay<index>." after the position of the movie in the batch.
+namespace ReplayBatch
+{
+struct Options
+{
+  std::vector<std::string> movies;
+  // Passed to every replay, like the game to boot and the user directory
+  std::vector<std::string> replay_args;
+  std::string output_dir;
+  // 0 runs one replay per core
+  size_t jobs = 0;
+};
+
+// One path per line, blank lines and lines starting with # are skipped
+std::vector<std::string> ReadMovieList(const std::string& path);
+
+// Returns the exit code for DolphinNoGUI, which is an error if any replay failed
+int Run(const Options& options);
+}  // namespace ReplayBatch
@@ -140,7 +140,7 @@ bool AddLocalPlayersEditor::AcceptPlayer()
     return false;
   }
 
-  LocalPlayers::LocalPlayers::AccountValidationType type = m_local_player->ValidateAccount(m_http);
+  LocalPlayers::LocalPlayers::AccountValidationType type = m_local_player->ValidateAccount(false);
   if (type == LocalPlayers::LocalPlayers::Invalid)
   {
     ModalMessageBox::critical(this, tr("Error"), tr("Username and Rio Key could not be validated. Verify that you are entering\n"
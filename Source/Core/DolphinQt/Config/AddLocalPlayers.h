@@ -6,8 +6,6 @@
 #include <QDialog>
 #include "Core/LocalPlayers.h"
 
-#include "Common/HttpRequest.h"
-
 class QDialogButtonBox;
 class QLabel;
 class QLineEdit;
@@ -44,5 +42,4 @@ private:
 
   LocalPlayers::LocalPlayers::Player* m_local_player = nullptr;
   
-  Common::HttpRequest m_http{std::chrono::minutes{3}};
 };
@@ -24,6 +24,7 @@
 #include "Common/IniFile.h"
 
 #include "Core/LocalPlayersConfig.h"
+#include "Core/TagSetService.h"
 #include "DolphinQt/Config/AddLocalPlayers.h"
 
 #include "Core/ConfigManager.h"
@@ -278,7 +279,7 @@ void LocalPlayersWidget::PopulateTagsetCombobox()
     {
       return;
     }
-    valid_tagsets.push_back(Tag::getAvailableTagSets(m_http, player1key));
+    valid_tagsets.push_back(TagSetService::GetInstance().getAvailableTagSets(player1key));
   }
 
   // Player 2
@@ -288,7 +289,7 @@ void LocalPlayersWidget::PopulateTagsetCombobox()
     {
       return;
     }
-    valid_tagsets.push_back(Tag::getAvailableTagSets(m_http, player2key));
+    valid_tagsets.push_back(TagSetService::GetInstance().getAvailableTagSets(player2key));
   }
 
   // Player 3
@@ -298,7 +299,7 @@ void LocalPlayersWidget::PopulateTagsetCombobox()
     {
       return;
     }
-    valid_tagsets.push_back(Tag::getAvailableTagSets(m_http, player3key));
+    valid_tagsets.push_back(TagSetService::GetInstance().getAvailableTagSets(player3key));
   }
 
   // Player 4
@@ -308,7 +309,7 @@ void LocalPlayersWidget::PopulateTagsetCombobox()
     {
       return;
     }
-    valid_tagsets.push_back(Tag::getAvailableTagSets(m_http, player1key));
+    valid_tagsets.push_back(TagSetService::GetInstance().getAvailableTagSets(player1key));
   }
 
   if (valid_tagsets.size() == 0)
@@ -365,7 +366,7 @@ void LocalPlayersWidget::SetTagSet()
 
 bool LocalPlayersWidget::IsValidUser(LocalPlayers::LocalPlayers::Player player)
 {
-  LocalPlayers::LocalPlayers::AccountValidationType type = player.ValidateAccount(m_http);
+  LocalPlayers::LocalPlayers::AccountValidationType type = player.ValidateAccount();
 
   if (type == LocalPlayers::LocalPlayers::Invalid)
   {
@@ -7,7 +7,6 @@
 
 #include <array>
 
-#include "Common/HttpRequest.h"
 #include "Core/LocalPlayers.h"
 
 class QComboBox;
@@ -54,7 +53,6 @@ private:
 
   QComboBox* m_local_tagset;
   QTextEdit* m_game_mode_description;
-  Common::HttpRequest m_http{std::chrono::minutes{3}};
 
   QPushButton* m_add_button;
   QPushButton* m_remove_button;
@@ -10,7 +10,9 @@
 
 #include "Common/Config/Config.h"
 
+#include "Core/Config/NetplaySettings.h"
 #include "Core/Config/UISettings.h"
+#include "Core/ConfigManager.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -18,6 +20,7 @@
 
 #include "DolphinQt/Settings.h"
 
+#include "UICommon/GameDigestCache.h"
 #include "UICommon/GameFile.h"
 
 // NOTE: Qt likes to be case-sensitive here even though it shouldn't be thus this ugly regex hack
@@ -30,6 +33,14 @@ static const QStringList game_filters{
     QStringLiteral("*.[eE][lL][fF]"),    QStringLiteral("*.[dD][oO][lL]"),
     QStringLiteral("*.[jJ][sS][oO][nN]")};
 
+// Only discs of the games Rio allows can be played on NetPlay, the others aren't worth hashing
+static bool NeedsGameDigest(const UICommon::GameFile& game)
+{
+  return (game.GetPlatform() == DiscIO::Platform::GameCubeDisc ||
+          game.GetPlatform() == DiscIO::Platform::WiiDisc) &&
+         SConfig::GameIsAllowed(game.GetGameID());
+}
+
 GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
 {
   qRegisterMetaType<std::shared_ptr<const UICommon::GameFile>>();
@@ -38,6 +49,7 @@ GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
   connect(qApp, &QApplication::aboutToQuit, this, [this] {
     m_processing_halted = true;
     m_load_thread.Shutdown(true);
+    m_digest_thread.Shutdown(true);
   });
   connect(this, &QFileSystemWatcher::directoryChanged, this, &GameTracker::UpdateDirectory);
   connect(this, &QFileSystemWatcher::fileChanged, this, &GameTracker::UpdateFile);
@@ -98,11 +110,24 @@ GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
     case CommandType::EndRefresh:
       m_refresh_in_progress = false;
       m_cache.Save();
+      QueueGameDigests();
       QueueOnObject(this, [] { Settings::Instance().NotifyRefreshGameListComplete(); });
       break;
     }
   });
 
+  m_digest_thread.Reset("GameList Digests", [this](const std::vector<std::string>& paths) {
+    UICommon::GameDigestCache& cache = UICommon::GameDigestCache::GetInstance();
+    for (const std::string& path : paths)
+    {
+      if (m_digest_thread.IsCancelling())
+        break;
+      cache.GetOrCompute(path, [this](int) { return !m_digest_thread.IsCancelling(); });
+    }
+    // The cache is written whole, so once per batch
+    cache.Save();
+  });
+
   m_load_thread.EmplaceItem(Command{CommandType::LoadCache, {}});
 
   // TODO: When language changes, reload m_title_database and call m_cache.UpdateAdditionalMetadata
@@ -161,6 +186,8 @@ void GameTracker::StartInternal()
   if (cache_updated)
     m_cache.Save();
 
+  QueueGameDigests();
+
   QueueOnObject(this, [] { Settings::Instance().NotifyMetadataRefreshComplete(); });
   QueueOnObject(this, [] { Settings::Instance().NotifyRefreshGameListComplete(); });
 }
@@ -358,12 +385,37 @@ void GameTracker::LoadGame(const QString& path)
     bool cache_changed = false;
     auto game = m_cache.AddOrGet(converted_path, &cache_changed);
     if (game)
+    {
+      if (NeedsGameDigest(*game))
+        QueueGameDigests({game->GetFilePath()});
       emit GameLoaded(std::move(game));
+    }
     if (cache_changed && !m_refresh_in_progress)
       m_cache.Save();
   }
 }
 
+void GameTracker::QueueGameDigests()
+{
+  std::vector<std::string> paths;
+  m_cache.ForEach([&paths](const auto& game) {
+    if (NeedsGameDigest(*game))
+      paths.push_back(game->GetFilePath());
+  });
+  QueueGameDigests(std::move(paths));
+}
+
+void GameTracker::QueueGameDigests(std::vector<std::string> paths)
+{
+  if (!Config::Get(Config::NETPLAY_PRECOMPUTE_GAME_DIGESTS) || m_processing_halted ||
+      paths.empty())
+  {
+    return;
+  }
+
+  m_digest_thread.EmplaceItem(std::move(paths));
+}
+
 void GameTracker::PurgeCache()
 {
   m_needs_purge = true;
@@ -6,6 +6,7 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <QFileSystemWatcher>
 #include <QMap>
@@ -59,6 +60,8 @@ private:
   void UpdateFileInternal(const QString& path);
   QSet<QString> FindMissingFiles(const QString& dir);
   void LoadGame(const QString& path);
+  void QueueGameDigests();
+  void QueueGameDigests(std::vector<std::string> paths);
 
   bool AddPath(const QString& path);
   bool RemovePath(const QString& path);
@@ -88,6 +91,8 @@ private:
   QMap<QString, QSet<QString>> m_tracked_files;
   QVector<QString> m_tracked_paths;
   Common::WorkQueueThread<Command> m_load_thread;
+  // Hashes games ahead of time for NetPlay, see UICommon::GameDigestCache
+  Common::WorkQueueThread<std::vector<std::string>> m_digest_thread;
   UICommon::GameFileCache m_cache;
   Common::Event m_cache_loaded_event;
   Common::Event m_initial_games_emitted_event;
@@ -48,6 +48,8 @@
 #include "VideoCommon/VideoConfig.h"
 
 constexpr const char* DUBOIS_ALGORITHM_SHADER = "dubois";
+// Each press of the rewind hotkey goes back this far
+constexpr double REWIND_HOTKEY_SECONDS = 2.0;
 
 HotkeyScheduler::HotkeyScheduler() : m_stop_requested(false)
 {
@@ -624,6 +626,12 @@ void HotkeyScheduler::Run()
 
     if (IsHotkey(HK_SAVE_STATE_FILE))
       emit StateSaveFile();
+
+    if (IsHotkey(HK_REWIND))
+      State::Rewind(REWIND_HOTKEY_SECONDS);
+
+    if (IsHotkey(HK_RETRY_AT_BAT))
+      State::Retry();
   }
 }
 
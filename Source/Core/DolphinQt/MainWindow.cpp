@@ -12,6 +12,7 @@
 #include <QDropEvent>
 #include <QFileInfo>
 #include <QIcon>
+#include <QInputDialog>
 #include <QMimeData>
 #include <QStackedWidget>
 #include <QStyleHints>
@@ -20,7 +21,9 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <future>
+#include <limits>
 #include <optional>
 #include <variant>
 
@@ -326,6 +329,7 @@ MainWindow::MainWindow(std::unique_ptr<BootParameters> boot_parameters,
 
   // lazy fix -- call this here so local players are loaded in every time client launches
   LocalPlayers::LoadLocalPorts();
+  LocalPlayers::PrefetchAccounts();
 
   Host::GetInstance()->SetMainWindowHandle(reinterpret_cast<void*>(winId()));
 }
@@ -579,6 +583,7 @@ void MainWindow::ConnectMenuBar()
   connect(m_menu_bar, &MenuBar::StartRecording, this, &MainWindow::OnStartRecording);
   connect(m_menu_bar, &MenuBar::StopRecording, this, &MainWindow::OnStopRecording);
   connect(m_menu_bar, &MenuBar::ExportRecording, this, &MainWindow::OnExportRecording);
+  connect(m_menu_bar, &MenuBar::SeekRecording, this, &MainWindow::OnSeekRecording);
   connect(m_menu_bar, &MenuBar::ShowTASInput, this, &MainWindow::ShowTASInput);
 
   // View
@@ -1393,7 +1398,7 @@ void MainWindow::ShowGraphicsWindow()
 void MainWindow::ShowNetPlaySetupDialog()
 {
   // Validate Rio User
-  LocalPlayers::LocalPlayers::AccountValidationType type = LocalPlayers::m_online_player.ValidateAccount(m_http);
+  LocalPlayers::LocalPlayers::AccountValidationType type = LocalPlayers::m_online_player.ValidateAccount();
 
   if (type == LocalPlayers::LocalPlayers::Invalid)
   {
@@ -2014,10 +2019,39 @@ void MainWindow::OnExportRecording()
     QString dtm_file = DolphinFileDialog::getSaveFileName(
         this, tr("Save Recording File As"), QString(), tr("Dolphin TAS Movies (*.dtm)"));
     if (!dtm_file.isEmpty())
-      Core::System::GetInstance().GetMovie().SaveRecording(dtm_file.toStdString());
+    {
+      auto& movie = Core::System::GetInstance().GetMovie();
+      movie.SaveRecording(dtm_file.toStdString());
+      movie.SaveKeyframes(dtm_file.toStdString());
+    }
   });
 }
 
+void MainWindow::OnSeekRecording()
+{
+  auto& movie = Core::System::GetInstance().GetMovie();
+  if (!movie.IsPlayingInput())
+  {
+    ModalMessageBox::information(this, tr("Jump to Frame"),
+                                 tr("Jumping to a frame only works while playing a recording."));
+    return;
+  }
+
+  bool ok;
+  const int frame = QInputDialog::getInt(
+      this, tr("Jump to Frame"), tr("Frame:"), static_cast<int>(movie.GetCurrentFrame()), 0,
+      static_cast<int>(std::min<u64>(movie.GetTotalFrames(), std::numeric_limits<int>::max())), 1,
+      &ok);
+  if (!ok)
+    return;
+
+  if (!movie.SeekToFrame(static_cast<u64>(frame)))
+  {
+    ModalMessageBox::critical(this, tr("Jump to Frame"),
+                              tr("This recording has no keyframe before frame %1.").arg(frame));
+  }
+}
+
 void MainWindow::OnActivateChat()
 {
   if (g_netplay_chat_ui)
@@ -206,6 +206,7 @@ private:
   void OnStartRecording();
   void OnStopRecording();
   void OnExportRecording();
+  void OnSeekRecording();
   void OnActivateChat();
   void OnRequestGolfControl();
   void ShowTASInput();
@@ -290,5 +291,4 @@ private:
   CheatsManager* m_cheats_manager;
   QByteArray m_render_widget_geometry;
 
-  Common::HttpRequest m_http{std::chrono::minutes{3}};
 };
@@ -119,6 +119,7 @@ signals:
   void StartRecording();
   void StopRecording();
   void ExportRecording();
+  void SeekRecording();
   void ShowTASInput();
 
   void SelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
@@ -235,6 +236,7 @@ private:
   // Movie
   QAction* m_recording_export;
   QAction* m_recording_play;
+  QAction* m_recording_seek;
   QAction* m_recording_start;
   QAction* m_recording_stop;
   QAction* m_recording_read_only;
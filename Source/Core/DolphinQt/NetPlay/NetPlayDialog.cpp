@@ -203,12 +203,25 @@ void NetPlayDialog::CreateMainLayout()
       tr("Each player sends their own inputs to the game, with equal buffer size for all players, "
          "configured by the host.\nRecommended only for casual games or when playing minigames."));
   m_fixed_delay_action->setCheckable(true);
+  m_rollback_action = m_network_menu->addAction(tr("Rollback"));
+  m_rollback_action->setToolTip(
+      tr("Each player's inputs take effect right away. The opponent's inputs are predicted, and "
+         "the game is rewound and replayed\nwhen a prediction was wrong. Replays show as short "
+         "speedups, more often the higher the ping."));
+  m_rollback_action->setCheckable(true);
 
   m_network_mode_group = new QActionGroup(this);
   m_network_mode_group->setExclusive(true);
   m_network_mode_group->addAction(m_fixed_delay_action);
   m_network_mode_group->addAction(m_golf_mode_action);
+  m_network_mode_group->addAction(m_rollback_action);
   m_fixed_delay_action->setChecked(true);
+  m_network_menu->addSeparator();
+  m_auto_buffer_action = m_network_menu->addAction(tr("Adjust Buffer Automatically"));
+  m_auto_buffer_action->setToolTip(
+      tr("Picks the buffer from the players' ping and how evenly their inputs arrive. The "
+         "buffer only changes between at-bats. Does nothing with Auto Golf Mode."));
+  m_auto_buffer_action->setCheckable(true);
 
   m_game_digest_menu = m_menu_bar->addMenu(tr("Checksum"));
   m_game_digest_menu->addAction(tr("Current game"), this, [this] {
@@ -444,6 +457,7 @@ void NetPlayDialog::ConnectWidgets()
 
   connect(m_golf_mode_action, &QAction::toggled, this, [hia_function] { hia_function(true); });
   connect(m_fixed_delay_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
+  connect(m_rollback_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
 
   connect(m_start_button, &QPushButton::clicked, this, &NetPlayDialog::OnStart);
   connect(m_quit_button, &QPushButton::clicked, this, &NetPlayDialog::reject);
@@ -492,6 +506,8 @@ void NetPlayDialog::ConnectWidgets()
   connect(m_golf_mode_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_golf_mode_overlay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_fixed_delay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_rollback_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_auto_buffer_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_hide_remote_gbas_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   //connect(m_night_stadium_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   //connect(m_disable_music_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
@@ -1123,6 +1139,7 @@ void NetPlayDialog::SetOptionsEnabled(bool enabled)
     //m_host_input_authority_action->setEnabled(enabled);
     m_golf_mode_action->setEnabled(enabled);
     m_fixed_delay_action->setEnabled(enabled);
+    m_rollback_action->setEnabled(enabled);
     m_night_stadium->setCheckable(enabled);
     m_disable_replays->setCheckable(enabled);
     //m_night_stadium_action->setEnabled(enabled);
@@ -1263,9 +1280,10 @@ void NetPlayDialog::OnHostInputAuthorityChanged(bool enabled)
 
 void NetPlayDialog::OnDesync(u32 frame, const std::string& player)
 {
-  OSD::AddTypedMessage(OSD::MessageType::NetPlayDesync,
-                       "Possible desync detected. Game restart advised (if this goes away, it's a false alarm).",
-                       OSD::Duration::SHORT, OSD::Color::RED);
+  OSD::AddTypedMessage(
+      OSD::MessageType::NetPlayDesync,
+      fmt::format("Desync with {} detected around frame {}. Game restart advised.", player, frame),
+      OSD::Duration::VERY_LONG, OSD::Color::RED);
   // TODO:
   // tell stat tracker here that a desync happened. write it to the event & gamestate
 }
@@ -1434,6 +1452,7 @@ void NetPlayDialog::LoadSettings()
   const bool strict_settings_sync = Config::Get(Config::NETPLAY_STRICT_SETTINGS_SYNC);
   const bool golf_mode_overlay = Config::Get(Config::NETPLAY_GOLF_MODE_OVERLAY);
   const bool hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
+  const bool auto_buffer = Config::Get(Config::NETPLAY_AUTO_BUFFER);
   //const bool night_stadium = Config::Get(Config::NETPLAY_NIGHT_STADIUM);
   //const bool disable_music = Config::Get(Config::NETPLAY_DISABLE_MUSIC);
   //const bool highlight_ball_shadow = Config::Get(Config::NETPLAY_HIGHLIGHT_BALL_SHADOW);
@@ -1454,6 +1473,7 @@ void NetPlayDialog::LoadSettings()
   m_strict_settings_sync_action->setChecked(strict_settings_sync);
   m_golf_mode_overlay_action->setChecked(golf_mode_overlay);
   m_hide_remote_gbas_action->setChecked(hide_remote_gbas);
+  m_auto_buffer_action->setChecked(auto_buffer);
   //m_night_stadium_action->setChecked(night_stadium);
   //m_disable_music_action->setChecked(disable_music);
   //m_highlight_ball_shadow_action->setChecked(highlight_ball_shadow);
@@ -1469,6 +1489,10 @@ void NetPlayDialog::LoadSettings()
   {
     m_golf_mode_action->setChecked(true);
   }
+  else if (network_mode == "rollback")
+  {
+    m_rollback_action->setChecked(true);
+  }
   else
   {
     WARN_LOG_FMT(NETPLAY, "Unknown network mode '{}', using 'fixeddelay'", network_mode);
@@ -1497,6 +1521,7 @@ void NetPlayDialog::SaveSettings()
   Config::SetBase(Config::NETPLAY_STRICT_SETTINGS_SYNC, m_strict_settings_sync_action->isChecked());
   Config::SetBase(Config::NETPLAY_GOLF_MODE_OVERLAY, m_golf_mode_overlay_action->isChecked());
   Config::SetBase(Config::NETPLAY_HIDE_REMOTE_GBAS, m_hide_remote_gbas_action->isChecked());
+  Config::SetBase(Config::NETPLAY_AUTO_BUFFER, m_auto_buffer_action->isChecked());
   //Config::SetBase(Config::NETPLAY_NIGHT_STADIUM, m_night_stadium_action->isChecked());
   //Config::SetBase(Config::NETPLAY_DISABLE_MUSIC, m_disable_music_action->isChecked());
   //Config::SetBase(Config::NETPLAY_HIGHLIGHT_BALL_SHADOW, m_highlight_ball_shadow_action->isChecked());
@@ -1511,6 +1536,10 @@ void NetPlayDialog::SaveSettings()
   {
     network_mode = "golf";
   }
+  else if (m_rollback_action->isChecked())
+  {
+    network_mode = "rollback";
+  }
 
   Config::SetBase(Config::NETPLAY_NETWORK_MODE, network_mode);
 }
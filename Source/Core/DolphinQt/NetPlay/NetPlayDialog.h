@@ -175,6 +175,8 @@ private:
   QAction* m_golf_mode_action;
   QAction* m_golf_mode_overlay_action;
   QAction* m_fixed_delay_action;
+  QAction* m_rollback_action;
+  QAction* m_auto_buffer_action;
   QAction* m_hide_remote_gbas_action;
   QAction* m_night_stadium_action;
   QAction* m_disable_music_action;
@@ -28,6 +28,7 @@
 
 #include "Core/Config/NetplaySettings.h"
 #include "Core/NetPlayProto.h"
+#include "Core/TagSetService.h"
 
 #include "DolphinQt/QtUtils/ModalMessageBox.h"
 #include "DolphinQt/QtUtils/NonDefaultQPushButton.h"
@@ -645,7 +646,7 @@ std::map<int, Tag::TagSet>& NetPlaySetupDialog::assignOnlineAccount(LocalPlayers
     m_host_server_name->setText(QString::fromStdString(nickname));
   }
 
-  user_tagsets = Tag::getAvailableTagSets(m_http, m_active_account.userid);
+  user_tagsets = TagSetService::GetInstance().getAvailableTagSets(m_active_account.userid);
 
   // add game modes
   tagset_map.clear();
@@ -140,5 +140,4 @@ private:
   std::map<int, Tag::TagSet> user_tagsets;
   std::map<int, std::optional<Tag::TagSet>> tagset_map; // maps the index of the tagset combo box to the tagset id
   const GameListModel& m_game_list_model;
-  Common::HttpRequest m_http{std::chrono::minutes{3}};
 };
@@ -0,0 +1,224 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/NetPlayBenchCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <enet/enet.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/StringUtil.h"
+#include "Core/NetPlayLinkSimulator.h"
+#include "Core/NetPlayLoopbackBenchmark.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+static int RunRelay(const std::string& server, u16 listen_port,
+                    const NetPlay::LinkConditions& conditions, u32 seed)
+{
+  const size_t separator = server.rfind(':');
+  u16 server_port = 0;
+  if (separator == std::string::npos || !TryParse(server.substr(separator + 1), &server_port))
+  {
+    fmt::print(std::cerr, "Error: Relay target must be HOST:PORT\n");
+    return EXIT_FAILURE;
+  }
+
+  if (enet_initialize() != 0)
+  {
+    fmt::print(std::cerr, "Error: Unable to initialize ENet\n");
+    return EXIT_FAILURE;
+  }
+
+  ENetAddress address{};
+  if (enet_address_set_host(&address, server.substr(0, separator).c_str()) != 0)
+  {
+    fmt::print(std::cerr, "Error: Unable to resolve {}\n", server.substr(0, separator));
+    return EXIT_FAILURE;
+  }
+  address.port = server_port;
+
+  NetPlay::LinkSimulator link(address, conditions, conditions, seed);
+  if (!link.Start(listen_port))
+  {
+    fmt::print(std::cerr, "Error: Unable to listen on port {}\n", listen_port);
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cerr, "Relaying port {} to {}, press Enter to stop\n", link.GetListenPort(),
+             server);
+  std::string line;
+  std::getline(std::cin, line);
+  link.Stop();
+
+  const NetPlay::LinkSimulator::Stats stats = link.GetStats();
+  fmt::print(std::cout, "Clients: {}\n", stats.clients);
+  for (const auto& [name, direction] :
+       {std::pair{"To server", stats.upstream}, std::pair{"To clients", stats.downstream}})
+  {
+    fmt::print(std::cout, "{}: {} datagrams, {} dropped, {} reordered\n", name,
+               direction.submitted, direction.dropped, direction.reordered);
+  }
+  return EXIT_SUCCESS;
+}
+
+int NetPlayBenchCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: netplaybench [options]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path, the NetPlay settings of the session come from there. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-m", "--mode")
+      .type("string")
+      .action("store")
+      .help("Optional. NetPlay mode to benchmark, hia is host input authority. Default is "
+            "normal. [%choices]")
+      .choices({"normal", "hia", "golf"})
+      .set_default("normal");
+
+  parser.add_option("-p", "--players")
+      .type("int")
+      .action("store")
+      .help("Optional. Number of players, from 2 to 4. Default is 2.")
+      .set_default(2);
+
+  parser.add_option("-f", "--frames")
+      .type("int")
+      .action("store")
+      .help("Optional. Frames every player runs. Default is 3600.")
+      .set_default(3600);
+
+  parser.add_option("-b", "--buffer")
+      .type("int")
+      .action("store")
+      .help("Optional. Pad buffer size, 8 at least. Default is 8.")
+      .set_default(8);
+
+  parser.add_option("-l", "--latency")
+      .type("double")
+      .action("store")
+      .help("Optional. One way latency in milliseconds between the server and the players other "
+            "than the host. Default is 0.")
+      .set_default(0);
+
+  parser.add_option("-j", "--jitter")
+      .type("double")
+      .action("store")
+      .help("Optional. Latency variation in milliseconds, each way. Default is 0.")
+      .set_default(0);
+
+  parser.add_option("--loss")
+      .type("double")
+      .action("store")
+      .help("Optional. Percentage of datagrams lost, each way. Default is 0.")
+      .set_default(0);
+
+  parser.add_option("--reorder")
+      .type("double")
+      .action("store")
+      .help("Optional. Percentage of datagrams reordered, each way. Default is 0.")
+      .set_default(0);
+
+  parser.add_option("--golf-switch")
+      .type("int")
+      .action("store")
+      .help("Optional. Frames between golfer switches in golf mode. Default is 600.")
+      .set_default(600);
+
+  parser.add_option("--seed")
+      .type("int")
+      .action("store")
+      .help("Optional. Seed for the simulated network. Default is 0.")
+      .set_default(0);
+
+  parser.add_option("-r", "--relay")
+      .type("string")
+      .action("store")
+      .help("Optional. Instead of benchmarking, relay a real NetPlay session to the server at "
+            "HOST:PORT with the network conditions above, until Enter is pressed. Clients "
+            "connect to the listen port.")
+      .metavar("HOST:PORT");
+
+  parser.add_option("--listen")
+      .type("int")
+      .action("store")
+      .help("Optional. Port the relay listens on. Default is 2627.")
+      .set_default(2627);
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  NetPlay::LinkConditions conditions;
+  conditions.latency_ms = static_cast<double>(options.get("latency"));
+  conditions.jitter_ms = static_cast<double>(options.get("jitter"));
+  conditions.loss = static_cast<double>(options.get("loss")) / 100;
+  conditions.reorder = static_cast<double>(options.get("reorder")) / 100;
+  const u32 seed = static_cast<u32>(static_cast<int>(options.get("seed")));
+
+  if (options.is_set("relay"))
+  {
+    return RunRelay(options["relay"], static_cast<u16>(static_cast<int>(options.get("listen"))),
+                    conditions, seed);
+  }
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  NetPlay::BenchmarkSettings settings;
+  settings.mode = *NetPlay::ParseBenchmarkMode(options["mode"]);
+  settings.players = static_cast<u32>(static_cast<int>(options.get("players")));
+  settings.frames = static_cast<u32>(static_cast<int>(options.get("frames")));
+  settings.buffer = static_cast<u32>(static_cast<int>(options.get("buffer")));
+  settings.golf_switch_frames = static_cast<u32>(static_cast<int>(options.get("golf_switch")));
+  settings.conditions = conditions;
+  settings.seed = seed;
+
+  if (settings.players < 2 || settings.players > 4)
+  {
+    fmt::print(std::cerr, "Error: Players must be from 2 to 4\n");
+    return EXIT_FAILURE;
+  }
+
+  const NetPlay::BenchmarkResult result = NetPlay::RunLoopbackBenchmark(settings);
+  if (result.players.empty())
+  {
+    fmt::print(std::cerr, "Error: Unable to start the benchmark\n");
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout,
+             "Player    FPS  Stalls  Stall ms   Max ms  Local ms (p95)  Remote ms (p95)\n");
+  for (size_t pid = 0; pid < result.players.size(); ++pid)
+  {
+    const NetPlay::BenchmarkPlayerResult& player = result.players[pid];
+    fmt::print(std::cout,
+               "{:>6} {:>6.1f} {:>7} {:>9.0f} {:>8.1f} {:>6.1f} ({:>5.1f}) {:>7.1f} ({:>5.1f}){}\n",
+               pid == 0 ? std::string("host") : fmt::format("{}", pid + 1),
+               player.seconds > 0 ? player.frames / player.seconds : 0.0, player.stalls,
+               player.stall_ms, player.max_stall_ms, player.local_delay_ms,
+               player.local_delay_p95_ms, player.remote_delay_ms, player.remote_delay_p95_ms,
+               player.timed_out ? "  timed out" : "");
+  }
+  fmt::print(std::cout, "Network: {} and {} datagrams to and from the server, {} dropped, {} "
+                        "reordered\n",
+             result.link.upstream.submitted, result.link.downstream.submitted,
+             result.link.upstream.dropped + result.link.downstream.dropped,
+             result.link.upstream.reordered + result.link.downstream.reordered);
+
+  return result.success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
@@ -0,0 +1,169 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/StatTrackCommand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Core/Core.h"
+#include "Core/MSB_StatTracker.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+int StatTrackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: stattrack [options]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("Optional. User folder path to replay in. Stat, HUD and journal files are written "
+            "here. A temporary folder is used and removed afterwards if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to stat tracker trace FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Optional. Copy the stat files of every game in the trace to DIR instead of printing "
+            "them.")
+      .metavar("DIR");
+
+  parser.add_option("-d", "--decoded")
+      .action("store_true")
+      .help("Optional. Print the decoded stat JSON instead of the raw stat JSON.");
+
+  parser.add_option("-v", "--verbose")
+      .action("store_true")
+      .help("Optional. Print the stat tracker log while replaying.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& input_file_path = options["input"];
+  const std::string& output_path = options["output"];
+  const bool print_decoded = options.is_set_by_user("decoded");
+
+  // Never replay into the real user folder unless asked to, the tracker writes files there
+  const bool temporary_user_folder = options["user"].empty();
+  const std::string user_path =
+      temporary_user_folder ? File::CreateTempDir() : std::string(options["user"]);
+  if (user_path.empty())
+  {
+    fmt::print(std::cerr, "Error: Unable to create a temporary user folder\n");
+    return EXIT_FAILURE;
+  }
+  UICommon::SetUserDirectory(user_path);
+  UICommon::Init();
+
+  // Only report the games from this trace, not what an existing user folder already holds
+  const std::string stat_files_path = File::GetUserPath(D_MSSBFILES_IDX);
+  const std::vector<std::string> existing_files = Common::DoFileSearch({stat_files_path}, {".json"});
+
+  // The tracker log goes to stdout, keep it out of the JSON unless asked for
+  std::streambuf* const cout_buffer = std::cout.rdbuf();
+  if (!options.is_set_by_user("verbose"))
+    std::cout.rdbuf(nullptr);
+
+  // Replay on this thread, the trace stands in for the CPU
+  Core::DeclareAsCPUThread();
+  std::optional<u64> frames;
+  std::chrono::steady_clock::duration elapsed{};
+  {
+    auto tracker = std::make_unique<StatTracker>();
+    tracker->init();
+
+    Core::CPUThreadGuard guard(Core::System::GetInstance());
+    const auto start = std::chrono::steady_clock::now();
+    frames = tracker->replayTrace(guard, input_file_path);
+    elapsed = std::chrono::steady_clock::now() - start;
+  }
+  Core::UndeclareAsCPUThread();
+
+  std::cout.clear();
+  std::cout.rdbuf(cout_buffer);
+
+  int result = EXIT_SUCCESS;
+  if (!frames)
+  {
+    fmt::print(std::cerr, "Error: Unable to replay {}\n", input_file_path);
+    result = EXIT_FAILURE;
+  }
+  else
+  {
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    fmt::print(std::cerr, "Replayed {} frames in {:.3f} s ({:.0f} frames/s)\n", *frames, seconds,
+               seconds > 0 ? *frames / seconds : 0.0);
+
+    // One file per game and kind: decoded., quit.decode., crash.decode. and their raw versions
+    std::vector<std::string> stat_files = Common::DoFileSearch({stat_files_path}, {".json"});
+    std::erase_if(stat_files, [&](const std::string& path) {
+      return std::find(existing_files.begin(), existing_files.end(), path) != existing_files.end();
+    });
+    if (stat_files.empty())
+      fmt::print(std::cerr, "No game was finished in the trace\n");
+
+    if (!output_path.empty())
+      File::CreateFullPath(output_path + DIR_SEP);
+
+    for (const std::string& path : stat_files)
+    {
+      std::string file_name, extension;
+      SplitPath(path, nullptr, &file_name, &extension);
+      file_name += extension;
+
+      if (!output_path.empty())
+      {
+        if (!File::Copy(path, output_path + DIR_SEP + file_name))
+        {
+          fmt::print(std::cerr, "Error: Unable to write {} to {}\n", file_name, output_path);
+          result = EXIT_FAILURE;
+        }
+        continue;
+      }
+
+      const bool decoded = file_name.find("decode") != std::string::npos;
+      if (decoded != print_decoded)
+        continue;
+
+      std::string json;
+      if (File::ReadFileToString(path, json))
+        fmt::print(std::cout, "{}", json);
+    }
+  }
+
+  if (temporary_user_folder)
+    File::DeleteDirRecursively(user_path);
+
+  return result;
+}
+}  // namespace DolphinTool
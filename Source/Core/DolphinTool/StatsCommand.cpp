@@ -0,0 +1,216 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/StatsCommand.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Core/MSB_StatArchive.h"
+#include "Core/MSB_StatDecode.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+// Accepts the decoded name, case insensitive, or the id
+static std::optional<u8> ParseDecodable(DecodeType type, const std::string& str)
+{
+  for (u32 value = 0; value < 256; ++value)
+  {
+    const std::optional<std::string_view> name = decode(type, static_cast<u8>(value));
+    if (name && Common::CaseInsensitiveEquals(*name, str))
+      return static_cast<u8>(value);
+  }
+
+  u8 value;
+  if (TryParse(str, &value) && decode(type, value))
+    return value;
+  return std::nullopt;
+}
+
+// YYYY-MM-DD in UTC to unix time
+static std::optional<s64> ParseDate(const std::string& str)
+{
+  int year, month, day;
+  char extra;
+  if (std::sscanf(str.c_str(), "%d-%d-%d%c", &year, &month, &day, &extra) != 3)
+    return std::nullopt;
+
+  const std::chrono::year_month_day date{std::chrono::year(year),
+                                         std::chrono::month(static_cast<unsigned>(month)),
+                                         std::chrono::day(static_cast<unsigned>(day))};
+  if (!date.ok())
+    return std::nullopt;
+  return std::chrono::sys_seconds(std::chrono::sys_days(date)).time_since_epoch().count();
+}
+
+static double Ratio(u32 numerator, u32 denominator)
+{
+  return denominator != 0 ? static_cast<double>(numerator) / denominator : 0.0;
+}
+
+int StatsCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: stats [options]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("Optional. User folder path whose stat archive is queried. The default user folder is "
+            "used if neither this nor --archive is set.")
+      .set_default("");
+
+  parser.add_option("-a", "--archive")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to the stat archive DIR, overrides --user.")
+      .metavar("DIR");
+
+  parser.add_option("-c", "--character")
+      .type("string")
+      .action("store")
+      .help("Optional. Only count games CHARACTER played in, by name or id.")
+      .metavar("CHARACTER");
+
+  parser.add_option("-s", "--stadium")
+      .type("string")
+      .action("store")
+      .help("Optional. Only count games played in STADIUM, by name or id.")
+      .metavar("STADIUM");
+
+  parser.add_option("--from")
+      .type("string")
+      .action("store")
+      .help("Optional. Only count games started on or after DATE (YYYY-MM-DD, UTC).")
+      .metavar("DATE");
+
+  parser.add_option("--to")
+      .type("string")
+      .action("store")
+      .help("Optional. Only count games started before DATE (YYYY-MM-DD, UTC).")
+      .metavar("DATE");
+
+  parser.add_option("-t", "--tagset")
+      .type("string")
+      .action("store")
+      .help("Optional. Only count games played with tag set ID.")
+      .metavar("ID");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  StatArchiveFilter filter;
+  if (options.is_set("character"))
+  {
+    filter.char_id = ParseDecodable(DecodeType::Character, options["character"]);
+    if (!filter.char_id)
+    {
+      fmt::print(std::cerr, "Error: Unknown character {}\n", options["character"]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (options.is_set("stadium"))
+  {
+    filter.stadium = ParseDecodable(DecodeType::Stadium, options["stadium"]);
+    if (!filter.stadium)
+    {
+      fmt::print(std::cerr, "Error: Unknown stadium {}\n", options["stadium"]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (const auto& [option, bound] :
+       {std::pair{"from", &filter.start_from}, std::pair{"to", &filter.start_to}})
+  {
+    if (!options.is_set(option))
+      continue;
+
+    *bound = ParseDate(options[option]);
+    if (!*bound)
+    {
+      fmt::print(std::cerr, "Error: Invalid date {}\n", options[option]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (options.is_set("tagset"))
+  {
+    s32 tag_set_id;
+    if (!TryParse(options["tagset"], &tag_set_id))
+    {
+      fmt::print(std::cerr, "Error: Invalid tag set {}\n", options["tagset"]);
+      return EXIT_FAILURE;
+    }
+    filter.tag_set_id = tag_set_id;
+  }
+
+  std::string archive_path = options["archive"];
+  if (archive_path.empty())
+  {
+    UICommon::SetUserDirectory(options["user"]);
+    archive_path = File::GetUserPath(D_STATARCHIVE_IDX);
+  }
+  else if (!archive_path.ends_with(DIR_SEP))
+  {
+    archive_path += DIR_SEP;
+  }
+
+  if (!File::IsDirectory(archive_path))
+  {
+    fmt::print(std::cerr, "Error: No stat archive at {}\n", archive_path);
+    return EXIT_FAILURE;
+  }
+
+  const StatArchive archive(archive_path);
+  const auto start = std::chrono::steady_clock::now();
+  const std::optional<StatArchiveSummary> summary = archive.query(filter);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  if (!summary)
+  {
+    fmt::print(std::cerr, "Error: Unable to read the stat archive at {}\n", archive_path);
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cerr, "Queried {} games in {:.3f} s\n", archive.getNumGames(),
+             std::chrono::duration<double>(elapsed).count());
+
+  fmt::print(std::cout, "Games: {}\n", summary->games);
+  fmt::print(std::cout, "Away wins: {}\n", summary->away_wins);
+  fmt::print(std::cout, "Home wins: {}\n", summary->home_wins);
+  fmt::print(std::cout, "Events: {}\n", summary->events);
+
+  fmt::print(std::cout,
+             "\n{:<12} {:>6} {:>6} {:>6} {:>6} {:>4} {:>4} {:>4} {:>5} {:>7} {:>4} {:>4}\n",
+             "Character", "Games", "AB", "H", "AVG", "HR", "SO", "BB", "RBI", "IP", "K", "R");
+  for (const auto& [char_id, totals] : summary->characters)
+  {
+    fmt::print(std::cout,
+               "{:<12} {:>6} {:>6} {:>6} {:>6.3f} {:>4} {:>4} {:>4} {:>5} {:>5}.{} {:>4} {:>4}\n",
+               decodeName(DecodeType::Character, char_id), totals.games, totals.at_bats,
+               totals.hits, Ratio(totals.hits, totals.at_bats), totals.homeruns,
+               totals.strikeouts, totals.walks, totals.rbi, totals.outs_pitched / 3,
+               totals.outs_pitched % 3, totals.strikeouts_pitched, totals.runs_allowed);
+  }
+
+  fmt::print(std::cout, "\n{:<16} {:>8}\n", "At bat result", "Count");
+  for (const auto& [result, count] : summary->at_bat_results)
+    fmt::print(std::cout, "{:<16} {:>8}\n", decodeName(DecodeType::AtBatResult, result), count);
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -18,13 +18,16 @@
 
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/NetPlayBenchCommand.h"
+#include "DolphinTool/StatTrackCommand.h"
+#include "DolphinTool/StatsCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static void PrintUsage()
 {
   fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
                         "\n"
-                        "commands supported: [convert, verify, header]\n");
+                        "commands supported: [convert, verify, header, stattrack, stats, netplaybench]\n");
 }
 
 #ifdef _WIN32
@@ -51,6 +54,12 @@ int main(int argc, char* argv[])
     return DolphinTool::VerifyCommand(args);
   else if (command_str == "header")
     return DolphinTool::HeaderCommand(args);
+  else if (command_str == "stattrack")
+    return DolphinTool::StatTrackCommand(args);
+  else if (command_str == "stats")
+    return DolphinTool::StatsCommand(args);
+  else if (command_str == "netplaybench")
+    return DolphinTool::NetPlayBenchCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
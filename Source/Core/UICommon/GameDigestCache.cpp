@@ -0,0 +1,325 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "UICommon/GameDigestCache.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <queue>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+
+#include "DiscIO/Blob.h"
+
+namespace UICommon
+{
+static constexpr u32 CACHE_REVISION = 1;
+
+// Enough for the disc header of GameCube and Wii discs
+static constexpr u64 HEADER_SIZE = 0x440;
+
+static constexpr size_t CHUNK_SIZE = 8 * 1024 * 1024;
+// One chunk being read, one being hashed and one waiting, so neither thread waits for the other
+static constexpr size_t CHUNK_COUNT = 3;
+
+void GameDigestCache::Entry::DoState(PointerWrap& p)
+{
+  p.Do(size);
+  p.Do(mtime);
+  p.Do(header_digest);
+  p.Do(digest);
+}
+
+bool GameDigestCache::Entry::IsSameFile(const Entry& other) const
+{
+  return size == other.size && mtime == other.mtime && header_digest == other.header_digest;
+}
+
+GameDigestCache::GameDigestCache(std::string path) : m_path(std::move(path))
+{
+}
+
+GameDigestCache& GameDigestCache::GetInstance()
+{
+  static GameDigestCache cache(File::GetUserPath(D_CACHE_IDX) + "gamedigest.cache");
+  static std::once_flag loaded;
+  std::call_once(loaded, [] { cache.Load(); });
+  return cache;
+}
+
+std::optional<GameDigestCache::Entry> GameDigestCache::ReadKey(const std::string& game_path)
+{
+  std::error_code error;
+  const auto mtime = std::filesystem::last_write_time(StringToPath(game_path), error);
+  if (error)
+    return std::nullopt;
+
+  std::unique_ptr<DiscIO::BlobReader> file(DiscIO::CreateBlobReader(game_path));
+  if (!file)
+    return std::nullopt;
+
+  std::vector<u8> header(std::min(HEADER_SIZE, file->GetDataSize()));
+  if (!file->Read(0, header.size(), header.data()))
+    return std::nullopt;
+
+  Entry entry;
+  entry.size = File::GetSize(game_path);
+  entry.mtime = mtime.time_since_epoch().count();
+  entry.header_digest = Common::SHA1::CalculateDigest(header);
+  return entry;
+}
+
+std::optional<std::string> GameDigestCache::Get(const std::string& game_path)
+{
+  const std::optional<Entry> key = ReadKey(game_path);
+  if (!key)
+    return std::nullopt;
+
+  std::lock_guard lk(m_mutex);
+  const auto it = m_entries.find(game_path);
+  if (it == m_entries.end() || !it->second.IsSameFile(*key))
+    return std::nullopt;
+  return it->second.digest;
+}
+
+std::string GameDigestCache::GetOrCompute(const std::string& game_path,
+                                          const ProgressCallback& report_progress)
+{
+  if (std::optional<std::string> digest = Get(game_path))
+  {
+    if (report_progress)
+      report_progress(100);
+    return *std::move(digest);
+  }
+
+  std::optional<Entry> entry = ReadKey(game_path);
+  if (!entry)
+    return "";
+
+  entry->digest = ComputeDigest(game_path, report_progress);
+  if (entry->digest.empty())
+    return "";
+
+  // Don't keep the digest if the file was written to while it was being hashed
+  const std::optional<Entry> key = ReadKey(game_path);
+  if (key && entry->IsSameFile(*key))
+  {
+    std::lock_guard lk(m_mutex);
+    m_entries.insert_or_assign(game_path, *entry);
+    m_changed = true;
+  }
+
+  return entry->digest;
+}
+
+std::string GameDigestCache::ComputeDigest(const std::string& game_path,
+                                           const ProgressCallback& report_progress)
+{
+  std::unique_ptr<DiscIO::BlobReader> file(DiscIO::CreateBlobReader(game_path));
+  if (!file)
+    return "";
+  const u64 game_size = file->GetDataSize();
+
+  struct Chunk
+  {
+    std::vector<u8> data = std::vector<u8>(CHUNK_SIZE);
+    size_t size = 0;
+  };
+  std::vector<Chunk> chunks(CHUNK_COUNT);
+
+  std::mutex mutex;
+  std::condition_variable chunk_moved;
+  std::queue<Chunk*> free_chunks;
+  std::queue<Chunk*> read_chunks;
+  bool reading_done = false;
+  for (Chunk& chunk : chunks)
+    free_chunks.push(&chunk);
+
+  auto context = Common::SHA1::CreateContext();
+  std::thread hash_thread([&] {
+    Common::SetCurrentThreadName("Game Digest");
+
+    while (true)
+    {
+      Chunk* chunk;
+      {
+        std::unique_lock lk(mutex);
+        chunk_moved.wait(lk, [&] { return !read_chunks.empty() || reading_done; });
+        if (read_chunks.empty())
+          return;
+        chunk = read_chunks.front();
+        read_chunks.pop();
+      }
+
+      context->Update(chunk->data.data(), chunk->size);
+
+      {
+        std::lock_guard lk(mutex);
+        free_chunks.push(chunk);
+      }
+      chunk_moved.notify_all();
+    }
+  });
+
+  bool success = true;
+  for (u64 offset = 0; offset < game_size;)
+  {
+    Chunk* chunk;
+    {
+      std::unique_lock lk(mutex);
+      chunk_moved.wait(lk, [&] { return !free_chunks.empty(); });
+      chunk = free_chunks.front();
+      free_chunks.pop();
+    }
+
+    chunk->size = static_cast<size_t>(std::min<u64>(CHUNK_SIZE, game_size - offset));
+    if (!file->Read(offset, chunk->size, chunk->data.data()))
+    {
+      success = false;
+      break;
+    }
+    offset += chunk->size;
+
+    {
+      std::lock_guard lk(mutex);
+      read_chunks.push(chunk);
+    }
+    chunk_moved.notify_all();
+
+    const int progress =
+        static_cast<int>(static_cast<float>(offset) / static_cast<float>(game_size) * 100);
+    if (report_progress && !report_progress(progress))
+    {
+      success = false;
+      break;
+    }
+  }
+
+  {
+    std::lock_guard lk(mutex);
+    reading_done = true;
+  }
+  chunk_moved.notify_all();
+  hash_thread.join();
+
+  if (!success)
+    return "";
+
+  // Convert to hex
+  return fmt::format("{:02x}", fmt::join(context->Finish(), ""));
+}
+
+bool GameDigestCache::Load()
+{
+  std::lock_guard lk(m_mutex);
+
+  File::IOFile f(m_path, "rb");
+  if (!f)
+    return false;
+
+  std::vector<u8> buffer(f.GetSize());
+  if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
+  {
+    u8* ptr = buffer.data();
+    PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+    DoState(p, buffer.size());
+    if (p.IsReadMode())
+    {
+      // Forget games that were deleted or moved
+      const size_t forgotten =
+          std::erase_if(m_entries, [](const auto& entry) { return !File::Exists(entry.first); });
+      m_changed = forgotten != 0;
+      return true;
+    }
+  }
+
+  // The cache is probably corrupted
+  m_entries.clear();
+  f.Close();
+  File::Delete(m_path);
+  return false;
+}
+
+bool GameDigestCache::Save()
+{
+  std::lock_guard lk(m_mutex);
+  if (!m_changed)
+    return true;
+
+  // Measure the size of the buffer.
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  DoState(p_measure);
+  const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+
+  // Then actually do the write.
+  std::vector<u8> buffer(buffer_size);
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+  DoState(p, buffer_size);
+
+  if (!File::CreateFullPath(m_path))
+    return false;
+  File::IOFile f(m_path, "wb");
+  if (!f || !f.WriteBytes(buffer.data(), buffer.size()))
+    return false;
+
+  m_changed = false;
+  return true;
+}
+
+void GameDigestCache::DoState(PointerWrap& p, u64 size)
+{
+  struct
+  {
+    u32 revision;
+    u64 expected_size;
+  } header = {CACHE_REVISION, size};
+  p.Do(header);
+  if (p.IsReadMode())
+  {
+    if (header.revision != CACHE_REVISION || header.expected_size != size)
+    {
+      p.SetMeasureMode();
+      return;
+    }
+  }
+
+  u32 count = static_cast<u32>(m_entries.size());
+  p.Do(count);
+  if (p.IsReadMode())
+  {
+    m_entries.clear();
+    for (u32 i = 0; i < count && p.IsReadMode(); ++i)
+    {
+      std::string path;
+      Entry entry;
+      p.Do(path);
+      entry.DoState(p);
+      m_entries.emplace(std::move(path), std::move(entry));
+    }
+  }
+  else
+  {
+    for (auto& [path, entry] : m_entries)
+    {
+      std::string key = path;
+      p.Do(key);
+      entry.DoState(p);
+    }
+  }
+}
+}  // namespace UICommon
@@ -0,0 +1,71 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+
+class PointerWrap;
+
+namespace UICommon
+{
+// Remembers the SHA-1 of the data of every game hashed for NetPlay's digest check, so a game is
+// only hashed again once its file changes. Entries are keyed by path, size, modification time
+// and a hash of the start of the data, which holds the disc header.
+class GameDigestCache
+{
+public:
+  // Takes the progress in percent, returns false to cancel
+  using ProgressCallback = std::function<bool(int)>;
+
+  explicit GameDigestCache(std::string path);
+
+  // The cache in the user's cache directory, loaded on first use
+  static GameDigestCache& GetInstance();
+
+  // Returns the digest in hex, if the file didn't change since it was hashed
+  std::optional<std::string> Get(const std::string& game_path);
+
+  // Returns the digest in hex, hashing the file if needed, or an empty string if reading failed
+  // or the hashing was cancelled. New digests are only kept in memory until Save is called.
+  std::string GetOrCompute(const std::string& game_path, const ProgressCallback& report_progress);
+
+  // Loading forgets the files that don't exist anymore. Saving writes the whole cache, so it's
+  // skipped when nothing changed since.
+  bool Load();
+  bool Save();
+
+  // Hashes the data of a game. Reading, which means decompressing for compressed formats, and
+  // hashing run on separate threads.
+  static std::string ComputeDigest(const std::string& game_path,
+                                   const ProgressCallback& report_progress);
+
+private:
+  struct Entry
+  {
+    u64 size = 0;
+    s64 mtime = 0;
+    Common::SHA1::Digest header_digest{};
+    std::string digest;
+
+    bool IsSameFile(const Entry& other) const;
+    void DoState(PointerWrap& p);
+  };
+
+  static std::optional<Entry> ReadKey(const std::string& game_path);
+
+  void DoState(PointerWrap& p, u64 size = 0);
+
+  std::string m_path;
+  std::mutex m_mutex;
+  std::map<std::string, Entry> m_entries;
+  bool m_changed = false;
+};
+}  // namespace UICommon
@@ -268,6 +268,10 @@ void CreateDirectories()
   File::CreateFullPath(File::GetUserPath(D_STATESAVES_IDX));
   File::CreateFullPath(File::GetUserPath(D_STATFILES_IDX));
   File::CreateFullPath(File::GetUserPath(D_MSSBFILES_IDX));
+  File::CreateFullPath(File::GetUserPath(D_STATOUTBOX_IDX));
+  File::CreateFullPath(File::GetUserPath(D_STATJOURNAL_IDX));
+  File::CreateFullPath(File::GetUserPath(D_STATTRACES_IDX));
+  File::CreateFullPath(File::GetUserPath(D_STATARCHIVE_IDX));
   File::CreateFullPath(File::GetUserPath(D_HUDFILES_IDX));
   File::CreateFullPath(File::GetUserPath(D_STATELOGGER_IDX));
   File::CreateFullPath(File::GetUserPath(D_ASM_ROOT_IDX));
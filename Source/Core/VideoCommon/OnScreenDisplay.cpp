@@ -4,16 +4,19 @@
 #include "VideoCommon/OnScreenDisplay.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <map>
 #include <mutex>
 #include <string>
+#include <string_view>
 
 #include <fmt/format.h>
 #include <imgui.h>
 
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
+#include "Common/Mailbox.h"
 #include "Common/Timer.h"
 
 #include "Core/Config/MainSettings.h"
@@ -54,6 +57,21 @@ struct Message
 static std::multimap<MessageType, Message> s_messages;
 static std::mutex s_messages_mutex;
 
+struct OverlayText
+{
+  std::string text;
+  u32 color = Color::YELLOW;
+  // When the published state last had the overlay on screen
+  u64 shown_ms = 0;
+};
+static Common::Mailbox<RioOverlayState> s_rio_overlay_mailbox;
+
+// Only used with s_messages_mutex held
+static RioOverlayState s_rio_overlay_state;
+static std::array<std::string, 4> s_player_names;
+static bool s_player_names_changed = false;
+static std::map<MessageType, OverlayText> s_rio_overlay_text;
+
 static ImVec4 ARGBToImVec4(const u32 argb)
 {
   return ImVec4(static_cast<float>((argb >> 16) & 0xFF) / 255.0f,
@@ -62,7 +80,7 @@ static ImVec4 ARGBToImVec4(const u32 argb)
                 static_cast<float>((argb >> 24) & 0xFF) / 255.0f);
 }
 
-static float DrawMessage(int index, Message& msg, const ImVec2& position, int time_left)
+static bool BeginMessageWindow(int index, const ImVec2& position)
 {
   // We have to provide a window name, and these shouldn't be duplicated.
   // So instead, we generate a name based on the number of messages drawn.
@@ -72,17 +90,27 @@ static float DrawMessage(int index, Message& msg, const ImVec2& position, int ti
   ImGui::SetNextWindowPos(position);
   ImGui::SetNextWindowSize(ImVec2(0.0f, 0.0f));
 
+  return ImGui::Begin(window_name.c_str(), nullptr,
+                      ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoInputs |
+                          ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings |
+                          ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoNav |
+                          ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing);
+}
+
+static float GetMessageWindowHeight()
+{
+  return ImGui::GetWindowSize().y + (WINDOW_PADDING * ImGui::GetIO().DisplayFramebufferScale.y);
+}
+
+static float DrawMessage(int index, Message& msg, const ImVec2& position, int time_left)
+{
   // Gradually fade old messages away (except in their first frame)
   const float fade_time = std::max(std::min(MESSAGE_FADE_TIME, (float)msg.duration), 1.f);
   const float alpha = std::clamp(time_left / fade_time, 0.f, 1.f);
   ImGui::PushStyleVar(ImGuiStyleVar_Alpha, msg.ever_drawn ? alpha : 1.0);
 
   float window_height = 0.0f;
-  if (ImGui::Begin(window_name.c_str(), nullptr,
-                   ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoInputs |
-                       ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings |
-                       ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoNav |
-                       ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing))
+  if (BeginMessageWindow(index, position))
   {
     if (msg.icon)
     {
@@ -114,8 +142,7 @@ static float DrawMessage(int index, Message& msg, const ImVec2& position, int ti
 
     // Use %s in case message contains %.
     ImGui::TextColored(ARGBToImVec4(msg.color), "%s", msg.text.c_str());
-    window_height =
-        ImGui::GetWindowSize().y + (WINDOW_PADDING * ImGui::GetIO().DisplayFramebufferScale.y);
+    window_height = GetMessageWindowHeight();
   }
 
   ImGui::End();
@@ -126,6 +153,187 @@ static float DrawMessage(int index, Message& msg, const ImVec2& position, int ti
   return window_height;
 }
 
+// How long an overlay stays after the game stopped showing it, the time its message was added for
+static u32 GetOverlayLingerTime(MessageType type)
+{
+  switch (type)
+  {
+  case MessageType::TrainingModeBallCoordinates:
+  case MessageType::TrainingModeFielderCoordinates:
+    return 200;
+  case MessageType::TrainingModeGolfing:
+    return 8000;
+  default:
+    return Duration::SHORT;
+  }
+}
+
+static float DrawOverlayText(int index, const OverlayText& overlay, const ImVec2& position,
+                             u32 linger_time, s64 time_left)
+{
+  // Fade away like the messages did
+  const float fade_time = std::max(std::min(MESSAGE_FADE_TIME, (float)linger_time), 1.f);
+  const float alpha = std::clamp(time_left / fade_time, 0.f, 1.f);
+  ImGui::PushStyleVar(ImGuiStyleVar_Alpha, alpha);
+
+  float window_height = 0.0f;
+  if (BeginMessageWindow(index, position))
+  {
+    ImGui::TextColored(ARGBToImVec4(overlay.color), "%s", overlay.text.c_str());
+    window_height = GetMessageWindowHeight();
+  }
+
+  ImGui::End();
+  ImGui::PopStyleVar();
+
+  return window_height;
+}
+
+static bool HasPlayerName(u8 port)
+{
+  return port < s_player_names.size() && !s_player_names[port].empty();
+}
+
+static void UpdatePlayerNamesText(const PlayerNamesOverlay& state)
+{
+  static constexpr std::array<u32, 4> port_colors = {Color::RED, Color::BLUE, Color::YELLOW,
+                                                     Color::GREEN};
+
+  // Without a name the last one lingers
+  const auto set_text = [](MessageType type, std::string_view role, u8 port) {
+    if (HasPlayerName(port))
+    {
+      OverlayText& overlay = s_rio_overlay_text[type];
+      overlay.text = fmt::format("{}: {}", role, s_player_names[port]);
+      overlay.color = port_colors[port];
+    }
+  };
+
+  set_text(MessageType::CurrentBatter, state.golf ? "Golfer" : "Batter", state.batter_port);
+  set_text(MessageType::CurrentFielder, "Fielder", state.fielder_port);
+}
+
+static void UpdateBaseballCoordinatesText(const BaseballCoordinatesOverlay& state)
+{
+  // Hidden overlays keep their last text while they linger
+  if (!state.visible)
+    return;
+
+  const auto& [ball_x, ball_y, ball_z] = state.ball_position;
+  const auto& [ball_vel_x, ball_vel_y, ball_vel_z] = state.ball_velocity;
+  const auto& [ball_mph_x, ball_mph_y, ball_mph_z] = state.ball_velocity_mph;
+  s_rio_overlay_text[MessageType::TrainingModeBallCoordinates] = {
+      fmt::format("Ball Coordinates:                \n"
+                  "X:  {}\n"
+                  "Y:  {}\n"
+                  "Z:  {}\n\n"
+                  "Ball Velocity:  \n"
+                  "X:  {} m/s  -->  {} mph\n"
+                  "Y:  {} m/s  -->  {} mph\n"
+                  "Z:  {} m/s  -->  {} mph\n"
+                  "Net:  {} m/s  -->  {} mph\n",
+                  ball_x, ball_y, ball_z, ball_vel_x, ball_mph_x, ball_vel_y, ball_mph_y,
+                  ball_vel_z, ball_mph_z, state.ball_net_velocity, state.ball_net_velocity_mph),
+      Color::CYAN};
+
+  const auto& [fielder_x, fielder_y, fielder_z] = state.fielder_position;
+  s_rio_overlay_text[MessageType::TrainingModeFielderCoordinates] = {
+      fmt::format("Fielder Coordinates:             \n"
+                  "X:  {}\n"
+                  "Y:  {}\n"
+                  "Z:  {}\n\n"
+                  "Fielder Velocity: \n"
+                  "X:  {} m/s  -->  {} mph\n"
+                  "Z:  {} m/s  -->  {} mph\n"
+                  "Net:  {} m/s  -->  {} mph",
+                  fielder_x, fielder_y, fielder_z, state.fielder_velocity_x,
+                  state.fielder_velocity_x_mph, state.fielder_velocity_z,
+                  state.fielder_velocity_z_mph, state.fielder_net_velocity,
+                  state.fielder_net_velocity_mph),
+      Color::CYAN};
+}
+
+static void UpdateGolfTrainingText(const GolfTrainingOverlay& state)
+{
+  if (!state.visible)
+    return;
+
+  const auto& [sim_x, sim_y, sim_z] = state.sim_line_endpoint;
+  s_rio_overlay_text[MessageType::TrainingModeGolfing] = {
+      fmt::format("Golf Training Mode:                    \n"
+                  "Distance to Hole:  {}\n"
+                  "Shot Aim Angle:  {}\n"
+                  "Vertical Adj:  {} / {}\n"
+                  "Horizontal Adj:  {} / {}\n"
+                  "Shot Accuracy:  {}\n"
+                  "Power Meter Accuracy:  {}\n"
+                  "Ball Sim Aim X:  {}\n"
+                  "Ball Sim Aim Y:  {}\n"
+                  "Ball Sim Aim Z:  {}\n",
+                  state.distance_to_hole, state.shot_aim_angle,
+                  state.pre_shot_vertical_adjustment, state.active_shot_vertical_adjustment,
+                  state.pre_shot_horizontal_adjustment, state.active_shot_horizontal_adjustment,
+                  state.shot_accuracy, state.power_meter_distance, sim_x, sim_y, sim_z)};
+}
+
+static void UpdateDraftTimerText(const DraftTimerOverlay& state)
+{
+  if (!state.visible)
+    return;
+
+  s_rio_overlay_text[MessageType::DraftTimer] = {
+      fmt::format("Draft:  {}:{:02}", state.seconds / 60, state.seconds % 60)};
+}
+
+static void MarkOverlayShown(MessageType type, bool shown, u64 now)
+{
+  const auto it = s_rio_overlay_text.find(type);
+  if (shown && it != s_rio_overlay_text.end())
+    it->second.shown_ms = now;
+}
+
+// Formats the text of the overlays whose state changed since the last frame. The text is kept
+// after an overlay stops lingering, so an unchanged state can bring it back after a pause.
+static void UpdateRioOverlay()
+{
+  const RioOverlayState* state = s_rio_overlay_mailbox.Receive();
+  const bool received = state != nullptr;
+  if (received || s_player_names_changed)
+  {
+    if (!state)
+      state = &s_rio_overlay_state;
+
+    if (s_player_names_changed || state->player_names != s_rio_overlay_state.player_names)
+      UpdatePlayerNamesText(state->player_names);
+    if (state->baseball_coordinates != s_rio_overlay_state.baseball_coordinates)
+      UpdateBaseballCoordinatesText(state->baseball_coordinates);
+    if (state->golf_training != s_rio_overlay_state.golf_training)
+      UpdateGolfTrainingText(state->golf_training);
+    if (state->draft_timer != s_rio_overlay_state.draft_timer)
+      UpdateDraftTimerText(state->draft_timer);
+
+    s_rio_overlay_state = *state;
+    s_player_names_changed = false;
+  }
+
+  // Nothing is published while emulation is paused, so the overlays go away like messages did
+  const u64 now = Common::Timer::NowMs();
+  if (received)
+  {
+    const RioOverlayState& shown = s_rio_overlay_state;
+    MarkOverlayShown(MessageType::CurrentBatter, HasPlayerName(shown.player_names.batter_port),
+                     now);
+    MarkOverlayShown(MessageType::CurrentFielder, HasPlayerName(shown.player_names.fielder_port),
+                     now);
+    MarkOverlayShown(MessageType::TrainingModeBallCoordinates, shown.baseball_coordinates.visible,
+                     now);
+    MarkOverlayShown(MessageType::TrainingModeFielderCoordinates,
+                     shown.baseball_coordinates.visible, now);
+    MarkOverlayShown(MessageType::TrainingModeGolfing, shown.golf_training.visible, now);
+    MarkOverlayShown(MessageType::DraftTimer, shown.draft_timer.visible, now);
+  }
+}
+
 void AddTypedMessage(MessageType type, std::string message, u32 ms, u32 argb,
                      std::unique_ptr<Icon> icon)
 {
@@ -147,6 +355,20 @@ void AddMessage(std::string message, u32 ms, u32 argb, std::unique_ptr<Icon> ico
   s_messages.emplace(MessageType::Typeless, Message(std::move(message), ms, argb, std::move(icon)));
 }
 
+void PublishRioOverlay(const RioOverlayState& state)
+{
+  s_rio_overlay_mailbox.Publish(state);
+}
+
+void SetPlayerNames(std::array<std::string, 4> names)
+{
+  std::lock_guard lock{s_messages_mutex};
+  if (names == s_player_names)
+    return;
+  s_player_names = std::move(names);
+  s_player_names_changed = true;
+}
+
 void DrawMessages()
 {
   const bool draw_messages = Config::Get(Config::MAIN_OSD_MESSAGES);
@@ -157,8 +379,29 @@ void DrawMessages()
 
   std::lock_guard lock{s_messages_mutex};
 
+  UpdateRioOverlay();
+
+  // The overlays are drawn in order of type, along with the typed messages
+  auto overlay_it = s_rio_overlay_text.begin();
+  const u64 now = Common::Timer::NowMs();
+  const auto draw_overlays_up_to = [&](MessageType type) {
+    for (; overlay_it != s_rio_overlay_text.end() && overlay_it->first <= type; ++overlay_it)
+    {
+      if (!draw_messages)
+        continue;
+
+      const u32 linger_time = GetOverlayLingerTime(overlay_it->first);
+      const s64 time_left = static_cast<s64>(overlay_it->second.shown_ms + linger_time - now);
+      if (time_left < 0)
+        continue;
+      current_y += DrawOverlayText(index++, overlay_it->second, ImVec2(current_x, current_y),
+                                   linger_time, time_left);
+    }
+  };
+
   for (auto it = s_messages.begin(); it != s_messages.end();)
   {
+    const MessageType type = it->first;
     Message& msg = it->second;
     if (msg.should_discard)
     {
@@ -180,15 +423,25 @@ void DrawMessages()
       ++it;
     }
 
+    draw_overlays_up_to(type);
     if (draw_messages)
       current_y += DrawMessage(index++, msg, ImVec2(current_x, current_y), time_left);
   }
+
+  draw_overlays_up_to(MessageType::Typeless);
 }
 
 void ClearMessages()
 {
   std::lock_guard lock{s_messages_mutex};
   s_messages.clear();
+
+  // Emulation has stopped, so nothing is publishing and this thread can take the last state
+  s_rio_overlay_mailbox.Receive();
+  s_rio_overlay_state = {};
+  s_player_names = {};
+  s_player_names_changed = false;
+  s_rio_overlay_text.clear();
 }
 
 void SetObscuredPixelsLeft(int width)
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <string>
@@ -17,6 +18,7 @@ enum class MessageType
   NetPlayPing,
   NetPlayBuffer,
   NetPlayDesync,
+  NetPlayTiming,
   CurrentFielder,
   CurrentBatter,
   TrainingModeFielderCoordinates,
@@ -62,6 +64,79 @@ void AddMessage(std::string message, u32 ms = Duration::SHORT, u32 argb = Color:
 void AddTypedMessage(MessageType type, std::string message, u32 ms = Duration::SHORT,
                      u32 argb = Color::YELLOW, std::unique_ptr<Icon> icon = nullptr);
 
+// Rio overlays that are shown while the game is in the right state, and linger for a moment after
+// like the messages they replaced. The CPU thread publishes the state every frame, and the video
+// thread only formats the text when it changed.
+struct PlayerNamesOverlay
+{
+  static constexpr u8 NO_PORT = 0xFF;
+
+  // Ports are 0-3. Nothing is shown for NO_PORT or ports without a name.
+  u8 batter_port = NO_PORT;
+  u8 fielder_port = NO_PORT;
+  // In Toadstool Tour, batter_port is the golfer
+  bool golf = false;
+
+  bool operator==(const PlayerNamesOverlay&) const = default;
+};
+
+struct BaseballCoordinatesOverlay
+{
+  bool visible = false;
+  std::array<float, 3> ball_position{};
+  // Velocities are in m/s, with the same in mph next to them
+  std::array<float, 3> ball_velocity{};
+  std::array<float, 3> ball_velocity_mph{};
+  float ball_net_velocity = 0;
+  float ball_net_velocity_mph = 0;
+  std::array<float, 3> fielder_position{};
+  float fielder_velocity_x = 0;
+  float fielder_velocity_x_mph = 0;
+  float fielder_velocity_z = 0;
+  float fielder_velocity_z_mph = 0;
+  float fielder_net_velocity = 0;
+  float fielder_net_velocity_mph = 0;
+
+  bool operator==(const BaseballCoordinatesOverlay&) const = default;
+};
+
+struct GolfTrainingOverlay
+{
+  bool visible = false;
+  float distance_to_hole = 0;
+  float shot_aim_angle = 0;
+  int pre_shot_vertical_adjustment = 0;
+  int active_shot_vertical_adjustment = 0;
+  int pre_shot_horizontal_adjustment = 0;
+  int active_shot_horizontal_adjustment = 0;
+  int shot_accuracy = 0;
+  u32 power_meter_distance = 0;
+  std::array<float, 3> sim_line_endpoint{};
+
+  bool operator==(const GolfTrainingOverlay&) const = default;
+};
+
+struct DraftTimerOverlay
+{
+  bool visible = false;
+  u32 seconds = 0;
+
+  bool operator==(const DraftTimerOverlay&) const = default;
+};
+
+struct RioOverlayState
+{
+  PlayerNamesOverlay player_names;
+  BaseballCoordinatesOverlay baseball_coordinates;
+  GolfTrainingOverlay golf_training;
+  DraftTimerOverlay draft_timer;
+};
+
+// Only call from the CPU thread. Replaces the state published before.
+void PublishRioOverlay(const RioOverlayState& state);
+// Names by port, the overlay is only updated if they changed
+void SetPlayerNames(std::array<std::string, 4> names);
+
 // Draw the current messages on the screen. Only call once per frame.
 void DrawMessages();
 void ClearMessages();
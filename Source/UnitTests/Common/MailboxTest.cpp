@@ -0,0 +1,57 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "Common/Mailbox.h"
+
+TEST(Mailbox, Simple)
+{
+  Common::Mailbox<u32> mailbox;
+  EXPECT_EQ(nullptr, mailbox.Receive());
+
+  mailbox.Publish(1);
+  const u32* value = mailbox.Receive();
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(1u, *value);
+  EXPECT_EQ(nullptr, mailbox.Receive());
+
+  // Only the latest value is kept
+  for (u32 i = 0; i < 10; ++i)
+    mailbox.Publish(i);
+  value = mailbox.Receive();
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(9u, *value);
+  EXPECT_EQ(nullptr, mailbox.Receive());
+}
+
+TEST(Mailbox, MultiThreaded)
+{
+  struct Value
+  {
+    u32 a = 0;
+    u32 b = 0;
+  };
+  Common::Mailbox<Value> mailbox;
+  constexpr u32 COUNT = 1000000;
+
+  std::thread producer([&] {
+    for (u32 i = 1; i <= COUNT; ++i)
+      mailbox.Publish({i, ~i});
+  });
+
+  // Values are never torn and never go back in time
+  u32 last = 0;
+  while (last != COUNT)
+  {
+    const Value* value = mailbox.Receive();
+    if (!value)
+      continue;
+    ASSERT_EQ(value->a, ~value->b);
+    ASSERT_GT(value->a, last);
+    last = value->a;
+  }
+
+  producer.join();
+}
@@ -0,0 +1,113 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "UICommon/GameDigestCache.h"
+
+using UICommon::GameDigestCache;
+
+class GameDigestCacheTest : public testing::Test
+{
+protected:
+  GameDigestCacheTest()
+      : m_dir(File::CreateTempDir()), m_game_path(m_dir + "/game.iso"),
+        m_cache_path(m_dir + "/gamedigest.cache")
+  {
+  }
+  ~GameDigestCacheTest() override { File::DeleteDirRecursively(m_dir); }
+
+  // Writes a game larger than one hashing chunk and returns its expected digest
+  std::string WriteGame(u8 seed)
+  {
+    std::vector<u8> data(20 * 1024 * 1024 + 123);
+    u32 state = seed;
+    for (u8& byte : data)
+    {
+      state = state * 1664525 + 1013904223;
+      byte = static_cast<u8>(state >> 24);
+    }
+
+    File::IOFile file(m_game_path, "wb");
+    EXPECT_TRUE(file.WriteBytes(data.data(), data.size()));
+    return fmt::format("{:02x}", fmt::join(Common::SHA1::CalculateDigest(data), ""));
+  }
+
+  const std::string m_dir;
+  const std::string m_game_path;
+  const std::string m_cache_path;
+};
+
+TEST_F(GameDigestCacheTest, ComputeDigest)
+{
+  const std::string expected = WriteGame(1);
+
+  int last_progress = -1;
+  EXPECT_EQ(GameDigestCache::ComputeDigest(m_game_path,
+                                           [&](int progress) {
+                                             EXPECT_GE(progress, last_progress);
+                                             last_progress = progress;
+                                             return true;
+                                           }),
+            expected);
+  EXPECT_EQ(last_progress, 100);
+}
+
+TEST_F(GameDigestCacheTest, CancelComputeDigest)
+{
+  WriteGame(2);
+  EXPECT_EQ(GameDigestCache::ComputeDigest(m_game_path, [](int) { return false; }), "");
+}
+
+TEST_F(GameDigestCacheTest, DigestIsCached)
+{
+  const std::string expected = WriteGame(3);
+
+  GameDigestCache cache(m_cache_path);
+  EXPECT_FALSE(cache.Get(m_game_path));
+  EXPECT_EQ(cache.GetOrCompute(m_game_path, {}), expected);
+  EXPECT_EQ(cache.Get(m_game_path), expected);
+
+  // Only written when saved
+  EXPECT_FALSE(File::Exists(m_cache_path));
+  ASSERT_TRUE(cache.Save());
+
+  GameDigestCache loaded(m_cache_path);
+  ASSERT_TRUE(loaded.Load());
+  EXPECT_EQ(loaded.Get(m_game_path), expected);
+}
+
+TEST_F(GameDigestCacheTest, ChangedGameIsHashedAgain)
+{
+  WriteGame(4);
+  GameDigestCache cache(m_cache_path);
+  ASSERT_FALSE(cache.GetOrCompute(m_game_path, {}).empty());
+
+  const std::string expected = WriteGame(5);
+  EXPECT_FALSE(cache.Get(m_game_path));
+  EXPECT_EQ(cache.GetOrCompute(m_game_path, {}), expected);
+}
+
+TEST_F(GameDigestCacheTest, MissingGamesAreForgotten)
+{
+  WriteGame(6);
+  {
+    GameDigestCache cache(m_cache_path);
+    ASSERT_FALSE(cache.GetOrCompute(m_game_path, {}).empty());
+    ASSERT_TRUE(cache.Save());
+  }
+
+  File::Delete(m_game_path);
+  GameDigestCache cache(m_cache_path);
+  ASSERT_TRUE(cache.Load());
+  EXPECT_FALSE(cache.Get(m_game_path));
+}
@@ -0,0 +1,289 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MemoryWatcher.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+constexpr int BENCHMARK_FRAMES = 1000;
+constexpr u32 RING_CAPACITY = 4096;
+}  // namespace
+
+class MemoryWatcherTest : public testing::Test
+{
+protected:
+  MemoryWatcherTest() : m_profile_path(File::CreateTempDir())
+  {
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+
+    auto& system = Core::System::GetInstance();
+    system.GetMemory().Init();
+
+    // Map 0x80000000 onto MEM1 the same way the IPL does, with translation on
+    auto& ppc_state = system.GetPPCState();
+    ppc_state.spr[SPR_DBAT0U] = 0x80001fff;
+    ppc_state.spr[SPR_DBAT0L] = 0x00000002;
+    ppc_state.spr[SPR_IBAT0U] = 0x80001fff;
+    ppc_state.spr[SPR_IBAT0L] = 0x00000002;
+    system.GetMMU().DBATUpdated();
+    system.GetMMU().IBATUpdated();
+    ppc_state.msr.DR = 1;
+    ppc_state.m_enable_dcache = false;
+
+    m_locations_path = m_profile_path + DIR_SEP "Locations.txt";
+    m_socket_path = m_profile_path + DIR_SEP "MemoryWatcher";
+    m_ring_path = m_profile_path + DIR_SEP "MemoryWatcher.ring";
+
+    m_socket = socket(AF_UNIX, SOCK_DGRAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, m_socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    bind(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  }
+
+  ~MemoryWatcherTest() override
+  {
+    close(m_socket);
+
+    auto& system = Core::System::GetInstance();
+    system.GetPPCState().msr.DR = 0;
+    system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  std::unique_ptr<MemoryWatcher> MakeWatcher(const std::vector<std::string>& locations,
+                                             bool binary, bool ring = false)
+  {
+    std::string file;
+    for (const std::string& line : locations)
+      file += line + "\n";
+    File::WriteStringToFile(m_locations_path, file);
+
+    auto watcher = std::make_unique<MemoryWatcher>(
+        m_locations_path, m_socket_path,
+        MemoryWatcher::Options{binary, ring ? m_ring_path : std::string(), RING_CAPACITY});
+    EXPECT_TRUE(watcher->IsRunning());
+    return watcher;
+  }
+
+  void Write(u32 address, u32 value)
+  {
+    Core::CPUThreadGuard guard(Core::System::GetInstance());
+    PowerPC::MMU::HostWrite_U32(guard, value, address);
+  }
+
+  void Step(MemoryWatcher& watcher)
+  {
+    Core::CPUThreadGuard guard(Core::System::GetInstance());
+    watcher.Step(guard);
+  }
+
+  // Next datagram, nothing if none was sent
+  std::optional<std::vector<u8>> Receive()
+  {
+    std::vector<u8> datagram(65536);
+    const ssize_t size = recv(m_socket, datagram.data(), datagram.size(), MSG_DONTWAIT);
+    if (size < 0)
+      return std::nullopt;
+    datagram.resize(size);
+    return datagram;
+  }
+
+  std::optional<std::vector<u32>> ReceivePacket()
+  {
+    const std::optional<std::vector<u8>> datagram = Receive();
+    if (!datagram)
+      return std::nullopt;
+    std::vector<u32> packet(datagram->size() / sizeof(u32));
+    std::memcpy(packet.data(), datagram->data(), packet.size() * sizeof(u32));
+    return packet;
+  }
+
+  std::string m_profile_path;
+  std::string m_locations_path;
+  std::string m_socket_path;
+  std::string m_ring_path;
+  int m_socket = -1;
+};
+
+TEST_F(MemoryWatcherTest, BinaryPacketHasOnlyChanges)
+{
+  Write(0x80001000, 0x11);
+  Write(0x80001004, 0x22);
+  auto watcher = MakeWatcher({"80001000", "80001004"}, true);
+
+  Step(*watcher);
+  EXPECT_EQ(ReceivePacket(), (std::vector<u32>{1, 2, 0, 0x11, 1, 0x22}));
+
+  // Nothing changed, nothing sent
+  Step(*watcher);
+  EXPECT_FALSE(Receive());
+
+  Write(0x80001004, 0x33);
+  Step(*watcher);
+  EXPECT_EQ(ReceivePacket(), (std::vector<u32>{3, 1, 1, 0x33}));
+}
+
+TEST_F(MemoryWatcherTest, TextFormat)
+{
+  Write(0x80001000, 0xAB);
+  auto watcher = MakeWatcher({"80001000", "80001004"}, false);
+
+  Step(*watcher);
+  const std::string expected = "80001000\nab\n";
+  EXPECT_EQ(Receive(), std::vector<u8>(expected.c_str(), expected.c_str() + expected.size() + 1));
+
+  // A datagram every frame, empty when nothing changed
+  Step(*watcher);
+  EXPECT_EQ(Receive(), std::vector<u8>(1, 0));
+}
+
+TEST_F(MemoryWatcherTest, TextFormatIsSortedByAddress)
+{
+  Write(0x80001000, 0x1);
+  Write(0x80001004, 0x2);
+  auto watcher = MakeWatcher({"80001004", "80001000"}, false);
+
+  Step(*watcher);
+  const std::string expected = "80001000\n1\n80001004\n2\n";
+  EXPECT_EQ(Receive(), std::vector<u8>(expected.c_str(), expected.c_str() + expected.size() + 1));
+}
+
+TEST_F(MemoryWatcherTest, FollowsPointerChains)
+{
+  Write(0x80002000, 0x80003000);
+  Write(0x80003008, 0x55);
+  Write(0x8000300C, 0x66);
+  auto watcher = MakeWatcher({"80002000 8", "80002000 C", "80002000"}, true);
+
+  // The shared base is read once
+  EXPECT_EQ(watcher->GetNumWatches(), 3u);
+  EXPECT_EQ(watcher->GetNumReads(), 3u);
+
+  Step(*watcher);
+  EXPECT_EQ(ReceivePacket(), (std::vector<u32>{1, 3, 0, 0x55, 1, 0x66, 2, 0x80003000}));
+
+  // The base moved
+  Write(0x80002000, 0x80004000);
+  Write(0x80004008, 0x77);
+  Write(0x8000400C, 0x66);
+  Step(*watcher);
+  EXPECT_EQ(ReceivePacket(), (std::vector<u32>{2, 2, 0, 0x77, 2, 0x80004000}));
+
+  // Not a pointer any more, the chain stops there
+  Write(0x80002000, 0x1234);
+  Step(*watcher);
+  EXPECT_EQ(ReceivePacket(), (std::vector<u32>{3, 3, 0, 0x1234, 1, 0x1234, 2, 0x1234}));
+}
+
+TEST_F(MemoryWatcherTest, WritesRing)
+{
+  auto watcher = MakeWatcher({"80001000"}, false, true);
+
+  File::IOFile ring(m_ring_path, "rb");
+  ASSERT_TRUE(ring.IsOpen());
+  const size_t ring_size = ring.GetSize();
+  ring.Close();
+  ASSERT_EQ(ring_size, 64 + RING_CAPACITY);
+
+  // Enough frames to wrap around the ring a few times
+  constexpr u32 frames = 1000;
+  for (u32 i = 1; i <= frames; ++i)
+  {
+    Write(0x80001000, i);
+    Step(*watcher);
+    Receive();
+  }
+
+  std::string data;
+  ASSERT_TRUE(File::ReadFileToString(m_ring_path, data));
+  EXPECT_EQ(data.substr(0, 4), "MWRG");
+
+  u64 write_pos;
+  std::memcpy(&write_pos, &data[16], sizeof(write_pos));
+  constexpr u32 record_size = 4 + 4 * sizeof(u32);
+  EXPECT_EQ(write_pos, u64(frames) * record_size);
+
+  // Last record
+  const auto read = [&](u64 pos) {
+    u32 value;
+    for (size_t i = 0; i < sizeof(value); ++i)
+      reinterpret_cast<u8*>(&value)[i] = data[64 + (pos + i) % RING_CAPACITY];
+    return value;
+  };
+  const u64 last = write_pos - record_size;
+  EXPECT_EQ(read(last), 4 * sizeof(u32));
+  EXPECT_EQ(read(last + 4), frames);
+  EXPECT_EQ(read(last + 8), 1u);
+  EXPECT_EQ(read(last + 12), 0u);
+  EXPECT_EQ(read(last + 16), frames);
+}
+
+TEST_F(MemoryWatcherTest, Benchmark)
+{
+  using Clock = std::chrono::steady_clock;
+
+  for (int num_watches : {10, 100, 500})
+  {
+    // Half direct addresses, half through one of a few pointers
+    std::vector<std::string> locations;
+    for (int i = 0; i < num_watches; ++i)
+    {
+      if (i % 2 == 0)
+        locations.push_back(fmt::format("{:x}", 0x80010000 + i * 4));
+      else
+        locations.push_back(fmt::format("{:x} {:x}", 0x80002000 + (i % 8) * 4, i * 4));
+    }
+    for (u32 i = 0; i < 8; ++i)
+      Write(0x80002000 + i * 4, 0x80020000 + i * 0x1000);
+
+    auto watcher = MakeWatcher(locations, true);
+    Clock::duration elapsed{};
+    for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+    {
+      // A tenth of the values change every frame
+      for (int i = 0; i < num_watches / 10; ++i)
+        Write(0x80010000 + ((frame + i * 10) % num_watches) * 4, frame);
+
+      const auto start = Clock::now();
+      Step(*watcher);
+      elapsed += Clock::now() - start;
+      Receive();
+    }
+
+    fmt::print(stderr, "{} watches ({} reads): {} ns/frame\n", num_watches, watcher->GetNumReads(),
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() /
+                   BENCHMARK_FRAMES);
+  }
+}
@@ -0,0 +1,201 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/MovieStream.h"
+
+namespace
+{
+Movie::DTMHeader MakeHeader(u64 frame_count)
+{
+  Movie::DTMHeader header{};
+  header.filetype = {'D', 'T', 'M', 0x1A};
+  header.frameCount = frame_count;
+  return header;
+}
+
+std::vector<u8> MakeInput(size_t size, u8 seed)
+{
+  std::vector<u8> input(size);
+  for (size_t i = 0; i < size; ++i)
+    input[i] = static_cast<u8>(seed + i);
+  return input;
+}
+
+// Compresses a little, like a savestate
+std::vector<u8> MakeState(size_t size, u32 seed)
+{
+  std::vector<u8> state(size);
+  std::mt19937 rng(seed);
+  for (u8& byte : state)
+    byte = static_cast<u8>(rng() % 16);
+  return state;
+}
+
+class MovieStreamTest : public testing::Test
+{
+protected:
+  MovieStreamTest() : m_dir(File::CreateTempDir() + DIR_SEP), m_path(m_dir + "recording.dtm") {}
+  ~MovieStreamTest() override { File::DeleteDirRecursively(m_dir); }
+
+  // What a DTM reader sees
+  void ReadDTM(Movie::DTMHeader* header, std::vector<u8>* input) const
+  {
+    File::IOFile file(m_path, "rb");
+    ASSERT_TRUE(file.ReadArray(header, 1));
+    input->resize(file.GetSize() - sizeof(Movie::DTMHeader));
+    ASSERT_TRUE(file.ReadBytes(input->data(), input->size()));
+  }
+
+  std::vector<u64> GetKeyframeFrames() const
+  {
+    std::vector<u64> frames;
+    const auto keyframes = Movie::DTMKeyframes::Open(Movie::GetKeyframePath(m_path));
+    if (keyframes)
+    {
+      for (const Movie::DTMKeyframes::Keyframe& keyframe : keyframes->GetKeyframes())
+        frames.push_back(keyframe.frame);
+    }
+    return frames;
+  }
+
+  std::string m_dir;
+  std::string m_path;
+};
+}  // namespace
+
+TEST_F(MovieStreamTest, FileIsAlwaysAValidDTM)
+{
+  Movie::DTMStreamWriter writer;
+  std::vector<u8> input = MakeInput(800, 1);
+  writer.Start(m_path, MakeHeader(100), input);
+  writer.Flush();
+
+  Movie::DTMHeader header;
+  std::vector<u8> read_input;
+  ReadDTM(&header, &read_input);
+  EXPECT_EQ(header.frameCount, 100u);
+  EXPECT_EQ(read_input, input);
+
+  for (u8 i = 0; i < 5; ++i)
+  {
+    const std::vector<u8> more = MakeInput(160, i);
+    input.insert(input.end(), more.begin(), more.end());
+    writer.Append(MakeHeader(120 + i * 20), more);
+  }
+  writer.Flush();
+  ReadDTM(&header, &read_input);
+  EXPECT_EQ(header.frameCount, 200u);
+  EXPECT_EQ(read_input, input);
+
+  // Going back with a savestate writes the shorter recording
+  input.resize(400);
+  writer.Start(m_path, MakeHeader(50), input, 50);
+  writer.Stop();
+  writer.Flush();
+  ReadDTM(&header, &read_input);
+  EXPECT_EQ(header.frameCount, 50u);
+  EXPECT_EQ(read_input, input);
+
+  // Nothing is written once stopped
+  writer.Append(MakeHeader(60), MakeInput(8, 0));
+  writer.Flush();
+  ReadDTM(&header, &read_input);
+  EXPECT_EQ(read_input, input);
+}
+
+TEST_F(MovieStreamTest, FindsKeyframes)
+{
+  Movie::DTMStreamWriter writer;
+  writer.Start(m_path, MakeHeader(0), {});
+  std::vector<std::vector<u8>> states;
+  for (u32 i = 0; i < 4; ++i)
+  {
+    // Some bigger than a chunk
+    states.push_back(MakeState(1000 * 1000 + i * 300 * 1000, i));
+    writer.AddKeyframe(i * 100, states.back());
+  }
+  writer.Flush();
+
+  const auto keyframes = Movie::DTMKeyframes::Open(Movie::GetKeyframePath(m_path));
+  ASSERT_TRUE(keyframes);
+  ASSERT_EQ(keyframes->GetKeyframes().size(), 4u);
+
+  EXPECT_EQ(keyframes->Find(0)->frame, 0u);
+  EXPECT_EQ(keyframes->Find(99)->frame, 0u);
+  EXPECT_EQ(keyframes->Find(100)->frame, 100u);
+  EXPECT_EQ(keyframes->Find(250)->frame, 200u);
+  EXPECT_EQ(keyframes->Find(100000)->frame, 300u);
+
+  for (u32 i = 0; i < 4; ++i)
+  {
+    const auto state = keyframes->Load(*keyframes->Find(i * 100));
+    ASSERT_TRUE(state);
+    EXPECT_EQ(*state, states[i]);
+  }
+}
+
+TEST_F(MovieStreamTest, GoingBackDropsLaterKeyframes)
+{
+  Movie::DTMStreamWriter writer;
+  writer.Start(m_path, MakeHeader(0), {});
+  for (u64 frame = 0; frame < 400; frame += 100)
+    writer.AddKeyframe(frame, MakeState(1000, 0));
+  writer.Flush();
+  EXPECT_EQ(GetKeyframeFrames(), (std::vector<u64>{0, 100, 200, 300}));
+
+  writer.Start(m_path, MakeHeader(150), MakeInput(80, 0), 150);
+  writer.AddKeyframe(180, MakeState(1000, 1));
+  writer.Flush();
+  EXPECT_EQ(GetKeyframeFrames(), (std::vector<u64>{0, 100, 180}));
+
+  // A new recording starts over
+  writer.Stop();
+  writer.Start(m_path, MakeHeader(0), {}, 150);
+  writer.AddKeyframe(10, MakeState(1000, 2));
+  writer.Flush();
+  EXPECT_EQ(GetKeyframeFrames(), std::vector<u64>{10});
+}
+
+TEST_F(MovieStreamTest, IgnoresCutOffKeyframe)
+{
+  Movie::DTMStreamWriter writer;
+  writer.Start(m_path, MakeHeader(0), {});
+  writer.AddKeyframe(0, MakeState(100 * 1000, 0));
+  writer.AddKeyframe(60, MakeState(100 * 1000, 1));
+  writer.Stop();
+  writer.Flush();
+
+  const auto keyframes = Movie::DTMKeyframes::Open(Movie::GetKeyframePath(m_path));
+  ASSERT_TRUE(keyframes);
+  ASSERT_EQ(keyframes->GetKeyframes().size(), 2u);
+  const Movie::DTMKeyframes::Keyframe& last = keyframes->GetKeyframes().back();
+
+  // Like a crash while the last keyframe was written
+  {
+    File::IOFile file(Movie::GetKeyframePath(m_path), "r+b");
+    ASSERT_TRUE(file.Resize(last.offset + last.compressed_size / 2));
+  }
+  EXPECT_EQ(GetKeyframeFrames(), std::vector<u64>{0});
+
+  {
+    File::IOFile file(Movie::GetKeyframePath(m_path), "r+b");
+    ASSERT_TRUE(file.Resize(last.offset - 10));
+  }
+  EXPECT_EQ(GetKeyframeFrames(), std::vector<u64>{0});
+
+  // Not keyframes at all
+  {
+    File::IOFile file(Movie::GetKeyframePath(m_path), "wb");
+    file.WriteString("DTM\x1a not keyframes");
+  }
+  EXPECT_FALSE(Movie::DTMKeyframes::Open(Movie::GetKeyframePath(m_path)));
+}
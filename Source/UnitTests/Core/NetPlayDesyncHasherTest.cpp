@@ -0,0 +1,213 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayDesyncHasher.h"
+
+using NetPlay::DesyncBisector;
+using NetPlay::DesyncHasher;
+
+namespace
+{
+// 24 MiB, the size of GameCube MEM1
+constexpr u32 RAM_SIZE = 0x1800000;
+
+std::vector<u8> MakeRam()
+{
+  std::vector<u8> ram(RAM_SIZE);
+  for (u32 i = 0; i < RAM_SIZE; ++i)
+    ram[i] = static_cast<u8>(i * 7 + (i >> 13));
+  return ram;
+}
+
+// Steps hasher through frames [first, last), returns the last closed round
+const DesyncHasher::Round* StepFrames(DesyncHasher& hasher, const std::vector<u8>& ram, u64 first,
+                                      u64 last)
+{
+  const DesyncHasher::Round* closed = nullptr;
+  for (u64 frame = first; frame < last; ++frame)
+  {
+    if (const DesyncHasher::Round* round = hasher.Step(frame, ram.data()))
+      closed = round;
+  }
+  return closed;
+}
+
+// Runs the request/answer exchange between two bisectors until local has a result
+std::optional<DesyncBisector::Result> Bisect(DesyncBisector& local, const DesyncHasher& remote)
+{
+  for (int i = 0; i < 16; ++i)
+  {
+    if (auto result = local.TakeResult())
+      return result;
+
+    const auto request = local.TakeRequest();
+    if (!request)
+      return std::nullopt;
+    const auto children = remote.GetChildren(request->round, request->level, request->index);
+    local.OnRemoteChildren(request->round, request->level, request->index,
+                           children.value_or(std::vector<u64>{}));
+  }
+  return std::nullopt;
+}
+}  // namespace
+
+TEST(NetPlayDesyncHasher, RoundsCoverAllPages)
+{
+  const std::vector<u8> ram = MakeRam();
+  DesyncHasher hasher(RAM_SIZE);
+  EXPECT_EQ(hasher.GetNumPages(), RAM_SIZE / DesyncHasher::PAGE_SIZE);
+  EXPECT_EQ(hasher.GetFramesPerRound(), hasher.GetNumPages() / DesyncHasher::PAGES_PER_FRAME);
+
+  const u32 frames = hasher.GetFramesPerRound();
+  EXPECT_EQ(StepFrames(hasher, ram, 0, frames - 1), nullptr);
+  const DesyncHasher::Round* round = hasher.Step(frames - 1, ram.data());
+  ASSERT_NE(round, nullptr);
+  EXPECT_EQ(round->id, 0u);
+  EXPECT_EQ(round->first_frame, 0u);
+  EXPECT_EQ(round->levels[0].size(), hasher.GetNumPages());
+  EXPECT_EQ(round->levels.back().size(), 1u);
+
+  // The same RAM hashes the same way every round
+  const u64 root = round->GetRoot();
+  round = StepFrames(hasher, ram, frames, frames * 2);
+  ASSERT_NE(round, nullptr);
+  EXPECT_EQ(round->id, 1u);
+  EXPECT_EQ(round->GetRoot(), root);
+}
+
+TEST(NetPlayDesyncHasher, PartialRoundIsDropped)
+{
+  const std::vector<u8> ram = MakeRam();
+  DesyncHasher hasher(RAM_SIZE);
+  const u32 frames = hasher.GetFramesPerRound();
+
+  // Joined in the middle of round 0, only round 1 is complete
+  EXPECT_EQ(StepFrames(hasher, ram, frames / 2, frames), nullptr);
+  EXPECT_EQ(hasher.GetRound(0), nullptr);
+
+  // A skipped frame drops the round too
+  EXPECT_EQ(StepFrames(hasher, ram, frames, frames + 3), nullptr);
+  EXPECT_EQ(StepFrames(hasher, ram, frames + 4, frames * 2), nullptr);
+  EXPECT_EQ(hasher.GetRound(1), nullptr);
+
+  const DesyncHasher::Round* round = StepFrames(hasher, ram, frames * 2, frames * 3);
+  ASSERT_NE(round, nullptr);
+  EXPECT_EQ(round->id, 2u);
+}
+
+TEST(NetPlayDesyncHasher, RepeatedFrameIsSkipped)
+{
+  std::vector<u8> ram = MakeRam();
+  DesyncHasher hasher(RAM_SIZE);
+  const u32 frames = hasher.GetFramesPerRound();
+  const u64 root = StepFrames(hasher, ram, 0, frames)->GetRoot();
+
+  // Frames that run again keep their first hashes, even if RAM changed in between
+  StepFrames(hasher, ram, frames, frames + 5);
+  ram[0] ^= 1;
+  EXPECT_EQ(StepFrames(hasher, ram, frames + 4, frames + 5), nullptr);
+  EXPECT_EQ(StepFrames(hasher, ram, frames, frames + 1), nullptr);
+  ram[0] ^= 1;
+
+  const DesyncHasher::Round* round = StepFrames(hasher, ram, frames + 5, frames * 2);
+  ASSERT_NE(round, nullptr);
+  EXPECT_EQ(round->id, 1u);
+  EXPECT_EQ(round->GetRoot(), root);
+
+  // The frame that closed the round doesn't close it again
+  EXPECT_EQ(hasher.Step(frames * 2 - 1, ram.data()), nullptr);
+}
+
+TEST(NetPlayDesyncHasher, BisectionFindsChangedPage)
+{
+  std::vector<u8> ram_a = MakeRam();
+  std::vector<u8> ram_b = ram_a;
+  DesyncHasher hasher_a(RAM_SIZE);
+  DesyncHasher hasher_b(RAM_SIZE);
+  const u32 frames = hasher_a.GetFramesPerRound();
+
+  StepFrames(hasher_a, ram_a, 0, frames);
+  StepFrames(hasher_b, ram_b, 0, frames);
+  DesyncBisector bisector_a(hasher_a);
+  EXPECT_FALSE(bisector_a.OnRemoteRoot(0, hasher_b.GetRound(0)->GetRoot()));
+
+  // Diverge in two pages in the middle of round 1
+  constexpr u32 PAGE = 0x123;
+  ram_b[PAGE * DesyncHasher::PAGE_SIZE + 0x42] ^= 1;
+  ram_b[(PAGE + 2) * DesyncHasher::PAGE_SIZE] ^= 1;
+  StepFrames(hasher_a, ram_a, frames, frames * 2);
+  StepFrames(hasher_b, ram_b, frames, frames * 2);
+
+  EXPECT_TRUE(bisector_a.OnRemoteRoot(1, hasher_b.GetRound(1)->GetRoot()));
+  EXPECT_TRUE(bisector_a.HasDiverged());
+  EXPECT_EQ(bisector_a.GetDivergedRound(), 1u);
+
+  const std::optional<DesyncBisector::Result> result = Bisect(bisector_a, hasher_b);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->round, 1u);
+  EXPECT_EQ(result->first_frame, frames);
+  EXPECT_EQ(result->mismatched_groups, 1u);
+  ASSERT_EQ(result->pages.size(), 2u);
+  EXPECT_EQ(result->pages[0].page, PAGE);
+  EXPECT_EQ(result->pages[0].frame, frames + PAGE / DesyncHasher::PAGES_PER_FRAME);
+  EXPECT_EQ(result->pages[1].page, PAGE + 2);
+  EXPECT_NE(result->pages[0].local_hash, result->pages[0].remote_hash);
+
+  // Later rounds aren't compared again
+  EXPECT_FALSE(bisector_a.OnRemoteRoot(2, 0));
+}
+
+TEST(NetPlayDesyncHasher, EarlyRootsAreCheckedLater)
+{
+  std::vector<u8> ram_a = MakeRam();
+  std::vector<u8> ram_b = ram_a;
+  ram_b[0x10] ^= 0xff;
+  DesyncHasher hasher_a(RAM_SIZE);
+  DesyncHasher hasher_b(RAM_SIZE);
+  const u32 frames = hasher_a.GetFramesPerRound();
+
+  StepFrames(hasher_b, ram_b, 0, frames);
+  DesyncBisector bisector_a(hasher_a);
+  EXPECT_FALSE(bisector_a.OnRemoteRoot(0, hasher_b.GetRound(0)->GetRoot()));
+  EXPECT_FALSE(bisector_a.HasDiverged());
+
+  StepFrames(hasher_a, ram_a, 0, frames);
+  EXPECT_TRUE(bisector_a.CheckPendingRoots());
+
+  const std::optional<DesyncBisector::Result> result = Bisect(bisector_a, hasher_b);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->pages.size(), 1u);
+  EXPECT_EQ(result->pages[0].page, 0u);
+  EXPECT_EQ(result->pages[0].frame, 0u);
+}
+
+TEST(NetPlayDesyncHasher, MissingRemoteRoundEndsBisection)
+{
+  std::vector<u8> ram_a = MakeRam();
+  std::vector<u8> ram_b = ram_a;
+  ram_b[0x10] ^= 0xff;
+  DesyncHasher hasher_a(RAM_SIZE);
+  DesyncHasher hasher_b(RAM_SIZE);
+  const u32 frames = hasher_a.GetFramesPerRound();
+
+  StepFrames(hasher_a, ram_a, 0, frames);
+  StepFrames(hasher_b, ram_b, 0, frames);
+  const u64 remote_root = hasher_b.GetRound(0)->GetRoot();
+
+  // The peer moved on far enough to forget the round
+  StepFrames(hasher_b, ram_b, frames, frames * (DesyncHasher::HISTORY_ROUNDS + 2));
+  EXPECT_EQ(hasher_b.GetRound(0), nullptr);
+
+  DesyncBisector bisector_a(hasher_a);
+  EXPECT_TRUE(bisector_a.OnRemoteRoot(0, remote_root));
+  const std::optional<DesyncBisector::Result> result = Bisect(bisector_a, hasher_b);
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->pages.empty());
+  EXPECT_FALSE(bisector_a.IsBisecting());
+}
@@ -0,0 +1,88 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayLinkSimulator.h"
+
+using NetPlay::LinkConditions;
+using NetPlay::LinkShaper;
+
+namespace
+{
+std::vector<u8> Datagram(u8 id)
+{
+  return {id};
+}
+
+// Submits a datagram every millisecond and returns the ids in the order they come out
+std::vector<u8> RunShaper(LinkShaper& shaper, u8 count)
+{
+  std::vector<u8> received;
+  u64 now_us = 0;
+  for (u8 id = 0; id < count; ++id, now_us += 1000)
+  {
+    shaper.Submit(Datagram(id), now_us);
+    while (const std::optional<std::vector<u8>> datagram = shaper.PopReady(now_us))
+      received.push_back(datagram->front());
+  }
+  while (const std::optional<u64> release_us = shaper.GetNextReleaseUs())
+  {
+    while (const std::optional<std::vector<u8>> datagram = shaper.PopReady(*release_us))
+      received.push_back(datagram->front());
+  }
+  return received;
+}
+}  // namespace
+
+TEST(NetPlayLinkSimulator, Latency)
+{
+  LinkShaper shaper({.latency_ms = 30}, 0);
+  shaper.Submit(Datagram(1), 1000);
+
+  EXPECT_EQ(shaper.GetNextReleaseUs(), 31000u);
+  EXPECT_FALSE(shaper.PopReady(30999));
+  EXPECT_TRUE(shaper.PopReady(31000));
+  EXPECT_FALSE(shaper.GetNextReleaseUs());
+}
+
+TEST(NetPlayLinkSimulator, JitterKeepsOrder)
+{
+  LinkShaper shaper({.latency_ms = 30, .jitter_ms = 20}, 1);
+  const std::vector<u8> received = RunShaper(shaper, 200);
+
+  ASSERT_EQ(received.size(), 200u);
+  for (size_t i = 0; i < received.size(); ++i)
+    EXPECT_EQ(received[i], i);
+}
+
+TEST(NetPlayLinkSimulator, Loss)
+{
+  LinkShaper shaper({.loss = 0.25}, 2);
+  const std::vector<u8> received = RunShaper(shaper, 200);
+
+  EXPECT_EQ(received.size() + shaper.GetStats().dropped, 200u);
+  EXPECT_GT(shaper.GetStats().dropped, 25u);
+  EXPECT_LT(shaper.GetStats().dropped, 75u);
+}
+
+TEST(NetPlayLinkSimulator, Reorder)
+{
+  LinkShaper shaper({.latency_ms = 10, .reorder = 0.1}, 3);
+  const std::vector<u8> received = RunShaper(shaper, 200);
+
+  ASSERT_EQ(received.size(), 200u);
+  ASSERT_GT(shaper.GetStats().reordered, 0u);
+
+  size_t out_of_order = 0;
+  for (size_t i = 1; i < received.size(); ++i)
+  {
+    if (received[i] < received[i - 1])
+      ++out_of_order;
+  }
+  EXPECT_EQ(out_of_order, shaper.GetStats().reordered);
+}
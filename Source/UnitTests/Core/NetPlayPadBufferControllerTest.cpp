@@ -0,0 +1,120 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayPadBufferController.h"
+
+using NetPlay::PadBufferController;
+
+namespace
+{
+void AddPings(PadBufferController& controller, NetPlay::PlayerId pid, u32 rtt_ms, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+    controller.AddRttSample(pid, rtt_ms);
+}
+}  // namespace
+
+TEST(NetPlayPadBufferController, WaitsForSamples)
+{
+  PadBufferController controller;
+  EXPECT_FALSE(controller.Recommend(8));
+
+  AddPings(controller, 1, 0, PadBufferController::MIN_RTT_SAMPLES);
+  AddPings(controller, 2, 100, PadBufferController::MIN_RTT_SAMPLES - 1);
+  EXPECT_FALSE(controller.Recommend(8));
+
+  controller.AddRttSample(2, 100);
+  EXPECT_TRUE(controller.Recommend(8));
+}
+
+TEST(NetPlayPadBufferController, FollowsPingRule)
+{
+  PadBufferController controller;
+  AddPings(controller, 1, 0, 10);
+  AddPings(controller, 2, 120, 10);
+
+  const std::optional<PadBufferController::Decision> decision = controller.Recommend(8);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->buffer, 15u);
+  EXPECT_EQ(decision->rtt_ms, 120u);
+  EXPECT_EQ(decision->jitter_ms, 0u);
+
+  // Low pings keep the minimum
+  PadBufferController lan;
+  AddPings(lan, 1, 0, 10);
+  AddPings(lan, 2, 10, 10);
+  EXPECT_EQ(lan.Recommend(8)->buffer, PadBufferController::MIN_BUFFER);
+}
+
+TEST(NetPlayPadBufferController, TwoRemotePlayersAddUp)
+{
+  PadBufferController controller;
+  AddPings(controller, 1, 0, 10);
+  AddPings(controller, 2, 80, 10);
+  AddPings(controller, 3, 40, 10);
+
+  EXPECT_EQ(controller.Recommend(8)->buffer, 15u);
+
+  controller.RemovePlayer(3);
+  EXPECT_EQ(controller.Recommend(8)->buffer, 10u);
+}
+
+TEST(NetPlayPadBufferController, RareSpikesAreTolerated)
+{
+  PadBufferController controller(0.1);
+  AddPings(controller, 1, 0, 10);
+  // One spike in 30 samples is under the 10% target, five are over it
+  AddPings(controller, 2, 80, 29);
+  controller.AddRttSample(2, 400);
+  EXPECT_EQ(controller.Recommend(8)->rtt_ms, 80u);
+
+  AddPings(controller, 2, 400, 4);
+  EXPECT_EQ(controller.Recommend(8)->rtt_ms, 400u);
+}
+
+TEST(NetPlayPadBufferController, ArrivalJitterRaisesBuffer)
+{
+  PadBufferController controller;
+  AddPings(controller, 1, 0, 10);
+  AddPings(controller, 2, 80, 10);
+
+  // Pad data every 16 ms, every tenth one 40 ms late and the next one early
+  double time_ms = 0;
+  for (int i = 0; i < 200; ++i)
+  {
+    time_ms += i % 10 == 0 ? 56 : (i % 10 == 1 ? 0 : 16);
+    controller.AddPadArrival(2, time_ms);
+  }
+
+  const std::optional<PadBufferController::Decision> decision = controller.Recommend(8);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->jitter_ms, 40u);
+  EXPECT_EQ(decision->required_ms, 120u);
+  EXPECT_EQ(decision->buffer, 15u);
+
+  controller.ResetArrivals();
+  EXPECT_EQ(controller.Recommend(8)->jitter_ms, 0u);
+}
+
+TEST(NetPlayPadBufferController, LowersSlowly)
+{
+  PadBufferController controller;
+  AddPings(controller, 1, 0, 10);
+  AddPings(controller, 2, 200, 10);
+
+  const std::optional<PadBufferController::Decision> raise = controller.Decide(8);
+  ASSERT_TRUE(raise);
+  EXPECT_EQ(raise->buffer, 25u);
+  EXPECT_EQ(raise->previous_buffer, 8u);
+  EXPECT_FALSE(controller.Decide(25));
+
+  AddPings(controller, 2, 100, PadBufferController::RTT_SAMPLES);
+  EXPECT_EQ(controller.Decide(25)->buffer, 25 - PadBufferController::MAX_DECREASE);
+  // One off isn't worth a change
+  EXPECT_FALSE(controller.Decide(14));
+}
@@ -0,0 +1,142 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayRedundantPads.h"
+#include "InputCommon/GCPadStatus.h"
+
+using NetPlay::RedundantPadHistory;
+using NetPlay::RedundantPadReceiver;
+
+namespace
+{
+GCPadStatus MakeInput(u32 sequence)
+{
+  GCPadStatus status;
+  status.button = static_cast<u16>(sequence);
+  return status;
+}
+
+struct UnreliablePacket
+{
+  u32 first_sequence;
+  u8 repeated;
+  std::vector<GCPadStatus> inputs;
+};
+
+UnreliablePacket Send(RedundantPadHistory& history, u32 sequence)
+{
+  history.Push(MakeInput(sequence));
+  const u8 repeated = history.TakeRepeatedCount();
+  return {history.GetFirstSequence(), repeated,
+          {history.GetInputs().begin(), history.GetInputs().end()}};
+}
+
+// Feeds a packet to receiver, appends the inputs it let through to delivered
+void Receive(RedundantPadReceiver& receiver, const UnreliablePacket& packet,
+             std::vector<u16>& delivered)
+{
+  const size_t first_new = receiver.OnUnreliable(0, packet.first_sequence, packet.inputs.size(),
+                                                 packet.repeated);
+  for (size_t i = first_new; i < packet.inputs.size(); ++i)
+    delivered.push_back(packet.inputs[i].button);
+}
+}  // namespace
+
+TEST(NetPlayRedundantPads, HistoryRepeatsLastInputs)
+{
+  RedundantPadHistory history;
+  EXPECT_TRUE(history.IsEmpty());
+
+  UnreliablePacket packet = Send(history, 0);
+  EXPECT_EQ(packet.first_sequence, 0u);
+  EXPECT_EQ(packet.repeated, 0u);
+  EXPECT_EQ(packet.inputs.size(), 1u);
+
+  for (u32 sequence = 1; sequence < RedundantPadHistory::SIZE + 3; ++sequence)
+    packet = Send(history, sequence);
+  EXPECT_EQ(packet.first_sequence, 3u);
+  EXPECT_EQ(packet.repeated, RedundantPadHistory::SIZE - 1);
+  ASSERT_EQ(packet.inputs.size(), RedundantPadHistory::SIZE);
+  EXPECT_EQ(packet.inputs.front().button, 3u);
+  EXPECT_EQ(packet.inputs.back().button, RedundantPadHistory::SIZE + 2);
+
+  // Several inputs pushed for one packet are all fresh
+  history.Push(MakeInput(100));
+  history.Push(MakeInput(101));
+  EXPECT_EQ(history.TakeRepeatedCount(), RedundantPadHistory::SIZE - 2);
+}
+
+TEST(NetPlayRedundantPads, LostPacketsAreRecovered)
+{
+  RedundantPadHistory history;
+  RedundantPadReceiver receiver;
+  std::vector<u16> delivered;
+
+  for (u32 sequence = 0; sequence < 20; ++sequence)
+  {
+    const UnreliablePacket packet = Send(history, sequence);
+    // Every third packet is lost
+    if (sequence % 3 != 2)
+      Receive(receiver, packet, delivered);
+  }
+
+  // The reliable copies arrive later and are dropped
+  for (u32 sequence = 0; sequence < 20; ++sequence)
+    EXPECT_FALSE(receiver.OnReliable(0));
+
+  ASSERT_EQ(delivered.size(), 20u);
+  for (u16 i = 0; i < 20; ++i)
+    EXPECT_EQ(delivered[i], i);
+
+  const RedundantPadReceiver::Stats stats = receiver.GetStats();
+  EXPECT_EQ(stats.unreliable_first, 20u);
+  EXPECT_EQ(stats.reliable_first, 0u);
+  EXPECT_EQ(stats.recovered, 6u);
+  EXPECT_EQ(stats.gaps, 0u);
+}
+
+TEST(NetPlayRedundantPads, ReliableFillsGaps)
+{
+  RedundantPadHistory history;
+  RedundantPadReceiver receiver;
+  std::vector<u16> delivered;
+
+  const UnreliablePacket first = Send(history, 0);
+  Receive(receiver, first, delivered);
+
+  // More packets lost in a row than the history repeats
+  UnreliablePacket packet{};
+  for (u32 sequence = 1; sequence <= RedundantPadHistory::SIZE + 1; ++sequence)
+    packet = Send(history, sequence);
+  Receive(receiver, packet, delivered);
+  EXPECT_EQ(delivered.size(), 1u);
+
+  // The reliable channel delivers the missing ones, the rest of the next packet is new
+  EXPECT_FALSE(receiver.OnReliable(0));
+  EXPECT_TRUE(receiver.OnReliable(0));
+  EXPECT_TRUE(receiver.OnReliable(0));
+  Receive(receiver, Send(history, RedundantPadHistory::SIZE + 2), delivered);
+  EXPECT_EQ(delivered.size(), RedundantPadHistory::SIZE + 1);
+  EXPECT_EQ(delivered[1], 3u);
+
+  const RedundantPadReceiver::Stats stats = receiver.GetStats();
+  EXPECT_EQ(stats.gaps, 1u);
+  EXPECT_EQ(stats.reliable_first, 2u);
+  EXPECT_EQ(stats.unreliable_first, RedundantPadHistory::SIZE + 1);
+}
+
+TEST(NetPlayRedundantPads, ResetStartsOver)
+{
+  RedundantPadReceiver receiver;
+  EXPECT_TRUE(receiver.OnReliable(2));
+  EXPECT_EQ(receiver.OnUnreliable(2, 0, 2, 0), 1u);
+
+  receiver.Reset();
+  EXPECT_EQ(receiver.GetStats().reliable_first, 0u);
+  EXPECT_EQ(receiver.OnUnreliable(2, 0, 2, 0), 0u);
+}
@@ -0,0 +1,340 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayRollback.h"
+#include "Core/StateRing.h"
+#include "InputCommon/GCPadStatus.h"
+
+using NetPlay::RollbackSession;
+
+namespace
+{
+constexpr u64 FRAMES = 600;
+
+// The input player pad sends on frame, held for a few frames like a real player would
+GCPadStatus ScriptedInput(int pad, u64 frame)
+{
+  GCPadStatus status = RollbackSession::NeutralInput();
+  const u64 held = (frame + pad * 3) / (5 + pad * 2);
+  status.button = static_cast<u16>((held * 2654435761u) >> 20) & 0x1f7f;
+  status.stickX = static_cast<u8>(held * 37);
+  return status;
+}
+
+// Stands in for the emulated machine, a bit of RAM that every input is mixed into
+class TestGame
+{
+public:
+  TestGame() : m_ram(0x100000) {}
+
+  void RunFrame(const std::array<GCPadStatus, 2>& pads)
+  {
+    for (const GCPadStatus& pad : pads)
+    {
+      m_hash = (m_hash ^ pad.button ^ (u64(pad.stickX) << 16)) * 0x100000001b3;
+      m_ram[(m_hash >> 8) % m_ram.size()] ^= static_cast<u8>(m_hash);
+    }
+    ++m_frame;
+  }
+
+  void Save(std::vector<u8>& state) const
+  {
+    state.resize(sizeof(m_frame) + sizeof(m_hash) + m_ram.size());
+    std::memcpy(state.data(), &m_frame, sizeof(m_frame));
+    std::memcpy(state.data() + sizeof(m_frame), &m_hash, sizeof(m_hash));
+    std::memcpy(state.data() + sizeof(m_frame) + sizeof(m_hash), m_ram.data(), m_ram.size());
+  }
+
+  void Load(const std::vector<u8>& state)
+  {
+    std::memcpy(&m_frame, state.data(), sizeof(m_frame));
+    std::memcpy(&m_hash, state.data() + sizeof(m_frame), sizeof(m_hash));
+    std::memcpy(m_ram.data(), state.data() + sizeof(m_frame) + sizeof(m_hash), m_ram.size());
+  }
+
+  u64 GetFrame() const { return m_frame; }
+  u64 GetHash() const { return m_hash; }
+  bool operator==(const TestGame& other) const
+  {
+    return m_frame == other.m_frame && m_hash == other.m_hash && m_ram == other.m_ram;
+  }
+
+private:
+  u64 m_frame = 0;
+  u64 m_hash = 0xcbf29ce484222325;
+  std::vector<u8> m_ram;
+};
+
+struct InFlightInput
+{
+  u64 arrival_tick;
+  GCPadStatus status;
+};
+
+// One direction of the connection between the two clients
+using Link = std::deque<InFlightInput>;
+
+// A client playing pad local_pad against the other client on the other pad
+class LoopbackClient
+{
+public:
+  explicit LoopbackClient(int local_pad)
+      : m_local_pad(local_pad), m_remote_pad(1 - local_pad),
+        m_session({local_pad != 0, local_pad != 1, false, false})
+  {
+  }
+
+  // One tick of wall clock time. Receives what arrived, rolls back if needed, resimulates and runs
+  // up to one new frame
+  void Tick(u64 tick, u32 latency, Link& incoming, Link& outgoing, u64 last_frame)
+  {
+    while (!incoming.empty() && incoming.front().arrival_tick <= tick)
+    {
+      m_session.AddRemoteInput(m_remote_pad, incoming.front().status);
+      incoming.pop_front();
+    }
+    // Like the CPU thread, which can't be paused while it waits for input
+    if (!m_frame_started)
+      m_session.Rollback([this](State::StateRing& ring, u64 frame) { return Load(ring, frame); });
+
+    while (true)
+    {
+      if (!m_frame_started)
+      {
+        const bool resimulating = m_game.GetFrame() < m_frames_run;
+        if (!resimulating && m_frames_run == last_frame)
+          return;
+
+        m_session.TakeSnapshot([this](State::StateRing& ring, u64 frame) { Save(ring, frame); });
+
+        m_frame_live = m_session.BeginFrame();
+        EXPECT_EQ(m_frame_live, !resimulating);
+        EXPECT_EQ(m_session.GetFrame(), m_game.GetFrame());
+        if (m_frame_live)
+        {
+          const GCPadStatus status = ScriptedInput(m_local_pad, m_game.GetFrame());
+          m_session.SetLocalInput(m_local_pad, status);
+          outgoing.push_back({tick + latency, status});
+        }
+        m_frame_started = true;
+      }
+
+      std::array<GCPadStatus, 2> pads;
+      for (int pad = 0; pad < 2; ++pad)
+      {
+        const std::optional<GCPadStatus> status = m_session.GetInput(pad);
+        // Too far ahead, wait for the remote input like lockstep NetPlay would
+        if (!status)
+        {
+          ++m_stalled_ticks;
+          return;
+        }
+        pads[pad] = *status;
+      }
+
+      // The local input takes effect on the frame it was polled on
+      EXPECT_TRUE(RollbackSession::IsSameInput(
+          pads[m_local_pad], ScriptedInput(m_local_pad, m_game.GetFrame())));
+
+      m_game.RunFrame(pads);
+      m_frame_started = false;
+      CaptureFrame();
+      if (m_frame_live)
+      {
+        ++m_frames_run;
+        return;
+      }
+    }
+  }
+
+  const TestGame& GetGame() const { return m_game; }
+  const std::vector<u64>& GetConfirmedHashes() const { return m_confirmed_hashes; }
+  RollbackSession::Stats GetStats() const { return m_session.GetStats(); }
+  u64 GetStalledTicks() const { return m_stalled_ticks; }
+
+private:
+  struct CapturedFrame
+  {
+    u64 frame;
+    u64 input_frames;
+    u64 hash;
+  };
+
+  void Save(State::StateRing& ring, u64 frame)
+  {
+    ring.Capture(frame, {}, [this](std::vector<u8>& state) { m_game.Save(state); });
+  }
+
+  std::optional<u64> Load(State::StateRing& ring, u64 frame)
+  {
+    return ring.Restore(frame, {}, [this](std::vector<u8>& state) { m_game.Load(state); });
+  }
+
+  // Keeps frames until their input is confirmed, like the stat tracker does under rollback
+  void CaptureFrame()
+  {
+    const RollbackSession::Progress progress = m_session.GetProgress();
+    while (!m_captured.empty() && m_captured.back().frame >= m_game.GetFrame())
+      m_captured.pop_back();
+    m_captured.push_back({m_game.GetFrame(), progress.frames, m_game.GetHash()});
+
+    while (!m_captured.empty() && m_captured.front().input_frames <= progress.confirmed_frames)
+    {
+      m_confirmed_hashes.push_back(m_captured.front().hash);
+      m_captured.pop_front();
+    }
+  }
+
+  int m_local_pad;
+  int m_remote_pad;
+  RollbackSession m_session;
+  TestGame m_game;
+  u64 m_frames_run = 0;
+  bool m_frame_started = false;
+  bool m_frame_live = false;
+  u64 m_stalled_ticks = 0;
+  std::deque<CapturedFrame> m_captured;
+  std::vector<u64> m_confirmed_hashes;
+};
+
+struct LoopbackResult
+{
+  RollbackSession::Stats stats;
+  u64 stalled_ticks;
+  double microseconds_per_frame;
+};
+
+// Plays FRAMES frames on two clients with latency ticks between them, checks that both end up
+// where lockstep emulation with all input known up front would
+LoopbackResult RunLoopback(u32 latency)
+{
+  TestGame reference;
+  std::vector<u64> reference_hashes;
+  for (u64 frame = 0; frame < FRAMES; ++frame)
+  {
+    reference.RunFrame({ScriptedInput(0, frame), ScriptedInput(1, frame)});
+    reference_hashes.push_back(reference.GetHash());
+  }
+
+  LoopbackClient a(0);
+  LoopbackClient b(1);
+  Link a_to_b;
+  Link b_to_a;
+
+  const auto start = std::chrono::steady_clock::now();
+  u64 tick = 0;
+  for (; tick < FRAMES * 4 && !(a.GetGame() == reference && b.GetGame() == reference &&
+                                a_to_b.empty() && b_to_a.empty());
+       ++tick)
+  {
+    a.Tick(tick, latency, b_to_a, a_to_b, FRAMES);
+    b.Tick(tick, latency, a_to_b, b_to_a, FRAMES);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_TRUE(a.GetGame() == reference);
+  EXPECT_TRUE(b.GetGame() == reference);
+
+  // Confirmed frames come out once each, in order and with the real input. The last few wait
+  // for input that is never sent
+  for (const LoopbackClient* client : {&a, &b})
+  {
+    const std::vector<u64>& confirmed = client->GetConfirmedHashes();
+    EXPECT_GE(confirmed.size(), FRAMES - latency - 1);
+    EXPECT_LE(confirmed.size(), FRAMES);
+    EXPECT_TRUE(std::equal(confirmed.begin(), confirmed.end(), reference_hashes.begin()));
+  }
+
+  const RollbackSession::Stats stats = a.GetStats();
+  EXPECT_EQ(stats.frames, FRAMES);
+  return {stats, a.GetStalledTicks(),
+          std::chrono::duration<double, std::micro>(elapsed).count() / (FRAMES * 2)};
+}
+}  // namespace
+
+TEST(NetPlayRollback, SameTickInputRollsBackOneFrame)
+{
+  // The first client always runs its frame before the second one's input for it was sent
+  const LoopbackResult result = RunLoopback(0);
+  EXPECT_GT(result.stats.rollbacks, 0u);
+  EXPECT_EQ(result.stats.max_rollback_frames, 1u);
+  EXPECT_EQ(result.stalled_ticks, 0u);
+}
+
+TEST(NetPlayRollback, MispredictionsAreResimulated)
+{
+  for (u32 latency : {1u, 3u, RollbackSession::MAX_PREDICTION - 1})
+  {
+    const LoopbackResult result = RunLoopback(latency);
+    EXPECT_GT(result.stats.rollbacks, 0u);
+    EXPECT_GT(result.stats.mispredicted_inputs, 0u);
+    EXPECT_LE(result.stats.max_rollback_frames, latency + 1);
+    EXPECT_EQ(result.stalled_ticks, 0u);
+  }
+}
+
+TEST(NetPlayRollback, HighLatencyWaitsForInput)
+{
+  const LoopbackResult result = RunLoopback(RollbackSession::MAX_PREDICTION + 4);
+  EXPECT_GT(result.stalled_ticks, 0u);
+  EXPECT_LE(result.stats.max_rollback_frames, RollbackSession::MAX_PREDICTION + 1);
+}
+
+TEST(NetPlayRollback, PredictionRepeatsLastInput)
+{
+  RollbackSession session({false, true, false, false});
+  session.TakeSnapshot([](State::StateRing& ring, u64 frame) {
+    ring.Capture(frame, {}, [](std::vector<u8>& state) { state.assign(1, 0); });
+  });
+
+  GCPadStatus pressed = RollbackSession::NeutralInput();
+  pressed.button = 0x100;
+
+  ASSERT_TRUE(session.BeginFrame());
+  session.AddRemoteInput(1, pressed);
+  EXPECT_TRUE(RollbackSession::IsSameInput(*session.GetInput(1), pressed));
+
+  // Nothing arrived for frame 1 yet
+  ASSERT_TRUE(session.BeginFrame());
+  EXPECT_TRUE(RollbackSession::IsSameInput(*session.GetInput(1), pressed));
+  EXPECT_EQ(session.GetStats().predicted_inputs, 1u);
+
+  // Released on frame 1, the frame has to run again
+  EXPECT_TRUE(session.AddRemoteInput(1, RollbackSession::NeutralInput()));
+  bool loaded = false;
+  EXPECT_TRUE(session.Rollback([&](State::StateRing& ring, u64 frame) {
+    loaded = true;
+    return ring.Restore(frame, {}, [](std::vector<u8>&) {});
+  }));
+  EXPECT_TRUE(loaded);
+  EXPECT_FALSE(session.BeginFrame());
+  EXPECT_EQ(session.GetFrame(), 0u);
+}
+
+TEST(NetPlayRollback, Benchmark)
+{
+  for (u32 latency : {1u, 2u, 4u, 6u})
+  {
+    // Delay based NetPlay needs a pad buffer as long as the latency
+    const LoopbackResult result = RunLoopback(latency);
+    fmt::print(stderr,
+               "{} frames latency: input delay {} frames with the pad buffer, 0 with rollback. "
+               "{:.2f} resimulated frames per frame, {} rollbacks, longest {} frames, "
+               "{:.1f} us/frame\n",
+               latency, latency, double(result.stats.resimulated_frames) / result.stats.frames,
+               result.stats.rollbacks, result.stats.max_rollback_frames,
+               result.microseconds_per_frame);
+  }
+}
@@ -0,0 +1,159 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/NetPlaySyncBlocks.h"
+
+using namespace NetPlay;
+
+namespace
+{
+// Noise that doesn't compress, with the given block a copy of the first one
+std::vector<u8> MakeData(size_t size, u32 seed, size_t repeated_block = SIZE_MAX)
+{
+  std::vector<u8> data(size);
+  u32 state = seed;
+  for (size_t i = 0; i < size; ++i)
+  {
+    state = state * 1664525 + 1013904223;
+    data[i] = i / SYNC_BLOCK_SIZE == repeated_block ? data[i % SYNC_BLOCK_SIZE] :
+                                                       static_cast<u8>(state >> 24);
+  }
+  return data;
+}
+}  // namespace
+
+class NetPlaySyncBlocksTest : public testing::Test
+{
+protected:
+  NetPlaySyncBlocksTest() : m_store_path(File::CreateTempDir() + "/NetPlaySync/") {}
+  ~NetPlaySyncBlocksTest() override { File::DeleteDirRecursively(m_store_path); }
+
+  // Sends data to a client with the store at m_store_path and returns what it decoded
+  std::optional<std::vector<u8>> Sync(const std::vector<u8>& data, u64* sent_bytes = nullptr)
+  {
+    SyncBlockStore store(m_store_path);
+    const std::vector<SyncBlockDigest> digests = store.GetDigests();
+
+    SyncBlockEncoder encoder(m_cache, {digests.begin(), digests.end()});
+    sf::Packet packet;
+    if (!encoder.Encode(data.data(), data.size(), packet))
+      return std::nullopt;
+    if (sent_bytes)
+      *sent_bytes = encoder.GetSentBytes();
+
+    SyncBlockDecoder decoder(std::move(store));
+    return decoder.Decode(packet);
+  }
+
+  const std::string m_store_path;
+  SyncBlockCache m_cache;
+};
+
+TEST_F(NetPlaySyncBlocksTest, RoundTrip)
+{
+  for (const size_t size : {size_t(0), size_t(1), size_t(SYNC_BLOCK_SIZE),
+                            size_t(SYNC_BLOCK_SIZE * 3 + 123)})
+  {
+    const std::vector<u8> data = MakeData(size, 1);
+    EXPECT_EQ(Sync(data), data);
+  }
+}
+
+TEST_F(NetPlaySyncBlocksTest, OnlyChangedBlocksAreSent)
+{
+  std::vector<u8> data = MakeData(SYNC_BLOCK_SIZE * 16, 2);
+  u64 first_sent = 0;
+  ASSERT_EQ(Sync(data, &first_sent), data);
+
+  data[SYNC_BLOCK_SIZE * 5 + 10] ^= 0xff;
+  u64 second_sent = 0;
+  ASSERT_EQ(Sync(data, &second_sent), data);
+
+  EXPECT_LT(second_sent * 8, first_sent);
+}
+
+TEST_F(NetPlaySyncBlocksTest, RepeatedBlocksAreSentOnce)
+{
+  const std::vector<u8> data = MakeData(SYNC_BLOCK_SIZE * 3, 3, 2);
+  SyncBlockEncoder encoder(m_cache, {});
+  sf::Packet packet;
+  ASSERT_TRUE(encoder.Encode(data.data(), data.size(), packet));
+
+  const std::vector<u8> distinct(data.begin(), data.begin() + SYNC_BLOCK_SIZE * 2);
+  SyncBlockEncoder distinct_encoder(m_cache, {});
+  sf::Packet distinct_packet;
+  ASSERT_TRUE(distinct_encoder.Encode(distinct.data(), distinct.size(), distinct_packet));
+
+  EXPECT_EQ(encoder.GetSentBytes(),
+            distinct_encoder.GetSentBytes() + sizeof(SyncBlockDigest) + 1);
+
+  SyncBlockDecoder decoder(SyncBlockStore{m_store_path});
+  EXPECT_EQ(decoder.Decode(packet), data);
+}
+
+TEST_F(NetPlaySyncBlocksTest, MissingKnownBlocksAreSentAgain)
+{
+  const std::vector<u8> data = MakeData(SYNC_BLOCK_SIZE * 3, 4);
+  ASSERT_EQ(Sync(data), data);
+
+  // The client claims to have the blocks, then loses one and corrupts another
+  SyncBlockStore store(m_store_path);
+  const std::vector<SyncBlockDigest> digests = store.GetDigests();
+  ASSERT_EQ(digests.size(), 3u);
+  SyncBlockEncoder encoder(m_cache, {digests.begin(), digests.end()});
+  sf::Packet packet;
+  ASSERT_TRUE(encoder.Encode(data.data(), data.size(), packet));
+
+  const std::vector<File::FSTEntry> files = File::ScanDirectoryTree(m_store_path, false).children;
+  ASSERT_EQ(files.size(), 3u);
+  File::Delete(files[0].physicalName);
+  File::WriteStringToFile(files[1].physicalName, "corrupted");
+
+  SyncBlockDecoder decoder(std::move(store));
+  const sf::Packet original = packet;
+  EXPECT_FALSE(decoder.Decode(packet));
+  EXPECT_EQ(decoder.GetMissingBlocks().size(), 2u);
+
+  sf::Packet blocks;
+  ASSERT_TRUE(encoder.EncodeBlocks(decoder.GetMissingBlocks(), blocks));
+  ASSERT_TRUE(decoder.AddBlocks(blocks));
+  EXPECT_TRUE(decoder.GetMissingBlocks().empty());
+
+  packet = original;
+  EXPECT_EQ(decoder.Decode(packet), data);
+}
+
+TEST_F(NetPlaySyncBlocksTest, PruneKeepsSizeLimit)
+{
+  ASSERT_TRUE(Sync(MakeData(SYNC_BLOCK_SIZE * 8, 5)));
+
+  SyncBlockStore store(m_store_path, SYNC_BLOCK_SIZE * 3);
+  store.Prune();
+  EXPECT_EQ(store.GetDigests().size(), 3u);
+}
+
+TEST_F(NetPlaySyncBlocksTest, DigestInventory)
+{
+  const std::vector<SyncBlockDigest> digests = {SyncBlockDigest{1}, SyncBlockDigest{2}};
+  sf::Packet packet;
+  WriteSyncBlockDigests(packet, digests);
+
+  const std::optional<std::set<SyncBlockDigest>> read = ReadSyncBlockDigests(packet);
+  ASSERT_TRUE(read);
+  EXPECT_EQ(*read, std::set<SyncBlockDigest>(digests.begin(), digests.end()));
+
+  sf::Packet truncated;
+  truncated << u32{2};
+  EXPECT_FALSE(ReadSyncBlockDigests(truncated));
+}
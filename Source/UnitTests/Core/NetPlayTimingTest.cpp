@@ -0,0 +1,128 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayTiming.h"
+
+using NetPlay::TimingHistogram;
+using NetPlay::TimingRecorder;
+using NetPlay::TimingSummary;
+using EventType = NetPlay::TimingRecorder::EventType;
+
+TEST(NetPlayTiming, HistogramBuckets)
+{
+  TimingHistogram histogram;
+  for (u32 value : {0u, 1u, 2u, 3u, 4u, 255u, 256u, 100000u})
+    histogram.Add(value);
+
+  EXPECT_EQ(histogram.counts[0], 1u);
+  EXPECT_EQ(histogram.counts[1], 1u);
+  EXPECT_EQ(histogram.counts[2], 2u);
+  EXPECT_EQ(histogram.counts[3], 1u);
+  EXPECT_EQ(histogram.counts[8], 1u);
+  EXPECT_EQ(histogram.counts[TimingHistogram::BUCKETS - 1], 2u);
+  EXPECT_EQ(histogram.GetTotal(), 8u);
+
+  EXPECT_EQ(TimingHistogram::GetLabel(0), "0-1");
+  EXPECT_EQ(TimingHistogram::GetLabel(3), "4-8");
+  EXPECT_EQ(TimingHistogram::GetLabel(TimingHistogram::BUCKETS - 1), "256+");
+}
+
+TEST(NetPlayTiming, HistogramQuantile)
+{
+  TimingHistogram histogram;
+  EXPECT_EQ(histogram.GetQuantileBound(0.5), 256u);
+
+  for (int i = 0; i < 90; ++i)
+    histogram.Add(1);
+  for (int i = 0; i < 10; ++i)
+    histogram.Add(20);
+
+  EXPECT_EQ(histogram.GetQuantileBound(0.5), 2u);
+  EXPECT_EQ(histogram.GetQuantileBound(0.9), 2u);
+  EXPECT_EQ(histogram.GetQuantileBound(0.95), 32u);
+}
+
+TEST(NetPlayTiming, Summary)
+{
+  TimingRecorder recorder;
+  recorder.RecordAt(EventType::Frame, 0, 0, 0);
+  recorder.RecordAt(EventType::Stall, 0, 5000, 100);
+  recorder.RecordAt(EventType::Stall, 0, 1500, 200);
+  recorder.RecordAt(EventType::PadArrival, 1, 3, 0);
+  recorder.RecordAt(EventType::PadArrival, 1, 3, 16000);
+  recorder.RecordAt(EventType::PadArrival, 2, 3, 20000);
+  recorder.RecordAt(EventType::BufferDepth, 1, 6, 0);
+  recorder.RecordAt(EventType::HostPoll, 0, 0, 0);
+  recorder.RecordAt(EventType::GolfSwitch, 0, 0, 0);
+
+  TimingSummary summary = recorder.GetSummary();
+  EXPECT_EQ(summary.frames, 1u);
+  EXPECT_EQ(summary.stalls, 2u);
+  EXPECT_EQ(summary.stall_us, 6500u);
+  EXPECT_EQ(summary.max_stall_us, 5000u);
+  EXPECT_EQ(summary.stall_ms.counts[1], 1u);
+  EXPECT_EQ(summary.stall_ms.counts[3], 1u);
+  EXPECT_EQ(summary.pad_arrivals, 3u);
+  // Only the second arrival of pad 1 has an interval
+  EXPECT_EQ(summary.arrival_interval_ms.GetTotal(), 1u);
+  EXPECT_EQ(summary.arrival_interval_ms.counts[5], 1u);
+  EXPECT_EQ(summary.buffer_depth.counts[3], 1u);
+  EXPECT_EQ(summary.host_polls, 1u);
+  EXPECT_EQ(summary.golf_switches, 1u);
+  EXPECT_EQ(summary.dropped_events, 0u);
+
+  // Totals carry over until a reset
+  recorder.RecordAt(EventType::Frame, 0, 0, 0);
+  EXPECT_EQ(recorder.GetSummary().frames, 2u);
+
+  recorder.Reset();
+  recorder.RecordAt(EventType::PadArrival, 1, 3, 32000);
+  summary = recorder.GetSummary();
+  EXPECT_EQ(summary.frames, 0u);
+  EXPECT_EQ(summary.pad_arrivals, 1u);
+  EXPECT_EQ(summary.arrival_interval_ms.GetTotal(), 0u);
+}
+
+TEST(NetPlayTiming, OverwrittenEventsAreDropped)
+{
+  TimingRecorder recorder;
+  for (size_t i = 0; i < TimingRecorder::RING_SIZE + 100; ++i)
+    recorder.RecordAt(EventType::Frame, 0, 0, i);
+
+  const TimingSummary summary = recorder.GetSummary();
+  EXPECT_EQ(summary.frames, TimingRecorder::RING_SIZE);
+  EXPECT_EQ(summary.dropped_events, 100u);
+}
+
+TEST(NetPlayTiming, ConcurrentWriters)
+{
+  static constexpr size_t EVENTS = 1000;
+
+  TimingRecorder recorder;
+  std::vector<std::thread> writers;
+  for (size_t thread = 0; thread < 4; ++thread)
+  {
+    writers.emplace_back([&recorder] {
+      for (size_t i = 0; i < EVENTS; ++i)
+        recorder.Record(EventType::HostPoll);
+    });
+  }
+
+  u64 polls = 0;
+  while (polls < 4 * EVENTS)
+  {
+    const TimingSummary summary = recorder.GetSummary();
+    polls = summary.host_polls + summary.dropped_events;
+  }
+  for (std::thread& writer : writers)
+    writer.join();
+
+  const TimingSummary summary = recorder.GetSummary();
+  EXPECT_EQ(summary.host_polls + summary.dropped_events, 4 * EVENTS);
+}
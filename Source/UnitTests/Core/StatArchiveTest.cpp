@@ -0,0 +1,182 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/MSB_StatArchive.h"
+
+namespace
+{
+constexpr u8 MARIO = 0x0;
+constexpr u8 LUIGI = 0x1;
+constexpr u8 BOWSER = 0x9;
+
+struct Game
+{
+  StatArchiveGame game;
+  std::vector<StatArchiveCharacter> characters;
+  std::vector<StatArchiveEvent> events;
+};
+
+// Away has away_char batting against the home pitcher home_char, home only pitches
+Game MakeGame(s64 start_time, u8 stadium, u8 away_char, u8 home_char, u16 away_score,
+              u16 home_score)
+{
+  Game game;
+  game.game.start_time = start_time;
+  game.game.stadium = stadium;
+  game.game.away_score = away_score;
+  game.game.home_score = home_score;
+
+  StatArchiveCharacter batter;
+  batter.team = 0;
+  batter.char_id = away_char;
+  batter.at_bats = 4;
+  batter.hits = 2;
+  batter.homeruns = 1;
+  batter.rbi = away_score;
+  game.characters.push_back(batter);
+
+  StatArchiveCharacter pitcher;
+  pitcher.team = 1;
+  pitcher.char_id = home_char;
+  pitcher.outs_pitched = 27;
+  pitcher.runs_allowed = away_score;
+  pitcher.pitches_thrown = 100;
+  game.characters.push_back(pitcher);
+
+  for (u16 i = 0; i < 4; ++i)
+  {
+    StatArchiveEvent event;
+    event.event_num = i;
+    event.batter_char = away_char;
+    event.pitcher_char = home_char;
+    event.result_of_atbat = i < 2 ? 0x7 : 0x1;  // Single or strikeout
+    game.events.push_back(event);
+  }
+  return game;
+}
+}  // namespace
+
+class StatArchiveTest : public testing::Test
+{
+protected:
+  StatArchiveTest() : m_dir(File::CreateTempDir() + DIR_SEP), m_archive(m_dir) {}
+  ~StatArchiveTest() override { File::DeleteDirRecursively(m_dir); }
+
+  bool Append(const Game& game)
+  {
+    return m_archive.append(game.game, game.characters, game.events);
+  }
+
+  std::string m_dir;
+  StatArchive m_archive;
+};
+
+TEST_F(StatArchiveTest, EmptyArchive)
+{
+  EXPECT_EQ(m_archive.getNumGames(), 0u);
+
+  const auto summary = m_archive.query({});
+  ASSERT_TRUE(summary);
+  EXPECT_EQ(summary->games, 0u);
+  EXPECT_TRUE(summary->characters.empty());
+}
+
+TEST_F(StatArchiveTest, AppendAndQuery)
+{
+  ASSERT_TRUE(Append(MakeGame(1000, 0, MARIO, BOWSER, 3, 1)));
+  ASSERT_TRUE(Append(MakeGame(2000, 1, LUIGI, BOWSER, 0, 2)));
+  EXPECT_EQ(m_archive.getNumGames(), 2u);
+
+  const auto summary = m_archive.query({});
+  ASSERT_TRUE(summary);
+  EXPECT_EQ(summary->games, 2u);
+  EXPECT_EQ(summary->away_wins, 1u);
+  EXPECT_EQ(summary->home_wins, 1u);
+  EXPECT_EQ(summary->events, 8u);
+  EXPECT_EQ(summary->at_bat_results.at(0x7), 4u);
+  EXPECT_EQ(summary->at_bat_results.at(0x1), 4u);
+
+  const StatArchiveTotals& mario = summary->characters.at(MARIO);
+  EXPECT_EQ(mario.games, 1u);
+  EXPECT_EQ(mario.at_bats, 4u);
+  EXPECT_EQ(mario.hits, 2u);
+  EXPECT_EQ(mario.rbi, 3u);
+
+  const StatArchiveTotals& bowser = summary->characters.at(BOWSER);
+  EXPECT_EQ(bowser.games, 2u);
+  EXPECT_EQ(bowser.outs_pitched, 54u);
+  EXPECT_EQ(bowser.runs_allowed, 3u);
+  EXPECT_EQ(bowser.pitches_thrown, 200u);
+}
+
+TEST_F(StatArchiveTest, Filters)
+{
+  Game tagged = MakeGame(3000, 0, LUIGI, MARIO, 5, 4);
+  tagged.game.tag_set_id = 7;
+  ASSERT_TRUE(Append(MakeGame(1000, 0, MARIO, BOWSER, 3, 1)));
+  ASSERT_TRUE(Append(MakeGame(2000, 1, LUIGI, BOWSER, 0, 2)));
+  ASSERT_TRUE(Append(tagged));
+
+  StatArchiveFilter filter;
+  filter.stadium = 1;
+  EXPECT_EQ(m_archive.query(filter)->games, 1u);
+
+  filter = {};
+  filter.start_from = 2000;
+  filter.start_to = 3000;
+  EXPECT_EQ(m_archive.query(filter)->games, 1u);
+
+  filter = {};
+  filter.tag_set_id = 7;
+  EXPECT_EQ(m_archive.query(filter)->games, 1u);
+
+  // Only Mario's rows are summed, as batter in the first game and pitcher in the last
+  filter = {};
+  filter.char_id = MARIO;
+  const auto summary = m_archive.query(filter);
+  ASSERT_TRUE(summary);
+  EXPECT_EQ(summary->games, 2u);
+  EXPECT_EQ(summary->characters.size(), 1u);
+  EXPECT_EQ(summary->characters.at(MARIO).games, 2u);
+  EXPECT_EQ(summary->characters.at(MARIO).at_bats, 4u);
+  EXPECT_EQ(summary->characters.at(MARIO).outs_pitched, 27u);
+  EXPECT_EQ(summary->events, 4u);
+}
+
+TEST_F(StatArchiveTest, InterruptedAppendIsRepaired)
+{
+  ASSERT_TRUE(Append(MakeGame(1000, 0, MARIO, BOWSER, 3, 1)));
+
+  // A game whose rows were written but not its game row, and a column cut short
+  {
+    StatArchive interrupted(m_dir);
+    Game game = MakeGame(2000, 0, LUIGI, BOWSER, 1, 0);
+    ASSERT_TRUE(interrupted.append(game.game, game.characters, game.events));
+  }
+  const std::string game_id_path = m_dir + "games" DIR_SEP "game_id.col";
+  {
+    File::IOFile file(game_id_path, "r+b");
+    ASSERT_TRUE(file.Resize(file.GetSize() - sizeof(u32)));
+  }
+  EXPECT_EQ(m_archive.getNumGames(), 1u);
+  EXPECT_EQ(m_archive.query({})->characters.count(LUIGI), 0u);
+
+  ASSERT_TRUE(Append(MakeGame(3000, 0, BOWSER, MARIO, 2, 0)));
+  EXPECT_EQ(m_archive.getNumGames(), 2u);
+
+  const auto summary = m_archive.query({});
+  ASSERT_TRUE(summary);
+  EXPECT_EQ(summary->games, 2u);
+  EXPECT_EQ(summary->events, 8u);
+  EXPECT_EQ(summary->characters.count(LUIGI), 0u);
+  EXPECT_EQ(summary->characters.at(BOWSER).games, 2u);
+  EXPECT_EQ(File::GetSize(m_dir + "characters" DIR_SEP "game.col"), 4 * sizeof(u32));
+}
@@ -0,0 +1,68 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Core/MSB_StatDecode.h"
+
+namespace
+{
+std::string DecodeToString(DecodeType type, u8 value)
+{
+  fmt::memory_buffer out;
+  decodeTo(out, type, value);
+  return fmt::to_string(out);
+}
+
+size_t CountNames(DecodeType type)
+{
+  size_t count = 0;
+  for (int value = 0; value < 256; ++value)
+    count += decode(type, static_cast<u8>(value)).has_value();
+  return count;
+}
+}  // namespace
+
+TEST(StatDecodeTest, TablesMatchLists)
+{
+  for (const auto& [value, name] : cCharIdToCharName)
+    EXPECT_EQ(decode(DecodeType::Character, value), name);
+  EXPECT_EQ(CountNames(DecodeType::Character), std::size(cCharIdToCharName));
+
+  for (const auto& [value, name] : cPosition)
+    EXPECT_EQ(decode(DecodeType::Position, value), name);
+  EXPECT_EQ(CountNames(DecodeType::Position), std::size(cPosition));
+
+  // 0 and 0xFF are both "None"
+  EXPECT_EQ(decode(DecodeType::Bobble, 0xFF), "None");
+  EXPECT_EQ(CountNames(DecodeType::Bobble), std::size(cFielderBobbles));
+}
+
+TEST(StatDecodeTest, StickVec)
+{
+  EXPECT_EQ(decode(DecodeType::StickVec, 0x0), "");
+  EXPECT_EQ(decode(DecodeType::StickVec, 0x2), "Right");
+  EXPECT_EQ(decode(DecodeType::StickVec, 0x9), "Left+Up");
+  EXPECT_EQ(decode(DecodeType::StickVec, 0xF), "Left+Right+Down+Up");
+  // Only the direction bits count
+  EXPECT_EQ(decode(DecodeType::StickVec, 0x19), "Left+Up");
+  EXPECT_EQ(CountNames(DecodeType::StickVec), 256u);
+}
+
+TEST(StatDecodeTest, DecodeTo)
+{
+  EXPECT_EQ(DecodeToString(DecodeType::Stadium, 0x6), "\"Toy Field\"");
+  EXPECT_EQ(DecodeToString(DecodeType::QuitterTeam, 0xFF), "\"None\"");
+  EXPECT_EQ(DecodeToString(DecodeType::StickVec, 0x0), "\"\"");
+  EXPECT_EQ(DecodeToString(DecodeType::QuitterTeam, 3),
+            "\"Unable to Decode. Invalid Value (3).\"");
+  EXPECT_EQ(DecodeToString(DecodeType::Count, 0), "\"Unable to Decode. Invalid Value (0).\"");
+
+  EXPECT_EQ(decodeName(DecodeType::Character, 0xFF), "Unknown");
+}
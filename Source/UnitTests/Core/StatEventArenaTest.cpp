@@ -0,0 +1,178 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/MSB_EventArena.h"
+#include "Core/MSB_StatTracker.h"
+#include "UICommon/UICommon.h"
+
+#include "StatTrackerTestGame.h"
+
+// Count heap allocations made while events are stored and copied
+static std::atomic<size_t> s_allocation_count{0};
+
+void* operator new(std::size_t size)
+{
+  ++s_allocation_count;
+  if (void* ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+constexpr int BENCHMARK_GAMES = 50;
+
+struct Record
+{
+  u32 value;
+};
+}  // namespace
+
+TEST(EventArena, BehavesLikeMap)
+{
+  EventArena<Record, 8> arena;
+  EXPECT_TRUE(arena.empty());
+
+  arena[3].value = 30;
+  arena[1].value = 10;
+  arena[2].value = 20;
+  EXPECT_EQ(arena.size(), 3u);
+  EXPECT_TRUE(arena.contains(2));
+  EXPECT_EQ(arena.count(4), 0u);
+  EXPECT_EQ(arena.at(3).value, 30u);
+  EXPECT_THROW(arena.at(4), std::out_of_range);
+
+  // New events start out zeroed, like std::map::operator[]
+  EXPECT_EQ(arena[5].value, 0u);
+  arena.erase(5);
+  arena.erase(5);
+  EXPECT_EQ(arena.size(), 3u);
+
+  std::vector<u16> order;
+  arena.forEach([&](u16 event_num, Record& record) {
+    order.push_back(event_num);
+    EXPECT_EQ(record.value, event_num * 10u);
+  });
+  EXPECT_EQ(order, (std::vector<u16>{1, 2, 3}));
+
+  arena.clear();
+  EXPECT_TRUE(arena.empty());
+  EXPECT_FALSE(arena.contains(1));
+}
+
+TEST(EventArena, ReusesSlotsPastCapacity)
+{
+  EventArena<Record, 8> arena;
+
+  // A long game keeps going past the capacity as long as finished events are dropped
+  for (u16 event_num = 0; event_num < 100; ++event_num)
+  {
+    arena[event_num].value = event_num;
+    if (event_num >= 4)
+      arena.erase(event_num - 4);
+  }
+  EXPECT_EQ(arena.size(), 4u);
+
+  std::vector<u16> order;
+  arena.forEach([&](u16 event_num, Record& record) {
+    order.push_back(event_num);
+    EXPECT_EQ(record.value, event_num);
+  });
+  EXPECT_EQ(order, (std::vector<u16>{96, 97, 98, 99}));
+
+  // Without that, the oldest event in the slot is overwritten
+  arena[104].value = 104;
+  EXPECT_FALSE(arena.contains(96));
+  EXPECT_EQ(arena.size(), 4u);
+}
+
+class StatEventArenaTest : public testing::Test
+{
+protected:
+  StatEventArenaTest() : m_profile_path(File::CreateTempDir())
+  {
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+  }
+
+  ~StatEventArenaTest() override
+  {
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  std::string m_profile_path;
+};
+
+TEST_F(StatEventArenaTest, NoAllocationsDuringGame)
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto tracker = std::make_unique<StatTracker>();
+  GameRecorder(7).Record(*tracker);
+
+  std::vector<std::pair<u16, StatTracker::Event>> recorded;
+  tracker->m_game_info.events.forEach([&](u16 event_num, StatTracker::Event& event) {
+    recorded.emplace_back(event_num, event);
+  });
+  ASSERT_FALSE(recorded.empty());
+
+  // What the tracker does for every event: create it, fill it in, keep a copy as the previous
+  // state and drop it once it is journaled
+  auto& events = tracker->m_game_info.events;
+  std::optional<StatTracker::Event>& previous_state = tracker->m_game_info.previous_state;
+  events.clear();
+
+  const size_t allocations = s_allocation_count;
+  const auto start = Clock::now();
+  for (int game = 0; game < BENCHMARK_GAMES; ++game)
+  {
+    for (const auto& [event_num, event] : recorded)
+    {
+      StatTracker::Event& current = events[event_num];
+      current = event;
+      current.history.push_back(EVENT_STATE::FINAL_RESULT);
+      previous_state = current;
+      events.erase(event_num);
+    }
+  }
+  const auto elapsed = Clock::now() - start;
+
+  EXPECT_EQ(s_allocation_count - allocations, 0u);
+  EXPECT_TRUE(events.empty());
+  EXPECT_EQ(previous_state->event_num, recorded.back().second.event_num);
+
+  const size_t num_events = recorded.size() * BENCHMARK_GAMES;
+  fmt::print(stderr, "sizeof(Event): {} bytes, {} ns/event\n", sizeof(StatTracker::Event),
+             std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / num_events);
+}
@@ -0,0 +1,171 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/MSB_StatEventJournal.h"
+#include "Core/MSB_StatTracker.h"
+#include "UICommon/UICommon.h"
+
+#include "StatTrackerTestGame.h"
+
+class StatEventJournalTest : public testing::Test
+{
+protected:
+  StatEventJournalTest() : m_profile_path(File::CreateTempDir())
+  {
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    m_journal_dir = m_profile_path + "/Journal/";
+  }
+
+  ~StatEventJournalTest() override
+  {
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  using EventList = std::vector<std::pair<u16, StatTracker::Event>>;
+
+  static EventList CopyEvents(StatTracker& tracker)
+  {
+    EventList events;
+    tracker.m_game_info.events.forEach(
+        [&](u16 event_num, StatTracker::Event& event) { events.emplace_back(event_num, event); });
+    return events;
+  }
+
+  // Feeds the recorded events through the tracker one at a time, the way they finish in game.
+  // The first |journaled| events end up in the journal, the rest stay in GameInfo::events
+  static void PlayGame(StatTracker& tracker, const EventList& events, size_t journaled)
+  {
+    tracker.m_event_journal.begin();
+    tracker.m_game_info.events.clear();
+    size_t count = 0;
+    for (const auto& [event_num, event] : events)
+    {
+      tracker.m_game_info.event_num = event_num;
+      tracker.m_game_info.events[event_num] = event;
+      if (count++ < journaled)
+        tracker.journalCurrentEvent();
+    }
+  }
+
+  std::string m_profile_path;
+  std::string m_journal_dir;
+};
+
+TEST_F(StatEventJournalTest, JournaledGameMatchesInMemoryGame)
+{
+  auto tracker = std::make_unique<StatTracker>();
+  GameRecorder(7).Record(*tracker);
+  const EventList events = CopyEvents(*tracker);
+
+  const std::string decoded = tracker->getStatJSON(true);
+  const std::string local = tracker->getStatJSON(false, true);
+  const std::string submitted = tracker->getStatJSON(false, false);
+
+  for (const size_t journaled : {events.size() / 2, events.size()})
+  {
+    PlayGame(*tracker, events, journaled);
+    EXPECT_EQ(tracker->m_event_journal.getNumEvents(), journaled);
+    EXPECT_EQ(tracker->m_game_info.events.size(), events.size() - journaled);
+
+    EXPECT_EQ(tracker->getStatJSON(true), decoded);
+    EXPECT_EQ(tracker->getStatJSON(false, true), local);
+    EXPECT_EQ(tracker->getStatJSON(false, false), submitted);
+  }
+
+  tracker->m_event_journal.discard();
+  tracker->m_event_journal.flush();
+  EXPECT_FALSE(File::Exists(tracker->m_event_journal.getJournalPath(true)));
+  EXPECT_FALSE(File::Exists(tracker->m_event_journal.getJournalPath(false)));
+}
+
+TEST_F(StatEventJournalTest, EmptyEventsAreNotJournaled)
+{
+  auto tracker = std::make_unique<StatTracker>();
+  GameRecorder(3).Record(*tracker);
+  EventList events = CopyEvents(*tracker);
+
+  // A quit leaves a last event that never got going
+  StatTracker::Event empty_event{};
+  empty_event.inning = 0;
+  events.emplace_back(static_cast<u16>(events.back().first + 1), empty_event);
+  PlayGame(*tracker, events, events.size());
+
+  EXPECT_EQ(tracker->m_event_journal.getNumEvents(), events.size() - 1);
+  EXPECT_TRUE(tracker->m_game_info.events.empty());
+
+  picojson::value document;
+  const std::string error = picojson::parse(document, tracker->getStatJSON(false));
+  ASSERT_TRUE(error.empty()) << error;
+  EXPECT_EQ(document.get("Events").get<picojson::array>().size(), events.size() - 1);
+}
+
+TEST_F(StatEventJournalTest, RecoversUnfinishedGame)
+{
+  {
+    StatEventJournal journal(m_journal_dir);
+    journal.begin();
+    for (int i = 0; i < 3; ++i)
+    {
+      journal.append(fmt::format("    {{\n      \"Event Num\": \"{}\"\n    }}", i),
+                     fmt::format("    {{\n      \"Event Num\": {}\n    }}", i));
+    }
+    journal.flush();
+    // Gone without writing a stat file, as if Rio had crashed
+  }
+
+  StatEventJournal journal(m_journal_dir);
+  const std::vector<std::string> recovered = Common::DoFileSearch({m_journal_dir}, {".json"});
+  ASSERT_EQ(recovered.size(), 2u);
+  for (const std::string& path : recovered)
+  {
+    EXPECT_NE(path.find("recovered."), std::string::npos);
+
+    std::string json;
+    ASSERT_TRUE(File::ReadFileToString(path, json));
+    picojson::value document;
+    const std::string error = picojson::parse(document, json);
+    ASSERT_TRUE(error.empty()) << error;
+    EXPECT_EQ(document.get("Events").get<picojson::array>().size(), 3u);
+  }
+
+  // The new session starts from an empty journal
+  fmt::memory_buffer events;
+  journal.readEvents(false, events);
+  EXPECT_EQ(events.size(), 0u);
+}
+
+TEST_F(StatEventJournalTest, LeavesLiveJournalAlone)
+{
+  StatEventJournal game(m_journal_dir);
+  game.begin();
+  game.append("    {}", "    {}");
+  game.flush();
+
+  // Another tracker, like dolphin-tool next to a running game, must not take the journal away
+  StatEventJournal other(m_journal_dir);
+  EXPECT_TRUE(File::Exists(game.getJournalPath(true)));
+  EXPECT_TRUE(File::Exists(game.getJournalPath(false)));
+  EXPECT_NE(game.getJournalPath(false), other.getJournalPath(false));
+
+  fmt::memory_buffer events;
+  game.readEvents(false, events);
+  EXPECT_EQ(fmt::to_string(events), "    {}");
+}
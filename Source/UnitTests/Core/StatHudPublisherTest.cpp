@@ -0,0 +1,165 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <optional>
+#include <string>
+
+#include <SFML/Network.hpp>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Core/MSB_StatHudPublisher.h"
+
+namespace
+{
+std::string MakeDocument(int event_num)
+{
+  return fmt::format("{{\n  \"Event Num\": \"{}a\",\n  \"Padding\": \"{}\"\n}}", event_num,
+                     std::string(event_num * 13, 'x'));
+}
+
+// Reads one "<length>\n<document>" message, nothing if none arrives in time
+std::optional<std::string> ReceiveDocument(sf::TcpSocket& socket, std::string& buffer)
+{
+  sf::SocketSelector selector;
+  selector.add(socket);
+  while (true)
+  {
+    const size_t newline = buffer.find('\n');
+    if (newline != std::string::npos)
+    {
+      const size_t length = std::stoul(buffer.substr(0, newline));
+      if (buffer.size() - newline - 1 >= length)
+      {
+        std::string document = buffer.substr(newline + 1, length);
+        buffer.erase(0, newline + 1 + length);
+        return document;
+      }
+    }
+
+    if (!selector.wait(sf::seconds(5)))
+      return std::nullopt;
+    std::array<char, 4096> chunk;
+    size_t received = 0;
+    if (socket.receive(chunk.data(), chunk.size(), received) != sf::Socket::Done)
+      return std::nullopt;
+    buffer.append(chunk.data(), received);
+  }
+}
+}  // namespace
+
+class StatHudPublisherTest : public testing::Test
+{
+protected:
+  StatHudPublisherTest()
+      : m_dir(File::CreateTempDir()), m_hud_path(m_dir + DIR_SEP "decoded.hud.json")
+  {
+  }
+  ~StatHudPublisherTest() override { File::DeleteDirRecursively(m_dir); }
+
+  std::string ReadHud()
+  {
+    std::string json;
+    File::ReadFileToString(m_hud_path, json);
+    return json;
+  }
+
+  std::string m_dir;
+  std::string m_hud_path;
+};
+
+TEST_F(StatHudPublisherTest, WritesLatestDocument)
+{
+  StatHudPublisher publisher(m_hud_path);
+  EXPECT_EQ(publisher.getStreamPort(), 0);
+
+  publisher.publish(MakeDocument(1));
+  publisher.flush();
+  EXPECT_EQ(ReadHud(), MakeDocument(1));
+
+  // Replaced in place, the shorter document leaves nothing of the longer one behind
+  publisher.publish(MakeDocument(20));
+  publisher.publish(MakeDocument(2));
+  publisher.flush();
+  EXPECT_EQ(ReadHud(), MakeDocument(2));
+}
+
+TEST_F(StatHudPublisherTest, CoalescesBursts)
+{
+  constexpr int num_documents = 500;
+  {
+    StatHudPublisher publisher(m_hud_path);
+    for (int i = 1; i <= num_documents; ++i)
+      publisher.publish(MakeDocument(i));
+    publisher.flush();
+
+    EXPECT_EQ(publisher.getPublishedCount(), u32(num_documents));
+    EXPECT_GE(publisher.getWrittenCount(), 1u);
+    EXPECT_LE(publisher.getWrittenCount(), u32(num_documents));
+    EXPECT_EQ(ReadHud(), MakeDocument(num_documents));
+  }
+
+  // Only the HUD itself is left, no temp file
+  EXPECT_EQ(Common::DoFileSearch({m_dir}, {}).size(), 1u);
+}
+
+TEST_F(StatHudPublisherTest, ShutdownWritesPending)
+{
+  StatHudPublisher publisher(m_hud_path);
+  publisher.publish(MakeDocument(3));
+  publisher.shutdown();
+  EXPECT_EQ(ReadHud(), MakeDocument(3));
+
+  // Nothing is written once shut down, and nothing waits for it
+  publisher.publish(MakeDocument(4));
+  publisher.flush();
+  EXPECT_EQ(ReadHud(), MakeDocument(3));
+}
+
+TEST_F(StatHudPublisherTest, StreamsToOverlays)
+{
+  StatHudPublisher publisher(m_hud_path, 0);
+  ASSERT_NE(publisher.getStreamPort(), 0);
+
+  publisher.publish(MakeDocument(5));
+  publisher.flush();
+
+  sf::TcpSocket overlay;
+  ASSERT_EQ(overlay.connect(sf::IpAddress::LocalHost, publisher.getStreamPort(), sf::seconds(5)),
+            sf::Socket::Done);
+
+  // A new overlay starts with the current HUD
+  std::string buffer;
+  EXPECT_EQ(ReceiveDocument(overlay, buffer), MakeDocument(5));
+
+  publisher.publish(MakeDocument(6));
+  publisher.flush();
+  EXPECT_EQ(ReceiveDocument(overlay, buffer), MakeDocument(6));
+  EXPECT_EQ(ReadHud(), MakeDocument(6));
+}
+
+TEST_F(StatHudPublisherTest, KeepsWhatTheSocketDoesNotTake)
+{
+  StatHudPublisher publisher(m_hud_path, 0);
+  ASSERT_NE(publisher.getStreamPort(), 0);
+
+  sf::TcpSocket overlay;
+  ASSERT_EQ(overlay.connect(sf::IpAddress::LocalHost, publisher.getStreamPort(), sf::seconds(5)),
+            sf::Socket::Done);
+
+  // Bigger than the socket buffers, and nothing is read until both are published
+  const std::string first = MakeDocument(7) + std::string(4 * 1000 * 1000, ' ');
+  const std::string second = MakeDocument(8) + std::string(4 * 1000 * 1000, ' ');
+  publisher.publish(first);
+  publisher.flush();
+  publisher.publish(second);
+  publisher.flush();
+
+  std::string buffer;
+  EXPECT_EQ(ReceiveDocument(overlay, buffer), first);
+  EXPECT_EQ(ReceiveDocument(overlay, buffer), second);
+}
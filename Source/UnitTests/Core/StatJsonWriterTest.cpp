@@ -0,0 +1,190 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/MSB_StatJsonWriter.h"
+#include "Core/MSB_StatTracker.h"
+#include "UICommon/UICommon.h"
+
+#include "StatTrackerTestGame.h"
+
+// Count heap allocations made while serializing
+static std::atomic<size_t> s_allocation_count{0};
+
+void* operator new(std::size_t size)
+{
+  ++s_allocation_count;
+  if (void* ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+constexpr int BENCHMARK_RUNS = 20;
+}  // namespace
+
+class StatJsonWriterTest : public testing::Test
+{
+protected:
+  StatJsonWriterTest() : m_profile_path(File::CreateTempDir())
+  {
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    m_tracker = std::make_unique<StatTracker>();
+    GameRecorder(1).Record(*m_tracker);
+  }
+
+  ~StatJsonWriterTest() override
+  {
+    m_tracker.reset();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  std::string m_profile_path;
+  std::unique_ptr<StatTracker> m_tracker;
+};
+
+TEST_F(StatJsonWriterTest, SinglePassMatchesSeparatePasses)
+{
+  const std::string decoded = m_tracker->getStatJSON(true);
+  const std::string local = m_tracker->getStatJSON(false, true);
+  const std::string submitted = m_tracker->getStatJSON(false, false);
+
+  StatJsonWriter json;
+  const size_t decoded_target = json.addTarget(true);
+  const size_t local_target = json.addTarget(false, true);
+  const size_t submitted_target = json.addTarget(false, false);
+  m_tracker->writeStatJSON(json);
+
+  EXPECT_EQ(json.view(decoded_target), decoded);
+  EXPECT_EQ(json.view(local_target), local);
+  EXPECT_EQ(json.view(submitted_target), submitted);
+
+  EXPECT_NE(decoded.find("\"Away Player\": \"AwayPlayer\""), std::string::npos);
+  EXPECT_NE(submitted.find("\"Away Player\": \"away-rio-key\""), std::string::npos);
+}
+
+TEST_F(StatJsonWriterTest, OutputIsValidJson)
+{
+  for (const bool decode : {true, false})
+  {
+    picojson::value document;
+    const std::string error = picojson::parse(document, m_tracker->getStatJSON(decode));
+    ASSERT_TRUE(error.empty()) << error;
+
+    const picojson::array& events = document.get("Events").get<picojson::array>();
+    EXPECT_EQ(events.size(), m_tracker->m_game_info.events.size());
+    EXPECT_EQ(document.get("Character Game Stats").get<picojson::object>().size(), 18u);
+  }
+
+  StatTracker::Event& event = m_tracker->m_game_info.getCurrentEvent();
+  picojson::value hud;
+  const std::string error = picojson::parse(
+      hud, m_tracker->getHUDJSON("1a", event, m_tracker->m_game_info.previous_state, true));
+  EXPECT_TRUE(error.empty()) << error;
+}
+
+TEST_F(StatJsonWriterTest, Benchmark)
+{
+  using Clock = std::chrono::steady_clock;
+
+  // Three documents at the end of a game, one pass each
+  Clock::duration separate_time{};
+  size_t separate_allocations = 0;
+  size_t size = 0;
+  for (int i = 0; i < BENCHMARK_RUNS; ++i)
+  {
+    const size_t allocations = s_allocation_count;
+    const auto start = Clock::now();
+    const std::string decoded = m_tracker->getStatJSON(true);
+    const std::string local = m_tracker->getStatJSON(false, true);
+    const std::string submitted = m_tracker->getStatJSON(false, false);
+    separate_time += Clock::now() - start;
+    separate_allocations += s_allocation_count - allocations;
+    size = decoded.size() + local.size() + submitted.size();
+  }
+
+  // The same three documents from one pass into a writer that is reused between games
+  StatJsonWriter json;
+  Clock::duration single_time{};
+  size_t single_allocations = 0;
+  size_t steady_allocations = 0;
+  for (int i = 0; i < BENCHMARK_RUNS; ++i)
+  {
+    const size_t allocations = s_allocation_count;
+    const auto start = Clock::now();
+    json.reset();
+    json.addTarget(true);
+    json.addTarget(false, true);
+    json.addTarget(false, false);
+    m_tracker->writeStatJSON(json);
+    single_time += Clock::now() - start;
+    single_allocations += s_allocation_count - allocations;
+    if (i == BENCHMARK_RUNS - 1)
+      steady_allocations = s_allocation_count - allocations;
+  }
+
+  // Once the buffers have grown to fit a game nothing is allocated
+  EXPECT_EQ(steady_allocations, 0u);
+  EXPECT_LT(single_allocations, separate_allocations);
+
+  const auto to_us = [](Clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count() / BENCHMARK_RUNS;
+  };
+  fmt::print(stderr, "{} events, {} bytes per game\n", m_tracker->m_game_info.events.size(), size);
+  fmt::print(stderr, "Separate passes: {} us/game, {} allocations/game\n", to_us(separate_time),
+             separate_allocations / BENCHMARK_RUNS);
+  fmt::print(stderr, "Single pass:     {} us/game, {} allocations/game\n", to_us(single_time),
+             single_allocations / BENCHMARK_RUNS);
+}
+
+TEST_F(StatJsonWriterTest, DecodedBenchmark)
+{
+  using Clock = std::chrono::steady_clock;
+
+  // Only the decoded document, where every id goes through the decode tables
+  StatJsonWriter json;
+  Clock::duration elapsed{};
+  for (int i = 0; i < BENCHMARK_RUNS; ++i)
+  {
+    const auto start = Clock::now();
+    json.reset();
+    json.addTarget(true);
+    m_tracker->writeStatJSON(json);
+    elapsed += Clock::now() - start;
+  }
+  EXPECT_EQ(json.view(0), m_tracker->getStatJSON(true));
+
+  fmt::print(stderr, "Decoded: {} us/game\n",
+             std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() /
+                 BENCHMARK_RUNS);
+}
@@ -0,0 +1,352 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MSB_StatTracker.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+constexpr int BENCHMARK_FRAMES = 2000;
+
+struct FrameResult
+{
+  u8 inning;
+  u8 balls;
+  u8 strikes;
+  u8 outs;
+  u16 away_score;
+  u16 home_score;
+  u16 pitcher_stamina;
+  u8 catcher_roster_loc;
+  u16 runs_allowed;
+  u16 pitches_thrown;
+  u8 at_bats;
+  u8 char_id;
+
+  auto Tie() const
+  {
+    return std::tie(inning, balls, strikes, outs, away_score, home_score, pitcher_stamina,
+                    catcher_roster_loc, runs_allowed, pitches_thrown, at_bats, char_id);
+  }
+  bool operator==(const FrameResult& other) const { return Tie() == other.Tie(); }
+};
+
+struct AtBatFrame
+{
+  u8 state_curr;
+  u8 state_prev;
+  u8 pitch_thrown;
+  u8 contact_made;
+  u8 contact_result;
+};
+
+constexpr std::array<AtBatFrame, 5> AT_BAT_FRAMES{{
+    {0x5, 0x0, 0, 0, 0},  // Game starts
+    {0x1, 0x0, 0, 0, 0},  // At-bat starts
+    {0x1, 0x1, 1, 0, 0},  // Pitch
+    {0x1, 0x1, 1, 1, 0},  // Contact
+    {0x1, 0x1, 1, 1, 1},  // Ball lands fair
+}};
+}  // namespace
+
+class StatTrackerSnapshotTest : public testing::Test
+{
+protected:
+  StatTrackerSnapshotTest() : m_profile_path(File::CreateTempDir())
+  {
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+
+    auto& system = Core::System::GetInstance();
+    system.GetMemory().Init();
+
+    // Map 0x80000000 onto MEM1 the same way the IPL does, with translation on
+    auto& ppc_state = system.GetPPCState();
+    ppc_state.spr[SPR_DBAT0U] = 0x80001fff;
+    ppc_state.spr[SPR_DBAT0L] = 0x00000002;
+    ppc_state.spr[SPR_IBAT0U] = 0x80001fff;
+    ppc_state.spr[SPR_IBAT0L] = 0x00000002;
+    system.GetMMU().DBATUpdated();
+    system.GetMMU().IBATUpdated();
+    ppc_state.msr.DR = 1;
+    ppc_state.m_enable_dcache = false;
+
+    // Deterministic junk so every read returns something different
+    u8* ram = system.GetMemory().GetRAM();
+    for (u32 i = 0; i < system.GetMemory().GetRamSizeReal(); ++i)
+      ram[i] = static_cast<u8>((i * 2654435761u) >> 24);
+
+    // Batting/pitching team indexes into the port table, must be 0 or 1
+    const u32 batting_team = 0x00892990;
+    const u32 pitching_team = 0x00892994;
+    std::memset(ram + batting_team, 0, 8);
+    ram[pitching_team + 3] = 1;
+  }
+
+  ~StatTrackerSnapshotTest() override
+  {
+    auto& system = Core::System::GetInstance();
+    system.GetPPCState().msr.DR = 0;
+    system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  // Runs the per-frame loggers |frames| times. Returns the last frame's values
+  FrameResult RunFrames(StatTracker& tracker, int frames)
+  {
+    Core::CPUThreadGuard guard(Core::System::GetInstance());
+    StatTracker::Event event;
+    for (int i = 0; i < frames; ++i)
+    {
+      tracker.m_snapshot.invalidate();
+      tracker.logGameInfo(guard);
+      tracker.logEventState(guard, event);
+    }
+
+    const auto& summary = tracker.m_game_info.character_summaries[1][4];
+    return FrameResult{event.inning,
+                       event.balls,
+                       event.strikes,
+                       event.outs,
+                       event.away_score,
+                       event.home_score,
+                       event.pitcher_stamina,
+                       event.catcher_roster_loc,
+                       summary.end_game_defensive_stats.runs_allowed,
+                       summary.end_game_defensive_stats.pitches_thrown,
+                       summary.end_game_offensive_stats.at_bats,
+                       summary.char_id};
+  }
+
+  // Everything that drives the at-bat state machine, the rest of memory stays junk
+  void SetUpAtBat()
+  {
+    SetU8(aGameId + 3, 0x42);
+    SetU8(aTeamPorts, 1);
+    SetU8(aTeamPorts + 1, 2);
+    SetU8(aAB_PickoffAttempt, 0);
+    SetU8(aAB_PitchType, 2);
+    SetAtBatFrame(AT_BAT_FRAMES[0]);
+  }
+
+  void SetAtBatFrame(const AtBatFrame& frame)
+  {
+    SetU8(aGameControlStateCurr, frame.state_curr);
+    SetU8(aGameControlStatePrev, frame.state_prev);
+    SetU8(aAB_PitchThrown, frame.pitch_thrown);
+    SetU8(aAB_ContactMade, frame.contact_made);
+    SetU8(aAB_ContactResult, frame.contact_result);
+  }
+
+  void SetU8(u32 address, u8 value)
+  {
+    Core::System::GetInstance().GetMemory().GetRAM()[address & 0x01FFFFFF] = value;
+  }
+
+  std::unique_ptr<StatTracker> MakeTracker(bool snapshot_enabled)
+  {
+    auto tracker = std::make_unique<StatTracker>();
+    tracker->m_game_info.team0_port = 0;
+    tracker->m_game_info.team1_port = 1;
+    tracker->m_game_info.away_port = 0;
+    tracker->m_game_info.home_port = 1;
+    tracker->m_snapshot.setEnabled(snapshot_enabled);
+    return tracker;
+  }
+
+  std::string m_profile_path;
+};
+
+TEST_F(StatTrackerSnapshotTest, SnapshotMatchesHostRead)
+{
+  const FrameResult host_read = RunFrames(*MakeTracker(false), 1);
+  const FrameResult snapshot = RunFrames(*MakeTracker(true), 1);
+
+  EXPECT_TRUE(host_read == snapshot);
+}
+
+TEST_F(StatTrackerSnapshotTest, SnapshotSeesNewFrame)
+{
+  auto tracker = MakeTracker(true);
+  const FrameResult before = RunFrames(*tracker, 1);
+
+  auto& system = Core::System::GetInstance();
+  const u32 away_score = 0x008928A4;
+  system.GetMemory().GetRAM()[away_score] ^= 0xFF;
+
+  // Same frame: still served from the copy
+  {
+    Core::CPUThreadGuard guard(system);
+    StatTracker::Event event;
+    tracker->logEventState(guard, event);
+    EXPECT_EQ(event.away_score, before.away_score);
+  }
+
+  const FrameResult after = RunFrames(*tracker, 1);
+  EXPECT_NE(after.away_score, before.away_score);
+  EXPECT_EQ(after.home_score, before.home_score);
+}
+
+TEST_F(StatTrackerSnapshotTest, Benchmark)
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto host_read_tracker = MakeTracker(false);
+  const auto host_read_start = Clock::now();
+  const FrameResult host_read = RunFrames(*host_read_tracker, BENCHMARK_FRAMES);
+  const auto host_read_time = Clock::now() - host_read_start;
+
+  auto snapshot_tracker = MakeTracker(true);
+  const auto snapshot_start = Clock::now();
+  const FrameResult snapshot = RunFrames(*snapshot_tracker, BENCHMARK_FRAMES);
+  const auto snapshot_time = Clock::now() - snapshot_start;
+
+  EXPECT_TRUE(host_read == snapshot);
+  // One copy per region actually touched per frame, never one per read
+  EXPECT_GE(snapshot_tracker->m_snapshot.getCaptureCount(), u64(BENCHMARK_FRAMES));
+  EXPECT_LE(snapshot_tracker->m_snapshot.getCaptureCount(), u64(BENCHMARK_FRAMES) * 3);
+
+  const auto per_frame = [](Clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / BENCHMARK_FRAMES;
+  };
+  fmt::print(stderr, "HostRead: {} ns/frame, snapshot: {} ns/frame\n", per_frame(host_read_time),
+             per_frame(snapshot_time));
+}
+
+TEST_F(StatTrackerSnapshotTest, ReplayedAtBatMatchesLive)
+{
+  Config::SetCurrent(Config::MAIN_STAT_TRACKER_RECORD_TRACE, true);
+  SetUpAtBat();
+
+  auto& system = Core::System::GetInstance();
+  StatTracker::Event live;
+  {
+    auto tracker = std::make_unique<StatTracker>();
+    tracker->init();
+    Core::CPUThreadGuard guard(system);
+    for (const AtBatFrame& frame : AT_BAT_FRAMES)
+    {
+      SetAtBatFrame(frame);
+      tracker->Run(guard);
+    }
+    ASSERT_TRUE(tracker->m_game_info.currentEventVld());
+    live = tracker->m_game_info.getCurrentEvent();
+  }
+  Config::SetCurrent(Config::MAIN_STAT_TRACKER_RECORD_TRACE, false);
+
+  ASSERT_TRUE(live.pitch.has_value());
+  ASSERT_TRUE(live.pitch->contact.has_value());
+  EXPECT_EQ(live.pitch->pitch_type, 2);
+  EXPECT_EQ(live.pitch->contact->primary_contact_result, 2);
+
+  const std::vector<std::string> traces =
+      Common::DoFileSearch({File::GetUserPath(D_STATTRACES_IDX)}, {".stattrace"});
+  ASSERT_EQ(traces.size(), 1u);
+
+  // Nothing the game had can leak into the replay
+  std::memset(system.GetMemory().GetRAM(), 0, system.GetMemory().GetRamSizeReal());
+
+  auto tracker = std::make_unique<StatTracker>();
+  tracker->init();
+  Core::CPUThreadGuard guard(system);
+  EXPECT_EQ(tracker->replayTrace(guard, traces[0]), AT_BAT_FRAMES.size());
+  EXPECT_EQ(tracker->m_snapshot.getMissedReadCount(), 0u);
+
+  ASSERT_TRUE(tracker->m_game_info.currentEventVld());
+  const StatTracker::Event& replayed = tracker->m_game_info.getCurrentEvent();
+  ASSERT_TRUE(replayed.pitch.has_value());
+  ASSERT_TRUE(replayed.pitch->contact.has_value());
+
+  const StatTracker::Pitch& pitch = *replayed.pitch;
+  EXPECT_EQ(pitch.pitcher_char_id, live.pitch->pitcher_char_id);
+  EXPECT_EQ(pitch.pitch_type, live.pitch->pitch_type);
+  EXPECT_EQ(pitch.charge_type, live.pitch->charge_type);
+  EXPECT_EQ(pitch.pitch_speed, live.pitch->pitch_speed);
+  EXPECT_EQ(pitch.type_of_swing, live.pitch->type_of_swing);
+  EXPECT_EQ(pitch.potential_db, live.pitch->potential_db);
+
+  const StatTracker::Contact& contact = *pitch.contact;
+  const StatTracker::Contact& live_contact = *live.pitch->contact;
+  EXPECT_EQ(contact.power.get_value(), live_contact.power.get_value());
+  EXPECT_EQ(contact.vert_angle.get_value(), live_contact.vert_angle.get_value());
+  EXPECT_EQ(contact.horiz_angle.get_value(), live_contact.horiz_angle.get_value());
+  EXPECT_EQ(contact.ball_x_velo.get_value(), live_contact.ball_x_velo.get_value());
+  EXPECT_EQ(contact.contact_quality.get_value(), live_contact.contact_quality.get_value());
+  EXPECT_EQ(contact.input_direction_stick.get_value(),
+            live_contact.input_direction_stick.get_value());
+  EXPECT_EQ(contact.primary_contact_result, live_contact.primary_contact_result);
+  EXPECT_EQ(contact.ball_x_pos.get_value(), live_contact.ball_x_pos.get_value());
+}
+
+TEST_F(StatTrackerSnapshotTest, RollbackFramesRunOnce)
+{
+  SetUpAtBat();
+
+  auto tracker = std::make_unique<StatTracker>();
+  tracker->init();
+  Core::CPUThreadGuard guard(Core::System::GetInstance());
+
+  // Input from the pitch on is predicted
+  for (u64 frame = 0; frame < AT_BAT_FRAMES.size(); ++frame)
+  {
+    SetAtBatFrame(AT_BAT_FRAMES[frame]);
+    tracker->captureFrame(guard, frame, frame + 1);
+    tracker->runConfirmedFrames(guard, std::min<u64>(frame, 2));
+  }
+  EXPECT_FALSE(tracker->m_game_info.currentEventVld() &&
+               tracker->m_game_info.getCurrentEvent().pitch.has_value());
+
+  // The prediction was wrong from the pitch on, those frames run again
+  for (u64 frame = 2; frame < AT_BAT_FRAMES.size(); ++frame)
+  {
+    SetAtBatFrame(AT_BAT_FRAMES[frame]);
+    tracker->captureFrame(guard, frame, frame + 1);
+    tracker->runConfirmedFrames(guard, frame);
+  }
+  tracker->runConfirmedFrames(guard, AT_BAT_FRAMES.size());
+
+  ASSERT_TRUE(tracker->m_game_info.currentEventVld());
+  const StatTracker::Event& event = tracker->m_game_info.getCurrentEvent();
+  ASSERT_TRUE(event.pitch.has_value());
+  ASSERT_TRUE(event.pitch->contact.has_value());
+  EXPECT_EQ(event.pitch->pitch_type, 2);
+  EXPECT_EQ(tracker->m_snapshot.getMissedReadCount(), 0u);
+
+  // Every position saw the pitch once
+  int pitches_seen = 0;
+  const auto& fielders = tracker->m_fielder_tracker[!event.half_inning];
+  for (const auto& [roster_loc, fielder] : fielders.fielder_map)
+  {
+    for (int pitches : fielder.pitch_count_by_position)
+      pitches_seen += pitches;
+  }
+  EXPECT_EQ(pitches_seen, cNumOfPositions);
+}
@@ -0,0 +1,246 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Core/MSB_StatTracker.h"
+
+// Deterministic stand-in for a recorded 9 inning game. Values stay inside the decode tables
+// most of the time, with the occasional id that has no name.
+class GameRecorder
+{
+public:
+  explicit GameRecorder(u32 seed) : m_state(seed) {}
+
+  void Record(StatTracker& tracker)
+  {
+    StatTracker::GameInfo& info = tracker.m_game_info;
+    info.game_id = 0x1234ABCD;
+    info.start_unix_date_time = "1700000000";
+    info.start_local_date_time = "Tue Nov 14 22:13:20 2023";
+    info.end_unix_date_time = "1700003600";
+    info.end_local_date_time = "Tue Nov 14 23:13:20 2023";
+    info.team0_port = 1;
+    info.team1_port = 2;
+    info.away_port = 1;
+    info.home_port = 2;
+    info.team0_captain_roster_loc = 3;
+    info.team1_captain_roster_loc = 0;
+    info.team0_player.username = "AwayPlayer";
+    info.team0_player.userid = "away-rio-key";
+    info.team1_player.username = "HomePlayer";
+    info.team1_player.userid = "home-rio-key";
+    info.avg_ping = 42;
+    info.lag_spikes = 3;
+    info.away_score = 7;
+    info.home_score = 5;
+    info.stadium = 2;
+    info.innings_selected = 9;
+    info.innings_played = 9;
+    info.netplay = true;
+    info.tag_set_id = 12;
+    info.quitter_team = 0xFF;
+
+    for (int team = 0; team < 2; ++team)
+    {
+      for (int roster = 0; roster < 9; ++roster)
+      {
+        StatTracker::CharacterSummary& summary = info.character_summaries[team][roster];
+        summary.char_id = U8(0x36);
+        summary.is_starred = U8(2);
+        summary.fielding_hand = U8(2);
+        summary.batting_hand = U8(2);
+
+        auto& def = summary.end_game_defensive_stats;
+        def.batters_faced = U8(40);
+        def.runs_allowed = U16(10);
+        def.earned_runs = def.runs_allowed;
+        def.batters_walked = U16(5);
+        def.batters_hit = U16(3);
+        def.hits_allowed = U16(15);
+        def.homeruns_allowed = U16(4);
+        def.pitches_thrown = U16(150);
+        def.stamina = U16(10);
+        def.was_pitcher = U8(2);
+        def.outs_pitched = U8(27);
+        def.batter_outs = U8(27);
+        def.strike_outs = U8(12);
+        def.star_pitches_thrown = U8(5);
+        def.big_plays = U8(4);
+
+        auto& off = summary.end_game_offensive_stats;
+        off.at_bats = U8(6);
+        off.hits = U8(5);
+        off.singles = U8(4);
+        off.doubles = U8(2);
+        off.triples = U8(2);
+        off.homeruns = U8(2);
+        off.successful_bunts = U8(2);
+        off.sac_flys = U8(2);
+        off.strikouts = U8(4);
+        off.walks_4balls = U8(2);
+        off.walks_hit = U8(2);
+        off.rbi = U8(5);
+        off.bases_stolen = U8(3);
+        off.star_hits = U8(2);
+
+        auto& fielder = tracker.m_fielder_tracker[team].fielder_map[roster];
+        for (int pos = 0; pos < 9; ++pos)
+        {
+          fielder.batter_count_by_position[pos] = U8(4) == 0 ? U8(30) : 0;
+          fielder.batter_outs_by_position[pos] = U8(5) == 0 ? U8(10) : 0;
+          fielder.out_count_by_position[pos] = U8(6) == 0 ? U8(5) : 0;
+        }
+      }
+    }
+
+    u16 event_num = 0;
+    for (u8 inning = 1; inning <= 9; ++inning)
+    {
+      for (u8 half = 0; half < 2; ++half)
+      {
+        const int at_bats = 6 + U8(6);
+        for (int ab = 0; ab < at_bats; ++ab)
+          RecordEvent(info.events[event_num], event_num, inning, half), ++event_num;
+      }
+    }
+    info.event_num = event_num - 1;
+  }
+
+private:
+  u32 Next()
+  {
+    m_state = m_state * 1664525 + 1013904223;
+    return m_state >> 8;
+  }
+  u8 U8(u32 range) { return static_cast<u8>(Next() % range); }
+  u16 U16(u32 range) { return static_cast<u16>(Next() % range); }
+  u32 Float(float min, float max)
+  {
+    const float value = min + (max - min) * (Next() % 100000) / 100000.0f;
+    u32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  StatTracker::Runner MakeRunner(u8 base)
+  {
+    StatTracker::Runner runner;
+    runner.roster_loc = U8(9);
+    runner.char_id = U8(0x36);
+    runner.initial_base = base;
+    runner.out_type = U8(6);
+    runner.out_location = U8(4);
+    runner.result_base = U8(5);
+    runner.steal = U8(5);
+    return runner;
+  }
+
+  StatTracker::Fielder MakeFielder()
+  {
+    StatTracker::Fielder fielder;
+    fielder.fielder_roster_loc = U8(9);
+    fielder.fielder_pos = U8(9);
+    fielder.fielder_char_id = U8(0x36);
+    fielder.fielder_swapped_for_batter = U8(2);
+    fielder.fielder_action = U8(4);
+    fielder.fielder_jump = U8(2);
+    fielder.fielder_manual_select_arg = U8(3);
+    fielder.fielder_x_pos = Float(-40, 40);
+    fielder.fielder_y_pos = Float(0, 5);
+    fielder.fielder_z_pos = Float(0, 120);
+    fielder.bobble = U8(4);
+    return fielder;
+  }
+
+  void RecordEvent(StatTracker::Event& event, u16 event_num, u8 inning, u8 half)
+  {
+    event.event_num = event_num;
+    event.inning = inning;
+    event.half_inning = half;
+    event.away_score = U16(10);
+    event.home_score = U16(10);
+    event.is_star_chance = U8(2);
+    event.away_stars = U8(6);
+    event.home_stars = U8(6);
+    event.chem_links_ob = U8(4);
+    event.pitcher_stamina = U16(10);
+    event.pitcher_roster_loc = U8(9);
+    event.batter_roster_loc = U8(9);
+    event.catcher_roster_loc = U8(9);
+    event.balls = U8(4);
+    event.strikes = U8(3);
+    event.outs = U8(3);
+    event.rbi = U8(4);
+    event.result_of_atbat = U8(18);
+    event.num_outs_during_play.set_value(U8(3));
+
+    event.runner_batter = MakeRunner(0);
+    if (U8(2))
+      event.runner_1 = MakeRunner(1);
+    if (U8(3) == 0)
+      event.runner_2 = MakeRunner(2);
+    if (U8(4) == 0)
+      event.runner_3 = MakeRunner(3);
+
+    // Pickoffs have no pitch
+    if (U8(10) == 0)
+      return;
+
+    StatTracker::Pitch& pitch = event.pitch.emplace();
+    pitch.pitcher_team_id = half;
+    pitch.pitcher_char_id = U8(0x36);
+    pitch.pitch_type = U8(4);
+    pitch.charge_type = U8(4);
+    pitch.star_pitch = U8(2);
+    pitch.pitch_speed = U8(200);
+    pitch.ball_z_strike_vs_ball = Float(-1, 1);
+    pitch.ball_in_strikezone = U8(2);
+    pitch.bat_contact_x_pos.set_value(Float(-2, 2));
+    pitch.bat_contact_z_pos.set_value(Float(-2, 2));
+    pitch.db = U8(2);
+    pitch.type_of_swing = U8(5);
+
+    if (U8(3) == 0)
+      return;
+
+    StatTracker::Contact& contact = pitch.contact.emplace();
+    contact.type_of_contact.set_value(U8(5));
+    contact.charge_power_up.set_value(Float(0, 1));
+    contact.charge_power_down.set_value(Float(0, 1));
+    contact.moon_shot.set_value(U8(2));
+    contact.input_direction_push_pull.set_value(U8(4));
+    contact.input_direction_stick.set_value(U8(16));
+    contact.frame_of_swing.set_value(U16(30));
+    contact.power.set_value(U16(200));
+    contact.vert_angle.set_value(U16(1024));
+    contact.horiz_angle.set_value(U16(1024));
+    contact.contact_absolute.set_value(Float(0, 200));
+    contact.contact_quality.set_value(Float(0, 1));
+    contact.rng1.set_value(U16(65535));
+    contact.rng2.set_value(U16(65535));
+    contact.rng3.set_value(U16(65535));
+    contact.ball_x_velo.set_value(Float(-2, 2));
+    contact.ball_y_velo.set_value(Float(-2, 2));
+    contact.ball_z_velo.set_value(Float(-2, 2));
+    contact.ball_contact_x_pos.set_value(Float(-2, 2));
+    contact.ball_contact_z_pos.set_value(Float(-2, 2));
+    contact.ball_x_pos.set_value(Float(-80, 80));
+    contact.ball_y_pos.set_value(Float(0, 10));
+    contact.ball_z_pos.set_value(Float(0, 140));
+    contact.ball_max_height.set_value(Float(0, 40));
+    contact.ball_hang_time.set_value(U16(300));
+    contact.primary_contact_result = U8(4);
+    contact.secondary_contact_result = U8(20);
+
+    if (U8(3) != 0)
+      contact.first_fielder = MakeFielder();
+    if (U8(2) != 0)
+      contact.collect_fielder = MakeFielder();
+  }
+
+  u32 m_state;
+};
@@ -0,0 +1,169 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/MSB_StatTrackerTrace.h"
+#include "Core/TrackerSnapshot.h"
+
+namespace
+{
+using Frame = std::vector<std::vector<u8>>;
+
+void AddRegions(TrackerSnapshot& snapshot)
+{
+  snapshot.addRegion(0x80000000, 0x80000100);
+  snapshot.addRegion(0x80400000, 0x80400040);
+  snapshot.setReplaying(true);
+}
+
+void SetFrame(TrackerSnapshot& snapshot, const Frame& frame)
+{
+  for (size_t i = 0; i < frame.size(); ++i)
+    std::copy(frame[i].begin(), frame[i].end(), snapshot.getReplayData(i));
+}
+
+Frame GetFrame(const TrackerSnapshot& snapshot)
+{
+  Frame frame;
+  for (size_t i = 0; i < snapshot.getNumRegions(); ++i)
+    frame.push_back(snapshot.getRegionData(i));
+  return frame;
+}
+
+// A few frames with scattered, clustered and no changes
+std::vector<Frame> MakeFrames()
+{
+  std::vector<Frame> frames;
+  Frame frame{std::vector<u8>(0x100), std::vector<u8>(0x40)};
+  for (int f = 0; f < 6; ++f)
+  {
+    if (f == 0)
+    {
+      for (size_t i = 0; i < frame[0].size(); ++i)
+        frame[0][i] = static_cast<u8>(i * 7);
+    }
+    else if (f != 3)
+    {
+      frame[0][f * 11] ^= 0x5A;
+      frame[0][f * 11 + 2] += 1;
+      frame[1][0x3F] = static_cast<u8>(f);
+    }
+    frames.push_back(frame);
+  }
+  return frames;
+}
+}  // namespace
+
+class StatTrackerTraceTest : public testing::Test
+{
+protected:
+  StatTrackerTraceTest()
+      : m_dir(File::CreateTempDir()), m_path(m_dir + DIR_SEP "test.stattrace")
+  {
+  }
+  ~StatTrackerTraceTest() override { File::DeleteDirRecursively(m_dir); }
+
+  void WriteTrace(const std::vector<Frame>& frames, const StatTrackerTraceSettings& settings)
+  {
+    TrackerSnapshot snapshot;
+    AddRegions(snapshot);
+
+    StatTrackerTraceWriter writer;
+    ASSERT_TRUE(writer.open(m_path, snapshot));
+    for (const Frame& frame : frames)
+    {
+      SetFrame(snapshot, frame);
+      writer.writeSettings(settings);
+      writer.writeFrame(snapshot);
+    }
+    EXPECT_EQ(writer.getNumFrames(), frames.size());
+    writer.close();
+  }
+
+  std::string m_dir;
+  std::string m_path;
+};
+
+TEST_F(StatTrackerTraceTest, RoundTrip)
+{
+  StatTrackerTraceSettings settings;
+  settings.netplay = true;
+  settings.opponent_alias = "Opponent";
+  settings.tag_set_id_netplay = 7;
+
+  const std::vector<Frame> frames = MakeFrames();
+  WriteTrace(frames, settings);
+
+  TrackerSnapshot snapshot;
+  AddRegions(snapshot);
+  StatTrackerTraceReader reader;
+  ASSERT_TRUE(reader.open(m_path));
+  ASSERT_TRUE(reader.matches(snapshot));
+
+  // Settings only when they change, so once before the first frame
+  ASSERT_EQ(reader.next(snapshot), StatTrackerTraceReader::Record::Settings);
+  EXPECT_TRUE(reader.getSettings() == settings);
+
+  for (const Frame& frame : frames)
+  {
+    ASSERT_EQ(reader.next(snapshot), StatTrackerTraceReader::Record::Frame);
+    EXPECT_EQ(GetFrame(snapshot), frame);
+  }
+  EXPECT_EQ(reader.next(snapshot), StatTrackerTraceReader::Record::End);
+  EXPECT_EQ(reader.getNumFrames(), frames.size());
+}
+
+TEST_F(StatTrackerTraceTest, TruncatedTraceEndsAtLastCompleteFrame)
+{
+  const std::vector<Frame> frames = MakeFrames();
+  WriteTrace(frames, {});
+
+  // Cut the last frame in half, as a crash while recording would
+  std::string data;
+  ASSERT_TRUE(File::ReadFileToString(m_path, data));
+  const std::string full = data;
+  WriteTrace(std::vector<Frame>(frames.begin(), frames.end() - 1), {});
+  ASSERT_TRUE(File::ReadFileToString(m_path, data));
+  ASSERT_LT(data.size(), full.size());
+  ASSERT_TRUE(File::WriteStringToFile(m_path, full.substr(0, (data.size() + full.size()) / 2)));
+
+  TrackerSnapshot snapshot;
+  AddRegions(snapshot);
+  StatTrackerTraceReader reader;
+  ASSERT_TRUE(reader.open(m_path));
+  ASSERT_EQ(reader.next(snapshot), StatTrackerTraceReader::Record::Settings);
+  for (size_t i = 0; i + 1 < frames.size(); ++i)
+    ASSERT_EQ(reader.next(snapshot), StatTrackerTraceReader::Record::Frame);
+  EXPECT_EQ(reader.next(snapshot), StatTrackerTraceReader::Record::End);
+
+  // The torn frame is not half applied
+  EXPECT_EQ(GetFrame(snapshot), frames[frames.size() - 2]);
+  EXPECT_EQ(reader.getNumFrames(), frames.size() - 1);
+}
+
+TEST_F(StatTrackerTraceTest, RejectsOtherRegions)
+{
+  WriteTrace(MakeFrames(), {});
+
+  TrackerSnapshot snapshot;
+  snapshot.addRegion(0x80000000, 0x80000080);
+  StatTrackerTraceReader reader;
+  ASSERT_TRUE(reader.open(m_path));
+  EXPECT_FALSE(reader.matches(snapshot));
+}
+
+TEST_F(StatTrackerTraceTest, RejectsOtherFiles)
+{
+  ASSERT_TRUE(File::WriteStringToFile(m_path, "{\"GameID\": 0}"));
+
+  StatTrackerTraceReader reader;
+  EXPECT_FALSE(reader.open(m_path));
+}
@@ -0,0 +1,187 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Core/MSB_StatUploader.h"
+
+namespace
+{
+// Local stand-in for the Rio API. Answers the first |failures| requests with |failure_status|.
+class StandInEndpoint
+{
+public:
+  explicit StandInEndpoint(int failures = 0, s32 failure_status = 503)
+      : m_failures(failures), m_failure_status(failure_status)
+  {
+  }
+
+  StatUploader::PostFunction GetPostFunction()
+  {
+    return [this](const std::string& url, const std::string& payload) -> s32 {
+      std::lock_guard lk(m_lock);
+      ++m_attempts;
+      if (m_failures > 0)
+      {
+        --m_failures;
+        return m_failure_status;
+      }
+      m_received.emplace_back(url, payload);
+      return 200;
+    };
+  }
+
+  int GetAttempts()
+  {
+    std::lock_guard lk(m_lock);
+    return m_attempts;
+  }
+
+  std::vector<std::pair<std::string, std::string>> GetReceived()
+  {
+    std::lock_guard lk(m_lock);
+    return m_received;
+  }
+
+private:
+  std::mutex m_lock;
+  int m_failures;
+  s32 m_failure_status;
+  int m_attempts = 0;
+  std::vector<std::pair<std::string, std::string>> m_received;
+};
+
+constexpr char BASE_URL[] = "http://127.0.0.1/";
+
+StatUploader::RetryPolicy FastRetry(int max_attempts)
+{
+  StatUploader::RetryPolicy policy;
+  policy.max_attempts = max_attempts;
+  policy.initial_backoff = std::chrono::milliseconds(1);
+  policy.max_backoff = std::chrono::milliseconds(4);
+  return policy;
+}
+}  // namespace
+
+class StatUploaderTest : public testing::Test
+{
+protected:
+  StatUploaderTest() : m_outbox_dir(File::CreateTempDir() + "/Outbox/") {}
+  ~StatUploaderTest() override { File::DeleteDirRecursively(m_outbox_dir); }
+
+  size_t OutboxSize() const { return Common::DoFileSearch({m_outbox_dir}, {".json"}).size(); }
+  size_t RejectedSize() const
+  {
+    return Common::DoFileSearch({m_outbox_dir + cStatOutboxRejectedDir}, {".json"}).size();
+  }
+
+  const std::string m_outbox_dir;
+};
+
+TEST_F(StatUploaderTest, SubmitsGameAndClearsOutbox)
+{
+  StandInEndpoint endpoint;
+  StatUploader uploader(m_outbox_dir, BASE_URL, endpoint.GetPostFunction(), FastRetry(3));
+
+  uploader.submitGame("{\"GameID\": \"1\"}");
+  uploader.submitOngoingGame("{\"GameID\": \"1\", \"Inning\": 1}");
+  uploader.waitForIdle();
+
+  const auto received = endpoint.GetReceived();
+  ASSERT_EQ(received.size(), 2u);
+  EXPECT_EQ(received[0].first, std::string(BASE_URL) + cRioApiEndpoint_Game);
+  EXPECT_EQ(received[0].second, "{\"GameID\": \"1\"}");
+  EXPECT_EQ(received[1].first, std::string(BASE_URL) + cRioApiEndpoint_OngoingGame);
+  EXPECT_EQ(uploader.getUploadedCount(), 2u);
+  EXPECT_EQ(OutboxSize(), 0u);
+}
+
+TEST_F(StatUploaderTest, RetriesGameWithBackoff)
+{
+  StandInEndpoint endpoint(2);
+  StatUploader uploader(m_outbox_dir, BASE_URL, endpoint.GetPostFunction(), FastRetry(3));
+
+  uploader.submitGame("{\"GameID\": \"2\"}");
+  uploader.waitForIdle();
+
+  EXPECT_EQ(endpoint.GetReceived().size(), 1u);
+  EXPECT_EQ(uploader.getFailedCount(), 0u);
+  EXPECT_EQ(OutboxSize(), 0u);
+}
+
+TEST_F(StatUploaderTest, TransportErrorIsRetried)
+{
+  StandInEndpoint endpoint(1, 0);
+  StatUploader uploader(m_outbox_dir, BASE_URL, endpoint.GetPostFunction(), FastRetry(3));
+
+  uploader.submitGame("{\"GameID\": \"5\"}");
+  uploader.waitForIdle();
+
+  EXPECT_EQ(endpoint.GetAttempts(), 2);
+  EXPECT_EQ(endpoint.GetReceived().size(), 1u);
+  EXPECT_EQ(OutboxSize(), 0u);
+}
+
+TEST_F(StatUploaderTest, RejectedGameIsQuarantined)
+{
+  StandInEndpoint endpoint(100, 400);
+  StatUploader uploader(m_outbox_dir, BASE_URL, endpoint.GetPostFunction(), FastRetry(3));
+
+  uploader.submitGame("{\"GameID\": \"6\"}");
+  uploader.waitForIdle();
+
+  EXPECT_EQ(endpoint.GetAttempts(), 1);
+  EXPECT_EQ(uploader.getFailedCount(), 1u);
+  EXPECT_EQ(OutboxSize(), 0u);
+  EXPECT_EQ(RejectedSize(), 1u);
+
+  // Quarantined games are not picked up again
+  uploader.resendOutbox();
+  uploader.waitForIdle();
+  EXPECT_EQ(endpoint.GetAttempts(), 1);
+}
+
+TEST_F(StatUploaderTest, OngoingGameIsNotRetried)
+{
+  StandInEndpoint endpoint(1);
+  StatUploader uploader(m_outbox_dir, BASE_URL, endpoint.GetPostFunction(), FastRetry(3));
+
+  uploader.submitOngoingGame("{\"GameID\": \"3\"}");
+  uploader.waitForIdle();
+
+  EXPECT_TRUE(endpoint.GetReceived().empty());
+  EXPECT_EQ(uploader.getFailedCount(), 1u);
+  EXPECT_EQ(OutboxSize(), 0u);
+}
+
+TEST_F(StatUploaderTest, UndeliveredGameIsResentNextSession)
+{
+  {
+    StandInEndpoint offline(100);
+    StatUploader uploader(m_outbox_dir, BASE_URL, offline.GetPostFunction(), FastRetry(2));
+    uploader.submitGame("{\"GameID\": \"4\"}");
+    uploader.waitForIdle();
+    EXPECT_EQ(uploader.getFailedCount(), 1u);
+  }
+  EXPECT_EQ(OutboxSize(), 1u);
+
+  StandInEndpoint online;
+  StatUploader uploader(m_outbox_dir, BASE_URL, online.GetPostFunction(), FastRetry(2));
+  uploader.waitForIdle();
+  // Nothing is resent until the session asks for it
+  EXPECT_EQ(OutboxSize(), 1u);
+
+  uploader.resendOutbox();
+  uploader.waitForIdle();
+
+  const auto received = online.GetReceived();
+  ASSERT_EQ(received.size(), 1u);
+  EXPECT_EQ(received[0].second, "{\"GameID\": \"4\"}");
+  EXPECT_EQ(OutboxSize(), 0u);
+}
@@ -0,0 +1,187 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <gtest/gtest.h>
+
+#include "Core/StateCompression.h"
+
+namespace
+{
+// Roughly what a GameCube state holds: runs of zeros, repeated structures and noisy data
+std::vector<u8> MakeStateData(size_t size)
+{
+  std::vector<u8> data(size);
+  std::mt19937 rng(1234);
+  for (size_t offset = 0; offset < size; offset += 4096)
+  {
+    const size_t page_end = std::min(size, offset + 4096);
+    switch (rng() % 4)
+    {
+    case 0:
+      break;
+    case 1:
+      for (size_t i = offset; i < page_end; ++i)
+        data[i] = static_cast<u8>(i % 64);
+      break;
+    default:
+      for (size_t i = offset; i < page_end; ++i)
+        data[i] = static_cast<u8>(rng() % 16);
+      break;
+    }
+  }
+  return data;
+}
+
+std::vector<u8> RoundTrip(const std::vector<u8>& data, State::CompressionType type,
+                          u32 chunk_size, size_t thread_count)
+{
+  const auto chunks = State::CompressChunks(data, type, chunk_size, thread_count);
+  if (!chunks)
+    return {};
+
+  std::vector<u8> out(data.size());
+  if (!State::DecompressChunks(chunks->data, chunks->sizes, type, chunk_size, out, thread_count))
+    return {};
+  return out;
+}
+}  // namespace
+
+TEST(StateCompression, RoundTrip)
+{
+  const std::vector<u8> data = MakeStateData(5 * 1000 * 1000 + 123);
+  for (const auto type : {State::CompressionType::ChunkedLZ4, State::CompressionType::ChunkedZstd})
+  {
+    EXPECT_EQ(RoundTrip(data, type, State::STATE_CHUNK_SIZE, 0), data);
+    EXPECT_EQ(RoundTrip(data, type, State::STATE_CHUNK_SIZE, 1), data);
+    EXPECT_EQ(RoundTrip(data, type, 4096, 3), data);
+  }
+}
+
+TEST(StateCompression, Regions)
+{
+  const std::vector<u8> data = MakeStateData(3 * 1000 * 1000);
+  const std::vector<u32> sizes{1000 * 1000, 0, 4096, 100, 1000 * 1000 - 4196, 1000 * 1000};
+
+  // Regions of the same data, some of them smaller than a chunk and some crossing chunks
+  std::vector<u8> memory = data;
+  std::vector<std::span<u8>> regions;
+  size_t offset = 0;
+  for (const u32 size : sizes)
+  {
+    regions.emplace_back(memory.data() + offset, size);
+    offset += size;
+  }
+  ASSERT_EQ(offset, data.size());
+
+  for (const auto type : {State::CompressionType::ChunkedLZ4, State::CompressionType::ChunkedZstd})
+  {
+    // Same chunks as compressing the regions copied into one buffer
+    const auto chunks = State::CompressRegions(regions, type, 64 * 1024, 3);
+    ASSERT_TRUE(chunks);
+    const auto expected = State::CompressChunks(data, type, 64 * 1024, 1);
+    ASSERT_TRUE(expected);
+    EXPECT_EQ(chunks->sizes, expected->sizes);
+    EXPECT_EQ(chunks->data, expected->data);
+
+    std::fill(memory.begin(), memory.end(), 0);
+    EXPECT_TRUE(State::DecompressRegions(chunks->data, chunks->sizes, type, 64 * 1024, regions, 3));
+    EXPECT_EQ(memory, data);
+
+    regions.pop_back();
+    EXPECT_FALSE(State::DecompressRegions(chunks->data, chunks->sizes, type, 64 * 1024, regions));
+    regions.emplace_back(memory.data() + 2 * 1000 * 1000, sizes.back());
+  }
+}
+
+TEST(StateCompression, ChunkIndex)
+{
+  const std::vector<u8> data = MakeStateData(3 * State::STATE_CHUNK_SIZE + 1);
+  const auto chunks = State::CompressChunks(data, State::CompressionType::ChunkedLZ4);
+  ASSERT_TRUE(chunks);
+  ASSERT_EQ(chunks->sizes.size(), 4u);
+
+  size_t total_size = 0;
+  for (const u32 size : chunks->sizes)
+    total_size += size;
+  EXPECT_EQ(total_size, chunks->data.size());
+  EXPECT_LT(chunks->data.size(), data.size());
+}
+
+TEST(StateCompression, EmptyPayload)
+{
+  const auto chunks = State::CompressChunks({}, State::CompressionType::ChunkedZstd);
+  ASSERT_TRUE(chunks);
+  EXPECT_TRUE(chunks->sizes.empty());
+  EXPECT_TRUE(State::DecompressChunks({}, {}, State::CompressionType::ChunkedZstd,
+                                      State::STATE_CHUNK_SIZE, {}));
+}
+
+TEST(StateCompression, RejectsCorruptedData)
+{
+  const std::vector<u8> data = MakeStateData(2 * State::STATE_CHUNK_SIZE);
+  auto chunks = State::CompressChunks(data, State::CompressionType::ChunkedLZ4);
+  ASSERT_TRUE(chunks);
+
+  std::vector<u8> out(data.size());
+
+  // Index doesn't match the uncompressed size
+  std::vector<u32> sizes = chunks->sizes;
+  sizes.pop_back();
+  EXPECT_FALSE(State::DecompressChunks(chunks->data, sizes, State::CompressionType::ChunkedLZ4,
+                                       State::STATE_CHUNK_SIZE, out));
+
+  // Index points past the data
+  sizes = chunks->sizes;
+  sizes.back() += 1;
+  EXPECT_FALSE(State::DecompressChunks(chunks->data, sizes, State::CompressionType::ChunkedLZ4,
+                                       State::STATE_CHUNK_SIZE, out));
+
+  // Chunk decompresses to the wrong size
+  sizes = chunks->sizes;
+  std::swap(sizes.front(), sizes.back());
+  EXPECT_FALSE(State::DecompressChunks(chunks->data, sizes, State::CompressionType::ChunkedLZ4,
+                                       State::STATE_CHUNK_SIZE, out));
+
+  // Not a chunked type
+  EXPECT_FALSE(State::DecompressChunks(chunks->data, chunks->sizes, State::CompressionType::LZ4,
+                                       State::STATE_CHUNK_SIZE, out));
+}
+
+// Save and load latency of a GameCube sized state on one thread and on every core
+TEST(StateCompression, Benchmark)
+{
+  const std::vector<u8> data = MakeStateData(30 * 1024 * 1024);
+  std::vector<u8> out(data.size());
+
+  for (const auto type : {State::CompressionType::ChunkedLZ4, State::CompressionType::ChunkedZstd})
+  {
+    for (const size_t thread_count : {size_t{1}, size_t{0}})
+    {
+      const auto start = std::chrono::steady_clock::now();
+      const auto chunks = State::CompressChunks(data, type, State::STATE_CHUNK_SIZE, thread_count);
+      const auto compressed = std::chrono::steady_clock::now();
+      ASSERT_TRUE(chunks);
+      ASSERT_TRUE(State::DecompressChunks(chunks->data, chunks->sizes, type,
+                                          State::STATE_CHUNK_SIZE, out, thread_count));
+      const auto decompressed = std::chrono::steady_clock::now();
+      EXPECT_EQ(out, data);
+
+      using Milliseconds = std::chrono::duration<double, std::milli>;
+      fmt::print(std::cout, "{} on {}: {:.1f} MiB, save {:.1f} ms, load {:.1f} ms\n",
+                 type == State::CompressionType::ChunkedZstd ? "zstd" : "LZ4",
+                 thread_count == 0 ? "every core" : "one thread",
+                 chunks->data.size() / (1024.0 * 1024.0),
+                 Milliseconds(compressed - start).count(),
+                 Milliseconds(decompressed - compressed).count());
+    }
+  }
+}
@@ -0,0 +1,229 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <gtest/gtest.h>
+
+#include "Core/StateRing.h"
+
+namespace
+{
+// Stands in for the emulated machine: memory regions and some state that isn't in them
+struct FakeMachine
+{
+  std::vector<u8> mem1;
+  std::vector<u8> aram;
+  std::vector<u8> state;
+
+  FakeMachine(size_t mem1_size, size_t aram_size) : mem1(mem1_size), aram(aram_size), state(1000)
+  {
+  }
+
+  State::StateRing::Regions GetRegions() { return {mem1, aram}; }
+
+  State::StateRing::StateFunction Save()
+  {
+    return [this](std::vector<u8>& out) { out = state; };
+  }
+  State::StateRing::StateFunction Load()
+  {
+    return [this](std::vector<u8>& in) { state = in; };
+  }
+
+  // Changes a few pages, like a frame of a game does
+  void RunFrame(std::mt19937& rng, size_t pages_touched)
+  {
+    for (size_t i = 0; i < pages_touched; ++i)
+    {
+      std::vector<u8>& region = rng() % 4 == 0 ? aram : mem1;
+      region[rng() % region.size()] = static_cast<u8>(rng());
+    }
+    state[rng() % state.size()] = static_cast<u8>(rng());
+  }
+};
+
+struct MachineCopy
+{
+  std::vector<u8> mem1;
+  std::vector<u8> aram;
+  std::vector<u8> state;
+
+  explicit MachineCopy(const FakeMachine& m) : mem1(m.mem1), aram(m.aram), state(m.state) {}
+  bool operator==(const FakeMachine& m) const
+  {
+    return mem1 == m.mem1 && aram == m.aram && state == m.state;
+  }
+};
+}  // namespace
+
+TEST(StateRing, RestoresEverySnapshot)
+{
+  FakeMachine machine(256 * 1024, 64 * 1024 + 100);
+  State::StateRing ring(100);
+  std::mt19937 rng(1);
+
+  std::vector<MachineCopy> copies;
+  for (u64 frame = 0; frame < 20; ++frame)
+  {
+    machine.RunFrame(rng, 10);
+    ring.Capture(frame, machine.GetRegions(), machine.Save());
+    copies.emplace_back(machine);
+  }
+  EXPECT_EQ(ring.GetSnapshotCount(), 20u);
+
+  // Newest first, restoring drops the later snapshots
+  for (u64 frame = 20; frame-- > 0;)
+  {
+    machine.RunFrame(rng, 50);
+    EXPECT_EQ(ring.Restore(frame, machine.GetRegions(), machine.Load()), frame);
+    EXPECT_TRUE(copies[frame] == machine);
+    EXPECT_EQ(ring.GetNewestFrame(), frame);
+  }
+}
+
+TEST(StateRing, FoldsOldestSnapshots)
+{
+  FakeMachine machine(128 * 1024, 32 * 1024);
+  State::StateRing ring(5);
+  std::mt19937 rng(2);
+
+  std::vector<MachineCopy> copies;
+  for (u64 frame = 0; frame < 12; ++frame)
+  {
+    machine.RunFrame(rng, 10);
+    ring.Capture(frame * 4, machine.GetRegions(), machine.Save());
+    copies.emplace_back(machine);
+  }
+  EXPECT_EQ(ring.GetSnapshotCount(), 5u);
+  EXPECT_EQ(ring.GetOldestFrame(), 7u * 4);
+  EXPECT_EQ(ring.GetNewestFrame(), 11u * 4);
+
+  // Between two snapshots, the older one is restored
+  EXPECT_EQ(ring.Restore(9 * 4 + 2, machine.GetRegions(), machine.Load()), 9u * 4);
+  EXPECT_TRUE(copies[9] == machine);
+
+  // Further back than the ring reaches, the oldest one is restored
+  EXPECT_EQ(ring.Restore(0, machine.GetRegions(), machine.Load()), 7u * 4);
+  EXPECT_TRUE(copies[7] == machine);
+  EXPECT_EQ(ring.GetSnapshotCount(), 1u);
+}
+
+TEST(StateRing, StateSizeChanges)
+{
+  FakeMachine machine(64 * 1024, 4096);
+  State::StateRing ring(10);
+
+  ring.Capture(0, machine.GetRegions(), machine.Save());
+  const MachineCopy first(machine);
+
+  machine.state.resize(20000, 7);
+  ring.Capture(1, machine.GetRegions(), machine.Save());
+  const MachineCopy second(machine);
+
+  machine.state.resize(10);
+  ring.Capture(2, machine.GetRegions(), machine.Save());
+
+  EXPECT_EQ(ring.Restore(1, machine.GetRegions(), machine.Load()), 1u);
+  EXPECT_TRUE(second == machine);
+  EXPECT_EQ(ring.Restore(0, machine.GetRegions(), machine.Load()), 0u);
+  EXPECT_TRUE(first == machine);
+}
+
+TEST(StateRing, RetryPoint)
+{
+  FakeMachine machine(64 * 1024, 4096);
+  State::StateRing ring(3);
+  std::mt19937 rng(3);
+
+  EXPECT_FALSE(ring.Retry(machine.GetRegions(), machine.Load()));
+
+  ring.Capture(0, machine.GetRegions(), machine.Save());
+  machine.RunFrame(rng, 10);
+  ring.SetRetryPoint(1, machine.GetRegions(), machine.Save());
+  const MachineCopy retry_point(machine);
+
+  // The retry point outlives the snapshots around it
+  for (u64 frame = 2; frame < 10; ++frame)
+  {
+    machine.RunFrame(rng, 10);
+    ring.Capture(frame, machine.GetRegions(), machine.Save());
+  }
+  EXPECT_EQ(ring.GetOldestFrame(), 7u);
+
+  EXPECT_EQ(ring.Retry(machine.GetRegions(), machine.Load()), 1u);
+  EXPECT_TRUE(retry_point == machine);
+  EXPECT_EQ(ring.GetSnapshotCount(), 0u);
+
+  // Retrying again works as often as needed
+  machine.RunFrame(rng, 10);
+  ring.Capture(2, machine.GetRegions(), machine.Save());
+  EXPECT_EQ(ring.Retry(machine.GetRegions(), machine.Load()), 1u);
+  EXPECT_TRUE(retry_point == machine);
+}
+
+TEST(StateRing, StartsOverWhenTimeGoesBack)
+{
+  FakeMachine machine(64 * 1024, 4096);
+  State::StateRing ring(10);
+
+  ring.Capture(10, machine.GetRegions(), machine.Save());
+  ring.Capture(20, machine.GetRegions(), machine.Save());
+  ring.Capture(5, machine.GetRegions(), machine.Save());
+  EXPECT_EQ(ring.GetSnapshotCount(), 1u);
+  EXPECT_EQ(ring.GetOldestFrame(), 5u);
+}
+
+// Capture and restore cost for GameCube sized memory, against copying everything like
+// State::SaveToBuffer does
+TEST(StateRing, Benchmark)
+{
+  FakeMachine machine(24 * 1024 * 1024, 16 * 1024 * 1024);
+  machine.state.resize(2 * 1024 * 1024);
+  // Ten seconds of snapshots every four frames
+  State::StateRing ring(150);
+  std::mt19937 rng(4);
+
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  Milliseconds capture_time{};
+  Milliseconds full_copy_time{};
+  std::vector<u8> full_copy;
+  constexpr u64 SNAPSHOTS = 300;
+  for (u64 frame = 0; frame < SNAPSHOTS * 4; frame += 4)
+  {
+    machine.RunFrame(rng, 200);
+
+    auto start = std::chrono::steady_clock::now();
+    ring.Capture(frame, machine.GetRegions(), machine.Save());
+    capture_time += std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    full_copy.resize(machine.mem1.size() + machine.aram.size() + machine.state.size());
+    std::memcpy(full_copy.data(), machine.mem1.data(), machine.mem1.size());
+    std::memcpy(full_copy.data() + machine.mem1.size(), machine.aram.data(), machine.aram.size());
+    std::memcpy(full_copy.data() + machine.mem1.size() + machine.aram.size(),
+                machine.state.data(), machine.state.size());
+    full_copy_time += std::chrono::steady_clock::now() - start;
+  }
+
+  const MachineCopy expected(machine);
+  const auto start = std::chrono::steady_clock::now();
+  // Back about two seconds
+  const auto restored = ring.Restore((SNAPSHOTS - 30) * 4, machine.GetRegions(), machine.Load());
+  const Milliseconds restore_time = std::chrono::steady_clock::now() - start;
+  ASSERT_TRUE(restored);
+
+  fmt::print(std::cout,
+             "Capture {:.2f} ms (full copy {:.2f} ms), restore {:.2f} ms, "
+             "{} snapshots in {:.1f} MiB (full copies {:.1f} MiB)\n",
+             capture_time.count() / SNAPSHOTS, full_copy_time.count() / SNAPSHOTS,
+             restore_time.count(), ring.GetSnapshotCount(),
+             ring.GetMemoryUsage() / (1024.0 * 1024.0),
+             ring.GetSnapshotCount() * full_copy.size() / (1024.0 * 1024.0));
+}
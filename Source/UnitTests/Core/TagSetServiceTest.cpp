@@ -0,0 +1,289 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <condition_variable>
+#include <ctime>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <picojson.h>
+
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Core/TagSetService.h"
+
+namespace
+{
+constexpr char BASE_URL[] = "http://127.0.0.1/";
+
+std::string TagSetsResponse(const std::string& name)
+{
+  return R"({"Tag Sets": [{"id": 7, "name": ")" + name +
+         R"(", "tags": [{"id": 1, "name": "Enable Hazardless", "type": "Client Code"}]}]})";
+}
+
+// How the cache file refers to the tag set list of a Rio key
+std::string TagSetListKey(const std::string& rio_key)
+{
+  return "tag_set/list\n" + Common::BytesToHexString(Common::SHA1::CalculateDigest(rio_key));
+}
+
+// Local stand-in for the Rio API. Answers every request with |body|, refuses it if rejecting, or
+// can't be reached if neither. While held, requests wait until released.
+class StandInEndpoint
+{
+public:
+  TagSetService::FetchFunction GetFetchFunction()
+  {
+    return [this](const std::string& url, const std::string&) {
+      std::unique_lock lk(m_lock);
+      m_released.wait(lk, [this] { return !m_held; });
+      m_requests.push_back(url);
+      return TagSetService::FetchResult{m_body, m_rejecting};
+    };
+  }
+
+  void SetBody(std::optional<std::string> body)
+  {
+    std::lock_guard lk(m_lock);
+    m_body = std::move(body);
+    m_rejecting = false;
+  }
+
+  void Reject()
+  {
+    std::lock_guard lk(m_lock);
+    m_body = std::nullopt;
+    m_rejecting = true;
+  }
+
+  void Hold()
+  {
+    std::lock_guard lk(m_lock);
+    m_held = true;
+  }
+
+  void Release()
+  {
+    {
+      std::lock_guard lk(m_lock);
+      m_held = false;
+    }
+    m_released.notify_all();
+  }
+
+  std::vector<std::string> GetRequests()
+  {
+    std::lock_guard lk(m_lock);
+    return m_requests;
+  }
+
+private:
+  std::mutex m_lock;
+  std::condition_variable m_released;
+  bool m_held = false;
+  std::optional<std::string> m_body;
+  bool m_rejecting = false;
+  std::vector<std::string> m_requests;
+};
+}  // namespace
+
+class TagSetServiceTest : public testing::Test
+{
+protected:
+  TagSetServiceTest() : m_dir(File::CreateTempDir()), m_cache_path(m_dir + "/RioApiCache.json")
+  {
+  }
+  ~TagSetServiceTest() override { File::DeleteDirRecursively(m_dir); }
+
+  const std::string m_dir;
+  const std::string m_cache_path;
+  StandInEndpoint m_endpoint;
+};
+
+TEST_F(TagSetServiceTest, CachedLookupsDontRefetch)
+{
+  m_endpoint.SetBody(TagSetsResponse("Ranked"));
+  TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+
+  for (int i = 0; i < 3; ++i)
+  {
+    const auto tag_sets = service.getAvailableTagSets("key");
+    ASSERT_EQ(tag_sets.size(), 1u);
+    EXPECT_EQ(tag_sets.at(7).name, "Ranked");
+    ASSERT_EQ(tag_sets.at(7).tags.size(), 1u);
+    EXPECT_TRUE(tag_sets.at(7).tags[0].client_code == ClientCode::EnableHazardless);
+  }
+  service.waitForIdle();
+
+  EXPECT_EQ(service.getFetchCount(), 1u);
+  EXPECT_EQ(m_endpoint.GetRequests(), std::vector<std::string>{std::string(BASE_URL) + "tag_set/list"});
+}
+
+TEST_F(TagSetServiceTest, StaleResponseIsReturnedWhileRefreshing)
+{
+  m_endpoint.SetBody(TagSetsResponse("Old"));
+  TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction(),
+                        std::chrono::seconds(0));
+  EXPECT_EQ(service.getAvailableTagSets("key").at(7).name, "Old");
+
+  // The refresh can't finish, the lookup must not wait for it
+  m_endpoint.SetBody(TagSetsResponse("New"));
+  m_endpoint.Hold();
+  EXPECT_EQ(service.getAvailableTagSets("key").at(7).name, "Old");
+  m_endpoint.Release();
+  service.waitForIdle();
+
+  EXPECT_EQ(service.getFetchCount(), 2u);
+  m_endpoint.Hold();
+  EXPECT_EQ(service.getAvailableTagSets("key").at(7).name, "New");
+  m_endpoint.Release();
+}
+
+TEST_F(TagSetServiceTest, FailedRefreshKeepsStaleResponse)
+{
+  m_endpoint.SetBody(TagSetsResponse("Ranked"));
+  TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction(),
+                        std::chrono::seconds(0));
+  EXPECT_EQ(service.getAvailableTagSets("key").size(), 1u);
+
+  m_endpoint.SetBody(std::nullopt);
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(service.getAvailableTagSets("key").at(7).name, "Ranked");
+    service.waitForIdle();
+  }
+
+  // Never fetched, nothing to fall back on
+  EXPECT_FALSE(service.getTagSet(7));
+}
+
+TEST_F(TagSetServiceTest, CachePersists)
+{
+  m_endpoint.SetBody(TagSetsResponse("Ranked"));
+  {
+    TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+    EXPECT_EQ(service.getAvailableTagSets("key").size(), 1u);
+  }
+
+  // Offline now, the cache file still answers
+  m_endpoint.SetBody(std::nullopt);
+  {
+    TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+    EXPECT_EQ(service.getAvailableTagSets("key").at(7).name, "Ranked");
+    service.waitForIdle();
+    EXPECT_EQ(service.getFetchCount(), 0u);
+  }
+
+  // A cache from another version is ignored
+  picojson::object entry;
+  entry["Body"] = picojson::value(TagSetsResponse("Outdated"));
+  entry["Fetched"] = picojson::value(static_cast<double>(std::time(nullptr)));
+  picojson::object responses;
+  responses[TagSetListKey("key")] = picojson::value(entry);
+  picojson::object root;
+  root["Version"] = picojson::value(999.0);
+  root["Responses"] = picojson::value(responses);
+  ASSERT_TRUE(File::WriteStringToFile(m_cache_path, picojson::value(root).serialize()));
+  TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+  EXPECT_TRUE(service.getAvailableTagSets("key").empty());
+  EXPECT_EQ(service.getFetchCount(), 1u);
+
+  // The same entry with the current version is used
+  root["Version"] = picojson::value(2.0);
+  ASSERT_TRUE(File::WriteStringToFile(m_cache_path, picojson::value(root).serialize()));
+  TagSetService current(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+  EXPECT_EQ(current.getAvailableTagSets("key").at(7).name, "Outdated");
+  EXPECT_EQ(current.getFetchCount(), 0u);
+}
+
+TEST_F(TagSetServiceTest, ValidationCanSkipCache)
+{
+  m_endpoint.SetBody("{}");
+  TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+
+  EXPECT_TRUE(service.validateAccount("player", "key"));
+  EXPECT_TRUE(service.validateAccount("player", "key"));
+  service.waitForIdle();
+  EXPECT_EQ(service.getFetchCount(), 1u);
+
+  // Offline, the account is still known to be valid
+  m_endpoint.SetBody(std::nullopt);
+  EXPECT_TRUE(service.validateAccount("player", "key", false));
+  EXPECT_EQ(service.getFetchCount(), 2u);
+
+  // The account was removed on the server, it doesn't come back from the cache
+  m_endpoint.Reject();
+  EXPECT_FALSE(service.validateAccount("player", "key", false));
+  m_endpoint.SetBody(std::nullopt);
+  EXPECT_FALSE(service.validateAccount("player", "key"));
+  EXPECT_EQ(service.getFetchCount(), 4u);
+
+  // Nor from the cache file
+  TagSetService restarted(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+  EXPECT_FALSE(restarted.validateAccount("player", "key"));
+}
+
+TEST_F(TagSetServiceTest, CacheFileHasNoRioKeys)
+{
+  m_endpoint.SetBody(TagSetsResponse("Ranked"));
+  {
+    TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+    service.prefetchAccount("player", "secret-rio-key");
+    service.waitForIdle();
+    EXPECT_EQ(service.getFetchCount(), 2u);
+  }
+
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(m_cache_path, contents));
+  EXPECT_NE(contents.find("player"), std::string::npos);
+  EXPECT_EQ(contents.find("secret-rio-key"), std::string::npos);
+
+  // Still found by the key after a restart
+  m_endpoint.SetBody(std::nullopt);
+  TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+  EXPECT_TRUE(service.validateAccount("player", "secret-rio-key"));
+  EXPECT_EQ(service.getAvailableTagSets("secret-rio-key").size(), 1u);
+  EXPECT_FALSE(service.validateAccount("player", "other-key"));
+}
+
+TEST_F(TagSetServiceTest, ConcurrentColdLookupsShareFetch)
+{
+  m_endpoint.SetBody(TagSetsResponse("Ranked"));
+  TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+
+  m_endpoint.Hold();
+  std::vector<std::future<size_t>> lookups;
+  for (int i = 0; i < 4; ++i)
+  {
+    lookups.push_back(std::async(std::launch::async,
+                                 [&] { return service.getAvailableTagSets("key").size(); }));
+  }
+  m_endpoint.Release();
+
+  for (auto& lookup : lookups)
+    EXPECT_EQ(lookup.get(), 1u);
+  service.waitForIdle();
+  EXPECT_EQ(service.getFetchCount(), 1u);
+}
+
+TEST_F(TagSetServiceTest, PrefetchWarmsCache)
+{
+  m_endpoint.SetBody(TagSetsResponse("Ranked"));
+  TagSetService service(m_cache_path, BASE_URL, m_endpoint.GetFetchFunction());
+
+  service.prefetchAccount("player", "key");
+  service.waitForIdle();
+  EXPECT_EQ(service.getFetchCount(), 2u);
+
+  m_endpoint.SetBody(std::nullopt);
+  EXPECT_TRUE(service.validateAccount("player", "key"));
+  EXPECT_EQ(service.getAvailableTagSets("key").size(), 1u);
+  service.waitForIdle();
+  EXPECT_EQ(service.getFetchCount(), 2u);
+}